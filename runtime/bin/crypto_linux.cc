@@ -5,8 +5,10 @@
 #include "platform/globals.h"
 #if defined(HOST_OS_LINUX)
 
-#include <errno.h>  // NOLINT
-#include <fcntl.h>  // NOLINT
+#include <errno.h>        // NOLINT
+#include <fcntl.h>        // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/fdutils.h"
@@ -17,6 +19,25 @@ namespace bin {
 
 bool Crypto::GetRandomBytes(intptr_t count, uint8_t* buffer) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
+#if defined(SYS_getrandom)
+  // getrandom(2) does not need a file descriptor, which saves the open and
+  // close of /dev/urandom. Older kernels fail with ENOSYS.
+  intptr_t bytes_copied = 0;
+  while (bytes_copied < count) {
+    intptr_t res = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+        syscall(SYS_getrandom, buffer + bytes_copied, count - bytes_copied, 0));
+    if (res < 0) {
+      break;
+    }
+    bytes_copied += res;
+  }
+  if (bytes_copied == count) {
+    return true;
+  }
+  if (errno != ENOSYS) {
+    return false;
+  }
+#endif  // defined(SYS_getrandom)
   intptr_t fd =
       TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(open("/dev/urandom", O_RDONLY));
   if (fd < 0) {
@@ -9,8 +9,10 @@
 #include "bin/error_exit.h"
 #include "bin/file.h"
 #include "bin/platform.h"
+#include "bin/process.h"
 #include "bin/utils.h"
 #include "include/dart_tools_api.h"
+#include "platform/text_buffer.h"
 #include "platform/utils.h"
 #include "vm/os.h"
 
@@ -75,6 +77,8 @@ DFE::DFE()
     : use_dfe_(false),
       use_incremental_compiler_(false),
       frontend_filename_(NULL),
+      kernel_cache_directory_(NULL),
+      kernel_cache_flags_(NULL),
       application_kernel_buffer_(NULL),
       application_kernel_buffer_size_(0) {}
 
@@ -84,6 +88,11 @@ DFE::~DFE() {
   }
   frontend_filename_ = NULL;
 
+  free(kernel_cache_directory_);
+  kernel_cache_directory_ = NULL;
+  free(kernel_cache_flags_);
+  kernel_cache_flags_ = NULL;
+
   free(application_kernel_buffer_);
   application_kernel_buffer_ = NULL;
   application_kernel_buffer_size_ = 0;
@@ -199,6 +208,18 @@ void DFE::CompileAndReadScript(const char* script_uri,
                                char** error,
                                int* exit_code,
                                const char* package_config) {
+  // The incremental compiler must see the initial compilation to compute
+  // the changes for a later reload, so it does not use the cache.
+  char* cache_key = NULL;
+  if ((kernel_cache_directory_ != NULL) && !use_incremental_compiler()) {
+    cache_key = KernelCacheKey(script_uri, package_config);
+    if (ReadCachedKernel(cache_key, kernel_buffer, kernel_buffer_size)) {
+      free(cache_key);
+      *error = NULL;
+      *exit_code = 0;
+      return;
+    }
+  }
   Dart_KernelCompilationResult result =
       CompileScript(script_uri, use_incremental_compiler(), package_config);
   switch (result.status) {
@@ -207,6 +228,9 @@ void DFE::CompileAndReadScript(const char* script_uri,
       *kernel_buffer_size = result.kernel_size;
       *error = NULL;
       *exit_code = 0;
+      if (cache_key != NULL) {
+        WriteCachedKernel(cache_key, result.kernel, result.kernel_size);
+      }
       break;
     case Dart_KernelCompilationStatus_Error:
       free(result.kernel);
@@ -224,6 +248,7 @@ void DFE::CompileAndReadScript(const char* script_uri,
       *exit_code = kErrorExitCode;
       break;
   }
+  free(cache_key);
 }
 
 void DFE::ReadScript(const char* script_uri,
@@ -243,6 +268,37 @@ void DFE::ReadScript(const char* script_uri,
                      Dart_Timeline_Event_Duration, 0, NULL, NULL);
 }
 
+MappedMemory* DFE::MapScript(const char* script_uri,
+                             uint8_t** kernel_buffer,
+                             intptr_t* kernel_buffer_size) const {
+  *kernel_buffer = NULL;
+  *kernel_buffer_size = -1;
+  File* file = File::OpenUri(NULL, script_uri, File::kRead);
+  if (file == NULL) {
+    return NULL;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if ((length <= 0) || (length > kIntptrMax)) {
+    return NULL;
+  }
+  MappedMemory* mapping = file->Map(File::kReadOnly, 0, length);
+  if (mapping == NULL) {
+    return NULL;
+  }
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(mapping->address());
+  // Kernel list files are read and concatenated by ReadScript instead.
+  if ((DartUtils::SniffForMagicNumber(buffer, length) !=
+       DartUtils::kKernelMagicNumber) ||
+      !Dart_IsKernel(buffer, length)) {
+    delete mapping;
+    return NULL;
+  }
+  *kernel_buffer = buffer;
+  *kernel_buffer_size = length;
+  return mapping;
+}
+
 // Attempts to treat [buffer] as a in-memory kernel byte representation.
 // If successful, returns [true] and places [buffer] into [kernel_ir], byte size
 // into [kernel_ir_size].
@@ -415,5 +471,266 @@ bool DFE::TryReadKernelFile(const char* script_uri,
   return TryReadSimpleKernelBuffer(buffer, kernel_ir, kernel_ir_size);
 }
 
+void DFE::set_kernel_cache(const char* directory, const char* flags) {
+  free(kernel_cache_directory_);
+  free(kernel_cache_flags_);
+  kernel_cache_directory_ = strdup(directory);
+  kernel_cache_flags_ = strdup(flags);
+}
+
+// Returns the NUL terminated contents of the file at |path|, or NULL if it
+// cannot be read. The caller must free() the result.
+static char* ReadTextFile(const char* path, intptr_t* length_out = NULL) {
+  File* file = File::Open(NULL, path, File::kRead);
+  if (file == NULL) {
+    return NULL;
+  }
+  const int64_t length = file->Length();
+  char* text = NULL;
+  if ((length >= 0) && (length < kIntptrMax)) {
+    text = reinterpret_cast<char*>(malloc(length + 1));
+    if (file->ReadFully(text, length)) {
+      text[length] = '\0';
+      if (length_out != NULL) {
+        *length_out = length;
+      }
+    } else {
+      free(text);
+      text = NULL;
+    }
+  }
+  file->Release();
+  return text;
+}
+
+// Stats |path|, with every field set to -1 if that fails.
+static void StatOrClear(const char* path, int64_t* stat) {
+  for (intptr_t i = 0; i < File::kStatSize; i++) {
+    stat[i] = -1;
+  }
+  File::Stat(NULL, path, stat);
+  if (stat[File::kType] == File::kDoesNotExist) {
+    for (intptr_t i = 0; i < File::kStatSize; i++) {
+      stat[i] = -1;
+    }
+  }
+}
+
+// 64-bit FNV-1a.
+static uint64_t KernelCacheHash(const char* data, intptr_t length) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (intptr_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Returns the packages file the front end uses for |script_uri|: the given
+// one, or else the first .packages file in the directory of the script or
+// one of its parents. The caller must free() the result.
+static char* FindPackagesFile(const char* script_uri,
+                              const char* package_config) {
+  if (package_config != NULL) {
+    return strdup(package_config);
+  }
+  const char* kFileScheme = "file://";
+  if (strncmp(script_uri, kFileScheme, strlen(kFileScheme)) == 0) {
+    script_uri += strlen(kFileScheme);
+  }
+  const char* separator = File::PathSeparator();
+  char* directory = strdup(script_uri);
+  char* last = strrchr(directory, *separator);
+  while (last != NULL) {
+    *last = '\0';
+    char* candidate =
+        OS::SCreate(NULL, "%s%s.packages", directory, separator);
+    if (File::GetType(NULL, candidate, true) == File::kIsFile) {
+      free(directory);
+      return candidate;
+    }
+    free(candidate);
+    last = strrchr(directory, *separator);
+  }
+  free(directory);
+  return NULL;
+}
+
+// Identifies a compilation by everything that determines its result other
+// than the sources: the VM, which embeds the platform libraries, the VM flags,
+// the script and the packages file with its contents.
+char* DFE::KernelCacheKey(const char* script_uri,
+                          const char* package_config) const {
+  const char* executable = Platform::GetResolvedExecutableName();
+  int64_t stat[File::kStatSize];
+  StatOrClear(executable, stat);
+  char* packages = FindPackagesFile(script_uri, package_config);
+  uint64_t packages_hash = 0;
+  if (packages != NULL) {
+    intptr_t length = 0;
+    char* contents = ReadTextFile(packages, &length);
+    if (contents != NULL) {
+      packages_hash = KernelCacheHash(contents, length);
+      free(contents);
+    }
+  }
+  char* key = OS::SCreate(
+      NULL, "%s %s %" Pd64 " %" Pd64 " %s %s %s %016" Px64,
+      Dart_VersionString(), executable, stat[File::kModifiedTime],
+      stat[File::kSize], kernel_cache_flags_, script_uri,
+      (packages != NULL) ? packages : "", packages_hash);
+  free(packages);
+  return key;
+}
+
+char* DFE::KernelCachePath(const char* key) const {
+  const uint64_t hash = KernelCacheHash(key, strlen(key));
+  return OS::SCreate(NULL, "%s%s%016" Px64 ".dill", kernel_cache_directory_,
+                     File::PathSeparator(), hash);
+}
+
+// A cache entry is a single file, so that it is replaced atomically. It
+// starts with the key of the compilation on its first line, followed by a
+// line for every file the front end read, with its modification time, size
+// and path. An empty line ends this header, and the kernel follows it.
+static bool DependencyIsUnchanged(const char* line) {
+  char* end = NULL;
+  const int64_t modified = strtoll(line, &end, 10);
+  if (*end != ' ') {
+    return false;
+  }
+  const int64_t size = strtoll(end + 1, &end, 10);
+  if (*end != ' ') {
+    return false;
+  }
+  int64_t stat[File::kStatSize];
+  StatOrClear(end + 1, stat);
+  return (stat[File::kType] == File::kIsFile) &&
+         (stat[File::kModifiedTime] == modified) && (stat[File::kSize] == size);
+}
+
+bool DFE::ReadCachedKernel(const char* key,
+                           uint8_t** kernel_buffer,
+                           intptr_t* kernel_buffer_size) const {
+  char* path = KernelCachePath(key);
+  intptr_t length = 0;
+  char* entry = ReadTextFile(path, &length);
+  free(path);
+  if (entry == NULL) {
+    return false;
+  }
+  const intptr_t key_length = strlen(key);
+  bool valid = (length > key_length) &&
+               (strncmp(entry, key, key_length) == 0) &&
+               (entry[key_length] == '\n');
+  char* line = valid ? entry + key_length + 1 : NULL;
+  while (valid && (*line != '\n')) {
+    char* end = reinterpret_cast<char*>(
+        memchr(line, '\n', length - (line - entry)));
+    if (end == NULL) {
+      valid = false;
+      break;
+    }
+    *end = '\0';
+    valid = DependencyIsUnchanged(line);
+    line = end + 1;
+  }
+  if (valid) {
+    const uint8_t* kernel = reinterpret_cast<uint8_t*>(line + 1);
+    const intptr_t kernel_size = length - (line + 1 - entry);
+    valid = (kernel_size > 0) &&
+            (DartUtils::SniffForMagicNumber(kernel, kernel_size) ==
+             DartUtils::kKernelMagicNumber);
+    if (valid) {
+      *kernel_buffer = reinterpret_cast<uint8_t*>(malloc(kernel_size));
+      memmove(*kernel_buffer, kernel, kernel_size);
+      *kernel_buffer_size = kernel_size;
+    }
+  }
+  free(entry);
+  return valid;
+}
+
+// Writes |path| through a temporary file, so that other VMs sharing the
+// cache directory never read a partially written file.
+static bool WriteFileAtomically(const char* path,
+                                const uint8_t* header,
+                                intptr_t header_length,
+                                const uint8_t* contents,
+                                intptr_t length) {
+  char* temp_path = OS::SCreate(NULL, "%s.%" Pd ".tmp", path,
+                                Process::CurrentProcessId());
+  File* file = File::Open(NULL, temp_path, File::kWriteTruncate);
+  bool success = false;
+  if (file != NULL) {
+    success = file->WriteFully(header, header_length) &&
+              file->WriteFully(contents, length);
+    file->Release();
+    success = success && File::Rename(NULL, temp_path, path);
+    if (!success) {
+      File::Delete(NULL, temp_path);
+    }
+  }
+  free(temp_path);
+  return success;
+}
+
+// Adds the line for |path| to the dependencies in |deps|. Returns false if
+// the file cannot be found, in which case the compilation is not cached.
+static bool AddDependency(const char* path, TextBuffer* deps) {
+  int64_t stat[File::kStatSize];
+  StatOrClear(path, stat);
+  if (stat[File::kType] != File::kIsFile) {
+    return false;
+  }
+  deps->Printf("%" Pd64 " %" Pd64 " %s\n", stat[File::kModifiedTime],
+               stat[File::kSize], path);
+  return true;
+}
+
+void DFE::WriteCachedKernel(const char* key,
+                            const uint8_t* kernel_buffer,
+                            intptr_t kernel_buffer_size) const {
+  // The front end lists the files it read as paths separated by spaces, with
+  // spaces and backslashes in them escaped by a backslash.
+  Dart_KernelCompilationResult result = Dart_KernelListDependencies();
+  if (result.status != Dart_KernelCompilationStatus_Ok) {
+    free(result.error);
+    return;
+  }
+  const char* list = reinterpret_cast<const char*>(result.kernel);
+  TextBuffer header(1024);
+  header.Printf("%s\n", key);
+  char* path = reinterpret_cast<char*>(malloc(result.kernel_size + 1));
+  intptr_t path_length = 0;
+  bool success = true;
+  for (intptr_t i = 0; success && (i <= result.kernel_size); i++) {
+    if ((i == result.kernel_size) || (list[i] == ' ')) {
+      if (path_length > 0) {
+        path[path_length] = '\0';
+        success = AddDependency(path, &header);
+        path_length = 0;
+      }
+      continue;
+    }
+    if ((list[i] == '\\') && (i + 1 < result.kernel_size)) {
+      i++;
+    }
+    path[path_length++] = list[i];
+  }
+  free(path);
+  free(result.kernel);
+
+  if (success) {
+    header.Printf("\n");
+    Directory::Create(NULL, kernel_cache_directory_);
+    char* entry_path = KernelCachePath(key);
+    WriteFileAtomically(entry_path,
+                        reinterpret_cast<const uint8_t*>(header.buf()),
+                        header.length(), kernel_buffer, kernel_buffer_size);
+    free(entry_path);
+  }
+}
+
 }  // namespace bin
 }  // namespace dart
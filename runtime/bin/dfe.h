@@ -13,6 +13,8 @@
 namespace dart {
 namespace bin {
 
+class MappedMemory;
+
 class DFE {
  public:
   DFE();
@@ -39,6 +41,11 @@ class DFE {
   }
   bool use_incremental_compiler() const { return use_incremental_compiler_; }
 
+  // Caches the kernel compiled from scripts in |directory|. A cached kernel
+  // file is reused as long as the VM, the VM flags in |flags| and the files
+  // the front end read to produce it are unchanged.
+  void set_kernel_cache(const char* directory, const char* flags);
+
   // Returns the platform binary file name if the path to
   // kernel binaries was set using SetKernelBinaries.
   const char* GetPlatformBinaryFilename();
@@ -78,6 +85,14 @@ class DFE {
                   uint8_t** kernel_buffer,
                   intptr_t* kernel_buffer_size) const;
 
+  // Maps the script kernel file into memory if specified 'script_uri' is a
+  // single kernel file, so that the kernel binary is not copied. Returns the
+  // mapping, which owns the returned kernel buffer, or NULL if the file is
+  // not a kernel file or cannot be mapped.
+  MappedMemory* MapScript(const char* script_uri,
+                          uint8_t** kernel_buffer,
+                          intptr_t* kernel_buffer_size) const;
+
   static bool KernelServiceDillAvailable();
 
   // Tries to read [script_uri] as a Kernel IR file.
@@ -101,10 +116,24 @@ class DFE {
                          intptr_t* kernel_service_buffer_size);
 
  private:
+  char* KernelCacheKey(const char* script_uri,
+                       const char* package_config) const;
+  char* KernelCachePath(const char* key) const;
+  bool ReadCachedKernel(const char* key,
+                        uint8_t** kernel_buffer,
+                        intptr_t* kernel_buffer_size) const;
+  void WriteCachedKernel(const char* key,
+                         const uint8_t* kernel_buffer,
+                         intptr_t kernel_buffer_size) const;
+
   bool use_dfe_;
   bool use_incremental_compiler_;
   char* frontend_filename_;
 
+  // Set by set_kernel_cache, NULL if compiled scripts are not cached.
+  char* kernel_cache_directory_;
+  char* kernel_cache_flags_;
+
   // Kernel binary specified on the cmd line.
   uint8_t* application_kernel_buffer_;
   intptr_t application_kernel_buffer_size_;
@@ -398,7 +398,9 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
+  // Two slots per entry. Large batches keep the number of round trips
+  // through the IO service down when listing big trees.
+  const int kArraySize = 1024;
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
@@ -450,14 +452,12 @@ bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
                                                           const char* arg) {
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
   if (arg != NULL) {
+    // Paths are short, so they are copied into the Dart heap with the
+    // response rather than each getting an external buffer and a finalizer.
     size_t len = strlen(arg);
-    Dart_CObject* io_buffer = CObject::NewIOBuffer(len);
-    uint8_t* data = io_buffer->value.as_external_typed_data.data;
-    strncpy(reinterpret_cast<char*>(data), arg, len);
-
-    CObjectExternalUint8Array* external_array =
-        new CObjectExternalUint8Array(io_buffer);
-    array_->SetAt(index_++, external_array);
+    Dart_CObject* path = CObject::NewUint8Array(len);
+    memmove(path->value.as_typed_data.values, arg, len);
+    array_->SetAt(index_++, new CObjectUint8Array(path));
   } else {
     array_->SetAt(index_++, CObject::Null());
   }
@@ -0,0 +1,467 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/elf_writer.h"
+
+#include "bin/file.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+// The structures below follow the System V ABI. Since gen_snapshot runs on a
+// host with the word size of its target, and all targets are little endian,
+// they can be written as they are laid out in memory.
+
+#if defined(ARCH_IS_32_BIT)
+static const uint8_t kElfClass = 1;  // ELFCLASS32
+#else
+static const uint8_t kElfClass = 2;  // ELFCLASS64
+#endif
+
+#if defined(TARGET_ARCH_IA32) ||                                               \
+    (defined(TARGET_ARCH_DBC) && defined(HOST_ARCH_IA32))
+static const uint16_t kElfMachine = 3;  // EM_386
+static const uint32_t kElfFlags = 0;
+#elif defined(TARGET_ARCH_X64) ||                                              \
+    (defined(TARGET_ARCH_DBC) && defined(HOST_ARCH_X64))
+static const uint16_t kElfMachine = 62;  // EM_X86_64
+static const uint32_t kElfFlags = 0;
+#elif defined(TARGET_ARCH_ARM) ||                                              \
+    (defined(TARGET_ARCH_DBC) && defined(HOST_ARCH_ARM))
+static const uint16_t kElfMachine = 40;          // EM_ARM
+static const uint32_t kElfFlags = 0x05000000;  // EF_ARM_EABI_VER5
+#elif defined(TARGET_ARCH_ARM64) ||                                            \
+    (defined(TARGET_ARCH_DBC) && defined(HOST_ARCH_ARM64))
+static const uint16_t kElfMachine = 183;  // EM_AARCH64
+static const uint32_t kElfFlags = 0;
+#else
+#error Unknown architecture.
+#endif
+
+struct ElfHeader {
+  uint8_t ident[16];
+  uint16_t type;
+  uint16_t machine;
+  uint32_t version;
+  uword entry;
+  uword program_table_offset;
+  uword section_table_offset;
+  uint32_t flags;
+  uint16_t header_size;
+  uint16_t program_table_entry_size;
+  uint16_t program_table_entry_count;
+  uint16_t section_table_entry_size;
+  uint16_t section_table_entry_count;
+  uint16_t section_names_index;
+};
+
+struct ElfProgramHeader {
+#if defined(ARCH_IS_32_BIT)
+  uint32_t type;
+  uint32_t offset;
+  uint32_t vaddr;
+  uint32_t paddr;
+  uint32_t file_size;
+  uint32_t memory_size;
+  uint32_t flags;
+  uint32_t alignment;
+#else
+  uint32_t type;
+  uint32_t flags;
+  uint64_t offset;
+  uint64_t vaddr;
+  uint64_t paddr;
+  uint64_t file_size;
+  uint64_t memory_size;
+  uint64_t alignment;
+#endif
+};
+
+struct ElfSectionHeader {
+  uint32_t name;
+  uint32_t type;
+  uword flags;
+  uword address;
+  uword offset;
+  uword size;
+  uint32_t link;
+  uint32_t info;
+  uword alignment;
+  uword entry_size;
+};
+
+struct ElfSymbol {
+#if defined(ARCH_IS_32_BIT)
+  uint32_t name;
+  uint32_t value;
+  uint32_t size;
+  uint8_t info;
+  uint8_t other;
+  uint16_t section;
+#else
+  uint32_t name;
+  uint8_t info;
+  uint8_t other;
+  uint16_t section;
+  uint64_t value;
+  uint64_t size;
+#endif
+};
+
+struct ElfDynamicEntry {
+  intptr_t tag;
+  uword value;
+};
+
+#if defined(ARCH_IS_32_BIT)
+COMPILE_ASSERT(sizeof(ElfHeader) == 52);
+COMPILE_ASSERT(sizeof(ElfProgramHeader) == 32);
+COMPILE_ASSERT(sizeof(ElfSectionHeader) == 40);
+COMPILE_ASSERT(sizeof(ElfSymbol) == 16);
+#else
+COMPILE_ASSERT(sizeof(ElfHeader) == 64);
+COMPILE_ASSERT(sizeof(ElfProgramHeader) == 56);
+COMPILE_ASSERT(sizeof(ElfSectionHeader) == 64);
+COMPILE_ASSERT(sizeof(ElfSymbol) == 24);
+#endif
+
+static const uint16_t ET_DYN = 3;
+
+static const uint32_t PT_LOAD = 1;
+static const uint32_t PT_DYNAMIC = 2;
+static const uint32_t PT_GNU_STACK = 0x6474e551;
+
+static const uint32_t PF_X = 1;
+static const uint32_t PF_W = 2;
+static const uint32_t PF_R = 4;
+
+static const uint32_t SHT_PROGBITS = 1;
+static const uint32_t SHT_STRTAB = 3;
+static const uint32_t SHT_HASH = 5;
+static const uint32_t SHT_DYNAMIC = 6;
+static const uint32_t SHT_DYNSYM = 11;
+
+static const uword SHF_WRITE = 1;
+static const uword SHF_ALLOC = 2;
+static const uword SHF_EXECINSTR = 4;
+
+static const uint8_t STB_GLOBAL = 1;
+static const uint8_t STT_OBJECT = 1;
+static const uint8_t STT_FUNC = 2;
+
+static const intptr_t DT_NULL = 0;
+static const intptr_t DT_HASH = 4;
+static const intptr_t DT_STRTAB = 5;
+static const intptr_t DT_SYMTAB = 6;
+static const intptr_t DT_STRSZ = 10;
+static const intptr_t DT_SYMENT = 11;
+
+// Segments are aligned for the largest page size of the supported targets,
+// so that the loader can map every blob directly from the file.
+static const intptr_t kElfPageSize = 16 * KB;
+
+enum Section {
+  kNullSection,
+  kDynamicSymbolSection,
+  kDynamicStringSection,
+  kHashSection,
+  kDataSection,
+  kTextSection,
+  kDynamicSection,
+  kSectionNamesSection,
+  kSectionCount,
+};
+
+enum Segment {
+  kReadOnlySegment,
+  kExecutableSegment,
+  kWritableSegment,
+  kDynamicSegment,
+  kStackSegment,
+  kSegmentCount,
+};
+
+// Symbols in the order of the blobs passed to WriteAppAOTSnapshot.
+static const intptr_t kBlobCount = 4;
+static const char* kSymbolNames[kBlobCount] = {
+    "_kDartVmSnapshotData", "_kDartVmSnapshotInstructions",
+    "_kDartIsolateSnapshotData", "_kDartIsolateSnapshotInstructions",
+};
+// The null symbol comes first.
+static const intptr_t kSymbolCount = kBlobCount + 1;
+
+static const char kSectionNames[] =
+    "\0.dynsym\0.dynstr\0.hash\0.rodata\0.text\0.dynamic\0.shstrtab";
+
+// The System V hash function for the symbols in the .hash section.
+static uint32_t ElfHash(const char* name) {
+  uint32_t hash = 0;
+  for (; *name != '\0'; name++) {
+    hash = (hash << 4) + static_cast<uint8_t>(*name);
+    const uint32_t high = hash & 0xf0000000;
+    hash ^= high >> 24;
+    hash &= ~high;
+  }
+  return hash;
+}
+
+// Returns the offset of |name| in the NUL separated |table|.
+static uint32_t NameOffset(const char* table, intptr_t length,
+                           const char* name) {
+  for (intptr_t offset = 0; offset < length;
+       offset += strlen(table + offset) + 1) {
+    if (strcmp(table + offset, name) == 0) {
+      return offset;
+    }
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+bool ElfWriter::Write(const void* buffer, intptr_t size) {
+  position_ += size;
+  return (size == 0) || file_->WriteFully(buffer, size);
+}
+
+bool ElfWriter::PadTo(intptr_t position) {
+  ASSERT(position >= position_);
+  static const uint8_t kZeros[256] = {0};
+  while (position_ < position) {
+    const intptr_t size = Utils::Minimum<intptr_t>(position - position_,
+                                                  sizeof(kZeros));
+    if (!Write(kZeros, size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ElfWriter::WriteAppAOTSnapshot(const uint8_t* vm_data_buffer,
+                                    intptr_t vm_data_size,
+                                    const uint8_t* vm_instructions_buffer,
+                                    intptr_t vm_instructions_size,
+                                    const uint8_t* isolate_data_buffer,
+                                    intptr_t isolate_data_size,
+                                    const uint8_t* isolate_instructions_buffer,
+                                    intptr_t isolate_instructions_size) {
+  const uint8_t* blobs[kBlobCount] = {
+      vm_data_buffer, vm_instructions_buffer, isolate_data_buffer,
+      isolate_instructions_buffer,
+  };
+  const intptr_t blob_sizes[kBlobCount] = {
+      vm_data_size, vm_instructions_size, isolate_data_size,
+      isolate_instructions_size,
+  };
+  const bool blob_is_text[kBlobCount] = {false, true, false, true};
+
+  // The dynamic string table, with the names in symbol order.
+  intptr_t dynamic_strings_size = 1;
+  for (intptr_t i = 0; i < kBlobCount; i++) {
+    dynamic_strings_size += strlen(kSymbolNames[i]) + 1;
+  }
+  char* dynamic_strings = reinterpret_cast<char*>(malloc(dynamic_strings_size));
+  dynamic_strings[0] = '\0';
+  uint32_t symbol_name_offsets[kBlobCount];
+  {
+    intptr_t offset = 1;
+    for (intptr_t i = 0; i < kBlobCount; i++) {
+      symbol_name_offsets[i] = offset;
+      strcpy(dynamic_strings + offset, kSymbolNames[i]);  // NOLINT
+      offset += strlen(kSymbolNames[i]) + 1;
+    }
+  }
+
+  // The file is laid out in the order of the sections, and every allocated
+  // section is loaded at the address equal to its offset in the file.
+  uword offsets[kSectionCount];
+  uword sizes[kSectionCount];
+  offsets[kNullSection] = 0;
+  sizes[kNullSection] = 0;
+  offsets[kDynamicSymbolSection] =
+      Utils::RoundUp(sizeof(ElfHeader) + kSegmentCount *
+                     sizeof(ElfProgramHeader), kWordSize);
+  sizes[kDynamicSymbolSection] = kSymbolCount * sizeof(ElfSymbol);
+  offsets[kDynamicStringSection] =
+      offsets[kDynamicSymbolSection] + sizes[kDynamicSymbolSection];
+  sizes[kDynamicStringSection] = dynamic_strings_size;
+  // One bucket and one chain entry per symbol.
+  const intptr_t bucket_count = kSymbolCount;
+  offsets[kHashSection] = Utils::RoundUp(
+      offsets[kDynamicStringSection] + sizes[kDynamicStringSection],
+      sizeof(uint32_t));
+  sizes[kHashSection] = (2 + bucket_count + kSymbolCount) * sizeof(uint32_t);
+
+  // Every blob starts on a page, as with the other snapshot formats.
+  uword blob_offsets[kBlobCount];
+  uword end = offsets[kHashSection] + sizes[kHashSection];
+  for (intptr_t text = 0; text <= 1; text++) {
+    const intptr_t section = (text == 1) ? kTextSection : kDataSection;
+    end = Utils::RoundUp(end, kElfPageSize);
+    offsets[section] = end;
+    for (intptr_t i = 0; i < kBlobCount; i++) {
+      if (blob_is_text[i] == (text == 1)) {
+        end = Utils::RoundUp(end, kElfPageSize);
+        blob_offsets[i] = end;
+        end += blob_sizes[i];
+      }
+    }
+    sizes[section] = end - offsets[section];
+  }
+  const intptr_t dynamic_entry_count = 6;
+  offsets[kDynamicSection] = Utils::RoundUp(end, kElfPageSize);
+  sizes[kDynamicSection] = dynamic_entry_count * sizeof(ElfDynamicEntry);
+  offsets[kSectionNamesSection] =
+      offsets[kDynamicSection] + sizes[kDynamicSection];
+  sizes[kSectionNamesSection] = sizeof(kSectionNames);
+  const uword section_table_offset = Utils::RoundUp(
+      offsets[kSectionNamesSection] + sizes[kSectionNamesSection], kWordSize);
+
+  ElfHeader header;
+  memset(&header, 0, sizeof(header));
+  header.ident[0] = 0x7f;
+  header.ident[1] = 'E';
+  header.ident[2] = 'L';
+  header.ident[3] = 'F';
+  header.ident[4] = kElfClass;
+  header.ident[5] = 1;  // ELFDATA2LSB
+  header.ident[6] = 1;  // EV_CURRENT
+  header.type = ET_DYN;
+  header.machine = kElfMachine;
+  header.version = 1;
+  header.program_table_offset = sizeof(ElfHeader);
+  header.section_table_offset = section_table_offset;
+  header.flags = kElfFlags;
+  header.header_size = sizeof(ElfHeader);
+  header.program_table_entry_size = sizeof(ElfProgramHeader);
+  header.program_table_entry_count = kSegmentCount;
+  header.section_table_entry_size = sizeof(ElfSectionHeader);
+  header.section_table_entry_count = kSectionCount;
+  header.section_names_index = kSectionNamesSection;
+
+  ElfProgramHeader segments[kSegmentCount];
+  memset(&segments, 0, sizeof(segments));
+  segments[kReadOnlySegment].type = PT_LOAD;
+  segments[kReadOnlySegment].flags = PF_R;
+  segments[kReadOnlySegment].offset = 0;
+  segments[kReadOnlySegment].file_size =
+      offsets[kDataSection] + sizes[kDataSection];
+  segments[kExecutableSegment].type = PT_LOAD;
+  segments[kExecutableSegment].flags = PF_R | PF_X;
+  segments[kExecutableSegment].offset = offsets[kTextSection];
+  segments[kExecutableSegment].file_size = sizes[kTextSection];
+  segments[kWritableSegment].type = PT_LOAD;
+  segments[kWritableSegment].flags = PF_R | PF_W;
+  segments[kWritableSegment].offset = offsets[kDynamicSection];
+  segments[kWritableSegment].file_size = sizes[kDynamicSection];
+  segments[kDynamicSegment].type = PT_DYNAMIC;
+  segments[kDynamicSegment].flags = PF_R | PF_W;
+  segments[kDynamicSegment].offset = offsets[kDynamicSection];
+  segments[kDynamicSegment].file_size = sizes[kDynamicSection];
+  for (intptr_t i = 0; i < kDynamicSegment; i++) {
+    segments[i].alignment = kElfPageSize;
+  }
+  segments[kDynamicSegment].alignment = kWordSize;
+  for (intptr_t i = 0; i < kStackSegment; i++) {
+    segments[i].vaddr = segments[i].paddr = segments[i].offset;
+    segments[i].memory_size = segments[i].file_size;
+  }
+  // Without this the loader would make the stack executable.
+  segments[kStackSegment].type = PT_GNU_STACK;
+  segments[kStackSegment].flags = PF_R | PF_W;
+  segments[kStackSegment].alignment = 16;
+
+  ElfSymbol symbols[kSymbolCount];
+  memset(&symbols, 0, sizeof(symbols));
+  for (intptr_t i = 0; i < kBlobCount; i++) {
+    ElfSymbol* symbol = &symbols[i + 1];
+    symbol->name = symbol_name_offsets[i];
+    const uint8_t type = blob_is_text[i] ? STT_FUNC : STT_OBJECT;
+    symbol->info = (STB_GLOBAL << 4) | type;
+    symbol->section = blob_is_text[i] ? kTextSection : kDataSection;
+    symbol->value = blob_offsets[i];
+    symbol->size = blob_sizes[i];
+  }
+
+  uint32_t hash[2 + bucket_count + kSymbolCount];
+  memset(&hash, 0, sizeof(hash));
+  hash[0] = bucket_count;
+  hash[1] = kSymbolCount;
+  uint32_t* buckets = &hash[2];
+  uint32_t* chains = &hash[2 + bucket_count];
+  for (intptr_t i = 1; i < kSymbolCount; i++) {
+    const uint32_t bucket = ElfHash(kSymbolNames[i - 1]) % bucket_count;
+    chains[i] = buckets[bucket];
+    buckets[bucket] = i;
+  }
+
+  const ElfDynamicEntry dynamic[dynamic_entry_count] = {
+      {DT_HASH, offsets[kHashSection]},
+      {DT_STRTAB, offsets[kDynamicStringSection]},
+      {DT_SYMTAB, offsets[kDynamicSymbolSection]},
+      {DT_STRSZ, sizes[kDynamicStringSection]},
+      {DT_SYMENT, sizeof(ElfSymbol)},
+      {DT_NULL, 0},
+  };
+
+  ElfSectionHeader sections[kSectionCount];
+  memset(&sections, 0, sizeof(sections));
+  static const char* kNames[kSectionCount] = {
+      "", ".dynsym", ".dynstr", ".hash", ".rodata", ".text", ".dynamic",
+      ".shstrtab",
+  };
+  static const uint32_t kTypes[kSectionCount] = {
+      0,           SHT_DYNSYM,    SHT_STRTAB,  SHT_HASH,
+      SHT_PROGBITS, SHT_PROGBITS, SHT_DYNAMIC, SHT_STRTAB,
+  };
+  for (intptr_t i = 1; i < kSectionCount; i++) {
+    sections[i].name =
+        NameOffset(kSectionNames, sizeof(kSectionNames), kNames[i]);
+    sections[i].type = kTypes[i];
+    sections[i].offset = offsets[i];
+    sections[i].size = sizes[i];
+    sections[i].alignment = 1;
+    if (i != kSectionNamesSection) {
+      sections[i].flags = SHF_ALLOC;
+      sections[i].address = offsets[i];
+    }
+  }
+  sections[kDynamicSymbolSection].link = kDynamicStringSection;
+  sections[kDynamicSymbolSection].info = 1;  // The first global symbol.
+  sections[kDynamicSymbolSection].alignment = kWordSize;
+  sections[kDynamicSymbolSection].entry_size = sizeof(ElfSymbol);
+  sections[kHashSection].link = kDynamicSymbolSection;
+  sections[kHashSection].alignment = sizeof(uint32_t);
+  sections[kHashSection].entry_size = sizeof(uint32_t);
+  sections[kDataSection].alignment = kElfPageSize;
+  sections[kTextSection].flags |= SHF_EXECINSTR;
+  sections[kTextSection].alignment = kElfPageSize;
+  sections[kDynamicSection].flags |= SHF_WRITE;
+  sections[kDynamicSection].link = kDynamicStringSection;
+  sections[kDynamicSection].alignment = kWordSize;
+  sections[kDynamicSection].entry_size = sizeof(ElfDynamicEntry);
+
+  bool success = Write(&header, sizeof(header)) &&
+                 Write(&segments, sizeof(segments)) &&
+                 PadTo(offsets[kDynamicSymbolSection]) &&
+                 Write(&symbols, sizeof(symbols)) &&
+                 Write(dynamic_strings, dynamic_strings_size) &&
+                 PadTo(offsets[kHashSection]) && Write(&hash, sizeof(hash));
+  free(dynamic_strings);
+  for (intptr_t text = 0; success && (text <= 1); text++) {
+    for (intptr_t i = 0; success && (i < kBlobCount); i++) {
+      if (blob_is_text[i] == (text == 1)) {
+        success = PadTo(blob_offsets[i]) && Write(blobs[i], blob_sizes[i]);
+      }
+    }
+  }
+  return success && PadTo(offsets[kDynamicSection]) &&
+         Write(&dynamic, sizeof(dynamic)) &&
+         Write(kSectionNames, sizeof(kSectionNames)) &&
+         PadTo(section_table_offset) && Write(&sections, sizeof(sections));
+}
+
+}  // namespace bin
+}  // namespace dart
@@ -0,0 +1,47 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_ELF_WRITER_H_
+#define RUNTIME_BIN_ELF_WRITER_H_
+
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+class File;
+
+// Writes an AOT snapshot as an ELF shared object for the target architecture.
+// The data blobs are placed in a read-only segment and the instructions blobs
+// in an executable one, each starting on a page boundary. They are exported
+// under the same dynamic symbols as the output of AssemblyImageWriter, so the
+// result can be loaded with dlopen like a snapshot assembled with a C
+// toolchain.
+class ElfWriter {
+ public:
+  explicit ElfWriter(File* file) : file_(file), position_(0) {}
+
+  bool WriteAppAOTSnapshot(const uint8_t* vm_data_buffer,
+                           intptr_t vm_data_size,
+                           const uint8_t* vm_instructions_buffer,
+                           intptr_t vm_instructions_size,
+                           const uint8_t* isolate_data_buffer,
+                           intptr_t isolate_data_size,
+                           const uint8_t* isolate_instructions_buffer,
+                           intptr_t isolate_instructions_size);
+
+ private:
+  bool Write(const void* buffer, intptr_t size);
+  bool PadTo(intptr_t position);
+
+  File* file_;
+  intptr_t position_;
+
+  DISALLOW_COPY_AND_ASSIGN(ElfWriter);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_ELF_WRITER_H_
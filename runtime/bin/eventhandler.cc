@@ -55,17 +55,45 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
   }
 }
 
-static EventHandler* event_handler = NULL;
+// The event handlers, each with its own thread and set of descriptors. An
+// isolate always uses the same one, chosen by its main port, so the
+// descriptors it creates are all polled by one thread.
+static EventHandler** event_handlers = NULL;
+static intptr_t event_handler_count = 0;
 static Monitor* shutdown_monitor = NULL;
 
+intptr_t EventHandler::thread_count_ = 1;
+
+void EventHandler::set_thread_count(intptr_t count) {
+  ASSERT(event_handlers == NULL);
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+  if (count < 1) {
+    count = 1;
+  } else if (count > kMaxThreadCount) {
+    count = kMaxThreadCount;
+  }
+  thread_count_ = count;
+#else
+  // Handles are bound to the one completion port or port set of the event
+  // handler when they are created, so only one is supported here.
+  USE(count);
+#endif
+}
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
 
-  ASSERT(event_handler == NULL);
+  ASSERT(event_handlers == NULL);
   shutdown_monitor = new Monitor();
-  event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+  event_handler_count = thread_count_;
+  event_handlers = new EventHandler*[event_handler_count];
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    event_handlers[i] = new EventHandler();
+  }
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    event_handlers[i]->delegate_.Start(event_handlers[i]);
+  }
 }
 
 void EventHandler::NotifyShutdownDone() {
@@ -74,22 +102,26 @@ void EventHandler::NotifyShutdownDone() {
 }
 
 void EventHandler::Stop() {
-  if (event_handler == NULL) {
+  if (event_handlers == NULL) {
     return;
   }
 
-  // Wait until it has stopped.
-  {
+  // Wait until they have stopped, one at a time.
+  for (intptr_t i = 0; i < event_handler_count; i++) {
     MonitorLocker ml(shutdown_monitor);
 
     // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
+    event_handlers[i]->delegate_.Shutdown();
     ml.Wait(Monitor::kNoTimeout);
   }
 
   // Cleanup
-  delete event_handler;
-  event_handler = NULL;
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    delete event_handlers[i];
+  }
+  delete[] event_handlers;
+  event_handlers = NULL;
+  event_handler_count = 0;
   delete shutdown_monitor;
   shutdown_monitor = NULL;
 
@@ -97,15 +129,26 @@ void EventHandler::Stop() {
   ListeningSocketRegistry::Cleanup();
 }
 
+EventHandler* EventHandler::ForIsolate(Dart_Port isolate_port) {
+  ASSERT(event_handlers != NULL);
+  if (event_handler_count == 1) {
+    return event_handlers[0];
+  }
+  uint64_t hash = static_cast<uint64_t>(isolate_port);
+  return event_handlers[(hash ^ (hash >> 32)) % event_handler_count];
+}
+
 EventHandlerImplementation* EventHandler::delegate() {
-  if (event_handler == NULL) {
+  if (event_handlers == NULL) {
     return NULL;
   }
-  return &event_handler->delegate_;
+  return &event_handlers[0]->delegate_;
 }
 
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
-  event_handler->SendData(id, port, data);
+  ASSERT(id != kTimerId);
+  Socket* socket = reinterpret_cast<Socket*>(id);
+  ForIsolate(socket->isolate_port())->SendData(id, port, data);
 }
 
 /*
@@ -124,14 +167,19 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
   }
   Dart_Handle sender = Dart_GetNativeArgument(args, 0);
   intptr_t id;
+  EventHandler* event_handler;
   if (Dart_IsNull(sender)) {
     id = kTimerId;
+    event_handler = EventHandler::ForIsolate(Dart_GetMainPortId());
   } else {
     Socket* socket = Socket::GetSocketIdNativeField(sender);
     ASSERT(dart_port != ILLEGAL_PORT);
     socket->set_port(dart_port);
     socket->Retain();  // inc refcount before sending to the eventhandler.
     id = reinterpret_cast<intptr_t>(socket);
+    // A listening socket shared between isolates stays with the event handler
+    // of the isolate that created it.
+    event_handler = EventHandler::ForIsolate(socket->isolate_port());
   }
   int64_t data = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
   event_handler->SendData(id, dart_port, data);
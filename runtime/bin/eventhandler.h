@@ -639,12 +639,30 @@ class EventHandler {
    */
   static void Stop();
 
+  /**
+   * Set the number of event-handler threads started by Start. Only Linux and
+   * Android support more than one.
+   */
+  static void set_thread_count(intptr_t count);
+  static intptr_t thread_count() { return thread_count_; }
+
+  /**
+   * The event-handler polling the descriptors of the isolate with the given
+   * main port.
+   */
+  static EventHandler* ForIsolate(Dart_Port isolate_port);
+
+  // The delegate of the first event-handler.
   static EventHandlerImplementation* delegate();
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
  private:
   friend class EventHandlerImplementation;
+
+  static const intptr_t kMaxThreadCount = 64;
+  static intptr_t thread_count_;
+
   EventHandlerImplementation delegate_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
@@ -9,13 +9,16 @@
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
 #include "bin/namespace.h"
+#include "bin/thread.h"
 #include "bin/typed_data_utils.h"
 #include "bin/utils.h"
 #include "include/bin/dart_io_api.h"
 #include "include/dart_api.h"
 #include "include/dart_tools_api.h"
 #include "platform/globals.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -290,6 +293,238 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
   }
 }
 
+// A positioned read or write started by File_ReadAt or File_WriteAt. These
+// run on a few threads of their own instead of the IO service, and post their
+// result straight to the reply port: the number of bytes written, the bytes
+// read, or an OS error. This avoids building the request and response as
+// CObject arrays.
+//
+// The request owns its data, a native buffer that the bytes are copied into
+// or out of. The Dart buffer may be freed while the request is running, for
+// example when the isolate that started it shuts down.
+class FileIORequest {
+ public:
+  FileIORequest(File* file,
+                bool is_write,
+                uint8_t* data,
+                int64_t length,
+                int64_t position,
+                Dart_Port reply_port)
+      : file_(file),
+        is_write_(is_write),
+        data_(data),
+        length_(length),
+        position_(position),
+        reply_port_(reply_port),
+        next_(NULL) {}
+
+  ~FileIORequest() {
+    if (data_ != NULL) {
+      IOBuffer::Free(data_);
+    }
+    file_->Release();
+  }
+
+  // Queues the request, starting another thread if none is idle.
+  static bool Enqueue(FileIORequest* request);
+
+ private:
+  static const intptr_t kMaxThreads = 8;
+  static const int64_t kIdleTimeoutMillis = 5000;
+
+  static void ThreadMain(uword parameters);
+
+  // Created on first use, so that nothing is allocated by static
+  // initializers.
+  static Monitor* monitor() {
+    static Monitor* monitor = new Monitor();
+    return monitor;
+  }
+
+  void Run();
+  void PostError();
+
+  File* file_;
+  bool is_write_;
+  uint8_t* data_;
+  int64_t length_;
+  int64_t position_;
+  Dart_Port reply_port_;
+  FileIORequest* next_;
+
+  static FileIORequest* head_;
+  static FileIORequest* tail_;
+  static intptr_t threads_;
+  static intptr_t idle_threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileIORequest);
+};
+
+FileIORequest* FileIORequest::head_ = NULL;
+FileIORequest* FileIORequest::tail_ = NULL;
+intptr_t FileIORequest::threads_ = 0;
+intptr_t FileIORequest::idle_threads_ = 0;
+
+bool FileIORequest::Enqueue(FileIORequest* request) {
+  MonitorLocker ml(monitor());
+  if ((idle_threads_ == 0) && (threads_ < kMaxThreads)) {
+    if (Thread::Start(&FileIORequest::ThreadMain, 0) != 0) {
+      if (threads_ == 0) {
+        return false;
+      }
+    } else {
+      threads_++;
+    }
+  }
+  if (tail_ == NULL) {
+    head_ = request;
+  } else {
+    tail_->next_ = request;
+  }
+  tail_ = request;
+  ml.Notify();
+  return true;
+}
+
+void FileIORequest::ThreadMain(uword parameters) {
+  while (true) {
+    FileIORequest* request;
+    {
+      MonitorLocker ml(monitor());
+      while (head_ == NULL) {
+        idle_threads_++;
+        Monitor::WaitResult result = ml.Wait(kIdleTimeoutMillis);
+        idle_threads_--;
+        if ((result == Monitor::kTimedOut) && (head_ == NULL)) {
+          threads_--;
+          return;
+        }
+      }
+      request = head_;
+      head_ = request->next_;
+      if (head_ == NULL) {
+        tail_ = NULL;
+      }
+    }
+    request->Run();
+    delete request;
+  }
+}
+
+void FileIORequest::Run() {
+  if (is_write_) {
+    int64_t written = 0;
+    while (written < length_) {
+      int64_t result = file_->WriteAt(data_ + written, length_ - written,
+                                      position_ + written);
+      if (result < 0) {
+        PostError();
+        return;
+      }
+      written += result;
+    }
+    Dart_PostInteger(reply_port_, written);
+    return;
+  }
+  int64_t bytes_read = file_->ReadAt(data_, length_, position_);
+  if (bytes_read < 0) {
+    PostError();
+  } else if (bytes_read == 0) {
+    Dart_PostInteger(reply_port_, bytes_read);
+  } else {
+    // Hand the buffer over to the message.
+    Dart_CObject message;
+    message.type = Dart_CObject_kExternalTypedData;
+    message.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    message.value.as_external_typed_data.length = bytes_read;
+    message.value.as_external_typed_data.data = data_;
+    message.value.as_external_typed_data.peer = data_;
+    message.value.as_external_typed_data.callback = IOBuffer::Finalizer;
+    if (Dart_PostCObject(reply_port_, &message)) {
+      data_ = NULL;
+    }
+  }
+}
+
+void FileIORequest::PostError() {
+  OSError os_error;
+  Dart_CObject kind;
+  kind.type = Dart_CObject_kInt32;
+  kind.value.as_int32 = CObject::kOSError;
+  Dart_CObject code;
+  code.type = Dart_CObject_kInt32;
+  code.value.as_int32 = os_error.code();
+  Dart_CObject message;
+  message.type = Dart_CObject_kString;
+  message.value.as_string = const_cast<char*>(os_error.message());
+  Dart_CObject* values[] = {&kind, &code, &message};
+  Dart_CObject error;
+  error.type = Dart_CObject_kArray;
+  error.value.as_array.length = sizeof(values) / sizeof(values[0]);
+  error.value.as_array.values = values;
+  Dart_PostCObject(reply_port_, &error);
+}
+
+static void StartFileIORequest(Dart_NativeArguments args, bool is_write) {
+  File* file = GetFile(args);
+  ASSERT(file != NULL);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  // The arguments are checked in Dart code.
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  int64_t position =
+      DartUtils::GetInt64ValueCheckRange(Dart_GetNativeArgument(args, 4), 0,
+                                         kMaxInt64);
+  Dart_Port reply_port = ILLEGAL_PORT;
+  ThrowIfError(
+      Dart_SendPortGetId(Dart_GetNativeArgument(args, 5), &reply_port));
+  intptr_t length = end - start;
+
+  // The bytes are always copied. Accessing the Dart buffer in place from
+  // another thread is not safe, as nothing native keeps it alive.
+  uint8_t* data = IOBuffer::Allocate(length);
+  if (data == NULL) {
+    OSError os_error(-1, "Out of memory", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  if (is_write) {
+    Dart_TypedData_Type type;
+    void* buffer = NULL;
+    intptr_t buffer_length = 0;
+    Dart_Handle result = Dart_TypedDataAcquireData(buffer_obj, &type, &buffer,
+                                                   &buffer_length);
+    if (Dart_IsError(result)) {
+      IOBuffer::Free(data);
+      Dart_PropagateError(result);
+    }
+    ASSERT(type == Dart_TypedData_kUint8 || type == Dart_TypedData_kInt8);
+    ASSERT(end <= buffer_length);
+    memmove(data, reinterpret_cast<uint8_t*>(buffer) + start, length);
+    ThrowIfError(Dart_TypedDataReleaseData(buffer_obj));
+  }
+
+  file->Retain();
+  FileIORequest* request = new FileIORequest(file, is_write, data, length,
+                                             position, reply_port);
+  if (!FileIORequest::Enqueue(request)) {
+    delete request;
+    OSError os_error(-1, "Failed to start a file IO thread",
+                     OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  Dart_SetReturnValue(args, Dart_Null());
+}
+
+void FUNCTION_NAME(File_ReadAt)(Dart_NativeArguments args) {
+  StartFileIORequest(args, false);
+}
+
+void FUNCTION_NAME(File_WriteAt)(Dart_NativeArguments args) {
+  StartFileIORequest(args, true);
+}
+
 void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
   File* file = GetFile(args);
   ASSERT(file != NULL);
@@ -493,6 +728,70 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void MappedMemoryFinalizer(void* isolate_callback_data,
+                                  Dart_WeakPersistentHandle handle,
+                                  void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  ASSERT(file != NULL);
+  int64_t position;
+  int64_t length;
+  int64_t pattern;
+  if (!DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &position) ||
+      !DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &length) ||
+      !DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &pattern) ||
+      (position < 0) || (length <= 0) ||
+      (pattern < MappedMemory::kAccessNormal) ||
+      (pattern > MappedMemory::kAccessRandom)) {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+#if defined(HOST_OS_FUCHSIA)
+  OSError os_error(-1, "Mapping files is not supported", OSError::kUnknown);
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+#else
+  // Mappings start at a multiple of this, which is a multiple of the page
+  // size, and of the allocation granularity on Windows.
+  const int64_t kMapAlignment = 64 * KB;
+  int64_t file_length = file->Length();
+  if (file_length < 0) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  // Pages past the end of the file cannot be accessed.
+  if ((length > file_length) || (position > file_length - length) ||
+      (length > kIntptrMax - kMapAlignment)) {
+    OSError os_error(-1, "Mapping past the end of the file", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  const int64_t map_position = Utils::RoundDown(position, kMapAlignment);
+  const intptr_t offset = position - map_position;
+  MappedMemory* mapping =
+      file->Map(File::kReadCopyOnWrite, map_position, length + offset);
+  if (mapping == NULL) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  mapping->Advise(static_cast<MappedMemory::AccessPattern>(pattern));
+  // The mapping is backed by the file, so it is not reported as an external
+  // allocation that should make the GC run sooner.
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8,
+      reinterpret_cast<uint8_t*>(mapping->address()) + offset, length,
+      mapping, 0, MappedMemoryFinalizer);
+  if (Dart_IsError(result)) {
+    delete mapping;
+    Dart_PropagateError(result);
+  }
+  Dart_SetReturnValue(args, result);
+#endif  // defined(HOST_OS_FUCHSIA)
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle path_handle = Dart_GetNativeArgument(args, 1);
@@ -30,6 +30,17 @@ class MappedMemory {
   void* address() const { return address_; }
   intptr_t size() const { return size_; }
 
+  // These match the constants in FileAccessPattern in file.dart.
+  enum AccessPattern {
+    kAccessNormal = 0,
+    kAccessSequential = 1,
+    kAccessRandom = 2,
+  };
+
+  // Tells the OS how the mapping will be accessed, so that it can adjust
+  // read-ahead. This is only a hint and is ignored where not supported.
+  void Advise(AccessPattern pattern);
+
  private:
   void Unmap();
 
@@ -100,6 +111,8 @@ class File : public ReferenceCounted<File> {
   enum MapType {
     kReadOnly = 0,
     kReadExecute = 1,
+    // A private mapping. Writes to it are not written back to the file.
+    kReadCopyOnWrite = 2,
   };
   MappedMemory* Map(MapType type, int64_t position, int64_t length);
 
@@ -108,6 +121,12 @@ class File : public ReferenceCounted<File> {
   int64_t Read(void* buffer, int64_t num_bytes);
   int64_t Write(const void* buffer, int64_t num_bytes);
 
+  // ReadAt/WriteAt transfer up to num_bytes to/from buffer at the given
+  // position in the file. It returns the number of bytes read/written. On
+  // Windows they move the file position, elsewhere it is left unchanged.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+  int64_t WriteAt(const void* buffer, int64_t num_bytes, int64_t position);
+
   // ReadFully and WriteFully do attempt to transfer num_bytes to/from
   // the buffer. In the event of short accesses they will loop internally until
   // the whole buffer has been transferred or an error occurs. If an error
@@ -87,6 +87,9 @@ MappedMemory* File::Map(MapType type, int64_t position, int64_t length) {
     case kReadExecute:
       prot = PROT_READ | PROT_EXEC;
       break;
+    case kReadCopyOnWrite:
+      prot = PROT_READ | PROT_WRITE;
+      break;
     default:
       return NULL;
   }
@@ -104,6 +107,21 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(AccessPattern pattern) {
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case kAccessSequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case kAccessRandom:
+      advice = MADV_RANDOM;
+      break;
+    default:
+      break;
+  }
+  VOID_NO_RETRY_EXPECTED(madvise(address_, size_, advice));
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -114,6 +132,18 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer,
+                      int64_t num_bytes,
+                      int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(pwrite(handle_->fd(), buffer, num_bytes, position));
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
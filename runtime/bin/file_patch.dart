@@ -74,14 +74,19 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   readByte() native "File_ReadByte";
   read(int bytes) native "File_Read";
   readInto(List<int> buffer, int start, int end) native "File_ReadInto";
+  readAt(List<int> buffer, int start, int end, int position, SendPort port)
+      native "File_ReadAt";
   writeByte(int value) native "File_WriteByte";
   writeFrom(List<int> buffer, int start, int end) native "File_WriteFrom";
+  writeAt(List<int> buffer, int start, int end, int position, SendPort port)
+      native "File_WriteAt";
   position() native "File_Position";
   setPosition(int position) native "File_SetPosition";
   truncate(int length) native "File_Truncate";
   length() native "File_Length";
   flush() native "File_Flush";
   lock(int lock, int start, int end) native "File_Lock";
+  map(int position, int length, int accessPattern) native "File_Map";
 }
 
 class _WatcherPath {
@@ -100,11 +100,26 @@ static int InotifyEventToMask(struct inotify_event* e) {
   return mask;
 }
 
+// Returns true if the events are the same change of the same file, so that
+// delivering one of them is enough. Moves are never merged, as they are
+// paired up by their cookies.
+static bool IsSameEvent(struct inotify_event* a, struct inotify_event* b) {
+  return (a->wd == b->wd) && (a->mask == b->mask) && (a->cookie == 0) &&
+         (b->cookie == 0) && (strcmp(a->len > 0 ? a->name : "",
+                                     b->len > 0 ? b->name : "") == 0);
+}
+
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
-  uint8_t buffer[kBufferSize];
+  // Read up to 64 events at a time, so that a burst of changes, e.g. a
+  // checkout, is delivered with few reads and list allocations.
+  const intptr_t kBufferSize = 64 * (kEventSize + NAME_MAX + 1);
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(Dart_ScopeAllocate(kBufferSize));
+  // Like inotify itself, only merge an event with the one right before it.
+  // An event repeated after a change to another file is still delivered, so
+  // the order of changes across files is kept.
+  struct inotify_event* previous = NULL;
   intptr_t bytes =
       SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
   if (bytes < 0) {
@@ -117,7 +132,9 @@ Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   while (offset < bytes) {
     struct inotify_event* e =
         reinterpret_cast<struct inotify_event*>(buffer + offset);
-    if ((e->mask & IN_IGNORED) == 0) {
+    const bool duplicate = (previous != NULL) && IsSameEvent(previous, e);
+    previous = e;
+    if (!duplicate && ((e->mask & IN_IGNORED) == 0)) {
       Dart_Handle event = Dart_NewList(5);
       int mask = InotifyEventToMask(e);
       Dart_ListSetAt(event, 0, Dart_NewInteger(mask));
@@ -85,6 +85,10 @@ MappedMemory* File::Map(File::MapType type, int64_t position, int64_t length) {
       prot_alloc = PAGE_EXECUTE_READWRITE;
       prot_final = PAGE_EXECUTE_READ;
       break;
+    case File::kReadCopyOnWrite:
+      prot_alloc = PAGE_READWRITE;
+      prot_final = PAGE_READWRITE;
+      break;
     default:
       return NULL;
   }
@@ -119,6 +123,11 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(AccessPattern pattern) {
+  // The mapping is a copy of the file that has already been read.
+  USE(pattern);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return read(handle_->fd(), buffer, num_bytes);
@@ -156,6 +165,40 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return bytes_written;
 }
 
+static void SetOverlappedOffset(OVERLAPPED* overlapped, int64_t position) {
+  ZeroMemory(overlapped, sizeof(*overlapped));
+  overlapped->Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+  overlapped->OffsetHigh = static_cast<DWORD>(position >> 32);
+}
+
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  int fd = handle_->fd();
+  ASSERT(fd >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  OVERLAPPED overlapped;
+  SetOverlappedOffset(&overlapped, position);
+  DWORD read = 0;
+  if (!ReadFile(handle, buffer, num_bytes, &read, &overlapped)) {
+    return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+  }
+  return read;
+}
+
+int64_t File::WriteAt(const void* buffer,
+                      int64_t num_bytes,
+                      int64_t position) {
+  int fd = handle_->fd();
+  ASSERT(fd >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  OVERLAPPED overlapped;
+  SetOverlappedOffset(&overlapped, position);
+  DWORD written = 0;
+  if (!WriteFile(handle, buffer, num_bytes, &written, &overlapped)) {
+    return -1;
+  }
+  return written;
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
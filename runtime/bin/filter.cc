@@ -237,21 +237,28 @@ void FUNCTION_NAME(Filter_Processed)(Dart_NativeArguments args) {
     Dart_PropagateError(err);
   }
 
-  intptr_t read = filter->Processed(
-      filter->processed_buffer(), filter->processed_buffer_size(), flush, end);
+  // Process straight into the buffer that is handed to Dart.
+  intptr_t size = filter->ProcessedBufferSize(flush, end);
+  uint8_t* io_buffer = IOBuffer::Allocate(size);
+  if (io_buffer == NULL) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  intptr_t read = filter->Processed(io_buffer, size, flush, end);
   if (read < 0) {
+    IOBuffer::Free(io_buffer);
     Dart_ThrowException(DartUtils::NewInternalError("Filter error, bad data"));
   } else if (read == 0) {
+    IOBuffer::Free(io_buffer);
     Dart_SetReturnValue(args, Dart_Null());
   } else {
-    uint8_t* io_buffer;
-    Dart_Handle result = IOBuffer::Allocate(read, &io_buffer);
-    if (Dart_IsNull(result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
+    if (read < size) {
+      uint8_t* shrunk = IOBuffer::Reallocate(io_buffer, read);
+      if (shrunk != NULL) {
+        io_buffer = shrunk;
+      }
     }
-    memmove(io_buffer, filter->processed_buffer(), read);
-    Dart_SetReturnValue(args, result);
+    Dart_SetReturnValue(args, IOBuffer::Wrap(io_buffer, read));
   }
 }
 
@@ -358,6 +365,14 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
   return error ? -1 : 0;
 }
 
+intptr_t ZLibDeflateFilter::ProcessedBufferSize(bool flush, bool end) {
+  if (!end) {
+    return Filter::ProcessedBufferSize(flush, end);
+  }
+  // Let the rest of the stream fit in one buffer.
+  return ClampBufferSize(deflateBound(&stream_, stream_.avail_in));
+}
+
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
   delete[] current_buffer_;
@@ -392,6 +407,11 @@ bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
   return true;
 }
 
+intptr_t ZLibInflateFilter::ProcessedBufferSize(bool flush, bool end) {
+  // Guess that the pending input expands four times.
+  return ClampBufferSize(static_cast<uint64_t>(stream_.avail_in) * 4);
+}
+
 intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush,
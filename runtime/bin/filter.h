@@ -30,6 +30,15 @@ class Filter {
                              bool finish,
                              bool end) = 0;
 
+  /**
+   * The size of the buffer to pass to the next call to Processed. Subclasses
+   * return more than the default when the pending data is known to need it,
+   * so that it comes out as one chunk.
+   */
+  virtual intptr_t ProcessedBufferSize(bool finish, bool end) {
+    return kFilterBufferSize;
+  }
+
   static Dart_Handle SetFilterAndCreateFinalizer(Dart_Handle filter,
                                                  Filter* filter_pointer,
                                                  intptr_t filter_size);
@@ -38,15 +47,24 @@ class Filter {
 
   bool initialized() const { return initialized_; }
   void set_initialized(bool value) { initialized_ = value; }
-  uint8_t* processed_buffer() { return processed_buffer_; }
-  intptr_t processed_buffer_size() const { return kFilterBufferSize; }
 
  protected:
   Filter() : initialized_(false) {}
 
- private:
   static const intptr_t kFilterBufferSize = 64 * KB;
-  uint8_t processed_buffer_[kFilterBufferSize];
+  static const intptr_t kMaxFilterBufferSize = 16 * MB;
+
+  static intptr_t ClampBufferSize(uint64_t size) {
+    if (size < static_cast<uint64_t>(kFilterBufferSize)) {
+      return kFilterBufferSize;
+    }
+    if (size > static_cast<uint64_t>(kMaxFilterBufferSize)) {
+      return kMaxFilterBufferSize;
+    }
+    return static_cast<intptr_t>(size);
+  }
+
+ private:
   bool initialized_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
@@ -79,6 +97,7 @@ class ZLibDeflateFilter : public Filter {
                              intptr_t length,
                              bool finish,
                              bool end);
+  virtual intptr_t ProcessedBufferSize(bool finish, bool end);
 
  private:
   const bool gzip_;
@@ -114,6 +133,7 @@ class ZLibInflateFilter : public Filter {
                              intptr_t length,
                              bool finish,
                              bool end);
+  virtual intptr_t ProcessedBufferSize(bool finish, bool end);
 
  private:
   const int32_t window_bits_;
@@ -16,6 +16,7 @@
 #include "bin/console.h"
 #include "bin/dartutils.h"
 #include "bin/dfe.h"
+#include "bin/elf_writer.h"
 #include "bin/eventhandler.h"
 #include "bin/file.h"
 #include "bin/loader.h"
@@ -76,6 +77,7 @@ enum SnapshotKind {
   kAppAOTBlobs,
   kAppAOTAssembly,
   kVMAOTAssembly,
+  kAppAOTElf,
 };
 static SnapshotKind snapshot_kind = kCore;
 
@@ -102,7 +104,8 @@ static const char* kSnapshotKindNames[] = {
     "app-jit",
     "app-aot-blobs",
     "app-aot-assembly",
-    "vm-aot-assembly", NULL,
+    "vm-aot-assembly",
+    "app-aot-elf", NULL,
     // clang-format on
 };
 
@@ -122,6 +125,7 @@ static const char* kSnapshotKindNames[] = {
   V(reused_instructions, reused_instructions_filename)                         \
   V(blobs_container_filename, blobs_container_filename)                        \
   V(assembly, assembly_filename)                                               \
+  V(elf, elf_filename)                                                         \
   V(dependencies, dependencies_filename)                                       \
   V(load_compilation_trace, load_compilation_trace_filename)                   \
   V(package_root, commandline_package_root)                                    \
@@ -160,7 +164,7 @@ DEFINE_CB_OPTION(ProcessEnvironmentOption);
 static bool IsSnapshottingForPrecompilation() {
   return (snapshot_kind == kAppAOTBlobs) ||
          (snapshot_kind == kAppAOTAssembly) ||
-         (snapshot_kind == kVMAOTAssembly);
+         (snapshot_kind == kVMAOTAssembly) || (snapshot_kind == kAppAOTElf);
 }
 
 // clang-format off
@@ -217,6 +221,14 @@ static void PrintUsage() {
 "[--save-obfuscation-map=<map-filename>]                                     \n"
 "<dart-kernel-file>                                                          \n"
 "                                                                            \n"
+"To create an AOT application snapshot as an ELF shared object suitable for  \n"
+"loading with dlopen, without going through a C toolchain:                   \n"
+"--snapshot_kind=app-aot-elf                                                 \n"
+"--elf=<output-file>                                                         \n"
+"[--obfuscate]                                                               \n"
+"[--save-obfuscation-map=<map-filename>]                                     \n"
+"<dart-kernel-file>                                                          \n"
+"                                                                            \n"
 "AOT snapshots can be obfuscated: that is all identifiers will be renamed    \n"
 "during compilation. This mode is enabled with --obfuscate flag. Mapping     \n"
 "between original and obfuscated names can be serialized as a JSON array     \n"
@@ -375,6 +387,15 @@ static int ParseArguments(int argc,
       }
       break;
     }
+    case kAppAOTElf: {
+      if ((elf_filename == NULL) || (*script_name == NULL)) {
+        Log::PrintErr(
+            "Building an AOT snapshot as ELF requires specifying "
+            "an output file for --elf and a kernel file.\n\n");
+        return -1;
+      }
+      break;
+    }
   }
 
   if (!obfuscate && obfuscation_map_filename != NULL) {
@@ -463,6 +484,9 @@ class DependenciesFileWriter : public ValueObject {
       case kAppAOTAssembly:
         WriteDependenciesWithTarget(assembly_filename);
         break;
+      case kAppAOTElf:
+        WriteDependenciesWithTarget(elf_filename);
+        break;
       case kAppJIT:
         WriteDependenciesWithTarget(isolate_snapshot_data_filename);
         // WriteDependenciesWithTarget(isolate_snapshot_instructions_filename);
@@ -740,7 +764,7 @@ static void CreateAndWritePrecompiledSnapshot() {
     result = Dart_CreateAppAOTSnapshotAsAssembly(StreamingWriteCallback, file);
     CHECK_RESULT(result);
   } else {
-    ASSERT(snapshot_kind == kAppAOTBlobs);
+    ASSERT((snapshot_kind == kAppAOTBlobs) || (snapshot_kind == kAppAOTElf));
 
     const uint8_t* shared_data = NULL;
     const uint8_t* shared_instructions = NULL;
@@ -787,7 +811,22 @@ static void CreateAndWritePrecompiledSnapshot() {
         &isolate_snapshot_instructions_size, shared_data, shared_instructions);
     CHECK_RESULT(result);
 
-    if (blobs_container_filename != NULL) {
+    if (elf_filename != NULL) {
+      File* file = OpenFile(elf_filename);
+      RefCntReleaseScope<File> rs(file);
+      ElfWriter writer(file);
+      if (!writer.WriteAppAOTSnapshot(
+              vm_snapshot_data_buffer, vm_snapshot_data_size,
+              vm_snapshot_instructions_buffer, vm_snapshot_instructions_size,
+              isolate_snapshot_data_buffer, isolate_snapshot_data_size,
+              isolate_snapshot_instructions_buffer,
+              isolate_snapshot_instructions_size)) {
+        Log::PrintErr("Error: Unable to write file: %s\n\n", elf_filename);
+        Dart_ExitScope();
+        Dart_ShutdownIsolate();
+        exit(kErrorExitCode);
+      }
+    } else if (blobs_container_filename != NULL) {
       Snapshot::WriteAppSnapshot(
           blobs_container_filename, vm_snapshot_data_buffer,
           vm_snapshot_data_size, vm_snapshot_instructions_buffer,
@@ -884,7 +923,8 @@ static int GenerateSnapshotFromKernel(const uint8_t* kernel_buffer,
 
   switch (snapshot_kind) {
     case kAppAOTBlobs:
-    case kAppAOTAssembly: {
+    case kAppAOTAssembly:
+    case kAppAOTElf: {
       if (Dart_IsNull(Dart_RootLibrary())) {
         Log::PrintErr(
             "Unable to load root library from the input dill file.\n");
@@ -0,0 +1,262 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+
+#if !defined(HOST_OS_WINDOWS)
+#include <fcntl.h>   // NOLINT
+#include <unistd.h>  // NOLINT
+#endif
+
+#include "bin/builtin.h"
+#include "include/dart_api.h"
+#include "platform/assert.h"
+#include "vm/benchmark_test.h"
+
+namespace dart {
+
+// dart:io benchmarks. Each workload runs in the benchmark isolate's message
+// loop against the loopback interface or a temporary file, and records the
+// latency of every request. A workload is registered once per score:
+//
+//   <name>             total run time in microseconds,
+//   <name>Throughput   requests per second,
+//   <name>P99          99th percentile request latency in microseconds,
+//   <name>Syscalls     system calls per request, or -1 where they can't be
+//                      counted (see BenchmarkPerfCounters).
+
+static const char* kIOBenchmarkScript =
+    "import 'dart:async';\n"
+    "import 'dart:io';\n"
+    "import 'dart:math';\n"
+    "\n"
+    "int requests = 0;\n"
+    "int elapsedMicros = 0;\n"
+    "int p99Micros = 0;\n"
+    "\n"
+    "final latencies = <int>[];\n"
+    "final total = new Stopwatch();\n"
+    "final watch = new Stopwatch();\n"
+    "\n"
+    "void start() {\n"
+    "  latencies.clear();\n"
+    "  total..reset()..start();\n"
+    "}\n"
+    "\n"
+    "void begin() {\n"
+    "  watch..reset()..start();\n"
+    "}\n"
+    "\n"
+    "void end() {\n"
+    "  latencies.add(watch.elapsedMicroseconds);\n"
+    "}\n"
+    "\n"
+    "void finish() {\n"
+    "  elapsedMicros = total.elapsedMicroseconds;\n"
+    "  requests = latencies.length;\n"
+    "  latencies.sort();\n"
+    "  p99Micros = latencies[min(requests - 1, requests * 99 ~/ 100)];\n"
+    "}\n"
+    "\n"
+    // A loopback echo server and a client doing sequential round trips.
+    "Future echo() async {\n"
+    "  const kRoundTrips = 10000;\n"
+    "  final server = await ServerSocket.bind(\n"
+    "      InternetAddress.loopbackIPv4, 0);\n"
+    "  server.listen((socket) {\n"
+    "    socket.listen(socket.add, onDone: socket.close);\n"
+    "  });\n"
+    "  final client = await Socket.connect(\n"
+    "      InternetAddress.loopbackIPv4, server.port);\n"
+    "  client.setOption(SocketOption.tcpNoDelay, true);\n"
+    "  final message = new List<int>.filled(64, 42);\n"
+    "  var pending = 0;\n"
+    "  var completer = new Completer();\n"
+    "  client.listen((data) {\n"
+    "    pending -= data.length;\n"
+    "    if (pending == 0) completer.complete();\n"
+    "  });\n"
+    "  start();\n"
+    "  for (var i = 0; i < kRoundTrips; i++) {\n"
+    "    begin();\n"
+    "    pending = message.length;\n"
+    "    client.add(message);\n"
+    "    await completer.future;\n"
+    "    completer = new Completer();\n"
+    "    end();\n"
+    "  }\n"
+    "  finish();\n"
+    "  await client.close();\n"
+    "  await server.close();\n"
+    "}\n"
+    "\n"
+    // An HTTP server and a client sending sequential requests over one
+    // persistent connection.
+    "Future http() async {\n"
+    "  const kRequests = 2000;\n"
+    "  final server = await HttpServer.bind(\n"
+    "      InternetAddress.loopbackIPv4, 0);\n"
+    "  server.listen((request) {\n"
+    "    request.response\n"
+    "      ..headers.contentType = ContentType.text\n"
+    "      ..write('ok')\n"
+    "      ..close();\n"
+    "  });\n"
+    "  final client = new HttpClient()..maxConnectionsPerHost = 1;\n"
+    "  final uri = Uri.parse('http://127.0.0.1:${server.port}/');\n"
+    "  start();\n"
+    "  for (var i = 0; i < kRequests; i++) {\n"
+    "    begin();\n"
+    "    final request = await client.getUrl(uri);\n"
+    "    final response = await request.close();\n"
+    "    await response.drain();\n"
+    "    end();\n"
+    "  }\n"
+    "  finish();\n"
+    "  client.close(force: true);\n"
+    "  await server.close(force: true);\n"
+    "}\n"
+    "\n"
+    // Sequential writes and reads of 4KB blocks through the asynchronous
+    // file API, followed by random ones.
+    "Future files() async {\n"
+    "  const kBlocks = 1024;\n"
+    "  const kBlockSize = 4096;\n"
+    "  final directory = Directory.systemTemp.createTempSync('io_bench');\n"
+    "  final file = new File('${directory.path}/data');\n"
+    "  final raf = await file.open(mode: FileMode.write);\n"
+    "  final block = new List<int>.filled(kBlockSize, 42);\n"
+    "  final random = new Random(0);\n"
+    "  start();\n"
+    "  for (var i = 0; i < kBlocks; i++) {\n"
+    "    begin();\n"
+    "    await raf.writeFrom(block);\n"
+    "    end();\n"
+    "  }\n"
+    "  await raf.setPosition(0);\n"
+    "  for (var i = 0; i < kBlocks; i++) {\n"
+    "    begin();\n"
+    "    await raf.read(kBlockSize);\n"
+    "    end();\n"
+    "  }\n"
+    "  for (var i = 0; i < kBlocks; i++) {\n"
+    "    begin();\n"
+    "    await raf.setPosition(random.nextInt(kBlocks) * kBlockSize);\n"
+    "    if (i.isEven) {\n"
+    "      await raf.read(kBlockSize);\n"
+    "    } else {\n"
+    "      await raf.writeFrom(block);\n"
+    "    }\n"
+    "    end();\n"
+    "  }\n"
+    "  finish();\n"
+    "  await raf.close();\n"
+    "  directory.deleteSync(recursive: true);\n"
+    "}\n"
+    "\n"
+    // Lines written to stdout, which the benchmark redirects to /dev/null.
+    "Future flood() async {\n"
+    "  const kLines = 100000;\n"
+    "  final line = 'x' * 79;\n"
+    "  start();\n"
+    "  for (var i = 0; i < kLines; i++) {\n"
+    "    begin();\n"
+    "    stdout.writeln(line);\n"
+    "    end();\n"
+    "  }\n"
+    "  await stdout.flush();\n"
+    "  finish();\n"
+    "}\n";
+
+enum IOBenchmarkScore {
+  kIORunTime,
+  kIOThroughput,
+  kIOP99,
+  kIOSyscalls,
+};
+
+static int64_t GetIntegerField(Dart_Handle lib, const char* name) {
+  Dart_Handle value = Dart_GetField(lib, NewString(name));
+  EXPECT_VALID(value);
+  int64_t result = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(value, &result));
+  return result;
+}
+
+static void RunIOBenchmark(Benchmark* benchmark,
+                           const char* workload,
+                           IOBenchmarkScore score) {
+  bin::Builtin::SetNativeResolver(bin::Builtin::kBuiltinLibrary);
+  bin::Builtin::SetNativeResolver(bin::Builtin::kIOLibrary);
+  bin::Builtin::SetNativeResolver(bin::Builtin::kCLILibrary);
+  Dart_Handle lib = TestCase::LoadTestScript(kIOBenchmarkScript, NULL);
+  EXPECT_VALID(lib);
+
+#if !defined(HOST_OS_WINDOWS)
+  // Keep the stdout flood out of the benchmark output.
+  fflush(stdout);
+  const int saved_stdout = dup(STDOUT_FILENO);
+  const int dev_null = open("/dev/null", O_WRONLY);
+  dup2(dev_null, STDOUT_FILENO);
+  close(dev_null);
+#endif
+
+  BenchmarkPerfCounters counters;
+  const bool count = (score == kIOSyscalls) && counters.Start();
+  EXPECT_VALID(Dart_Invoke(lib, NewString(workload), 0, NULL));
+  EXPECT_VALID(Dart_RunLoop());
+  if (count) {
+    counters.Stop();
+  }
+
+#if !defined(HOST_OS_WINDOWS)
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(saved_stdout);
+#endif
+
+  const int64_t requests = GetIntegerField(lib, "requests");
+  const int64_t elapsed_micros = GetIntegerField(lib, "elapsedMicros");
+  EXPECT(requests > 0);
+  switch (score) {
+    case kIORunTime:
+      benchmark->set_score(elapsed_micros);
+      break;
+    case kIOThroughput:
+      benchmark->set_score(requests * kMicrosecondsPerSecond /
+                           Utils::Maximum<int64_t>(elapsed_micros, 1));
+      break;
+    case kIOP99:
+      benchmark->set_score(GetIntegerField(lib, "p99Micros"));
+      break;
+    case kIOSyscalls: {
+      const int64_t syscalls =
+          counters.Value(BenchmarkPerfCounters::kSyscalls);
+      benchmark->set_score((syscalls == -1) ? -1 : syscalls / requests);
+      break;
+    }
+  }
+}
+
+#define IO_BENCHMARK(name, workload)                                           \
+  BENCHMARK(IO##name) {                                                        \
+    RunIOBenchmark(benchmark, workload, kIORunTime);                           \
+  }                                                                            \
+  BENCHMARK_THROUGHPUT(IO##name##Throughput) {                                 \
+    RunIOBenchmark(benchmark, workload, kIOThroughput);                        \
+  }                                                                            \
+  BENCHMARK(IO##name##P99) {                                                   \
+    RunIOBenchmark(benchmark, workload, kIOP99);                               \
+  }                                                                            \
+  BENCHMARK(IO##name##Syscalls) {                                              \
+    RunIOBenchmark(benchmark, workload, kIOSyscalls);                          \
+  }
+
+IO_BENCHMARK(SocketEcho, "echo")
+IO_BENCHMARK(HttpKeepAlive, "http")
+IO_BENCHMARK(FileMix, "files")
+IO_BENCHMARK(StdoutFlood, "flood")
+
+#undef IO_BENCHMARK
+
+}  // namespace dart
@@ -17,9 +17,19 @@ class IOBuffer {
   // an external byte array.
   static Dart_Handle Allocate(intptr_t size, uint8_t** buffer);
 
+  // Allocate an IO buffer dart object of the given size backed by buffer,
+  // which must come from Allocate(intptr_t) or Reallocate and is owned by the
+  // dart object afterwards.
+  static Dart_Handle Wrap(uint8_t* buffer, intptr_t size);
+
   // Allocate IO buffer storage.
   static uint8_t* Allocate(intptr_t size);
 
+  // Shrink or grow IO buffer storage. Shrinking a buffer, e.g. after a short
+  // read into it, normally happens in place without copying the data.
+  // Returns NULL, leaving the buffer unchanged, if this fails.
+  static uint8_t* Reallocate(uint8_t* buffer, intptr_t new_size);
+
   // Function for disposing of IO buffer storage. All backing storage
   // for IO buffers must be freed using this function.
   static void Free(void* buffer) { free(buffer); }
@@ -52,10 +52,12 @@ namespace bin {
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_Map, 4)                                                               \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
   V(File_Position, 1)                                                          \
   V(File_Read, 2)                                                              \
+  V(File_ReadAt, 6)                                                            \
   V(File_ReadByte, 1)                                                          \
   V(File_ReadInto, 4)                                                          \
   V(File_Rename, 3)                                                            \
@@ -67,6 +69,7 @@ namespace bin {
   V(File_SetPosition, 2)                                                       \
   V(File_Stat, 2)                                                              \
   V(File_Truncate, 2)                                                          \
+  V(File_WriteAt, 6)                                                           \
   V(File_WriteByte, 2)                                                         \
   V(File_WriteFrom, 4)                                                         \
   V(FileSystemWatcher_CloseWatcher, 1)                                         \
@@ -109,7 +112,7 @@ namespace bin {
   V(Process_ClearSignalHandler, 1)                                             \
   V(ProcessInfo_CurrentRSS, 0)                                                 \
   V(ProcessInfo_MaxRSS, 0)                                                     \
-  V(SecureSocket_Connect, 7)                                                   \
+  V(SecureSocket_Connect, 8)                                                   \
   V(SecureSocket_Destroy, 1)                                                   \
   V(SecureSocket_FilterPointer, 1)                                             \
   V(SecureSocket_GetSelectedProtocol, 1)                                       \
@@ -133,6 +136,7 @@ namespace bin {
   V(Socket_CreateBindConnect, 4)                                               \
   V(Socket_CreateBindDatagram, 6)                                              \
   V(Socket_CreateConnect, 3)                                                   \
+  V(Socket_DupForSendFile, 1)                                                  \
   V(Socket_GetPort, 1)                                                         \
   V(Socket_GetRemotePeer, 1)                                                   \
   V(Socket_GetError, 1)                                                        \
@@ -143,10 +147,12 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
+  V(Socket_ReadInto, 4)                                                        \
   V(Socket_RecvFrom, 1)                                                        \
   V(Socket_SendTo, 6)                                                          \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetSocketId, 3)                                                     \
+  V(Socket_WriteBuffers, 4)                                                    \
   V(Socket_WriteList, 4)                                                       \
   V(Stdin_ReadByte, 1)                                                         \
   V(Stdin_GetEchoMode, 1)                                                      \
@@ -51,6 +51,7 @@ namespace bin {
   V(Socket, Lookup, 31)                                                        \
   V(Socket, ListInterfaces, 32)                                                \
   V(Socket, ReverseLookup, 33)                                                 \
+  V(Socket, SendFile, 43)                                                      \
   V(Directory, Create, 34)                                                     \
   V(Directory, Delete, 35)                                                     \
   V(Directory, Exists, 36)                                                     \
@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/isolate_data.h"
+#include "bin/file.h"
 #include "bin/snapshot_utils.h"
 #include "platform/growable_array.h"
 
@@ -22,7 +23,9 @@ IsolateData::IsolateData(const char* url,
       resolved_packages_config_(NULL),
       kernel_buffer_(NULL),
       kernel_buffer_size_(0),
-      owns_kernel_buffer_(false) {
+      owns_kernel_buffer_(false),
+      kernel_mapping_(NULL),
+      spawn_template_(NULL) {
   if (package_root != NULL) {
     ASSERT(packages_file == NULL);
     this->package_root = strdup(package_root);
@@ -49,6 +52,8 @@ IsolateData::~IsolateData() {
   }
   kernel_buffer_ = NULL;
   kernel_buffer_size_ = 0;
+  delete kernel_mapping_;
+  kernel_mapping_ = NULL;
   delete app_snapshot_;
   app_snapshot_ = NULL;
   delete dependencies_;
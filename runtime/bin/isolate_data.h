@@ -24,6 +24,8 @@ namespace bin {
 class AppSnapshot;
 class EventHandler;
 class Loader;
+class MappedMemory;
+struct SpawnTemplate;
 
 // Data associated with every isolate in the standalone VM
 // embedding. This is used to free external resources for each isolate
@@ -48,6 +50,14 @@ class IsolateData {
     kernel_buffer_size_ = size;
     owns_kernel_buffer_ = take_ownership;
   }
+  // Uses the mapped kernel file as the kernel buffer. The mapping is owned
+  // by this object.
+  void set_kernel_mapping(MappedMemory* mapping,
+                          uint8_t* buffer,
+                          intptr_t size) {
+    set_kernel_buffer(buffer, size, false /*take ownership*/);
+    kernel_mapping_ = mapping;
+  }
 
   void UpdatePackagesFile(const char* packages_file_) {
     if (packages_file != NULL) {
@@ -84,6 +94,13 @@ class IsolateData {
     dependencies_ = deps;
   }
 
+  // The template this isolate was started from, if it was spawned with
+  // --spawn-templates. The templates live as long as the process.
+  SpawnTemplate* spawn_template() const { return spawn_template_; }
+  void set_spawn_template(SpawnTemplate* spawn_template) {
+    spawn_template_ = spawn_template;
+  }
+
   void OnIsolateShutdown();
 
  private:
@@ -94,6 +111,8 @@ class IsolateData {
   uint8_t* kernel_buffer_;
   intptr_t kernel_buffer_size_;
   bool owns_kernel_buffer_;
+  MappedMemory* kernel_mapping_;
+  SpawnTemplate* spawn_template_;
 
   DISALLOW_COPY_AND_ASSIGN(IsolateData);
 };
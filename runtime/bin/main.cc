@@ -22,6 +22,7 @@
 #include "bin/file.h"
 #include "bin/isolate_data.h"
 #include "bin/loader.h"
+#include "bin/lockers.h"
 #include "bin/log.h"
 #include "bin/main_options.h"
 #include "bin/platform.h"
@@ -519,6 +520,256 @@ static Dart_Isolate CreateAndSetupServiceIsolate(const char* script_uri,
   return isolate;
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Isolate snapshots of spawned kernel scripts, taken once per script and set
+// of isolate flags right after its libraries were loaded. Later isolates
+// spawned for the same script with the same flags start from the snapshot
+// instead of loading the kernel binary again.
+//
+// When the first isolate started from a template shuts down, an app-JIT
+// snapshot of it replaces the template, so that the isolates spawned after
+// it start with the code it compiled instead of warming up again, and share
+// the instructions of that code.
+struct SpawnTemplate {
+  char* script_uri;
+  Dart_IsolateFlags flags;
+  uint8_t* isolate_snapshot_data;
+  AppSnapshot* warm_snapshot;
+  // Set while the first isolate for the template builds it.
+  bool creating;
+  bool warming;
+  SpawnTemplate* next;
+};
+
+static Mutex* spawn_templates_mutex = new Mutex();
+static SpawnTemplate* spawn_templates = NULL;
+
+// The flags that are checked against the snapshot an isolate starts from, or
+// that change the code loaded into it.
+static bool SameSpawnFlags(const Dart_IsolateFlags& a,
+                           const Dart_IsolateFlags& b) {
+  return (a.enable_type_checks == b.enable_type_checks) &&
+         (a.enable_asserts == b.enable_asserts) &&
+         (a.enable_error_on_bad_type == b.enable_error_on_bad_type) &&
+         (a.use_field_guards == b.use_field_guards) &&
+         (a.use_osr == b.use_osr) && (a.obfuscate == b.obfuscate) &&
+         (a.entry_points == b.entry_points) &&
+         (a.load_vmservice_library == b.load_vmservice_library) &&
+         (a.unsafe_trust_strong_mode_types ==
+          b.unsafe_trust_strong_mode_types);
+}
+
+// Must be called with spawn_templates_mutex held.
+static SpawnTemplate* FindSpawnTemplate(const char* script_uri,
+                                        const Dart_IsolateFlags& flags) {
+  for (SpawnTemplate* t = spawn_templates; t != NULL; t = t->next) {
+    if ((strcmp(t->script_uri, script_uri) == 0) &&
+        SameSpawnFlags(t->flags, flags)) {
+      return t;
+    }
+  }
+  return NULL;
+}
+
+// Loads the kernel binary into a scratch isolate created from the core
+// snapshot and returns a malloc'ed full snapshot of it, or NULL if the
+// snapshot could not be created.
+static uint8_t* CreateSpawnTemplate(const char* script_uri,
+                                    const char* main,
+                                    const char* package_root,
+                                    const char* packages_config,
+                                    Dart_IsolateFlags* flags,
+                                    const uint8_t* kernel_buffer,
+                                    intptr_t kernel_buffer_size) {
+  IsolateData* isolate_data =
+      new IsolateData(script_uri, package_root, packages_config, NULL);
+  char* error = NULL;
+  Dart_Isolate isolate = Dart_CreateIsolate(
+      script_uri, main, core_isolate_snapshot_data,
+      core_isolate_snapshot_instructions, app_isolate_shared_data,
+      app_isolate_shared_instructions, flags, isolate_data, &error);
+  if (isolate == NULL) {
+    free(error);
+    delete isolate_data;
+    return NULL;
+  }
+
+  Dart_EnterScope();
+  uint8_t* snapshot = NULL;
+  Dart_Handle result = Dart_SetLibraryTagHandler(Loader::LibraryTagHandler);
+  if (!Dart_IsError(result)) {
+    result = Dart_LoadScriptFromKernel(kernel_buffer, kernel_buffer_size);
+  }
+  if (!Dart_IsError(result)) {
+    uint8_t* buffer = NULL;
+    intptr_t size = 0;
+    result = Dart_CreateSnapshot(NULL, NULL, &buffer, &size);
+    if (!Dart_IsError(result)) {
+      // The buffer lives in the current API scope.
+      snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+      memmove(snapshot, buffer, size);
+    }
+  }
+  if (Dart_IsError(result) && Options::trace_loading()) {
+    Log::PrintErr("Cannot create spawn template for %s: %s\n", script_uri,
+                  Dart_GetError(result));
+  }
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+  return snapshot;
+}
+
+static void GetSpawnTemplateBuffers(SpawnTemplate* t,
+                                    const uint8_t** isolate_snapshot_data,
+                                    const uint8_t** isolate_snapshot_instr) {
+  if (t->warm_snapshot != NULL) {
+    const uint8_t* ignore_vm_snapshot_data;
+    const uint8_t* ignore_vm_snapshot_instructions;
+    t->warm_snapshot->SetBuffers(
+        &ignore_vm_snapshot_data, &ignore_vm_snapshot_instructions,
+        isolate_snapshot_data, isolate_snapshot_instr);
+  } else {
+    *isolate_snapshot_data = t->isolate_snapshot_data;
+    *isolate_snapshot_instr = NULL;
+  }
+}
+
+// Looks up the isolate snapshot to spawn script_uri from, creating it on
+// first use. Returns the template, or NULL if no snapshot can be made for the
+// script or if another isolate is still creating it. The lock is not held
+// while the template is created, so spawns of other scripts go ahead, and
+// concurrent spawns of the same script load its kernel binary themselves.
+static SpawnTemplate* LookupSpawnTemplate(
+    const char* script_uri,
+    const char* main,
+    const char* package_root,
+    const char* packages_config,
+    Dart_IsolateFlags* flags,
+    const uint8_t* kernel_buffer,
+    intptr_t kernel_buffer_size,
+    const uint8_t** isolate_snapshot_data,
+    const uint8_t** isolate_snapshot_instr) {
+  Dart_IsolateFlags spawn_flags;
+  if (flags != NULL) {
+    spawn_flags = *flags;
+  } else {
+    Dart_IsolateFlagsInitialize(&spawn_flags);
+  }
+  SpawnTemplate* t = NULL;
+  {
+    MutexLocker ml(spawn_templates_mutex);
+    t = FindSpawnTemplate(script_uri, spawn_flags);
+    if (t != NULL) {
+      if (t->creating || (t->isolate_snapshot_data == NULL)) {
+        return NULL;
+      }
+      GetSpawnTemplateBuffers(t, isolate_snapshot_data,
+                              isolate_snapshot_instr);
+      return t;
+    }
+    // Failures are remembered as well, so that they are not retried on every
+    // spawn.
+    t = new SpawnTemplate();
+    t->script_uri = strdup(script_uri);
+    t->flags = spawn_flags;
+    t->isolate_snapshot_data = NULL;
+    t->warm_snapshot = NULL;
+    t->creating = true;
+    t->warming = false;
+    t->next = spawn_templates;
+    spawn_templates = t;
+  }
+  uint8_t* snapshot =
+      CreateSpawnTemplate(script_uri, main, package_root, packages_config,
+                          &spawn_flags, kernel_buffer, kernel_buffer_size);
+  MutexLocker ml(spawn_templates_mutex);
+  t->isolate_snapshot_data = snapshot;
+  t->creating = false;
+  if (snapshot == NULL) {
+    return NULL;
+  }
+  GetSpawnTemplateBuffers(t, isolate_snapshot_data, isolate_snapshot_instr);
+  return t;
+}
+
+// Replaces the template the current isolate was started from by an app-JIT
+// snapshot of the isolate, unless that was done before. Called when the
+// isolate shuts down.
+static void WarmSpawnTemplate(SpawnTemplate* t) {
+  const char* script_uri = t->script_uri;
+  {
+    MutexLocker ml(spawn_templates_mutex);
+    if (t->warming) {
+      return;
+    }
+    // Only one isolate takes the snapshot, even if it fails.
+    t->warming = true;
+  }
+
+  uint8_t* isolate_data_buffer = NULL;
+  intptr_t isolate_data_size = 0;
+  uint8_t* isolate_instructions_buffer = NULL;
+  intptr_t isolate_instructions_size = 0;
+  Dart_Handle result = Dart_CreateAppJITSnapshotAsBlobs(
+      &isolate_data_buffer, &isolate_data_size, &isolate_instructions_buffer,
+      &isolate_instructions_size, NULL);
+  if (Dart_IsError(result)) {
+    if (Options::trace_loading()) {
+      Log::PrintErr("Cannot warm spawn template for %s: %s\n", script_uri,
+                    Dart_GetError(result));
+    }
+    return;
+  }
+  // The instructions have to be mapped executable, which is done by writing
+  // the snapshot to a temporary file and mapping that file.
+  PathBuffer path;
+  if (!path.Add(Directory::SystemTemp(NULL)) ||
+      !path.Add(File::PathSeparator()) || !path.Add("dart_spawn_template")) {
+    return;
+  }
+  const char* temp_dir = Directory::CreateTemp(NULL, path.AsString());
+  if (temp_dir == NULL) {
+    return;
+  }
+  path.Reset(0);
+  if (!path.Add(temp_dir) || !path.Add(File::PathSeparator()) ||
+      !path.Add("snapshot")) {
+    Directory::Delete(NULL, temp_dir, true);
+    return;
+  }
+  Snapshot::WriteAppSnapshot(path.AsString(), NULL, 0, NULL, 0,
+                             isolate_data_buffer, isolate_data_size,
+                             isolate_instructions_buffer,
+                             isolate_instructions_size);
+  AppSnapshot* snapshot = Snapshot::TryReadAppSnapshot(path.AsString());
+  // The mapping stays valid once the file is gone, where the platform
+  // permits to delete mapped files.
+  Directory::Delete(NULL, temp_dir, true);
+  if (snapshot == NULL) {
+    return;
+  }
+
+  MutexLocker ml(spawn_templates_mutex);
+  // The previous snapshot data is kept, isolates may still be reading from
+  // it.
+  t->warm_snapshot = snapshot;
+}
+
+// Frees the templates. Called once the VM has shut down, when no isolate
+// refers to their snapshots any more.
+static void DeleteSpawnTemplates() {
+  MutexLocker ml(spawn_templates_mutex);
+  while (spawn_templates != NULL) {
+    SpawnTemplate* t = spawn_templates;
+    spawn_templates = t->next;
+    free(t->script_uri);
+    free(t->isolate_snapshot_data);
+    delete t->warm_snapshot;
+    delete t;
+  }
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 // Returns newly created Isolate on success, NULL on failure.
 static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
                                                 const char* script_uri,
@@ -532,7 +783,9 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
   ASSERT(script_uri != NULL);
   uint8_t* kernel_buffer = NULL;
   intptr_t kernel_buffer_size = 0;
+  MappedMemory* kernel_mapping = NULL;
   AppSnapshot* app_snapshot = NULL;
+  SpawnTemplate* spawn_template = NULL;
 
 #if defined(DART_PRECOMPILED_RUNTIME)
   // AOT: All isolates start from the app snapshot.
@@ -565,16 +818,45 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
     }
   }
   if (!isolate_run_app_snapshot) {
-    dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    // Map plain kernel files instead of reading them, so that the VM refers
+    // to the file contents without a copy of the kernel binary.
+    kernel_mapping =
+        dfe.MapScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    if (kernel_mapping == NULL) {
+      dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    }
+  }
+  if (!is_main_isolate && Options::spawn_templates() &&
+      (kernel_buffer != NULL) && (core_isolate_snapshot_data != NULL)) {
+    spawn_template = LookupSpawnTemplate(
+        script_uri, main, package_root, packages_config, flags, kernel_buffer,
+        kernel_buffer_size, &isolate_snapshot_data,
+        &isolate_snapshot_instructions);
+    if (spawn_template != NULL) {
+      // The snapshot already holds the script's libraries.
+      isolate_run_app_snapshot = true;
+      if (kernel_mapping != NULL) {
+        delete kernel_mapping;
+        kernel_mapping = NULL;
+      } else {
+        free(kernel_buffer);
+      }
+      kernel_buffer = NULL;
+      kernel_buffer_size = 0;
+    }
   }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
   IsolateData* isolate_data =
       new IsolateData(script_uri, package_root, packages_config, app_snapshot);
-  if (kernel_buffer != NULL) {
+  if (kernel_mapping != NULL) {
+    isolate_data->set_kernel_mapping(kernel_mapping, kernel_buffer,
+                                     kernel_buffer_size);
+  } else if (kernel_buffer != NULL) {
     isolate_data->set_kernel_buffer(kernel_buffer, kernel_buffer_size,
                                     true /*take ownership*/);
   }
+  isolate_data->set_spawn_template(spawn_template);
   if (is_main_isolate && (Options::depfile() != NULL)) {
     isolate_data->set_dependencies(new MallocGrowableArray<char*>());
   }
@@ -696,6 +978,12 @@ static void OnIsolateShutdown(void* callback_data) {
   IsolateData* isolate_data = reinterpret_cast<IsolateData*>(callback_data);
   isolate_data->OnIsolateShutdown();
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if ((isolate_data->spawn_template() != NULL) && Dart_IsNull(sticky_error)) {
+    WarmSpawnTemplate(isolate_data->spawn_template());
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   Dart_ExitScope();
 }
 
@@ -911,6 +1199,22 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
       CHECK_RESULT(result);
       WriteFile(Options::save_compilation_trace_filename(), buffer, size);
     }
+
+    if (Options::save_type_feedback_filename() != NULL) {
+      uint8_t* buffer = NULL;
+      intptr_t size = 0;
+      result = Dart_SaveTypeFeedback(&buffer, &size);
+      CHECK_RESULT(result);
+      WriteFile(Options::save_type_feedback_filename(), buffer, size);
+    }
+
+    if (Options::save_startup_trace_filename() != NULL) {
+      uint8_t* buffer = NULL;
+      intptr_t size = 0;
+      result = Dart_SaveStartupTrace(&buffer, &size);
+      CHECK_RESULT(result);
+      WriteFile(Options::save_startup_trace_filename(), buffer, size);
+    }
   }
 
   WriteDepsFile(isolate);
@@ -1082,6 +1386,16 @@ void main(int argc, char** argv) {
 // they might affect how the platform is loaded.
 #if !defined(DART_PRECOMPILED_RUNTIME)
   dfe.Init();
+  // A script loaded from the cache is not compiled, so the front end would
+  // not list its dependencies for the depfile.
+  if ((Options::kernel_cache_directory() != NULL) &&
+      (Options::depfile() == NULL)) {
+    TextBuffer flags(256);
+    for (intptr_t i = 0; i < vm_options.count(); i++) {
+      flags.Printf("%s ", vm_options.GetArgument(i));
+    }
+    dfe.set_kernel_cache(Options::kernel_cache_directory(), flags.buf());
+  }
   uint8_t* application_kernel_buffer = NULL;
   intptr_t application_kernel_buffer_size = 0;
   dfe.ReadScript(script_name, &application_kernel_buffer,
@@ -1150,6 +1464,9 @@ void main(int argc, char** argv) {
   delete shared_blobs;
 #endif
   free(app_script_uri);
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  DeleteSpawnTemplates();
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
   // Free copied argument strings if converted.
   if (argv_converted) {
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bin/eventhandler.h"
 #include "bin/log.h"
 #include "bin/options.h"
 #include "bin/platform.h"
@@ -112,6 +113,10 @@ static void hot_reload_rollback_test_mode_callback(
 DEFINE_BOOL_OPTION_CB(hot_reload_rollback_test_mode,
                       hot_reload_rollback_test_mode_callback);
 
+DEFINE_STRING_OPTION_CB(event_handler_threads, {
+  EventHandler::set_thread_count(strtol(value, NULL, 10));
+});
+
 void Options::PrintVersion() {
   Log::PrintErr("Dart VM version: %s\n", Dart_VersionString());
 }
@@ -189,6 +194,16 @@ void Options::PrintUsage() {
 "--trace-loading\n"
 "  enables tracing of library and script loading\n"
 "\n"
+"--spawn-templates\n"
+"  spawns isolates of the same kernel script from a snapshot of the first\n"
+"  one's loaded libraries instead of loading the kernel binary each time;\n"
+"  once the first of them exits, later ones start with the code it compiled\n"
+"\n"
+"--kernel-cache=<path>\n"
+"  caches the kernel compiled from Dart sources in the given directory and\n"
+"  reuses it while the sources, the packages file, the VM and its flags are\n"
+"  unchanged\n"
+"\n"
 "--enable-vm-service[=<port>[/<bind-address>]]\n"
 "  enables the VM service and listens on specified port for connections\n"
 "  (default port number is 8181, default bind address is localhost).\n"
@@ -206,6 +221,11 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+"--event-handler-threads=<count>\n"
+"  The number of threads polling sockets and timers. Each isolate uses one\n"
+"  of them. Shared server sockets get one listening socket per isolate.\n"
+#endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
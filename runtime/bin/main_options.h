@@ -26,8 +26,11 @@ namespace bin {
   V(shared_blobs, shared_blobs_filename)                                       \
   V(save_compilation_trace, save_compilation_trace_filename)                   \
   V(load_compilation_trace, load_compilation_trace_filename)                   \
+  V(save_type_feedback, save_type_feedback_filename)                           \
+  V(save_startup_trace, save_startup_trace_filename)                           \
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
+  V(kernel_cache, kernel_cache_directory)                                      \
   V(namespace, namespc)
 
 // As STRING_OPTIONS_LIST but for boolean valued options. The default value is
@@ -41,6 +44,7 @@ namespace bin {
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
   V(disable_exit, exit_disabled)                                               \
+  V(spawn_templates, spawn_templates)                                          \
   V(preview_dart_2, nop_option)
 
 // Boolean flags that have a short form.
@@ -10,10 +10,12 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <signal.h>        // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
 #include <sys/resource.h>  // NOLINT
+#include <sys/syscall.h>   // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
 
@@ -70,11 +72,20 @@ class ProcessInfoList {
  public:
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Like AddProcess, for a caller that holds mutex(). Holding it from before
+  // a process is created until it is added means that the exit code handler
+  // can't look the process up, and miss its exit code, before that.
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
   }
 
+  static Mutex* mutex() { return mutex_; }
+
   static intptr_t LookupProcessExitFd(pid_t pid) {
     MutexLocker locker(mutex_);
     ProcessInfo* current = active_processes_;
@@ -242,6 +253,9 @@ int ExitCodeHandler::process_count_ = 0;
 bool ExitCodeHandler::terminate_done_ = false;
 Monitor* ExitCodeHandler::monitor_ = new Monitor();
 
+// The shell that runs executables that are not binaries, as execvp does.
+static const char kShellPath[] = "/bin/sh";
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -303,37 +317,30 @@ class ProcessStarter {
       return err;
     }
 
-    // Fork to create the new process.
-    pid_t pid = TEMP_FAILURE_RETRY(fork());
-    if (pid < 0) {
-      // Failed to fork.
-      return CleanupAndReturnError();
-    } else if (pid == 0) {
-      // This runs in the new process.
-      NewProcess();
-    }
-
-    // This runs in the original process.
-
-    // If the child process is not started in detached mode, be sure to
-    // listen for exit-codes, now that we have a non detached child process
-    // and also Register this child process.
+    pid_t pid;
     if (Process::ModeIsAttached(mode_)) {
-      ExitCodeHandler::ProcessStarted();
-      err = RegisterProcess(pid);
+      err = SpawnAttached(&pid);
       if (err != 0) {
         return err;
       }
-    }
+    } else {
+      // Fork to create the new process.
+      pid = TEMP_FAILURE_RETRY(fork());
+      if (pid < 0) {
+        // Failed to fork.
+        return CleanupAndReturnError();
+      } else if (pid == 0) {
+        // This runs in the new process.
+        NewProcess();
+      }
 
-    // Notify child process to start. This is done to delay the call to exec
-    // until the process is registered above, and we are ready to receive the
-    // exit code.
-    char msg = '1';
-    int bytes_written =
-        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
-    if (bytes_written != sizeof(msg)) {
-      return CleanupAndReturnError();
+      // Notify child process to start.
+      char msg = '1';
+      int bytes_written =
+          FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
+      if (bytes_written != sizeof(msg)) {
+        return CleanupAndReturnError();
+      }
     }
 
     // Read the result of executing the child process.
@@ -428,21 +435,225 @@ class ProcessStarter {
       perror("Failed receiving notification message");
       exit(1);
     }
-    if (Process::ModeIsAttached(mode_)) {
-      ExecProcess();
+    ASSERT(!Process::ModeIsAttached(mode_));
+    ExecDetachedProcess();
+  }
+
+  // Starts an attached process with vfork and exec, so that the cost of
+  // starting it does not grow with the size of this process. The child shares
+  // the memory of this process until it calls exec, so everything it needs
+  // is prepared here, and it only makes system calls. This thread is
+  // suspended until the child has called exec or exited.
+  int SpawnAttached(pid_t* pid) {
+    int cwd_fd = -1;
+    if (working_directory_ != NULL) {
+      NamespaceScope ns(namespc_, working_directory_);
+      cwd_fd = TEMP_FAILURE_RETRY(openat64(
+          ns.fd(), ns.path(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+      if (cwd_fd == -1) {
+        return CleanupAndReturnError();
+      }
+    }
+    // A relative path_ is relative to the child's working directory.
+    char realpath[PATH_MAX];
+    if (!FindPathInNamespace(realpath, PATH_MAX, cwd_fd)) {
+      if (cwd_fd != -1) {
+        FDUtils::SaveErrorAndClose(cwd_fd);
+      }
+      return CleanupAndReturnError();
+    }
+    char** envp =
+        (program_environment_ != NULL) ? program_environment_ : environ;
+    // execvpe would search the PATH of this process, not the child's.
+    const char* search_path = SearchPath(envp);
+    intptr_t arguments_length = 0;
+    while (program_arguments_[arguments_length] != NULL) {
+      arguments_length++;
+    }
+    // Arguments for running the executable as a shell script, should it turn
+    // out not to be a binary. Slot 1 is filled in by the child.
+    char** shell_arguments = reinterpret_cast<char**>(
+        Dart_ScopeAllocate((arguments_length + 2) * sizeof(*shell_arguments)));
+    shell_arguments[0] = const_cast<char*>(kShellPath);
+    shell_arguments[1] = NULL;
+    for (intptr_t i = 1; i <= arguments_length; i++) {
+      shell_arguments[i + 1] = program_arguments_[i];
+    }
+    int event_fds[2];
+    if (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      if (cwd_fd != -1) {
+        VOID_TEMP_FAILURE_RETRY(close(cwd_fd));
+      }
+      return CleanupAndReturnError();
+    }
+
+    // No signal handler of this process may run in the child while it
+    // shares this process's memory.
+    sigset_t all_signals;
+    sigset_t old_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+    pid_t child;
+    int vfork_errno;
+    {
+      MutexLocker locker(ProcessInfoList::mutex());
+      child = vfork();
+      if (child == 0) {
+        ExecAttachedChild(realpath, cwd_fd, envp, search_path, shell_arguments,
+                          &old_signals);
+      }
+      vfork_errno = errno;
+      if (child > 0) {
+        ProcessInfoList::AddProcessLocked(child, event_fds[1]);
+      }
+    }
+    pthread_sigmask(SIG_SETMASK, &old_signals, NULL);
+    if (cwd_fd != -1) {
+      VOID_TEMP_FAILURE_RETRY(close(cwd_fd));
+    }
+    if (child < 0) {
+      VOID_TEMP_FAILURE_RETRY(close(event_fds[0]));
+      VOID_TEMP_FAILURE_RETRY(close(event_fds[1]));
+      errno = vfork_errno;
+      return CleanupAndReturnError();
+    }
+    ExitCodeHandler::ProcessStarted();
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    *pid = child;
+    return 0;
+  }
+
+  // Runs in the vfork child, see SpawnAttached. Does not return.
+  void ExecAttachedChild(const char* realpath,
+                         int cwd_fd,
+                         char** envp,
+                         const char* search_path,
+                         char** shell_arguments,
+                         const sigset_t* signal_mask) {
+    // The child has its own copy of the signal handlers. Reset the ones set
+    // by this process before unblocking signals again.
+    for (int sig = 1; sig < NSIG; sig++) {
+      struct sigaction action;
+      if ((sigaction(sig, NULL, &action) == 0) &&
+          (action.sa_handler != SIG_DFL) && (action.sa_handler != SIG_IGN)) {
+        action.sa_handler = SIG_DFL;
+        action.sa_flags = 0;
+        sigemptyset(&action.sa_mask);
+        sigaction(sig, &action, NULL);
+      }
+    }
+
+    if (mode_ == kNormal) {
+      if (TEMP_FAILURE_RETRY(dup2(write_out_[0], STDIN_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_in_[1], STDOUT_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_err_[1], STDERR_FILENO)) == -1) {
+        ReportChildError();
+      }
     } else {
-      ExecDetachedProcess();
+      ASSERT(mode_ == kInheritStdio);
+    }
+
+    if ((cwd_fd != -1) && (TEMP_FAILURE_RETRY(fchdir(cwd_fd)) == -1)) {
+      ReportChildError();
     }
+
+    pthread_sigmask(SIG_SETMASK, signal_mask, NULL);
+    ExecInPath(realpath, envp, search_path, shell_arguments);
+
+    ReportChildError();
   }
 
-  // Tries to find path_ relative to the current namespace.
+  // Returns the PATH of the environment envp, or the default used by execvp
+  // if it has none.
+  static const char* SearchPath(char** envp) {
+    for (char** entry = envp; *entry != NULL; entry++) {
+      if (strncmp(*entry, "PATH=", 5) == 0) {
+        return *entry + 5;
+      }
+    }
+    return "/bin:/usr/bin";
+  }
+
+  // Runs in the vfork child. Executes file like execvpe, except that a file
+  // without a '/' is looked up in search_path, the PATH of envp, rather than
+  // in the PATH of this process. Returns only on failure, with errno set.
+  void ExecInPath(const char* file,
+                  char** envp,
+                  const char* search_path,
+                  char** shell_arguments) {
+    if (strchr(file, '/') != NULL) {
+      ExecFile(file, envp, shell_arguments);
+      return;
+    }
+    const intptr_t file_length = strlen(file);
+    bool saw_eacces = false;
+    char candidate[PATH_MAX];
+    errno = ENOENT;
+    const char* dir = search_path;
+    while (true) {
+      const char* end = strchrnul(dir, ':');
+      const intptr_t dir_length = end - dir;
+      if (dir_length + file_length + 2 <= PATH_MAX) {
+        // An empty entry stands for the working directory.
+        intptr_t length = 0;
+        if (dir_length > 0) {
+          memmove(candidate, dir, dir_length);
+          length = dir_length;
+          candidate[length++] = '/';
+        }
+        memmove(candidate + length, file, file_length + 1);
+        ExecFile(candidate, envp, shell_arguments);
+        if (errno == EACCES) {
+          saw_eacces = true;
+        } else if ((errno != ENOENT) && (errno != ENOTDIR) &&
+                   (errno != ESTALE) && (errno != ENODEV) &&
+                   (errno != ETIMEDOUT)) {
+          // Give up on other errors, as execvp does.
+          return;
+        }
+      }
+      if (*end == '\0') {
+        break;
+      }
+      dir = end + 1;
+    }
+    if (saw_eacces) {
+      errno = EACCES;
+    }
+  }
+
+  // Runs in the vfork child. Executes path, or runs it with the shell if it
+  // is not a binary, as execvp does. Returns only on failure.
+  void ExecFile(const char* path, char** envp, char** shell_arguments) {
+    VOID_TEMP_FAILURE_RETRY(execve(
+        path, const_cast<char* const*>(program_arguments_), envp));
+    if (errno == ENOEXEC) {
+      shell_arguments[1] = const_cast<char*>(path);
+      VOID_TEMP_FAILURE_RETRY(execve(kShellPath, shell_arguments, envp));
+      errno = ENOEXEC;
+    }
+  }
+
+  // Tries to find path_ relative to the current namespace, or to dir_fd if
+  // it is not -1 and path_ is relative.
   // The path that should be passed to exec is returned in realpath.
   // Returns true on success, and false if there was an error that should
   // be reported to the parent.
-  bool FindPathInNamespace(char* realpath, intptr_t realpath_size) {
+  bool FindPathInNamespace(char* realpath,
+                           intptr_t realpath_size,
+                           int dir_fd = -1) {
     NamespaceScope ns(namespc_, path_);
-    const int fd =
-        TEMP_FAILURE_RETRY(openat64(ns.fd(), ns.path(), O_RDONLY | O_CLOEXEC));
+    const bool relative_to_dir = (dir_fd != -1) && (path_[0] != '/');
+    const int fd = TEMP_FAILURE_RETRY(
+        openat64(relative_to_dir ? dir_fd : ns.fd(),
+                 relative_to_dir ? path_ : ns.path(), O_RDONLY | O_CLOEXEC));
     if (fd == -1) {
       if ((errno == ENOENT) && (strchr(path_, '/') == NULL)) {
         // path_ was not found relative to the namespace, but since it didn't
@@ -468,43 +679,6 @@ class ProcessStarter {
     return true;
   }
 
-  void ExecProcess() {
-    if (mode_ == kNormal) {
-      if (TEMP_FAILURE_RETRY(dup2(write_out_[0], STDIN_FILENO)) == -1) {
-        ReportChildError();
-      }
-
-      if (TEMP_FAILURE_RETRY(dup2(read_in_[1], STDOUT_FILENO)) == -1) {
-        ReportChildError();
-      }
-
-      if (TEMP_FAILURE_RETRY(dup2(read_err_[1], STDERR_FILENO)) == -1) {
-        ReportChildError();
-      }
-    } else {
-      ASSERT(mode_ == kInheritStdio);
-    }
-
-    if (working_directory_ != NULL &&
-        !Directory::SetCurrent(namespc_, working_directory_)) {
-      ReportChildError();
-    }
-
-    if (program_environment_ != NULL) {
-      environ = program_environment_;
-    }
-
-    char realpath[PATH_MAX];
-    if (!FindPathInNamespace(realpath, PATH_MAX)) {
-      ReportChildError();
-    }
-    // TODO(dart:io) Test for the existence of execveat, and use it instead.
-    VOID_TEMP_FAILURE_RETRY(
-        execvp(realpath, const_cast<char* const*>(program_arguments_)));
-
-    ReportChildError();
-  }
-
   void ExecDetachedProcess() {
     if (mode_ == kDetached) {
       ASSERT(write_out_[0] == -1);
@@ -568,20 +742,6 @@ class ProcessStarter {
     }
   }
 
-  int RegisterProcess(pid_t pid) {
-    int result;
-    int event_fds[2];
-    result = TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC));
-    if (result < 0) {
-      return CleanupAndReturnError();
-    }
-
-    ProcessInfoList::AddProcess(pid, event_fds[1]);
-    *exit_event_ = event_fds[0];
-    FDUtils::SetNonBlocking(event_fds[0]);
-    return 0;
-  }
-
   int ReadExecResult() {
     int child_errno;
     int bytes_read = -1;
@@ -625,15 +785,8 @@ class ProcessStarter {
     ASSERT(mode_ == kDetached);
 
     // Close all open file descriptors except for exec_control_[1].
-    int max_fds = sysconf(_SC_OPEN_MAX);
-    if (max_fds == -1) {
-      max_fds = _POSIX_OPEN_MAX;
-    }
-    for (int fd = 0; fd < max_fds; fd++) {
-      if (fd != exec_control_[1]) {
-        VOID_TEMP_FAILURE_RETRY(close(fd));
-      }
-    }
+    int keep[] = {exec_control_[1]};
+    CloseFileDescriptorsExcept(keep, sizeof(keep) / sizeof(keep[0]));
 
     // Re-open stdin, stdout and stderr and connect them to /dev/null.
     // The loop above should already have closed all of them, so
@@ -656,16 +809,8 @@ class ProcessStarter {
     // Close all open file descriptors except for
     // exec_control_[1], write_out_[0], read_in_[1] and
     // read_err_[1].
-    int max_fds = sysconf(_SC_OPEN_MAX);
-    if (max_fds == -1) {
-      max_fds = _POSIX_OPEN_MAX;
-    }
-    for (int fd = 0; fd < max_fds; fd++) {
-      if ((fd != exec_control_[1]) && (fd != write_out_[0]) &&
-          (fd != read_in_[1]) && (fd != read_err_[1])) {
-        VOID_TEMP_FAILURE_RETRY(close(fd));
-      }
-    }
+    int keep[] = {exec_control_[1], write_out_[0], read_in_[1], read_err_[1]};
+    CloseFileDescriptorsExcept(keep, sizeof(keep) / sizeof(keep[0]));
 
     if (TEMP_FAILURE_RETRY(dup2(write_out_[0], STDIN_FILENO)) == -1) {
       ReportChildError();
@@ -683,6 +828,44 @@ class ProcessStarter {
     VOID_TEMP_FAILURE_RETRY(close(read_err_[1]));
   }
 
+  // Closes all file descriptors below the open file limit except for the
+  // count ones in keep, which is sorted in place. The gaps between them are
+  // closed with one close_range system call each where the kernel has it.
+  static void CloseFileDescriptorsExcept(int* keep, intptr_t count) {
+    int max_fds = sysconf(_SC_OPEN_MAX);
+    if (max_fds == -1) {
+      max_fds = _POSIX_OPEN_MAX;
+    }
+    for (intptr_t i = 1; i < count; i++) {
+      for (intptr_t j = i; (j > 0) && (keep[j - 1] > keep[j]); j--) {
+        int tmp = keep[j];
+        keep[j] = keep[j - 1];
+        keep[j - 1] = tmp;
+      }
+    }
+    int first = 0;
+    for (intptr_t i = 0; i <= count; i++) {
+      const int last = (i < count) ? keep[i] - 1 : max_fds - 1;
+      if (first <= last) {
+        CloseRange(first, last);
+      }
+      if (i < count) {
+        first = Utils::Maximum(first, keep[i] + 1);
+      }
+    }
+  }
+
+  static void CloseRange(int first, int last) {
+#if defined(__NR_close_range)
+    if (syscall(__NR_close_range, first, last, 0) == 0) {
+      return;
+    }
+#endif
+    for (int fd = first; fd <= last; fd++) {
+      VOID_TEMP_FAILURE_RETRY(close(fd));
+    }
+  }
+
   int CleanupAndReturnError() {
     int actual_errno = errno;
     // If CleanupAndReturnError is called without an actual errno make
@@ -76,9 +76,25 @@ void TestCaseBase::RunTest() {
 void Benchmark::RunBenchmark() {
   if ((run_filter == kAllBenchmarks) ||
       (strcmp(run_filter, this->name()) == 0)) {
+    BenchmarkPerfCounters counters;
+    const bool count = FLAG_benchmark_perf_counters && counters.Start();
     this->Run();
+    if (count) {
+      counters.Stop();
+    }
     bin::Log::Print("%s(%s): %" Pd64 "\n", this->name(), this->score_kind(),
                     this->score());
+    if (count) {
+      for (intptr_t i = 0; i < BenchmarkPerfCounters::kNumCounters; i++) {
+        BenchmarkPerfCounters::Counter counter =
+            static_cast<BenchmarkPerfCounters::Counter>(i);
+        if (counters.Value(counter) != -1) {
+          bin::Log::Print("%s(%s): %" Pd64 "\n", this->name(),
+                          BenchmarkPerfCounters::Name(counter),
+                          counters.Value(counter));
+        }
+      }
+    }
     run_matches++;
   } else if (run_filter == kList) {
     bin::Log::Print("%s\n", this->name());
@@ -297,7 +313,7 @@ static int Main(int argc, const char** argv) {
       dart::bin::DartUtils::OpenFile, dart::bin::DartUtils::ReadFile,
       dart::bin::DartUtils::WriteFile, dart::bin::DartUtils::CloseFile,
       nullptr /* entropy_source */, nullptr /* get_service_assets */,
-      start_kernel_isolate);
+      start_kernel_isolate, nullptr /* heap_growth */);
   if (error != nullptr) {
     bin::Log::PrintErr("Failed to initialize VM: %s\n", error);
     free(error);
@@ -87,13 +87,16 @@ void FUNCTION_NAME(SecureSocket_Init)(Dart_NativeArguments args) {
 
 void FUNCTION_NAME(SecureSocket_Connect)(Dart_NativeArguments args) {
   Dart_Handle host_name_object = ThrowIfError(Dart_GetNativeArgument(args, 1));
-  Dart_Handle context_object = ThrowIfError(Dart_GetNativeArgument(args, 2));
-  bool is_server = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 3));
+  int64_t port =
+      DartUtils::GetInt64ValueCheckRange(Dart_GetNativeArgument(args, 2), 0,
+                                         65535);
+  Dart_Handle context_object = ThrowIfError(Dart_GetNativeArgument(args, 3));
+  bool is_server = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 4));
   bool request_client_certificate =
-      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 4));
-  bool require_client_certificate =
       DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 5));
-  Dart_Handle protocols_handle = ThrowIfError(Dart_GetNativeArgument(args, 6));
+  bool require_client_certificate =
+      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 6));
+  Dart_Handle protocols_handle = ThrowIfError(Dart_GetNativeArgument(args, 7));
 
   const char* host_name = NULL;
   // TODO(whesse): Is truncating a Dart string containing \0 what we want?
@@ -109,7 +112,7 @@ void FUNCTION_NAME(SecureSocket_Connect)(Dart_NativeArguments args) {
   // The protocols_handle is guaranteed to be a valid Uint8List.
   // It will have the correct length encoding of the protocols array.
   ASSERT(!Dart_IsNull(protocols_handle));
-  GetFilter(args)->Connect(host_name, context, is_server,
+  GetFilter(args)->Connect(host_name, port, context, is_server,
                            request_client_certificate,
                            require_client_certificate, protocols_handle);
 }
@@ -432,11 +435,13 @@ void SSLFilter::InitializeLibrary() {
     SSL_library_init();
     filter_ssl_index = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
     ASSERT(filter_ssl_index >= 0);
+    SSLCertContext::InitializeSessionCache();
     library_initialized_ = true;
   }
 }
 
 void SSLFilter::Connect(const char* hostname,
+                        intptr_t port,
                         SSLCertContext* context,
                         bool is_server,
                         bool request_client_certificate,
@@ -479,6 +484,7 @@ void SSLFilter::Connect(const char* hostname,
     // against the certificate presented by the server.
     X509_VERIFY_PARAM* certificate_checking_parameters = SSL_get0_param(ssl_);
     hostname_ = strdup(hostname);
+    port_ = port;
     X509_VERIFY_PARAM_set_flags(
         certificate_checking_parameters,
         X509_V_FLAG_PARTIAL_CHAIN | X509_V_FLAG_TRUSTED_FIRST);
@@ -487,6 +493,7 @@ void SSLFilter::Connect(const char* hostname,
                                          hostname_, strlen(hostname_));
     SecureSocketUtils::CheckStatusSSL(
         status, "TlsException", "Set hostname for certificate checking", ssl_);
+    SSLCertContext::ResumeClientSession(ssl_, hostname_, port_);
   }
   // Make the connection:
   if (is_server_) {
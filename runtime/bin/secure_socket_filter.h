@@ -45,16 +45,19 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
         handshake_complete_(NULL),
         bad_certificate_callback_(NULL),
         in_handshake_(false),
-        hostname_(NULL) {}
+        hostname_(NULL),
+        port_(0) {}
 
   ~SSLFilter();
 
   char* hostname() const { return hostname_; }
+  intptr_t port() const { return port_; }
   bool is_server() const { return is_server_; }
   bool is_client() const { return !is_server_; }
 
   Dart_Handle Init(Dart_Handle dart_this);
   void Connect(const char* hostname,
+               intptr_t port,
                SSLCertContext* context,
                bool is_server,
                bool request_client_certificate,
@@ -107,6 +110,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   bool in_handshake_;
   bool is_server_;
   char* hostname_;
+  intptr_t port_;
 
   static bool IsBufferEncrypted(int i) {
     return static_cast<BufferIndex>(i) >= kFirstEncrypted;
@@ -83,6 +83,7 @@ class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   void connect(
       String hostName,
+      int port,
       SecurityContext context,
       bool is_server,
       bool requestClientCertificate,
@@ -102,6 +103,26 @@ class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   int processBuffer(int bufferIndex) => throw new UnimplementedError();
 
+  int readEncryptedFrom(RawSocket socket) {
+    if (socket is! _RawSocket) return -1;
+    _RawSocket rawSocket = socket;
+    if (rawSocket._isMacOSTerminalInput) return -1;
+    _NativeSocket nativeSocket = rawSocket._socket;
+    var buffer = buffers[_RawSecureSocket.readEncryptedId];
+    int read = 0;
+    // Loop over zero, one, or two linear free ranges.
+    int toRead = buffer.linearFree;
+    while (toRead > 0) {
+      int bytes =
+          nativeSocket.readInto(buffer.data, buffer.end, buffer.end + toRead);
+      if (bytes == 0) break;
+      buffer.advanceEnd(bytes);
+      read += bytes;
+      toRead = buffer.linearFree;
+    }
+    return read;
+  }
+
   String selectedProtocol() native "SecureSocket_GetSelectedProtocol";
 
   void renegotiate(bool useSessionCache, bool requestClientCertificate,
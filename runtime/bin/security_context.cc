@@ -35,6 +35,174 @@ namespace bin {
 const char* SSLCertContext::root_certs_file_ = NULL;
 const char* SSLCertContext::root_certs_cache_ = NULL;
 
+// A small cache of client sessions for one SSL_CTX, keyed by host name and
+// port. It is shared by every connection made with the context, possibly from
+// several threads, so all accesses take the lock.
+class ClientSessionCache {
+ public:
+  ClientSessionCache() : next_(0), hits_(0), misses_(0) {
+    for (intptr_t i = 0; i < kCapacity; i++) {
+      entries_[i].hostname = NULL;
+      entries_[i].port = 0;
+      entries_[i].session = NULL;
+    }
+  }
+
+  ~ClientSessionCache() {
+    for (intptr_t i = 0; i < kCapacity; i++) {
+      Clear(&entries_[i]);
+    }
+  }
+
+  // Takes ownership of [session].
+  void Insert(const char* hostname, intptr_t port, SSL_SESSION* session) {
+    MutexLocker locker(&mutex_);
+    Entry* entry = Find(hostname, port);
+    if (entry == NULL) {
+      entry = &entries_[next_];
+      next_ = (next_ + 1) % kCapacity;
+      Clear(entry);
+      entry->hostname = strdup(hostname);
+      entry->port = port;
+    } else {
+      SSL_SESSION_free(entry->session);
+    }
+    entry->session = session;
+  }
+
+  // Returns a new reference to a resumable session for [hostname] and [port],
+  // or NULL.
+  SSL_SESSION* Lookup(const char* hostname, intptr_t port) {
+    MutexLocker locker(&mutex_);
+    Entry* entry = Find(hostname, port);
+    SSL_SESSION* session = NULL;
+    if ((entry != NULL) && SSL_SESSION_is_resumable(entry->session)) {
+      session = entry->session;
+      if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION) {
+        // TLS 1.3 tickets should only be used once. The resumed connection
+        // will be sent fresh ones.
+        entry->session = NULL;
+        Clear(entry);
+      } else {
+        SSL_SESSION_up_ref(session);
+      }
+    }
+    if (session != NULL) {
+      hits_++;
+    } else {
+      misses_++;
+    }
+    if (SSL_LOG_STATUS) {
+      Log::Print("Session cache %s for %s:%" Pd " (%" Pd " hits, %" Pd
+                 " misses)\n",
+                 (session != NULL) ? "hit" : "miss", hostname, port, hits_,
+                 misses_);
+    }
+    return session;
+  }
+
+ private:
+  static const intptr_t kCapacity = 64;
+
+  struct Entry {
+    char* hostname;
+    intptr_t port;
+    SSL_SESSION* session;
+  };
+
+  Entry* Find(const char* hostname, intptr_t port) {
+    for (intptr_t i = 0; i < kCapacity; i++) {
+      if ((entries_[i].hostname != NULL) && (entries_[i].port == port) &&
+          (strcmp(entries_[i].hostname, hostname) == 0)) {
+        return &entries_[i];
+      }
+    }
+    return NULL;
+  }
+
+  static void Clear(Entry* entry) {
+    if (entry->session != NULL) {
+      SSL_SESSION_free(entry->session);
+      entry->session = NULL;
+    }
+    if (entry->hostname != NULL) {
+      free(entry->hostname);
+      entry->hostname = NULL;
+    }
+  }
+
+  Mutex mutex_;
+  Entry entries_[kCapacity];
+  intptr_t next_;
+  intptr_t hits_;
+  intptr_t misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(ClientSessionCache);
+};
+
+static int session_cache_index = -1;
+
+void SSLCertContext::InitializeSessionCache() {
+  session_cache_index =
+      SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, FreeSessionCache);
+  ASSERT(session_cache_index >= 0);
+}
+
+void SSLCertContext::FreeSessionCache(void* parent,
+                                      void* ptr,
+                                      CRYPTO_EX_DATA* ad,
+                                      int index,
+                                      long argl,  // NOLINT
+                                      void* argp) {
+  delete reinterpret_cast<ClientSessionCache*>(ptr);
+}
+
+void SSLCertContext::EnableClientSessionCache(SSL_CTX* ctx) {
+  // The cache is owned by the SSL_CTX, so it stays valid for as long as any
+  // connection made with the context.
+  SSL_CTX_set_ex_data(ctx, session_cache_index, new ClientSessionCache());
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_sess_set_new_cb(ctx, NewSessionCallback);
+}
+
+int SSLCertContext::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  if (SSL_is_server(ssl)) {
+    return 0;
+  }
+  SSLFilter* filter = static_cast<SSLFilter*>(
+      SSL_get_ex_data(ssl, SSLFilter::filter_ssl_index));
+  ClientSessionCache* cache = static_cast<ClientSessionCache*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), session_cache_index));
+  if ((filter == NULL) || (filter->hostname() == NULL) || (cache == NULL)) {
+    return 0;
+  }
+  // Only sessions whose certificate chain passed verification are cached. A
+  // resumed session skips verification, so caching one that was accepted by
+  // an onBadCertificate callback would let later connections through without
+  // ever asking the callback.
+  if (SSL_get_verify_result(ssl) != X509_V_OK) {
+    return 0;
+  }
+  cache->Insert(filter->hostname(), filter->port(), session);
+  // The cache now owns the session.
+  return 1;
+}
+
+void SSLCertContext::ResumeClientSession(SSL* ssl,
+                                         const char* hostname,
+                                         intptr_t port) {
+  ClientSessionCache* cache = static_cast<ClientSessionCache*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), session_cache_index));
+  if (cache == NULL) {
+    return;
+  }
+  SSL_SESSION* session = cache->Lookup(hostname, port);
+  if (session != NULL) {
+    SSL_set_session(ssl, session);
+    SSL_SESSION_free(session);
+  }
+}
+
 int SSLCertContext::CertificateCallback(int preverify_ok,
                                         X509_STORE_CTX* store_ctx) {
   if (preverify_ok == 1) {
@@ -824,6 +992,7 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, SSLCertContext::CertificateCallback);
   SSL_CTX_set_min_proto_version(ctx, TLS1_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  SSLCertContext::EnableClientSessionCache(ctx);
   SSLCertContext* context = new SSLCertContext(ctx);
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
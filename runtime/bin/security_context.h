@@ -84,7 +84,25 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   void RegisterCallbacks(SSL* ssl);
 
+  // Client-side session resumption. Sessions handed out by servers are cached
+  // on the SSL_CTX, keyed by host name and port, so that later connections
+  // made with the same context can resume them instead of doing a full
+  // handshake. Only sessions that passed certificate verification are cached.
+  static void InitializeSessionCache();
+  static void EnableClientSessionCache(SSL_CTX* ctx);
+  static void ResumeClientSession(SSL* ssl,
+                                  const char* hostname,
+                                  intptr_t port);
+
  private:
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
+  static void FreeSessionCache(void* parent,
+                               void* ptr,
+                               CRYPTO_EX_DATA* ad,
+                               int index,
+                               long argl,  // NOLINT
+                               void* argp);
+
   void AddCompiledInCerts();
   void LoadRootCertFile(const char* file);
   void LoadRootCertCache(const char* cache);
@@ -4,8 +4,13 @@
 
 #include "bin/socket.h"
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+#include <unistd.h>  // NOLINT
+#endif
+
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/file.h"
 #include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/lockers.h"
@@ -96,6 +101,16 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
                                                       bool shared) {
   MutexLocker ml(mutex_);
 
+  // With more than one event handler, each isolate binding a shared socket
+  // gets its own listening socket with SO_REUSEPORT. It is polled by the
+  // event handler of that isolate, and the kernel distributes the incoming
+  // connections between the isolates.
+#if defined(HOST_OS_LINUX)
+  const bool shard = shared && (EventHandler::thread_count() > 1);
+#else
+  const bool shard = false;
+#endif
+  intptr_t fd = -1;
   OSSocket* first_os_socket = NULL;
   intptr_t port = SocketAddress::GetAddrPort(addr);
   if (port > 0) {
@@ -125,32 +140,40 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
           return DartUtils::NewDartOSError(&os_error);
         }
 
-        // This socket creation is the exact same as the one which originally
-        // created the socket. We therefore increment the refcount and reuse
-        // the file descriptor.
-        os_socket->ref_count++;
-
-        // The same Socket is used by a second Dart _NativeSocket object.
-        // It Retains a reference.
-        os_socket->socketfd->Retain();
-        // We set as a side-effect the file descriptor on the dart
-        // socket_object.
-        Socket::ReuseSocketIdNativeField(socket_object, os_socket->socketfd,
-                                         Socket::kFinalizerListening);
-        return Dart_True();
+        if (shard) {
+          fd = ServerSocket::CreateBindListen(addr, backlog, v6_only, true);
+        }
+        if (fd < 0) {
+          // This socket creation is the exact same as the one which
+          // originally created the socket. We therefore increment the
+          // refcount and reuse the file descriptor.
+          os_socket->ref_count++;
+
+          // The same Socket is used by a second Dart _NativeSocket object.
+          // It Retains a reference.
+          os_socket->socketfd->Retain();
+          // We set as a side-effect the file descriptor on the dart
+          // socket_object.
+          Socket::ReuseSocketIdNativeField(socket_object, os_socket->socketfd,
+                                           Socket::kFinalizerListening);
+          return Dart_True();
+        }
       }
     }
   }
 
-  // There is no socket listening on that (address, port), so we create new one.
-  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
-  if (fd == -5) {
-    OSError os_error(-1, "Invalid host", OSError::kUnknown);
-    return DartUtils::NewDartOSError(&os_error);
-  }
   if (fd < 0) {
-    OSError error;
-    return DartUtils::NewDartOSError(&error);
+    // There is no socket listening on that (address, port), so we create new
+    // one.
+    fd = ServerSocket::CreateBindListen(addr, backlog, v6_only, shard);
+    if (fd == -5) {
+      OSError os_error(-1, "Invalid host", OSError::kUnknown);
+      return DartUtils::NewDartOSError(&os_error);
+    }
+    if (fd < 0) {
+      OSError error;
+      return DartUtils::NewDartOSError(&error);
+    }
   }
   if (!ServerSocket::StartAccept(fd)) {
     OSError os_error(-1, "Failed to start accept", OSError::kUnknown);
@@ -332,33 +355,26 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = NULL;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    uint8_t* buffer = IOBuffer::Allocate(length);
+    if (buffer == NULL) {
       Dart_SetReturnValue(args, DartUtils::NewDartOSError());
       return;
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != NULL);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = NULL;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-        return;
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
+    if (bytes_read <= 0) {
+      IOBuffer::Free(buffer);
+    }
+    if (bytes_read > 0) {
+      if (bytes_read < length) {
+        // Give back the unused end of the buffer instead of copying the data
+        // into a smaller one.
+        uint8_t* shrunk = IOBuffer::Reallocate(buffer, bytes_read);
+        if (shrunk != NULL) {
+          buffer = shrunk;
+        }
       }
-      ASSERT(new_buffer != NULL);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, bytes_read));
     } else if (bytes_read == 0) {
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
@@ -373,6 +389,43 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  // The range is checked in Dart code.
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  intptr_t length = end - start;
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
+  }
+  Dart_TypedData_Type type;
+  uint8_t* buffer = NULL;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((type == Dart_TypedData_kUint8) || (type == Dart_TypedData_kInt8));
+  ASSERT(end <= len);
+  // The socket is non-blocking, so the data is only held across a single
+  // read call.
+  intptr_t bytes_read = SocketBase::Read(socket->fd(), buffer + start,
+                                         length, SocketBase::kAsync);
+  result = Dart_TypedDataReleaseData(buffer_obj);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  if (bytes_read >= 0) {
+    Dart_SetReturnValue(args, Dart_NewInteger(bytes_read));
+  } else {
+    ASSERT(bytes_read == -1);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+}
+
 void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
   // handle 64k datagrams.
@@ -380,18 +433,20 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
 
-  // Ensure that a receive buffer for the UDP socket exists.
   ASSERT(socket != NULL);
-  uint8_t* recv_buffer = socket->udp_receive_buffer();
+  uint8_t* recv_buffer = IOBuffer::Allocate(kReceiveBufferLen);
   if (recv_buffer == NULL) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
-    socket->set_udp_receive_buffer(recv_buffer);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
   }
 
   // Read data into the buffer.
   RawAddr addr;
   const intptr_t bytes_read = SocketBase::RecvFrom(
       socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
+  if (bytes_read <= 0) {
+    IOBuffer::Free(recv_buffer);
+  }
   if (bytes_read == 0) {
     Dart_SetReturnValue(args, Dart_Null());
     return;
@@ -402,19 +457,14 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
     return;
   }
 
-  // Datagram data read. Copy into buffer of the exact size,
+  // Datagram data read. Shrink the buffer to the size of the datagram, which
+  // normally happens in place, so the data is not copied.
   ASSERT(bytes_read > 0);
-  uint8_t* data_buffer = NULL;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
-  if (Dart_IsNull(data)) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    return;
+  uint8_t* data_buffer = IOBuffer::Reallocate(recv_buffer, bytes_read);
+  if (data_buffer == NULL) {
+    data_buffer = recv_buffer;
   }
-  if (Dart_IsError(data)) {
-    Dart_PropagateError(data);
-  }
-  ASSERT(data_buffer != NULL);
-  memmove(data_buffer, recv_buffer, bytes_read);
+  Dart_Handle data = IOBuffer::Wrap(data_buffer, bytes_read);
 
   // Get the port and clear it in the sockaddr structure.
   int port = SocketAddress::GetAddrPort(addr);
@@ -494,6 +544,109 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+// Writes a list of buffers with one system call. The buffers are Uint8Lists
+// or Int8Lists, each written from the start to the end in the corresponding
+// elements of the lists of starts and ends. Only the first
+// SocketBase::kMaxWriteVectorCount buffers are written.
+void FUNCTION_NAME(Socket_WriteBuffers)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle starts_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 3);
+  ASSERT(Dart_IsList(buffers_obj));
+  intptr_t count = 0;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(count > 0);
+  count = Utils::Minimum(count, SocketBase::kMaxWriteVectorCount);
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    // Only forced short writes of the first buffer are supported, which
+    // WriteList reports as such.
+    count = 1;
+  }
+
+  // Look up the arguments before acquiring the data, which prevents calls
+  // into the VM.
+  Dart_Handle buffer_objs[SocketBase::kMaxWriteVectorCount];
+  intptr_t starts[SocketBase::kMaxWriteVectorCount];
+  intptr_t lengths[SocketBase::kMaxWriteVectorCount];
+  for (intptr_t i = 0; i < count; i++) {
+    buffer_objs[i] = Dart_ListGetAt(buffers_obj, i);
+    if (Dart_IsError(buffer_objs[i])) {
+      Dart_PropagateError(buffer_objs[i]);
+    }
+    starts[i] = DartUtils::GetIntptrValue(Dart_ListGetAt(starts_obj, i));
+    lengths[i] =
+        DartUtils::GetIntptrValue(Dart_ListGetAt(ends_obj, i)) - starts[i];
+  }
+  if (Socket::short_socket_write()) {
+    if (lengths[0] > 1) {
+      short_write = true;
+    }
+    lengths[0] = (lengths[0] + 1) / 2;
+  }
+
+  uint8_t* buffers[SocketBase::kMaxWriteVectorCount];
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedData_Type type;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(
+        buffer_objs[i], &type, reinterpret_cast<void**>(&buffers[i]), &len);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) {
+        Dart_TypedDataReleaseData(buffer_objs[j]);
+      }
+      Dart_PropagateError(result);
+    }
+    ASSERT((starts[i] + lengths[i]) <= len);
+    buffers[i] += starts[i];
+  }
+  intptr_t bytes_written = SocketBase::WriteVector(
+      socket->fd(), buffers, lengths, count, SocketBase::kAsync);
+  if (bytes_written < 0) {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    for (intptr_t i = 0; i < count; i++) {
+      Dart_TypedDataReleaseData(buffer_objs[i]);
+    }
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedDataReleaseData(buffer_objs[i]);
+  }
+  if (short_write) {
+    // If the write was forced 'short', indicate by returning the negative
+    // number of bytes. A forced short write may not trigger a write event.
+    Dart_SetReturnValue(args, Dart_NewInteger(-bytes_written));
+  } else {
+    Dart_SetReturnValue(args, Dart_NewInteger(bytes_written));
+  }
+}
+
+// Returns a duplicate of the socket's file descriptor for a SendFile request.
+// The request runs on an IO service thread, and the duplicate keeps the socket
+// open even if the event handler closes the original meanwhile.
+void FUNCTION_NAME(Socket_DupForSendFile)(Dart_NativeArguments args) {
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  const intptr_t fd = NO_RETRY_EXPECTED(dup(socket->fd()));
+  if (fd >= 0) {
+    Dart_SetReturnValue(args, Dart_NewInteger(fd));
+  } else {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+#else
+  OSError os_error(-1, "sendfile is not supported", OSError::kUnknown);
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+#endif
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -691,6 +844,53 @@ CObject* Socket::LookupRequest(const CObjectArray& request) {
   return CObject::IllegalArgumentError();
 }
 
+static int64_t CObjectToInt64(CObject* cobject) {
+  if (cobject->IsInt32()) {
+    CObjectInt32 value(cobject);
+    return value.Value();
+  }
+  CObjectInt64 value(cobject);
+  return value.Value();
+}
+
+// Sends part of a file on a socket, so that any disk reads for it are done
+// on the IO service thread. The request holds the file pointer, the socket
+// descriptor from Socket_DupForSendFile, which is closed here, the file
+// offset and the number of bytes. Returns the number of bytes sent, which
+// is less than requested if the socket would block.
+CObject* Socket::SendFileRequest(const CObjectArray& request) {
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+  if ((request.Length() != 4) || !request[0]->IsIntptr() ||
+      !request[1]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectIntptr file_pointer(request[0]);
+  File* file = reinterpret_cast<File*>(file_pointer.Value());
+  RefCntReleaseScope<File> rs(file);
+  CObjectIntptr socket_fd(request[1]);
+  const intptr_t fd = socket_fd.Value();
+  if (!request[2]->IsInt32OrInt64() || !request[3]->IsInt32OrInt64()) {
+    VOID_NO_RETRY_EXPECTED(close(fd));
+    return CObject::IllegalArgumentError();
+  }
+  if (file->IsClosed()) {
+    VOID_NO_RETRY_EXPECTED(close(fd));
+    return CObject::FileClosedError();
+  }
+  const int64_t offset = CObjectToInt64(request[2]);
+  const int64_t length = CObjectToInt64(request[3]);
+  const intptr_t bytes_written = SocketBase::SendFile(
+      fd, file->GetFD(), offset, length, SocketBase::kAsync);
+  CObject* result = (bytes_written >= 0)
+                        ? new CObjectInt64(CObject::NewInt64(bytes_written))
+                        : CObject::NewOSError();
+  VOID_NO_RETRY_EXPECTED(close(fd));
+  return result;
+#else
+  return CObject::IllegalArgumentError();
+#endif
+}
+
 CObject* Socket::ReverseLookupRequest(const CObjectArray& request) {
   if ((request.Length() == 1) && request[0]->IsTypedData()) {
     CObjectUint8Array addr_object(request[0]);
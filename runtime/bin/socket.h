@@ -56,9 +56,6 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port port() const { return port_; }
   void set_port(Dart_Port port) { port_ = port; }
 
-  uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
-  void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
-
   static bool Initialize();
 
   // Creates a socket which is bound and connected. The port to connect to is
@@ -78,6 +75,7 @@ class Socket : public ReferenceCounted<Socket> {
   static CObject* LookupRequest(const CObjectArray& request);
   static CObject* ListInterfacesRequest(const CObjectArray& request);
   static CObject* ReverseLookupRequest(const CObjectArray& request);
+  static CObject* SendFileRequest(const CObjectArray& request);
 
   static Dart_Port GetServicePort();
 
@@ -103,11 +101,7 @@ class Socket : public ReferenceCounted<Socket> {
   }
 
  private:
-  ~Socket() {
-    ASSERT(fd_ == kClosedFd);
-    free(udp_receive_buffer_);
-    udp_receive_buffer_ = NULL;
-  }
+  ~Socket() { ASSERT(fd_ == kClosedFd); }
 
   static const int kClosedFd = -1;
 
@@ -117,7 +111,6 @@ class Socket : public ReferenceCounted<Socket> {
   intptr_t fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
-  uint8_t* udp_receive_buffer_;
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -130,7 +123,10 @@ class ServerSocket {
   static intptr_t Accept(intptr_t fd);
 
   // Creates a socket which is bound and listens. The port to listen on is
-  // specified in the port component of the passed RawAddr structure.
+  // specified in the port component of the passed RawAddr structure. With
+  // reuse_port, other sockets created the same way can listen on the same
+  // (address, port) and the kernel distributes incoming connections between
+  // them. It is only supported on Linux and Android and ignored elsewhere.
   //
   // Returns a positive integer if the call is successful. In case of failure
   // it returns:
@@ -139,7 +135,8 @@ class ServerSocket {
   //   -5: invalid bindAddress
   static intptr_t CreateBindListen(const RawAddr& addr,
                                    intptr_t backlog,
-                                   bool v6_only = false);
+                                   bool v6_only = false,
+                                   bool reuse_port = false);
 
   // Start accepting on a newly created listening socket. If it was unable to
   // start accepting incoming sockets, the fd is invalidated.
@@ -20,8 +20,7 @@ Socket::Socket(intptr_t fd)
     : ReferenceCounted(),
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
-      port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {}
+      port_(ILLEGAL_PORT) {}
 
 void Socket::SetClosedFd() {
   fd_ = kClosedFd;
@@ -128,7 +127,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   intptr_t fd;
 
   fd = NO_RETRY_EXPECTED(socket(addr.ss.ss_family, SOCK_STREAM, 0));
@@ -162,7 +162,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
       (SocketBase::GetPort(fd) == 65535)) {
     // Don't close the socket until we have created a new socket, ensuring
     // that we do not get the bad port number again.
-    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only, reuse_port);
     FDUtils::SaveErrorAndClose(fd);
     return new_fd;
   }
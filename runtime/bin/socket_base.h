@@ -152,6 +152,25 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes count buffers in order, with a single system call where the
+  // platform supports it. Like Write, returns the number of bytes written,
+  // which may be less than the total length, or -1 on error.
+  static intptr_t WriteVector(intptr_t fd,
+                              uint8_t* const* buffers,
+                              const intptr_t* lengths,
+                              intptr_t count,
+                              SocketOpKind sync);
+  // The maximum number of buffers passed to WriteVector.
+  static const intptr_t kMaxWriteVectorCount = 64;
+  // Sends num_bytes of the file file_fd from offset on the socket, without
+  // copying them through a buffer. Returns the number of bytes sent, which
+  // may be less than num_bytes, or -1 on error. Fails with ENOSYS on
+  // platforms that do not support this.
+  static intptr_t SendFile(intptr_t fd,
+                           intptr_t file_fd,
+                           int64_t offset,
+                           intptr_t num_bytes,
+                           SocketOpKind sync);
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
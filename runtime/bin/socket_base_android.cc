@@ -7,13 +7,14 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -102,6 +103,24 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  off_t file_offset = offset;
+  ssize_t written_bytes =
+      TEMP_FAILURE_RETRY(sendfile(fd, file_fd, &file_offset, num_bytes));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -104,6 +104,15 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  errno = ENOSYS;
+  return -1;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -0,0 +1,45 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_MACOS) ||                        \
+    defined(HOST_OS_ANDROID)
+
+#include "bin/socket_base.h"
+
+#include <errno.h>    // NOLINT
+#include <sys/uio.h>  // NOLINT
+
+#include "platform/signal_blocker.h"
+
+namespace dart {
+namespace bin {
+
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 uint8_t* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((count > 0) && (count <= kMaxWriteVectorCount));
+  struct iovec vectors[kMaxWriteVectorCount];
+  for (intptr_t i = 0; i < count; i++) {
+    vectors[i].iov_base = buffers[i];
+    vectors[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, vectors, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_MACOS) ||
+        // defined(HOST_OS_ANDROID)
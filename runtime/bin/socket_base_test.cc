@@ -0,0 +1,79 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_MACOS) ||                        \
+    defined(HOST_OS_ANDROID)
+
+#include <fcntl.h>       // NOLINT
+#include <string.h>      // NOLINT
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+
+#include "bin/socket_base.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+VM_UNIT_TEST_CASE(SocketBase_WriteVector) {
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  uint8_t first[] = {1, 2, 3};
+  uint8_t second[] = {4};
+  uint8_t third[] = {5, 6, 7, 8, 9};
+  uint8_t* buffers[] = {first, second, third};
+  const intptr_t lengths[] = {3, 1, 5};
+  EXPECT_EQ(9, SocketBase::WriteVector(fds[0], buffers, lengths, 3,
+                                       SocketBase::kSync));
+
+  // The buffers arrive in order, as one stream of bytes.
+  uint8_t received[9];
+  intptr_t total = 0;
+  while (total < 9) {
+    const intptr_t bytes = read(fds[1], received + total, 9 - total);
+    EXPECT(bytes > 0);
+    if (bytes <= 0) break;
+    total += bytes;
+  }
+  for (intptr_t i = 0; i < total; i++) {
+    EXPECT_EQ(i + 1, received[i]);
+  }
+
+  // When the socket is full, asynchronous writes write as much as fits and
+  // then report that nothing was written, instead of an error.
+  EXPECT_NE(-1, fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK));
+  const intptr_t kChunkSize = 64 * KB;
+  uint8_t* chunk = new uint8_t[kChunkSize];
+  memset(chunk, 0xab, kChunkSize);
+  uint8_t* chunks[SocketBase::kMaxWriteVectorCount];
+  intptr_t chunk_lengths[SocketBase::kMaxWriteVectorCount];
+  for (intptr_t i = 0; i < SocketBase::kMaxWriteVectorCount; i++) {
+    chunks[i] = chunk;
+    chunk_lengths[i] = kChunkSize;
+  }
+  intptr_t written = 0;
+  intptr_t last = 0;
+  for (intptr_t i = 0; i < 100; i++) {
+    last = SocketBase::WriteVector(fds[0], chunks, chunk_lengths,
+                                   SocketBase::kMaxWriteVectorCount,
+                                   SocketBase::kAsync);
+    EXPECT(last >= 0);
+    if (last <= 0) break;
+    written += last;
+  }
+  EXPECT_EQ(0, last);
+  EXPECT(written > 0);
+  delete[] chunk;
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_MACOS) ||
+        // defined(HOST_OS_ANDROID)
@@ -96,6 +96,36 @@ intptr_t SocketBase::Write(intptr_t fd,
   return handle->Write(buffer, num_bytes);
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 uint8_t* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  // There is no vectored write for these handles; write the buffers one by
+  // one until a write is short.
+  intptr_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = Write(fd, buffers[i], lengths[i], sync);
+    if (written_bytes < 0) {
+      return (total > 0) ? total : written_bytes;
+    }
+    total += written_bytes;
+    if (written_bytes < lengths[i]) {
+      break;
+    }
+  }
+  return total;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  SetLastError(ERROR_NOT_SUPPORTED);
+  return -1;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -21,8 +21,7 @@ Socket::Socket(intptr_t fd)
     : ReferenceCounted(),
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
-      port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {}
+      port_(ILLEGAL_PORT) {}
 
 void Socket::SetClosedFd() {
   fd_ = kClosedFd;
@@ -129,7 +128,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   intptr_t fd;
 
   fd = NO_RETRY_EXPECTED(
@@ -142,6 +142,15 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
   VOID_NO_RETRY_EXPECTED(
       setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)));
 
+#ifdef SO_REUSEPORT  // Not all Linux versions support this.
+  if (reuse_port) {
+    // If the kernel does not support it, binding a second socket fails and
+    // the caller shares this one instead.
+    VOID_NO_RETRY_EXPECTED(
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval)));
+  }
+#endif  // SO_REUSEPORT
+
   if (addr.ss.ss_family == AF_INET6) {
     optval = v6_only ? 1 : 0;
     VOID_NO_RETRY_EXPECTED(
@@ -159,7 +168,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
       (SocketBase::GetPort(fd) == 65535)) {
     // Don't close the socket until we have created a new socket, ensuring
     // that we do not get the bad port number again.
-    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only, reuse_port);
     FDUtils::SaveErrorAndClose(fd);
     return new_fd;
   }
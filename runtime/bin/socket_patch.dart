@@ -250,6 +250,14 @@ class _NetworkInterface implements NetworkInterface {
 // implicit constructor.
 class _NativeSocketNativeWrapper extends NativeFieldWrapperClass1 {}
 
+// A host lookup, in flight while its expiry is null.
+class _HostLookup {
+  final Future<List<InternetAddress>> result;
+  int expiry;
+
+  _HostLookup(this.result);
+}
+
 // The _NativeSocket class encapsulates an OS socket.
 class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   // Bit flags used when communicating between the eventhandler and
@@ -360,8 +368,61 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   // a HttpServer, a WebSocket connection, a process pipe, etc.
   Object owner;
 
+  // Host lookups block an IO service thread in getaddrinfo, so lookups of
+  // the same host and address type that are in flight at the same time share
+  // one request, and results are cached for a short while. getaddrinfo does
+  // not report TTLs, so addresses are kept for _lookupCacheDuration and
+  // failures for _lookupFailureCacheDuration. Running with
+  // -Ddart.io.lookup_cache=false sends every lookup to getaddrinfo.
+  static const bool _lookupCacheEnabled =
+      const bool.fromEnvironment("dart.io.lookup_cache", defaultValue: true);
+  static const Duration _lookupCacheDuration = const Duration(seconds: 5);
+  static const Duration _lookupFailureCacheDuration =
+      const Duration(seconds: 1);
+  static const int _lookupCacheMaxEntries = 256;
+  static final Stopwatch _lookupClock = new Stopwatch()..start();
+  static final Map<String, _HostLookup> _lookups = new HashMap();
+
   static Future<List<InternetAddress>> lookup(String host,
       {InternetAddressType type: InternetAddressType.any}) {
+    if (!_lookupCacheEnabled) {
+      return _lookupAddresses(host, type)
+          .then((addresses) => addresses.toList());
+    }
+    var key = "${type._value}:$host";
+    var lookup = _lookups[key];
+    if (lookup != null &&
+        (lookup.expiry == null ||
+            lookup.expiry > _lookupClock.elapsedMicroseconds)) {
+      return lookup.result.then((addresses) => addresses.toList());
+    }
+    if (_lookups.length >= _lookupCacheMaxEntries) {
+      _evictExpiredLookups();
+    }
+    lookup = new _HostLookup(_lookupAddresses(host, type));
+    _lookups[key] = lookup;
+    lookup.result.then((_) {
+      lookup.expiry = _lookupClock.elapsedMicroseconds +
+          _lookupCacheDuration.inMicroseconds;
+    }, onError: (_) {
+      lookup.expiry = _lookupClock.elapsedMicroseconds +
+          _lookupFailureCacheDuration.inMicroseconds;
+    });
+    return lookup.result.then((addresses) => addresses.toList());
+  }
+
+  static void _evictExpiredLookups() {
+    var now = _lookupClock.elapsedMicroseconds;
+    _lookups.removeWhere((key, lookup) =>
+        lookup.expiry != null && lookup.expiry <= now);
+    if (_lookups.length >= _lookupCacheMaxEntries) {
+      // Everything is recent or in flight. Drop the completed entries.
+      _lookups.removeWhere((key, lookup) => lookup.expiry != null);
+    }
+  }
+
+  static Future<List<InternetAddress>> _lookupAddresses(
+      String host, InternetAddressType type) {
     return _IOService._dispatch(_IOService.socketLookup, [host, type._value])
         .then((response) {
       if (isErrorResponse(response)) {
@@ -370,11 +431,34 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
         return response.skip(1).map<InternetAddress>((result) {
           var type = new InternetAddressType._from(result[0]);
           return new _InternetAddress(result[1], host, result[2]);
-        }).toList();
+        }).toList(growable: false);
       }
     });
   }
 
+  // Orders the addresses so that the address families alternate, starting
+  // with the family of the first address, as recommended for happy eyeballs
+  // (RFC 8305). The staggered connects in startConnect then try the other
+  // family after one retry delay instead of after all addresses of the
+  // first one.
+  static List<InternetAddress> _interleaveAddressFamilies(
+      List<InternetAddress> addresses) {
+    if (addresses.length < 3) return addresses;
+    var first = <InternetAddress>[];
+    var second = <InternetAddress>[];
+    var firstType = addresses[0].type;
+    for (var address in addresses) {
+      (address.type == firstType ? first : second).add(address);
+    }
+    if (second.isEmpty) return addresses;
+    var result = <InternetAddress>[];
+    for (int i = 0; i < first.length || i < second.length; i++) {
+      if (i < first.length) result.add(first[i]);
+      if (i < second.length) result.add(second[i]);
+    }
+    return result;
+  }
+
   static Future<InternetAddress> reverseLookup(InternetAddress addr) {
     return _IOService._dispatch(_IOService.socketReverseLookup,
         [(addr as _InternetAddress)._in_addr]).then((response) {
@@ -426,7 +510,7 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
         if (addresses.isEmpty) {
           throw createError(null, "Failed host lookup: '$host'");
         }
-        return addresses;
+        return _interleaveAddressFamilies(addresses);
       });
     }).then((addresses) {
       var completer = new Completer<_NativeSocket>();
@@ -663,6 +747,27 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  // Reads at most end - start of the available bytes into the external
+  // buffer, and returns the number of bytes read.
+  int readInto(List<int> buffer, int start, int end) {
+    if (isClosing || isClosed) return 0;
+    int len = min(available, end - start);
+    if (len == 0) return 0;
+    var result = nativeReadInto(buffer, start, start + len);
+    if (result is OSError) {
+      reportError(result, "Read failed");
+      return 0;
+    }
+    available -= result;
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.totalRead += result;
+      resourceInfo.didRead();
+    }
+    return result;
+  }
+
   Datagram receive() {
     if (isClosing || isClosed) return null;
     var result = nativeRecvFrom();
@@ -734,6 +839,78 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  // Writes as much as possible of the buffers, starting at offset in the
+  // first one, with a single system call. Returns the number of bytes
+  // written.
+  int writeBuffers(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    var count = buffers.length;
+    var fastBuffers = new List(count);
+    var starts = new List<int>(count);
+    var ends = new List<int>(count);
+    int bytes = 0;
+    for (int i = 0; i < count; i++) {
+      var buffer = buffers[i];
+      var start = (i == 0) ? offset : 0;
+      _BufferAndStart bufferAndStart =
+          _ensureFastAndSerializableByteData(buffer, start, buffer.length);
+      fastBuffers[i] = bufferAndStart.buffer;
+      starts[i] = bufferAndStart.start;
+      ends[i] = bufferAndStart.start + buffer.length - start;
+      bytes += buffer.length - start;
+    }
+    if (bytes == 0) return 0;
+    var result = nativeWriteBuffers(fastBuffers, starts, ends);
+    if (result is OSError) {
+      OSError osError = result;
+      scheduleMicrotask(() => reportError(osError, "Write failed"));
+      result = 0;
+    }
+    // As in write, a negative result is a forced short write, which may not
+    // trigger a write event.
+    if (result >= 0 && result < bytes) {
+      writeAvailable = false;
+    }
+    if (result < 0) result = -result;
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.addWrite(result);
+    }
+    return result;
+  }
+
+  // Sends up to length bytes of the file from position, without copying them
+  // through the Dart heap. The send runs on an IO service thread, since it
+  // may have to read the file from disk. Completes with the number of bytes
+  // sent, which is less than length if the socket would block.
+  Future<int> sendFile(_RandomAccessFile file, int position, int length) {
+    if (isClosing || isClosed) return new Future.value(0);
+    if (file.closed) {
+      return new Future.error(
+          new FileSystemException("File closed", file.path));
+    }
+    var fd = nativeDupForSendFile();
+    if (fd is OSError) {
+      return new Future.error(createError(fd, "Send file failed"));
+    }
+    return file._dispatch(
+        _IOService.socketSendFile, [null, fd, position, length]).then((result) {
+      if (_isErrorResponse(result)) {
+        throw _exceptionFromResponse(result, "Send file failed", file.path);
+      }
+      if (result < length) {
+        writeAvailable = false;
+      }
+      // TODO(ricow): Remove when we track internal and pipe uses.
+      assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+      if (resourceInfo != null) {
+        resourceInfo.addWrite(result);
+      }
+      return result;
+    });
+  }
+
   int send(List<int> buffer, int offset, int bytes, InternetAddress address,
       int port) {
     _throwOnBadPort(port);
@@ -1126,9 +1303,14 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   void nativeSetSocketId(int id, int typeFlags) native "Socket_SetSocketId";
   nativeAvailable() native "Socket_Available";
   nativeRead(int len) native "Socket_Read";
+  nativeReadInto(List<int> buffer, int start, int end)
+      native "Socket_ReadInto";
   nativeRecvFrom() native "Socket_RecvFrom";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeWriteBuffers(List buffers, List<int> starts, List<int> ends)
+      native "Socket_WriteBuffers";
+  nativeDupForSendFile() native "Socket_DupForSendFile";
   nativeSendTo(List<int> buffer, int offset, int bytes, List<int> address,
       int port) native "Socket_SendTo";
   nativeCreateConnect(List<int> addr, int port) native "Socket_CreateConnect";
@@ -1470,26 +1652,46 @@ class Socket {
 }
 
 class _SocketStreamConsumer extends StreamConsumer<List<int>> {
+  // Chunks are queued while the socket is not writable, and written together
+  // when it is, until this many bytes are pending.
+  static const int _maxPendingBytes = 64 * 1024;
+
   StreamSubscription subscription;
   final _Socket socket;
-  int offset;
-  List<int> buffer;
+  // The chunks not yet written, and how much of the first one was written.
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int pendingBytes = 0;
   bool paused = false;
+  bool streamDone = false;
   Completer streamCompleter;
+  // The file being sent with sendfile, the range left to send, and the send
+  // in progress, if any.
+  RandomAccessFile file;
+  int filePosition;
+  int fileEnd;
+  Future fileSend;
 
   _SocketStreamConsumer(this.socket);
 
   Future<Socket> addStream(Stream<List<int>> stream) {
     socket._ensureRawSocketSubscription();
     streamCompleter = new Completer<Socket>();
-    if (socket._raw != null) {
+    if (socket._raw != null && _canSendFile(stream)) {
+      _startSendFile(stream);
+    } else if (socket._raw != null) {
       subscription = stream.listen((data) {
         assert(!paused);
-        assert(buffer == null);
-        buffer = data;
-        offset = 0;
+        buffers.add(data);
+        pendingBytes += data.length;
         try {
-          write();
+          if (buffers.length == 1) {
+            write();
+          } else {
+            // A write event is pending; write this chunk together with the
+            // others then.
+            _pauseIfFull();
+          }
         } catch (e) {
           socket.destroy();
           stop();
@@ -1499,7 +1701,12 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
         socket.destroy();
         done(error, stackTrace);
       }, onDone: () {
-        done();
+        if (buffers.isEmpty) {
+          done();
+        } else {
+          // Complete when the pending chunks have been written.
+          streamDone = true;
+        }
       }, cancelOnError: true);
     }
     return streamCompleter.future;
@@ -1510,27 +1717,119 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
     return new Future.value(socket);
   }
 
+  // Whether the stream is the contents of a file, as from File.openRead, that
+  // can be sent with sendfile instead of being read into the Dart heap.
+  bool _canSendFile(Stream<List<int>> stream) {
+    return (Platform.isLinux || Platform.isAndroid) &&
+        stream is _FileStream &&
+        stream._path != null &&
+        stream._controller == null &&
+        !stream._transferred &&
+        socket._raw is _RawSocket;
+  }
+
+  void _startSendFile(_FileStream stream) {
+    var start = stream._position;
+    var end = stream._end;
+    // The stream opens the file, as it would when listened to, and can't be
+    // listened to afterwards.
+    stream._openForTransfer().then((RandomAccessFile opened) {
+      file = opened;
+      return opened.length();
+    }).then((int fileEnd) {
+      if (file == null) return;
+      // Like the stream, stop at the end of the file rather than waiting
+      // for data past it.
+      if (end != null && end < fileEnd) fileEnd = end;
+      if (fileEnd < start) {
+        throw new RangeError("Bad end position: $fileEnd");
+      }
+      filePosition = start;
+      this.fileEnd = fileEnd;
+      write();
+    }).catchError((e, stackTrace) {
+      _closeFile();
+      done(e, stackTrace);
+    });
+  }
+
+  void _closeFile() {
+    if (file == null) return;
+    var closing = file;
+    file = null;
+    fileEnd = null;
+    if (fileSend != null) {
+      // The file can't be closed while the send is using it.
+      fileSend.whenComplete(closing.close);
+    } else {
+      closing.close();
+    }
+  }
+
+  void _writeFile() {
+    if (fileEnd == null || fileSend != null) return;
+    if (filePosition >= fileEnd) {
+      _closeFile();
+      done();
+      return;
+    }
+    int length = fileEnd - filePosition;
+    fileSend = socket._sendFile(file, filePosition, length).then((int sent) {
+      fileSend = null;
+      // Stopped while the send was in progress.
+      if (file == null) return;
+      filePosition += sent;
+      if (sent < length) {
+        socket._enableWriteEvent();
+      } else {
+        _writeFile();
+      }
+    }, onError: (e, stackTrace) {
+      fileSend = null;
+      if (file == null) return;
+      socket.destroy();
+      _closeFile();
+      done(e, stackTrace);
+    });
+  }
+
   void write() {
+    if (file != null) {
+      _writeFile();
+      return;
+    }
     if (subscription == null) return;
-    assert(buffer != null);
+    assert(buffers.isNotEmpty);
     // Write as much as possible.
-    offset += socket._write(buffer, offset, buffer.length - offset);
-    if (offset < buffer.length) {
-      if (!paused) {
-        paused = true;
-        subscription.pause();
-      }
+    int written = socket._writeBuffers(buffers, offset);
+    while (buffers.isNotEmpty && offset + written >= buffers.first.length) {
+      var buffer = buffers.removeAt(0);
+      written -= buffer.length - offset;
+      pendingBytes -= buffer.length;
+      offset = 0;
+    }
+    offset += written;
+    if (buffers.isNotEmpty) {
+      _pauseIfFull();
       socket._enableWriteEvent();
-    } else {
-      buffer = null;
-      if (paused) {
-        paused = false;
-        subscription.resume();
-      }
+    } else if (streamDone) {
+      streamDone = false;
+      done();
+    } else if (paused) {
+      paused = false;
+      subscription.resume();
+    }
+  }
+
+  void _pauseIfFull() {
+    if (!paused && (pendingBytes - offset) >= _maxPendingBytes) {
+      paused = true;
+      subscription.pause();
     }
   }
 
   void done([error, stackTrace]) {
+    _closeFile();
     if (streamCompleter != null) {
       if (error != null) {
         streamCompleter.completeError(error, stackTrace);
@@ -1542,10 +1841,18 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (file != null) {
+      _closeFile();
+      socket._disableWriteEvent();
+    }
     if (subscription == null) return;
     subscription.cancel();
     subscription = null;
     paused = false;
+    streamDone = false;
+    buffers.clear();
+    offset = 0;
+    pendingBytes = 0;
     socket._disableWriteEvent();
   }
 }
@@ -1669,7 +1976,7 @@ class _Socket extends Stream<List<int>> implements Socket {
     _detachReady = new Completer();
     _sink.close();
     return _detachReady.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -1750,6 +2057,20 @@ class _Socket extends Stream<List<int>> implements Socket {
   int _write(List<int> data, int offset, int length) =>
       _raw.write(data, offset, length);
 
+  Future<int> _sendFile(RandomAccessFile file, int position, int length) {
+    _RawSocket raw = _raw;
+    return raw._socket.sendFile(file, position, length);
+  }
+
+  int _writeBuffers(List<List<int>> buffers, int offset) {
+    var raw = _raw;
+    if (buffers.length > 1 && raw is _RawSocket) {
+      return raw._socket.writeBuffers(buffers, offset);
+    }
+    var first = buffers.first;
+    return _write(first, offset, first.length - offset);
+  }
+
   void _enableWriteEvent() {
     _raw.writeEventsEnabled = true;
   }
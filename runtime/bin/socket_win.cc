@@ -23,8 +23,7 @@ Socket::Socket(intptr_t fd)
     : ReferenceCounted(),
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
-      port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {
+      port_(ILLEGAL_PORT) {
   ASSERT(fd_ != kClosedFd);
   Handle* handle = reinterpret_cast<Handle*>(fd_);
   ASSERT(handle != NULL);
@@ -201,7 +200,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   SOCKET s = socket(addr.ss.ss_family, SOCK_STREAM, IPPROTO_TCP);
   if (s == INVALID_SOCKET) {
     return -1;
@@ -240,7 +240,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
        65535)) {
     // Don't close fd until we have created new. By doing that we ensure another
     // port.
-    intptr_t new_s = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_s = CreateBindListen(addr, backlog, v6_only, reuse_port);
     DWORD rc = WSAGetLastError();
     closesocket(s);
     listen_socket->Release();
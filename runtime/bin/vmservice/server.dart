@@ -142,6 +142,7 @@ class HttpRequestClient extends Client {
 
 class Server {
   static const WEBSOCKET_PATH = '/ws';
+  static const METRICS_PATH = '/metrics';
   static const ROOT_REDIRECT_PATH = '/index.html';
 
   final VMService _service;
@@ -311,6 +312,18 @@ class Server {
       return;
     }
 
+    if (path == METRICS_PATH) {
+      // Serve the metrics in the Prometheus text format, for scrapers that
+      // do not speak the service protocol.
+      final response =
+          await new Message.forMethod('_getVMMetricsPrometheus').sendToVM();
+      request.response.headers.contentType =
+          ContentType.parse('text/plain; version=0.0.4');
+      request.response.write(response.decodeJson()['result']['text']);
+      request.response.close();
+      return;
+    }
+
     if (assets == null) {
       request.response.headers.contentType = ContentType.TEXT;
       request.response.write("This VM was built without the Observatory UI.");
@@ -735,11 +735,31 @@ typedef bool (*Dart_EntropySource)(uint8_t* buffer, intptr_t length);
  */
 typedef Dart_Handle (*Dart_GetVMServiceAssetsArchive)();
 
+/**
+ * A callback invoked before the old generation of an isolate's heap grows.
+ *
+ * This lets the embedder account for the heap of each isolate and bound it,
+ * for example to enforce a memory quota. Returning false refuses the growth:
+ * the VM then behaves as if the isolate had reached its maximum heap size,
+ * and collects garbage or throws an OutOfMemoryError.
+ *
+ * The callback may be invoked on any thread allocating in the isolate's heap,
+ * and must not call into the VM.
+ *
+ * \param callback_data The callback data which was passed to the isolate
+ *   when it was created.
+ * \param capacity_in_bytes The old generation capacity after the growth.
+ *
+ * \return True if the heap may grow.
+ */
+typedef bool (*Dart_HeapGrowthCallback)(void* callback_data,
+                                        intptr_t capacity_in_bytes);
+
 /**
  * The current version of the Dart_InitializeFlags. Should be incremented every
  * time Dart_InitializeFlags changes in a binary incompatible way.
  */
-#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x00000003)
+#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x00000004)
 
 /**
  * Describes how to initialize the VM. Used with Dart_Initialize.
@@ -761,6 +781,8 @@ typedef Dart_Handle (*Dart_GetVMServiceAssetsArchive)();
  * \param get_service_assets A function to be called by the service isolate when
  *    it requires the vmservice assets archive.
  *    See Dart_GetVMServiceAssetsArchive.
+ * \param heap_growth A function to be called before an isolate's heap grows,
+ *    or NULL. See Dart_HeapGrowthCallback.
  */
 typedef struct {
   int32_t version;
@@ -777,6 +799,7 @@ typedef struct {
   Dart_EntropySource entropy_source;
   Dart_GetVMServiceAssetsArchive get_service_assets;
   bool start_kernel_isolate;
+  Dart_HeapGrowthCallback heap_growth;
 } Dart_InitializeParams;
 
 /**
@@ -1284,6 +1307,26 @@ DART_EXPORT bool Dart_HasLivePorts();
  */
 DART_EXPORT bool Dart_Post(Dart_Port port_id, Dart_Handle object);
 
+/**
+ * Posts a message for some isolate like Dart_Post, but transfers the data of
+ * external typed data in the message instead of copying it.
+ *
+ * The data and finalizer of each external typed data object in the message
+ * that has exactly one finalizer, e.g. one created by
+ * Dart_NewExternalTypedDataWithFinalizer or received from Dart_PostCObject
+ * as Dart_CObject_kExternalTypedData, move to the receiving isolate. The
+ * sender's object keeps its length but refers to zero-filled data from then
+ * on. Other external typed data is copied as with Dart_Post.
+ *
+ * Requires there to be a current isolate.
+ *
+ * \param port The destination port.
+ * \param object An object from the current isolate.
+ *
+ * \return True if the message was posted.
+ */
+DART_EXPORT bool Dart_PostTransfer(Dart_Port port_id, Dart_Handle object);
+
 /**
  * Returns a new SendPort with the provided port id.
  *
@@ -1792,6 +1835,32 @@ Dart_NewExternalLatin1String(const uint8_t* latin1_array,
                              intptr_t external_allocation_size,
                              Dart_WeakPersistentHandleFinalizer callback);
 
+/**
+ * Returns a String for an external array of UTF-8 encoded characters. If the
+ * characters are all ASCII the String references the array, like
+ * Dart_NewExternalLatin1String does. Otherwise they are decoded into a String
+ * on the heap, and the array is no longer needed once this returns.
+ *
+ * Either way the callback is called when the String is finalized, so several
+ * Strings can share slices of one buffer whose peer counts references.
+ *
+ * \param utf8_array Array of UTF-8 encoded characters. This must not move.
+ * \param length The length of the characters array.
+ * \param peer An external pointer to associate with this string.
+ * \param external_allocation_size The number of externally allocated
+ *   bytes for peer. Used to inform the garbage collector.
+ * \param callback A callback to be called when this string is finalized.
+ *
+ * \return The String object if no error occurs. Otherwise returns
+ *   an error handle.
+ */
+DART_EXPORT Dart_Handle
+Dart_NewExternalUTF8String(const uint8_t* utf8_array,
+                           intptr_t length,
+                           void* peer,
+                           intptr_t external_allocation_size,
+                           Dart_WeakPersistentHandleFinalizer callback);
+
 /**
  * Returns a String which references an external array of UTF-16 encoded
  * characters.
@@ -2188,7 +2257,10 @@ DART_EXPORT Dart_Handle Dart_NewByteBuffer(Dart_Handle typed_data);
  * Notes:
  *   When the internal address of the object is acquired any calls to a
  *   Dart API function that could potentially allocate an object or run
- *   any Dart code will return an error.
+ *   any Dart code will return an error. This restriction does not apply to
+ *   external typed data, nor to typed data of 64KB or more that was
+ *   allocated with Dart_NewTypedData, whose data is never moved by the
+ *   garbage collector.
  *
  *   Any Dart API functions for accessing the data should not be called
  *   before the corresponding release. In particular, the object should
@@ -2324,6 +2396,97 @@ Dart_InvokeClosure(Dart_Handle closure,
                    int number_of_arguments,
                    Dart_Handle* arguments);
 
+/**
+ * Looks up a static function once, for repeated calls through
+ * Dart_InvokeStaticFunction.
+ *
+ * \param target A library, for a top-level function, or a type, for a static
+ *   method of its class.
+ * \param name The name of the function.
+ *
+ * \return A handle to the function, which may be made persistent to use it
+ *   across scopes, or an error handle if there is no such static function.
+ */
+DART_EXPORT Dart_Handle Dart_LookupStaticFunction(Dart_Handle target,
+                                                  Dart_Handle name);
+
+/**
+ * An unboxed argument or result of Dart_InvokeStaticFunction.
+ */
+typedef struct {
+  bool is_double;
+  union {
+    int64_t as_int64;
+    double as_double;
+  } value;
+} Dart_UnboxedValue;
+
+/**
+ * Invokes a static function found by Dart_LookupStaticFunction with integer
+ * and double arguments.
+ *
+ * Unlike Dart_Invoke, this does not look up the function by name, and needs
+ * no handles for the arguments or result, so it suits native code calling the
+ * same function many times, e.g. once per audio buffer while it stays in the
+ * isolate.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param function A handle to a static function with exactly
+ *   number_of_arguments positional parameters.
+ * \param arguments The arguments, which must be valid for the parameters.
+ * \param result If not NULL, receives the result, which has to be an integer
+ *   or a double.
+ *
+ * \return A valid handle if no error occurs during execution, otherwise an
+ *   error handle.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_InvokeStaticFunction(Dart_Handle function,
+                          int number_of_arguments,
+                          const Dart_UnboxedValue* arguments,
+                          Dart_UnboxedValue* result);
+
+/**
+ * Looks up an instance method once, for repeated calls through
+ * Dart_InvokeMethod.
+ *
+ * \param type A type whose class declares or inherits the method.
+ * \param name The name of the method.
+ *
+ * \return A handle to the method, which may be made persistent to use it
+ *   across scopes, or an error handle if there is no such instance method.
+ */
+DART_EXPORT Dart_Handle Dart_LookupMethod(Dart_Handle type, Dart_Handle name);
+
+/**
+ * Invokes an instance method found by Dart_LookupMethod on a receiver, with
+ * integer and double arguments, like Dart_InvokeStaticFunction does for
+ * static functions.
+ *
+ * The receiver must dispatch to this very method: an instance of the class
+ * declaring it, which takes no lookup, or of a subclass that does not
+ * override it.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param receiver The object to invoke the method on.
+ * \param function A handle to an instance method with exactly
+ *   number_of_arguments positional parameters.
+ * \param arguments The arguments, which must be valid for the parameters.
+ * \param result If not NULL, receives the result, which has to be an integer
+ *   or a double.
+ *
+ * \return A valid handle if no error occurs during execution, otherwise an
+ *   error handle.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_InvokeMethod(Dart_Handle receiver,
+                  Dart_Handle function,
+                  int number_of_arguments,
+                  const Dart_UnboxedValue* arguments,
+                  Dart_UnboxedValue* result);
+
 /**
  * Invokes a Generative Constructor on an object that was previously
  * allocated using Dart_Allocate/Dart_AllocateWithNativeFields.
@@ -3167,17 +3330,53 @@ DART_EXPORT Dart_Port Dart_ServiceWaitForLoadPort();
 DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
 Dart_SaveCompilationTrace(uint8_t** buffer, intptr_t* buffer_length);
 
+/**
+ * Record the functions first compiled in the current isolate during the time
+ * given by --startup-trace-duration=<milliseconds>, in the order in which
+ * they were first called. The trace has the format of a compilation trace
+ * and can be passed to the snapshot writer with --load-startup-trace=<file>
+ * to place the code and read-only data used during startup at the start of
+ * the snapshot images.
+ *
+ * \param buffer Returns a pointer to a buffer containing the trace.
+ *   This buffer is scope allocated and is only valid  until the next call to
+ *   Dart_ExitScope.
+ * \param size Returns the size of the buffer.
+ * \return Returns an valid handle upon success.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_SaveStartupTrace(uint8_t** buffer, intptr_t* buffer_length);
+
 /**
  * Compile all functions from data from Dart_SaveCompilationTrace. Unlike JIT
  * feedback, this data is fuzzy: loading does not need to happen in the exact
  * program that was saved, the saver and loader do not need to agree on checked
- * mode versus production mode or debug/release/product.
+ * mode versus production mode or debug/release/product. Functions whose source
+ * changed since the trace was saved are skipped and compiled on demand, and
+ * functions that were optimized when the trace was saved are optimized again
+ * soon after they start running.
  *
  * \return Returns an error handle if a compilation error was encountered.
  */
 DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
 Dart_LoadCompilationTrace(uint8_t* buffer, intptr_t buffer_length);
 
+/**
+ * Record the type feedback collected in the current isolate: the receiver
+ * classes seen at instance calls, call counts and edge counters. The data
+ * can be passed to the precompiler with --load-type-feedback=<file> to
+ * guide inlining, call specialization and block layout. Like the
+ * compilation trace, it refers to functions and classes by name.
+ *
+ * \param buffer Returns a pointer to a buffer containing the feedback.
+ *   This buffer is scope allocated and is only valid  until the next call to
+ *   Dart_ExitScope.
+ * \param buffer_length Returns the size of the buffer.
+ * \return Returns an valid handle upon success.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_SaveTypeFeedback(uint8_t** buffer, intptr_t* buffer_length);
+
 /*
  * ==============
  * Precompilation
@@ -101,6 +101,45 @@ typedef struct _Dart_CObject {
  */
 DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
 
+/**
+ * Posts count messages on some port, like calling Dart_PostCObject for each
+ * of them, but enqueues them together so that high rate producers pay the
+ * cost of posting once per batch.
+ *
+ * The messages are posted in order. If a message cannot be serialized, it
+ * and the messages after it are not posted, but the messages before it are.
+ *
+ * \param port_id The destination port.
+ * \param count The number of messages.
+ * \param messages The messages to send.
+ *
+ * \return The number of messages posted, counted from the first one. This is
+ *   count if all messages were posted, the index of the first message that
+ *   could not be serialized otherwise, and 0 if the port is closed.
+ */
+DART_EXPORT intptr_t Dart_PostCObjectBatch(Dart_Port port_id,
+                                           intptr_t count,
+                                           Dart_CObject** messages);
+
+/**
+ * Posts an array message on some port, like calling Dart_PostCObject with a
+ * Dart_CObject_kArray object, but takes the elements from one contiguous
+ * buffer. High rate producers can fill the same buffer for every message
+ * instead of building a Dart_CObject tree each time.
+ *
+ * The elements cannot be arrays. As with Dart_PostCObject, they are only
+ * read, and the buffer can be reused as soon as this returns.
+ *
+ * \param port_id The destination port.
+ * \param length The number of elements.
+ * \param elements The elements of the array.
+ *
+ * \return True if the message was posted.
+ */
+DART_EXPORT bool Dart_PostCObjectArray(Dart_Port port_id,
+                                       intptr_t length,
+                                       Dart_CObject* elements);
+
 /**
  * Posts a message on some port. The message will contain the integer 'message'.
  *
@@ -485,5 +485,50 @@ DART_EXPORT int64_t
 Dart_IsolateRunnableLatencyMetric(Dart_Isolate isolate);  // Microsecond
 DART_EXPORT int64_t
 Dart_IsolateRunnableHeapSizeMetric(Dart_Isolate isolate);  // Byte
+/**
+ * The histogram metrics below return the sum of the recorded values.
+ */
+DART_EXPORT int64_t
+Dart_IsolateGCScavengePauseMetric(Dart_Isolate isolate);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateGCScavengeSurvivedMetric(Dart_Isolate isolate);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGCMarkSweepPauseMetric(Dart_Isolate isolate);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateCompileUnoptimizedTimeMetric(Dart_Isolate isolate);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateCompileOptimizedTimeMetric(Dart_Isolate isolate);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateDeoptimizationCountMetric(Dart_Isolate isolate);  // Counter
+
+/**
+ * Cumulative resource usage of an isolate since it was created.
+ */
+typedef struct {
+  /** CPU time of the threads that ran the isolate's mutator. */
+  int64_t cpu_time_micros;
+  /** Bytes allocated in new space. */
+  int64_t new_allocated_bytes;
+  /** Bytes allocated directly in old space, promotions excluded. */
+  int64_t old_allocated_bytes;
+  /** Time spent in garbage collections. */
+  int64_t gc_time_micros;
+  /** Number of garbage collections. */
+  int64_t gc_count;
+} Dart_IsolateStats;
+
+/**
+ * Reads the resource usage counters of an isolate. The counters are cheap to
+ * read and updated as the isolate runs: CPU time whenever the isolate's
+ * mutator thread exits the isolate, e.g. after handling a batch of messages,
+ * and allocations when the heap is collected.
+ *
+ * Unlike the metrics above, these counters are available in PRODUCT builds.
+ *
+ * \param isolate The isolate, which must not be shut down concurrently.
+ * \param stats Receives the counters.
+ */
+DART_EXPORT void Dart_IsolateGetStats(Dart_Isolate isolate,
+                                      Dart_IsolateStats* stats);
 
 #endif  // RUNTIME_INCLUDE_DART_TOOLS_API_H_
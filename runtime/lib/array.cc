@@ -42,9 +42,10 @@ DEFINE_NATIVE_ENTRY(List_setIndexed, 3) {
   return Object::null();
 }
 
-DEFINE_NATIVE_ENTRY(List_getLength, 1) {
-  const Array& array = Array::CheckedHandle(arguments->NativeArgAt(0));
-  return Smi::New(array.Length());
+DEFINE_LEAF_NATIVE_ENTRY(List_getLength, 1) {
+  RawObject* array = arguments->NativeArgAt(0);
+  ASSERT(array->IsArray() || array->IsImmutableArray());
+  return Smi::New(Array::LengthOf(static_cast<RawArray*>(array)));
 }
 
 // ObjectArray src, int start, int count, bool needTypeArgument.
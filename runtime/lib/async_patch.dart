@@ -88,18 +88,32 @@ Function _asyncErrorWrapperHelper(continuation) {
 
 /// Registers the [thenCallback] and [errorCallback] on the given [object].
 ///
-/// If [object] is not a future, then it is wrapped into one.
+/// If [object] is not a future, or is one of our futures that already has a
+/// value, [thenCallback] is scheduled directly.
 ///
-/// Returns the result of registering with `.then`.
+/// Returns the result of registering with `.then`, or null if [thenCallback]
+/// was scheduled directly. The result is not used by the async transformation.
 Future _awaitHelper(
     var object, Function thenCallback, Function errorCallback, var awaiter) {
   if (object is! Future) {
-    object = new _Future().._setValue(object);
+    _scheduleAwaitContinuation(thenCallback, object);
+    return null;
   } else if (object is! _Future) {
     return object.then(thenCallback, onError: errorCallback);
   }
   // `object` is a `_Future`.
   //
+  // A future in the current zone that already has a value would only
+  // schedule the continuation, so do that directly. The awaiter is still
+  // recorded, as below.
+  if (object._isComplete &&
+      !object._hasError &&
+      identical(object._zone, Zone.current)) {
+    object._awaiter = awaiter;
+    _scheduleAwaitContinuation(thenCallback, object._resultOrListeners);
+    return null;
+  }
+
   // Since the callbacks have been registered in the current zone (see
   // [_asyncThenWrapperHelper] and [_asyncErrorWrapperHelper]), we can avoid
   // another registration and directly invoke the no-zone-registration `.then`.
@@ -110,6 +124,19 @@ Future _awaitHelper(
   return object._thenNoZoneRegistration(thenCallback, errorCallback);
 }
 
+/// Resumes an `await` of an available [value] in a later microtask, as an
+/// already completed future would, without allocating the future, its result
+/// future and the listener connecting them.
+///
+/// Like the listener would, runs the continuation in the zone of the `await`,
+/// in which [thenCallback] is already registered.
+void _scheduleAwaitContinuation(Function thenCallback, var value) {
+  Zone zone = Zone.current;
+  zone.scheduleMicrotask(() {
+    zone.runUnary(thenCallback, value);
+  });
+}
+
 // Called as part of the 'await for (...)' construct. Registers the
 // awaiter on the stream.
 void _asyncStarListenHelper(var object, var awaiter) {
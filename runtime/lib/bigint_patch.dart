@@ -79,6 +79,9 @@ class _BigIntImpl implements BigInt {
   static const int _digitBase = 1 << _digitBits;
   static const int _digitMask = (1 << _digitBits) - 1;
 
+  // Minimum number of digits in both factors for Karatsuba multiplication.
+  static const int _karatsubaThreshold = 64;
+
   // Bits per half digit.
   static const int _halfDigitBits = _digitBits >> 1;
   static const int _halfDigitMask = (1 << _halfDigitBits) - 1;
@@ -1195,6 +1198,10 @@ class _BigIntImpl implements BigInt {
     var resultUsed = used + otherUsed;
     var digits = _digits;
     var otherDigits = other._digits;
+    if (used >= _karatsubaThreshold && otherUsed >= _karatsubaThreshold) {
+      return new _BigIntImpl._(_isNegative != other._isNegative, resultUsed,
+          _mulDigitsKaratsuba(digits, used, otherDigits, otherUsed));
+    }
     var resultDigits = _newDigits(resultUsed);
     var i = 0;
     while (i < otherUsed) {
@@ -1222,6 +1229,115 @@ class _BigIntImpl implements BigInt {
     return resultUsed;
   }
 
+  // Returns the digits of xDigits[0..xUsed-1]*yDigits[0..yUsed-1] in a new
+  // list of xUsed + yUsed digits.
+  //
+  // Factors of at least [_karatsubaThreshold] digits are split at an even
+  // digit index m into x1*B^m + x0 and y1*B^m + y0, and the product is
+  // assembled from the three half-size products x0*y0, x1*y1 and
+  // (x0 + x1)*(y0 + y1). The low halves are passed as prefixes of the
+  // original lists; since m is even and the halves are normalized, the digit
+  // following an odd-length low half is zero as required by _mulAdd.
+  static Uint32List _mulDigitsKaratsuba(
+      Uint32List xDigits, int xUsed, Uint32List yDigits, int yUsed) {
+    if (xUsed < yUsed) {
+      return _mulDigitsKaratsuba(yDigits, yUsed, xDigits, xUsed);
+    }
+    var resultDigits = _newDigits(xUsed + yUsed);
+    if (yUsed == 0) return resultDigits;
+    if (yUsed < _karatsubaThreshold) {
+      _mulDigits(xDigits, xUsed, yDigits, yUsed, resultDigits);
+      return resultDigits;
+    }
+    var m = (xUsed + 1) >> 1;
+    m += m & 1;
+    var x0Used = _normalize(m, xDigits);
+    var x1Used = xUsed - m;
+    var x1Digits = _cloneDigits(xDigits, m, xUsed, x1Used);
+    if (yUsed <= m) {
+      // Only the larger factor is split.
+      var p0 = _mulDigitsKaratsuba(xDigits, x0Used, yDigits, yUsed);
+      var p1 = _mulDigitsKaratsuba(x1Digits, x1Used, yDigits, yUsed);
+      _addDigitsAt(p0, x0Used + yUsed, resultDigits, 0);
+      _addDigitsAt(p1, x1Used + yUsed, resultDigits, m);
+      return resultDigits;
+    }
+    var y0Used = _normalize(m, yDigits);
+    var y1Used = yUsed - m;
+    var y1Digits = _cloneDigits(yDigits, m, yUsed, y1Used);
+    var z0Used = x0Used + y0Used;
+    var z0 = _mulDigitsKaratsuba(xDigits, x0Used, yDigits, y0Used);
+    var z2Used = x1Used + y1Used;
+    var z2 = _mulDigitsKaratsuba(x1Digits, x1Used, y1Digits, y1Used);
+    var sxUsed = _max(x0Used, x1Used) + 1;
+    var sx = _sumDigits(xDigits, x0Used, x1Digits, x1Used);
+    sxUsed = _normalize(sxUsed, sx);
+    var syUsed = _max(y0Used, y1Used) + 1;
+    var sy = _sumDigits(yDigits, y0Used, y1Digits, y1Used);
+    syUsed = _normalize(syUsed, sy);
+    var z1Used = sxUsed + syUsed;
+    var z1 = _mulDigitsKaratsuba(sx, sxUsed, sy, syUsed);
+    _subDigitsFrom(z1, z1Used, z0, z0Used);
+    _subDigitsFrom(z1, z1Used, z2, z2Used);
+    _addDigitsAt(z0, z0Used, resultDigits, 0);
+    _addDigitsAt(z1, _normalize(z1Used, z1), resultDigits, m);
+    _addDigitsAt(z2, z2Used, resultDigits, 2 * m);
+    return resultDigits;
+  }
+
+  // Returns the digits of xDigits[0..xUsed-1] + yDigits[0..yUsed-1] in a new
+  // list of max(xUsed, yUsed) + 1 digits.
+  static Uint32List _sumDigits(
+      Uint32List xDigits, int xUsed, Uint32List yDigits, int yUsed) {
+    var n = _max(xUsed, yUsed);
+    var resultDigits = _newDigits(n + 1);
+    var carry = 0;
+    for (var i = 0; i < n; i++) {
+      if (i < xUsed) carry += xDigits[i];
+      if (i < yUsed) carry += yDigits[i];
+      resultDigits[i] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+    resultDigits[n] = carry;
+    return resultDigits;
+  }
+
+  // resultDigits[offset..] += digits[0..used-1].
+  // The sum must fit in resultDigits.
+  static void _addDigitsAt(
+      Uint32List digits, int used, Uint32List resultDigits, int offset) {
+    var carry = 0;
+    var i = offset;
+    for (var j = 0; j < used; j++, i++) {
+      carry += resultDigits[i] + digits[j];
+      resultDigits[i] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+    while (carry != 0) {
+      carry += resultDigits[i];
+      resultDigits[i++] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+  }
+
+  // digits[0..used-1] -= otherDigits[0..otherUsed-1].
+  // The difference must not be negative.
+  static void _subDigitsFrom(
+      Uint32List digits, int used, Uint32List otherDigits, int otherUsed) {
+    var carry = 0;
+    var i = 0;
+    for (; i < otherUsed; i++) {
+      carry += digits[i] - otherDigits[i];
+      digits[i] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+    while (carry != 0 && i < used) {
+      carry += digits[i];
+      digits[i++] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+  }
+
   // resultDigits[0..resultUsed-1] = xDigits[0..xUsed-1]^2.
   // Returns resultUsed = 2*xUsed.
   static int _sqrDigits(
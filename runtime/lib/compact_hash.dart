@@ -80,6 +80,15 @@ abstract class _HashBase implements _HashVMBase {
   static const int _INITIAL_INDEX_BITS = 3;
   static const int _INITIAL_INDEX_SIZE = 1 << (_INITIAL_INDEX_BITS + 1);
 
+  // Maps that have never had a key inserted share an index with a single
+  // unused entry and an empty _data, so that lookups need no special case and
+  // the first insertion allocates the real backing stores via _rehash.
+  static const int _UNINITIALIZED_INDEX_SIZE = 1;
+  static final Uint32List _uninitializedIndex =
+      new Uint32List(_UNINITIALIZED_INDEX_SIZE);
+  static const int _UNINITIALIZED_HASH_MASK = 0;
+  static final List _uninitializedData = new List(0);
+
   // Unused and deleted entries are marked by 0 and 1, respectively.
   static const int _UNUSED_PAIR = 0;
   static const int _DELETED_PAIR = 1;
@@ -145,9 +154,9 @@ class _InternalLinkedHashMap<K, V> extends _HashVMBase
         _OperatorEqualsAndHashCode
     implements LinkedHashMap<K, V> {
   _InternalLinkedHashMap() {
-    _index = new Uint32List(_HashBase._INITIAL_INDEX_SIZE);
-    _hashMask = _HashBase._indexSizeToHashMask(_HashBase._INITIAL_INDEX_SIZE);
-    _data = new List(_HashBase._INITIAL_INDEX_SIZE);
+    _index = _HashBase._uninitializedIndex;
+    _hashMask = _HashBase._UNINITIALIZED_HASH_MASK;
+    _data = _HashBase._uninitializedData;
     _usedData = 0;
     _deletedKeys = 0;
   }
@@ -164,7 +173,10 @@ abstract class _LinkedHashMapMixin<K, V> implements _HashBase {
   bool get isNotEmpty => !isEmpty;
 
   void _rehash() {
-    if ((_deletedKeys << 2) > _usedData) {
+    if (identical(_data, _HashBase._uninitializedData)) {
+      const int size = _HashBase._INITIAL_INDEX_SIZE;
+      _init(size, _HashBase._indexSizeToHashMask(size), null, 0);
+    } else if ((_deletedKeys << 2) > _usedData) {
       // TODO(koda): Consider shrinking.
       // TODO(koda): Consider in-place compaction and more costly CME check.
       _init(_index.length, _hashMask, _data, _usedData);
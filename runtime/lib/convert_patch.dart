@@ -405,6 +405,11 @@ abstract class _ChunkedJsonParser<T> {
   // Mask used to mask off two lower bits.
   static const int TWO_BIT_MASK = 3;
 
+  // Number of entries of the property name cache, a power of two.
+  static const int KEY_CACHE_SIZE = 64;
+  // Longer property names are not cached.
+  static const int MAX_CACHED_KEY_LENGTH = 32;
+
   final _JsonListener listener;
 
   // The current parsing state.
@@ -457,6 +462,12 @@ abstract class _ChunkedJsonParser<T> {
    */
   var buffer = null;
 
+  /**
+   * Property names seen so far, indexed by a hash of their characters.
+   * Allocated on the first property name. See [getKey].
+   */
+  List<String> keyCache;
+
   _ChunkedJsonParser(this.listener);
 
   /**
@@ -840,8 +851,10 @@ abstract class _ChunkedJsonParser<T> {
           break;
         case QUOTE:
           if ((state & ALLOW_STRING_MASK) != 0) return fail(position);
+          // Only property names are allowed where values are not.
+          bool isKey = (state & ALLOW_VALUE_MASK) != 0;
           state |= VALUE_READ_BITS;
-          position = parseString(position + 1);
+          position = parseString(position + 1, isKey);
           break;
         case LBRACKET:
           if ((state & ALLOW_VALUE_MASK) != 0) return fail(position);
@@ -1003,8 +1016,11 @@ abstract class _ChunkedJsonParser<T> {
    *
    * Initial [position] is right after the initial quote.
    * Returned position right after the final quote.
+   *
+   * If [isKey] is true, the string is a property name, and it may be
+   * shared with earlier property names with the same characters.
    */
-  int parseString(int position) {
+  int parseString(int position, bool isKey) {
     // Format: '"'([^\x00-\x1f\\\"]|'\\'[bfnrt/\\"])*'"'
     // Initial position is right after first '"'.
     int start = position;
@@ -1024,7 +1040,9 @@ abstract class _ChunkedJsonParser<T> {
         return parseStringToBuffer(sliceEnd);
       }
       if (char == QUOTE) {
-        listener.handleString(getString(start, position - 1, bits));
+        listener.handleString(isKey
+            ? getKey(start, position - 1, bits)
+            : getString(start, position - 1, bits));
         return position;
       }
       if (char < SPACE) {
@@ -1036,6 +1054,43 @@ abstract class _ChunkedJsonParser<T> {
     return chunkString(STR_PLAIN);
   }
 
+  /**
+   * Returns the property name between [start] and [end], reusing the string
+   * of an earlier property name with the same characters when possible.
+   *
+   * Objects in a list usually have the same property names. Sharing the
+   * strings saves allocating them, and computing their hash codes again
+   * for every map they are added to.
+   *
+   * Only ASCII names are cached, so the characters of the source and the
+   * cached string can be compared directly for both parsers.
+   */
+  String getKey(int start, int end, int bits) {
+    const int maxAsciiChar = 0x7f;
+    int length = end - start;
+    if (bits > maxAsciiChar || length == 0 || length > MAX_CACHED_KEY_LENGTH) {
+      return getString(start, end, bits);
+    }
+    int index = (length * 31 +
+            getChar(start) * 7 +
+            getChar(start + (length >> 1)) * 3 +
+            getChar(end - 1)) &
+        (KEY_CACHE_SIZE - 1);
+    List<String> cache = keyCache;
+    if (cache == null) {
+      cache = keyCache = new List<String>(KEY_CACHE_SIZE);
+    }
+    String key = cache[index];
+    if (key != null && key.length == length) {
+      int i = 0;
+      while (i < length && key.codeUnitAt(i) == getChar(start + i)) i++;
+      if (i == length) return key;
+    }
+    key = getString(start, end, bits);
+    cache[index] = key;
+    return key;
+  }
+
   /**
    * Sets up a partial string state.
    *
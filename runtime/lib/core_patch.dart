@@ -130,8 +130,21 @@ class _SyncIterator<T> implements Iterator<T> {
   T _current;
   Iterable<T> _yieldEachIterable;
 
-  T get current =>
-      _yieldEachIterator != null ? _yieldEachIterator.current : _current;
+  // Iterators of the sync* generators that are running in the yield* of
+  // this generator, innermost last. Their bodies are driven directly from
+  // this iterator, so that an element yielded at nesting depth d costs O(1)
+  // rather than O(d) moveNext calls.
+  List<_SyncIterator> _nested;
+
+  _SyncIterator get _innermost =>
+      (_nested == null || _nested.isEmpty) ? this : _nested.last;
+
+  T get current {
+    _SyncIterator iterator = _innermost;
+    return iterator._yieldEachIterator != null
+        ? iterator._yieldEachIterator.current
+        : iterator._current;
+  }
 
   _SyncIterator(this._moveNextFn);
 
@@ -140,25 +153,37 @@ class _SyncIterator<T> implements Iterator<T> {
       return false;
     }
     while (true) {
-      if (_yieldEachIterator != null) {
-        if (_yieldEachIterator.moveNext()) {
+      _SyncIterator iterator = _innermost;
+      if (iterator._yieldEachIterator != null) {
+        if (iterator._yieldEachIterator.moveNext()) {
           return true;
         }
-        _yieldEachIterator = null;
+        iterator._yieldEachIterator = null;
       }
       // _moveNextFn() will update the values of _yieldEachIterable
       //  and _current.
-      if (!_moveNextFn(this)) {
-        _moveNextFn = null;
-        _current = null;
-        return false;
+      if (!iterator._moveNextFn(iterator)) {
+        iterator._moveNextFn = null;
+        iterator._current = null;
+        if (identical(iterator, this)) {
+          return false;
+        }
+        // Resume the enclosing generator after its yield*.
+        _nested.removeLast();
+        continue;
       }
-      if (_yieldEachIterable != null) {
+      Iterable iterable = iterator._yieldEachIterable;
+      if (iterable != null) {
+        iterator._yieldEachIterable = null;
+        iterator._current = null;
         // Spec mandates: it is a dynamic error if the class of [the object
         // returned by yield*] does not implement Iterable.
-        _yieldEachIterator = _yieldEachIterable.iterator;
-        _yieldEachIterable = null;
-        _current = null;
+        if (iterable is _SyncIterable) {
+          _SyncIterator nested = iterable.iterator;
+          (_nested ??= <_SyncIterator>[]).add(nested);
+        } else {
+          iterator._yieldEachIterator = iterable.iterator;
+        }
         continue;
       }
       return true;
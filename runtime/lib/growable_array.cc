@@ -50,16 +50,18 @@ DEFINE_NATIVE_ENTRY(GrowableList_setIndexed, 3) {
   return Object::null();
 }
 
-DEFINE_NATIVE_ENTRY(GrowableList_getLength, 1) {
-  const GrowableObjectArray& array =
-      GrowableObjectArray::CheckedHandle(arguments->NativeArgAt(0));
-  return Smi::New(array.Length());
+DEFINE_LEAF_NATIVE_ENTRY(GrowableList_getLength, 1) {
+  RawObject* array = arguments->NativeArgAt(0);
+  ASSERT(array->IsGrowableObjectArray());
+  return Smi::New(GrowableObjectArray::LengthOf(
+      static_cast<RawGrowableObjectArray*>(array)));
 }
 
-DEFINE_NATIVE_ENTRY(GrowableList_getCapacity, 1) {
-  const GrowableObjectArray& array =
-      GrowableObjectArray::CheckedHandle(arguments->NativeArgAt(0));
-  return Smi::New(array.Capacity());
+DEFINE_LEAF_NATIVE_ENTRY(GrowableList_getCapacity, 1) {
+  RawObject* array = arguments->NativeArgAt(0);
+  ASSERT(array->IsGrowableObjectArray());
+  return Smi::New(GrowableObjectArray::CapacityOf(
+      static_cast<RawGrowableObjectArray*>(array)));
 }
 
 DEFINE_NATIVE_ENTRY(GrowableList_setLength, 2) {
@@ -80,6 +82,15 @@ DEFINE_NATIVE_ENTRY(GrowableList_setData, 2) {
   return Object::null();
 }
 
+DEFINE_NATIVE_ENTRY(GrowableList_grow, 2) {
+  const GrowableObjectArray& array =
+      GrowableObjectArray::CheckedHandle(arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, capacity, arguments->NativeArgAt(1));
+  ASSERT(capacity.Value() > array.Capacity());
+  array.Grow(capacity.Value());
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(Internal_makeListFixedLength, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(GrowableObjectArray, array,
                                arguments->NativeArgAt(0));
@@ -244,6 +244,11 @@ class _GrowableList<T> extends ListBase<T> {
   int _nextCapacity(int old_capacity) => (old_capacity * 2) | 3;
 
   void _grow(int new_capacity) {
+    if (length > _bulkGrowThreshold) {
+      // Copy in bulk in the runtime. Round up the same way as _allocateData.
+      _growInternal(new_capacity | 1);
+      return;
+    }
     var newData = _allocateData(new_capacity);
     // This is a work-around for dartbug.com/30090: array-bound-check
     // generalization causes excessive deoptimizations because it
@@ -259,6 +264,12 @@ class _GrowableList<T> extends ListBase<T> {
     _setData(newData);
   }
 
+  // Above this length, copying the elements in the runtime outweighs the cost
+  // of the native call.
+  static const int _bulkGrowThreshold = 64;
+
+  void _growInternal(int new_capacity) native "GrowableList_grow";
+
   void _shrink(int new_capacity, int new_length) {
     var newData = _allocateData(new_capacity);
     // This is a work-around for dartbug.com/30090. See the comment in _grow.
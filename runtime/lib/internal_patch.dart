@@ -39,6 +39,11 @@ class VMLibraryHooks {
   // Example: "dart:io _EventHandler._timerMillisecondClock"
   static var timerMillisecondClock;
 
+  // Number of milliseconds by which a timer may fire late, which allows the
+  // timer implementation to keep an already scheduled wakeup instead of
+  // sending the event handler a new one.
+  static int timerWakeupSlack = 0;
+
   // Implementation of Resource.readAsBytes.
   static var resourceReadAsBytes;
 
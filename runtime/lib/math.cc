@@ -161,11 +161,15 @@ DEFINE_NATIVE_ENTRY(Random_initialSeed, 0) {
   return CreateRandomState(zone, seed);
 }
 
-DEFINE_NATIVE_ENTRY(SecureRandom_getBytes, 1) {
-  GET_NON_NULL_NATIVE_ARGUMENT(Smi, count, arguments->NativeArgAt(0));
-  const intptr_t n = count.Value();
-  ASSERT((n > 0) && (n <= 8));
-  uint8_t buffer[8];
+// Fills the given Uint8List with entropy.
+DEFINE_NATIVE_ENTRY(SecureRandom_fillBytes, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedData, bytes, arguments->NativeArgAt(0));
+  ASSERT(bytes.ElementType() == kUint8ArrayElement);
+  const intptr_t kMaxBytes = 256;
+  const intptr_t n = bytes.LengthInBytes();
+  ASSERT((n > 0) && (n <= kMaxBytes));
+  // The entropy source may block, so it does not write into the heap.
+  uint8_t buffer[kMaxBytes];
   Dart_EntropySource entropy_source = Dart::entropy_source_callback();
   if ((entropy_source == NULL) || !entropy_source(buffer, n)) {
     const String& error = String::Handle(String::New(
@@ -174,11 +178,9 @@ DEFINE_NATIVE_ENTRY(SecureRandom_getBytes, 1) {
     args.SetAt(0, error);
     Exceptions::ThrowByType(Exceptions::kUnsupported, args);
   }
-  uint64_t result = 0;
-  for (intptr_t i = 0; i < n; i++) {
-    result = (result << 8) | buffer[i];
-  }
-  return Integer::New(result);
+  NoSafepointScope no_safepoint;
+  memmove(bytes.DataAddr(0), buffer, n);
+  return Object::null();
 }
 
 }  // namespace dart
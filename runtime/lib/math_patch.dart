@@ -9,7 +9,7 @@
 
 import "dart:_internal" show patch;
 
-import "dart:typed_data" show Uint32List;
+import "dart:typed_data" show Uint32List, Uint8List;
 
 /// There are no parts of this patch library.
 
@@ -267,8 +267,28 @@ class _SecureRandom implements Random {
     _getBytes(1);
   }
 
+  // Entropy is fetched from the embedder in buckets of this many bytes, so
+  // that most calls are served without a native call. Consumed bytes are
+  // cleared from the buffer.
+  static const _kBufferSize = 256;
+  static final Uint8List _buffer = new Uint8List(_kBufferSize);
+  static int _position = _kBufferSize;
+
+  static void _fillBytes(Uint8List bytes) native "SecureRandom_fillBytes";
+
   // Return count bytes of entropy as a positive integer; count <= 8.
-  static int _getBytes(int count) native "SecureRandom_getBytes";
+  static int _getBytes(int count) {
+    if (_position + count > _kBufferSize) {
+      _fillBytes(_buffer);
+      _position = 0;
+    }
+    var result = 0;
+    for (var i = 0; i < count; i++) {
+      result = (result << 8) | _buffer[_position];
+      _buffer[_position++] = 0;
+    }
+    return result;
+  }
 
   int nextInt(int max) {
     RangeError.checkValueInInterval(
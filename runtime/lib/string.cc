@@ -245,6 +245,15 @@ DEFINE_NATIVE_ENTRY(StringBase_joinReplaceAllResult, 4) {
   return result.raw();
 }
 
+DEFINE_NATIVE_ENTRY(StringBase_indexOfString, 3) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(2));
+  // The start index is checked in Dart code.
+  return Smi::New(String::IndexOf(receiver, pattern, start_obj.Value()));
+}
+
 DEFINE_NATIVE_ENTRY(OneByteString_substringUnchecked, 3) {
   const String& receiver =
       String::CheckedHandle(zone, arguments->NativeArgAt(0));
@@ -269,16 +278,16 @@ DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 2) {
       zone, GrowableObjectArray::New(16, Heap::kNew));
   String& str = String::Handle(zone);
   intptr_t start = 0;
-  intptr_t i = 0;
-  for (; i < len; i++) {
-    if (split_code == OneByteString::CharAt(receiver, i)) {
+  if (Utils::IsUint(8, split_code)) {
+    intptr_t i;
+    while ((i = OneByteString::IndexOf(receiver, split_code, start)) != -1) {
       str = OneByteString::SubStringUnchecked(receiver, start, (i - start),
                                               Heap::kNew);
       result.Add(str);
       start = i + 1;
     }
   }
-  str = OneByteString::SubStringUnchecked(receiver, start, (i - start),
+  str = OneByteString::SubStringUnchecked(receiver, start, (len - start),
                                           Heap::kNew);
   result.Add(str);
   result.SetTypeArguments(TypeArguments::Handle(
@@ -472,19 +481,19 @@ DEFINE_NATIVE_ENTRY(TwoByteString_allocateFromTwoByteList, 3) {
   return Object::null();
 }
 
-DEFINE_NATIVE_ENTRY(String_getHashCode, 1) {
-  const String& receiver =
-      String::CheckedHandle(zone, arguments->NativeArgAt(0));
-  intptr_t hash_val = receiver.Hash();
+DEFINE_LEAF_NATIVE_ENTRY(String_getHashCode, 1) {
+  RawObject* receiver = arguments->NativeArgAt(0);
+  ASSERT(receiver->IsStringInstance());
+  intptr_t hash_val = String::HashOf(static_cast<RawString*>(receiver));
   ASSERT(hash_val > 0);
   ASSERT(Smi::IsValid(hash_val));
   return Smi::New(hash_val);
 }
 
-DEFINE_NATIVE_ENTRY(String_getLength, 1) {
-  const String& receiver =
-      String::CheckedHandle(zone, arguments->NativeArgAt(0));
-  return Smi::New(receiver.Length());
+DEFINE_LEAF_NATIVE_ENTRY(String_getLength, 1) {
+  RawObject* receiver = arguments->NativeArgAt(0);
+  ASSERT(receiver->IsStringInstance());
+  return Smi::New(String::LengthOf(static_cast<RawString*>(receiver)));
 }
 
 static uint16_t StringValueAt(const String& str, const Integer& index) {
@@ -593,4 +602,50 @@ DEFINE_NATIVE_ENTRY(StringBuffer_createStringFromUint16Array, 3) {
   return result.raw();
 }
 
+// Concatenates the parts of a StringBuffer and the code units in its buffer
+// into a single string, without first making a string of the buffer.
+DEFINE_NATIVE_ENTRY(StringBuffer_concatPartsAndBuffer, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(GrowableObjectArray, parts,
+                               arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedData, codeUnits, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, length, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, isLatin1, arguments->NativeArgAt(3));
+  intptr_t array_length = codeUnits.Length();
+  intptr_t length_value = length.Value();
+  if (length_value < 0 || length_value > array_length) {
+    Exceptions::ThrowRangeError("length", length, 0, array_length);
+  }
+  const intptr_t num_parts = parts.Length();
+  String& str = String::Handle(zone);
+  intptr_t result_len = length_value;
+  intptr_t char_size =
+      isLatin1.value() ? String::kOneByteChar : String::kTwoByteChar;
+  for (intptr_t i = 0; i < num_parts; i++) {
+    str ^= parts.At(i);
+    const intptr_t str_len = str.Length();
+    if ((String::kMaxElements - result_len) < str_len) {
+      Exceptions::ThrowOOM();
+      UNREACHABLE();
+    }
+    result_len += str_len;
+    char_size = Utils::Maximum(char_size, str.CharSize());
+  }
+  const String& result =
+      (char_size == String::kOneByteChar)
+          ? String::Handle(zone, OneByteString::New(result_len, Heap::kNew))
+          : String::Handle(zone, TwoByteString::New(result_len, Heap::kNew));
+  intptr_t pos = 0;
+  for (intptr_t i = 0; i < num_parts; i++) {
+    str ^= parts.At(i);
+    const intptr_t str_len = str.Length();
+    String::Copy(result, pos, str, 0, str_len);
+    pos += str_len;
+  }
+  ASSERT(pos + length_value == result_len);
+  NoSafepointScope no_safepoint;
+  uint16_t* data_position = reinterpret_cast<uint16_t*>(codeUnits.DataAddr(0));
+  String::Copy(result, pos, data_position, length_value);
+  return result.raw();
+}
+
 }  // namespace dart
@@ -121,6 +121,11 @@ class StringBuffer {
   /** Returns the contents of buffer as a string. */
   @patch
   String toString() {
+    if (_bufferPosition != 0 && _partsCodeUnits != 0) {
+      // Copy the parts and the buffer into the result in one go.
+      return _concatPartsAndBuffer(_parts, _buffer, _bufferPosition,
+          _bufferCodeUnitMagnitude <= 0xFF);
+    }
     _consumeBuffer();
     return (_partsCodeUnits == 0)
         ? ""
@@ -193,4 +198,12 @@ class StringBuffer {
    */
   static String _create(Uint16List buffer, int length, bool isLatin1)
       native "StringBuffer_createStringFromUint16Array";
+
+  /**
+   * Create a [String] of the [parts] followed by the first [length] code
+   * units of [buffer].
+   */
+  static String _concatPartsAndBuffer(
+      List<String> parts, Uint16List buffer, int length, bool isLatin1)
+      native "StringBuffer_concatPartsAndBuffer";
 }
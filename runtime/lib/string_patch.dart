@@ -290,6 +290,13 @@ abstract class _StringBase implements String {
     return 0;
   }
 
+  // Searches at fewer positions are done in Dart, which is faster than
+  // calling into the runtime for short strings.
+  static const int _minNativeSearchLength = 32;
+
+  int _indexOfString(String pattern, int start)
+      native "StringBase_indexOfString";
+
   @pragma("vm:exact-result-type", bool)
   bool _substringMatches(int start, String other) {
     if (other.isEmpty) return true;
@@ -326,7 +333,9 @@ abstract class _StringBase implements String {
     if (pattern is String) {
       String other = pattern;
       int maxIndex = this.length - other.length;
-      // TODO: Use an efficient string search (e.g. BMH).
+      if (maxIndex - start >= _minNativeSearchLength) {
+        return _indexOfString(other, start);
+      }
       for (int index = start; index <= maxIndex; index++) {
         if (_substringMatches(index, other)) {
           return index;
@@ -1004,6 +1013,9 @@ class _OneByteString extends _StringBase {
         if (patternCu0 > 0xFF) {
           return -1;
         }
+        if (len - start > _StringBase._minNativeSearchLength) {
+          return _indexOfString(patternAsString, start);
+        }
         for (int i = start; i < len; i++) {
           if (this.codeUnitAt(i) == patternCu0) {
             return i;
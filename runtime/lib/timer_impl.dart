@@ -11,10 +11,16 @@
 // To ensure the timers are ordered by insertion time, the _Timer class has a
 // `_id` field set when added to the heap.
 //
+// Cancelling a timer other than the first one does not remove it: it stays in
+// the heap until it reaches the top, or until cancelled timers make up half of
+// the heap and the heap is rebuilt without them. This makes `cancel` O(1) for
+// the common case of timeouts that are cancelled long before they expire.
+//
 // [0] http://en.wikipedia.org/wiki/Binary_heap
 class _TimerHeap {
   List<_Timer> _list;
   int _used = 0;
+  int _cancelled = 0; // Number of cancelled timers still in the heap.
 
   _TimerHeap([int initSize = 7]) : _list = new List<_Timer>(initSize);
 
@@ -39,7 +45,25 @@ class _TimerHeap {
     return f;
   }
 
+  // Records that [timer], which is not the first timer, was cancelled.
+  void markCancelled(_Timer timer) {
+    assert(timer._callback == null && !isFirst(timer));
+    if (++_cancelled * 2 > _used) {
+      _compact();
+    }
+  }
+
+  // Removes the cancelled timers from the top of the heap.
+  void removeCancelledFirst() {
+    while (!isEmpty && first._callback == null) {
+      remove(first);
+    }
+  }
+
   void remove(_Timer timer) {
+    if (timer._callback == null) {
+      _cancelled--;
+    }
     _used--;
     if (isEmpty) {
       _list[0] = null;
@@ -60,6 +84,27 @@ class _TimerHeap {
     timer._indexOrNext = null;
   }
 
+  void _compact() {
+    int used = 0;
+    for (int i = 0; i < _used; i++) {
+      var timer = _list[i];
+      if (timer._callback == null) {
+        timer._indexOrNext = null;
+      } else {
+        timer._indexOrNext = used;
+        _list[used++] = timer;
+      }
+    }
+    for (int i = used; i < _used; i++) {
+      _list[i] = null;
+    }
+    _used = used;
+    _cancelled = 0;
+    for (int i = _parentIndex(used - 1); i >= 0; i--) {
+      _bubbleDown(_list[i]);
+    }
+  }
+
   void _resize() {
     var newList = new List<_Timer>(_list.length * 2 + 1);
     newList.setRange(0, _used, _list);
@@ -201,18 +246,25 @@ class _Timer implements Timer {
 
   int get tick => _tick;
 
-  // Cancels a set timer. The timer is removed from the timer heap if it is a
-  // non-zero timer. Zero timers are kept in the list as they need to consume
-  // the corresponding pending message.
+  // Cancels a set timer. The timer is removed from the timer heap if it is
+  // the first non-zero timer, and left for the heap to drop lazily otherwise.
+  // Zero timers are kept in the list as they need to consume the
+  // corresponding pending message.
   void cancel() {
-    _callback = null;
+    if (_callback == null) return;
     // Only heap timers are really removed. Zero timers need to consume their
     // corresponding wakeup message so they are left in the queue.
-    if (!_isInHeap) return;
-    bool update = _heap.isFirst(this);
-    _heap.remove(this);
-    if (update) {
+    if (!_isInHeap) {
+      _callback = null;
+      return;
+    }
+    if (_heap.isFirst(this)) {
+      _heap.remove(this);
+      _callback = null;
       _notifyEventHandler();
+    } else {
+      _callback = null;
+      _heap.markCancelled(this);
     }
   }
 
@@ -285,6 +337,8 @@ class _Timer implements Timer {
       return;
     }
 
+    _heap.removeCancelledFirst();
+
     // If there are no pending timers. Close down the receive port.
     if ((_firstZeroTimer == null) && _heap.isEmpty) {
       // No pending timers: Close the receive port and let the event handler
@@ -300,11 +354,14 @@ class _Timer implements Timer {
       return;
     }
 
-    // Only send a message if the requested wakeup time differs from the
-    // already scheduled wakeup time.
+    // Only send a message if the requested wakeup time is earlier than the
+    // already scheduled wakeup time by more than the allowed slack. A wakeup
+    // that comes too early, because the first timer was cancelled, finds no
+    // expired timers and schedules the next wakeup then.
     var wakeupTime = _heap.first._wakeupTime;
     if ((_scheduledWakeupTime == null) ||
-        (wakeupTime != _scheduledWakeupTime)) {
+        (wakeupTime <
+            _scheduledWakeupTime - VMLibraryHooks.timerWakeupSlack)) {
       _scheduleWakeup(wakeupTime);
     }
   }
@@ -397,7 +454,9 @@ class _Timer implements Timer {
       // Re-queue timers we didn't get to.
       for (i++; i < pendingTimers.length; i++) {
         var timer = pendingTimers[i];
-        timer._enqueue();
+        if (timer._callback != null) {
+          timer._enqueue();
+        }
       }
       _notifyEventHandler();
     }
@@ -33,6 +33,22 @@ import 'dart:math' show Random;
 
 /// There are no parts in patch library:
 
+// Ranges at least twice this long are filled by storing this many elements
+// and then copying the filled part after itself in bulk.
+const int _bulkFillPrefixLength = 128;
+
+// Fills [filled, end) of [list] with copies of [start, filled). Between typed
+// lists with the same buffer and element size, setRange does each copy as a
+// memmove, so this takes a logarithmic number of copies.
+void _fillRangeFromPrefix(List list, int start, int filled, int end) {
+  while (filled < end) {
+    int chunk = filled - start;
+    if (chunk > end - filled) chunk = end - filled;
+    list.setRange(filled, filled + chunk, list, start);
+    filled += chunk;
+  }
+}
+
 @patch
 class ByteData implements TypedData {
   @patch
@@ -456,6 +472,14 @@ abstract class _IntListMixin implements List<int> {
 
   void fillRange(int start, int end, [int fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
+    if (end - start >= 2 * _bulkFillPrefixLength) {
+      final prefixEnd = start + _bulkFillPrefixLength;
+      for (var i = start; i < prefixEnd; ++i) {
+        this[i] = fillValue;
+      }
+      _fillRangeFromPrefix(this, start, prefixEnd, end);
+      return;
+    }
     for (var i = start; i < end; ++i) {
       this[i] = fillValue;
     }
@@ -812,6 +836,14 @@ abstract class _DoubleListMixin implements List<double> {
 
   void fillRange(int start, int end, [double fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
+    if (end - start >= 2 * _bulkFillPrefixLength) {
+      final prefixEnd = start + _bulkFillPrefixLength;
+      for (var i = start; i < prefixEnd; ++i) {
+        this[i] = fillValue;
+      }
+      _fillRangeFromPrefix(this, start, prefixEnd, end);
+      return;
+    }
     for (var i = start; i < end; ++i) {
       this[i] = fillValue;
     }
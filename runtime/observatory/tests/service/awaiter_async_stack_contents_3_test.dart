@@ -0,0 +1,65 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--verbose_debug --async_debugger
+//
+// The awaiter stack is kept when awaits resume without a listener: on values
+// that are not futures, and on futures that already have a value.
+
+import 'dart:async';
+import 'dart:developer';
+import 'package:observatory/models.dart' as M;
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+import 'service_test_common.dart';
+import 'test_helper.dart';
+
+const LINE_A = 28;
+const LINE_B = 35;
+const LINE_C = 39;
+
+foobar(Future done) async {
+  await null;
+  await 42;
+  await done;
+  await done;
+  if (await done != 7) throw 'Wrong value';
+  debugger();
+  print('foobar'); // LINE_A.
+}
+
+helper() async {
+  var done = new Future.value(7);
+  await done;
+  print('helper');
+  await foobar(done); // LINE_B.
+}
+
+testMain() {
+  helper(); // LINE_C.
+}
+
+var tests = <IsolateTest>[
+  hasStoppedAtBreakpoint,
+  stoppedAtLine(LINE_A),
+  (Isolate isolate) async {
+    ServiceMap stack = await isolate.getStack();
+    expect(stack['awaiterFrames'], isNotNull);
+    List awaiterFrames = stack['awaiterFrames'];
+    expect(awaiterFrames.length, greaterThanOrEqualTo(4));
+    // Awaiter frame.
+    expect(await awaiterFrames[0].toUserString(),
+        stringContainsInOrder(['foobar', '.dart:$LINE_A']));
+    // Awaiter frame.
+    expect(await awaiterFrames[1].toUserString(),
+        stringContainsInOrder(['helper', '.dart:$LINE_B']));
+    // Suspension point.
+    expect(awaiterFrames[2].kind, equals(M.FrameKind.asyncSuspensionMarker));
+    // Causal frame.
+    expect(await awaiterFrames[3].toUserString(),
+        stringContainsInOrder(['testMain', '.dart:$LINE_C']));
+  },
+];
+
+main(args) =>
+    runIsolateTestsSynchronous(args, tests, testeeConcurrent: testMain);
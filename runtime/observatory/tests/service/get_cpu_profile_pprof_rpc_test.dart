@@ -0,0 +1,41 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:convert';
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+fib(n) {
+  if (n < 0) return 0;
+  if (n == 0) return 1;
+  return fib(n - 1) + fib(n - 2);
+}
+
+testeeDo() {
+  print("Testee doing something.");
+  fib(25);
+  print("Testee did something.");
+}
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    var params = {'tags': 'None'};
+    var result =
+        await isolate.invokeRpcNoUpgrade('_getCpuProfilePprof', params);
+    expect(result['type'], equals('_CpuProfilePprof'));
+    expect(result['sampleCount'], new isInstanceOf<int>());
+
+    List<int> pprof = base64.decode(result['pprof']);
+    // The message starts with the empty string that has to come first in the
+    // string table (field 6, length delimited).
+    expect(pprof.length, greaterThan(2));
+    expect(pprof[0], equals((6 << 3) | 2));
+    expect(pprof[1], equals(0));
+  },
+];
+
+main(args) async => runIsolateTests(args, tests, testeeBefore: testeeDo);
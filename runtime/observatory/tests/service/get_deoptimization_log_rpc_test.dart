@@ -0,0 +1,43 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+add(a, b) => a + b;
+
+testeeDo() {
+  // Optimize add for smis, then deoptimize it with doubles.
+  var sum = 0;
+  for (var i = 0; i < 100; i++) {
+    sum = add(sum, i);
+  }
+  print(add(sum, 0.5));
+}
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    var result = await isolate.invokeRpcNoUpgrade('_getDeoptimizationLog', {});
+    expect(result['type'], equals('_DeoptimizationLog'));
+    expect(result['capacity'], greaterThan(0));
+    List deoptimizations = result['deoptimizations'];
+    var adds = deoptimizations.where((e) => e['function'].endsWith('add'));
+    expect(adds, isNotEmpty);
+    var event = adds.first;
+    expect(event['reason'], new isInstanceOf<String>());
+    expect(event['deoptId'], new isInstanceOf<int>());
+    expect(event['lazy'], isFalse);
+    expect(event['disabledOptimization'], isFalse);
+    expect(event['timestamp'], new isInstanceOf<int>());
+  },
+];
+
+main(args) async => runIsolateTests(args, tests,
+    testeeBefore: testeeDo,
+    extraArgs: [
+      '--optimization-counter-threshold=10',
+      '--no-background-compilation'
+    ]);
@@ -0,0 +1,67 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// A heap snapshot larger than one chunk is sent in chunks while the heap is
+// walked. Only the last chunk carries the chunk and node counts, and the
+// snapshot is complete once it has arrived.
+
+import 'package:observatory/heap_snapshot.dart';
+import 'package:observatory/models.dart' as M;
+import 'package:observatory/object_graph.dart';
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+import 'test_helper.dart';
+
+const int fooCount = 200000;
+
+class Foo {
+  dynamic next;
+}
+
+List<Foo> foos;
+
+void script() {
+  foos = new List<Foo>(fooCount);
+  for (int i = 0; i < fooCount; i++) {
+    foos[i] = new Foo();
+    if (i > 0) foos[i].next = foos[i - 1];
+  }
+}
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    Library lib = await isolate.rootLibrary.load();
+    Class fooClass = lib.classes.singleWhere((cls) => cls.name == 'Foo');
+
+    List events =
+        await isolate.fetchHeapSnapshot(M.HeapSnapshotRoots.user, false)
+            .toList();
+    RawHeapSnapshot raw = events.last;
+    List progress = events.sublist(0, events.length - 1);
+
+    int chunkCount = raw.chunks.length;
+    expect(chunkCount, greaterThan(1));
+    expect(raw.chunks.every((chunk) => chunk != null), isTrue);
+    expect(raw.count, greaterThan(fooCount));
+
+    // One progress event per chunk. Until the last chunk the total is not
+    // known, so progress is reported against one more chunk.
+    expect(progress.length, equals(chunkCount));
+    for (int i = 0; i < chunkCount - 1; i++) {
+      expect(progress[i], equals([i, i + 2]));
+    }
+    expect(progress.last, equals([chunkCount - 1, chunkCount]));
+
+    HeapSnapshot snapshot = new HeapSnapshot();
+    await snapshot.loadProgress(isolate, raw).last;
+    ObjectGraph graph = snapshot.graph;
+    expect(graph.vertexCount, equals(raw.count));
+    expect(
+        graph.vertices.where((ObjectVertex obj) => obj.vmCid == fooClass.vmCid)
+            .length,
+        equals(fooCount));
+  },
+];
+
+main(args) => runIsolateTests(args, tests, testeeBefore: script);
@@ -122,7 +122,7 @@ void TextBuffer::EscapeAndAddUTF16CodeUnit(uint16_t codeunit) {
 }
 
 void TextBuffer::AddString(const char* s) {
-  Printf("%s", s);
+  AddRaw(reinterpret_cast<const uint8_t*>(s), strlen(s));
 }
 
 void TextBuffer::AddEscapedString(const char* s) {
@@ -141,6 +141,11 @@ void TextBuffer::EnsureCapacity(intptr_t len) {
     // to send user-controlled data (e.g. values of string variables) to
     // the debugger front-end.
     intptr_t new_size = buf_size_ + len + kBufferSpareCapacity;
+    // Grow geometrically, so that appending n bytes in small pieces takes
+    // O(n) time rather than O(n^2) in reallocations.
+    if (new_size < 2 * buf_size_) {
+      new_size = 2 * buf_size_;
+    }
     char* new_buf = reinterpret_cast<char*>(realloc(buf_, new_size));
     if (new_buf == NULL) {
       OUT_OF_MEMORY();
@@ -4,9 +4,18 @@
 
 #include "vm/benchmark_test.h"
 
+#if defined(HOST_OS_LINUX)
+#include <dirent.h>            // NOLINT
+#include <linux/perf_event.h>  // NOLINT
+#include <sys/ioctl.h>         // NOLINT
+#include <sys/syscall.h>       // NOLINT
+#include <unistd.h>            // NOLINT
+#endif
+
 #include "bin/builtin.h"
 #include "bin/file.h"
 #include "bin/isolate_data.h"
+#include "bin/log.h"
 #include "bin/process.h"
 #include "bin/reference_counting.h"
 
@@ -14,7 +23,10 @@
 #include "platform/globals.h"
 
 #include "vm/clustered_snapshot.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/jit/compiler.h"
 #include "vm/dart_api_impl.h"
+#include "vm/json_stream.h"
 #include "vm/stack_frame.h"
 #include "vm/timer.h"
 
@@ -22,10 +34,199 @@ using dart::bin::File;
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            benchmark_perf_counters,
+            false,
+            "Report the cycles, instructions, cache misses and branch misses "
+            "of each benchmark, where the OS provides them.");
+
 Benchmark* Benchmark::first_ = NULL;
 Benchmark* Benchmark::tail_ = NULL;
 const char* Benchmark::executable_ = NULL;
 
+BenchmarkPerfCounters::BenchmarkPerfCounters() {
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    fds_[i] = -1;
+    values_[i] = -1;
+  }
+}
+
+BenchmarkPerfCounters::~BenchmarkPerfCounters() {
+#if defined(HOST_OS_LINUX)
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    if (fds_[i] != -1) {
+      close(fds_[i]);
+    }
+  }
+  for (intptr_t i = 0; i < syscall_fds_.length(); i++) {
+    close(syscall_fds_[i]);
+  }
+#endif
+}
+
+const char* BenchmarkPerfCounters::Name(Counter counter) {
+  switch (counter) {
+    case kCycles:
+      return "Cycles";
+    case kInstructions:
+      return "Instructions";
+    case kCacheMisses:
+      return "CacheMisses";
+    case kBranchMisses:
+      return "BranchMisses";
+    case kSyscalls:
+      return "Syscalls";
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+#if defined(HOST_OS_LINUX)
+// Returns the perf event id of the tracepoint entered by every system call,
+// or -1 if tracefs is not readable.
+static int64_t SyscallTracepointId() {
+  static const char* kPaths[] = {
+      "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+      "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+  };
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kPaths)); i++) {
+    FILE* file = fopen(kPaths[i], "r");
+    if (file == NULL) {
+      continue;
+    }
+    int64_t id = -1;
+    if (fscanf(file, "%" Pd64, &id) != 1) {
+      id = -1;
+    }
+    fclose(file);
+    if (id != -1) {
+      return id;
+    }
+  }
+  return -1;
+}
+
+static uint64_t HardwareEventConfig(BenchmarkPerfCounters::Counter counter) {
+  switch (counter) {
+    case BenchmarkPerfCounters::kCycles:
+      return PERF_COUNT_HW_CPU_CYCLES;
+    case BenchmarkPerfCounters::kInstructions:
+      return PERF_COUNT_HW_INSTRUCTIONS;
+    case BenchmarkPerfCounters::kCacheMisses:
+      return PERF_COUNT_HW_CACHE_MISSES;
+    case BenchmarkPerfCounters::kBranchMisses:
+      return PERF_COUNT_HW_BRANCH_MISSES;
+    default:
+      UNREACHABLE();
+      return 0;
+  }
+}
+
+static void EnableCounter(int fd) {
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static bool ReadCounter(int fd, int64_t* value) {
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  uint64_t count = 0;
+  if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+    return false;
+  }
+  *value = static_cast<int64_t>(count);
+  return true;
+}
+#endif
+
+bool BenchmarkPerfCounters::Start() {
+#if defined(HOST_OS_LINUX)
+  bool opened = false;
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    if (i == kSyscalls) {
+      continue;
+    }
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = HardwareEventConfig(static_cast<Counter>(i));
+    attr.disabled = 1;
+    // Also count the helper threads, e.g. background compilers, that the
+    // benchmark starts.
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fds_[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fds_[i] != -1) {
+      opened = true;
+    }
+  }
+
+  // An inherited counter only follows the threads started after it is
+  // opened, by the thread it is opened for. The event handler and the IO
+  // thread pool may already be running, so open a system call counter for
+  // every thread of the process.
+  const int64_t id = SyscallTracepointId();
+  DIR* tasks = (id == -1) ? NULL : opendir("/proc/self/task");
+  if (tasks != NULL) {
+    struct dirent* entry;
+    while ((entry = readdir(tasks)) != NULL) {
+      const pid_t tid = static_cast<pid_t>(strtol(entry->d_name, NULL, 10));
+      if (tid <= 0) {
+        continue;
+      }
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_TRACEPOINT;
+      attr.size = sizeof(attr);
+      attr.config = id;
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_hv = 1;
+      const int fd = syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+      if (fd != -1) {
+        syscall_fds_.Add(fd);
+        opened = true;
+      }
+    }
+    closedir(tasks);
+  }
+
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    if (fds_[i] != -1) {
+      EnableCounter(fds_[i]);
+    }
+  }
+  for (intptr_t i = 0; i < syscall_fds_.length(); i++) {
+    EnableCounter(syscall_fds_[i]);
+  }
+  return opened;
+#else
+  return false;
+#endif
+}
+
+void BenchmarkPerfCounters::Stop() {
+#if defined(HOST_OS_LINUX)
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    if (fds_[i] != -1) {
+      ReadCounter(fds_[i], &values_[i]);
+    }
+  }
+  if (syscall_fds_.length() > 0) {
+    int64_t total = 0;
+    for (intptr_t i = 0; i < syscall_fds_.length(); i++) {
+      int64_t count = 0;
+      if (ReadCounter(syscall_fds_[i], &count)) {
+        total += count;
+      }
+    }
+    values_[kSyscalls] = total;
+  }
+#endif
+}
+
 //
 // Measure compile of all dart2js(compiler) functions.
 //
@@ -112,6 +313,111 @@ BENCHMARK(CorelibCompileAll) {
   benchmark->set_score(elapsed_time);
 }
 
+#if !defined(PRODUCT)
+//
+// Compile a fixed corpus of functions through the unoptimized and the
+// optimizing tier, then time the optimized code. The per-pass compile time,
+// IL instruction counts, code size and spill slots are printed as JSON so
+// they can be tracked next to the score, which is the execution time.
+//
+BENCHMARK(CompilerCorpus) {
+  const char* kScriptChars =
+      "import 'dart:typed_data';\n"
+      "int fib(int n) => (n < 2) ? n : fib(n - 1) + fib(n - 2);\n"
+      "double sumList(List<double> list) {\n"
+      "  double sum = 0.0;\n"
+      "  for (int i = 0; i < list.length; i++) sum += list[i];\n"
+      "  return sum;\n"
+      "}\n"
+      "int matMul(Int32List a, Int32List b, Int32List c, int n) {\n"
+      "  for (int i = 0; i < n; i++) {\n"
+      "    for (int j = 0; j < n; j++) {\n"
+      "      int sum = 0;\n"
+      "      for (int k = 0; k < n; k++) sum += a[i * n + k] * b[k * n + j];\n"
+      "      c[i * n + j] = sum;\n"
+      "    }\n"
+      "  }\n"
+      "  return c[n * n - 1];\n"
+      "}\n"
+      "String concat(List<String> parts) {\n"
+      "  var buffer = new StringBuffer();\n"
+      "  for (var part in parts) buffer.write(part);\n"
+      "  return buffer.toString();\n"
+      "}\n"
+      "final doubles = new List<double>.generate(1000, (i) => i * 0.5);\n"
+      "final a = new Int32List(32 * 32);\n"
+      "final b = new Int32List(32 * 32);\n"
+      "final c = new Int32List(32 * 32);\n"
+      "final parts = new List<String>.generate(100, (i) => '$i');\n"
+      "int runFib() => fib(20);\n"
+      "double runSumList() => sumList(doubles);\n"
+      "int runMatMul() => matMul(a, b, c, 32);\n"
+      "int runConcat() => concat(parts).length;\n"
+      "void run() {\n"
+      "  for (int i = 0; i < 100; i++) {\n"
+      "    runFib();\n"
+      "    runSumList();\n"
+      "    runMatMul();\n"
+      "    runConcat();\n"
+      "  }\n"
+      "}\n";
+  static const char* kCorpus[] = {"fib", "sumList", "matMul", "concat"};
+  static const char* kRunners[] = {"runFib", "runSumList", "runMatMul",
+                                   "runConcat"};
+
+  SetFlagScope<bool> sfs(&FLAG_compiler_pass_stats, true);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Isolate* isolate = thread->isolate();
+  {
+    MutexLocker ml(isolate->mutex());
+    isolate->compiler_pass_stats()->Clear();
+  }
+
+  // Running each function once compiles it with the unoptimized tier.
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kRunners)); i++) {
+    EXPECT_VALID(Dart_Invoke(lib, NewString(kRunners[i]), 0, NULL));
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    const Library& library =
+        Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+    Function& function = Function::Handle();
+    Object& result = Object::Handle();
+    for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kCorpus));
+         i++) {
+      function = library.LookupLocalFunction(
+          String::Handle(String::New(kCorpus[i])));
+      EXPECT(!function.IsNull());
+      result = Compiler::CompileOptimizedFunction(thread, function);
+      EXPECT(!result.IsError());
+    }
+  }
+
+  Timer timer(true, "Compiler corpus execution");
+  timer.Start();
+  EXPECT_VALID(Dart_Invoke(lib, NewString("run"), 0, NULL));
+  timer.Stop();
+  const int64_t elapsed_time = timer.TotalElapsedTime();
+
+  {
+    TransitionNativeToVM transition(thread);
+    JSONStream js;
+    {
+      JSONObject jsobj(&js);
+      jsobj.AddProperty("type", "CompilerCorpus");
+      jsobj.AddProperty64("executionMicros", elapsed_time);
+      MutexLocker ml(isolate->mutex());
+      isolate->compiler_pass_stats()->PrintToJSONObject(&jsobj);
+    }
+    bin::Log::Print("%s\n", js.ToCString());
+  }
+  benchmark->set_score(elapsed_time);
+}
+#endif  // !defined(PRODUCT)
+
 // This file is created by the target //runtime/bin:gen_kernel_bytecode_dill
 // which is depended on by run_vm_tests.
 static char* ComputeGenKernelKernelPath(const char* arg) {
@@ -420,7 +726,7 @@ BENCHMARK(Dart2JSCompileAll) {
 }
 
 //
-// Measure frame lookup during stack traversal.
+// Measure frame lookup and token position lookup during stack traversal.
 //
 static void StackFrame_accessFrame(Dart_NativeArguments args) {
   const int kNumIterations = 100;
@@ -439,6 +745,7 @@ static void StackFrame_accessFrame(Dart_NativeArguments args) {
       } else if (frame->IsDartFrame()) {
         code = frame->LookupDartCode();
         EXPECT(code.function() != Function::null());
+        frame->GetTokenPos();
       }
       frame = frames.NextFrame();
     }
@@ -692,6 +999,184 @@ BENCHMARK(SimpleMessage) {
   benchmark->set_score(elapsed_time);
 }
 
+// Messaging benchmarks. Messages are posted with the native API to native
+// ports, whose handlers run on the VM thread pool. run_vm_tests has no
+// isolate creation callback, so the receivers are native ports rather than
+// isolates, but the messages go through the same port map, message queues
+// and serialization.
+
+static Monitor* message_monitor = NULL;
+static intptr_t messages_remaining = 0;  // Guarded by message_monitor.
+static Dart_Port ping_port = ILLEGAL_PORT;
+static Dart_Port pong_port = ILLEGAL_PORT;
+
+// Returns true if more messages are expected.
+static bool CountMessage() {
+  MonitorLocker ml(message_monitor);
+  if (--messages_remaining == 0) {
+    ml.Notify();
+  }
+  return messages_remaining > 0;
+}
+
+static void WaitForMessages() {
+  MonitorLocker ml(message_monitor);
+  while (messages_remaining > 0) {
+    ml.Wait();
+  }
+}
+
+static void MessageSinkHandler(Dart_Port dest_port_id, Dart_CObject* message) {
+  CountMessage();
+}
+
+static void PingPongHandler(Dart_Port dest_port_id, Dart_CObject* message) {
+  if (CountMessage()) {
+    Dart_PostInteger((dest_port_id == ping_port) ? pong_port : ping_port, 0);
+  }
+}
+
+BENCHMARK(MessagePingPong) {
+  const intptr_t kRoundTrips = 10000;
+  message_monitor = new Monitor();
+  messages_remaining = 2 * kRoundTrips;
+  ping_port = Dart_NewNativePort("Ping", PingPongHandler, false);
+  pong_port = Dart_NewNativePort("Pong", PingPongHandler, false);
+  Timer timer(true, "Message ping-pong");
+  timer.Start();
+  Dart_PostInteger(ping_port, 0);
+  WaitForMessages();
+  timer.Stop();
+  Dart_CloseNativePort(ping_port);
+  Dart_CloseNativePort(pong_port);
+  delete message_monitor;
+  message_monitor = NULL;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+struct MessageSenderData {
+  Dart_Port port;
+  Dart_CObject* message;
+  intptr_t count;
+};
+
+static void MessageSender(uword parameter) {
+  // Copy the data, the benchmark may return as soon as the last message
+  // has been received.
+  const MessageSenderData data =
+      *reinterpret_cast<MessageSenderData*>(parameter);
+  for (intptr_t i = 0; i < data.count; i++) {
+    Dart_PostCObject(data.port, data.message);
+  }
+}
+
+// Posts count messages from each of num_threads native threads to one
+// native port, and scores the time until all of them have been received.
+static void MessageFanInBenchmark(Benchmark* benchmark,
+                                  intptr_t num_threads,
+                                  Dart_CObject* message,
+                                  intptr_t count) {
+  message_monitor = new Monitor();
+  messages_remaining = num_threads * count;
+  MessageSenderData data;
+  data.port = Dart_NewNativePort("MessageSink", MessageSinkHandler, false);
+  data.message = message;
+  data.count = count;
+  Timer timer(true, "Message fan-in");
+  timer.Start();
+  for (intptr_t i = 0; i < num_threads; i++) {
+    int result = OSThread::Start("MessageSender", MessageSender,
+                                 reinterpret_cast<uword>(&data));
+    EXPECT_EQ(0, result);
+  }
+  WaitForMessages();
+  timer.Stop();
+  Dart_CloseNativePort(data.port);
+  delete message_monitor;
+  message_monitor = NULL;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+static Dart_CObject* IntegerMessage() {
+  static Dart_CObject message;
+  message.type = Dart_CObject_kInt32;
+  message.value.as_int32 = 42;
+  return &message;
+}
+
+static Dart_CObject* LargeTypedDataMessage() {
+  static uint8_t data[1 * MB];
+  static Dart_CObject message;
+  message.type = Dart_CObject_kTypedData;
+  message.value.as_typed_data.type = Dart_TypedData_kUint8;
+  message.value.as_typed_data.length = ARRAY_SIZE(data);
+  message.value.as_typed_data.values = data;
+  return &message;
+}
+
+// A list of records, each holding an int, a string, a double and a nested
+// list.
+static Dart_CObject* ObjectGraphMessage() {
+  const intptr_t kRecords = 100;
+  const intptr_t kFields = 4;
+  static Dart_CObject leaves[2];
+  static Dart_CObject* leaf_pointers[2];
+  static Dart_CObject fields[kRecords][kFields];
+  static Dart_CObject* field_pointers[kRecords][kFields];
+  static Dart_CObject records[kRecords];
+  static Dart_CObject* record_pointers[kRecords];
+  static Dart_CObject message;
+  leaves[0].type = Dart_CObject_kBool;
+  leaves[0].value.as_bool = true;
+  leaves[1].type = Dart_CObject_kNull;
+  for (intptr_t i = 0; i < 2; i++) {
+    leaf_pointers[i] = &leaves[i];
+  }
+  for (intptr_t i = 0; i < kRecords; i++) {
+    fields[i][0].type = Dart_CObject_kInt32;
+    fields[i][0].value.as_int32 = i;
+    fields[i][1].type = Dart_CObject_kString;
+    fields[i][1].value.as_string = const_cast<char*>("record");
+    fields[i][2].type = Dart_CObject_kDouble;
+    fields[i][2].value.as_double = i * 0.5;
+    fields[i][3].type = Dart_CObject_kArray;
+    fields[i][3].value.as_array.length = 2;
+    fields[i][3].value.as_array.values = leaf_pointers;
+    for (intptr_t j = 0; j < kFields; j++) {
+      field_pointers[i][j] = &fields[i][j];
+    }
+    records[i].type = Dart_CObject_kArray;
+    records[i].value.as_array.length = kFields;
+    records[i].value.as_array.values = field_pointers[i];
+    record_pointers[i] = &records[i];
+  }
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.length = kRecords;
+  message.value.as_array.values = record_pointers;
+  return &message;
+}
+
+// Registers the benchmark for 1, 2, 4 and 8 sending threads.
+#define MESSAGE_FAN_IN_BENCHMARK(name, message, count)                         \
+  BENCHMARK(Message##name##1Thread) {                                          \
+    MessageFanInBenchmark(benchmark, 1, message(), count);                     \
+  }                                                                            \
+  BENCHMARK(Message##name##2Threads) {                                         \
+    MessageFanInBenchmark(benchmark, 2, message(), count);                     \
+  }                                                                            \
+  BENCHMARK(Message##name##4Threads) {                                         \
+    MessageFanInBenchmark(benchmark, 4, message(), count);                     \
+  }                                                                            \
+  BENCHMARK(Message##name##8Threads) {                                         \
+    MessageFanInBenchmark(benchmark, 8, message(), count);                     \
+  }
+
+MESSAGE_FAN_IN_BENCHMARK(FanIn, IntegerMessage, 100000)
+MESSAGE_FAN_IN_BENCHMARK(LargeTypedData, LargeTypedDataMessage, 16)
+MESSAGE_FAN_IN_BENCHMARK(ObjectGraph, ObjectGraphMessage, 1000)
+
+#undef MESSAGE_FAN_IN_BENCHMARK
+
 BENCHMARK(LargeMap) {
   const char* kScript =
       "makeMap() {\n"
@@ -725,6 +1210,214 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+// Measures scavenges of a new space full of live objects, with the
+// semispaces backed by transparent huge pages or by regular pages.
+static void ScavengeBenchmark(Benchmark* benchmark,
+                              Thread* thread,
+                              bool huge_pages) {
+  TransitionNativeToVM transition(thread);
+  const bool saved_huge_pages = FLAG_transparent_huge_pages;
+  FLAG_transparent_huge_pages = huge_pages;
+  Heap* heap = thread->isolate()->heap();
+  // Two scavenges replace both semispaces with ones of the requested kind.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+
+  const intptr_t kLoopCount = 100;
+  const intptr_t kNumArrays = 10000;
+  const Array& live = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  Array& element = Array::Handle();
+  Timer timer(true, "Scavenge");
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    for (intptr_t j = 0; j < kNumArrays; j++) {
+      element = Array::New(8, Heap::kNew);
+      live.SetAt(j, element);
+    }
+    timer.Start();
+    heap->CollectGarbage(Heap::kNew);
+    timer.Stop();
+  }
+  benchmark->set_score(timer.TotalElapsedTime() / kLoopCount);
+  FLAG_transparent_huge_pages = saved_huge_pages;
+}
+
+BENCHMARK(ScavengeWithHugePages) {
+  ScavengeBenchmark(benchmark, thread, true);
+}
+
+BENCHMARK(ScavengeWithoutHugePages) {
+  ScavengeBenchmark(benchmark, thread, false);
+}
+
+// GC benchmarks. Each allocation profile is scored by its total run time, by
+// the median and 99th percentile of the GC pauses it causes, and by the peak
+// RSS of the process afterwards.
+
+enum GCBenchmarkScore { kGCTotalTime, kGCPauseP50, kGCPauseP99, kGCMaxRSS };
+
+#if !defined(PRODUCT)
+static void GCPauseBuckets(Isolate* isolate, int64_t* buckets) {
+  HistogramMetric* scavenges = isolate->GetGCScavengePauseMetric();
+  HistogramMetric* mark_sweeps = isolate->GetGCMarkSweepPauseMetric();
+  for (intptr_t i = 0; i < HistogramMetric::kNumBuckets; i++) {
+    buckets[i] = scavenges->bucket_count(i) + mark_sweeps->bucket_count(i);
+  }
+}
+
+// Returns the upper bound, in microseconds, of the histogram bucket holding
+// the given percentile of the pauses.
+static int64_t GCPausePercentile(const int64_t* buckets, intptr_t percentile) {
+  int64_t total = 0;
+  for (intptr_t i = 0; i < HistogramMetric::kNumBuckets; i++) {
+    total += buckets[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const int64_t target = (total * percentile + 99) / 100;
+  int64_t count = 0;
+  for (intptr_t i = 0; i < HistogramMetric::kNumBuckets; i++) {
+    count += buckets[i];
+    if (count >= target) {
+      return static_cast<int64_t>(1) << i;
+    }
+  }
+  UNREACHABLE();
+  return 0;
+}
+#endif  // !defined(PRODUCT)
+
+typedef void (*GCWorkload)(Thread* thread);
+
+static void RunGCBenchmark(Benchmark* benchmark,
+                           Thread* thread,
+                           GCWorkload workload,
+                           GCBenchmarkScore score) {
+#if !defined(PRODUCT)
+  int64_t before[HistogramMetric::kNumBuckets];
+  GCPauseBuckets(thread->isolate(), before);
+#endif  // !defined(PRODUCT)
+  Timer timer(true, "GC workload");
+  timer.Start();
+  workload(thread);
+  timer.Stop();
+  switch (score) {
+    case kGCTotalTime:
+      benchmark->set_score(timer.TotalElapsedTime());
+      break;
+    case kGCPauseP50:
+    case kGCPauseP99: {
+#if !defined(PRODUCT)
+      int64_t pauses[HistogramMetric::kNumBuckets];
+      GCPauseBuckets(thread->isolate(), pauses);
+      for (intptr_t i = 0; i < HistogramMetric::kNumBuckets; i++) {
+        pauses[i] -= before[i];
+      }
+      benchmark->set_score(
+          GCPausePercentile(pauses, (score == kGCPauseP50) ? 50 : 99));
+#endif  // !defined(PRODUCT)
+      break;
+    }
+    case kGCMaxRSS:
+      benchmark->set_score(bin::Process::MaxRSS());
+      break;
+  }
+}
+
+// Many small objects that die young.
+static void GCChurnWorkload(Thread* thread) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < 4 * 1000 * 1000; i++) {
+    array = Array::New(4);
+  }
+}
+
+// Objects that all stay alive, so the old generation keeps growing.
+static void GCOldGrowthWorkload(Thread* thread) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const GrowableObjectArray& live =
+      GrowableObjectArray::Handle(GrowableObjectArray::New());
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < 500 * 1000; i++) {
+    array = Array::New(8);
+    live.Add(array);
+  }
+}
+
+// A large old array whose elements keep being replaced by new objects,
+// which goes through the store buffer and card marking.
+static void GCStoreBufferWorkload(Thread* thread) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const intptr_t kLength = 256 * KB;
+  const Array& old = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < 16 * kLength; i++) {
+    element = Array::New(2);
+    old.SetAt((i * 7919) % kLength, element);
+  }
+}
+
+// Objects with peers, which live in weak tables that each GC has to visit.
+static void GCWeakTableWorkload(Thread* thread) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  Heap* heap = thread->isolate()->heap();
+  const intptr_t kLength = 64 * KB;
+  const Array& live = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < 16 * kLength; i++) {
+    element = Array::New(2);
+    heap->SetPeer(element.raw(), reinterpret_cast<void*>(i + 1));
+    live.SetAt(i % kLength, element);
+  }
+}
+
+// Small objects holding large external allocations, which trigger GCs on
+// their own.
+static void GCExternalWorkload(Thread* thread) {
+  static uint8_t data[16];
+  for (intptr_t i = 0; i < 1000; i++) {
+    Dart_EnterScope();
+    for (intptr_t j = 0; j < 10; j++) {
+      Dart_Handle typed_data = Dart_NewExternalTypedData(
+          Dart_TypedData_kUint8, data, ARRAY_SIZE(data));
+      EXPECT_VALID(typed_data);
+      Dart_NewWeakPersistentHandle(typed_data, NULL, 1 * MB, NoopFinalizer);
+    }
+    Dart_ExitScope();
+  }
+}
+
+#define GC_BENCHMARK(name, workload)                                           \
+  BENCHMARK(GC##name) {                                                        \
+    RunGCBenchmark(benchmark, thread, workload, kGCTotalTime);                 \
+  }                                                                            \
+  BENCHMARK(GC##name##PauseP50) {                                              \
+    RunGCBenchmark(benchmark, thread, workload, kGCPauseP50);                  \
+  }                                                                            \
+  BENCHMARK(GC##name##PauseP99) {                                              \
+    RunGCBenchmark(benchmark, thread, workload, kGCPauseP99);                  \
+  }                                                                            \
+  BENCHMARK_MEMORY(GC##name##MaxRSS) {                                         \
+    RunGCBenchmark(benchmark, thread, workload, kGCMaxRSS);                    \
+  }
+
+GC_BENCHMARK(Churn, GCChurnWorkload)
+GC_BENCHMARK(OldGrowth, GCOldGrowthWorkload)
+GC_BENCHMARK(StoreBuffer, GCStoreBufferWorkload)
+GC_BENCHMARK(WeakTable, GCWeakTableWorkload)
+GC_BENCHMARK(External, GCExternalWorkload)
+
+#undef GC_BENCHMARK
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
@@ -19,6 +19,7 @@ namespace dart {
 
 DECLARE_FLAG(int, code_heap_size);
 DECLARE_FLAG(int, old_gen_growth_space_ratio);
+DECLARE_FLAG(bool, benchmark_perf_counters);
 
 namespace bin {
 // Snapshot pieces if we link in a snapshot, otherwise initialized to NULL.
@@ -54,6 +55,7 @@ extern const uint8_t* core_isolate_snapshot_instructions;
 #define BENCHMARK(name) BENCHMARK_HELPER(name, "RunTime")
 #define BENCHMARK_SIZE(name) BENCHMARK_HELPER(name, "CodeSize")
 #define BENCHMARK_MEMORY(name) BENCHMARK_HELPER(name, "MemoryUse")
+#define BENCHMARK_THROUGHPUT(name) BENCHMARK_HELPER(name, "Throughput")
 
 inline Dart_Handle NewString(const char* str) {
   return Dart_NewStringFromCString(str);
@@ -112,6 +114,44 @@ class Benchmark {
   DISALLOW_COPY_AND_ASSIGN(Benchmark);
 };
 
+// Counts hardware events of the current thread, and of the threads it
+// starts, between Start() and Stop(). System calls are counted for every
+// thread of the process, so the calls made by the event handler and the IO
+// thread pool are included. Only supported on Linux, through
+// perf_event_open. Counting system calls needs read access to the
+// raw_syscalls tracepoints in tracefs.
+class BenchmarkPerfCounters : public ValueObject {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kCacheMisses,
+    kBranchMisses,
+    kSyscalls,
+    kNumCounters,
+  };
+
+  BenchmarkPerfCounters();
+  ~BenchmarkPerfCounters();
+
+  // Returns false if no counter could be opened.
+  bool Start();
+  void Stop();
+
+  // Returns -1 for a counter that could not be opened.
+  int64_t Value(Counter counter) const { return values_[counter]; }
+
+  static const char* Name(Counter counter);
+
+ private:
+  int fds_[kNumCounters];
+  int64_t values_[kNumCounters];
+  // One system call counter per thread alive at Start().
+  MallocGrowableArray<int> syscall_fds_;
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkPerfCounters);
+};
+
 class BenchmarkIsolateScope {
  public:
   explicit BenchmarkIsolateScope(Benchmark* benchmark) : benchmark_(benchmark) {
@@ -115,7 +115,9 @@ namespace dart {
   V(StringBase_createFromCodePoints, 3)                                        \
   V(StringBase_substringUnchecked, 3)                                          \
   V(StringBase_joinReplaceAllResult, 4)                                        \
+  V(StringBase_indexOfString, 3)                                               \
   V(StringBuffer_createStringFromUint16Array, 3)                               \
+  V(StringBuffer_concatPartsAndBuffer, 4)                                      \
   V(OneByteString_substringUnchecked, 3)                                       \
   V(OneByteString_splitWithCharCode, 2)                                        \
   V(OneByteString_allocate, 1)                                                 \
@@ -145,7 +147,7 @@ namespace dart {
   V(Random_nextState, 1)                                                       \
   V(Random_setupSeed, 1)                                                       \
   V(Random_initialSeed, 0)                                                     \
-  V(SecureRandom_getBytes, 1)                                                  \
+  V(SecureRandom_fillBytes, 1)                                                 \
   V(DateTime_currentTimeMicros, 0)                                             \
   V(DateTime_timeZoneName, 1)                                                  \
   V(DateTime_timeZoneOffsetInSeconds, 1)                                       \
@@ -306,6 +308,7 @@ namespace dart {
   V(GrowableList_getCapacity, 1)                                               \
   V(GrowableList_setLength, 2)                                                 \
   V(GrowableList_setData, 2)                                                   \
+  V(GrowableList_grow, 2)                                                      \
   V(Internal_unsafeCast, 1)                                                    \
   V(Internal_makeListFixedLength, 1)                                           \
   V(Internal_makeFixedListUnmodifiable, 1)                                     \
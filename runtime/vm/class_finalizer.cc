@@ -194,16 +194,26 @@ bool ClassFinalizer::ProcessPendingClasses() {
     class_array = object_store->pending_classes();
     ASSERT(!class_array.IsNull());
     Class& cls = Class::Handle();
-    // First resolve all superclasses.
-    for (intptr_t i = 0; i < class_array.Length(); i++) {
-      cls ^= class_array.At(i);
+    // First resolve all superclasses. Each resolution pops what it pushes, so
+    // one visited list can be shared instead of growing a fresh one per class.
+    {
+      NOT_IN_PRODUCT(TimelineDurationScope tds(
+          thread, Timeline::GetIsolateStream(), "ResolveSuperTypes"));
       GrowableArray<intptr_t> visited_interfaces;
-      ResolveSuperTypeAndInterfaces(cls, &visited_interfaces);
+      for (intptr_t i = 0; i < class_array.Length(); i++) {
+        cls ^= class_array.At(i);
+        ResolveSuperTypeAndInterfaces(cls, &visited_interfaces);
+        ASSERT(visited_interfaces.is_empty());
+      }
     }
     // Finalize all classes.
-    for (intptr_t i = 0; i < class_array.Length(); i++) {
-      cls ^= class_array.At(i);
-      FinalizeTypesInClass(cls);
+    {
+      NOT_IN_PRODUCT(TimelineDurationScope tds(
+          thread, Timeline::GetIsolateStream(), "FinalizeTypesInClasses"));
+      for (intptr_t i = 0; i < class_array.Length(); i++) {
+        cls ^= class_array.At(i);
+        FinalizeTypesInClass(cls);
+      }
     }
 
     if (FLAG_print_classes) {
@@ -2491,8 +2501,11 @@ void ClassFinalizer::FinalizeClass(const Class& cls) {
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   // If loading from a kernel, make sure that the class is fully loaded.
-  // Top level classes are always fully loaded.
-  if (!cls.IsTopLevel() && cls.kernel_offset() > 0) {
+  // The members of top level classes are only deferred with
+  // --lazy_toplevel_loading, and are loaded once the program is loaded.
+  if (cls.IsTopLevel()) {
+    Library::Handle(cls.library()).EnsureTopLevelMembersLoaded();
+  } else if (cls.kernel_offset() > 0) {
     kernel::KernelLoader::FinishLoading(cls);
   }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -91,6 +91,11 @@ class ClassFinalizer : public AllStatic {
   // Finalize the class including its fields and functions.
   static void FinalizeClass(const Class& cls);
 
+  // Resolve and finalize the types in the signatures of the fields and
+  // functions of class 'cls', e.g. after loading members of a finalized
+  // top level class.
+  static void ResolveAndFinalizeMemberTypes(const Class& cls);
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
   // Verify that the classes have been properly prefinalized. This is
   // needed during bootstrapping where the classes have been preloaded.
@@ -163,7 +168,6 @@ class ClassFinalizer : public AllStatic {
       const Class& cls,
       FinalizationKind finalization = kCanonicalize);
   static void ResolveSignature(const Class& cls, const Function& function);
-  static void ResolveAndFinalizeMemberTypes(const Class& cls);
   static void PrintClassInformation(const Class& cls);
   static void CollectInterfaces(const Class& cls,
                                 GrowableArray<const Class*>* collected);
@@ -15,6 +15,17 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_class_table, false, "Print initial class table.");
+DEFINE_FLAG(int,
+            pretenure_survival_threshold,
+            0,
+            "Allocate instances of a class directly in old space when at "
+            "least this percentage of them survives a scavenge, e.g. 90 "
+            "(0 disables).");
+DEFINE_FLAG(int,
+            pretenure_min_count,
+            1000,
+            "Minimum number of instances of a class in new space before its "
+            "survival rate is considered for pretenuring.");
 
 ClassTable::ClassTable()
     : top_(kNumPredefinedCids),
@@ -103,6 +114,11 @@ bool ClassTable::TraceAllocationFor(intptr_t cid) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   return stats->trace_allocation();
 }
+
+bool ClassTable::PretenureFor(intptr_t cid) {
+  ClassHeapStats* stats = PreliminaryStatsAt(cid);
+  return stats->pretenure();
+}
 #endif  // !PRODUCT
 
 void ClassTable::Register(const Class& cls) {
@@ -347,6 +363,9 @@ void ClassHeapStats::ResetAtOldGC() {
   last_reset.ResetOld();
   post_gc.ResetOld();
   recent.ResetOld();
+  // Pretenured instances that died in old space may mean the class no longer
+  // survives scavenges; let the next scavenge decide again.
+  set_pretenure(false);
 }
 
 void ClassHeapStats::Verify() {
@@ -384,6 +403,19 @@ void ClassHeapStats::UpdatePromotedAfterNewGC() {
   promoted_size = recent.old_size - old_pre_new_gc_size_;
 }
 
+void ClassHeapStats::UpdatePretenureAfterNewGC() {
+  if ((FLAG_pretenure_survival_threshold <= 0) || pretenure() ||
+      (pre_gc.new_count < FLAG_pretenure_min_count)) {
+    return;
+  }
+  // Survivors are either copied within new space or promoted.
+  const intptr_t survived = post_gc.new_count + promoted_count;
+  if ((survived * 100) >=
+      (pre_gc.new_count * FLAG_pretenure_survival_threshold)) {
+    set_pretenure(true);
+  }
+}
+
 void ClassHeapStats::PrintToJSONObject(const Class& cls,
                                        JSONObject* obj) const {
   if (!FLAG_support_service) {
@@ -463,18 +495,23 @@ ClassHeapStats* ClassTable::PreliminaryStatsAt(intptr_t cid) {
 }
 
 ClassHeapStats* ClassTable::StatsWithUpdatedSize(intptr_t cid) {
+  Class& cls = Class::Handle();
+  return StatsWithUpdatedSize(cid, &cls);
+}
+
+ClassHeapStats* ClassTable::StatsWithUpdatedSize(intptr_t cid, Class* cls) {
   if (!HasValidClassAt(cid) || (cid == kFreeListElement) ||
       (cid == kForwardingCorpse) || (cid == kSmiCid)) {
     return NULL;
   }
-  Class& cls = Class::Handle(At(cid));
-  if (!(cls.is_finalized() || cls.is_prefinalized())) {
+  *cls = At(cid);
+  if (!(cls->is_finalized() || cls->is_prefinalized())) {
     // Not finalized.
     return NULL;
   }
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   if (ShouldUpdateSizeForClassId(cid)) {
-    stats->UpdateSize(cls.instance_size());
+    stats->UpdateSize(cls->instance_size());
   }
   stats->Verify();
   return stats;
@@ -504,6 +541,9 @@ void ClassTable::UpdatePromoted() {
   }
   for (intptr_t i = kNumPredefinedCids; i < top_; i++) {
     class_heap_stats_table_[i].UpdatePromotedAfterNewGC();
+    // Only user classes are allocated through AllocateObject, which honors
+    // the pretenure bit.
+    class_heap_stats_table_[i].UpdatePretenureAfterNewGC();
   }
 }
 
@@ -571,10 +611,9 @@ void ClassTable::AllocationProfilePrintJSON(JSONStream* stream) {
     JSONArray arr(&obj, "members");
     Class& cls = Class::Handle();
     for (intptr_t i = 1; i < top_; i++) {
-      const ClassHeapStats* stats = StatsWithUpdatedSize(i);
+      const ClassHeapStats* stats = StatsWithUpdatedSize(i, &cls);
       if (stats != NULL) {
         JSONObject obj(&arr);
-        cls = At(i);
         stats->PrintToJSONObject(cls, &obj);
       }
     }
@@ -582,8 +621,9 @@ void ClassTable::AllocationProfilePrintJSON(JSONStream* stream) {
 }
 
 void ClassTable::ResetAllocationAccumulators() {
+  Class& cls = Class::Handle();
   for (intptr_t i = 1; i < top_; i++) {
-    ClassHeapStats* stats = StatsWithUpdatedSize(i);
+    ClassHeapStats* stats = StatsWithUpdatedSize(i, &cls);
     if (stats != NULL) {
       stats->ResetAccumulator();
     }
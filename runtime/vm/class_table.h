@@ -143,13 +143,18 @@ class ClassHeapStats {
            OFFSET_OF(AllocStats<intptr_t>, old_size);
   }
   static intptr_t state_offset() { return OFFSET_OF(ClassHeapStats, state_); }
-  static intptr_t TraceAllocationMask() { return (1 << kTraceAllocationBit); }
+  // Inline allocation fast paths defer to the runtime when any of these bits
+  // is set: allocations of the class are either traced or pretenured.
+  static intptr_t TraceAllocationMask() {
+    return (1 << kTraceAllocationBit) | (1 << kPretenureBit);
+  }
 
   void Initialize();
   void ResetAtNewGC();
   void ResetAtOldGC();
   void ResetAccumulator();
   void UpdatePromotedAfterNewGC();
+  void UpdatePretenureAfterNewGC();
   void UpdateSize(intptr_t instance_size);
 #ifndef PRODUCT
   void PrintToJSONObject(const Class& cls, JSONObject* obj) const;
@@ -162,13 +167,21 @@ class ClassHeapStats {
     state_ = TraceAllocationBit::update(trace_allocation, state_);
   }
 
+  bool pretenure() const { return PretenureBit::decode(state_); }
+
+  void set_pretenure(bool pretenure) {
+    state_ = PretenureBit::update(pretenure, state_);
+  }
+
  private:
   enum StateBits {
     kTraceAllocationBit = 0,
+    kPretenureBit = 1,
   };
 
   class TraceAllocationBit
       : public BitField<intptr_t, bool, kTraceAllocationBit, 1> {};
+  class PretenureBit : public BitField<intptr_t, bool, kPretenureBit, 1> {};
 
   // Recent old at start of last new GC (used to compute promoted_*).
   intptr_t old_pre_new_gc_count_;
@@ -291,11 +304,13 @@ class ClassTable {
 
   void SetTraceAllocationFor(intptr_t cid, bool trace);
   bool TraceAllocationFor(intptr_t cid);
+  bool PretenureFor(intptr_t cid);
 
  private:
   friend class GCMarker;
   friend class MarkingWeakVisitor;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class ScavengerWeakVisitor;
   friend class ClassHeapStatsTestHelper;
   static const int initial_capacity_ = 512;
@@ -316,6 +331,9 @@ class ClassTable {
 
   // May not have updated size for variable size classes.
   ClassHeapStats* PreliminaryStatsAt(intptr_t cid);
+  // Same as StatsWithUpdatedSize, but reuses the caller's handle so walks
+  // over the whole table do not allocate a handle per class.
+  ClassHeapStats* StatsWithUpdatedSize(intptr_t cid, Class* cls);
   void UpdateLiveOld(intptr_t cid, intptr_t size, intptr_t count = 1);
   void UpdateLiveNew(intptr_t cid, intptr_t size);
   void UpdateLiveOldExternal(intptr_t cid, intptr_t size);
@@ -5,7 +5,9 @@
 #include "vm/clustered_snapshot.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/bootstrap.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/backend/code_statistics.h"
 #include "vm/dart.h"
 #include "vm/heap/heap.h"
@@ -16,6 +18,7 @@
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/version.h"
 
@@ -23,6 +26,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(charp,
+            load_startup_trace,
+            NULL,
+            "Place the code of the functions in this startup trace, as saved "
+            "by Dart_SaveStartupTrace, first in the instructions and read-only "
+            "data images.");
+
 static RawObject* AllocateUninitialized(PageSpace* old_space, intptr_t size) {
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
   uword address =
@@ -199,6 +209,9 @@ class ClassDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Registers the classes in the class table.
+  bool CanReadFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     Snapshot::Kind kind = d->kind();
     bool is_vm_object = d->isolate() == Dart::vm_isolate();
@@ -1523,6 +1536,43 @@ class KernelProgramInfoDeserializationCluster : public DeserializationCluster {
   }
 };
 
+struct RankedObject {
+  intptr_t rank;
+  intptr_t index;
+};
+
+static int CompareRankedObjects(const RankedObject* a, const RankedObject* b) {
+  if (a->rank != b->rank) {
+    return (a->rank < b->rank) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : ((a->index > b->index) ? 1 : 0);
+}
+
+// Moves the objects used during startup to the front, in the order of the
+// startup trace, and keeps the order of the other objects. Since the image
+// offsets follow the order of the cluster, this places the instructions and
+// read-only data touched during startup together at the start of the images.
+template <typename T>
+static void SortByStartupRank(Serializer* s, GrowableArray<T>* objects) {
+  if (!s->HasStartupCode()) {
+    return;
+  }
+  const intptr_t count = objects->length();
+  GrowableArray<RankedObject> ranked(count);
+  for (intptr_t i = 0; i < count; i++) {
+    RankedObject entry = {s->StartupRank((*objects)[i]), i};
+    ranked.Add(entry);
+  }
+  ranked.Sort(CompareRankedObjects);
+  GrowableArray<T> sorted(count);
+  for (intptr_t i = 0; i < count; i++) {
+    sorted.Add((*objects)[ranked[i].index]);
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    (*objects)[i] = sorted[i];
+  }
+}
+
 class CodeSerializationCluster : public SerializationCluster {
  public:
   CodeSerializationCluster() : SerializationCluster("Code") {}
@@ -1555,6 +1605,7 @@ class CodeSerializationCluster : public SerializationCluster {
   }
 
   void WriteAlloc(Serializer* s) {
+    SortByStartupRank(s, &objects_);
     s->WriteCid(kCodeCid);
     intptr_t count = objects_.length();
     s->WriteUnsigned(count);
@@ -1868,6 +1919,26 @@ class ObjectPoolDeserializationCluster : public DeserializationCluster {
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+// Places the objects in the read-only data image and writes their offsets,
+// see ReadReadOnlyObjects. Image objects are shared by all isolates loaded
+// from the snapshot and are never marked or moved by the GC.
+template <typename T>
+static void WriteReadOnlyObjects(Serializer* s,
+                                 const GrowableArray<T>& objects) {
+  const intptr_t count = objects.length();
+  s->WriteUnsigned(count);
+  uint32_t running_offset = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    RawObject* object = objects[i];
+    uint32_t offset = s->GetDataOffset(object);
+    ASSERT(Utils::IsAligned(offset, kObjectAlignment));
+    ASSERT(offset > running_offset);
+    s->WriteUnsigned((offset - running_offset) >> kObjectAlignmentLog2);
+    running_offset = offset;
+    s->AssignRef(object);
+  }
+}
+
 // PcDescriptor, StackMap, OneByteString, TwoByteString
 class RODataSerializationCluster : public SerializationCluster {
  public:
@@ -1908,18 +1979,8 @@ class RODataSerializationCluster : public SerializationCluster {
       s->AssignRef(object);
     }
 
-    count = objects_.length();
-    s->WriteUnsigned(count);
-    uint32_t running_offset = 0;
-    for (intptr_t i = 0; i < count; i++) {
-      RawObject* object = objects_[i];
-      uint32_t offset = s->GetDataOffset(object);
-      ASSERT(Utils::IsAligned(offset, kObjectAlignment));
-      ASSERT(offset > running_offset);
-      s->WriteUnsigned((offset - running_offset) >> kObjectAlignmentLog2);
-      running_offset = offset;
-      s->AssignRef(object);
-    }
+    SortByStartupRank(s, &objects_);
+    WriteReadOnlyObjects(s, objects_);
   }
 
   void WriteFill(Serializer* s) {
@@ -1933,6 +1994,15 @@ class RODataSerializationCluster : public SerializationCluster {
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
+static void ReadReadOnlyObjects(Deserializer* d) {
+  intptr_t count = d->ReadUnsigned();
+  uint32_t running_offset = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    running_offset += d->ReadUnsigned() << kObjectAlignmentLog2;
+    d->AssignRef(d->GetObjectAt(running_offset));
+  }
+}
+
 class RODataDeserializationCluster : public DeserializationCluster {
  public:
   RODataDeserializationCluster() {}
@@ -1945,12 +2015,7 @@ class RODataDeserializationCluster : public DeserializationCluster {
       d->AssignRef(d->GetSharedObjectAt(offset));
     }
 
-    count = d->ReadUnsigned();
-    uint32_t running_offset = 0;
-    for (intptr_t i = 0; i < count; i++) {
-      running_offset += d->ReadUnsigned() << kObjectAlignmentLog2;
-      d->AssignRef(d->GetObjectAt(running_offset));
-    }
+    ReadReadOnlyObjects(d);
   }
 
   void ReadFill(Deserializer* d) {
@@ -3034,6 +3099,9 @@ class TypeDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Sets type testing stubs through handles.
+  bool CanReadFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     const bool is_vm_isolate = d->isolate() == Dart::vm_isolate();
     const bool should_read_type_testing_stub =
@@ -3179,6 +3247,9 @@ class TypeRefDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Sets type testing stubs through handles.
+  bool CanReadFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     const bool is_vm_object = d->isolate() == Dart::vm_isolate();
     const bool should_read_type_testing_stub =
@@ -3293,6 +3364,9 @@ class TypeParameterDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Sets type testing stubs through handles.
+  bool CanReadFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     bool is_vm_object = d->isolate() == Dart::vm_isolate();
     const bool should_read_type_testing_stub =
@@ -3500,7 +3574,13 @@ class MintSerializationCluster : public SerializationCluster {
       smis_.Add(smi);
     } else {
       RawMint* mint = Mint::RawCast(object);
-      mints_.Add(mint);
+      if (mint->IsCanonical() && Snapshot::IncludesCode(s->kind())) {
+        // Canonical mints are never written to, so they can live in the
+        // read-only data image shared by every isolate using the snapshot.
+        ro_mints_.Add(mint);
+      } else {
+        mints_.Add(mint);
+      }
     }
   }
 
@@ -3520,6 +3600,7 @@ class MintSerializationCluster : public SerializationCluster {
       s->Write<int64_t>(mint->ptr()->value_);
       s->AssignRef(mint);
     }
+    WriteReadOnlyObjects(s, ro_mints_);
   }
 
   void WriteFill(Serializer* s) {}
@@ -3527,6 +3608,7 @@ class MintSerializationCluster : public SerializationCluster {
  private:
   GrowableArray<RawSmi*> smis_;
   GrowableArray<RawMint*> mints_;
+  GrowableArray<RawMint*> ro_mints_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -3555,6 +3637,7 @@ class MintDeserializationCluster : public DeserializationCluster {
         d->AssignRef(mint);
       }
     }
+    ReadReadOnlyObjects(d);
     stop_index_ = d->next_index();
   }
 
@@ -3585,7 +3668,13 @@ class DoubleSerializationCluster : public SerializationCluster {
 
   void Trace(Serializer* s, RawObject* object) {
     RawDouble* dbl = Double::RawCast(object);
-    objects_.Add(dbl);
+    if (dbl->IsCanonical() && Snapshot::IncludesCode(s->kind())) {
+      // Unlike the boxes of unboxed fields, canonical doubles are never
+      // written to and can live in the read-only data image.
+      ro_objects_.Add(dbl);
+    } else {
+      objects_.Add(dbl);
+    }
   }
 
   void WriteAlloc(Serializer* s) {
@@ -3596,6 +3685,7 @@ class DoubleSerializationCluster : public SerializationCluster {
       RawDouble* dbl = objects_[i];
       s->AssignRef(dbl);
     }
+    WriteReadOnlyObjects(s, ro_objects_);
   }
 
   void WriteFill(Serializer* s) {
@@ -3609,6 +3699,7 @@ class DoubleSerializationCluster : public SerializationCluster {
 
  private:
   GrowableArray<RawDouble*> objects_;
+  GrowableArray<RawDouble*> ro_objects_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -3625,6 +3716,8 @@ class DoubleDeserializationCluster : public DeserializationCluster {
       d->AssignRef(AllocateUninitialized(old_space, Double::InstanceSize()));
     }
     stop_index_ = d->next_index();
+    // Filled in the image, not in ReadFill.
+    ReadReadOnlyObjects(d);
   }
 
   void ReadFill(Deserializer* d) {
@@ -4202,6 +4295,9 @@ class LinkedHashMapDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Allocates the backing stores of the maps.
+  bool CanReadFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     bool is_vm_object = d->isolate() == Dart::vm_isolate();
     PageSpace* old_space = d->heap()->old_space();
@@ -4518,7 +4614,8 @@ Serializer::Serializer(Thread* thread,
       num_cids_(0),
       num_base_objects_(0),
       num_written_objects_(0),
-      next_ref_index_(1)
+      next_ref_index_(1),
+      startup_code_(NULL)
 #if defined(SNAPSHOT_BACKTRACE)
       ,
       current_parent_(Object::null()),
@@ -4682,6 +4779,35 @@ bool Serializer::GetSharedDataOffset(RawObject* object,
   return image_writer_->GetSharedDataOffsetFor(object, offset);
 }
 
+intptr_t Serializer::StartupRank(RawObject* object) const {
+  ObjectRankPair* pair = startup_ranks_.Lookup(object);
+  return (pair == NULL) ? kNoStartupRank : pair->rank_;
+}
+
+void Serializer::AddStartupRank(RawObject* object, intptr_t rank) {
+  if (!object->IsHeapObject() || (startup_ranks_.Lookup(object) != NULL)) {
+    return;
+  }
+  startup_ranks_.Insert(ObjectRankPair(object, rank));
+}
+
+void Serializer::AddStartupRanks() {
+  Code& code = Code::Handle(zone_);
+  Array& stackmaps = Array::Handle(zone_);
+  for (intptr_t i = 0; i < startup_code_->length(); i++) {
+    code ^= (*startup_code_)[i]->raw();
+    AddStartupRank(code.raw(), i);
+    AddStartupRank(code.pc_descriptors(), i);
+    AddStartupRank(code.code_source_map(), i);
+    stackmaps = code.stackmaps();
+    if (!stackmaps.IsNull()) {
+      for (intptr_t j = 0; j < stackmaps.Length(); j++) {
+        AddStartupRank(stackmaps.At(j), i);
+      }
+    }
+  }
+}
+
 uint32_t Serializer::GetDataOffset(RawObject* object) const {
   return image_writer_->GetDataOffsetFor(object);
 }
@@ -4864,15 +4990,36 @@ void Serializer::Serialize() {
   // We should have assigned a ref to every object we pushed.
   ASSERT((next_ref_index_ - 1) == num_objects);
 
+  // The size of every fill section is patched in once it is written, so
+  // that the deserializer can read the fill sections concurrently.
+  const intptr_t fill_sizes_position = stream_.Position();
+  for (intptr_t i = 0; i < num_clusters; i++) {
+    const uint32_t placeholder = 0;
+    WriteBytes(reinterpret_cast<const uint8_t*>(&placeholder),
+               sizeof(placeholder));
+  }
+
+  intptr_t cluster_index = 0;
   for (intptr_t cid = 1; cid < num_cids_; cid++) {
     SerializationCluster* cluster = clusters_by_cid_[cid];
     if (cluster != NULL) {
+      const intptr_t fill_start = stream_.Position();
       cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
       Write<int32_t>(kSectionMarker);
 #endif
+      const intptr_t fill_size = stream_.Position() - fill_start;
+      if (!Utils::IsUint(32, fill_size)) {
+        FATAL("Fill section overflow");
+      }
+      const uint32_t size = static_cast<uint32_t>(fill_size);
+      memmove(stream_.buffer() + fill_sizes_position +
+                  cluster_index * sizeof(size),
+              &size, sizeof(size));
+      cluster_index++;
     }
   }
+  ASSERT(cluster_index == num_clusters);
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_print_snapshot_sizes_verbose) {
@@ -4997,6 +5144,10 @@ void Serializer::WriteIsolateSnapshot(intptr_t num_base_objects,
                                       ObjectStore* object_store) {
   NoSafepointScope no_safepoint;
 
+  if (startup_code_ != NULL) {
+    AddStartupRanks();
+  }
+
   if (num_base_objects == 0) {
     // Not writing a new vm isolate: use the one this VM was loaded from.
     const Array& base_objects = Object::vm_isolate_snapshot_object_table();
@@ -5040,13 +5191,17 @@ Deserializer::Deserializer(Thread* thread,
                            const uint8_t* shared_instructions_buffer)
     : StackResource(thread),
       heap_(thread->isolate()->heap()),
+      isolate_(thread->isolate()),
       zone_(thread->zone()),
       kind_(kind),
       stream_(buffer, size),
       image_reader_(NULL),
       refs_(NULL),
       next_ref_index_(1),
-      clusters_(NULL) {
+      clusters_(NULL),
+      fill_starts_(NULL),
+      fill_sizes_(NULL),
+      next_fill_cluster_(0) {
   if (Snapshot::IncludesCode(kind)) {
     ASSERT(instructions_buffer != NULL);
     ASSERT(data_buffer != NULL);
@@ -5056,6 +5211,26 @@ Deserializer::Deserializer(Thread* thread,
   }
 }
 
+Deserializer::Deserializer(Deserializer* parent,
+                           const uint8_t* buffer,
+                           intptr_t size)
+    : StackResource(NULL),
+      heap_(parent->heap_),
+      isolate_(parent->isolate_),
+      zone_(NULL),
+      kind_(parent->kind_),
+      stream_(buffer, size),
+      image_reader_(parent->image_reader_),
+      num_base_objects_(parent->num_base_objects_),
+      num_objects_(parent->num_objects_),
+      num_clusters_(parent->num_clusters_),
+      refs_(parent->refs_),
+      next_ref_index_(parent->next_ref_index_),
+      clusters_(NULL),
+      fill_starts_(NULL),
+      fill_sizes_(NULL),
+      next_fill_cluster_(0) {}
+
 Deserializer::~Deserializer() {
   delete[] clusters_;
 }
@@ -5268,6 +5443,36 @@ RawObject* Deserializer::GetSharedObjectAt(uint32_t offset) const {
   return image_reader_->GetSharedObjectAt(offset);
 }
 
+// Fill sections smaller than this are read on the main thread only.
+static const intptr_t kMinConcurrentFillSize = 256 * KB;
+
+// Fills clusters on a thread pool thread. These threads are not registered
+// with the isolate; the main thread waits in Deserialize until they finish,
+// so no GC or other mutator can observe the partially filled objects.
+class DeserializationFillTask : public ThreadPool::Task {
+ public:
+  DeserializationFillTask(Deserializer* deserializer,
+                          Monitor* monitor,
+                          intptr_t* pending_tasks)
+      : deserializer_(deserializer),
+        monitor_(monitor),
+        pending_tasks_(pending_tasks) {}
+
+  virtual void Run() {
+    deserializer_->FillClusters();
+    MonitorLocker ml(monitor_);
+    (*pending_tasks_)--;
+    ml.Notify();
+  }
+
+ private:
+  Deserializer* deserializer_;
+  Monitor* monitor_;
+  intptr_t* pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeserializationFillTask);
+};
+
 void Deserializer::Prepare() {
   num_base_objects_ = ReadUnsigned();
   num_objects_ = ReadUnsigned();
@@ -5303,16 +5508,86 @@ void Deserializer::Deserialize() {
   {
     NOT_IN_PRODUCT(TimelineDurationScope tds(
         thread(), Timeline::GetIsolateStream(), "ReadFill"));
+    // All objects are allocated by now, and every cluster only initializes
+    // its own objects, so the fill sections can be read in any order.
+    fill_starts_ = zone_->Alloc<const uint8_t*>(num_clusters_);
+    fill_sizes_ = zone_->Alloc<intptr_t>(num_clusters_);
+    intptr_t total_fill_size = 0;
     for (intptr_t i = 0; i < num_clusters_; i++) {
-      clusters_[i]->ReadFill(this);
+      uint32_t fill_size;
+      ReadBytes(reinterpret_cast<uint8_t*>(&fill_size), sizeof(fill_size));
+      fill_sizes_[i] = fill_size;
+    }
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      fill_starts_[i] = CurrentBufferAddress() + total_fill_size;
+      total_fill_size += fill_sizes_[i];
+    }
+
+    intptr_t num_tasks = 0;
+    if ((num_clusters_ > 1) && (total_fill_size >= kMinConcurrentFillSize)) {
+      num_tasks =
+          Utils::Minimum(static_cast<intptr_t>(FLAG_deserialization_tasks),
+                         num_clusters_ - 1);
+    }
+    if (num_tasks <= 0) {
+      for (intptr_t i = 0; i < num_clusters_; i++) {
+        clusters_[i]->ReadFill(this);
+#if defined(DEBUG)
+        int32_t section_marker = Read<int32_t>();
+        ASSERT(section_marker == kSectionMarker);
+#endif
+      }
+    } else {
+      // Clusters that need the main thread are filled first, the others are
+      // shared between the main thread and the fill tasks.
+      for (intptr_t i = 0; i < num_clusters_; i++) {
+        if (!clusters_[i]->CanReadFillConcurrently()) {
+          Deserializer reader(this, fill_starts_[i], fill_sizes_[i]);
+          clusters_[i]->ReadFill(&reader);
 #if defined(DEBUG)
-      int32_t section_marker = Read<int32_t>();
-      ASSERT(section_marker == kSectionMarker);
+          int32_t section_marker = reader.Read<int32_t>();
+          ASSERT(section_marker == kSectionMarker);
 #endif
+        }
+      }
+      Monitor monitor;
+      intptr_t pending_tasks = num_tasks;
+      for (intptr_t i = 0; i < num_tasks; i++) {
+        Dart::thread_pool()->Run(
+            new DeserializationFillTask(this, &monitor, &pending_tasks));
+      }
+      FillClusters();
+      {
+        MonitorLocker ml(&monitor);
+        while (pending_tasks > 0) {
+          ml.Wait();
+        }
+      }
+      Advance(total_fill_size);
     }
   }
 }
 
+void Deserializer::FillClusters() {
+  while (true) {
+    const intptr_t i =
+        AtomicOperations::FetchAndIncrement(&next_fill_cluster_);
+    if (i >= num_clusters_) {
+      return;
+    }
+    if (!clusters_[i]->CanReadFillConcurrently()) {
+      continue;
+    }
+    Deserializer reader(this, fill_starts_[i], fill_sizes_[i]);
+    clusters_[i]->ReadFill(&reader);
+#if defined(DEBUG)
+    int32_t section_marker = reader.Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+    ASSERT(reader.PendingBytes() == 0);
+#endif
+  }
+}
+
 class HeapLocker : public StackResource {
  public:
   HeapLocker(Thread* thread, PageSpace* page_space)
@@ -5536,7 +5811,8 @@ class SeedVMIsolateVisitor : public ClassVisitor, public FunctionVisitor {
 
     stack_maps_ = code_.stackmaps();
     if (!stack_maps_.IsNull()) {
-      for (intptr_t i = 0; i < stack_maps_.Length(); i++) {
+      for (intptr_t i = Code::kSMStackMapEntry; i < stack_maps_.Length();
+           i += Code::kSMEntryLength) {
         AddSeed(stack_maps_.At(i));
       }
     }
@@ -5659,6 +5935,40 @@ intptr_t FullSnapshotWriter::WriteVMSnapshot() {
   return num_objects;
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+ZoneGrowableArray<Object*>* FullSnapshotWriter::LoadStartupTrace() {
+  Dart_FileOpenCallback file_open = Dart::file_open_callback();
+  Dart_FileReadCallback file_read = Dart::file_read_callback();
+  Dart_FileCloseCallback file_close = Dart::file_close_callback();
+  if ((file_open == NULL) || (file_read == NULL) || (file_close == NULL)) {
+    OS::PrintErr("warning: Could not read the startup trace %s\n",
+                 FLAG_load_startup_trace);
+    return NULL;
+  }
+  void* file = file_open(FLAG_load_startup_trace, /*write=*/false);
+  if (file == NULL) {
+    OS::PrintErr("warning: Could not open the startup trace %s\n",
+                 FLAG_load_startup_trace);
+    return NULL;
+  }
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = 0;
+  file_read(&buffer, &buffer_length, file);
+  file_close(file);
+  if (buffer == NULL) {
+    OS::PrintErr("warning: Could not read the startup trace %s\n",
+                 FLAG_load_startup_trace);
+    return NULL;
+  }
+
+  ZoneGrowableArray<Object*>* code = new (zone()) ZoneGrowableArray<Object*>();
+  StartupTraceLoader loader(thread());
+  loader.LoadTrace(buffer, buffer_length, code);
+  free(buffer);
+  return code;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 void FullSnapshotWriter::WriteIsolateSnapshot(intptr_t num_base_objects) {
   NOT_IN_PRODUCT(TimelineDurationScope tds(
       thread(), Timeline::GetIsolateStream(), "WriteIsolateSnapshot"));
@@ -5668,6 +5978,12 @@ void FullSnapshotWriter::WriteIsolateSnapshot(intptr_t num_base_objects) {
   ObjectStore* object_store = isolate()->object_store();
   ASSERT(object_store != NULL);
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if ((FLAG_load_startup_trace != NULL) && Snapshot::IncludesCode(kind_)) {
+    serializer.set_startup_code(LoadStartupTrace());
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   serializer.ReserveHeader();
   serializer.WriteVersionAndFeatures(false);
   // Isolate snapshot roots are:
@@ -90,6 +90,11 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill can run on a helper thread, concurrently with the fill
+  // of other clusters. It must then only read from the deserializer's stream
+  // and ref array, and not use handles or the isolate's tables.
+  virtual bool CanReadFillConcurrently() const { return true; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(const Array& refs, Snapshot::Kind kind, Zone* zone) {}
@@ -125,6 +130,31 @@ class SmiObjectIdPairTrait {
 
 typedef DirectChainedHashMap<SmiObjectIdPairTrait> SmiObjectIdMap;
 
+class ObjectRankPair {
+ public:
+  ObjectRankPair() : object_(NULL), rank_(0) {}
+  ObjectRankPair(RawObject* object, intptr_t rank)
+      : object_(object), rank_(rank) {}
+  RawObject* object_;
+  intptr_t rank_;
+};
+
+class ObjectRankPairTrait {
+ public:
+  typedef RawObject* Key;
+  typedef intptr_t Value;
+  typedef ObjectRankPair Pair;
+
+  static Key KeyOf(Pair kv) { return kv.object_; }
+  static Value ValueOf(Pair kv) { return kv.rank_; }
+  static inline intptr_t Hashcode(Key key) {
+    return reinterpret_cast<uword>(key) >> kObjectAlignmentLog2;
+  }
+  static inline bool IsKeyEqual(Pair kv, Key key) { return kv.object_ == key; }
+};
+
+typedef DirectChainedHashMap<ObjectRankPairTrait> ObjectRankMap;
+
 class Serializer : public StackResource {
  public:
   Serializer(Thread* thread,
@@ -264,7 +294,22 @@ class Serializer : public StackResource {
 
   void DumpCombinedCodeStatistics();
 
+  // The code run during startup, in the order of the startup trace. Its
+  // instructions and read-only data are written first into the images.
+  void set_startup_code(ZoneGrowableArray<Object*>* code) {
+    startup_code_ = code;
+  }
+  bool HasStartupCode() const { return startup_code_ != NULL; }
+
+  // Returns the position in the startup trace of the first code that uses
+  // the object, or kNoStartupRank.
+  static const intptr_t kNoStartupRank = kIntptrMax;
+  intptr_t StartupRank(RawObject* object) const;
+
  private:
+  void AddStartupRanks();
+  void AddStartupRank(RawObject* object, intptr_t rank);
+
   TypeTestingStubFinder type_testing_stubs_;
   Heap* heap_;
   Zone* zone_;
@@ -278,6 +323,8 @@ class Serializer : public StackResource {
   intptr_t num_written_objects_;
   intptr_t next_ref_index_;
   SmiObjectIdMap smi_ids_;
+  ZoneGrowableArray<Object*>* startup_code_;
+  ObjectRankMap startup_ranks_;
 
 #if defined(SNAPSHOT_BACKTRACE)
   RawObject* current_parent_;
@@ -365,10 +412,20 @@ class Deserializer : public StackResource {
 
   intptr_t next_index() const { return next_ref_index_; }
   Heap* heap() const { return heap_; }
+  Isolate* isolate() const { return isolate_; }
   Snapshot::Kind kind() const { return kind_; }
 
  private:
+  // Creates a deserializer that reads the fill section of one cluster on a
+  // helper thread, sharing the ref array of the given deserializer.
+  Deserializer(Deserializer* parent, const uint8_t* buffer, intptr_t size);
+
+  // Fills the clusters that are not filled yet, see CanReadFillConcurrently.
+  // Executed by the main thread and by the fill tasks.
+  void FillClusters();
+
   Heap* heap_;
+  Isolate* isolate_;
   Zone* zone_;
   Snapshot::Kind kind_;
   ReadStream stream_;
@@ -379,6 +436,14 @@ class Deserializer : public StackResource {
   RawArray* refs_;
   intptr_t next_ref_index_;
   DeserializationCluster** clusters_;
+
+  // The start and size of the fill section of every cluster, and the index
+  // of the next cluster to fill.
+  const uint8_t** fill_starts_;
+  intptr_t* fill_sizes_;
+  intptr_t next_fill_cluster_;
+
+  friend class DeserializationFillTask;
 };
 
 class FullSnapshotWriter {
@@ -416,6 +481,12 @@ class FullSnapshotWriter {
   // Writes a full snapshot of a regular Dart Isolate.
   void WriteIsolateSnapshot(intptr_t num_base_objects);
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Returns the code of the functions in --load_startup_trace, or NULL if
+  // the trace cannot be read.
+  ZoneGrowableArray<Object*>* LoadStartupTrace();
+#endif
+
   Thread* thread_;
   Snapshot::Kind kind_;
   uint8_t** vm_snapshot_data_buffer_;
@@ -46,19 +46,25 @@ RawPcDescriptors* DescriptorList::FinalizePcDescriptors(uword entry_point) {
 void StackMapTableBuilder::AddEntry(intptr_t pc_offset,
                                     BitmapBuilder* bitmap,
                                     intptr_t register_bit_count) {
-  stack_map_ = StackMap::New(pc_offset, bitmap, register_bit_count);
+  stack_map_ = StackMap::New(bitmap, register_bit_count);
+  if (Length() > 0) {
+    // Neighbouring safepoints often have the same live slots, so share their
+    // StackMap. The precompiler also shares them between functions, see
+    // ProgramVisitor::DedupStackMaps.
+    const StackMap& previous = StackMap::Handle(MapAt(Length() - 1));
+    if (previous.Equals(stack_map_)) {
+      stack_map_ = previous.raw();
+    }
+  }
+  list_.Add(Smi::Handle(Smi::New(pc_offset)), Heap::kOld);
   list_.Add(stack_map_, Heap::kOld);
 }
 
 bool StackMapTableBuilder::Verify() {
   intptr_t num_entries = Length();
-  StackMap& map1 = StackMap::Handle();
-  StackMap& map2 = StackMap::Handle();
   for (intptr_t i = 1; i < num_entries; i++) {
-    map1 = MapAt(i - 1);
-    map2 = MapAt(i);
     // Ensure there are no duplicates and the entries are sorted.
-    if (map1.PcOffset() >= map2.PcOffset()) {
+    if (PcOffsetAt(i - 1) >= PcOffsetAt(i)) {
       return false;
     }
   }
@@ -74,9 +80,14 @@ RawArray* StackMapTableBuilder::FinalizeStackMaps(const Code& code) {
   return Array::MakeFixedLength(list_);
 }
 
+intptr_t StackMapTableBuilder::PcOffsetAt(intptr_t index) const {
+  return Smi::Value(Smi::RawCast(
+      list_.At(index * Code::kSMEntryLength + Code::kSMPcOffsetEntry)));
+}
+
 RawStackMap* StackMapTableBuilder::MapAt(intptr_t index) const {
   StackMap& map = StackMap::Handle();
-  map ^= list_.At(index);
+  map ^= list_.At(index * Code::kSMEntryLength + Code::kSMStackMapEntry);
   return map.raw();
 }
 
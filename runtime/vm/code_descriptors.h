@@ -61,7 +61,8 @@ class StackMapTableBuilder : public ZoneAllocated {
   RawArray* FinalizeStackMaps(const Code& code);
 
  private:
-  intptr_t Length() const { return list_.Length(); }
+  intptr_t Length() const { return list_.Length() / Code::kSMEntryLength; }
+  intptr_t PcOffsetAt(intptr_t index) const;
   RawStackMap* MapAt(intptr_t index) const;
 
   StackMap& stack_map_;
@@ -118,6 +118,31 @@ TEST_CASE(StackMapGC) {
   EXPECT(!result.IsError());
 }
 
+ISOLATE_UNIT_TEST_CASE(StackMapTableBuilder_SharesStackMaps) {
+  StackMapTableBuilder* builder = new StackMapTableBuilder();
+  BitmapBuilder* live = new BitmapBuilder();
+  live->Set(0, true);
+  live->Set(1, false);
+  builder->AddEntry(4, live, 0);
+  builder->AddEntry(8, live, 0);
+  live->Set(1, true);
+  builder->AddEntry(12, live, 0);
+  const Array& table =
+      Array::Handle(builder->FinalizeStackMaps(Code::Handle()));
+  EXPECT_EQ(3 * Code::kSMEntryLength, table.Length());
+  EXPECT_EQ(Smi::New(8), table.At(Code::kSMEntryLength));
+  // Neighbouring safepoints with the same live slots share their map.
+  EXPECT_EQ(table.At(Code::kSMStackMapEntry),
+            table.At(Code::kSMEntryLength + Code::kSMStackMapEntry));
+  const StackMap& first =
+      StackMap::Handle(StackMap::RawCast(table.At(Code::kSMStackMapEntry)));
+  const StackMap& last = StackMap::Handle(StackMap::RawCast(
+      table.At(2 * Code::kSMEntryLength + Code::kSMStackMapEntry)));
+  EXPECT(!first.Equals(last));
+  EXPECT(!first.IsObject(1));
+  EXPECT(last.IsObject(1));
+}
+
 ISOLATE_UNIT_TEST_CASE(DescriptorList_TokenPositions) {
   DescriptorList* descriptors = new DescriptorList(64);
   ASSERT(descriptors != NULL);
@@ -16,6 +16,28 @@ namespace dart {
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 DEFINE_FLAG(bool, trace_compilation_trace, false, "Trace compilation trace.");
+DEFINE_FLAG(bool, trace_type_feedback, false, "Trace loading type feedback.");
+
+// Only functions read from kernel have a source fingerprint. Synthetic
+// functions, like method extractors and dispatchers, return 0 and are
+// matched by name alone.
+static int32_t FunctionFingerprint(const Function& function) {
+  switch (function.kind()) {
+    case RawFunction::kRegularFunction:
+    case RawFunction::kClosureFunction:
+    case RawFunction::kGetterFunction:
+    case RawFunction::kSetterFunction:
+    case RawFunction::kConstructor:
+      break;
+    default:
+      return 0;
+  }
+  if ((function.kernel_offset() <= 0) ||
+      (function.KernelData() == ExternalTypedData::null())) {
+    return 0;
+  }
+  return function.SourceFingerprint();
+}
 
 CompilationTraceSaver::CompilationTraceSaver(Zone* zone)
     : buf_(zone, 4 * KB),
@@ -42,8 +64,9 @@ void CompilationTraceSaver::Visit(const Function& function) {
   cls_name_ = String::RemovePrivateKey(cls_name_);
   lib_ = cls_.library();
   uri_ = lib_.url();
-  buf_.Printf("%s,%s,%s\n", uri_.ToCString(), cls_name_.ToCString(),
-              func_name_.ToCString());
+  buf_.Printf("%s,%s,%s,%" Pd32 ",%d\n", uri_.ToCString(),
+              cls_name_.ToCString(), func_name_.ToCString(),
+              FunctionFingerprint(function), function.HasOptimizedCode());
 }
 
 CompilationTraceLoader::CompilationTraceLoader(Thread* thread)
@@ -94,7 +117,20 @@ RawObject* CompilationTraceLoader::CompileTrace(uint8_t* buffer,
       break;
     }
     *newline = 0;
-    error_ = CompileTriple(uri, cls_name, func_name);
+    // Traces written before fingerprints were recorded end here.
+    int32_t fingerprint = 0;
+    bool was_optimized = false;
+    char* comma3 = FindCharacter(func_name, ',', newline);
+    if (comma3 != NULL) {
+      *comma3 = 0;
+      char* end = NULL;
+      fingerprint = static_cast<int32_t>(strtol(comma3 + 1, &end, 10));
+      if ((end != NULL) && (*end == ',')) {
+        was_optimized = (end[1] == '1');
+      }
+    }
+    error_ = CompileTriple(uri, cls_name, func_name, fingerprint,
+                           was_optimized);
     if (error_.IsError()) {
       return error_.raw();
     }
@@ -148,9 +184,15 @@ RawObject* CompilationTraceLoader::CompileTrace(uint8_t* buffer,
 //    compile the getter, create its method extractor and compile that.
 //  - If looking for a getter and we only have a const field, evaluate the const
 //    field.
+// A function whose source fingerprint differs from the recorded one has
+// changed since the trace was saved and is left to be compiled on demand.
+// Functions that had optimized code when the trace was saved are marked to be
+// optimized again after a short warm-up.
 RawObject* CompilationTraceLoader::CompileTriple(const char* uri_cstr,
                                                  const char* cls_cstr,
-                                                 const char* func_cstr) {
+                                                 const char* func_cstr,
+                                                 int32_t fingerprint,
+                                                 bool was_optimized) {
   uri_ = Symbols::New(thread_, uri_cstr);
   class_name_ = Symbols::New(thread_, cls_cstr);
   function_name_ = Symbols::New(thread_, func_cstr);
@@ -260,6 +302,15 @@ RawObject* CompilationTraceLoader::CompileTriple(const char* uri_cstr,
     }
   }
 
+  if (!function_.IsNull() && (fingerprint != 0) && !add_closure &&
+      (FunctionFingerprint(function_) != fingerprint)) {
+    if (FLAG_trace_compilation_trace) {
+      THR_Print("Compilation trace: stale %s,%s,%s\n", uri_.ToCString(),
+                class_name_.ToCString(), function_name_.ToCString());
+    }
+    return Object::null();
+  }
+
   if (!function_.IsNull()) {
     processed = true;
     error_ = CompileFunction(function_);
@@ -285,6 +336,15 @@ RawObject* CompilationTraceLoader::CompileTriple(const char* uri_cstr,
         return error_.raw();
       }
     }
+    if (was_optimized && (FLAG_optimization_counter_threshold > 0)) {
+      // Optimize soon, but leave the unoptimized code some calls to collect
+      // type feedback first.
+      const intptr_t usage_counter =
+          Utils::Maximum(FLAG_optimization_counter_threshold - 100, 0);
+      if (function_.usage_counter() < usage_counter) {
+        function_.SetUsageCounter(usage_counter);
+      }
+    }
   }
 
   if (FLAG_trace_compilation_trace) {
@@ -316,6 +376,302 @@ RawObject* CompilationTraceLoader::EvaluateInitializer(const Field& field) {
   return Object::null();
 }
 
+TypeFeedbackSaver::TypeFeedbackSaver(Zone* zone)
+    : zone_(zone),
+      buf_(zone, 4 * KB),
+      name_(String::Handle(zone)),
+      cls_(Class::Handle(zone)),
+      lib_(Library::Handle(zone)),
+      uri_(String::Handle(zone)),
+      ic_data_array_(Array::Handle(zone)),
+      edge_counters_(Array::Handle(zone)),
+      ic_data_(ICData::Handle(zone)),
+      unary_checks_(ICData::Handle(zone)) {}
+
+void TypeFeedbackSaver::WriteClass(const Class& cls) {
+  name_ = cls.Name();
+  name_ = String::RemovePrivateKey(name_);
+  lib_ = cls.library();
+  uri_ = lib_.url();
+  buf_.Printf(",%s,%s", uri_.ToCString(), name_.ToCString());
+}
+
+// The feedback of a function is written as
+//
+//   F,<library uri>,<class name>,<function name>
+//   E,<edge count>,...
+//   I,<deopt id>,<selector>,<count>,<library uri>,<class name>,<count>,...
+//   S,<deopt id>,<selector>,<count>
+//
+// with a line per instance call (I) and static call (S).
+void TypeFeedbackSaver::Visit(const Function& function) {
+  if (function.parent_function() != Function::null()) {
+    // Local functions cannot be looked up by name.
+    return;
+  }
+  ic_data_array_ = function.ic_data_array();
+  if (ic_data_array_.IsNull()) {
+    return;  // Not compiled.
+  }
+
+  cls_ = function.Owner();
+  name_ = function.name();
+  name_ = String::RemovePrivateKey(name_);
+  const char* function_name = name_.ToCString();
+  buf_.AddString("F");
+  WriteClass(cls_);
+  buf_.Printf(",%s\n", function_name);
+
+  if (ic_data_array_.At(0) != Object::null()) {
+    edge_counters_ ^= ic_data_array_.At(0);
+    buf_.AddString("E");
+    for (intptr_t i = 0; i < edge_counters_.Length(); i++) {
+      buf_.Printf(",%" Pd, Smi::Value(Smi::RawCast(edge_counters_.At(i))));
+    }
+    buf_.AddString("\n");
+  }
+
+  for (intptr_t i = 1; i < ic_data_array_.Length(); i++) {
+    ic_data_ ^= ic_data_array_.At(i);
+    const intptr_t count = ic_data_.AggregateCount();
+    if (count == 0) {
+      continue;
+    }
+    name_ = ic_data_.target_name();
+    name_ = String::RemovePrivateKey(name_);
+    if (ic_data_.is_static_call()) {
+      buf_.Printf("S,%" Pd ",%s,%" Pd "\n", ic_data_.deopt_id(),
+                  name_.ToCString(), count);
+      continue;
+    }
+    if (ic_data_.NumArgsTested() == 0) {
+      continue;
+    }
+    buf_.Printf("I,%" Pd ",%s,%" Pd, ic_data_.deopt_id(), name_.ToCString(),
+                count);
+    unary_checks_ = ic_data_.AsUnaryClassChecks();
+    for (intptr_t j = 0; j < unary_checks_.NumberOfChecks(); j++) {
+      cls_ = Isolate::Current()->class_table()->At(
+          unary_checks_.GetReceiverClassIdAt(j));
+      WriteClass(cls_);
+      buf_.Printf(",%" Pd, unary_checks_.GetCountAt(j));
+    }
+    buf_.AddString("\n");
+  }
+}
+
+const FunctionTypeFeedback::Call* FunctionTypeFeedback::LookupCall(
+    intptr_t deopt_id) const {
+  intptr_t lo = 0;
+  intptr_t hi = calls.length() - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (calls[mid]->deopt_id < deopt_id) {
+      lo = mid + 1;
+    } else if (calls[mid]->deopt_id > deopt_id) {
+      hi = mid - 1;
+    } else {
+      return calls[mid];
+    }
+  }
+  return NULL;
+}
+
+TypeFeedbackLoader::TypeFeedbackLoader(Thread* thread)
+    : thread_(thread),
+      zone_(thread->zone()),
+      uri_(String::Handle(zone_)),
+      class_name_(String::Handle(zone_)),
+      function_name_(String::Handle(zone_)),
+      lib_(Library::Handle(zone_)),
+      cls_(Class::Handle(zone_)),
+      function_(Function::Handle(zone_)),
+      feedback_() {}
+
+RawClass* TypeFeedbackLoader::LookupClass(const char* uri_cstr,
+                                          const char* cls_cstr) {
+  uri_ = Symbols::New(thread_, uri_cstr);
+  class_name_ = Symbols::New(thread_, cls_cstr);
+  lib_ = Library::LookupLibrary(thread_, uri_);
+  if (lib_.IsNull()) {
+    return Class::null();
+  }
+  if (class_name_.Equals(Symbols::TopLevel())) {
+    return lib_.toplevel_class();
+  }
+  return lib_.SlowLookupClassAllowMultiPartPrivate(class_name_);
+}
+
+RawFunction* TypeFeedbackLoader::LookupFunction(const char* uri_cstr,
+                                                const char* cls_cstr,
+                                                const char* func_cstr) {
+  cls_ = LookupClass(uri_cstr, cls_cstr);
+  if (cls_.IsNull() || !cls_.is_finalized()) {
+    return Function::null();
+  }
+  function_name_ = Symbols::New(thread_, func_cstr);
+  if (cls_.IsTopLevel()) {
+    return lib_.LookupFunctionAllowPrivate(function_name_);
+  }
+  return cls_.LookupFunctionAllowPrivate(function_name_);
+}
+
+static intptr_t ParseCount(const char* str) {
+  return static_cast<intptr_t>(strtoll(str, NULL, 10));
+}
+
+RawObject* TypeFeedbackLoader::LoadFeedback(uint8_t* buffer, intptr_t size) {
+  char* cursor = reinterpret_cast<char*>(buffer);
+  char* limit = cursor + size;
+  GrowableArray<char*> fields;
+  FunctionTypeFeedback* current = NULL;
+  intptr_t num_functions = 0;
+  while (cursor < limit) {
+    char* newline = FindCharacter(cursor, '\n', limit);
+    if (newline == NULL) {
+      break;
+    }
+    *newline = 0;
+    fields.Clear();
+    fields.Add(cursor);
+    for (char* comma = FindCharacter(cursor, ',', newline); comma != NULL;
+         comma = FindCharacter(comma + 1, ',', newline)) {
+      *comma = 0;
+      fields.Add(comma + 1);
+    }
+    cursor = newline + 1;
+
+    const char* kind = fields[0];
+    if (strcmp(kind, "F") == 0) {
+      if (fields.length() != 4) {
+        return ApiError::New(String::Handle(
+            zone_, String::New("Malformed type feedback: function")));
+      }
+      current = NULL;
+      function_ = LookupFunction(fields[1], fields[2], fields[3]);
+      if (function_.IsNull()) {
+        if (FLAG_trace_type_feedback) {
+          THR_Print("Type feedback: missing %s,%s,%s\n", fields[1],
+                    fields[2], fields[3]);
+        }
+        continue;
+      }
+      if (feedback_.LookupValue(&function_) != NULL) {
+        continue;  // Overloaded after removing private keys.
+      }
+      current = new (zone_)
+          FunctionTypeFeedback(Function::ZoneHandle(zone_, function_.raw()));
+      feedback_.Insert(current);
+      num_functions++;
+    } else if (current == NULL) {
+      continue;
+    } else if (strcmp(kind, "E") == 0) {
+      const Array& counters = Array::ZoneHandle(
+          zone_, Array::New(fields.length() - 1, Heap::kOld));
+      Smi& count = Smi::Handle(zone_);
+      for (intptr_t i = 1; i < fields.length(); i++) {
+        count = Smi::New(ParseCount(fields[i]));
+        counters.SetAt(i - 1, count);
+      }
+      current->edge_counters = &counters;
+    } else if ((strcmp(kind, "I") == 0) || (strcmp(kind, "S") == 0)) {
+      if ((fields.length() < 4) || ((fields.length() - 4) % 3 != 0)) {
+        return ApiError::New(String::Handle(
+            zone_, String::New("Malformed type feedback: call")));
+      }
+      FunctionTypeFeedback::Call* call = new (zone_) FunctionTypeFeedback::Call(
+          ParseCount(fields[1]),
+          String::ZoneHandle(zone_, Symbols::New(thread_, fields[2])),
+          ParseCount(fields[3]));
+      for (intptr_t i = 4; i < fields.length(); i += 3) {
+        cls_ = LookupClass(fields[i], fields[i + 1]);
+        if (cls_.IsNull() || !cls_.is_finalized()) {
+          continue;
+        }
+        FunctionTypeFeedback::Receiver receiver = {cls_.id(),
+                                                   ParseCount(fields[i + 2])};
+        call->receivers.Add(receiver);
+      }
+      current->calls.Add(call);
+    }
+  }
+  if (FLAG_trace_type_feedback) {
+    THR_Print("Type feedback: loaded %" Pd " functions\n", num_functions);
+  }
+  return Object::null();
+}
+
+StartupTraceLoader::StartupTraceLoader(Thread* thread)
+    : thread_(thread),
+      zone_(thread->zone()),
+      uri_(String::Handle(zone_)),
+      class_name_(String::Handle(zone_)),
+      function_name_(String::Handle(zone_)),
+      lib_(Library::Handle(zone_)),
+      cls_(Class::Handle(zone_)),
+      function_(Function::Handle(zone_)) {}
+
+RawFunction* StartupTraceLoader::LookupFunction(const char* uri_cstr,
+                                                const char* cls_cstr,
+                                                const char* func_cstr) {
+  uri_ = Symbols::New(thread_, uri_cstr);
+  lib_ = Library::LookupLibrary(thread_, uri_);
+  if (lib_.IsNull()) {
+    return Function::null();
+  }
+  function_name_ = Symbols::New(thread_, func_cstr);
+  class_name_ = Symbols::New(thread_, cls_cstr);
+  if (class_name_.Equals(Symbols::TopLevel())) {
+    return lib_.LookupFunctionAllowPrivate(function_name_);
+  }
+  cls_ = lib_.SlowLookupClassAllowMultiPartPrivate(class_name_);
+  if (cls_.IsNull() || !cls_.is_finalized()) {
+    return Function::null();
+  }
+  return cls_.LookupFunctionAllowPrivate(function_name_);
+}
+
+void StartupTraceLoader::LoadTrace(uint8_t* buffer,
+                                   intptr_t size,
+                                   ZoneGrowableArray<Object*>* code) {
+  char* cursor = reinterpret_cast<char*>(buffer);
+  char* limit = cursor + size;
+  while (cursor < limit) {
+    char* newline = FindCharacter(cursor, '\n', limit);
+    if (newline == NULL) {
+      break;
+    }
+    *newline = 0;
+    char* uri = cursor;
+    cursor = newline + 1;
+    char* comma1 = FindCharacter(uri, ',', newline);
+    if (comma1 == NULL) {
+      continue;
+    }
+    *comma1 = 0;
+    char* cls_name = comma1 + 1;
+    char* comma2 = FindCharacter(cls_name, ',', newline);
+    if (comma2 == NULL) {
+      continue;
+    }
+    *comma2 = 0;
+    char* func_name = comma2 + 1;
+    char* comma3 = FindCharacter(func_name, ',', newline);
+    if (comma3 != NULL) {
+      *comma3 = 0;  // Drop the fingerprint.
+    }
+    function_ = LookupFunction(uri, cls_name, func_name);
+    if (function_.IsNull() || !function_.HasCode()) {
+      if (FLAG_trace_compilation_trace) {
+        THR_Print("Startup trace: missing %s,%s,%s\n", uri, cls_name,
+                  func_name);
+      }
+      continue;
+    }
+    code->Add(&Code::ZoneHandle(zone_, function_.CurrentCode()));
+  }
+}
+
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
 }  // namespace dart
@@ -7,6 +7,7 @@
 
 #include "platform/assert.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/hash_map.h"
 #include "vm/object.h"
 #include "vm/program_visitor.h"
 #include "vm/zone_text_buffer.h"
@@ -41,7 +42,9 @@ class CompilationTraceLoader : public ValueObject {
  private:
   RawObject* CompileTriple(const char* uri_cstr,
                            const char* cls_cstr,
-                           const char* func_cstr);
+                           const char* func_cstr,
+                           int32_t fingerprint,
+                           bool was_optimized);
   RawObject* CompileFunction(const Function& function);
   RawObject* EvaluateInitializer(const Field& field);
 
@@ -59,6 +62,151 @@ class CompilationTraceLoader : public ValueObject {
   Object& error_;
 };
 
+// Records the type feedback of all compiled functions: the receiver classes
+// seen by instance calls, the call counts of static calls and the edge
+// counters. Functions and classes are recorded by name, so that the feedback
+// of a profiling run can guide the precompilation of the same program.
+class TypeFeedbackSaver : public FunctionVisitor {
+ public:
+  explicit TypeFeedbackSaver(Zone* zone);
+  void Visit(const Function& function);
+
+  void StealBuffer(uint8_t** buffer, intptr_t* buffer_length) {
+    *buffer = reinterpret_cast<uint8_t*>(buf_.buffer());
+    *buffer_length = buf_.length();
+  }
+
+ private:
+  void WriteClass(const Class& cls);
+
+  Zone* zone_;
+  ZoneTextBuffer buf_;
+  String& name_;
+  Class& cls_;
+  Library& lib_;
+  String& uri_;
+  Array& ic_data_array_;
+  Array& edge_counters_;
+  ICData& ic_data_;
+  ICData& unary_checks_;
+};
+
+// The type feedback of one function, see TypeFeedbackSaver.
+class FunctionTypeFeedback : public ZoneAllocated {
+ public:
+  struct Receiver {
+    intptr_t cid;
+    intptr_t count;
+  };
+
+  class Call : public ZoneAllocated {
+   public:
+    Call(intptr_t deopt_id, const String& selector, intptr_t count)
+        : deopt_id(deopt_id), selector(selector), count(count) {}
+
+    const intptr_t deopt_id;
+    // Without the private key.
+    const String& selector;
+    const intptr_t count;
+    // Empty for static calls.
+    GrowableArray<Receiver> receivers;
+  };
+
+  explicit FunctionTypeFeedback(const Function& function)
+      : function(function), edge_counters(NULL) {}
+
+  // Returns the call with the given deopt id, or NULL.
+  const Call* LookupCall(intptr_t deopt_id) const;
+
+  const Function& function;
+  // Smi counts indexed by the preorder number of the blocks.
+  const Array* edge_counters;
+  // Sorted by deopt id.
+  GrowableArray<Call*> calls;
+};
+
+class FunctionTypeFeedbackTrait {
+ public:
+  typedef const Function* Key;
+  typedef FunctionTypeFeedback* Value;
+  typedef FunctionTypeFeedback* Pair;
+
+  static Key KeyOf(Pair kv) { return &kv->function; }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline intptr_t Hashcode(Key key) {
+    // Synthetic token positions are negative.
+    return ((key->kernel_offset() > 0) ? key->kernel_offset()
+                                       : key->token_pos().value()) &
+           kSmiMax;
+  }
+
+  static inline bool IsKeyEqual(Pair kv, Key key) {
+    return kv->function.raw() == key->raw();
+  }
+};
+
+// Reads the output of TypeFeedbackSaver. Class ids are resolved when the
+// feedback is loaded, so it must be loaded after the classes were sorted.
+class TypeFeedbackLoader : public ZoneAllocated {
+ public:
+  explicit TypeFeedbackLoader(Thread* thread);
+
+  // Returns an error if the buffer is malformed. Functions and classes
+  // that no longer exist are ignored.
+  RawObject* LoadFeedback(uint8_t* buffer, intptr_t buffer_length);
+
+  // Returns the feedback recorded for the function, or NULL.
+  const FunctionTypeFeedback* FeedbackFor(const Function& function) {
+    return feedback_.LookupValue(&function);
+  }
+
+ private:
+  RawFunction* LookupFunction(const char* uri_cstr,
+                              const char* cls_cstr,
+                              const char* func_cstr);
+  RawClass* LookupClass(const char* uri_cstr, const char* cls_cstr);
+
+  Thread* thread_;
+  Zone* zone_;
+  String& uri_;
+  String& class_name_;
+  String& function_name_;
+  Library& lib_;
+  Class& cls_;
+  Function& function_;
+  DirectChainedHashMap<FunctionTypeFeedbackTrait> feedback_;
+};
+
+// Reads a startup trace, as saved by Dart_SaveStartupTrace. It has the
+// format of a compilation trace, with the functions in the order in which
+// they were first called.
+class StartupTraceLoader : public ValueObject {
+ public:
+  explicit StartupTraceLoader(Thread* thread);
+
+  // Adds the current code of the traced functions to 'code', in the order of
+  // the trace. Functions that no longer exist or have no code are skipped.
+  void LoadTrace(uint8_t* buffer,
+                 intptr_t buffer_length,
+                 ZoneGrowableArray<Object*>* code);
+
+ private:
+  RawFunction* LookupFunction(const char* uri_cstr,
+                              const char* cls_cstr,
+                              const char* func_cstr);
+
+  Thread* thread_;
+  Zone* zone_;
+  String& uri_;
+  String& class_name_;
+  String& function_name_;
+  Library& lib_;
+  Class& cls_;
+  Function& function_;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_COMPILATION_TRACE_H_
@@ -34,8 +34,14 @@ namespace dart {
 DEFINE_FLAG(int,
             max_exhaustive_polymorphic_checks,
             5,
-            "If a call receiver is known to be of at most this many classes, "
-            "generate exhaustive class tests instead of a megamorphic call");
+            "If the classes a call receiver is known to be of dispatch to "
+            "their targets in at most this many class id ranges, generate "
+            "exhaustive class id range tests instead of a megamorphic call");
+DEFINE_FLAG(int,
+            max_exhaustive_polymorphic_classes,
+            100,
+            "Only generate exhaustive class id range tests for calls whose "
+            "receiver is known to be of at most this many classes");
 
 // Quick access to the current isolate and zone.
 #define I (isolate())
@@ -950,7 +956,7 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
 
           // The call does not resolve to a single target within the hierarchy.
           // If we have too many subclasses abort the optimization.
-          if (class_ids.length() > FLAG_max_exhaustive_polymorphic_checks) {
+          if (class_ids.length() > FLAG_max_exhaustive_polymorphic_classes) {
             single_target = Function::null();
             break;
           }
@@ -998,12 +1004,18 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
         return;
       } else if ((ic_data.raw() != ICData::null()) &&
                  !ic_data.NumberOfChecksIs(0)) {
+        // Classes are sorted so that subclasses have the class ids following
+        // their superclass, so the classes of a hierarchy that inherit the
+        // same override usually merge into a few class id ranges, each of
+        // which is tested with at most two comparisons.
         CallTargets* targets = CallTargets::Create(Z, ic_data);
-        PolymorphicInstanceCallInstr* call =
-            new (Z) PolymorphicInstanceCallInstr(instr, *targets,
-                                                 /* complete = */ true);
-        instr->ReplaceWith(call, current_iterator());
-        return;
+        if (targets->length() <= FLAG_max_exhaustive_polymorphic_checks) {
+          PolymorphicInstanceCallInstr* call =
+              new (Z) PolymorphicInstanceCallInstr(instr, *targets,
+                                                   /* complete = */ true);
+          instr->ReplaceWith(call, current_iterator());
+          return;
+        }
       }
     }
 
@@ -6,9 +6,11 @@
 
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph.h"
@@ -58,6 +60,11 @@ namespace dart {
 
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynamic targets");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(charp,
+            load_type_feedback,
+            NULL,
+            "Guide compilation with type feedback saved by "
+            "Dart_SaveTypeFeedback.");
 DEFINE_FLAG(
     int,
     max_speculative_inlining_attempts,
@@ -175,6 +182,7 @@ Precompiler::Precompiler(Thread* thread)
       types_to_retain_(),
       consts_to_retain_(),
       error_(Error::Handle()),
+      type_feedback_(NULL),
       get_runtime_type_is_unique_(false) {}
 
 void Precompiler::DoCompileAll() {
@@ -194,6 +202,9 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // Class ids in the feedback are resolved after sorting.
+      LoadTypeFeedback();
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -2185,6 +2196,135 @@ void Precompiler::Obfuscate() {
   I->object_store()->set_obfuscation_map(Array::Handle(Z));
 }
 
+void Precompiler::LoadTypeFeedback() {
+  if (FLAG_load_type_feedback == NULL) {
+    return;
+  }
+  Dart_FileOpenCallback file_open = Dart::file_open_callback();
+  Dart_FileReadCallback file_read = Dart::file_read_callback();
+  Dart_FileCloseCallback file_close = Dart::file_close_callback();
+  if ((file_open == NULL) || (file_read == NULL) || (file_close == NULL)) {
+    error_ = ApiError::New(String::Handle(
+        Z, String::New("Cannot read type feedback without file callbacks")));
+    Jump(error_);
+  }
+  void* file = file_open(FLAG_load_type_feedback, /*write=*/false);
+  if (file == NULL) {
+    error_ = ApiError::New(String::Handle(
+        Z, String::NewFormatted("Cannot open type feedback %s",
+                                FLAG_load_type_feedback)));
+    Jump(error_);
+  }
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = -1;
+  file_read(&buffer, &buffer_length, file);
+  file_close(file);
+  if ((buffer == NULL) || (buffer_length < 0)) {
+    error_ = ApiError::New(String::Handle(
+        Z, String::NewFormatted("Cannot read type feedback %s",
+                                FLAG_load_type_feedback)));
+    Jump(error_);
+  }
+
+  type_feedback_ = new (Z) TypeFeedbackLoader(T);
+  const Object& result =
+      Object::Handle(Z, type_feedback_->LoadFeedback(buffer, buffer_length));
+  free(buffer);
+  if (result.IsError()) {
+    error_ ^= result.raw();
+    Jump(error_);
+  }
+}
+
+void Precompiler::ApplyTypeFeedback(FlowGraph* flow_graph) {
+  if (type_feedback_ == NULL) {
+    return;
+  }
+  const Function& function = flow_graph->function();
+  const FunctionTypeFeedback* feedback = type_feedback_->FeedbackFor(function);
+  if (feedback == NULL) {
+    return;
+  }
+
+  // The feedback refers to blocks by preorder number and to calls by deopt
+  // id. These match as long as the flow graph builder produces the same
+  // graph as in the profiling run, so blocks are only used if their number
+  // matches and calls only if their selector does.
+  if ((feedback->edge_counters != NULL) &&
+      (feedback->edge_counters->Length() == flow_graph->preorder().length())) {
+    BlockScheduler block_scheduler(flow_graph);
+    block_scheduler.AssignEdgeWeights(*feedback->edge_counters);
+  }
+
+  Zone* zone = flow_graph->zone();
+  Class& cls = Class::Handle(zone);
+  Function& target = Function::Handle(zone);
+  String& name = String::Handle(zone);
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      if (InstanceCallInstr* call = instr->AsInstanceCall()) {
+        const FunctionTypeFeedback::Call* entry =
+            feedback->LookupCall(call->deopt_id());
+        if (call->HasICData() || (entry == NULL)) {
+          continue;
+        }
+        name = String::RemovePrivateKey(call->function_name());
+        if (!name.Equals(entry->selector)) {
+          continue;
+        }
+        const Array& arguments_descriptor =
+            Array::Handle(zone, call->GetArgumentsDescriptor());
+        const ICData& ic_data = ICData::ZoneHandle(
+            zone, ICData::New(function, call->function_name(),
+                              arguments_descriptor, call->deopt_id(),
+                              /* args_tested = */ 1, ICData::kInstance));
+        for (intptr_t i = 0; i < entry->receivers.length(); i++) {
+          const FunctionTypeFeedback::Receiver& receiver =
+              entry->receivers[i];
+          cls = I->class_table()->At(receiver.cid);
+          // See AotCallSpecializer::VisitInstanceCall on why lazily added
+          // functions are not used as targets.
+          target = call->ResolveForReceiverClass(cls, /*allow_add=*/false);
+          if (target.IsNull() || target.IsMethodExtractor() ||
+              target.IsInvokeFieldDispatcher()) {
+            continue;
+          }
+          ic_data.AddReceiverCheck(receiver.cid, target, receiver.count);
+        }
+        if (ic_data.NumberOfChecks() > 0) {
+          call->set_ic_data(&ic_data);
+        }
+      } else if (StaticCallInstr* call = instr->AsStaticCall()) {
+        const FunctionTypeFeedback::Call* entry =
+            feedback->LookupCall(call->deopt_id());
+        if (call->HasICData() || (entry == NULL)) {
+          continue;
+        }
+        const Function& callee = call->function();
+        name = callee.name();
+        name = String::RemovePrivateKey(name);
+        if (!name.Equals(entry->selector)) {
+          continue;
+        }
+        const Array& arguments_descriptor =
+            Array::Handle(zone, call->GetArgumentsDescriptor());
+        const ICData& ic_data = ICData::ZoneHandle(
+            zone,
+            ICData::New(function, String::Handle(zone, callee.name()),
+                        arguments_descriptor, call->deopt_id(),
+                        MethodRecognizer::NumArgsCheckedForStaticCall(callee),
+                        ICData::kStatic));
+        ic_data.AddTarget(callee);
+        ic_data.SetCountAt(0, entry->count);
+        call->set_ic_data(&ic_data);
+      }
+    }
+  }
+}
+
 void Precompiler::FinalizeAllClasses() {
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
@@ -2313,6 +2453,9 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
       }
 
       if (optimized()) {
+        if (precompiler_ != NULL) {
+          precompiler_->ApplyTypeFeedback(flow_graph);
+        }
         flow_graph->PopulateWithICData(parsed_function()->function());
       }
 
@@ -2325,9 +2468,15 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         FlowGraphPrinter::PrintGraph("Unoptimized Compilation", flow_graph);
       }
 
+      // There are no edge counters in AOT, the scheduler only moves cold
+      // blocks out of the way.
+      BlockScheduler block_scheduler(flow_graph);
       CompilerPassState pass_state(thread(), flow_graph, &speculative_policy,
                                    precompiler_);
       NOT_IN_PRODUCT(pass_state.compiler_timeline = compiler_timeline);
+      pass_state.block_scheduler = &block_scheduler;
+      pass_state.reorder_blocks =
+          FlowGraph::ShouldReorderBlocks(function, optimized());
 
       if (optimized()) {
 #ifndef PRODUCT
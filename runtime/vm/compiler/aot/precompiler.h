@@ -26,6 +26,7 @@ class ParsedJSONArray;
 class Precompiler;
 class FlowGraph;
 class PrecompilerEntryPointsPrinter;
+class TypeFeedbackLoader;
 
 class TypeRangeCache : public ValueObject {
  public:
@@ -248,6 +249,11 @@ class Precompiler : public ValueObject {
     return get_runtime_type_is_unique_;
   }
 
+  // Attaches the receiver classes and call counts recorded for the
+  // function of the freshly built flow graph to its calls, and assigns
+  // edge weights from the recorded edge counters.
+  void ApplyTypeFeedback(FlowGraph* flow_graph);
+
  private:
   explicit Precompiler(Thread* thread);
 
@@ -300,6 +306,8 @@ class Precompiler : public ValueObject {
 
   void FinalizeAllClasses();
 
+  void LoadTypeFeedback();
+
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
   Isolate* isolate() const { return isolate_; }
@@ -332,6 +340,9 @@ class Precompiler : public ValueObject {
   InstanceSet consts_to_retain_;
   Error& error_;
 
+  // Feedback from --load-type-feedback, or NULL.
+  TypeFeedbackLoader* type_feedback_;
+
   bool get_runtime_type_is_unique_;
 };
 
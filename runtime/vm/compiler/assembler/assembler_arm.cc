@@ -2560,6 +2560,15 @@ void Assembler::CallNullErrorShared(bool save_fpu_registers) {
   blx(LR);
 }
 
+void Assembler::CallRangeErrorShared(bool save_fpu_registers) {
+  uword entry_point_offset =
+      save_fpu_registers
+          ? Thread::range_error_shared_with_fpu_regs_entry_point_offset()
+          : Thread::range_error_shared_without_fpu_regs_entry_point_offset();
+  ldr(LR, Address(THR, entry_point_offset));
+  blx(LR);
+}
+
 void Assembler::BranchLinkWithEquivalence(const StubEntry& stub_entry,
                                           const Object& equivalence,
                                           Code::EntryKind entry_kind) {
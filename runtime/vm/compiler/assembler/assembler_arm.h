@@ -707,6 +707,7 @@ class Assembler : public ValueObject {
   void BranchLinkToRuntime();
 
   void CallNullErrorShared(bool save_fpu_registers);
+  void CallRangeErrorShared(bool save_fpu_registers);
 
   // Branch and link to an entry address. Call sequence can be patched.
   void BranchLinkPatchable(
@@ -1395,6 +1395,7 @@ class Assembler : public ValueObject {
   void BranchLinkToRuntime();
 
   void CallNullErrorShared(bool save_fpu_registers);
+  void CallRangeErrorShared(bool save_fpu_registers);
 
   // Emit a call that shares its object pool entries with other calls
   // that have the same equivalence marker.
@@ -1477,6 +1478,11 @@ class Assembler : public ValueObject {
                        Register value,
                        CanBeSmi can_value_be_smi = kValueCanBeSmi,
                        bool lr_reserved = false);
+  void StoreIntoArray(Register object,
+                      Register slot,
+                      Register value,
+                      CanBeSmi can_value_be_smi = kValueCanBeSmi,
+                      bool lr_reserved = false);
   void StoreIntoObjectOffset(Register object,
                              int32_t offset,
                              Register value,
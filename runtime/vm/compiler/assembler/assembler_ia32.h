@@ -655,6 +655,7 @@ class Assembler : public ValueObject {
   void CallToRuntime();
 
   void CallNullErrorShared(bool save_fpu_registers) { UNREACHABLE(); }
+  void CallRangeErrorShared(bool save_fpu_registers) { UNREACHABLE(); }
 
   void Jmp(const StubEntry& stub_entry);
   void J(Condition condition, const StubEntry& stub_entry);
@@ -107,6 +107,14 @@ void Assembler::CallNullErrorShared(bool save_fpu_registers) {
   call(Address(THR, entry_point_offset));
 }
 
+void Assembler::CallRangeErrorShared(bool save_fpu_registers) {
+  uword entry_point_offset =
+      save_fpu_registers
+          ? Thread::range_error_shared_with_fpu_regs_entry_point_offset()
+          : Thread::range_error_shared_without_fpu_regs_entry_point_offset();
+  call(Address(THR, entry_point_offset));
+}
+
 void Assembler::pushq(Register reg) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitRegisterREX(reg, REX_NONE);
@@ -320,6 +328,30 @@ void Assembler::EmitL(int dst, int src, int opcode, int prefix2, int prefix1) {
   EmitRegisterOperand(dst & 7, src);
 }
 
+void Assembler::EmitVex(int dst, int src1, int src2, int opcode, int prefix) {
+  ASSERT(dst <= XMM15);
+  ASSERT(src1 <= XMM15);
+  ASSERT(src2 <= XMM15);
+  ASSERT(prefix == -1 || prefix == 0x66);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // The R, X and B bits and the vvvv register are stored inverted.
+  const uint8_t r = dst > 7 ? 0 : 0x80;
+  const uint8_t vvvv = ((~src1) & 0xF) << 3;
+  const uint8_t pp = prefix == 0x66 ? 0x01 : 0x00;
+  if (src2 <= 7) {
+    // Two-byte VEX, implied 0F opcode map and W = 0.
+    EmitUint8(0xC5);
+    EmitUint8(r | vvvv | pp);
+  } else {
+    // Three-byte VEX, needed for B. Opcode map 0F, W = 0.
+    EmitUint8(0xC4);
+    EmitUint8(r | 0x40 | 0x01);
+    EmitUint8(vvvv | pp);
+  }
+  EmitUint8(opcode);
+  EmitRegisterOperand(dst & 7, src2);
+}
+
 void Assembler::EmitW(Register dst,
                       Register src,
                       int opcode,
@@ -1323,6 +1355,47 @@ void Assembler::StoreIntoObject(Register object,
 #endif
 }
 
+void Assembler::StoreIntoArray(Register object,
+                               Register slot,
+                               Register value,
+                               CanBeSmi can_be_smi) {
+  ASSERT(object != TMP);
+  ASSERT(value != TMP);
+  ASSERT(slot != TMP);
+
+  movq(Address(slot, 0), value);
+
+  // In parallel, test whether
+  //  - object is old and not remembered and value is new, or
+  //  - object is old and value is old and not marked and concurrent marking is
+  //    in progress
+  // If so, call the WriteBarrier stub, which will either add object to the
+  // store buffer (case 1) or add value to the marking stack (case 2).
+  // Compare RawObject::StorePointer.
+  Label done;
+  if (can_be_smi == kValueCanBeSmi) {
+    testq(value, Immediate(kSmiTagMask));
+    j(ZERO, &done, kNearJump);
+  }
+  movb(TMP, FieldAddress(object, Object::tags_offset()));
+  shrl(TMP, Immediate(RawObject::kBarrierOverlapShift));
+  andl(TMP, Address(THR, Thread::write_barrier_mask_offset()));
+  testb(FieldAddress(value, Object::tags_offset()), TMP);
+  j(ZERO, &done, kNearJump);
+
+  if ((object != kWriteBarrierObjectReg) || (value != kWriteBarrierValueReg) ||
+      (slot != kWriteBarrierSlotReg)) {
+    // Spill and shuffle unimplemented. Currently StoreIntoArray is only used
+    // from StoreIndexInstr, which gets these exact registers from the register
+    // allocator.
+    UNIMPLEMENTED();
+  }
+
+  call(Address(THR, Thread::array_write_barrier_entry_point_offset()));
+
+  Bind(&done);
+}
+
 void Assembler::StoreIntoObjectNoBarrier(Register object,
                                          const Address& dest,
                                          Register value) {
@@ -426,6 +426,21 @@ class Assembler : public ValueObject {
 #undef AX
 #undef XA
 
+// Three-operand VEX forms, dst = src1 op src2. Only to be used when
+// TargetCPUFeatures::avx_supported().
+#define VX(name, ...)                                                          \
+  void name(XmmRegister dst, XmmRegister src1, XmmRegister src2) {             \
+    EmitVex(dst, src1, src2, __VA_ARGS__);                                     \
+  }
+#define DECLARE_VEX(name, code)                                                \
+  VX(v##name##ps, 0x50 + code)                                                 \
+  VX(v##name##pd, 0x50 + code, 0x66)
+  XMM_VEX_ALU_CODES(DECLARE_VEX)
+#undef DECLARE_VEX
+  VX(vsubpl, 0xFA, 0x66)
+  VX(vaddpl, 0xFE, 0x66)
+#undef VX
+
 #define DECLARE_CMPPS(name, code)                                              \
   void cmpps##name(XmmRegister dst, XmmRegister src) {                         \
     EmitL(dst, src, 0xC2, 0x0F);                                               \
@@ -698,6 +713,7 @@ class Assembler : public ValueObject {
   void CallToRuntime();
 
   void CallNullErrorShared(bool save_fpu_registers);
+  void CallRangeErrorShared(bool save_fpu_registers);
 
   // Emit a call that shares its object pool entries with other calls
   // that have the same equivalence marker.
@@ -726,6 +742,10 @@ class Assembler : public ValueObject {
                        const Address& dest,  // Where we are storing into.
                        Register value,       // Value we are storing.
                        CanBeSmi can_be_smi = kValueCanBeSmi);
+  void StoreIntoArray(Register object,  // Object we are storing into.
+                      Register slot,    // Where we are storing into.
+                      Register value,   // Value we are storing.
+                      CanBeSmi can_be_smi = kValueCanBeSmi);
 
   void StoreIntoObjectNoBarrier(Register object,
                                 const Address& dest,
@@ -1030,6 +1050,7 @@ class Assembler : public ValueObject {
              int prefix1 = -1);
   void EmitQ(int dst, int src, int opcode, int prefix2 = -1, int prefix1 = -1);
   void EmitL(int dst, int src, int opcode, int prefix2 = -1, int prefix1 = -1);
+  void EmitVex(int dst, int src1, int src2, int opcode, int prefix = -1);
   void EmitW(Register dst,
              Register src,
              int opcode,
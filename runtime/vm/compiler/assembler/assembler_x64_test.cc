@@ -6,6 +6,7 @@
 #if defined(TARGET_ARCH_X64)
 
 #include "vm/compiler/assembler/assembler.h"
+#include "vm/cpu.h"
 #include "vm/os.h"
 #include "vm/unit_test.h"
 #include "vm/virtual_memory.h"
@@ -3219,6 +3220,78 @@ ASSEMBLER_TEST_RUN(PackedDoubleSub, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(PackedDoubleAddVex, assembler) {
+  static const struct ALIGN16 {
+    double a;
+    double b;
+  } constant0 = {1.0, 2.0};
+  static const struct ALIGN16 {
+    double a;
+    double b;
+  } constant1 = {3.0, 4.0};
+  __ movq(RAX, Immediate(reinterpret_cast<uword>(&constant0)));
+  __ movups(XMM10, Address(RAX, 0));
+  __ movq(RAX, Immediate(reinterpret_cast<uword>(&constant1)));
+  __ movups(XMM11, Address(RAX, 0));
+  __ vaddpd(XMM0, XMM10, XMM11);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(PackedDoubleAddVex, test) {
+  if (TargetCPUFeatures::avx_supported()) {
+    typedef double (*PackedDoubleAddVex)();
+    double res = reinterpret_cast<PackedDoubleAddVex>(test->entry())();
+    EXPECT_FLOAT_EQ(4.0, res, 0.000001f);
+  }
+  EXPECT_DISASSEMBLY_ENDS_WITH(
+      "movups xmm11,[rax]\n"
+      "vaddpd xmm0,xmm10,xmm11\n"
+      "ret\n");
+}
+
+ASSEMBLER_TEST_GENERATE(PackedIntSubVex, assembler) {
+  static const struct ALIGN16 {
+    int32_t a;
+    int32_t b;
+    int32_t c;
+    int32_t d;
+  } constant0 = {10, 20, 30, 40};
+  static const struct ALIGN16 {
+    int32_t a;
+    int32_t b;
+    int32_t c;
+    int32_t d;
+  } constant1 = {3, 4, 5, 6};
+  __ movq(RAX, Immediate(reinterpret_cast<uword>(&constant0)));
+  __ movups(XMM1, Address(RAX, 0));
+  __ movq(RAX, Immediate(reinterpret_cast<uword>(&constant1)));
+  __ movups(XMM2, Address(RAX, 0));
+  __ vsubpl(XMM9, XMM1, XMM2);
+  __ vxorps(XMM3, XMM3, XMM3);
+  __ vaddpl(XMM0, XMM3, XMM9);
+  __ pushq(RAX);
+  __ movss(Address(RSP, 0), XMM0);
+  __ popq(RAX);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(PackedIntSubVex, test) {
+  if (TargetCPUFeatures::avx_supported()) {
+    typedef uint32_t (*PackedIntSubVex)();
+    uint32_t res = reinterpret_cast<PackedIntSubVex>(test->entry())();
+    EXPECT_EQ(static_cast<uword>(7), res);
+  }
+  EXPECT_DISASSEMBLY_ENDS_WITH(
+      "movups xmm2,[rax]\n"
+      "vpsubd xmm9,xmm1,xmm2\n"
+      "vxorps xmm3,xmm3,xmm3\n"
+      "vpaddd xmm0,xmm3,xmm9\n"
+      "push rax\n"
+      "movss [rsp],xmm0\n"
+      "pop rax\n"
+      "ret\n");
+}
+
 static void EnterTestFrame(Assembler* assembler) {
   COMPILE_ASSERT(THR != CallingConventions::kArg1Reg);
   COMPILE_ASSERT(CODE_REG != CallingConventions::kArg2Reg);
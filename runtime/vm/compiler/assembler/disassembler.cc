@@ -279,10 +279,13 @@ void Disassembler::DisassembleCodeHelper(const char* function_fullname,
   THR_Print("StackMaps for function '%s' {\n", function_fullname);
   if (code.stackmaps() != Array::null()) {
     const Array& stackmap_table = Array::Handle(zone, code.stackmaps());
+    Smi& offset = Smi::Handle(zone);
     StackMap& map = StackMap::Handle(zone);
-    for (intptr_t i = 0; i < stackmap_table.Length(); ++i) {
-      map ^= stackmap_table.At(i);
-      THR_Print("%s\n", map.ToCString());
+    for (intptr_t i = 0; i < stackmap_table.Length();
+         i += Code::kSMEntryLength) {
+      offset ^= stackmap_table.At(i + Code::kSMPcOffsetEntry);
+      map ^= stackmap_table.At(i + Code::kSMStackMapEntry);
+      THR_Print("%#05" Px ": %s\n", offset.Value(), map.ToCString());
     }
   }
   THR_Print("}\n");
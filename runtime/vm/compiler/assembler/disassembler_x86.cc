@@ -344,6 +344,7 @@ class DisassemblerX64 : public ValueObject {
   const char* TwoByteMnemonic(uint8_t opcode);
   int TwoByteOpcodeInstruction(uint8_t* data);
   int Print660F38Instruction(uint8_t* data);
+  int VexInstruction(uint8_t* data);
   void CheckPrintStop(uint8_t* data);
 
   int F6F7Instruction(uint8_t* data);
@@ -1229,6 +1230,47 @@ int DisassemblerX64::Print660F38Instruction(uint8_t* current) {
   }
 }
 
+// Handles the register-register VEX forms emitted by Assembler::EmitVex.
+int DisassemblerX64::VexInstruction(uint8_t* data) {
+  uint8_t* current = data + 1;
+  const bool three_byte = *data == 0xC4;
+  const bool vex_r = (*current & 0x80) == 0;
+  bool vex_b = false;
+  if (three_byte) {
+    vex_b = (*current & 0x20) == 0;
+    if ((*current & 0x1F) != 0x01) {
+      UnimplementedInstruction();
+    }
+    current++;
+  }
+  const int vvvv = (~(*current) >> 3) & 0xF;
+  const int pp = *current & 0x3;
+  current++;
+  const uint8_t opcode = *current++;
+  int mod, regop, rm;
+  get_modrm(*current, &mod, &regop, &rm);
+  regop = (regop & 7) | (vex_r ? 8 : 0);
+  rm = (rm & 7) | (vex_b ? 8 : 0);
+  if (mod != 3) {
+    UnimplementedInstruction();
+  }
+  current++;
+  const char* mnemonic = NULL;
+  if (0x54 <= opcode && opcode <= 0x5F && (pp == 0 || pp == 1)) {
+    mnemonic = pp == 0 ? xmm_instructions[opcode & 0xF].ps_name
+                       : xmm_instructions[opcode & 0xF].pd_name;
+  } else if (opcode == 0xFA && pp == 1) {
+    mnemonic = "psubd";
+  } else if (opcode == 0xFE && pp == 1) {
+    mnemonic = "paddd";
+  } else {
+    UnimplementedInstruction();
+  }
+  Print("v%s %s,%s,%s", mnemonic, NameOfXMMRegister(regop),
+        NameOfXMMRegister(vvvv), NameOfXMMRegister(rm));
+  return current - data;
+}
+
 // Called when disassembling test eax, 0xXXXXX.
 void DisassemblerX64::CheckPrintStop(uint8_t* data) {
 #if defined(TARGET_ARCH_IA32)
@@ -1650,6 +1692,11 @@ int DisassemblerX64::InstructionDecode(uword pc) {
         data += TwoByteOpcodeInstruction(data);
         break;
 
+      case 0xC4:  // fall through
+      case 0xC5:
+        data += VexInstruction(data);
+        break;
+
       case 0x8F: {
         data++;
         int mod, regop, rm;
@@ -14,10 +14,6 @@
 namespace dart {
 
 static intptr_t GetEdgeCount(const Array& edge_counters, intptr_t edge_id) {
-  if (!FLAG_reorder_basic_blocks) {
-    // Assume everything was visited once.
-    return 1;
-  }
   return Smi::Value(Smi::RawCast(edge_counters.At(edge_id)));
 }
 
@@ -70,7 +66,10 @@ void BlockScheduler::AssignEdgeWeights() const {
   }
   Array& edge_counters = Array::Handle();
   edge_counters ^= ic_data_array.At(0);
+  AssignEdgeWeights(edge_counters);
+}
 
+void BlockScheduler::AssignEdgeWeights(const Array& edge_counters) const {
   auto graph_entry = flow_graph()->graph_entry();
   BlockEntryInstr* entry = graph_entry->normal_entry();
   if (entry == nullptr) {
@@ -154,10 +153,115 @@ static void Union(GrowableArray<Chain*>* chains,
   }
 }
 
+// Edge weights are assigned from the edge counters of the JIT or from type
+// feedback in AOT.
+static bool HasEdgeWeights(FlowGraph* flow_graph) {
+  return flow_graph->graph_entry()->entry_count() > 0;
+}
+
+// Returns true if the block is a branch target that was never reached while
+// the other target was.
+static bool IsNeverTaken(BlockEntryInstr* block) {
+  TargetEntryInstr* target = block->AsTargetEntry();
+  if ((target == NULL) || (target->edge_weight() != 0.0) ||
+      (target->PredecessorCount() != 1)) {
+    return false;
+  }
+  BranchInstr* branch =
+      target->PredecessorAt(0)->last_instruction()->AsBranch();
+  if (branch == NULL) {
+    return false;
+  }
+  TargetEntryInstr* other = (branch->true_successor() == target)
+                                ? branch->false_successor()
+                                : branch->true_successor();
+  return other->edge_weight() > 0.0;
+}
+
+// Returns true if the block is known to be cold by itself: it throws,
+// deoptimizes unconditionally or, when edge counters are available, was
+// never reached.
+static bool IsColdBlock(BlockEntryInstr* block, bool use_edge_weights) {
+  if (block->IsGraphEntry() || block->IsFunctionEntry() ||
+      block->IsOsrEntry()) {
+    return false;
+  }
+  if (block->IsCatchBlockEntry()) {
+    return true;
+  }
+  if (use_edge_weights && IsNeverTaken(block)) {
+    return true;
+  }
+  for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsThrow() || current->IsReThrow() || current->IsStop() ||
+        current->IsDeoptimize()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Computes the blocks, by postorder number, which are only executed on
+// the way to a cold block or only reached from cold blocks.
+static void ComputeColdBlocks(FlowGraph* flow_graph,
+                              GrowableArray<bool>* cold) {
+  const GrowableArray<BlockEntryInstr*>& postorder = flow_graph->postorder();
+  const bool use_edge_weights = HasEdgeWeights(flow_graph);
+  for (intptr_t i = 0; i < postorder.length(); i++) {
+    cold->Add(FLAG_split_cold_code &&
+              IsColdBlock(postorder[i], use_edge_weights));
+  }
+  if (!FLAG_split_cold_code) {
+    return;
+  }
+
+  // Successors come first in postorder, except for loop headers, which are
+  // conservatively treated as hot.
+  for (intptr_t i = 0; i < postorder.length(); i++) {
+    BlockEntryInstr* block = postorder[i];
+    Instruction* last = block->last_instruction();
+    if ((*cold)[i] || (last->SuccessorCount() == 0) ||
+        block->IsGraphEntry() || block->IsFunctionEntry() ||
+        block->IsOsrEntry()) {
+      continue;
+    }
+    bool all_cold = true;
+    for (intptr_t j = 0; j < last->SuccessorCount(); j++) {
+      BlockEntryInstr* succ = last->SuccessorAt(j);
+      if ((succ->postorder_number() >= i) ||
+          !(*cold)[succ->postorder_number()]) {
+        all_cold = false;
+        break;
+      }
+    }
+    (*cold)[i] = all_cold;
+  }
+
+  // Blocks whose predecessors are all cold are cold as well.
+  for (intptr_t i = postorder.length() - 1; i >= 0; i--) {
+    BlockEntryInstr* block = postorder[i];
+    if ((*cold)[i] || (block->PredecessorCount() == 0) ||
+        block->IsFunctionEntry() || block->IsOsrEntry()) {
+      continue;
+    }
+    bool all_cold = true;
+    for (intptr_t j = 0; j < block->PredecessorCount(); j++) {
+      if (!(*cold)[block->PredecessorAt(j)->postorder_number()]) {
+        all_cold = false;
+        break;
+      }
+    }
+    (*cold)[i] = all_cold;
+  }
+}
+
 void BlockScheduler::ReorderBlocks() const {
   // Add every block to a chain of length 1 and compute a list of edges
   // sorted by weight.
   intptr_t block_count = flow_graph()->preorder().length();
+  GrowableArray<bool> cold(block_count);
+  ComputeColdBlocks(flow_graph(), &cold);
   GrowableArray<Edge> edges(2 * block_count);
 
   // A map from a block's postorder number to the chain it is in.  Used to
@@ -171,6 +275,10 @@ void BlockScheduler::ReorderBlocks() const {
     BlockEntryInstr* block = it.Current();
     chains.Add(new Chain(block));
 
+    // Without edge counters the blocks keep their reverse postorder.
+    if (!HasEdgeWeights(flow_graph())) {
+      continue;
+    }
     Instruction* last = block->last_instruction();
     for (intptr_t i = 0; i < last->SuccessorCount(); ++i) {
       BlockEntryInstr* succ = last->SuccessorAt(i);
@@ -193,8 +301,10 @@ void BlockScheduler::ReorderBlocks() const {
 
     // If the source and target are already in the same chain or if the
     // edge's source or target is not exposed at the appropriate end of a
-    // chain skip this edge.
+    // chain skip this edge. Hot and cold blocks are not chained together.
     if ((source_chain == target_chain) ||
+        (cold[edge.source->postorder_number()] !=
+         cold[edge.target->postorder_number()]) ||
         (edge.source != source_chain->last->block) ||
         (edge.target != target_chain->first->block)) {
       continue;
@@ -205,11 +315,16 @@ void BlockScheduler::ReorderBlocks() const {
 
   // Build a new block order.  Emit each chain when its first block occurs
   // in the original reverse postorder ordering (which gives a topological
-  // sort of the blocks).
-  for (intptr_t i = block_count - 1; i >= 0; --i) {
-    if (chains[i]->first->block == flow_graph()->postorder()[i]) {
-      for (Link* link = chains[i]->first; link != NULL; link = link->next) {
-        flow_graph()->CodegenBlockOrder(true)->Add(link->block);
+  // sort of the blocks).  The cold chains follow all of the hot ones, next
+  // to the slow paths and deoptimization stubs at the end of the code.
+  for (intptr_t pass = 0; pass < 2; ++pass) {
+    const bool emit_cold = (pass == 1);
+    for (intptr_t i = block_count - 1; i >= 0; --i) {
+      if ((cold[i] == emit_cold) &&
+          (chains[i]->first->block == flow_graph()->postorder()[i])) {
+        for (Link* link = chains[i]->first; link != NULL; link = link->next) {
+          flow_graph()->CodegenBlockOrder(true)->Add(link->block);
+        }
       }
     }
   }
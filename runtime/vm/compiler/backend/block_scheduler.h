@@ -9,6 +9,7 @@
 
 namespace dart {
 
+class Array;
 class FlowGraph;
 
 class BlockScheduler : public ValueObject {
@@ -17,8 +18,13 @@ class BlockScheduler : public ValueObject {
 
   FlowGraph* flow_graph() const { return flow_graph_; }
 
+  // Assigns edge weights from the edge counters of the unoptimized code.
   void AssignEdgeWeights() const;
 
+  // Assigns edge weights from edge counters indexed by the preorder number
+  // of the target block, e.g. recorded in a type feedback file.
+  void AssignEdgeWeights(const Array& edge_counters) const;
+
   void ReorderBlocks() const;
 
  private:
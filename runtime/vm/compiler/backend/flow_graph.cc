@@ -59,7 +59,8 @@ FlowGraph::FlowGraph(const ParsedFunction& parsed_function,
       await_token_positions_(nullptr),
       captured_parameters_(new (zone()) BitVector(zone(), variable_count())),
       inlining_id_(-1),
-      should_print_(FlowGraphPrinter::ShouldPrint(parsed_function.function())) {
+      should_print_(FlowGraphPrinter::ShouldPrint(parsed_function.function())),
+      intermediate_tier_(false) {
   DiscoverBlocks();
 }
 
@@ -123,7 +124,8 @@ void FlowGraph::AddToDeferredPrefixes(
 
 bool FlowGraph::ShouldReorderBlocks(const Function& function,
                                     bool is_optimized) {
-  return is_optimized && FLAG_reorder_basic_blocks && !function.is_intrinsic();
+  return is_optimized && (FLAG_reorder_basic_blocks || FLAG_split_cold_code) &&
+         !function.is_intrinsic();
 }
 
 GrowableArray<BlockEntryInstr*>* FlowGraph::CodegenBlockOrder(
@@ -373,6 +373,11 @@ class FlowGraph : public ZoneAllocated {
 
   bool should_print() const { return should_print_; }
 
+  // True if the graph is optimized by the intermediate tier, which runs a
+  // shorter pipeline and keeps counting invocations towards the full tier.
+  bool is_intermediate_tier() const { return intermediate_tier_; }
+  void set_intermediate_tier(bool value) { intermediate_tier_ = value; }
+
   //
   // High-level utilities.
   //
@@ -411,6 +416,8 @@ class FlowGraph : public ZoneAllocated {
   friend class ConstantPropagator;
   friend class DeadCodeElimination;
   friend class Intrinsifier;
+  friend class LoopUnroller;
+  friend class LoopVectorizer;
 
   // SSA transformation methods and fields.
   void ComputeDominators(GrowableArray<BitVector*>* dominance_frontier);
@@ -524,6 +531,7 @@ class FlowGraph : public ZoneAllocated {
 
   intptr_t inlining_id_;
   bool should_print_;
+  bool intermediate_tier_;
 };
 
 class LivenessAnalysis : public ValueObject {
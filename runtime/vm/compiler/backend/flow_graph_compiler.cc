@@ -192,6 +192,8 @@ void FlowGraphCompiler::InitCompiler() {
   // indicating a non-leaf routine and calls without IC data indicating
   // possible reoptimization.
 
+  // Intermediate tier code is always recompiled by the full tier.
+  may_reoptimize_ = is_optimizing() && flow_graph().is_intermediate_tier();
   for (int i = 0; i < block_order_.length(); ++i) {
     block_info_.Add(new (zone()) BlockInfo());
     if (is_optimizing() && !flow_graph().IsCompiledForOsr()) {
@@ -1764,7 +1766,9 @@ const ICData* FlowGraphCompiler::GetOrAddStaticCallICData(
 intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
   intptr_t threshold;
   if (is_optimizing()) {
-    threshold = FLAG_reoptimization_counter_threshold;
+    threshold = flow_graph().is_intermediate_tier()
+                    ? FLAG_optimization_counter_threshold
+                    : FLAG_reoptimization_counter_threshold;
   } else if (parsed_function_.function().IsIrregexpFunction()) {
     threshold = FLAG_regexp_optimization_counter_threshold;
   } else {
@@ -1775,6 +1779,10 @@ intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
     if (threshold > FLAG_optimization_counter_threshold) {
       threshold = FLAG_optimization_counter_threshold;
     }
+    if ((FLAG_intermediate_tier_threshold >= 0) &&
+        (threshold > FLAG_intermediate_tier_threshold)) {
+      threshold = FLAG_intermediate_tier_threshold;
+    }
   }
   return threshold;
 }
@@ -2241,7 +2249,9 @@ void ThrowErrorSlowPathCode::EmitNativeCode(FlowGraphCompiler* compiler) {
       instruction()->UseSharedSlowPathStub(compiler->is_optimizing());
   const bool live_fpu_registers =
       instruction()->locs()->live_registers()->FpuRegisterCount() > 0;
-  ASSERT(!use_shared_stub || num_args_ == 0);
+  // Shared stubs take their arguments in fixed registers and push them in
+  // their own frame, so nothing is pushed in this one.
+  const intptr_t num_pushed_args = use_shared_stub ? 0 : num_args_;
   __ Bind(entry_label());
   EmitCodeAtSlowPathEntry(compiler);
   LocationSummary* locs = instruction()->locs();
@@ -2249,7 +2259,7 @@ void ThrowErrorSlowPathCode::EmitNativeCode(FlowGraphCompiler* compiler) {
   if (!use_shared_stub) {
     compiler->SaveLiveRegisters(locs);
   }
-  for (intptr_t i = 0; i < num_args_; ++i) {
+  for (intptr_t i = 0; i < num_pushed_args; ++i) {
     __ PushRegister(locs->in(i).reg());
   }
   if (use_shared_stub) {
@@ -2267,11 +2277,11 @@ void ThrowErrorSlowPathCode::EmitNativeCode(FlowGraphCompiler* compiler) {
                           compiler->assembler()->CodeSize(), deopt_id,
                           instruction()->token_pos(), try_index_);
   AddMetadataForRuntimeCall(compiler);
-  compiler->RecordSafepoint(locs, num_args_);
+  compiler->RecordSafepoint(locs, num_pushed_args);
   if ((try_index_ != kInvalidTryIndex) ||
       (compiler->CurrentTryIndex() != kInvalidTryIndex)) {
     Environment* env =
-        compiler->SlowPathEnvironmentFor(instruction(), num_args_);
+        compiler->SlowPathEnvironmentFor(instruction(), num_pushed_args);
     compiler->RecordCatchEntryMoves(env, try_index_);
   }
   if (!use_shared_stub) {
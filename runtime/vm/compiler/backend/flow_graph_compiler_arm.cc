@@ -858,8 +858,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
     __ ldr(R3, FieldAddress(function_reg, Function::usage_counter_offset()));
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, except for intermediate
+    // tier code.
+    if (!is_optimizing() || flow_graph().is_intermediate_tier()) {
       __ add(R3, R3, Operand(1));
       __ str(R3, FieldAddress(function_reg, Function::usage_counter_offset()));
     }
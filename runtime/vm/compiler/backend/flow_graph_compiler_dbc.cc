@@ -316,7 +316,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
   if (CanOptimizeFunction() && function.IsOptimizable() &&
       (!is_optimizing() || may_reoptimize())) {
-    __ HotCheck(!is_optimizing(), GetOptimizationThreshold());
+    __ HotCheck(!is_optimizing() || flow_graph().is_intermediate_tier(),
+                GetOptimizationThreshold());
   }
 
   if (is_optimizing()) {
@@ -783,8 +783,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
     __ LoadObject(function_reg, function);
 
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, except for intermediate
+    // tier code.
+    if (!is_optimizing() || flow_graph().is_intermediate_tier()) {
       __ incl(FieldAddress(function_reg, Function::usage_counter_offset()));
     }
     __ cmpl(FieldAddress(function_reg, Function::usage_counter_offset()),
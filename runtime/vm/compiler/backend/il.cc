@@ -4505,6 +4505,13 @@ LocationSummary* GenericCheckBoundInstr::MakeLocationSummary(Zone* zone,
                                                              bool opt) const {
   const intptr_t kNumInputs = 2;
   const intptr_t kNumTemps = 0;
+  if (UseSharedSlowPathStub(opt)) {
+    LocationSummary* locs = new (zone) LocationSummary(
+        zone, kNumInputs, kNumTemps, LocationSummary::kCallOnSharedSlowPath);
+    locs->set_in(kLengthPos, Location::RegisterLocation(kRangeErrorLengthReg));
+    locs->set_in(kIndexPos, Location::RegisterLocation(kRangeErrorIndexReg));
+    return locs;
+  }
   LocationSummary* locs = new (zone) LocationSummary(
       zone, kNumInputs, kNumTemps, LocationSummary::kCallOnSlowPath);
   locs->set_in(kLengthPos, Location::RequiresRegister());
@@ -4523,6 +4530,11 @@ class RangeErrorSlowPath : public ThrowErrorSlowPathCode {
                                try_index) {}
 
   virtual const char* name() { return "check bound"; }
+
+  virtual void EmitSharedStubCall(Assembler* assembler,
+                                  bool save_fpu_registers) {
+    assembler->CallRangeErrorShared(save_fpu_registers);
+  }
 };
 
 void GenericCheckBoundInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
@@ -5061,6 +5073,8 @@ intptr_t InvokeMathCFunctionInstr::ArgumentCountFor(
     case MethodRecognizer::kMathAsin:
     case MethodRecognizer::kMathSin:
     case MethodRecognizer::kMathCos:
+    case MethodRecognizer::kMathExp:
+    case MethodRecognizer::kMathLog:
       return 1;
     case MethodRecognizer::kDoubleMod:
     case MethodRecognizer::kMathDoublePow:
@@ -5100,6 +5114,10 @@ const RuntimeEntry& InvokeMathCFunctionInstr::TargetFunction() const {
       return kLibcAtanRuntimeEntry;
     case MethodRecognizer::kMathAtan2:
       return kLibcAtan2RuntimeEntry;
+    case MethodRecognizer::kMathExp:
+      return kLibcExpRuntimeEntry;
+    case MethodRecognizer::kMathLog:
+      return kLibcLogRuntimeEntry;
     default:
       UNREACHABLE();
   }
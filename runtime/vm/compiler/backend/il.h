@@ -545,6 +545,7 @@ struct InstrAttrs {
   M(CheckedSmiOp, _)                                                           \
   M(BinaryInt32Op, kNoGC)                                                      \
   M(UnarySmiOp, kNoGC)                                                         \
+  M(SmiBitLength, kNoGC)                                                       \
   M(UnaryDoubleOp, kNoGC)                                                      \
   M(CheckStackOverflow, _)                                                     \
   M(SmiToDouble, kNoGC)                                                        \
@@ -1065,6 +1066,7 @@ class Instruction : public ZoneAllocated {
   // GetDeoptId and/or CopyDeoptIdFrom.
   friend class CallSiteInliner;
   friend class LICM;
+  friend class LoopUnroller;
   friend class ComparisonInstr;
   friend class Scheduler;
   friend class BlockEntryInstr;
@@ -4773,6 +4775,10 @@ class StoreIndexedInstr : public TemplateDefinition<3, NoThrow> {
            (emit_store_barrier_ == kEmitStoreBarrier);
   }
 
+  void set_emit_store_barrier(StoreBarrierType value) {
+    emit_store_barrier_ = value;
+  }
+
   virtual bool ComputeCanDeoptimize() const { return false; }
 
   virtual Representation RequiredInputRepresentation(intptr_t idx) const;
@@ -4794,7 +4800,7 @@ class StoreIndexedInstr : public TemplateDefinition<3, NoThrow> {
     return Assembler::kValueCanBeSmi;
   }
 
-  const StoreBarrierType emit_store_barrier_;
+  StoreBarrierType emit_store_barrier_;
   const intptr_t index_scale_;
   const intptr_t class_id_;
   const AlignmentType alignment_;
@@ -5125,7 +5131,20 @@ class CreateArrayInstr : public TemplateAllocation<2, Throws> {
   virtual AliasIdentity Identity() const { return identity_; }
   virtual void SetIdentity(AliasIdentity identity) { identity_ = identity; }
 
-  virtual bool WillAllocateNewOrRemembered() const { return true; }
+  // Large arrays are allocated in old space. They may be allocated black
+  // while the marker is running, so stores into them still need the barrier
+  // even though the allocation remembers them.
+  virtual bool WillAllocateNewOrRemembered() const {
+    if (!num_elements()->BindsToConstant()) {
+      return false;
+    }
+    const Object& length = num_elements()->BoundConstant();
+    if (!length.IsSmi()) {
+      return false;
+    }
+    const intptr_t value = Smi::Cast(length).Value();
+    return (value >= 0) && (value <= Array::kMaxNewSpaceElements);
+  }
 
  private:
   const TokenPosition token_pos_;
@@ -6250,6 +6269,27 @@ class UnarySmiOpInstr : public UnaryIntegerOpInstr {
   DISALLOW_COPY_AND_ASSIGN(UnarySmiOpInstr);
 };
 
+// Computes the bitLength of a Smi, using the count-leading-zeros (or bit
+// scan reverse) instruction of the target.
+class SmiBitLengthInstr : public TemplateDefinition<1, NoThrow, Pure> {
+ public:
+  explicit SmiBitLengthInstr(Value* value) { SetInputAt(0, value); }
+
+  Value* value() const { return inputs_[0]; }
+
+  DECLARE_INSTRUCTION(SmiBitLength)
+  virtual CompileType ComputeType() const;
+
+  virtual bool ComputeCanDeoptimize() const { return false; }
+
+  virtual void InferRange(RangeAnalysis* analysis, Range* range);
+
+  virtual bool AttributesEqual(Instruction* other) const { return true; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SmiBitLengthInstr);
+};
+
 class UnaryUint32OpInstr : public UnaryIntegerOpInstr {
  public:
   UnaryUint32OpInstr(Token::Kind op_kind, Value* value, intptr_t deopt_id)
@@ -7482,6 +7522,7 @@ class CheckArrayBoundInstr : public TemplateInstruction<2, NoThrow, Pure> {
   bool IsRedundant(const RangeBoundary& length);
 
   void mark_generalized() { generalized_ = true; }
+  bool generalized() const { return generalized_; }
 
   virtual Instruction* Canonicalize(FlowGraph* flow_graph);
 
@@ -7517,6 +7558,10 @@ class GenericCheckBoundInstr : public TemplateInstruction<2, Throws, NoCSE> {
 
   virtual bool HasUnknownSideEffects() const { return false; }
 
+  virtual bool UseSharedSlowPathStub(bool is_optimizing) const {
+    return SlowPathSharingSupported(is_optimizing);
+  }
+
   DECLARE_INSTRUCTION(GenericCheckBound)
 
   // GenericCheckBound can implicitly call Dart code (RangeError or
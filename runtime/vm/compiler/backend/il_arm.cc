@@ -5165,6 +5165,31 @@ void UnarySmiOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 }
 
+LocationSummary* SmiBitLengthInstr::MakeLocationSummary(Zone* zone,
+                                                        bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SmiBitLengthInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  ASSERT(kSmiTagShift == 1);
+  const Register value = locs()->in(0).reg();
+  const Register result = locs()->out(0).reg();
+  // XOR with sign bit to complement bits if value is negative. Setting the
+  // Smi tag bit makes the leading zero count of the tagged value one less
+  // than that of the untagged one, also when the latter is zero.
+  __ eor(result, value, Operand(value, ASR, 31));
+  __ orr(result, result, Operand(kSmiTagMask));
+  __ clz(result, result);
+  __ rsb(result, result, Operand(kBitsPerWord - 1));
+  __ SmiTag(result);
+}
+
 LocationSummary* UnaryDoubleOpInstr::MakeLocationSummary(Zone* zone,
                                                          bool opt) const {
   const intptr_t kNumInputs = 1;
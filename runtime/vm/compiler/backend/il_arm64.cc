@@ -1355,7 +1355,10 @@ Representation StoreIndexedInstr::RequiredInputRepresentation(
 LocationSummary* StoreIndexedInstr::MakeLocationSummary(Zone* zone,
                                                         bool opt) const {
   const intptr_t kNumInputs = 3;
-  const intptr_t kNumTemps = aligned() ? 0 : 2;
+  const intptr_t kNumTemps =
+      aligned() ? (((class_id() == kArrayCid) && ShouldEmitStoreBarrier()) ? 1
+                                                                            : 0)
+                : 2;
   LocationSummary* locs = new (zone)
       LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
   locs->set_in(0, Location::RequiresRegister());
@@ -1366,15 +1369,14 @@ LocationSummary* StoreIndexedInstr::MakeLocationSummary(Zone* zone,
   }
   switch (class_id()) {
     case kArrayCid:
-#if defined(CONCURRENT_MARKING)
-      locs->set_in(2, ShouldEmitStoreBarrier()
-                          ? Location::RegisterLocation(kWriteBarrierValueReg)
-                          : Location::RegisterOrConstant(value()));
-#else
-      locs->set_in(2, ShouldEmitStoreBarrier()
-                          ? Location::WritableRegister()
-                          : Location::RegisterOrConstant(value()));
-#endif
+      if (ShouldEmitStoreBarrier()) {
+        // Fixed registers of the array write barrier stub.
+        locs->set_in(0, Location::RegisterLocation(kWriteBarrierObjectReg));
+        locs->set_in(2, Location::RegisterLocation(kWriteBarrierValueReg));
+        locs->set_temp(0, Location::RegisterLocation(kWriteBarrierSlotReg));
+      } else {
+        locs->set_in(2, Location::RegisterOrConstant(value()));
+      }
       break;
     case kExternalTypedDataUint8ArrayCid:
     case kExternalTypedDataUint8ClampedArrayCid:
@@ -1445,8 +1447,19 @@ void StoreIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
       ASSERT(aligned());
       if (ShouldEmitStoreBarrier()) {
         const Register value = locs()->in(2).reg();
-        __ StoreIntoObject(array, element_address, value, CanValueBeSmi(),
-                           /*lr_reserved=*/!compiler->intrinsic_mode());
+        const Register slot = locs()->temp(0).reg();
+        if (index.IsRegister()) {
+          __ LoadElementAddressForRegIndex(slot,
+                                           false,  // Store.
+                                           IsExternal(), class_id(),
+                                           index_scale(), array, index.reg());
+        } else {
+          __ LoadElementAddressForIntIndex(slot, IsExternal(), class_id(),
+                                           index_scale(), array,
+                                           Smi::Cast(index.constant()).Value());
+        }
+        __ StoreIntoArray(array, slot, value, CanValueBeSmi(),
+                          /*lr_reserved=*/!compiler->intrinsic_mode());
       } else if (locs()->in(2).IsConstant()) {
         const Object& constant = locs()->in(2).constant();
         __ StoreIntoObjectNoBarrier(array, element_address, constant);
@@ -2218,8 +2231,7 @@ static void InlineArrayAllocation(FlowGraphCompiler* compiler,
   __ StoreIntoObjectNoBarrier(R0, FieldAddress(R0, Array::length_offset()),
                               kLengthReg);
 
-  // TODO(zra): Use stp once added.
-  // Initialize all array elements to raw_null.
+  // Initialize all array elements to raw_null, two at a time.
   // R0: new object start as a tagged pointer.
   // R3: new object end address.
   // R8: iterator which initially points to the start of the variable
@@ -2231,17 +2243,23 @@ static void InlineArrayAllocation(FlowGraphCompiler* compiler,
     __ AddImmediate(R8, R0, sizeof(RawArray) - kHeapObjectTag);
     if (array_size < (kInlineArraySize * kWordSize)) {
       intptr_t current_offset = 0;
-      while (current_offset < array_size) {
+      while (current_offset + kWordSize < array_size) {
+        __ stp(R6, R6, Address(R8, current_offset, Address::PairOffset));
+        current_offset += 2 * kWordSize;
+      }
+      if (current_offset < array_size) {
         __ str(R6, Address(R8, current_offset));
-        current_offset += kWordSize;
       }
     } else {
+      // Leave an even number of words for the loop.
+      if (!Utils::IsAligned(array_size, 2 * kWordSize)) {
+        __ str(R6, Address(R8, kWordSize, Address::PostIndex));
+      }
       Label end_loop, init_loop;
       __ Bind(&init_loop);
       __ CompareRegisters(R8, R3);
       __ b(&end_loop, CS);
-      __ str(R6, Address(R8));
-      __ AddImmediate(R8, kWordSize);
+      __ stp(R6, R6, Address(R8, 2 * kWordSize, Address::PairPostIndex));
       __ b(&init_loop);
       __ Bind(&end_loop);
     }
@@ -4423,6 +4441,32 @@ void UnarySmiOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 }
 
+LocationSummary* SmiBitLengthInstr::MakeLocationSummary(Zone* zone,
+                                                        bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SmiBitLengthInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  ASSERT(kSmiTagShift == 1);
+  const Register value = locs()->in(0).reg();
+  const Register result = locs()->out(0).reg();
+  // XOR with sign bit to complement bits if value is negative. Setting the
+  // Smi tag bit makes the leading zero count of the tagged value one less
+  // than that of the untagged one, also when the latter is zero.
+  __ eor(result, value, Operand(value, ASR, 63));
+  __ orri(result, result, Immediate(kSmiTagMask));
+  __ clz(result, result);
+  __ LoadImmediate(TMP, kBitsPerWord - 1);
+  __ sub(result, TMP, Operand(result));
+  __ SmiTag(result);
+}
+
 LocationSummary* UnaryDoubleOpInstr::MakeLocationSummary(Zone* zone,
                                                          bool opt) const {
   const intptr_t kNumInputs = 1;
@@ -5947,7 +5991,16 @@ void ComparisonInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Condition true_condition = EmitComparisonCode(compiler, labels);
   const Register result = this->locs()->out(0).reg();
 
-  // TODO(dartbug.com/29908): Use csel here for better branch prediction?
+  // Select the result without branching if the comparison is fully
+  // described by the condition flags.
+  if ((true_condition != kInvalidCondition) && is_true.IsUnused() &&
+      is_false.IsUnused()) {
+    __ LoadObject(result, Bool::True());
+    __ LoadObject(TMP, Bool::False());
+    __ csel(result, result, TMP, true_condition);
+    return;
+  }
+
   if (true_condition != kInvalidCondition) {
     EmitBranchOnCondition(compiler, true_condition, labels);
   }
@@ -5960,9 +6013,103 @@ void ComparisonInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Bind(&done);
 }
 
+static bool IsZeroConstant(Location loc) {
+  if (!loc.IsConstant()) {
+    return false;
+  }
+  ConstantInstr* constant = loc.constant_instruction();
+  if (constant->IsUnboxedSignedIntegerConstant()) {
+    return constant->GetUnboxedSignedIntegerConstantValue() == 0;
+  }
+  return constant->value().IsSmi() &&
+         (Smi::Cast(constant->value()).Value() == 0);
+}
+
+// Emits cbz/cbnz (bit < 0) or tbz/tbnz of the given bit of reg.
+static void EmitTestAndBranch(FlowGraphCompiler* compiler,
+                              Register reg,
+                              intptr_t bit,
+                              bool branch_if_zero,
+                              Label* label) {
+  if (bit < 0) {
+    if (branch_if_zero) {
+      __ cbz(label, reg);
+    } else {
+      __ cbnz(label, reg);
+    }
+  } else {
+    if (branch_if_zero) {
+      __ tbz(label, reg, bit);
+    } else {
+      __ tbnz(label, reg, bit);
+    }
+  }
+}
+
+// Branches on comparisons of a register against zero, and on tests of a
+// single bit, with a fused compare-and-branch instead of setting the flags.
+// Returns false if the comparison has neither form.
+static bool TryEmitFusedBranch(FlowGraphCompiler* compiler,
+                               ComparisonInstr* comparison,
+                               BranchLabels labels) {
+  LocationSummary* locs = comparison->locs();
+  Location left = locs->in(0);
+  Location right = locs->in(1);
+  bool is_equal;
+  intptr_t bit = -1;
+  if (comparison->IsTestSmi()) {
+    if (!right.IsConstant() || !left.IsRegister()) {
+      return false;
+    }
+    const uint64_t imm = reinterpret_cast<uint64_t>(right.constant().raw());
+    if (!Utils::IsPowerOfTwo(imm)) {
+      return false;
+    }
+    bit = Utils::ShiftForPowerOfTwo(imm);
+    is_equal = comparison->kind() == Token::kEQ;
+  } else {
+    if (EqualityCompareInstr* equality = comparison->AsEqualityCompare()) {
+      if ((equality->operation_cid() != kSmiCid) &&
+          (equality->operation_cid() != kMintCid)) {
+        return false;
+      }
+      is_equal = equality->kind() == Token::kEQ;
+    } else if (StrictCompareInstr* strict = comparison->AsStrictCompare()) {
+      if (strict->needs_number_check()) {
+        return false;
+      }
+      is_equal = strict->kind() == Token::kEQ_STRICT;
+    } else {
+      return false;
+    }
+    if (IsZeroConstant(left)) {
+      Location tmp = left;
+      left = right;
+      right = tmp;
+    }
+    if (!IsZeroConstant(right) || !left.IsRegister()) {
+      return false;
+    }
+  }
+
+  const Register reg = left.reg();
+  if (labels.fall_through == labels.false_label) {
+    EmitTestAndBranch(compiler, reg, bit, is_equal, labels.true_label);
+  } else {
+    EmitTestAndBranch(compiler, reg, bit, !is_equal, labels.false_label);
+    if (labels.fall_through != labels.true_label) {
+      __ b(labels.true_label);
+    }
+  }
+  return true;
+}
+
 void ComparisonInstr::EmitBranchCode(FlowGraphCompiler* compiler,
                                      BranchInstr* branch) {
   BranchLabels labels = compiler->CreateBranchLabels(branch);
+  if (TryEmitFusedBranch(compiler, this, labels)) {
+    return;
+  }
   Condition true_condition = EmitComparisonCode(compiler, labels);
   if (true_condition != kInvalidCondition) {
     EmitBranchOnCondition(compiler, true_condition, labels);
@@ -66,7 +66,8 @@ DECLARE_FLAG(int, optimization_counter_threshold);
   M(UnaryInt64Op)                                                              \
   M(CheckedSmiOp)                                                              \
   M(CheckedSmiComparison)                                                      \
-  M(SimdOp)
+  M(SimdOp)                                                                    \
+  M(SmiBitLength)
 
 // Location summaries actually are not used by the unoptimizing DBC compiler
 // because we don't allocate any registers.
@@ -763,6 +764,8 @@ EMIT_NATIVE_CODE(StoreIndexed,
       }
       if (index_scale() == 1) {
         __ StoreIndexedUint32(array, index, value);
+      } else if (index_scale() == 4) {
+        __ StoreIndexed4Uint32(array, index, value);
       } else {
         __ ShlImm(temp, index, Utils::ShiftForPowerOfTwo(index_scale()));
         __ StoreIndexedUint32(array, temp, value);
@@ -864,6 +867,8 @@ EMIT_NATIVE_CODE(LoadIndexed,
         }
         if (index_scale() == 1) {
           __ LoadIndexedInt32(result, array, index);
+        } else if (index_scale() == 4) {
+          __ LoadIndexed4Int32(result, array, index);
         } else {
           __ ShlImm(temp, index, Utils::ShiftForPowerOfTwo(index_scale()));
           __ LoadIndexedInt32(result, array, temp);
@@ -877,6 +882,8 @@ EMIT_NATIVE_CODE(LoadIndexed,
         }
         if (index_scale() == 1) {
           __ LoadIndexedUint32(result, array, index);
+        } else if (index_scale() == 4) {
+          __ LoadIndexed4Uint32(result, array, index);
         } else {
           __ ShlImm(temp, index, Utils::ShiftForPowerOfTwo(index_scale()));
           __ LoadIndexedUint32(result, array, temp);
@@ -1820,6 +1827,10 @@ EMIT_NATIVE_CODE(InvokeMathCFunction,
     __ DSin(result, left);
   } else if (recognized_kind() == MethodRecognizer::kMathCos) {
     __ DCos(result, left);
+  } else if (recognized_kind() == MethodRecognizer::kMathExp) {
+    __ DExp(result, left);
+  } else if (recognized_kind() == MethodRecognizer::kMathLog) {
+    __ DLog(result, left);
   } else {
     Unsupported(compiler);
     UNREACHABLE();
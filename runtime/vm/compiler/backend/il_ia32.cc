@@ -4487,6 +4487,34 @@ void UnarySmiOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 }
 
+LocationSummary* SmiBitLengthInstr::MakeLocationSummary(Zone* zone,
+                                                        bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 1;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_temp(0, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SmiBitLengthInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  ASSERT(kSmiTagShift == 1);
+  const Register value = locs()->in(0).reg();
+  const Register temp = locs()->temp(0).reg();
+  const Register result = locs()->out(0).reg();
+  // XOR with sign bit to complement bits if value is negative.
+  __ movl(temp, value);
+  __ sarl(temp, Immediate(31));  // All 0 or all 1.
+  __ xorl(temp, value);
+  // BSR does not write the destination register if source is zero.  Put a 1 in
+  // the Smi tag bit to ensure BSR writes to destination register.
+  __ orl(temp, Immediate(kSmiTagMask));
+  __ bsrl(result, temp);
+  __ SmiTag(result);
+}
+
 LocationSummary* UnaryDoubleOpInstr::MakeLocationSummary(Zone* zone,
                                                          bool opt) const {
   const intptr_t kNumInputs = 1;
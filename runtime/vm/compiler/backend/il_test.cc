@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/compiler/backend/il.h"
+#include "vm/flags.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -40,4 +41,123 @@ TEST_CASE(OptimizationTests) {
   EXPECT(!c3->Equals(c1));
 }
 
+// Runs int.bitLength long enough to get it inlined into optimized code and
+// compares it against a shifting loop, around zero and the Smi limits.
+TEST_CASE(SmiBitLength) {
+  const char* kScriptChars =
+      "int slowBitLength(int x) {\n"
+      "  if (x < 0) x = ~x;\n"
+      "  int n = 0;\n"
+      "  while (x != 0) { x >>= 1; n++; }\n"
+      "  return n;\n"
+      "}\n"
+      "int check(int x) => x.bitLength == slowBitLength(x) ? 0 : 1;\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  for (int round = 0; round < 20; round++) {\n"
+      "    for (int i = -70; i < 70; i++) errors += check(i);\n"
+      "    for (int i = 1; i < 62; i++) {\n"
+      "      errors += check(1 << i);\n"
+      "      errors += check((1 << i) - 1);\n"
+      "      errors += check(-(1 << i));\n"
+      "      errors += check(-(1 << i) - 1);\n"
+      "    }\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+}
+
+static CreateArrayInstr* MakeCreateArray(Definition* length) {
+  ConstantInstr* type = new ConstantInstr(Object::ZoneHandle());
+  return new CreateArrayInstr(TokenPosition::kNoSource, new Value(type),
+                              new Value(length), DeoptId::kNone);
+}
+
+// Write barrier elimination only drops barriers on stores into allocations
+// that report WillAllocateNewOrRemembered. For arrays that must mean the
+// array is certain to be in new space.
+TEST_CASE(CreateArrayWillAllocateNewOrRemembered) {
+  ConstantInstr* small = new ConstantInstr(Smi::ZoneHandle(Smi::New(4)));
+  EXPECT(MakeCreateArray(small)->WillAllocateNewOrRemembered());
+
+  ConstantInstr* largest_new = new ConstantInstr(
+      Smi::ZoneHandle(Smi::New(Array::kMaxNewSpaceElements)));
+  EXPECT(MakeCreateArray(largest_new)->WillAllocateNewOrRemembered());
+
+  ConstantInstr* old = new ConstantInstr(
+      Smi::ZoneHandle(Smi::New(Array::kMaxNewSpaceElements + 1)));
+  EXPECT(!MakeCreateArray(old)->WillAllocateNewOrRemembered());
+
+  JoinEntryInstr* join =
+      new JoinEntryInstr(1, kInvalidTryIndex, DeoptId::kNone);
+  Definition* unknown = new PhiInstr(join, 0);
+  EXPECT(!MakeCreateArray(unknown)->WillAllocateNewOrRemembered());
+}
+
+// Stores fresh objects into arrays created with constant lengths on both
+// sides of the new-space limit, without a GC point in between, while
+// allocating enough to keep the marker busy. The arrays that end up in old
+// space must keep their barriers or the stored objects are lost.
+TEST_CASE(WriteBarrierElimination_LargeArrays) {
+  const char* kScriptChars =
+      "class Box {\n"
+      "  final int value;\n"
+      "  Box(this.value);\n"
+      "}\n"
+      "List small(Box x, Box y) {\n"
+      "  var a = new List(16);\n"
+      "  a[0] = x;\n"
+      "  a[15] = y;\n"
+      "  return a;\n"
+      "}\n"
+      "List large(Box x, Box y) {\n"
+      "  var a = new List(100000);\n"
+      "  a[0] = x;\n"
+      "  a[99999] = y;\n"
+      "  return a;\n"
+      "}\n"
+      "int check(List a, int i) {\n"
+      "  int errors = 0;\n"
+      "  if (a[0].value != i) errors++;\n"
+      "  if (a[a.length - 1].value != -i) errors++;\n"
+      "  return errors;\n"
+      "}\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  var live = new List(32);\n"
+      "  for (int i = 0; i < 2000; i++) {\n"
+      "    int slot = i % live.length;\n"
+      "    if (live[slot] != null) {\n"
+      "      errors += check(live[slot][0], i - live.length);\n"
+      "      errors += check(live[slot][1], i - live.length);\n"
+      "    }\n"
+      "    var garbage = new List(1000);\n"
+      "    for (int j = 0; j < garbage.length; j++) garbage[j] = new Box(j);\n"
+      "    live[slot] = [\n"
+      "      small(new Box(i), new Box(-i)),\n"
+      "      large(new Box(i), new Box(-i))\n"
+      "    ];\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+}
+
 }  // namespace dart
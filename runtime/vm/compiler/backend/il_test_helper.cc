@@ -0,0 +1,75 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il_test_helper.h"
+
+#include "vm/compiler/backend/block_scheduler.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/inliner.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/longjump.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+RawFunction* GetFunction(const Library& lib, const char* name) {
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(String::New(name))));
+  EXPECT(!function.IsNull());
+  return function.raw();
+}
+
+FlowGraph* BuildOptimizedFlowGraph(Thread* thread, const Function& function) {
+  Zone* zone = thread->zone();
+  ParsedFunction* parsed_function = new (zone)
+      ParsedFunction(thread, Function::ZoneHandle(zone, function.raw()));
+  DartCompilationPipeline pipeline;
+  SpeculativeInliningPolicy speculative_policy(/* enable_blacklist= */ false);
+  LongJumpScope jump;
+  if (setjmp(*jump.Set()) == 0) {
+    CompilerState compiler_state(thread);
+    pipeline.ParseFunction(parsed_function);
+    ZoneGrowableArray<const ICData*>* ic_data_array =
+        new (zone) ZoneGrowableArray<const ICData*>();
+    function.RestoreICDataMap(ic_data_array, /* clone_ic_data= */ false);
+    FlowGraph* flow_graph =
+        pipeline.BuildFlowGraph(zone, parsed_function, ic_data_array,
+                                Compiler::kNoOSRDeoptId, /* optimized= */ true);
+
+    BlockScheduler block_scheduler(flow_graph);
+    CompilerPassState pass_state(thread, flow_graph, &speculative_policy);
+    pass_state.block_scheduler = &block_scheduler;
+    pass_state.reorder_blocks = false;
+    pass_state.inline_id_to_function.Add(&function);
+    pass_state.caller_inline_id.Add(-1);
+    JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
+    pass_state.call_specializer = &call_specializer;
+    CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+    return flow_graph;
+  }
+  return NULL;
+}
+
+intptr_t CountInstructions(FlowGraph* flow_graph,
+                           bool (*matches)(Instruction* instr)) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (matches(it.Current())) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+}  // namespace dart
@@ -0,0 +1,34 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+class Function;
+class Instruction;
+class Library;
+class RawFunction;
+class Thread;
+
+// Returns the top-level function of the library with the given name.
+RawFunction* GetFunction(const Library& lib, const char* name);
+
+// Builds the flow graph of a function with the optimizing JIT pipeline, as
+// the optimizing compiler does, and returns it after the last pass without
+// generating code. The function must have run unoptimized, so that its type
+// feedback is available. Returns NULL if the compilation bails out.
+FlowGraph* BuildOptimizedFlowGraph(Thread* thread, const Function& function);
+
+// Returns the number of instructions in the graph for which matches is true.
+intptr_t CountInstructions(FlowGraph* flow_graph,
+                           bool (*matches)(Instruction* instr));
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
@@ -13,6 +13,7 @@
 #include "vm/compiler/backend/locations_helpers.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/cpu.h"
 #include "vm/dart_entry.h"
 #include "vm/instructions.h"
 #include "vm/object_store.h"
@@ -1386,7 +1387,8 @@ Representation StoreIndexedInstr::RequiredInputRepresentation(
 LocationSummary* StoreIndexedInstr::MakeLocationSummary(Zone* zone,
                                                         bool opt) const {
   const intptr_t kNumInputs = 3;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps =
+      ((class_id() == kArrayCid) && ShouldEmitStoreBarrier()) ? 1 : 0;
   LocationSummary* locs = new (zone)
       LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
   locs->set_in(0, Location::RequiresRegister());
@@ -1405,15 +1407,14 @@ LocationSummary* StoreIndexedInstr::MakeLocationSummary(Zone* zone,
   }
   switch (class_id()) {
     case kArrayCid:
-#if defined(CONCURRENT_MARKING)
-      locs->set_in(2, ShouldEmitStoreBarrier()
-                          ? Location::RegisterLocation(kWriteBarrierValueReg)
-                          : Location::RegisterOrConstant(value()));
-#else
-      locs->set_in(2, ShouldEmitStoreBarrier()
-                          ? Location::WritableRegister()
-                          : Location::RegisterOrConstant(value()));
-#endif
+      if (ShouldEmitStoreBarrier()) {
+        // Fixed registers of the array write barrier stub.
+        locs->set_in(0, Location::RegisterLocation(kWriteBarrierObjectReg));
+        locs->set_in(2, Location::RegisterLocation(kWriteBarrierValueReg));
+        locs->set_temp(0, Location::RegisterLocation(kWriteBarrierSlotReg));
+      } else {
+        locs->set_in(2, Location::RegisterOrConstant(value()));
+      }
       break;
     case kExternalTypedDataUint8ArrayCid:
     case kExternalTypedDataUint8ClampedArrayCid:
@@ -1473,7 +1474,9 @@ void StoreIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     case kArrayCid:
       if (ShouldEmitStoreBarrier()) {
         Register value = locs()->in(2).reg();
-        __ StoreIntoObject(array, element_address, value, CanValueBeSmi());
+        Register slot = locs()->temp(0).reg();
+        __ leaq(slot, element_address);
+        __ StoreIntoArray(array, slot, value, CanValueBeSmi());
       } else if (locs()->in(2).IsConstant()) {
         const Object& constant = locs()->in(2).constant();
         __ StoreIntoObjectNoBarrier(array, element_address, constant);
@@ -4031,6 +4034,49 @@ Condition DoubleTestOpInstr::EmitComparisonCode(FlowGraphCompiler* compiler,
   V(Float32x4LessThan, cmppslt)                                                \
   V(Float32x4LessThanOrEqual, cmppsle)
 
+// The subset of SIMD_OP_SIMPLE_BINARY with a three-operand VEX form, which
+// does not tie the output to the left input.
+#define SIMD_OP_VEX_BINARY(V)                                                  \
+  SIMD_OP_FLOAT_ARITH(V, Add, vadd)                                            \
+  SIMD_OP_FLOAT_ARITH(V, Sub, vsub)                                            \
+  SIMD_OP_FLOAT_ARITH(V, Mul, vmul)                                            \
+  SIMD_OP_FLOAT_ARITH(V, Div, vdiv)                                            \
+  SIMD_OP_FLOAT_ARITH(V, Min, vmin)                                            \
+  SIMD_OP_FLOAT_ARITH(V, Max, vmax)                                            \
+  V(Int32x4Add, vaddpl)                                                        \
+  V(Int32x4Sub, vsubpl)                                                        \
+  V(Int32x4BitAnd, vandps)                                                     \
+  V(Int32x4BitOr, vorps)                                                       \
+  V(Int32x4BitXor, vxorps)
+
+static bool UseVexEncoding(SimdOpInstr::Kind kind) {
+  if (!TargetCPUFeatures::avx_supported()) {
+    return false;
+  }
+  switch (kind) {
+#define CASE(Name, op) case SimdOpInstr::k##Name:
+    SIMD_OP_VEX_BINARY(CASE)
+#undef CASE
+    return true;
+    default:
+      return false;
+  }
+}
+
+DEFINE_EMIT(SimdBinaryOpVex,
+            (XmmRegister out, XmmRegister left, XmmRegister right)) {
+  switch (instr->kind()) {
+#define EMIT(Name, op)                                                         \
+  case SimdOpInstr::k##Name:                                                   \
+    __ op(out, left, right);                                                   \
+    break;
+    SIMD_OP_VEX_BINARY(EMIT)
+#undef EMIT
+    default:
+      UNREACHABLE();
+  }
+}
+
 DEFINE_EMIT(SimdBinaryOp,
             (SameAsFirstInput, XmmRegister left, XmmRegister right)) {
   switch (instr->kind()) {
@@ -4378,6 +4424,9 @@ DEFINE_EMIT(Int32x4Select,
   SIMPLE(Int32x4Select)
 
 LocationSummary* SimdOpInstr::MakeLocationSummary(Zone* zone, bool opt) const {
+  if (UseVexEncoding(kind())) {
+    return MakeLocationSummaryFromEmitter(zone, this, &EmitSimdBinaryOpVex);
+  }
   switch (kind()) {
 #define CASE(Name, ...) case k##Name:
 #define EMIT(Name)                                                             \
@@ -4395,6 +4444,10 @@ LocationSummary* SimdOpInstr::MakeLocationSummary(Zone* zone, bool opt) const {
 }
 
 void SimdOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  if (UseVexEncoding(kind())) {
+    InvokeEmitter(compiler, this, &EmitSimdBinaryOpVex);
+    return;
+  }
   switch (kind()) {
 #define CASE(Name, ...) case k##Name:
 #define EMIT(Name)                                                             \
@@ -4498,6 +4551,34 @@ void UnarySmiOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 }
 
+LocationSummary* SmiBitLengthInstr::MakeLocationSummary(Zone* zone,
+                                                        bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 1;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_temp(0, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SmiBitLengthInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  ASSERT(kSmiTagShift == 1);
+  const Register value = locs()->in(0).reg();
+  const Register temp = locs()->temp(0).reg();
+  const Register result = locs()->out(0).reg();
+  // XOR with sign bit to complement bits if value is negative.
+  __ movq(temp, value);
+  __ sarq(temp, Immediate(63));  // All 0 or all 1.
+  __ xorq(temp, value);
+  // BSR does not write the destination register if source is zero.  Put a 1 in
+  // the Smi tag bit to ensure BSR writes to destination register.
+  __ orq(temp, Immediate(kSmiTagMask));
+  __ bsrq(result, temp);
+  __ SmiTag(result);
+}
+
 LocationSummary* UnaryDoubleOpInstr::MakeLocationSummary(Zone* zone,
                                                          bool opt) const {
   const intptr_t kNumInputs = 1;
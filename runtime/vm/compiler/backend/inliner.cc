@@ -87,6 +87,17 @@ DEFINE_FLAG(int,
             max_inlined_per_depth,
             500,
             "Max. number of inlined calls per depth");
+DEFINE_FLAG(int,
+            max_polymorphic_field_access_checks,
+            16,
+            "Maximum number of receiver classes inlined at a polymorphic call "
+            "that only reaches implicit getters and setters.");
+DEFINE_FLAG(int,
+            max_polymorphic_range_checks,
+            12,
+            "Maximum number of receiver class id ranges inlined at a "
+            "polymorphic call whose ranges reach no more than "
+            "--max_polymorphic_checks distinct targets.");
 DEFINE_FLAG(bool, print_inlining_tree, false, "Print inlining tree");
 DEFINE_FLAG(bool,
             enable_inlining_annotations,
@@ -663,6 +674,34 @@ static void ReplaceParameterStubs(Zone* zone,
   DEBUG_ASSERT(!FLAG_verify_compiler || caller_graph->VerifyUseLists());
 }
 
+// Maps a callee to its parsed function, so that callees considered at many
+// call sites are parsed once per optimizing compilation.
+class ParsedFunctionKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const Function* Key;
+  typedef ParsedFunction* Value;
+  typedef ParsedFunction* Pair;
+
+  static Key KeyOf(Pair kv) { return &kv->function(); }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline intptr_t Hashcode(Key key) {
+    // Hash on the source position rather than the address, which a
+    // compacting GC may change while we compile.
+    if (key->kernel_offset() > 0) {
+      return key->kernel_offset();
+    } else {
+      return key->token_pos().value();
+    }
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return pair->function().raw() == key->raw();
+  }
+};
+
 class CallSiteInliner : public ValueObject {
  public:
   explicit CallSiteInliner(FlowGraphInliner* inliner, intptr_t threshold)
@@ -710,6 +749,10 @@ class CallSiteInliner : public ValueObject {
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
     }
+    if (inliner_->flow_graph()->is_intermediate_tier()) {
+      // Only trivial callees are worth their compile time in this tier.
+      return InliningDecision::No("intermediate tier");
+    }
     if (inlined_size_ > FLAG_inlining_caller_size_threshold) {
       // Prevent methods becoming humongous and thus slow to compile.
       return InliningDecision::No("--inlining-caller-size-threshold");
@@ -988,6 +1031,9 @@ class CallSiteInliner : public ValueObject {
 #if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
     !defined(TARGET_ARCH_IA32)
         if (FLAG_precompiled_mode) {
+          if (inliner_->precompiler_ != NULL) {
+            inliner_->precompiler_->ApplyTypeFeedback(callee_graph);
+          }
           callee_graph->PopulateWithICData(parsed_function->function());
         }
 #else
@@ -1180,7 +1226,7 @@ class CallSiteInliner : public ValueObject {
 
         // Add the function to the cache.
         if (!in_cache) {
-          function_cache_.Add(parsed_function);
+          function_cache_.Insert(parsed_function);
         }
 
         // Build succeeded so we restore the bailout jump.
@@ -1343,17 +1389,13 @@ class CallSiteInliner : public ValueObject {
 
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
-    // TODO(zerny): Use a hash map for the cache.
-    for (intptr_t i = 0; i < function_cache_.length(); ++i) {
-      ParsedFunction* parsed_function = function_cache_[i];
-      if (parsed_function->function().raw() == function.raw()) {
-        *in_cache = true;
-        return parsed_function;
-      }
+    ParsedFunction* parsed_function = function_cache_.LookupValue(&function);
+    if (parsed_function != NULL) {
+      *in_cache = true;
+      return parsed_function;
     }
     *in_cache = false;
-    ParsedFunction* parsed_function =
-        new (Z) ParsedFunction(thread(), function);
+    parsed_function = new (Z) ParsedFunction(thread(), function);
     return parsed_function;
   }
 
@@ -1585,7 +1627,7 @@ class CallSiteInliner : public ValueObject {
   intptr_t inlining_depth_threshold_;
   CallSites* collected_call_sites_;
   CallSites* inlining_call_sites_;
-  GrowableArray<ParsedFunction*> function_cache_;
+  DirectChainedHashMap<ParsedFunctionKeyValueTrait> function_cache_;
   GrowableArray<InlinedInfo> inlined_info_;
 
   DISALLOW_COPY_AND_ASSIGN(CallSiteInliner);
@@ -2052,19 +2094,77 @@ bool PolymorphicInliner::trace_inlining() const {
   return owner_->trace_inlining();
 }
 
+// Returns true if all targets are implicit field accessors. Inlined, each of
+// them is a class id test and a field load or store, so accessing the same
+// field name on many unrelated classes stays cheaper than a call.
+static bool AreAllImplicitAccessors(const CallTargets& targets) {
+  for (intptr_t i = 0; i < targets.length(); i++) {
+    const RawFunction::Kind kind = targets.TargetAt(i)->target->kind();
+    if ((kind != RawFunction::kImplicitGetter) &&
+        (kind != RawFunction::kImplicitSetter)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the number of different functions reached by the ranges in
+// 'targets'.
+static intptr_t CountDistinctTargets(const CallTargets& targets) {
+  intptr_t distinct = 0;
+  for (intptr_t i = 0; i < targets.length(); i++) {
+    const Function& target = *targets.TargetAt(i)->target;
+    bool seen = false;
+    for (intptr_t j = 0; j < i; j++) {
+      if (targets.TargetAt(j)->target->raw() == target.raw()) {
+        seen = true;
+        break;
+      }
+    }
+    if (!seen) distinct++;
+  }
+  return distinct;
+}
+
+// Returns the number of calls that reached 'target' through any of the ranges
+// in 'targets'.
+static intptr_t CountForTarget(const CallTargets& targets,
+                               const Function& target) {
+  intptr_t count = 0;
+  for (intptr_t i = 0; i < targets.length(); i++) {
+    if (targets.TargetAt(i)->target->raw() == target.raw()) {
+      count += targets.TargetAt(i)->count;
+    }
+  }
+  return count;
+}
+
 bool PolymorphicInliner::Inline() {
   ASSERT(&variants_ == &call_->targets_);
 
+  const intptr_t max_checks = AreAllImplicitAccessors(variants_)
+                                  ? FLAG_max_polymorphic_field_access_checks
+                                  : FLAG_max_polymorphic_checks;
+  // Class hierarchies that share an implementation among subclasses that are
+  // not numbered contiguously produce several ranges for the same target.
+  // Their bodies are inlined once and shared, so only the class id tests
+  // grow with the number of ranges.
+  const bool too_many_checks =
+      (variants_.length() > max_checks) &&
+      ((variants_.length() > FLAG_max_polymorphic_range_checks) ||
+       (CountDistinctTargets(variants_) > max_checks));
   intptr_t total = call_->total_call_count();
   for (intptr_t var_idx = 0; var_idx < variants_.length(); ++var_idx) {
     TargetInfo* info = variants_.TargetAt(var_idx);
-    if (variants_.length() > FLAG_max_polymorphic_checks) {
+    if (too_many_checks) {
       non_inlined_variants_->Add(info);
       continue;
     }
 
     const Function& target = *variants_.TargetAt(var_idx)->target;
-    const intptr_t count = variants_.TargetAt(var_idx)->count;
+    // Judge frequency by implementation rather than by range, so that a
+    // target reached through many small ranges is not dropped piecemeal.
+    const intptr_t count = CountForTarget(variants_, target);
 
     // We we almost inlined all the cases then try a little harder to inline
     // the last two, because it's a big win if we inline all of them (compiler
@@ -2247,7 +2347,8 @@ int FlowGraphInliner::Inline() {
     printer.PrintBlocks();
   }
 
-  intptr_t inlining_depth_threshold = FLAG_inlining_depth_threshold;
+  intptr_t inlining_depth_threshold =
+      flow_graph_->is_intermediate_tier() ? 1 : FLAG_inlining_depth_threshold;
 
   CallSiteInliner inliner(this, inlining_depth_threshold);
   inliner.InlineCalls();
@@ -2623,6 +2724,28 @@ static bool InlineSmiBitAndFromSmi(FlowGraph* flow_graph,
   return true;
 }
 
+static bool InlineSmiBitLength(FlowGraph* flow_graph,
+                               Instruction* call,
+                               Definition* receiver,
+                               GraphEntryInstr* graph_entry,
+                               FunctionEntryInstr** entry,
+                               Instruction** last) {
+#if defined(TARGET_ARCH_DBC)
+  // DBC has no bytecode for it.
+  return false;
+#else
+  *entry =
+      new (Z) FunctionEntryInstr(graph_entry, flow_graph->allocate_block_id(),
+                                 call->GetBlock()->try_index(), DeoptId::kNone);
+  (*entry)->InheritDeoptTarget(Z, call);
+  SmiBitLengthInstr* bit_length =
+      new (Z) SmiBitLengthInstr(new (Z) Value(receiver));
+  flow_graph->AppendTo(*entry, bit_length, NULL, FlowGraph::kValue);
+  *last = bit_length;
+  return true;
+#endif  // defined(TARGET_ARCH_DBC)
+}
+
 static bool InlineGrowableArraySetter(FlowGraph* flow_graph,
                                       intptr_t offset,
                                       StoreBarrierType store_barrier_type,
@@ -3824,6 +3947,9 @@ bool FlowGraphInliner::TryInlineRecognizedMethod(
     case MethodRecognizer::kSmi_bitAndFromSmi:
       return InlineSmiBitAndFromSmi(flow_graph, call, receiver, graph_entry,
                                     entry, last);
+    case MethodRecognizer::kSmi_bitLength:
+      return InlineSmiBitLength(flow_graph, call, receiver, graph_entry, entry,
+                                last);
 
     case MethodRecognizer::kFloat32x4Abs:
     case MethodRecognizer::kFloat32x4Clamp:
@@ -3898,6 +4024,8 @@ bool FlowGraphInliner::TryInlineRecognizedMethod(
     case MethodRecognizer::kMathAcos:
     case MethodRecognizer::kMathAtan:
     case MethodRecognizer::kMathAtan2:
+    case MethodRecognizer::kMathExp:
+    case MethodRecognizer::kMathLog:
       return InlineMathCFunction(flow_graph, call, kind, graph_entry, entry,
                                  last);
 
@@ -2237,9 +2237,19 @@ bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
   TRACE_ALLOC(THR_Print(" to v%" Pd "\n", unallocated->vreg()));
 
   if (free_until != kMaxPosition) {
-    // There was an intersection. Split unallocated.
-    TRACE_ALLOC(THR_Print("  splitting at %" Pd "\n", free_until));
-    LiveRange* tail = unallocated->SplitAt(free_until);
+    // There was an intersection. Split unallocated. If the intersection is
+    // inside a loop that starts after the range, split at the loop header
+    // instead, to give the tail a chance to stay in one location for the
+    // whole loop rather than moving on every iteration.
+    LiveRange* tail = NULL;
+    LoopInfo* split_loop = BlockEntryAt(free_until)->loop_info();
+    if ((split_loop != nullptr) &&
+        (unallocated->Start() < split_loop->header()->lifetime_position())) {
+      tail = SplitBetween(unallocated, unallocated->Start(), free_until);
+    } else {
+      TRACE_ALLOC(THR_Print("  splitting at %" Pd "\n", free_until));
+      tail = unallocated->SplitAt(free_until);
+    }
     AddToUnallocated(tail);
   }
 
@@ -2570,6 +2580,7 @@ bool LiveRange::Contains(intptr_t pos) const {
 }
 
 void FlowGraphAllocator::AssignSafepoints(Definition* defn, LiveRange* range) {
+  UseInterval* interval = range->first_use_interval();
   for (intptr_t i = safepoints_.length() - 1; i >= 0; i--) {
     Instruction* safepoint_instr = safepoints_[i];
     if (safepoint_instr == defn) {
@@ -2582,7 +2593,15 @@ void FlowGraphAllocator::AssignSafepoints(Definition* defn, LiveRange* range) {
     const intptr_t pos = safepoint_instr->lifetime_position();
     if (range->End() <= pos) break;
 
-    if (range->Contains(pos)) {
+    // Safepoints are visited in increasing order of positions, so the use
+    // intervals can be walked in tandem instead of searching them from the
+    // start for every safepoint.
+    while ((interval != NULL) && (interval->end() <= pos)) {
+      interval = interval->next();
+    }
+    if (interval == NULL) break;
+
+    if (interval->Contains(pos)) {
       range->AddSafepoint(pos, safepoint_instr->locs());
     }
   }
@@ -2602,13 +2621,20 @@ static void AddToSortedListOfRanges(GrowableArray<LiveRange*>* list,
     return;
   }
 
-  for (intptr_t i = list->length() - 1; i >= 0; i--) {
-    if (ShouldBeAllocatedBefore(range, (*list)[i])) {
-      list->InsertAt(i + 1, range);
-      return;
+  // The list is sorted by decreasing start positions. Binary search for the
+  // first range that should not be allocated after the new one, which
+  // keeps ranges with equal start positions in insertion order.
+  intptr_t lo = 0;
+  intptr_t hi = list->length();
+  while (lo < hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (ShouldBeAllocatedBefore(range, (*list)[mid])) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
-  list->InsertAt(0, range);
+  list->InsertAt(lo, range);
 }
 
 void FlowGraphAllocator::AddToUnallocated(LiveRange* range) {
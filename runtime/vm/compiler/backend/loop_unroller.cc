@@ -0,0 +1,674 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/loop_unroller.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, loop_unrolling, false, "Unroll and peel small loops.");
+DEFINE_FLAG(int,
+            loop_unrolling_budget,
+            48,
+            "Maximum number of instructions in the body of an unrolled loop.");
+DEFINE_FLAG(bool, trace_loop_unrolling, false, "Trace loop unrolling.");
+
+// Upper bound on the number of iterations per unrolled iteration.
+static const intptr_t kMaxUnrollFactor = 8;
+
+LoopUnroller::LoopUnroller(FlowGraph* flow_graph, LoopInfo* loop)
+    : flow_graph_(flow_graph),
+      loop_(loop),
+      header_(NULL),
+      body_(NULL),
+      preheader_(NULL),
+      exit_(NULL),
+      branch_(NULL),
+      stack_check_(NULL),
+      entry_index_(-1),
+      back_index_(-1),
+      phis_(),
+      induction_(NULL),
+      stride_(0),
+      induction_on_left_(true),
+      peel_(false),
+      factor_(0),
+      merged_exit_(NULL),
+      exit_phis_(),
+      map_(),
+      phi_inputs_() {}
+
+bool LoopUnroller::IsInvariant(Definition* def) const {
+  return loop_->IsInvariant(def);
+}
+
+// Blocks emitted for other loops have no preorder number yet.
+bool LoopUnroller::IsInLoop(Instruction* instr) const {
+  const intptr_t preorder_number = instr->GetBlock()->preorder_number();
+  return (preorder_number >= 0) && loop_->blocks()->Contains(preorder_number);
+}
+
+bool LoopUnroller::Match() {
+  if (!MatchHeader() || !MatchBody()) {
+    return false;
+  }
+  if ((factor_ > 1) && !MatchCountedLoop()) {
+    factor_ = 0;
+  }
+  return peel_ || (factor_ > 1);
+}
+
+bool LoopUnroller::MatchHeader() {
+  if (loop_->inner() != NULL || !loop_->header()->IsJoinEntry() ||
+      loop_->back_edges().length() != 1 || loop_->NumBlocks() != 2) {
+    return false;
+  }
+  header_ = loop_->header()->AsJoinEntry();
+  body_ = loop_->back_edges()[0];
+  if (header_->PredecessorCount() != 2 || body_ == header_ ||
+      body_->PredecessorCount() != 1 || body_->PredecessorAt(0) != header_ ||
+      header_->try_index() != kInvalidTryIndex) {
+    return false;
+  }
+  back_index_ = header_->IndexOfPredecessor(body_);
+  entry_index_ = 1 - back_index_;
+  preheader_ = header_->PredecessorAt(entry_index_);
+  if (!preheader_->last_instruction()->IsGoto()) {
+    return false;
+  }
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    if (!it.Current()->is_alive()) {
+      return false;
+    }
+    phis_.Add(it.Current());
+  }
+
+  // The header holds only the stack overflow check and the loop test.
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsCheckStackOverflow() && stack_check_ == NULL) {
+      stack_check_ = current->AsCheckStackOverflow();
+    } else if (current->IsBranch()) {
+      branch_ = current->AsBranch();
+    } else {
+      return false;
+    }
+  }
+  if (branch_ == NULL) {
+    return false;
+  }
+  ComparisonInstr* compare = branch_->comparison();
+  if (!compare->IsRelationalOp() && !compare->IsEqualityCompare() &&
+      !compare->IsStrictCompare()) {
+    return false;
+  }
+  for (intptr_t i = 0; i < compare->InputCount(); i++) {
+    Definition* input = compare->InputAt(i)->definition();
+    if (!IsInvariant(input) && input->GetBlock() != header_) {
+      return false;
+    }
+  }
+  BlockEntryInstr* exit = NULL;
+  if (branch_->true_successor() == body_) {
+    exit = branch_->false_successor();
+  } else if (branch_->false_successor() == body_) {
+    exit = branch_->true_successor();
+  }
+  if (exit == NULL || loop_->blocks()->Contains(exit->preorder_number())) {
+    return false;
+  }
+  exit_ = exit->AsTargetEntry();
+  return true;
+}
+
+// Every instruction in the body must have a copy. Instructions with loop
+// invariant inputs that LICM left in the loop, e.g. because they may throw,
+// become redundant with their copies in a peeled iteration.
+bool LoopUnroller::MatchBody() {
+  intptr_t size = 0;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsGoto()) {
+      continue;
+    }
+    if (Clone(current) == NULL) {
+      return false;
+    }
+    size++;
+    bool inputs_invariant = current->InputCount() > 0;
+    for (intptr_t i = 0; i < current->InputCount(); i++) {
+      if (!IsInvariant(current->InputAt(i)->definition())) {
+        inputs_invariant = false;
+        break;
+      }
+    }
+    if (inputs_invariant &&
+        (current->AllowsCSE() || current->IsLoadField() ||
+         current->IsLoadIndexed() || current->IsLoadUntagged())) {
+      peel_ = true;
+    }
+  }
+  factor_ = Utils::Minimum(kMaxUnrollFactor,
+                           FLAG_loop_unrolling_budget /
+                               Utils::Maximum<intptr_t>(size, 1));
+  return true;
+}
+
+// Matches a test of a basic induction variable q against a loop invariant,
+// and makes sure that the value q takes factor_ - 1 iterations later is
+// representable whenever q itself passes the test.
+bool LoopUnroller::MatchCountedLoop() {
+  RelationalOpInstr* compare = branch_->comparison()->AsRelationalOp();
+  if (compare == NULL) {
+    return false;
+  }
+  Token::Kind kind = compare->kind();
+  if (branch_->false_successor() == body_) {
+    kind = Token::NegateComparison(kind);
+  }
+  Definition* left = compare->left()->definition();
+  Definition* right = compare->right()->definition();
+  if (!IsInvariant(right)) {
+    Definition* tmp = left;
+    left = right;
+    right = tmp;
+    kind = FlipComparison(kind);
+    induction_on_left_ = false;
+  }
+  induction_ = left->AsPhi();
+  if (induction_ == NULL || induction_->block() != header_ ||
+      !IsInvariant(right)) {
+    return false;
+  }
+  InductionVar* induc = loop_->LookupInduction(induction_);
+  if (induc == NULL || !induc->IsLinear()) {
+    return false;
+  }
+  stride_ = induc->stride();
+  if (!((stride_ > 0) && (kind == Token::kLT || kind == Token::kLTE)) &&
+      !((stride_ < 0) && (kind == Token::kGT || kind == Token::kGTE))) {
+    return false;
+  }
+  int64_t min_value = kMinInt64;
+  int64_t max_value = kMaxInt64;
+  if (compare->operation_cid() == kSmiCid &&
+      induction_->representation() == kTagged) {
+    min_value = Smi::kMinValue;
+    max_value = Smi::kMaxValue;
+  } else if (compare->operation_cid() != kMintCid ||
+             induction_->representation() != kUnboxedInt64) {
+    return false;
+  }
+  const int64_t offset = (factor_ - 1) * stride_;
+  return (offset > 0)
+             ? RangeUtils::IsWithin(induction_->range(), min_value,
+                                    max_value - offset)
+             : RangeUtils::IsWithin(induction_->range(), min_value - offset,
+                                    max_value);
+}
+
+Definition* LoopUnroller::MapDefinition(Definition* def) {
+  Definition* mapped = map_.LookupValue(def);
+  return (mapped != NULL) ? mapped : def;
+}
+
+Value* LoopUnroller::MapValue(Value* value) {
+  return new (flow_graph_->zone()) Value(MapDefinition(value->definition()));
+}
+
+Environment* LoopUnroller::MapEnvironment(Environment* env) {
+  if (env == NULL) {
+    return NULL;
+  }
+  Environment* copy = env->DeepCopy(flow_graph_->zone());
+  for (Environment::DeepIterator it(copy); !it.Done(); it.Advance()) {
+    Value* value = it.CurrentValue();
+    value->set_definition(MapDefinition(value->definition()));
+  }
+  return copy;
+}
+
+void LoopUnroller::MapPhis(const GrowableArray<Definition*>& values) {
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    map_.Insert({phis_[i], values[i]});
+  }
+}
+
+// Returns a copy of the instruction with its inputs mapped, or NULL if
+// copying the instruction is not supported.
+Instruction* LoopUnroller::Clone(Instruction* instr) {
+  Zone* zone = flow_graph_->zone();
+  Instruction* copy = NULL;
+  if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    copy = new (zone) LoadIndexedInstr(
+        MapValue(load->array()), MapValue(load->index()), load->index_scale(),
+        load->class_id(), load->aligned() ? kAlignedAccess : kUnalignedAccess,
+        DeoptId::kNone, load->token_pos());
+  } else if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+    // The barrier is conservative, WriteBarrierElimination runs later.
+    copy = new (zone) StoreIndexedInstr(
+        MapValue(store->array()), MapValue(store->index()),
+        MapValue(store->value()), kEmitStoreBarrier, store->index_scale(),
+        store->class_id(), store->aligned() ? kAlignedAccess : kUnalignedAccess,
+        DeoptId::kNone, store->token_pos());
+  } else if (LoadFieldInstr* load = instr->AsLoadField()) {
+    LoadFieldInstr* copy_load = NULL;
+    if (load->native_field() != nullptr) {
+      copy_load = new (zone) LoadFieldInstr(
+          MapValue(load->instance()), load->native_field(), load->token_pos());
+    } else if (load->field() != nullptr) {
+      copy_load = new (zone)
+          LoadFieldInstr(MapValue(load->instance()), load->field(),
+                         load->type(), load->token_pos(), nullptr);
+    } else {
+      copy_load = new (zone)
+          LoadFieldInstr(MapValue(load->instance()), load->offset_in_bytes(),
+                         load->type(), load->token_pos());
+    }
+    copy_load->set_result_cid(load->result_cid());
+    copy_load->set_is_immutable(load->AllowsCSE());
+    copy = copy_load;
+  } else if (LoadUntaggedInstr* load = instr->AsLoadUntagged()) {
+    copy = new (zone)
+        LoadUntaggedInstr(MapValue(load->object()), load->offset());
+  } else if (CheckArrayBoundInstr* check = instr->AsCheckArrayBound()) {
+    copy = new (zone) CheckArrayBoundInstr(
+        MapValue(check->length()), MapValue(check->index()), DeoptId::kNone);
+  } else if (GenericCheckBoundInstr* check = instr->AsGenericCheckBound()) {
+    copy = new (zone) GenericCheckBoundInstr(
+        MapValue(check->length()), MapValue(check->index()), DeoptId::kNone);
+  } else if (CheckSmiInstr* check = instr->AsCheckSmi()) {
+    copy = new (zone)
+        CheckSmiInstr(MapValue(check->value()), DeoptId::kNone,
+                      check->token_pos());
+  } else if (CheckClassInstr* check = instr->AsCheckClass()) {
+    copy = new (zone) CheckClassInstr(MapValue(check->value()), DeoptId::kNone,
+                                      check->cids(), check->token_pos());
+  } else if (CheckStackOverflowInstr* check = instr->AsCheckStackOverflow()) {
+    copy = new (zone) CheckStackOverflowInstr(
+        check->token_pos(), check->loop_depth(), DeoptId::kNone);
+  } else if (BinaryInt64OpInstr* op = instr->AsBinaryInt64Op()) {
+    copy = new (zone)
+        BinaryInt64OpInstr(op->op_kind(), MapValue(op->left()),
+                           MapValue(op->right()), DeoptId::kNone,
+                           op->speculative_mode());
+  } else if (BinaryIntegerOpInstr* op = instr->AsBinaryIntegerOp()) {
+    copy = BinaryIntegerOpInstr::Make(
+        op->representation(), op->op_kind(), MapValue(op->left()),
+        MapValue(op->right()), DeoptId::kNone, op->can_overflow(),
+        op->is_truncating(), op->range(), op->speculative_mode());
+  } else if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+    copy = new (zone) BinaryDoubleOpInstr(
+        op->op_kind(), MapValue(op->left()), MapValue(op->right()),
+        DeoptId::kNone, op->token_pos(), op->speculative_mode());
+  } else if (BoxInstr* box = instr->AsBox()) {
+    copy = BoxInstr::Create(box->from_representation(), MapValue(box->value()));
+  } else if (UnboxInstr* unbox = instr->AsUnbox()) {
+    if (unbox->AsUnboxInteger() != NULL &&
+        unbox->AsUnboxInteger()->is_truncating()) {
+      return NULL;
+    }
+    copy = UnboxInstr::Create(unbox->representation(),
+                              MapValue(unbox->value()), DeoptId::kNone,
+                              unbox->speculative_mode());
+  } else if (UnboxedIntConverterInstr* conv =
+                 instr->AsUnboxedIntConverter()) {
+    UnboxedIntConverterInstr* copy_conv = new (zone) UnboxedIntConverterInstr(
+        conv->from(), conv->to(), MapValue(conv->value()), DeoptId::kNone);
+    if (conv->is_truncating()) {
+      copy_conv->mark_truncating();
+    }
+    copy = copy_conv;
+  }
+  if (copy != NULL) {
+    copy->CopyDeoptIdFrom(*instr);
+  }
+  return copy;
+}
+
+ComparisonInstr* LoopUnroller::CloneComparison(ComparisonInstr* comparison,
+                                               Value* left,
+                                               Value* right) {
+  Zone* zone = flow_graph_->zone();
+  ComparisonInstr* copy = NULL;
+  if (RelationalOpInstr* compare = comparison->AsRelationalOp()) {
+    copy = new (zone) RelationalOpInstr(
+        compare->token_pos(), compare->kind(), left, right,
+        compare->operation_cid(), DeoptId::kNone, compare->speculative_mode());
+  } else if (EqualityCompareInstr* compare = comparison->AsEqualityCompare()) {
+    copy = new (zone) EqualityCompareInstr(
+        compare->token_pos(), compare->kind(), left, right,
+        compare->operation_cid(), DeoptId::kNone, compare->speculative_mode());
+  } else {
+    ASSERT(comparison->IsStrictCompare());
+    copy = comparison->CopyWithNewOperands(left, right);
+  }
+  copy->CopyDeoptIdFrom(*comparison);
+  return copy;
+}
+
+PhiInstr* LoopUnroller::NewPhi(JoinEntryInstr* join, PhiInstr* original) {
+  PhiInstr* phi = new (flow_graph_->zone()) PhiInstr(join, 2);
+  flow_graph_->AllocateSSAIndexes(phi);
+  phi->mark_alive();
+  phi->set_representation(original->representation());
+  if (original->range() != NULL) {
+    phi->set_range(*original->range());
+  }
+  join->InsertPhi(phi);
+  return phi;
+}
+
+JoinEntryInstr* LoopUnroller::NewJoin() {
+  return new (flow_graph_->zone())
+      JoinEntryInstr(flow_graph_->allocate_block_id(), preheader_->try_index(),
+                     DeoptId::kNone);
+}
+
+TargetEntryInstr* LoopUnroller::NewTarget() {
+  return new (flow_graph_->zone())
+      TargetEntryInstr(flow_graph_->allocate_block_id(),
+                       preheader_->try_index(), DeoptId::kNone);
+}
+
+// Ends the block at cursor with a branch on the comparison, with targets in
+// the same order as the loop test.
+BranchInstr* LoopUnroller::EmitBranch(Instruction* cursor,
+                                      ComparisonInstr* comparison) {
+  BranchInstr* branch =
+      new (flow_graph_->zone()) BranchInstr(comparison, DeoptId::kNone);
+  branch->CopyDeoptIdFrom(*branch_);
+  flow_graph_->AppendTo(cursor, branch, MapEnvironment(branch_->env()),
+                        FlowGraph::kEffect);
+  cursor->GetBlock()->set_last_instruction(branch);
+  *branch->true_successor_address() = NewTarget();
+  *branch->false_successor_address() = NewTarget();
+  return branch;
+}
+
+// Appends a copy of the body for the iteration entered with the given phi
+// values, and replaces them with the values of the next iteration.
+Instruction* LoopUnroller::EmitBody(Instruction* cursor,
+                                    GrowableArray<Definition*>* values) {
+  MapPhis(*values);
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsGoto()) {
+      continue;
+    }
+    Instruction* copy = Clone(current);
+    Definition* def = current->AsDefinition();
+    const bool is_value = (def != NULL) && def->HasSSATemp();
+    cursor = flow_graph_->AppendTo(cursor, copy, MapEnvironment(current->env()),
+                                   is_value ? FlowGraph::kValue
+                                            : FlowGraph::kEffect);
+    if (is_value) {
+      Definition* copy_def = copy->AsDefinition();
+      if (def->range() != NULL) {
+        copy_def->set_range(*def->range());
+      }
+      map_.Insert({def, copy_def});
+    }
+  }
+  GrowableArray<Definition*> next(phis_.length());
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    next.Add(MapDefinition(phis_[i]->InputAt(back_index_)->definition()));
+  }
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    (*values)[i] = next[i];
+  }
+  return cursor;
+}
+
+// Redirects the loop exit through a new join, which will also receive the
+// exit of the peeled iteration, and gives the loop phis that are used after
+// the loop a phi in it.
+void LoopUnroller::MergeExits() {
+  merged_exit_ = NewJoin();
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    PhiInstr* phi = phis_[i];
+    GrowableArray<Value*> uses;
+    GrowableArray<Value*> env_uses;
+    for (Value* use = phi->input_use_list(); use != NULL;
+         use = use->next_use()) {
+      if (!IsInLoop(use->instruction())) {
+        uses.Add(use);
+      }
+    }
+    for (Value* use = phi->env_use_list(); use != NULL; use = use->next_use()) {
+      if (!IsInLoop(use->instruction())) {
+        env_uses.Add(use);
+      }
+    }
+    if (uses.is_empty() && env_uses.is_empty()) {
+      exit_phis_.Add(NULL);
+      continue;
+    }
+    PhiInstr* exit_phi = NewPhi(merged_exit_, phi);
+    exit_phis_.Add(exit_phi);
+    for (intptr_t j = 0; j < uses.length(); j++) {
+      uses[j]->BindTo(exit_phi);
+    }
+    for (intptr_t j = 0; j < env_uses.length(); j++) {
+      env_uses[j]->BindToEnvironment(exit_phi);
+    }
+    PhiInput input = {exit_phi, exit_, phi};
+    phi_inputs_.Add(input);
+  }
+
+  merged_exit_->LinkTo(exit_->next());
+  exit_->ReplaceAsPredecessorWith(merged_exit_);
+  GotoInstr* exit_goto =
+      new (flow_graph_->zone()) GotoInstr(merged_exit_, DeoptId::kNone);
+  exit_->LinkTo(exit_goto);
+  exit_->set_last_instruction(exit_goto);
+}
+
+void LoopUnroller::EmitPeeledIteration(GotoInstr** entry,
+                                       BlockEntryInstr** entry_block,
+                                       GrowableArray<Definition*>* values) {
+  Zone* zone = flow_graph_->zone();
+  JoinEntryInstr* peel_header = NewJoin();
+  (*entry)->set_successor(peel_header);
+
+  MapPhis(*values);
+  ComparisonInstr* compare = branch_->comparison();
+  BranchInstr* branch = EmitBranch(
+      peel_header, CloneComparison(compare, MapValue(compare->InputAt(0)),
+                                   MapValue(compare->InputAt(1))));
+  const bool body_on_true = branch_->true_successor() == body_;
+  TargetEntryInstr* peel_body =
+      body_on_true ? branch->true_successor() : branch->false_successor();
+  TargetEntryInstr* peel_exit =
+      body_on_true ? branch->false_successor() : branch->true_successor();
+
+  GotoInstr* exit_goto = new (zone) GotoInstr(merged_exit_, DeoptId::kNone);
+  peel_exit->AppendInstruction(exit_goto);
+  peel_exit->set_last_instruction(exit_goto);
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    if (exit_phis_[i] != NULL) {
+      PhiInput input = {exit_phis_[i], peel_exit, (*values)[i]};
+      phi_inputs_.Add(input);
+    }
+  }
+
+  Instruction* cursor = EmitBody(peel_body, values);
+  GotoInstr* next = new (zone) GotoInstr(header_, DeoptId::kNone);
+  cursor->AppendInstruction(next);
+  peel_body->set_last_instruction(next);
+  *entry = next;
+  *entry_block = peel_body;
+}
+
+void LoopUnroller::EmitUnrolledLoop(GotoInstr** entry,
+                                    BlockEntryInstr** entry_block,
+                                    GrowableArray<Definition*>* values) {
+  Zone* zone = flow_graph_->zone();
+  JoinEntryInstr* unrolled_header = NewJoin();
+  (*entry)->set_successor(unrolled_header);
+
+  GrowableArray<PhiInstr*> unrolled_phis(phis_.length());
+  GrowableArray<Definition*> iteration_values(phis_.length());
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    PhiInstr* phi = NewPhi(unrolled_header, phis_[i]);
+    PhiInput input = {phi, *entry_block, (*values)[i]};
+    phi_inputs_.Add(input);
+    unrolled_phis.Add(phi);
+    iteration_values.Add(phi);
+  }
+  MapPhis(iteration_values);
+
+  Instruction* cursor = unrolled_header;
+  if (stack_check_ != NULL) {
+    cursor = flow_graph_->AppendTo(cursor, Clone(stack_check_),
+                                   MapEnvironment(stack_check_->env()),
+                                   FlowGraph::kEffect);
+  }
+
+  // Test the induction variable of the last of the unrolled iterations.
+  // Its range guarantees that the addition does not overflow, see
+  // MatchCountedLoop.
+  const intptr_t offset = (factor_ - 1) * stride_;
+  Definition* offset_def =
+      flow_graph_->GetConstant(Smi::ZoneHandle(zone, Smi::New(offset)));
+  if (induction_->representation() == kUnboxedInt64) {
+    offset_def =
+        UnboxInstr::Create(kUnboxedInt64, new (zone) Value(offset_def),
+                           DeoptId::kNone, Instruction::kNotSpeculative);
+    flow_graph_->InsertBefore(*entry, offset_def, NULL, FlowGraph::kValue);
+  }
+  BinaryIntegerOpInstr* last = BinaryIntegerOpInstr::Make(
+      induction_->representation(), Token::kADD,
+      new (zone) Value(MapDefinition(induction_)), new (zone) Value(offset_def),
+      DeoptId::kNone, /*can_overflow=*/false, /*is_truncating=*/false, NULL,
+      Instruction::kNotSpeculative);
+  cursor = flow_graph_->AppendTo(cursor, last, NULL, FlowGraph::kValue);
+  ComparisonInstr* compare = branch_->comparison();
+  Value* left = induction_on_left_ ? new (zone) Value(last)
+                                   : MapValue(compare->InputAt(0));
+  Value* right = induction_on_left_ ? MapValue(compare->InputAt(1))
+                                    : new (zone) Value(last);
+  BranchInstr* branch =
+      EmitBranch(cursor, CloneComparison(compare, left, right));
+  const bool body_on_true = branch_->true_successor() == body_;
+  TargetEntryInstr* unrolled_body =
+      body_on_true ? branch->true_successor() : branch->false_successor();
+  TargetEntryInstr* unrolled_exit =
+      body_on_true ? branch->false_successor() : branch->true_successor();
+
+  cursor = unrolled_body;
+  for (intptr_t j = 0; j < factor_; j++) {
+    cursor = EmitBody(cursor, &iteration_values);
+  }
+  GotoInstr* back_edge = new (zone) GotoInstr(unrolled_header, DeoptId::kNone);
+  cursor->AppendInstruction(back_edge);
+  unrolled_body->set_last_instruction(back_edge);
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    PhiInput input = {unrolled_phis[i], unrolled_body, iteration_values[i]};
+    phi_inputs_.Add(input);
+  }
+
+  GotoInstr* exit_goto = new (zone) GotoInstr(header_, DeoptId::kNone);
+  unrolled_exit->AppendInstruction(exit_goto);
+  unrolled_exit->set_last_instruction(exit_goto);
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    (*values)[i] = unrolled_phis[i];
+  }
+  *entry = exit_goto;
+  *entry_block = unrolled_exit;
+}
+
+void LoopUnroller::Emit() {
+  GotoInstr* entry = preheader_->last_instruction()->AsGoto();
+  BlockEntryInstr* entry_block = preheader_;
+  GrowableArray<Definition*> values(phis_.length());
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    values.Add(phis_[i]->InputAt(entry_index_)->definition());
+  }
+
+  if (peel_) {
+    MergeExits();
+    EmitPeeledIteration(&entry, &entry_block, &values);
+  }
+  if (factor_ > 1) {
+    EmitUnrolledLoop(&entry, &entry_block, &values);
+  }
+  entry->set_successor(header_);
+
+  // The loop is now entered from the last block emitted in front of it.
+  for (intptr_t i = 0; i < phis_.length(); i++) {
+    PhiInstr* phi = phis_[i];
+    PhiInput entry_input = {phi, entry_block, values[i]};
+    PhiInput back_input = {phi, body_,
+                           phi->InputAt(back_index_)->definition()};
+    phi->InputAt(0)->RemoveFromUseList();
+    phi->InputAt(1)->RemoveFromUseList();
+    phi_inputs_.Add(entry_input);
+    phi_inputs_.Add(back_input);
+  }
+}
+
+// Sets the recorded phi inputs now that the predecessors of every join are
+// known.
+void LoopUnroller::FixPhis() {
+  for (intptr_t i = 0; i < phi_inputs_.length(); i++) {
+    const PhiInput& input = phi_inputs_[i];
+    const intptr_t index =
+        input.phi->block()->IndexOfPredecessor(input.predecessor);
+    ASSERT(index >= 0);
+    SetPhiInput(input.phi, index, input.value);
+  }
+}
+
+bool LoopUnroller::Optimize(FlowGraph* flow_graph) {
+  if (!FLAG_loop_unrolling) {
+    return false;
+  }
+  const LoopHierarchy& loops = flow_graph->GetLoopHierarchy();
+  loops.ComputeInduction();
+  const ZoneGrowableArray<BlockEntryInstr*>& headers = loops.headers();
+  GrowableArray<LoopUnroller*> unrolled;
+  bool peeled = false;
+  for (intptr_t i = 0; i < headers.length(); i++) {
+    LoopUnroller* unroller =
+        new LoopUnroller(flow_graph, headers[i]->loop_info());
+    if (unroller->Match()) {
+      if (FLAG_trace_loop_unrolling) {
+        THR_Print("Unrolling loop B%" Pd " in %s: factor %" Pd "%s\n",
+                  headers[i]->block_id(),
+                  flow_graph->function().ToFullyQualifiedCString(),
+                  unroller->factor_, unroller->peel_ ? ", peeled" : "");
+      }
+      peeled = peeled || unroller->peel_;
+      unrolled.Add(unroller);
+    }
+  }
+  if (unrolled.is_empty()) {
+    return false;
+  }
+  // Matching relies on the preorder numbers of the original graph, so all
+  // loops are matched before any of them is transformed.
+  for (intptr_t i = 0; i < unrolled.length(); i++) {
+    unrolled[i]->Emit();
+  }
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+  for (intptr_t i = 0; i < unrolled.length(); i++) {
+    unrolled[i]->FixPhis();
+  }
+  return peeled;
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -0,0 +1,126 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class FlowGraph;
+class LoopInfo;
+
+// Unrolls and peels small innermost loops of the form
+//
+//   preheader:
+//     goto header
+//   header:
+//     q = phi(q0, q + t)
+//     CheckStackOverflow
+//     if (q < n) goto body else goto exit
+//   body:
+//     ...
+//     goto header
+//
+// Counted loops, where q is an induction variable compared against a loop
+// invariant n, are unrolled by running a copy of the loop in front of it
+// that executes several iterations per stack overflow check and per test
+// of q. The original loop executes the remaining iterations.
+//
+// Loops with instructions whose inputs are loop invariant, but which could
+// not be hoisted, get their first iteration peeled, so that its copies of
+// these instructions dominate the loop and make the ones in the loop
+// redundant.
+//
+// Must run after range analysis, since it relies on the ranges of the
+// induction variable to keep the unrolled test from overflowing.
+class LoopUnroller : public ZoneAllocated {
+ public:
+  // Returns true if any loop was peeled, in which case redundancy
+  // elimination should run again.
+  static bool Optimize(FlowGraph* flow_graph);
+
+ private:
+  typedef RawPointerKeyValueTrait<Definition, Definition*> MapTrait;
+  typedef DirectChainedHashMap<MapTrait> Map;
+
+  // Phi input to set once the predecessors are known.
+  struct PhiInput {
+    PhiInstr* phi;
+    BlockEntryInstr* predecessor;
+    Definition* value;
+  };
+
+  LoopUnroller(FlowGraph* flow_graph, LoopInfo* loop);
+
+  bool Match();
+  bool MatchHeader();
+  bool MatchBody();
+  bool MatchCountedLoop();
+  bool IsInvariant(Definition* def) const;
+  bool IsInLoop(Instruction* instr) const;
+
+  void Emit();
+  void EmitPeeledIteration(GotoInstr** entry,
+                           BlockEntryInstr** entry_block,
+                           GrowableArray<Definition*>* values);
+  void EmitUnrolledLoop(GotoInstr** entry,
+                        BlockEntryInstr** entry_block,
+                        GrowableArray<Definition*>* values);
+  void MergeExits();
+  Instruction* EmitBody(Instruction* cursor,
+                        GrowableArray<Definition*>* values);
+  BranchInstr* EmitBranch(Instruction* cursor, ComparisonInstr* comparison);
+  void FixPhis();
+
+  Definition* MapDefinition(Definition* def);
+  Value* MapValue(Value* value);
+  Environment* MapEnvironment(Environment* env);
+  void MapPhis(const GrowableArray<Definition*>& values);
+  Instruction* Clone(Instruction* instr);
+  ComparisonInstr* CloneComparison(ComparisonInstr* comparison,
+                                   Value* left,
+                                   Value* right);
+  PhiInstr* NewPhi(JoinEntryInstr* join, PhiInstr* original);
+  JoinEntryInstr* NewJoin();
+  TargetEntryInstr* NewTarget();
+
+  FlowGraph* flow_graph_;
+  LoopInfo* loop_;
+
+  JoinEntryInstr* header_;
+  BlockEntryInstr* body_;
+  BlockEntryInstr* preheader_;
+  TargetEntryInstr* exit_;
+  BranchInstr* branch_;
+  CheckStackOverflowInstr* stack_check_;
+  intptr_t entry_index_;
+  intptr_t back_index_;
+  GrowableArray<PhiInstr*> phis_;
+
+  // The counted loop test q < n, with q an induction variable.
+  PhiInstr* induction_;
+  int64_t stride_;
+  bool induction_on_left_;
+
+  bool peel_;
+  intptr_t factor_;
+
+  // Join where the exits of the peeled iteration and the loop meet,
+  // with the phis for the loop phis that are used after the loop.
+  JoinEntryInstr* merged_exit_;
+  GrowableArray<PhiInstr*> exit_phis_;
+
+  Map map_;
+  GrowableArray<PhiInput> phi_inputs_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopUnroller);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_unroller.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_unrolling);
+
+// Runs small loops long enough to get them optimized, over lengths that
+// exercise both the unrolled loop and the original loop for the remainder.
+// main returns the number of results that differ from the expected values.
+TEST_CASE(LoopUnrolling_CountedLoops) {
+  const char* kScriptChars =
+      "import 'dart:typed_data';\n"
+      "int sum(Uint8List a) {\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < a.length; i++) s += a[i];\n"
+      "  return s;\n"
+      "}\n"
+      "int sumOdd(Uint8List a, int n) {\n"
+      "  int s = 0;\n"
+      "  for (int i = n - 1; i >= 0; i -= 2) s = (s * 31 + a[i]) & 0xffff;\n"
+      "  return s;\n"
+      "}\n"
+      "class Box {\n"
+      "  Uint8List data;\n"
+      "  Box(this.data);\n"
+      "}\n"
+      "int sumBox(Box b, int n) {\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < n; i++) s += b.data[i];\n"
+      "  return s;\n"
+      "}\n"
+      "int check(int n) {\n"
+      "  int errors = 0;\n"
+      "  var a = new Uint8List(n);\n"
+      "  for (int i = 0; i < n; i++) a[i] = i * 7;\n"
+      "  int expected = 0, expectedOdd = 0;\n"
+      "  for (int i = 0; i < n; i++) expected += (i * 7) & 0xff;\n"
+      "  for (int i = n - 1; i >= 0; i -= 2) {\n"
+      "    expectedOdd = (expectedOdd * 31 + ((i * 7) & 0xff)) & 0xffff;\n"
+      "  }\n"
+      "  if (sum(a) != expected) errors++;\n"
+      "  if (sumOdd(a, n) != expectedOdd) errors++;\n"
+      "  if (sumBox(new Box(a), n) != expected) errors++;\n"
+      "  return errors;\n"
+      "}\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  for (int round = 0; round < 20; round++) {\n"
+      "    for (int n = 0; n < 21; n++) errors += check(n);\n"
+      "  }\n"
+      "  // Loops that throw part way through an unrolled iteration.\n"
+      "  try {\n"
+      "    sumBox(new Box(new Uint8List(5)), 9);\n"
+      "    errors++;\n"
+      "  } on RangeError catch (e) {\n"
+      "  }\n"
+      "  try {\n"
+      "    sumBox(new Box(null), 3);\n"
+      "    errors++;\n"
+      "  } on NoSuchMethodError catch (e) {\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  SetFlagScope<bool> sfs(&FLAG_loop_unrolling, true);
+  SetFlagScope<int> sfs2(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs3(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+
+  // The unrolled body of sum repeats the load, the original loop left for
+  // the remainder keeps its own.
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& function = Function::Handle(GetFunction(library, "sum"));
+  FlowGraph* flow_graph = BuildOptimizedFlowGraph(thread, function);
+  EXPECT(flow_graph != NULL);
+  EXPECT_LT(1, CountInstructions(flow_graph, [](Instruction* instr) {
+              return instr->IsLoadIndexed();
+            }));
+  FLAG_loop_unrolling = false;
+  flow_graph = BuildOptimizedFlowGraph(thread, function);
+  EXPECT(flow_graph != NULL);
+  EXPECT_EQ(1, CountInstructions(flow_graph, [](Instruction* instr) {
+              return instr->IsLoadIndexed();
+            }));
+}
+
+}  // namespace dart
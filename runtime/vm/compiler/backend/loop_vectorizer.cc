@@ -0,0 +1,645 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            false,
+            "Vectorize simple loops over Float32List, Float64List and "
+            "Int32List.");
+DEFINE_FLAG(bool, trace_loop_vectorization, false, "Trace loop vectorization.");
+
+// Element types that map onto SIMD values.
+enum LaneKind {
+  kNoLanes,
+  kFloat32Lanes,
+  kFloat64Lanes,
+  kInt32Lanes,
+};
+
+static LaneKind LaneKindForArrayCid(intptr_t cid) {
+  switch (cid) {
+    case kTypedDataFloat32ArrayCid:
+      return kFloat32Lanes;
+    case kTypedDataFloat64ArrayCid:
+      return kFloat64Lanes;
+    case kTypedDataInt32ArrayCid:
+      return kInt32Lanes;
+    default:
+      return kNoLanes;
+  }
+}
+
+static intptr_t LaneCount(LaneKind kind) {
+  return (kind == kFloat64Lanes) ? 2 : 4;
+}
+
+// The array class id used to access a whole vector of elements.
+static intptr_t VectorArrayCid(LaneKind kind) {
+  switch (kind) {
+    case kFloat32Lanes:
+      return kTypedDataFloat32x4ArrayCid;
+    case kFloat64Lanes:
+      return kTypedDataFloat64x2ArrayCid;
+    case kInt32Lanes:
+      return kTypedDataInt32x4ArrayCid;
+    default:
+      UNREACHABLE();
+      return kIllegalCid;
+  }
+}
+
+static intptr_t VectorCid(LaneKind kind) {
+  switch (kind) {
+    case kFloat32Lanes:
+      return kFloat32x4Cid;
+    case kFloat64Lanes:
+      return kFloat64x2Cid;
+    case kInt32Lanes:
+      return kInt32x4Cid;
+    default:
+      UNREACHABLE();
+      return kIllegalCid;
+  }
+}
+
+// Returns true if the scalar operation computes the same lanes as the
+// matching SIMD operation. Integer operations qualify if they agree with
+// their 32-bit wrap-around counterparts, since Int32List stores truncate.
+static bool IsLaneOperation(LaneKind kind, Token::Kind op) {
+  switch (op) {
+    case Token::kADD:
+    case Token::kSUB:
+      return true;
+    case Token::kMUL:
+    case Token::kDIV:
+      return kind != kInt32Lanes;
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+      return kind == kInt32Lanes;
+    default:
+      return false;
+  }
+}
+
+// Matches and transforms a single innermost loop of the form
+//
+//   preheader:
+//     goto header
+//   header:
+//     i = phi(i0, i + 1)
+//     if (i < n) goto body else goto exit
+//   body:
+//     ... element-wise accesses at index i ...
+//     goto header
+//
+// into
+//
+//   preheader:
+//     goto vector_header
+//   vector_header:
+//     vi = phi(i0, vi + lanes)
+//     if (vi + lanes - 1 < n && vi + lanes - 1 < length ...)
+//       goto vector_body else goto vector_exit
+//   vector_body:
+//     ... SIMD accesses at index vi ...
+//     goto vector_header
+//   vector_exit:
+//     goto header
+//   header:
+//     i = phi(vi, i + 1)
+//     ...
+//
+// The vector loop has no stack overflow check: it is bounded by the length
+// of the accessed arrays and every instruction in it is free of calls.
+class LoopBodyVectorizer : public ZoneAllocated {
+ public:
+  LoopBodyVectorizer(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        loop_(loop),
+        header_(NULL),
+        body_(NULL),
+        preheader_(NULL),
+        induction_(NULL),
+        increment_(NULL),
+        initial_(NULL),
+        limit_(NULL),
+        limit_cid_(kIllegalCid),
+        lane_kind_(kNoLanes),
+        vector_index_(NULL),
+        vector_header_(NULL) {}
+
+  // Returns true if the loop matches the supported shape.
+  bool Match();
+
+  // Emits the vector loop in front of the matched loop. The block order and
+  // dominators must be recomputed afterwards, followed by FixHeaderPhi.
+  void Emit();
+
+  // Reorders the inputs of the induction phi to match the predecessors of
+  // the loop header after block discovery.
+  void FixHeaderPhi();
+
+  LaneKind lane_kind() const { return lane_kind_; }
+
+ private:
+  // A scalar definition in the loop body computing one lane of a vector.
+  struct Lane {
+    Definition* scalar;
+    // Scalar definition this one is a representation change of, or NULL.
+    Definition* alias;
+    // Number of arithmetic operations between the loads and this value.
+    intptr_t depth;
+    Definition* vector;
+  };
+
+  bool MatchHeader();
+  bool MatchBody();
+  bool MatchBoundsCheck(Value* length, Value* index);
+  bool MatchAccess(Value* array, Value* index, intptr_t cid, intptr_t scale);
+  bool MatchOperand(Value* value, intptr_t* depth);
+  bool SetLaneKind(LaneKind kind);
+
+  bool IsInvariant(Definition* def) const {
+    BlockEntryInstr* block = def->GetBlock();
+    return !loop_->blocks()->Contains(block->preorder_number());
+  }
+
+  Lane* LaneFor(Definition* def);
+  void AddLane(Definition* scalar, Definition* alias, intptr_t depth);
+  Definition* VectorFor(Value* value, Instruction* splat_position);
+
+  Instruction* EmitGuard(Instruction* cursor,
+                         Definition* last_index,
+                         Definition* limit,
+                         intptr_t cid,
+                         JoinEntryInstr* vector_exit);
+  TargetEntryInstr* NewTarget();
+  ConstantInstr* SmiConstant(intptr_t value);
+
+  FlowGraph* flow_graph_;
+  LoopInfo* loop_;
+
+  JoinEntryInstr* header_;
+  BlockEntryInstr* body_;
+  BlockEntryInstr* preheader_;
+  PhiInstr* induction_;
+  BinarySmiOpInstr* increment_;
+  Definition* initial_;
+  Definition* limit_;
+  intptr_t limit_cid_;
+  LaneKind lane_kind_;
+
+  // Array lengths the index must stay below.
+  GrowableArray<Definition*> lengths_;
+  // Loads, operations and stores to replicate, in program order.
+  GrowableArray<Definition*> plan_;
+  GrowableArray<Lane> lanes_;
+
+  PhiInstr* vector_index_;
+  JoinEntryInstr* vector_header_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopBodyVectorizer);
+};
+
+bool LoopBodyVectorizer::Match() {
+  return MatchHeader() && MatchBody();
+}
+
+bool LoopBodyVectorizer::MatchHeader() {
+  if (loop_->inner() != NULL || !loop_->header()->IsJoinEntry() ||
+      loop_->back_edges().length() != 1 || loop_->NumBlocks() != 2) {
+    return false;
+  }
+  header_ = loop_->header()->AsJoinEntry();
+  body_ = loop_->back_edges()[0];
+  if (header_->PredecessorCount() != 2 || body_ == header_ ||
+      body_->PredecessorCount() != 1 || body_->PredecessorAt(0) != header_) {
+    return false;
+  }
+  const intptr_t back_index = header_->IndexOfPredecessor(body_);
+  const intptr_t entry_index = 1 - back_index;
+  preheader_ = header_->PredecessorAt(entry_index);
+  if (!preheader_->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  // A single induction variable i = phi(i0, i + 1) on Smis.
+  if (header_->phis() == NULL || header_->phis()->length() != 1) {
+    return false;
+  }
+  induction_ = (*header_->phis())[0];
+  if (!induction_->is_alive() || induction_->representation() != kTagged ||
+      induction_->Type()->ToCid() != kSmiCid) {
+    return false;
+  }
+  increment_ =
+      induction_->InputAt(back_index)->definition()->AsBinarySmiOp();
+  if (increment_ == NULL || increment_->op_kind() != Token::kADD ||
+      increment_->GetBlock() != body_) {
+    return false;
+  }
+  Value* step = NULL;
+  if (increment_->left()->definition() == induction_) {
+    step = increment_->right();
+  } else if (increment_->right()->definition() == induction_) {
+    step = increment_->left();
+  } else {
+    return false;
+  }
+  if (!step->BindsToConstant() || !step->BoundConstant().IsSmi() ||
+      Smi::Cast(step->BoundConstant()).Value() != 1) {
+    return false;
+  }
+
+  // Keep vi + lanes far from overflowing, see Emit.
+  initial_ = induction_->InputAt(entry_index)->definition();
+  if (!RangeUtils::IsWithin(initial_->range(), 0, kMaxInt32)) {
+    return false;
+  }
+
+  // The header holds only the loop condition i < n.
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsCheckStackOverflow()) continue;
+    BranchInstr* branch = current->AsBranch();
+    if (branch == NULL) return false;
+    RelationalOpInstr* compare = branch->comparison()->AsRelationalOp();
+    if (compare == NULL || branch->true_successor() != body_) {
+      return false;
+    }
+    if (compare->kind() == Token::kLT &&
+        compare->left()->definition() == induction_) {
+      limit_ = compare->right()->definition();
+    } else if (compare->kind() == Token::kGT &&
+               compare->right()->definition() == induction_) {
+      limit_ = compare->left()->definition();
+    } else {
+      return false;
+    }
+    limit_cid_ = compare->operation_cid();
+    if ((limit_cid_ != kSmiCid && limit_cid_ != kMintCid) ||
+        !IsInvariant(limit_)) {
+      return false;
+    }
+  }
+  return limit_ != NULL;
+}
+
+bool LoopBodyVectorizer::SetLaneKind(LaneKind kind) {
+  if (kind == kNoLanes) return false;
+  if (lane_kind_ == kNoLanes) lane_kind_ = kind;
+  return lane_kind_ == kind;
+}
+
+LoopBodyVectorizer::Lane* LoopBodyVectorizer::LaneFor(Definition* def) {
+  for (intptr_t i = 0; i < lanes_.length(); i++) {
+    if (lanes_[i].scalar == def) {
+      return &lanes_[i];
+    }
+  }
+  return NULL;
+}
+
+void LoopBodyVectorizer::AddLane(Definition* scalar,
+                                 Definition* alias,
+                                 intptr_t depth) {
+  Lane lane = {scalar, alias, depth, NULL};
+  lanes_.Add(lane);
+}
+
+bool LoopBodyVectorizer::MatchBoundsCheck(Value* length, Value* index) {
+  if (index->definition() != induction_ ||
+      !IsInvariant(length->definition()) ||
+      length->Type()->ToCid() != kSmiCid) {
+    return false;
+  }
+  for (intptr_t i = 0; i < lengths_.length(); i++) {
+    if (lengths_[i] == length->definition()) return true;
+  }
+  lengths_.Add(length->definition());
+  return true;
+}
+
+bool LoopBodyVectorizer::MatchAccess(Value* array,
+                                     Value* index,
+                                     intptr_t cid,
+                                     intptr_t scale) {
+  return index->definition() == induction_ &&
+         IsInvariant(array->definition()) &&
+         array->definition()->representation() == kTagged &&
+         SetLaneKind(LaneKindForArrayCid(cid)) &&
+         scale == TypedData::ElementSizeInBytes(cid);
+}
+
+// An operand is a vector computed in the body, or a loop invariant double
+// that is splatted for Float64x2 lanes. Float32x4 lanes compute in single
+// instead of double precision, which only rounds the same way for a single
+// operation on loaded values.
+bool LoopBodyVectorizer::MatchOperand(Value* value, intptr_t* depth) {
+  Lane* lane = LaneFor(value->definition());
+  if (lane != NULL) {
+    if (lane_kind_ == kFloat32Lanes && lane->depth > 0) return false;
+    *depth = Utils::Maximum(*depth, lane->depth);
+    return true;
+  }
+  return lane_kind_ == kFloat64Lanes && IsInvariant(value->definition()) &&
+         value->definition()->representation() == kUnboxedDouble;
+}
+
+// Every instruction in the body must either be replicated on vectors, be
+// subsumed by the guards of the vector loop, or be the increment.
+bool LoopBodyVectorizer::MatchBody() {
+  bool has_store = false;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current == increment_ || current->IsCheckStackOverflow()) {
+      continue;
+    }
+    if (current->IsGoto()) {
+      ASSERT(current->AsGoto()->successor() == header_);
+      continue;
+    }
+    if (CheckArrayBoundInstr* check = current->AsCheckArrayBound()) {
+      if (!MatchBoundsCheck(check->length(), check->index())) return false;
+      continue;
+    }
+    if (GenericCheckBoundInstr* check = current->AsGenericCheckBound()) {
+      if (!MatchBoundsCheck(check->length(), check->index())) return false;
+      continue;
+    }
+    if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+      if (!MatchAccess(load->array(), load->index(), load->class_id(),
+                       load->index_scale())) {
+        return false;
+      }
+      AddLane(load, NULL, 0);
+      plan_.Add(load);
+      continue;
+    }
+    if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+      if (!MatchAccess(store->array(), store->index(), store->class_id(),
+                       store->index_scale())) {
+        return false;
+      }
+      Lane* lane = LaneFor(store->value()->definition());
+      if (lane == NULL || (lane_kind_ == kFloat32Lanes && lane->depth > 1)) {
+        return false;
+      }
+      plan_.Add(store);
+      has_store = true;
+      continue;
+    }
+    Definition* def = current->AsDefinition();
+    if (def == NULL || lane_kind_ == kNoLanes) {
+      return false;
+    }
+    if (def->IsBinaryDoubleOp() || def->IsBinaryIntegerOp()) {
+      const Token::Kind op = def->IsBinaryDoubleOp()
+                                 ? def->AsBinaryDoubleOp()->op_kind()
+                                 : def->AsBinaryIntegerOp()->op_kind();
+      if ((def->IsBinaryDoubleOp() == (lane_kind_ == kInt32Lanes)) ||
+          !IsLaneOperation(lane_kind_, op)) {
+        return false;
+      }
+      intptr_t depth = 0;
+      if (!MatchOperand(def->InputAt(0), &depth) ||
+          !MatchOperand(def->InputAt(1), &depth) ||
+          (LaneFor(def->InputAt(0)->definition()) == NULL &&
+           LaneFor(def->InputAt(1)->definition()) == NULL)) {
+        return false;
+      }
+      AddLane(def, NULL, depth + 1);
+      plan_.Add(def);
+      continue;
+    }
+    // Representation changes leave the lanes as they are, as long as they
+    // neither round doubles nor change the low 32 bits of integers.
+    const bool is_conversion =
+        def->IsBox() || def->IsUnbox() ||
+        (def->IsUnboxedIntConverter() && lane_kind_ == kInt32Lanes) ||
+        ((def->IsDoubleToFloat() || def->IsFloatToDouble()) &&
+         lane_kind_ == kFloat32Lanes);
+    if (!is_conversion || def->InputCount() != 1) {
+      return false;
+    }
+    Lane* lane = LaneFor(def->InputAt(0)->definition());
+    if (lane == NULL) {
+      return false;
+    }
+    AddLane(def, lane->alias != NULL ? lane->alias : lane->scalar,
+            lane->depth);
+  }
+  return has_store;
+}
+
+Definition* LoopBodyVectorizer::VectorFor(Value* value,
+                                          Instruction* splat_position) {
+  Lane* lane = LaneFor(value->definition());
+  if (lane == NULL) {
+    // Loop invariant operand.
+    ASSERT(lane_kind_ == kFloat64Lanes);
+    SimdOpInstr* splat =
+        SimdOpInstr::Create(MethodRecognizer::kFloat64x2Splat,
+                            new Value(value->definition()), DeoptId::kNone);
+    flow_graph_->InsertBefore(splat_position, splat, NULL, FlowGraph::kValue);
+    return splat;
+  }
+  if (lane->alias != NULL) {
+    lane = LaneFor(lane->alias);
+  }
+  ASSERT(lane->vector != NULL);
+  return lane->vector;
+}
+
+TargetEntryInstr* LoopBodyVectorizer::NewTarget() {
+  return new (flow_graph_->zone())
+      TargetEntryInstr(flow_graph_->allocate_block_id(),
+                       preheader_->try_index(), DeoptId::kNone);
+}
+
+ConstantInstr* LoopBodyVectorizer::SmiConstant(intptr_t value) {
+  return flow_graph_->GetConstant(
+      Smi::ZoneHandle(flow_graph_->zone(), Smi::New(value)));
+}
+
+// Ends the block at cursor with a branch on last_index < limit and returns
+// the entry of the true successor.
+Instruction* LoopBodyVectorizer::EmitGuard(Instruction* cursor,
+                                           Definition* last_index,
+                                           Definition* limit,
+                                           intptr_t cid,
+                                           JoinEntryInstr* vector_exit) {
+  Zone* zone = flow_graph_->zone();
+  RelationalOpInstr* compare = new (zone) RelationalOpInstr(
+      header_->last_instruction()->token_pos(), Token::kLT,
+      new (zone) Value(last_index), new (zone) Value(limit), cid,
+      DeoptId::kNone, Instruction::kNotSpeculative);
+  BranchInstr* branch = new (zone) BranchInstr(compare, DeoptId::kNone);
+  cursor->AppendInstruction(branch);
+  cursor->GetBlock()->set_last_instruction(branch);
+
+  TargetEntryInstr* taken = NewTarget();
+  TargetEntryInstr* not_taken = NewTarget();
+  *branch->true_successor_address() = taken;
+  *branch->false_successor_address() = not_taken;
+
+  GotoInstr* exit = new (zone) GotoInstr(vector_exit, DeoptId::kNone);
+  not_taken->AppendInstruction(exit);
+  not_taken->set_last_instruction(exit);
+  return taken;
+}
+
+void LoopBodyVectorizer::Emit() {
+  Zone* zone = flow_graph_->zone();
+  const intptr_t lanes = LaneCount(lane_kind_);
+  const intptr_t vector_array_cid = VectorArrayCid(lane_kind_);
+  const intptr_t vector_cid = VectorCid(lane_kind_);
+  GotoInstr* preheader_goto = preheader_->last_instruction()->AsGoto();
+
+  vector_header_ = new (zone) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), preheader_->try_index(),
+      DeoptId::kNone);
+  JoinEntryInstr* vector_exit = new (zone) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), preheader_->try_index(),
+      DeoptId::kNone);
+
+  // The preheader is the first predecessor of the vector header since the
+  // back edge has a newer block id.
+  vector_index_ = new (zone) PhiInstr(vector_header_, 2);
+  flow_graph_->AllocateSSAIndexes(vector_index_);
+  vector_index_->mark_alive();
+  SetPhiInput(vector_index_, 0, initial_);
+  vector_header_->InsertPhi(vector_index_);
+
+  // Index of the last lane. The initial index is a non-negative int32 and
+  // the vector index only advances while the last lane is below an array
+  // length, so this cannot overflow.
+  BinarySmiOpInstr* last_index = new (zone)
+      BinarySmiOpInstr(Token::kADD, new (zone) Value(vector_index_),
+                       new (zone) Value(SmiConstant(lanes - 1)),
+                       DeoptId::kNone);
+  last_index->set_can_overflow(false);
+  Instruction* cursor = flow_graph_->AppendTo(vector_header_, last_index, NULL,
+                                              FlowGraph::kValue);
+  cursor = EmitGuard(cursor, last_index, limit_, limit_cid_, vector_exit);
+  for (intptr_t i = 0; i < lengths_.length(); i++) {
+    if ((lengths_[i] == limit_) && (limit_cid_ == kSmiCid)) continue;
+    cursor = EmitGuard(cursor, last_index, lengths_[i], kSmiCid, vector_exit);
+  }
+  BlockEntryInstr* vector_body = cursor->AsBlockEntry();
+
+  for (intptr_t i = 0; i < plan_.length(); i++) {
+    Definition* scalar = plan_[i];
+    if (LoadIndexedInstr* load = scalar->AsLoadIndexed()) {
+      LoadIndexedInstr* vector = new (zone) LoadIndexedInstr(
+          new (zone) Value(load->array()->definition()),
+          new (zone) Value(vector_index_), load->index_scale(),
+          vector_array_cid, kAlignedAccess, DeoptId::kNone, load->token_pos());
+      cursor = flow_graph_->AppendTo(cursor, vector, NULL, FlowGraph::kValue);
+      LaneFor(load)->vector = vector;
+    } else if (StoreIndexedInstr* store = scalar->AsStoreIndexed()) {
+      StoreIndexedInstr* vector = new (zone) StoreIndexedInstr(
+          new (zone) Value(store->array()->definition()),
+          new (zone) Value(vector_index_),
+          new (zone) Value(VectorFor(store->value(), preheader_goto)),
+          kNoStoreBarrier, store->index_scale(), vector_array_cid,
+          kAlignedAccess, DeoptId::kNone, store->token_pos());
+      cursor = flow_graph_->AppendTo(cursor, vector, NULL, FlowGraph::kEffect);
+    } else {
+      const Token::Kind op = scalar->IsBinaryDoubleOp()
+                                 ? scalar->AsBinaryDoubleOp()->op_kind()
+                                 : scalar->AsBinaryIntegerOp()->op_kind();
+      SimdOpInstr* vector = SimdOpInstr::Create(
+          SimdOpInstr::KindForOperator(vector_cid, op),
+          new (zone) Value(VectorFor(scalar->InputAt(0), preheader_goto)),
+          new (zone) Value(VectorFor(scalar->InputAt(1), preheader_goto)),
+          DeoptId::kNone);
+      cursor = flow_graph_->AppendTo(cursor, vector, NULL, FlowGraph::kValue);
+      LaneFor(scalar)->vector = vector;
+    }
+  }
+
+  BinarySmiOpInstr* next_index = new (zone)
+      BinarySmiOpInstr(Token::kADD, new (zone) Value(vector_index_),
+                       new (zone) Value(SmiConstant(lanes)), DeoptId::kNone);
+  next_index->set_can_overflow(false);
+  cursor =
+      flow_graph_->AppendTo(cursor, next_index, NULL, FlowGraph::kValue);
+  GotoInstr* back_edge = new (zone) GotoInstr(vector_header_, DeoptId::kNone);
+  cursor->AppendInstruction(back_edge);
+  vector_body->set_last_instruction(back_edge);
+  SetPhiInput(vector_index_, 1, next_index);
+
+  GotoInstr* exit = new (zone) GotoInstr(header_, DeoptId::kNone);
+  vector_exit->AppendInstruction(exit);
+  vector_exit->set_last_instruction(exit);
+  preheader_goto->set_successor(vector_header_);
+}
+
+void LoopBodyVectorizer::FixHeaderPhi() {
+  const intptr_t back_index = header_->IndexOfPredecessor(body_);
+  ASSERT(header_->PredecessorAt(1 - back_index)->IsJoinEntry());
+  induction_->InputAt(0)->RemoveFromUseList();
+  induction_->InputAt(1)->RemoveFromUseList();
+  SetPhiInput(induction_, back_index, increment_);
+  SetPhiInput(induction_, 1 - back_index, vector_index_);
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  if (!FLAG_loop_vectorization ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+  const LoopHierarchy& loops = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& headers = loops.headers();
+  GrowableArray<LoopBodyVectorizer*> vectorized;
+  for (intptr_t i = 0; i < headers.length(); i++) {
+    LoopBodyVectorizer* vectorizer =
+        new LoopBodyVectorizer(flow_graph, headers[i]->loop_info());
+    if (vectorizer->Match()) {
+      if (FLAG_trace_loop_vectorization) {
+        THR_Print("Vectorizing loop B%" Pd " in %s with %" Pd " lanes\n",
+                  headers[i]->block_id(),
+                  flow_graph->function().ToFullyQualifiedCString(),
+                  LaneCount(vectorizer->lane_kind()));
+      }
+      vectorized.Add(vectorizer);
+    }
+  }
+  if (vectorized.is_empty()) {
+    return;
+  }
+  // Matching relies on the preorder numbers of the original graph, so all
+  // loops are matched before any of them is transformed.
+  for (intptr_t i = 0; i < vectorized.length(); i++) {
+    vectorized[i]->Emit();
+  }
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+  for (intptr_t i = 0; i < vectorized.length(); i++) {
+    vectorized[i]->FixHeaderPhi();
+  }
+#endif
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
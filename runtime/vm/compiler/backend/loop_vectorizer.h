@@ -0,0 +1,33 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Vectorizes simple counted loops over typed data, e.g.
+//
+//   for (int i = 0; i < n; i++) c[i] = a[i] + b[i];
+//
+// with Float32List, Float64List or Int32List operands, by running the body
+// on Float32x4, Float64x2 or Int32x4 values in a new loop in front of the
+// original one. The vector loop only runs while all lanes of an iteration
+// are in bounds, and the unchanged scalar loop executes the remaining
+// iterations, including any that throw.
+//
+// Must run after range analysis, since it relies on the ranges of the
+// induction variable and on the bounds checks that were not eliminated.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
@@ -0,0 +1,113 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_vectorization);
+
+// Runs element-wise loops long enough to get them optimized, over lengths
+// that exercise both the vector loop and the scalar loop for the remainder.
+// main returns the number of elements that differ from the expected values.
+TEST_CASE(LoopVectorization_ElementwiseLoops) {
+  const char* kScriptChars =
+      "import 'dart:typed_data';\n"
+      "void addF32(Float32List a, Float32List b, Float32List c) {\n"
+      "  for (int i = 0; i < c.length; i++) c[i] = a[i] + b[i];\n"
+      "}\n"
+      "void mulF64(Float64List a, Float64List b, double k) {\n"
+      "  for (int i = 0; i < b.length; i++) b[i] = a[i] * k;\n"
+      "}\n"
+      "void subI32(Int32List a, Int32List b, Int32List c) {\n"
+      "  for (int i = 0; i < c.length; i++) c[i] = (a[i] - b[i]) ^ a[i];\n"
+      "}\n"
+      "double toF32(double x) {\n"
+      "  var l = new Float32List(1);\n"
+      "  l[0] = x;\n"
+      "  return l[0];\n"
+      "}\n"
+      "int check(int n) {\n"
+      "  int errors = 0;\n"
+      "  var fa = new Float32List(n), fb = new Float32List(n);\n"
+      "  var fc = new Float32List(n);\n"
+      "  var da = new Float64List(n), db = new Float64List(n);\n"
+      "  var ia = new Int32List(n), ib = new Int32List(n);\n"
+      "  var ic = new Int32List(n);\n"
+      "  for (int i = 0; i < n; i++) {\n"
+      "    fa[i] = i / 3; fb[i] = i * 0.7; da[i] = i / 7;\n"
+      "    ia[i] = 0x7fffffff - i; ib[i] = -i * 3;\n"
+      "  }\n"
+      "  addF32(fa, fb, fc);\n"
+      "  mulF64(da, db, 1.1);\n"
+      "  subI32(ia, ib, ic);\n"
+      "  for (int i = 0; i < n; i++) {\n"
+      "    if (fc[i] != toF32(fa[i] + fb[i])) errors++;\n"
+      "    if (db[i] != da[i] * 1.1) errors++;\n"
+      "    if (ic[i] != ((ia[i] - ib[i]) ^ ia[i]).toSigned(32)) errors++;\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  for (int round = 0; round < 20; round++) {\n"
+      "    for (int n = 0; n < 19; n++) errors += check(n);\n"
+      "  }\n"
+      "  // The scalar loop throws where the shorter input ends, after the\n"
+      "  // vector loop stored the elements in front of it.\n"
+      "  var fc = new Float32List(9);\n"
+      "  try {\n"
+      "    addF32(new Float32List(5)..fillRange(0, 5, 1.0),\n"
+      "           new Float32List(9)..fillRange(0, 9, 2.0), fc);\n"
+      "    errors++;\n"
+      "  } on RangeError catch (e) {\n"
+      "    for (int i = 0; i < 9; i++) {\n"
+      "      if (fc[i] != (i < 5 ? 3.0 : 0.0)) errors++;\n"
+      "    }\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+  SetFlagScope<int> sfs2(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs3(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+
+  // The float loops are vectorized, and only by this pass.
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const char* kVectorized[] = {"addF32", "mulF64"};
+  Function& function = Function::Handle();
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kVectorized));
+       i++) {
+    function = GetFunction(library, kVectorized[i]);
+    FlowGraph* flow_graph = BuildOptimizedFlowGraph(thread, function);
+    EXPECT(flow_graph != NULL);
+    EXPECT_LT(0, CountInstructions(flow_graph, [](Instruction* instr) {
+                return instr->IsSimdOp();
+              }));
+    FLAG_loop_vectorization = false;
+    flow_graph = BuildOptimizedFlowGraph(thread, function);
+    FLAG_loop_vectorization = true;
+    EXPECT(flow_graph != NULL);
+    EXPECT_EQ(0, CountInstructions(flow_graph, [](Instruction* instr) {
+                return instr->IsSimdOp();
+              }));
+  }
+}
+
+}  // namespace dart
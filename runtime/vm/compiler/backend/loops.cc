@@ -11,11 +11,127 @@
 
 namespace dart {
 
+// Arithmetic on the constant parts of induction variables. Fails on
+// results outside the int32 range, which keeps all products exact.
+static bool SafeAdd(int64_t a, int64_t b, int64_t* c) {
+  *c = a + b;
+  return Utils::IsInt(32, a) && Utils::IsInt(32, b) && Utils::IsInt(32, *c);
+}
+
+static bool SafeMul(int64_t a, int64_t b, int64_t* c) {
+  *c = a * b;
+  return Utils::IsInt(32, a) && Utils::IsInt(32, b) && Utils::IsInt(32, *c);
+}
+
+// Returns x + y, or NULL if the sum cannot be represented.
+static InductionVar* Add(InductionVar* x, InductionVar* y) {
+  if (x->IsInvariant() && y->IsInvariant()) {
+    int64_t offset = 0;
+    if (!SafeAdd(x->offset(), y->offset(), &offset)) {
+      return nullptr;
+    } else if (x->IsConstant()) {
+      return new InductionVar(offset, y->mult(), y->def());
+    } else if (y->IsConstant()) {
+      return new InductionVar(offset, x->mult(), x->def());
+    } else if (x->def() == y->def()) {
+      int64_t mult = 0;
+      if (!SafeAdd(x->mult(), y->mult(), &mult)) {
+        return nullptr;
+      }
+      return (mult == 0) ? new InductionVar(offset)
+                         : new InductionVar(offset, mult, x->def());
+    }
+    return nullptr;
+  } else if (x->IsLinear() && y->IsInvariant()) {
+    InductionVar* initial = Add(x->initial(), y);
+    return (initial == nullptr) ? nullptr
+                                : new InductionVar(initial, x->stride());
+  } else if (x->IsInvariant() && y->IsLinear()) {
+    return Add(y, x);
+  }
+  ASSERT(x->IsLinear() && y->IsLinear());
+  InductionVar* initial = Add(x->initial(), y->initial());
+  int64_t stride = 0;
+  if ((initial == nullptr) || !SafeAdd(x->stride(), y->stride(), &stride)) {
+    return nullptr;
+  }
+  return (stride == 0) ? initial : new InductionVar(initial, stride);
+}
+
+// Returns c * x, or NULL if the product cannot be represented.
+static InductionVar* Mul(int64_t c, InductionVar* x) {
+  int64_t offset = 0;
+  int64_t mult = 0;
+  if (c == 0) {
+    return new InductionVar(0);
+  } else if (x->IsInvariant()) {
+    if (!SafeMul(c, x->offset(), &offset) || !SafeMul(c, x->mult(), &mult)) {
+      return nullptr;
+    }
+    return new InductionVar(offset, mult, x->def());
+  }
+  ASSERT(x->IsLinear());
+  InductionVar* initial = Mul(c, x->initial());
+  int64_t stride = 0;
+  if ((initial == nullptr) || !SafeMul(c, x->stride(), &stride)) {
+    return nullptr;
+  }
+  return new InductionVar(initial, stride);
+}
+
+// Returns x - y, or NULL if the difference cannot be represented.
+static InductionVar* Sub(InductionVar* x, InductionVar* y) {
+  InductionVar* minus_y = Mul(-1, y);
+  return (minus_y == nullptr) ? nullptr : Add(x, minus_y);
+}
+
+// Strips constraints and redefinitions from given definition.
+static Definition* Unwrap(Definition* def) {
+  while (def->IsConstraint() || def->IsRedefinition()) {
+    def = def->InputAt(0)->definition();
+  }
+  return def;
+}
+
+// Recognizes integer arithmetic, independent of its representation.
+static bool IsIntegerArithmetic(Definition* def,
+                                Token::Kind* op_kind,
+                                Definition** left,
+                                Definition** right) {
+  if (BinarySmiOpInstr* bin_op = def->AsBinarySmiOp()) {
+    *op_kind = bin_op->op_kind();
+    *left = bin_op->left()->definition();
+    *right = bin_op->right()->definition();
+    return true;
+  } else if (BinaryInt64OpInstr* bin_op = def->AsBinaryInt64Op()) {
+    *op_kind = bin_op->op_kind();
+    *left = bin_op->left()->definition();
+    *right = bin_op->right()->definition();
+    return true;
+  }
+  return false;
+}
+
+const char* InductionVar::ToCString() const {
+  char buffer[1024];
+  BufferFormatter f(buffer, sizeof(buffer));
+  if (IsInvariant()) {
+    f.Print("%" Pd64, offset_);
+    if (def_ != nullptr) {
+      f.Print(" + %" Pd64 " * v%" Pd, mult_, def_->ssa_temp_index());
+    }
+  } else {
+    f.Print("LIN(%s + %" Pd64 " * i)", initial_->ToCString(), stride_);
+  }
+  return Thread::Current()->zone()->MakeCopyOfString(buffer);
+}
+
 LoopInfo::LoopInfo(intptr_t id, BlockEntryInstr* header, BitVector* blocks)
     : id_(id),
       header_(header),
       blocks_(blocks),
       back_edges_(),
+      induction_(),
       outer_(nullptr),
       inner_(nullptr),
       next_(nullptr) {}
@@ -52,16 +168,29 @@ intptr_t LoopInfo::NestingDepth() const {
   return nesting_depth;
 }
 
+intptr_t LoopInfo::NumBlocks() const {
+  intptr_t num_blocks = 0;
+  for (BitVector::Iterator it(blocks_); !it.Done(); it.Advance()) {
+    num_blocks++;
+  }
+  return num_blocks;
+}
+
+bool LoopInfo::IsInvariant(Definition* def) const {
+  BlockEntryInstr* block = def->GetBlock();
+  return (block != nullptr) && !blocks_->Contains(block->preorder_number());
+}
+
+InductionVar* LoopInfo::LookupInduction(Definition* def) const {
+  return induction_.LookupValue(def);
+}
+
 const char* LoopInfo::ToCString() const {
   char buffer[1024];
   BufferFormatter f(buffer, sizeof(buffer));
   f.Print("%*c", static_cast<int>(2 * NestingDepth()), ' ');
   f.Print("loop%" Pd " B%" Pd " ", id_, header_->block_id());
-  intptr_t num_blocks = 0;
-  for (BitVector::Iterator it(blocks_); !it.Done(); it.Advance()) {
-    num_blocks++;
-  }
-  f.Print("#blocks=%" Pd, num_blocks);
+  f.Print("#blocks=%" Pd, NumBlocks());
   if (outer_) f.Print(" outer=%" Pd, outer_->id_);
   if (inner_) f.Print(" inner=%" Pd, inner_->id_);
   if (next_) f.Print(" next=%" Pd, next_->id_);
@@ -75,7 +204,10 @@ const char* LoopInfo::ToCString() const {
 
 LoopHierarchy::LoopHierarchy(ZoneGrowableArray<BlockEntryInstr*>* headers,
                              const GrowableArray<BlockEntryInstr*>& preorder)
-    : headers_(headers), preorder_(preorder), top_(nullptr) {
+    : headers_(headers),
+      preorder_(preorder),
+      top_(nullptr),
+      induction_computed_(false) {
   Build();
 }
 
@@ -114,6 +246,148 @@ void LoopHierarchy::Build() {
   }
 }
 
+void LoopHierarchy::ComputeInduction() const {
+  if (induction_computed_) {
+    return;
+  }
+  induction_computed_ = true;
+  for (intptr_t i = 0, n = headers_->length(); i < n; ++i) {
+    ComputeInduction((*headers_)[i]->loop_info());
+  }
+}
+
+void LoopHierarchy::ComputeInduction(LoopInfo* loop) const {
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if (header == nullptr) {
+    return;
+  }
+  // Basic induction variables are found at the header.
+  for (PhiIterator it(header); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    InductionVar* induc = ComputeBasic(loop, phi);
+    if (induc != nullptr) {
+      loop->induction_.Insert({phi, induc});
+    }
+  }
+  // Derived induction variables are found in the blocks of the loop,
+  // visited in preorder so that every operand precedes its uses.
+  for (BitVector::Iterator it(loop->blocks()); !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = preorder_[it.Current()];
+    for (ForwardInstructionIterator instr_it(block); !instr_it.Done();
+         instr_it.Advance()) {
+      Definition* def = instr_it.Current()->AsDefinition();
+      if (def != nullptr) {
+        InductionVar* induc = ComputeDerived(loop, def);
+        if (induc != nullptr) {
+          loop->induction_.Insert({def, induc});
+        }
+      }
+    }
+  }
+  if (FLAG_support_il_printer && FLAG_trace_optimization) {
+    auto it = loop->induction_.GetIterator();
+    for (auto* kv = it.Next(); kv != nullptr; kv = it.Next()) {
+      if (kv->value->IsLinear()) {
+        THR_Print("loop%" Pd " induction v%" Pd ": %s\n", loop->id(),
+                  kv->key->ssa_temp_index(), kv->value->ToCString());
+      }
+    }
+  }
+}
+
+// Recognizes v <- phi(x, v + c), with x invariant and c a constant.
+InductionVar* LoopHierarchy::ComputeBasic(LoopInfo* loop,
+                                          PhiInstr* phi) const {
+  if ((phi->InputCount() != 2) || (loop->back_edges_.length() != 1)) {
+    return nullptr;
+  }
+  const intptr_t backedge_idx =
+      loop->IsBackEdge(phi->block()->PredecessorAt(0)) ? 0 : 1;
+  InductionVar* initial =
+      Lookup(loop, phi->InputAt(1 - backedge_idx)->definition());
+  if ((initial == nullptr) || !initial->IsInvariant()) {
+    return nullptr;
+  }
+  Definition* next = Unwrap(phi->InputAt(backedge_idx)->definition());
+  Token::Kind op_kind;
+  Definition* left;
+  Definition* right;
+  if (!IsIntegerArithmetic(next, &op_kind, &left, &right)) {
+    return nullptr;
+  }
+  left = Unwrap(left);
+  right = Unwrap(right);
+  InductionVar* stride = nullptr;
+  if ((op_kind == Token::kADD) && (left == phi)) {
+    stride = Lookup(loop, right);
+  } else if ((op_kind == Token::kADD) && (right == phi)) {
+    stride = Lookup(loop, left);
+  } else if ((op_kind == Token::kSUB) && (left == phi)) {
+    stride = Lookup(loop, right);
+    stride = (stride == nullptr) ? nullptr : Mul(-1, stride);
+  }
+  if ((stride == nullptr) || !stride->IsConstant() ||
+      (stride->offset() == 0)) {
+    return nullptr;
+  }
+  return new InductionVar(initial, stride->offset());
+}
+
+InductionVar* LoopHierarchy::ComputeDerived(LoopInfo* loop,
+                                            Definition* def) const {
+  if (def->IsConstraint() || def->IsRedefinition()) {
+    return Lookup(loop, def->InputAt(0)->definition());
+  }
+  Token::Kind op_kind;
+  Definition* left;
+  Definition* right;
+  if (!IsIntegerArithmetic(def, &op_kind, &left, &right)) {
+    return nullptr;
+  }
+  InductionVar* x = Lookup(loop, left);
+  InductionVar* y = Lookup(loop, right);
+  if ((x == nullptr) || (y == nullptr) ||
+      (x->IsInvariant() && y->IsInvariant())) {
+    // Invariant arithmetic is not tracked, it is handled as an
+    // opaque invariant by Lookup().
+    return nullptr;
+  }
+  switch (op_kind) {
+    case Token::kADD:
+      return Add(x, y);
+    case Token::kSUB:
+      return Sub(x, y);
+    case Token::kMUL:
+      if (x->IsConstant()) {
+        return Mul(x->offset(), y);
+      } else if (y->IsConstant()) {
+        return Mul(y->offset(), x);
+      }
+      return nullptr;
+    default:
+      return nullptr;
+  }
+}
+
+InductionVar* LoopHierarchy::Lookup(LoopInfo* loop, Definition* def) const {
+  InductionVar* induc = loop->LookupInduction(def);
+  if (induc != nullptr) {
+    return induc;
+  }
+  if (ConstantInstr* constant = def->AsConstant()) {
+    const Object& value = constant->value();
+    if (value.IsInteger()) {
+      const int64_t c = Integer::Cast(value).AsInt64Value();
+      return Utils::IsInt(32, c) ? new InductionVar(c) : nullptr;
+    }
+    return nullptr;
+  }
+  if (!loop->IsInvariant(def)) {
+    return nullptr;
+  }
+  return new InductionVar(0, 1, def);
+}
+
 void LoopHierarchy::Print(LoopInfo* loop) {
   for (; loop != nullptr; loop = loop->next_) {
     THR_Print("%s {", loop->ToCString());
@@ -125,6 +399,32 @@ void LoopHierarchy::Print(LoopInfo* loop) {
   }
 }
 
+Token::Kind FlipComparison(Token::Kind kind) {
+  switch (kind) {
+    case Token::kEQ:
+      return Token::kEQ;
+    case Token::kNE:
+      return Token::kNE;
+    case Token::kLT:
+      return Token::kGT;
+    case Token::kGT:
+      return Token::kLT;
+    case Token::kLTE:
+      return Token::kGTE;
+    case Token::kGTE:
+      return Token::kLTE;
+    default:
+      UNREACHABLE();
+      return Token::kILLEGAL;
+  }
+}
+
+void SetPhiInput(PhiInstr* phi, intptr_t i, Definition* def) {
+  Value* input = new Value(def);
+  phi->SetInputAt(i, input);
+  def->AddInputUse(input);
+}
+
 }  // namespace dart
 
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
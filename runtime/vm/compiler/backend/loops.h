@@ -7,9 +7,79 @@
 
 #include "vm/allocation.h"
 #include "vm/compiler/backend/il.h"
+#include "vm/hash_map.h"
 
 namespace dart {
 
+// Information on an induction variable in a loop. Values are either
+// invariant in the loop, represented as
+//
+//   offset + mult * def   (def is defined outside the loop, or NULL)
+//
+// or linear in the number of iterations i of the loop, represented as
+//
+//   initial + stride * i  (initial is invariant, stride is a constant)
+//
+// Basic induction variables are the header phis that are linear, derived
+// induction variables are linear expressions computed from them.
+class InductionVar : public ZoneAllocated {
+ public:
+  enum Kind {
+    kInvariant,
+    kLinear,
+  };
+
+  // Constructor for an invariant.
+  InductionVar(int64_t offset, int64_t mult, Definition* def)
+      : kind_(kInvariant),
+        offset_(offset),
+        mult_(mult),
+        def_(def),
+        initial_(nullptr),
+        stride_(0) {
+    ASSERT((def != nullptr) || (mult == 0));
+  }
+
+  // Constructor for a constant.
+  explicit InductionVar(int64_t offset) : InductionVar(offset, 0, nullptr) {}
+
+  // Constructor for a linear induction.
+  InductionVar(InductionVar* initial, int64_t stride)
+      : kind_(kLinear),
+        offset_(0),
+        mult_(0),
+        def_(nullptr),
+        initial_(initial),
+        stride_(stride) {
+    ASSERT(initial->IsInvariant() && (stride != 0));
+  }
+
+  bool IsInvariant() const { return kind_ == kInvariant; }
+  bool IsLinear() const { return kind_ == kLinear; }
+  bool IsConstant() const { return IsInvariant() && (def_ == nullptr); }
+
+  // Getters.
+  Kind kind() const { return kind_; }
+  int64_t offset() const { return offset_; }
+  int64_t mult() const { return mult_; }
+  Definition* def() const { return def_; }
+  InductionVar* initial() const { return initial_; }
+  int64_t stride() const { return stride_; }
+
+  // For debugging.
+  const char* ToCString() const;
+
+ private:
+  const Kind kind_;
+  const int64_t offset_;
+  const int64_t mult_;
+  Definition* def_;
+  InductionVar* initial_;
+  const int64_t stride_;
+
+  DISALLOW_COPY_AND_ASSIGN(InductionVar);
+};
+
 // Information on a "natural loop" in the flow graph.
 class LoopInfo : public ZoneAllocated {
  public:
@@ -30,6 +100,16 @@ class LoopInfo : public ZoneAllocated {
   // Returns the nesting depth of this loop.
   intptr_t NestingDepth() const;
 
+  // Returns the number of blocks in this loop.
+  intptr_t NumBlocks() const;
+
+  // Returns true if given definition is computed outside this loop.
+  bool IsInvariant(Definition* def) const;
+
+  // Returns the induction information of given definition
+  // in this loop, or NULL if it is not an induction.
+  InductionVar* LookupInduction(Definition* def) const;
+
   // Getters.
   intptr_t id() const { return id_; }
   BlockEntryInstr* header() const { return header_; }
@@ -59,6 +139,10 @@ class LoopInfo : public ZoneAllocated {
   // Back edges of loop (usually one).
   GrowableArray<BlockEntryInstr*> back_edges_;
 
+  // Induction variables of loop, filled in by LoopHierarchy.
+  DirectChainedHashMap<RawPointerKeyValueTrait<Definition, InductionVar*> >
+      induction_;
+
   // Loop hierarchy.
   LoopInfo* outer_;
   LoopInfo* inner_;
@@ -82,17 +166,35 @@ class LoopHierarchy : public ZoneAllocated {
   // Returns total number of loops in the hierarchy.
   intptr_t num_loops() const { return headers_->length(); }
 
+  // Performs induction variable analysis on every loop. Is idempotent,
+  // the analysis is only done on the first call.
+  void ComputeInduction() const;
+
  private:
   void Build();
   void Print(LoopInfo* loop);
 
+  void ComputeInduction(LoopInfo* loop) const;
+  InductionVar* ComputeBasic(LoopInfo* loop, PhiInstr* phi) const;
+  InductionVar* ComputeDerived(LoopInfo* loop, Definition* def) const;
+  InductionVar* Lookup(LoopInfo* loop, Definition* def) const;
+
   ZoneGrowableArray<BlockEntryInstr*>* headers_;
   const GrowableArray<BlockEntryInstr*>& preorder_;
   LoopInfo* top_;
+  mutable bool induction_computed_;
 
   DISALLOW_COPY_AND_ASSIGN(LoopHierarchy);
 };
 
+// Helpers shared by the loop transformations.
+
+// Returns the comparison with the operands swapped: a (op) b === b (op') a.
+Token::Kind FlipComparison(Token::Kind kind);
+
+// Makes given definition the input i of given phi.
+void SetPhiInput(PhiInstr* phi, intptr_t i, Definition* def);
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_COMPILER_BACKEND_LOOPS_H_
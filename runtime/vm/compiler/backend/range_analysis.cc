@@ -273,28 +273,6 @@ void RangeAnalysis::CollectValues() {
   }
 }
 
-// For a comparison operation return an operation for the equivalent flipped
-// comparison: a (op) b === b (op') a.
-static Token::Kind FlipComparison(Token::Kind op) {
-  switch (op) {
-    case Token::kEQ:
-      return Token::kEQ;
-    case Token::kNE:
-      return Token::kNE;
-    case Token::kLT:
-      return Token::kGT;
-    case Token::kGT:
-      return Token::kLT;
-    case Token::kLTE:
-      return Token::kGTE;
-    case Token::kGTE:
-      return Token::kLTE;
-    default:
-      UNREACHABLE();
-      return Token::kILLEGAL;
-  }
-}
-
 // Given a boundary (right operand) and a comparison operation return
 // a symbolic range constraint for the left operand of the comparison assuming
 // that it evaluated to true.
@@ -919,6 +897,7 @@ class BoundsCheckGeneralizer {
         THR_Print("Failed to construct upper bound for %s index\n",
                   check->ToCString());
       }
+      TryGeneralizeInduction(check, array_length);
       return;
     }
 
@@ -1043,6 +1022,146 @@ class BoundsCheckGeneralizer {
     }
   }
 
+  // Attempt to hoist the check using the induction variables of the
+  // innermost loop around it. Given a linear index x and a linear q that
+  // is compared against an invariant n in the loop header
+  //
+  //          x = x0 + s * i
+  //          q = q0 + t * i,  q < n (or <=, >, >=)
+  //
+  // where s = m * t, the index is x0 + m * (q - q0) in every iteration.
+  // Hence all values of the index lie between x0 and x0 + m * (Q - q0),
+  // where Q is the last value of q the header test lets into the loop.
+  // This handles loops that SimpleInductionVariable does not describe,
+  // such as strided and descending loops.
+  void TryGeneralizeInduction(CheckArrayBoundInstr* check,
+                              const RangeBoundary& array_length) {
+    LoopInfo* loop = check->GetBlock()->loop_info();
+    if (loop == NULL) {
+      return;
+    }
+    InductionVar* x = loop->LookupInduction(check->index()->definition());
+    if ((x == NULL) || !x->IsLinear()) {
+      return;
+    }
+
+    // Find the test that keeps the loop running.
+    BranchInstr* branch = loop->header()->last_instruction()->AsBranch();
+    if (branch == NULL) {
+      return;
+    }
+    RelationalOpInstr* compare = branch->comparison()->AsRelationalOp();
+    if ((compare == NULL) || (compare->operation_cid() != kSmiCid)) {
+      return;
+    }
+    BlockEntryInstr* body = NULL;
+    Token::Kind kind = compare->kind();
+    if (!IsInLoop(loop, branch->false_successor())) {
+      body = branch->true_successor();
+    } else if (!IsInLoop(loop, branch->true_successor())) {
+      body = branch->false_successor();
+      kind = Token::NegateComparison(kind);
+    }
+    if ((body == NULL) || !body->Dominates(check->GetBlock())) {
+      return;
+    }
+    Definition* left = compare->left()->definition();
+    Definition* right = compare->right()->definition();
+    if (!loop->IsInvariant(right)) {
+      Definition* tmp = left;
+      left = right;
+      right = tmp;
+      kind = FlipComparison(kind);
+    }
+    InductionVar* q = loop->LookupInduction(left);
+    if ((q == NULL) || !q->IsLinear() || !loop->IsInvariant(right) ||
+        ((x->stride() % q->stride()) != 0)) {
+      return;
+    }
+    const int64_t m = x->stride() / q->stride();
+
+    // Compute the last value of q let into the loop.
+    intptr_t adjust = 0;
+    if ((q->stride() > 0) && (kind == Token::kLT)) {
+      adjust = -1;
+    } else if ((q->stride() < 0) && (kind == Token::kGT)) {
+      adjust = 1;
+    } else if (!(((q->stride() > 0) && (kind == Token::kLTE)) ||
+                 ((q->stride() < 0) && (kind == Token::kGTE)))) {
+      return;
+    }
+    Definition* q_last = UnwrapConstraint(right);
+    if (q_last->Type()->ToCid() != kSmiCid) {
+      return;
+    }
+    if (adjust != 0) {
+      q_last = MakeBinaryOp(Token::kADD, q_last, adjust);
+    }
+
+    Definition* x_first = InvariantToDefinition(x->initial());
+    Definition* q_first = InvariantToDefinition(q->initial());
+    if ((x_first == NULL) || (q_first == NULL) || !Smi::IsValid(m)) {
+      return;
+    }
+    // Simplify rewrites floating subexpressions in place, so x_last is
+    // built from its own copy of x0.
+    Definition* x_last = MakeBinaryOp(
+        Token::kADD, InvariantToDefinition(x->initial()),
+        MakeBinaryOp(Token::kMUL,
+                     MakeBinaryOp(Token::kSUB, q_last, q_first), m));
+    if (!Simplify(&x_last, NULL)) {
+      return;
+    }
+
+    Definition* lower_bound = (x->stride() > 0) ? x_first : x_last;
+    Definition* upper_bound = (x->stride() > 0) ? x_last : x_first;
+    range_analysis_->AssignRangesRecursively(lower_bound);
+    range_analysis_->AssignRangesRecursively(upper_bound);
+
+#ifndef PRODUCT
+    if (FLAG_support_il_printer && FLAG_trace_range_analysis) {
+      THR_Print("For %s induction %s computed index bounds [%s, %s]\n",
+                check->ToCString(), x->ToCString(),
+                IndexBoundToCString(lower_bound),
+                IndexBoundToCString(upper_bound));
+    }
+#endif  // !PRODUCT
+
+    scheduler_.Start();
+
+    if (!RangeUtils::IsPositive(lower_bound->range())) {
+      ConstantInstr* max_smi =
+          flow_graph_->GetConstant(Smi::Handle(Smi::New(Smi::kMaxValue)));
+      CheckArrayBoundInstr* precondition = new CheckArrayBoundInstr(
+          new Value(max_smi), new Value(lower_bound), DeoptId::kNone);
+      precondition->mark_generalized();
+      if (scheduler_.Emit(precondition, check) == NULL) {
+        if (FLAG_trace_range_analysis) {
+          THR_Print("  => failed to insert positivity constraint\n");
+        }
+        scheduler_.Rollback();
+        return;
+      }
+    }
+
+    CheckArrayBoundInstr* new_check = new CheckArrayBoundInstr(
+        new Value(UnwrapConstraint(check->length()->definition())),
+        new Value(upper_bound), DeoptId::kNone);
+    new_check->mark_generalized();
+    if (!new_check->IsRedundant(array_length) &&
+        (scheduler_.Emit(new_check, check) == NULL)) {
+      if (FLAG_trace_range_analysis) {
+        THR_Print("  => generalized check can't be hoisted\n");
+      }
+      scheduler_.Rollback();
+      return;
+    }
+    if (FLAG_trace_range_analysis) {
+      THR_Print("  => generalized check was hoisted\n");
+    }
+    RemoveGeneralizedCheck(check);
+  }
+
   static void RemoveGeneralizedCheck(CheckArrayBoundInstr* check) {
     BinarySmiOpInstr* binary_op = check->index()->definition()->AsBinarySmiOp();
     if (binary_op != NULL) {
@@ -1067,6 +1186,33 @@ class BoundsCheckGeneralizer {
     return MakeBinaryOp(op_kind, left, constant_right);
   }
 
+  // Convert invariant offset + mult * def into a floating expression,
+  // or return NULL if it is not a Smi expression.
+  Definition* InvariantToDefinition(InductionVar* invariant) {
+    ASSERT(invariant->IsInvariant());
+    if (!Smi::IsValid(invariant->offset()) ||
+        !Smi::IsValid(invariant->mult())) {
+      return NULL;
+    }
+    const intptr_t offset = static_cast<intptr_t>(invariant->offset());
+    if (invariant->IsConstant()) {
+      return flow_graph_->GetConstant(Smi::Handle(Smi::New(offset)));
+    }
+    Definition* def = UnwrapConstraint(invariant->def());
+    if (def->Type()->ToCid() != kSmiCid) {
+      return NULL;
+    }
+    if (invariant->mult() != 1) {
+      def = MakeBinaryOp(Token::kMUL, def,
+                         static_cast<intptr_t>(invariant->mult()));
+    }
+    return (offset == 0) ? def : MakeBinaryOp(Token::kADD, def, offset);
+  }
+
+  static bool IsInLoop(LoopInfo* loop, BlockEntryInstr* block) {
+    return loop->blocks()->Contains(block->preorder_number());
+  }
+
   Definition* RangeBoundaryToDefinition(const RangeBoundary& bound) {
     Definition* symbol = UnwrapConstraint(bound.symbol());
     if (bound.offset() == 0) {
@@ -1443,6 +1589,9 @@ void RangeAnalysis::EliminateRedundantBoundsChecks() {
         !FLAG_precompiled_mode;
 
     BoundsCheckGeneralizer generalizer(this, flow_graph_);
+    if (try_generalization) {
+      flow_graph_->GetLoopHierarchy().ComputeInduction();
+    }
 
     for (intptr_t i = 0; i < bounds_checks_.length(); i++) {
       CheckArrayBoundInstr* check = bounds_checks_[i];
@@ -2821,6 +2970,11 @@ void IfThenElseInstr::InferRange(RangeAnalysis* analysis, Range* range) {
       Range(RangeBoundary::FromConstant(min), RangeBoundary::FromConstant(max));
 }
 
+void SmiBitLengthInstr::InferRange(RangeAnalysis* analysis, Range* range) {
+  *range = Range(RangeBoundary::FromConstant(0),
+                 RangeBoundary::FromConstant(kSmiBits));
+}
+
 static RangeBoundary::RangeSize RepresentationToRangeSize(Representation r) {
   switch (r) {
     case kTagged:
@@ -3,6 +3,10 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/compiler/backend/range_analysis.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -636,4 +640,75 @@ TEST_CASE(RangeJoinMinMax) {
           .IsMaximumOrAbove(size));
 }
 
+// Runs strided and descending loops, whose bounds checks are hoisted using
+// induction variables, long enough to get them optimized. The last call
+// fails a hoisted check and must still throw where the original check did.
+// main returns the number of wrong results. The strided and descending loops
+// must then compile with generalized checks in their preheaders.
+TEST_CASE(RangeAnalysis_InductionBoundsChecks) {
+  const char* kScriptChars =
+      "int strided(List<int> a) {\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < a.length - 1; i += 2) s += a[i] * a[i + 1];\n"
+      "  return s;\n"
+      "}\n"
+      "int descending(List<int> a) {\n"
+      "  int s = 0;\n"
+      "  for (int i = a.length - 1; i >= 0; i--) s = s * 3 + a[i];\n"
+      "  return s;\n"
+      "}\n"
+      "int pairs(List<int> a, int n) {\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < n; i++) s += a[2 * i + 1];\n"
+      "  return s;\n"
+      "}\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  for (int round = 0; round < 50; round++) {\n"
+      "    var a = new List<int>.generate(round % 7 + 2, (i) => i + 1);\n"
+      "    int s1 = 0, s2 = 0, s3 = 0;\n"
+      "    for (int i = 0; i + 1 < a.length; i += 2) s1 += a[i] * a[i + 1];\n"
+      "    for (int i = a.length - 1; i >= 0; i--) s2 = s2 * 3 + a[i];\n"
+      "    for (int i = 0; i < a.length ~/ 2; i++) s3 += a[2 * i + 1];\n"
+      "    if (strided(a) != s1) errors++;\n"
+      "    if (descending(a) != s2) errors++;\n"
+      "    if (pairs(a, a.length ~/ 2) != s3) errors++;\n"
+      "  }\n"
+      "  try {\n"
+      "    pairs([1, 2, 3, 4, 5], 3);\n"
+      "    errors++;\n"
+      "  } on RangeError catch (e) {\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+
+  // The generalization of pairs was disabled by the failed check.
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const char* kGeneralized[] = {"strided", "descending"};
+  Function& function = Function::Handle();
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kGeneralized));
+       i++) {
+    function = GetFunction(library, kGeneralized[i]);
+    FlowGraph* flow_graph = BuildOptimizedFlowGraph(thread, function);
+    EXPECT(flow_graph != NULL);
+    EXPECT_LT(0, CountInstructions(flow_graph, [](Instruction* instr) {
+                return instr->IsCheckArrayBound() &&
+                       instr->AsCheckArrayBound()->generalized();
+              }));
+  }
+}
+
 }  // namespace dart
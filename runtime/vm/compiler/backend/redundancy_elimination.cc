@@ -2640,6 +2640,29 @@ static bool IsAllocationSinkingCandidate(Definition* alloc,
   return true;
 }
 
+// Redefinitions of a fresh allocation constrain nothing: the allocation has
+// an exact non-nullable type. They are only left in the graph as barriers for
+// code motion, which has already happened when allocation sinking runs, but
+// would make the allocation look escaping. Route their uses to the
+// allocation itself, including through chains of redefinitions.
+static void RemoveRedefinitionsOf(Definition* alloc) {
+  GrowableArray<RedefinitionInstr*> redefinitions;
+  do {
+    redefinitions.Clear();
+    for (Value* use = alloc->input_use_list(); use != NULL;
+         use = use->next_use()) {
+      RedefinitionInstr* redefinition = use->instruction()->AsRedefinition();
+      if (redefinition != NULL) {
+        redefinitions.Add(redefinition);
+      }
+    }
+    for (intptr_t i = 0; i < redefinitions.length(); i++) {
+      redefinitions[i]->ReplaceUsesWith(alloc);
+      redefinitions[i]->RemoveFromGraph();
+    }
+  } while (!redefinitions.is_empty());
+}
+
 // If the given use is a store into an object then return an object we are
 // storing into.
 static Definition* StoreInto(Value* use) {
@@ -2700,6 +2723,7 @@ void AllocationSinking::CollectCandidates() {
       }
 
       Definition* alloc = current->Cast<Definition>();
+      RemoveRedefinitionsOf(alloc);
       if (IsAllocationSinkingCandidate(alloc, kOptimisticCheck)) {
         alloc->SetIdentity(AliasIdentity::AllocationSinkingCandidate());
         candidates_.Add(alloc);
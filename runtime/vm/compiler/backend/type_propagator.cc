@@ -1365,6 +1365,10 @@ CompileType UnarySmiOpInstr::ComputeType() const {
   return CompileType::FromCid(kSmiCid);
 }
 
+CompileType SmiBitLengthInstr::ComputeType() const {
+  return CompileType::FromCid(kSmiCid);
+}
+
 CompileType UnaryDoubleOpInstr::ComputeType() const {
   return CompileType::FromCid(kDoubleCid);
 }
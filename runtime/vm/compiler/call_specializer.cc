@@ -1545,6 +1545,79 @@ void CallSpecializer::VisitLoadCodeUnits(LoadCodeUnitsInstr* instr) {
 #endif
 }
 
+// Replace generic context allocation or cloning with a sequence of inlined
+// allocation and explicit initializing stores.
+// If context_value is not NULL then newly allocated context is a populated
+// with values copied from it, otherwise it is initialized with null.
+void CallSpecializer::LowerContextAllocation(Definition* alloc,
+                                             intptr_t num_context_variables,
+                                             Value* context_value) {
+  ASSERT(alloc->IsAllocateContext() || alloc->IsCloneContext());
+
+  AllocateUninitializedContextInstr* replacement =
+      new AllocateUninitializedContextInstr(alloc->token_pos(),
+                                            num_context_variables);
+  alloc->ReplaceWith(replacement, current_iterator());
+
+  Definition* cursor = replacement;
+
+  Value* initial_value;
+  if (context_value != NULL) {
+    LoadFieldInstr* load = new (Z)
+        LoadFieldInstr(context_value->CopyWithType(Z), Context::parent_offset(),
+                       AbstractType::ZoneHandle(Z), alloc->token_pos());
+    flow_graph()->InsertAfter(cursor, load, NULL, FlowGraph::kValue);
+    cursor = load;
+    initial_value = new (Z) Value(load);
+  } else {
+    initial_value = new (Z) Value(flow_graph()->constant_null());
+  }
+  StoreInstanceFieldInstr* store = new (Z) StoreInstanceFieldInstr(
+      Context::parent_offset(), new (Z) Value(replacement), initial_value,
+      kNoStoreBarrier, alloc->token_pos());
+  // Storing into uninitialized memory; remember to prevent dead store
+  // elimination and ensure proper GC barrier.
+  store->set_is_initialization(true);
+  flow_graph()->InsertAfter(cursor, store, NULL, FlowGraph::kEffect);
+  cursor = replacement;
+
+  for (intptr_t i = 0; i < num_context_variables; ++i) {
+    if (context_value != NULL) {
+      LoadFieldInstr* load = new (Z) LoadFieldInstr(
+          context_value->CopyWithType(Z), Context::variable_offset(i),
+          AbstractType::ZoneHandle(Z), alloc->token_pos());
+      flow_graph()->InsertAfter(cursor, load, NULL, FlowGraph::kValue);
+      cursor = load;
+      initial_value = new (Z) Value(load);
+    } else {
+      initial_value = new (Z) Value(flow_graph()->constant_null());
+    }
+
+    store = new (Z) StoreInstanceFieldInstr(
+        Context::variable_offset(i), new (Z) Value(replacement), initial_value,
+        kNoStoreBarrier, alloc->token_pos());
+    // Storing into uninitialized memory; remember to prevent dead store
+    // elimination and ensure proper GC barrier.
+    store->set_is_initialization(true);
+    flow_graph()->InsertAfter(cursor, store, NULL, FlowGraph::kEffect);
+    cursor = store;
+  }
+}
+
+void CallSpecializer::VisitAllocateContext(AllocateContextInstr* instr) {
+  LowerContextAllocation(instr, instr->num_context_variables(), NULL);
+}
+
+void CallSpecializer::VisitCloneContext(CloneContextInstr* instr) {
+  if (instr->num_context_variables() ==
+      CloneContextInstr::kUnknownContextSize) {
+    return;
+  }
+
+  LowerContextAllocation(instr, instr->num_context_variables(),
+                         instr->context_value());
+}
+
 static bool CidTestResultsContains(const ZoneGrowableArray<intptr_t>& results,
                                    intptr_t test_cid) {
   for (intptr_t i = 0; i < results.length(); i += 2) {
@@ -61,6 +61,12 @@ class CallSpecializer : public FlowGraphVisitor {
   // Find a better place for them.
   virtual void VisitLoadCodeUnits(LoadCodeUnitsInstr* instr);
 
+  // Lowered contexts are allocated with explicit initializing stores, which
+  // makes those that do not escape candidates for allocation sinking in both
+  // JIT and AOT compilation.
+  virtual void VisitAllocateContext(AllocateContextInstr* instr);
+  virtual void VisitCloneContext(CloneContextInstr* instr);
+
  protected:
   Thread* thread() const { return flow_graph_->thread(); }
   Isolate* isolate() const { return flow_graph_->isolate(); }
@@ -85,6 +91,10 @@ class CallSpecializer : public FlowGraphVisitor {
 
   void ReplaceCall(Definition* call, Definition* replacement);
 
+  void LowerContextAllocation(Definition* instr,
+                              intptr_t num_context_variables,
+                              Value* context_value);
+
   // Add a class check for the call's first argument (receiver).
   void AddReceiverCheck(InstanceCallInstr* call) {
     AddChecksForArgNr(call, call->Receiver()->definition(),
@@ -12,6 +12,8 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_unroller.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
@@ -19,6 +21,10 @@
 #if defined(DART_PRECOMPILER)
 #include "vm/compiler/aot/aot_call_specializer.h"
 #endif
+#include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
 #include "vm/timeline.h"
 
 #define COMPILER_PASS_REPEAT(Name, Body)                                       \
@@ -173,16 +179,166 @@ void CompilerPass::Run(CompilerPassState* state) const {
 
     PrintGraph(state, kTraceBefore, round);
     {
-      NOT_IN_PRODUCT(
-          TimelineDurationScope tds2(thread, state->compiler_timeline, name()));
+#ifndef PRODUCT
+      TimelineDurationScope tds2(thread, state->compiler_timeline, name());
+      const int64_t start_micros = OS::GetCurrentMonotonicMicros();
+      const uintptr_t start_capacity = thread->current_zone_capacity();
+      const uintptr_t high_watermark = thread->zone_high_watermark();
+      thread->ResetHighWatermark();
+#endif  // !PRODUCT
       repeat = DoBody(state);
       DEBUG_ASSERT(state->flow_graph->VerifyUseLists());
+#ifndef PRODUCT
+      const int64_t micros = OS::GetCurrentMonotonicMicros() - start_micros;
+      const uintptr_t zone_bytes =
+          thread->zone_high_watermark() - start_capacity;
+      thread->RestoreHighWatermark(high_watermark);
+      tds2.SetNumArguments(1);
+      tds2.FormatArgument(0, "zoneBytes", "%" Pu, zone_bytes);
+      if (FLAG_compiler_pass_stats) {
+        RecordStats(state, micros, zone_bytes);
+      }
+#endif  // !PRODUCT
       thread->CheckForSafepoint();
     }
     PrintGraph(state, kTraceAfter, round);
   }
 }
 
+#ifndef PRODUCT
+static intptr_t CountInstructions(FlowGraph* flow_graph) {
+  intptr_t instructions = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      instructions++;
+    }
+  }
+  return instructions;
+}
+
+void CompilerPass::RecordInitialStats(CompilerPassState* state) {
+  if (!FLAG_compiler_pass_stats) {
+    return;
+  }
+  const intptr_t instructions = CountInstructions(state->flow_graph);
+  Isolate* isolate = state->thread->isolate();
+  MutexLocker ml(isolate->mutex());
+  isolate->compiler_pass_stats()->AddInitialInstructions(instructions);
+}
+
+void CompilerPass::RecordStats(CompilerPassState* state,
+                               int64_t micros,
+                               uintptr_t zone_bytes) const {
+  FlowGraph* flow_graph = state->flow_graph;
+  const intptr_t instructions = CountInstructions(flow_graph);
+  Isolate* isolate = state->thread->isolate();
+  MutexLocker ml(isolate->mutex());
+  CompilerPassStats* stats = isolate->compiler_pass_stats();
+  stats->Add(id_, flow_graph->function(), micros, zone_bytes, instructions);
+  if (id_ == kAllocateRegisters) {
+    stats->AddSpillSlots(flow_graph->graph_entry()->spill_slot_count());
+  }
+}
+#endif  // !PRODUCT
+
+CompilerPassStats::CompilerPassStats() {
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    entries_[i].max_micros_function = NULL;
+    entries_[i].max_zone_bytes_function = NULL;
+  }
+  Clear();
+}
+
+CompilerPassStats::~CompilerPassStats() {
+  Clear();
+}
+
+void CompilerPassStats::Add(CompilerPass::Id id,
+                            const Function& function,
+                            int64_t micros,
+                            uintptr_t zone_bytes,
+                            intptr_t instructions) {
+  Entry* entry = &entries_[id];
+  entry->count++;
+  entry->total_instructions += instructions;
+  entry->total_micros += micros;
+  entry->total_zone_bytes += zone_bytes;
+  if ((entry->max_micros_function == NULL) || (micros > entry->max_micros)) {
+    entry->max_micros = micros;
+    free(entry->max_micros_function);
+    entry->max_micros_function = strdup(function.ToFullyQualifiedCString());
+  }
+  if ((entry->max_zone_bytes_function == NULL) ||
+      (zone_bytes > entry->max_zone_bytes)) {
+    entry->max_zone_bytes = zone_bytes;
+    free(entry->max_zone_bytes_function);
+    entry->max_zone_bytes_function = strdup(function.ToFullyQualifiedCString());
+  }
+}
+
+void CompilerPassStats::AddCode(bool optimized, intptr_t code_size) {
+  if (optimized) {
+    optimized_code_count_++;
+    optimized_code_size_ += code_size;
+  } else {
+    unoptimized_code_count_++;
+    unoptimized_code_size_ += code_size;
+  }
+}
+
+void CompilerPassStats::Clear() {
+  unoptimized_code_count_ = 0;
+  unoptimized_code_size_ = 0;
+  optimized_code_count_ = 0;
+  optimized_code_size_ = 0;
+  total_initial_instructions_ = 0;
+  total_spill_slots_ = 0;
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    Entry* entry = &entries_[i];
+    entry->count = 0;
+    entry->total_micros = 0;
+    entry->max_micros = 0;
+    entry->total_zone_bytes = 0;
+    entry->max_zone_bytes = 0;
+    entry->total_instructions = 0;
+    free(entry->max_micros_function);
+    entry->max_micros_function = NULL;
+    free(entry->max_zone_bytes_function);
+    entry->max_zone_bytes_function = NULL;
+  }
+}
+
+#ifndef PRODUCT
+void CompilerPassStats::PrintToJSONObject(JSONObject* obj) const {
+  obj->AddProperty("unoptimizedCodeCount", unoptimized_code_count_);
+  obj->AddProperty64("unoptimizedCodeSize", unoptimized_code_size_);
+  obj->AddProperty("optimizedCodeCount", optimized_code_count_);
+  obj->AddProperty64("optimizedCodeSize", optimized_code_size_);
+  obj->AddProperty64("totalInitialInstructions", total_initial_instructions_);
+  obj->AddProperty64("totalSpillSlots", total_spill_slots_);
+  JSONArray passes(obj, "passes");
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    const Entry& entry = entries_[i];
+    CompilerPass* pass = CompilerPass::Get(static_cast<CompilerPass::Id>(i));
+    if ((entry.count == 0) || (pass == NULL)) {
+      continue;
+    }
+    JSONObject jspass(&passes);
+    jspass.AddProperty("name", pass->name());
+    jspass.AddProperty("count", entry.count);
+    jspass.AddProperty64("totalMicros", entry.total_micros);
+    jspass.AddProperty64("maxMicros", entry.max_micros);
+    jspass.AddProperty("maxMicrosFunction", entry.max_micros_function);
+    jspass.AddProperty64("totalZoneBytes", entry.total_zone_bytes);
+    jspass.AddProperty64("maxZoneBytes", entry.max_zone_bytes);
+    jspass.AddProperty("maxZoneBytesFunction", entry.max_zone_bytes_function);
+    jspass.AddProperty64("totalInstructions", entry.total_instructions);
+  }
+}
+#endif  // !PRODUCT
+
 void CompilerPass::PrintGraph(CompilerPassState* state,
                               Flag mask,
                               intptr_t round) const {
@@ -205,8 +361,40 @@ void CompilerPass::PrintGraph(CompilerPassState* state,
 #define INVOKE_PASS(Name)                                                      \
   CompilerPass::Get(CompilerPass::k##Name)->Run(pass_state);
 
+// Specializes calls with the type feedback, inlines only trivial callees and
+// allocates registers, leaving out range analysis, loop optimizations,
+// allocation sinking and the other expensive passes.
+void CompilerPass::RunIntermediatePipeline(CompilerPassState* pass_state) {
+  NOT_IN_PRODUCT(RecordInitialStats(pass_state));
+  INVOKE_PASS(ComputeSSA);
+  INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(TryOptimizePatterns);
+  INVOKE_PASS(SetOuterInliningId);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyClassIds);
+  INVOKE_PASS(Inlining);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyClassIds);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(SelectRepresentations);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(EliminateDeadPhis);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(WriteBarrierElimination);
+  INVOKE_PASS(FinalizeGraph);
+  INVOKE_PASS(AllocateRegisters);
+  INVOKE_PASS(ReorderBlocks);
+}
+
 void CompilerPass::RunPipeline(PipelineMode mode,
                                CompilerPassState* pass_state) {
+  if (mode == kJITIntermediate) {
+    RunIntermediatePipeline(pass_state);
+    return;
+  }
+  NOT_IN_PRODUCT(RecordInitialStats(pass_state));
   INVOKE_PASS(ComputeSSA);
 #if defined(DART_PRECOMPILER)
   if (mode == kAOT) {
@@ -249,6 +437,8 @@ void CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(RangeAnalysis);
   INVOKE_PASS(OptimizeBranches);
+  INVOKE_PASS(VectorizeLoops);
+  INVOKE_PASS(UnrollLoops);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(TryCatchOptimization);
   INVOKE_PASS(EliminateEnvironments);
@@ -270,9 +460,7 @@ void CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(WriteBarrierElimination);
   INVOKE_PASS(FinalizeGraph);
   INVOKE_PASS(AllocateRegisters);
-  if (mode == kJIT) {
-    INVOKE_PASS(ReorderBlocks);
-  }
+  INVOKE_PASS(ReorderBlocks);
 }
 
 COMPILER_PASS(ComputeSSA, {
@@ -368,6 +556,21 @@ COMPILER_PASS(OptimizeBranches, {
   ConstantPropagator::OptimizeBranches(flow_graph);
 });
 
+COMPILER_PASS(VectorizeLoops, { LoopVectorizer::Optimize(flow_graph); });
+
+COMPILER_PASS(UnrollLoops, {
+  // Copies of the loop invariant instructions in a peeled iteration make
+  // the ones in the loop redundant.
+  if (LoopUnroller::Optimize(flow_graph)) {
+    DominatorBasedCSE::Optimize(flow_graph);
+    flow_graph->RenameUsesDominatedByRedefinitions();
+    DEBUG_ASSERT(flow_graph->VerifyRedefinitions());
+    LICM licm(flow_graph);
+    licm.Optimize();
+    flow_graph->RemoveRedefinitions();
+  }
+});
+
 COMPILER_PASS(TryCatchOptimization,
               { TryCatchAnalyzer::Optimize(flow_graph); });
 
@@ -408,33 +611,123 @@ COMPILER_PASS(ReorderBlocks, {
   }
 });
 
-static void WriteBarrierElimination(FlowGraph* flow_graph) {
-  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
-       !block_it.Done(); block_it.Advance()) {
-    BlockEntryInstr* block = block_it.Current();
-    Definition* last_allocated = nullptr;
-    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
-      Instruction* current = it.Current();
-      if (StoreInstanceFieldInstr* instr = current->AsStoreInstanceField()) {
-        if (!current->CanTriggerGC()) {
-          if (instr->instance()->definition() == last_allocated) {
-            instr->set_emit_store_barrier(kNoStoreBarrier);
-          }
-          continue;
+// Computes the set of objects known to be in new space or remembered on entry
+// to [block] from the sets its predecessors end with.
+static void WriteBarrierEliminationBlockEntry(
+    BlockEntryInstr* block,
+    const GrowableArray<BitVector*>& allocated_out,
+    BitVector* allocated) {
+  // Entries reached from outside the normal control flow (the graph,
+  // function, OSR, catch and indirect entries) start with nothing.
+  if ((block->PredecessorCount() == 0) || block->IsCatchBlockEntry() ||
+      block->IsIndirectEntry() || block->IsOsrEntry() ||
+      block->IsFunctionEntry()) {
+    allocated->Clear();
+    return;
+  }
+  allocated->SetAll();
+  for (intptr_t i = 0; i < block->PredecessorCount(); ++i) {
+    allocated->Intersect(
+        allocated_out[block->PredecessorAt(i)->preorder_number()]);
+  }
+}
+
+// Updates [allocated], the set of objects (by SSA temp index) that are known
+// to be in new space or remembered, across [current]. If [eliminate] is set,
+// stores into such objects are marked as not needing a barrier.
+static void WriteBarrierEliminationTransfer(Instruction* current,
+                                            BitVector* allocated,
+                                            bool eliminate) {
+  if (StoreInstanceFieldInstr* instr = current->AsStoreInstanceField()) {
+    if (!current->CanTriggerGC()) {
+      if (eliminate) {
+        Definition* instance = instr->instance()->definition();
+        if (instance->HasSSATemp() &&
+            allocated->Contains(instance->ssa_temp_index())) {
+          instr->set_emit_store_barrier(kNoStoreBarrier);
         }
       }
+      return;
+    }
+  }
 
-      AllocationInstr* alloc = current->AsAllocation();
-      if (alloc != nullptr && alloc->WillAllocateNewOrRemembered()) {
-        last_allocated = alloc;
-        continue;
+  // Only arrays known to be in new space get here: CreateArray reports
+  // WillAllocateNewOrRemembered only for small constant lengths.
+  if (StoreIndexedInstr* instr = current->AsStoreIndexed()) {
+    if (!current->CanTriggerGC()) {
+      if (eliminate) {
+        Definition* array = instr->array()->definition();
+        if (array->HasSSATemp() &&
+            allocated->Contains(array->ssa_temp_index())) {
+          instr->set_emit_store_barrier(kNoStoreBarrier);
+        }
       }
+      return;
+    }
+  }
+
+  if (current->CanTriggerGC()) {
+    // A GC may promote anything allocated so far, including the result of
+    // this instruction if it is an allocation.
+    allocated->Clear();
+  }
+
+  AllocationInstr* alloc = current->AsAllocation();
+  if ((alloc != nullptr) && alloc->HasSSATemp() &&
+      alloc->WillAllocateNewOrRemembered()) {
+    allocated->Add(alloc->ssa_temp_index());
+  }
+}
+
+// Removes barriers from stores into objects that were allocated in new space
+// (or remembered) with no possible GC on any path in between. The set of such
+// objects is propagated across blocks: a block starts with the intersection
+// of the sets its predecessors end with, so loops that cannot GC keep their
+// stores into objects allocated ahead of the loop barrier-free.
+static void WriteBarrierElimination(FlowGraph* flow_graph) {
+  Zone* zone = flow_graph->zone();
+  const intptr_t num_blocks = flow_graph->preorder().length();
+  const intptr_t num_defs = flow_graph->current_ssa_temp_index();
+  if (num_defs == 0) {
+    return;
+  }
+
+  // Optimistically start with everything allocated at the end of each
+  // block and iterate to a fixed point.
+  GrowableArray<BitVector*> allocated_out(num_blocks);
+  for (intptr_t i = 0; i < num_blocks; ++i) {
+    BitVector* out = new (zone) BitVector(zone, num_defs);
+    out->SetAll();
+    allocated_out.Add(out);
+  }
 
-      if (current->CanTriggerGC()) {
-        last_allocated = nullptr;
+  BitVector* allocated = new (zone) BitVector(zone, num_defs);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      BlockEntryInstr* block = block_it.Current();
+      WriteBarrierEliminationBlockEntry(block, allocated_out, allocated);
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        WriteBarrierEliminationTransfer(it.Current(), allocated, false);
+      }
+      BitVector* out = allocated_out[block->preorder_number()];
+      if (!out->Equals(*allocated)) {
+        out->CopyFrom(allocated);
+        changed = true;
       }
     }
   }
+
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    WriteBarrierEliminationBlockEntry(block, allocated_out, allocated);
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      WriteBarrierEliminationTransfer(it.Current(), allocated, true);
+    }
+  }
 }
 
 COMPILER_PASS(WriteBarrierElimination,
@@ -42,6 +42,8 @@ namespace dart {
   V(TryCatchOptimization)                                                      \
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
+  V(UnrollLoops)                                                               \
+  V(VectorizeLoops)                                                            \
   V(WidenSmiToInt32)                                                           \
   V(WriteBarrierElimination)
 
@@ -50,6 +52,7 @@ class BlockScheduler;
 class CallSpecializer;
 class FlowGraph;
 class Function;
+class JSONObject;
 class Precompiler;
 class SpeculativeInliningPolicy;
 
@@ -111,7 +114,7 @@ class CompilerPass {
   static const intptr_t kNumPasses = 0 COMPILER_PASS_LIST(ADD_ONE);
 #undef ADD_ONE
 
-  CompilerPass(Id id, const char* name) : name_(name), flags_(0) {
+  CompilerPass(Id id, const char* name) : id_(id), name_(name), flags_(0) {
     ASSERT(passes_[id] == NULL);
     passes_[id] = this;
 
@@ -141,7 +144,9 @@ class CompilerPass {
 
   static void ParseFilters(const char* filter);
 
-  enum PipelineMode { kJIT, kAOT };
+  // kJITIntermediate is the cheaper JIT tier that code goes through before
+  // the full kJIT pipeline, see --intermediate_tier_threshold.
+  enum PipelineMode { kJIT, kJITIntermediate, kAOT };
 
   static void RunPipeline(PipelineMode mode, CompilerPassState* state);
 
@@ -163,12 +168,75 @@ class CompilerPass {
 
   void PrintGraph(CompilerPassState* state, Flag mask, intptr_t round) const;
 
+  static void RunIntermediatePipeline(CompilerPassState* state);
+
+  NOT_IN_PRODUCT(static void RecordInitialStats(CompilerPassState* state));
+  NOT_IN_PRODUCT(void RecordStats(CompilerPassState* state,
+                                  int64_t micros,
+                                  uintptr_t zone_bytes) const);
+
   static CompilerPass* passes_[];
 
+  const Id id_;
   const char* name_;
   intptr_t flags_;
 };
 
+// Time spent in each compiler pass and the zone memory it used, summed over
+// the compilations of an isolate. The zone memory of a pass is the peak of
+// the thread's zone capacity while it ran, above the capacity when it
+// started. Each pass also sums the number of IL instructions left in the
+// graph after it, and the isolate sums the instructions of the graphs before
+// the first pass, the size of the code it generated and the spill slots the
+// register allocator needed. Only collected with --compiler_pass_stats.
+// Guarded by the isolate's mutex.
+class CompilerPassStats {
+ public:
+  CompilerPassStats();
+  ~CompilerPassStats();
+
+  void Add(CompilerPass::Id id,
+           const Function& function,
+           int64_t micros,
+           uintptr_t zone_bytes,
+           intptr_t instructions);
+  void AddInitialInstructions(intptr_t instructions) {
+    total_initial_instructions_ += instructions;
+  }
+  void AddSpillSlots(intptr_t spill_slots) {
+    total_spill_slots_ += spill_slots;
+  }
+  void AddCode(bool optimized, intptr_t code_size);
+  void Clear();
+
+#ifndef PRODUCT
+  void PrintToJSONObject(JSONObject* obj) const;
+#endif  // !PRODUCT
+
+ private:
+  struct Entry {
+    intptr_t count;
+    int64_t total_micros;
+    int64_t max_micros;
+    uintptr_t total_zone_bytes;
+    uintptr_t max_zone_bytes;
+    int64_t total_instructions;
+    // The functions with the slowest run and the largest zone use, owned.
+    char* max_micros_function;
+    char* max_zone_bytes_function;
+  };
+
+  Entry entries_[CompilerPass::kNumPasses];
+  intptr_t unoptimized_code_count_;
+  int64_t unoptimized_code_size_;
+  intptr_t optimized_code_count_;
+  int64_t optimized_code_size_;
+  int64_t total_initial_instructions_;
+  int64_t total_spill_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerPassStats);
+};
+
 }  // namespace dart
 
 #endif
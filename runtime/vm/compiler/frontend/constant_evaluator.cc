@@ -1003,13 +1003,19 @@ bool ConstantEvaluator::EvaluateBooleanExpressionHere() {
 
 bool ConstantEvaluator::GetCachedConstant(intptr_t kernel_offset,
                                           Instance* value) {
-  if (!IsBuildingFlowGraph()) return false;
+  // Evaluators outside of flow graph building (default parameter values and
+  // metadata) share the cache of the script, so they do not re-evaluate what
+  // a compilation of the enclosing function already did, and vice versa.
+  if (script_.IsNull()) return false;
 
-  const Function& function = flow_graph_builder_->parsed_function_->function();
-  if (function.kind() == RawFunction::kImplicitStaticFinalGetter) {
-    // Don't cache constants in initializer expressions. They get
-    // evaluated only once.
-    return false;
+  if (IsBuildingFlowGraph()) {
+    const Function& function =
+        flow_graph_builder_->parsed_function_->function();
+    if (function.kind() == RawFunction::kImplicitStaticFinalGetter) {
+      // Don't cache constants in initializer expressions. They get
+      // evaluated only once.
+      return false;
+    }
   }
 
   bool is_present = false;
@@ -1029,21 +1035,30 @@ bool ConstantEvaluator::GetCachedConstant(intptr_t kernel_offset,
 
 void ConstantEvaluator::CacheConstantValue(intptr_t kernel_offset,
                                            const Instance& value) {
-  ASSERT(Thread::Current()->IsMutatorThread());
-
-  if (!IsBuildingFlowGraph()) return;
+  if (script_.IsNull()) return;
 
-  const Function& function = flow_graph_builder_->parsed_function_->function();
-  if (function.kind() == RawFunction::kImplicitStaticFinalGetter) {
-    // Don't cache constants in initializer expressions. They get
-    // evaluated only once.
+  if (IsBuildingFlowGraph()) {
+    const Function& function =
+        flow_graph_builder_->parsed_function_->function();
+    if (function.kind() == RawFunction::kImplicitStaticFinalGetter) {
+      // Don't cache constants in initializer expressions. They get
+      // evaluated only once.
+      return;
+    }
+  } else if (!Thread::Current()->IsMutatorThread()) {
+    // Metadata may be evaluated by the background compiler, which must not
+    // update the script.
     return;
   }
+  ASSERT(Thread::Current()->IsMutatorThread());
+
   const intptr_t kInitialConstMapSize = 16;
   ASSERT(!script_.InVMHeap());
   if (script_.compile_time_constants() == Array::null()) {
+    // The cache lives as long as the script and is written into JIT
+    // snapshots with it, so do not make every scavenge copy it.
     const Array& array = Array::Handle(
-        HashTables::New<KernelConstantsMap>(kInitialConstMapSize, Heap::kNew));
+        HashTables::New<KernelConstantsMap>(kInitialConstMapSize, Heap::kOld));
     script_.set_compile_time_constants(array);
   }
   KernelConstantsMap constants(script_.compile_time_constants());
@@ -2192,14 +2192,6 @@ void StreamingFlowGraphBuilder::ReportUnexpectedTag(const char* variant,
   }
 }
 
-Tag KernelReaderHelper::ReadTag(uint8_t* payload) {
-  return reader_.ReadTag(payload);
-}
-
-Tag KernelReaderHelper::PeekTag(uint8_t* payload) {
-  return reader_.PeekTag(payload);
-}
-
 void StreamingFlowGraphBuilder::loop_depth_inc() {
   ++flow_graph_builder_->loop_depth_;
 }
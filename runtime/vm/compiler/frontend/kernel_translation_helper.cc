@@ -537,6 +537,7 @@ RawField* TranslationHelper::LookupFieldByKernelField(NameIndex kernel_field) {
   if (IsLibrary(enclosing)) {
     Library& library =
         Library::Handle(Z, LookupLibraryByKernelLibrary(enclosing));
+    library.EnsureTopLevelMembersLoaded();
     klass = library.toplevel_class();
   } else {
     ASSERT(IsClass(enclosing));
@@ -1743,60 +1744,16 @@ CallSiteAttributesMetadataHelper::GetCallSiteAttributes(intptr_t node_offset) {
   return metadata;
 }
 
-intptr_t KernelReaderHelper::ReaderOffset() const {
-  return reader_.offset();
-}
-
-void KernelReaderHelper::SetOffset(intptr_t offset) {
-  reader_.set_offset(offset);
-}
-
-void KernelReaderHelper::SkipBytes(intptr_t bytes) {
-  reader_.set_offset(ReaderOffset() + bytes);
-}
-
-bool KernelReaderHelper::ReadBool() {
-  return reader_.ReadBool();
-}
-
-uint8_t KernelReaderHelper::ReadByte() {
-  return reader_.ReadByte();
-}
-
-uint32_t KernelReaderHelper::ReadUInt() {
-  return reader_.ReadUInt();
-}
-
-uint32_t KernelReaderHelper::ReadUInt32() {
-  return reader_.ReadUInt32();
-}
-
 uint32_t KernelReaderHelper::PeekUInt() {
   AlternativeReadingScope alt(&reader_);
   return reader_.ReadUInt();
 }
 
-double KernelReaderHelper::ReadDouble() {
-  return reader_.ReadDouble();
-}
-
 uint32_t KernelReaderHelper::PeekListLength() {
   AlternativeReadingScope alt(&reader_);
   return reader_.ReadListLength();
 }
 
-intptr_t KernelReaderHelper::ReadListLength() {
-  return reader_.ReadListLength();
-}
-
-StringIndex KernelReaderHelper::ReadStringReference() {
-  return StringIndex(ReadUInt());
-}
-
-NameIndex KernelReaderHelper::ReadCanonicalNameReference() {
-  return reader_.ReadCanonicalNameReference();
-}
-
 StringIndex KernelReaderHelper::ReadNameAsStringIndex() {
   StringIndex name_index = ReadStringReference();  // read name index.
   if ((H.StringSize(name_index) >= 1) && H.CharacterAt(name_index, 0) == '_') {
@@ -1849,22 +1806,6 @@ const String& KernelReaderHelper::ReadNameAsFieldName() {
   }
 }
 
-void KernelReaderHelper::SkipFlags() {
-  ReadFlags();
-}
-
-void KernelReaderHelper::SkipStringReference() {
-  ReadUInt();
-}
-
-void KernelReaderHelper::SkipConstantReference() {
-  ReadUInt();
-}
-
-void KernelReaderHelper::SkipCanonicalNameReference() {
-  ReadUInt();
-}
-
 void KernelReaderHelper::ReportUnexpectedTag(const char* variant, Tag tag) {
   H.ReportError(script_, TokenPosition::kNoSource,
                 "Unexpected tag %d (%s) in ?, expected %s", tag,
@@ -2518,6 +2459,13 @@ const String& KernelReaderHelper::GetSourceFor(intptr_t index) {
   }
 }
 
+intptr_t KernelReaderHelper::GetSourceSizeFor(intptr_t index) {
+  AlternativeReadingScope alt(&reader_);
+  SetOffset(GetOffsetForSourceInfo(index));
+  SkipBytes(ReadUInt());  // skip uri.
+  return ReadUInt();      // read source List<byte> size.
+}
+
 RawTypedData* KernelReaderHelper::GetLineStartsFor(intptr_t index) {
   // Line starts are delta encoded. So get the max delta first so that we
   // can store them as tighly as possible.
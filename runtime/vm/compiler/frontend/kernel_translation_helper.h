@@ -950,14 +950,17 @@ class KernelReaderHelper {
 
   virtual ~KernelReaderHelper() = default;
 
-  void SetOffset(intptr_t offset);
+  // The accessors forwarding to reader_ are defined here so that scope and
+  // flow graph building, which decode every node through them, get the
+  // reader's varint and tag decoding inlined.
+  void SetOffset(intptr_t offset) { reader_.set_offset(offset); }
 
-  intptr_t ReadListLength();
+  intptr_t ReadListLength() { return reader_.ReadListLength(); }
   virtual void ReportUnexpectedTag(const char* variant, Tag tag);
 
   void ReadUntilFunctionNode();
 
-  Tag PeekTag(uint8_t* payload = NULL);
+  Tag PeekTag(uint8_t* payload = NULL) { return reader_.PeekTag(payload); }
 
  protected:
   const Script& script() const { return script_; }
@@ -980,26 +983,28 @@ class KernelReaderHelper {
     USE(position);
   }
 
-  intptr_t ReaderOffset() const;
-  void SkipBytes(intptr_t skip);
-  bool ReadBool();
-  uint8_t ReadByte();
-  uint32_t ReadUInt();
-  uint32_t ReadUInt32();
+  intptr_t ReaderOffset() const { return reader_.offset(); }
+  void SkipBytes(intptr_t skip) { reader_.set_offset(ReaderOffset() + skip); }
+  bool ReadBool() { return reader_.ReadBool(); }
+  uint8_t ReadByte() { return reader_.ReadByte(); }
+  uint32_t ReadUInt() { return reader_.ReadUInt(); }
+  uint32_t ReadUInt32() { return reader_.ReadUInt32(); }
   uint32_t PeekUInt();
-  double ReadDouble();
+  double ReadDouble() { return reader_.ReadDouble(); }
   uint32_t PeekListLength();
-  StringIndex ReadStringReference();
-  NameIndex ReadCanonicalNameReference();
+  StringIndex ReadStringReference() { return StringIndex(ReadUInt()); }
+  NameIndex ReadCanonicalNameReference() {
+    return reader_.ReadCanonicalNameReference();
+  }
   StringIndex ReadNameAsStringIndex();
   const String& ReadNameAsMethodName();
   const String& ReadNameAsGetterName();
   const String& ReadNameAsSetterName();
   const String& ReadNameAsFieldName();
-  void SkipFlags();
-  void SkipStringReference();
-  void SkipConstantReference();
-  void SkipCanonicalNameReference();
+  void SkipFlags() { ReadFlags(); }
+  void SkipStringReference() { ReadUInt(); }
+  void SkipConstantReference() { ReadUInt(); }
+  void SkipCanonicalNameReference() { ReadUInt(); }
   void SkipDartType();
   void SkipOptionalDartType();
   void SkipInterfaceType(bool simple);
@@ -1022,13 +1027,14 @@ class KernelReaderHelper {
   void SkipLibraryPart();
   void SkipLibraryTypedef();
   TokenPosition ReadPosition(bool record = true);
-  Tag ReadTag(uint8_t* payload = NULL);
+  Tag ReadTag(uint8_t* payload = NULL) { return reader_.ReadTag(payload); }
   uint8_t ReadFlags() { return reader_.ReadFlags(); }
 
   intptr_t SourceTableSize();
   intptr_t GetOffsetForSourceInfo(intptr_t index);
   String& SourceTableUriFor(intptr_t index);
   const String& GetSourceFor(intptr_t index);
+  intptr_t GetSourceSizeFor(intptr_t index);
   RawTypedData* GetLineStartsFor(intptr_t index);
 
   Zone* zone_;
@@ -2157,11 +2157,31 @@ void Intrinsifier::OneByteString_substringUnchecked(Assembler* assembler,
   // R6: Pointer into R3.
   // R7: Pointer into R0.
   // R1: Scratch register.
-  Label loop, done;
-  __ cmp(R2, Operand(0));
-  __ b(&done, LE);
+  // Copy a word at a time while at least a word is left, then the tail
+  // byte by byte.
+  Label word_loop, bytes, loop, done;
   __ mov(R6, R3);
   __ mov(R7, R0);
+  __ cmp(R2, Operand(kWordSize));
+  __ b(&bytes, LT);
+#if defined(USING_SIMULATOR)
+  // The hardware allows unaligned word loads, but the simulator does not.
+  // The destination is always aligned, so use the byte loop unless the
+  // source is too.
+  __ tsti(R6, Immediate(kWordSize - 1));
+  __ b(&bytes, NE);
+#endif
+  __ Bind(&word_loop);
+  __ ldr(R1, Address(R6));
+  __ AddImmediate(R6, kWordSize);
+  __ sub(R2, R2, Operand(kWordSize));
+  __ cmp(R2, Operand(kWordSize));
+  __ str(R1, FieldAddress(R7, OneByteString::data_offset()));
+  __ AddImmediate(R7, kWordSize);
+  __ b(&word_loop, GE);
+  __ Bind(&bytes);
+  __ cmp(R2, Operand(0));
+  __ b(&done, LE);
   __ Bind(&loop);
   __ ldr(R1, Address(R6), kUnsignedByte);
   __ AddImmediate(R6, 1);
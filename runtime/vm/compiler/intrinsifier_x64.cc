@@ -2104,7 +2104,20 @@ void Intrinsifier::OneByteString_substringUnchecked(Assembler* assembler,
   // RCX: Untagged number of bytes to copy.
   // RAX: Tagged result string
   // RDX: Loop counter.
-  // RBX: Scratch register.
+  // RBX, RDI: Scratch registers.
+  // Copy a word at a time while at least a word is left, then the tail
+  // byte by byte.
+  Label word_loop, word_check;
+  __ jmp(&word_check, Assembler::kNearJump);
+  __ Bind(&word_loop);
+  __ movq(RBX, Address(RSI, RDX, TIMES_1, 0));
+  __ movq(FieldAddress(RAX, RDX, TIMES_1, OneByteString::data_offset()), RBX);
+  __ addq(RDX, Immediate(kWordSize));
+  __ Bind(&word_check);
+  __ leaq(RDI, Address(RDX, kWordSize));
+  __ cmpq(RDI, RCX);
+  __ j(LESS_EQUAL, &word_loop, Assembler::kNearJump);
+
   Label loop, check;
   __ jmp(&check, Assembler::kNearJump);
   __ Bind(&loop);
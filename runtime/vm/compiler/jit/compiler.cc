@@ -70,6 +70,11 @@ DEFINE_FLAG(bool,
             stress_test_background_compilation,
             false,
             "Keep background compiler running all the time");
+DEFINE_FLAG(int,
+            startup_trace_duration,
+            0,
+            "Record the functions first compiled in the first N milliseconds "
+            "of an isolate, for Dart_SaveStartupTrace.");
 DEFINE_FLAG(bool,
             stop_on_excessive_deoptimization,
             false,
@@ -116,6 +121,11 @@ static void PrecompilationModeHandler(bool value) {
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
     // Not present with DART_PRECOMPILED_RUNTIME
+    // Unboxed fields are kept in mutable boxes. That relies on the first
+    // store allocating the box under a field guard and on implicit getters
+    // copying the value out. AOT code has neither: implicit getters are
+    // intrinsified to return the field as is, and fields for which TFA
+    // inferred nothing keep kIllegalCid.
     FLAG_unbox_numeric_fields = false;
 #endif
 
@@ -545,6 +555,10 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
   code.set_is_optimized(optimized());
   code.set_owner(function);
 #if !defined(PRODUCT)
+  if (FLAG_compiler_pass_stats) {
+    MutexLocker ml(isolate()->mutex());
+    isolate()->compiler_pass_stats()->AddCode(optimized(), code.Size());
+  }
   ZoneGrowableArray<TokenPosition>* await_token_positions =
       flow_graph->await_token_positions();
   if (await_token_positions != NULL) {
@@ -698,6 +712,16 @@ void CompileParsedFunctionHelper::CheckIfBackgroundCompilerIsBeingStopped() {
   }
 }
 
+// Functions that run unoptimized code and were never deoptimized are first
+// optimized by the intermediate tier. Its code keeps counting invocations and
+// is replaced by fully optimized code at --optimization_counter_threshold.
+static bool UseIntermediateTier(const Function& function, intptr_t osr_id) {
+  return (FLAG_intermediate_tier_threshold >= 0) &&
+         (osr_id == Compiler::kNoOSRDeoptId) &&
+         !function.IsIrregexpFunction() && !function.HasOptimizedCode() &&
+         (function.deoptimization_counter() == 0);
+}
+
 // Return null if bailed out.
 // If optimized_result_code is not NULL then it is caller's responsibility
 // to install code.
@@ -725,6 +749,9 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   // blacklist, since we don't restart optimization.
   SpeculativeInliningPolicy speculative_policy(/* enable_blacklist= */ false);
 
+  const bool intermediate_tier =
+      optimized() && UseIntermediateTier(function, osr_id());
+
   Code* volatile result = &Code::ZoneHandle(zone);
   while (!done) {
     *result = Code::null();
@@ -774,6 +801,7 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
                                                  "BuildFlowGraph"));
         flow_graph = pipeline->BuildFlowGraph(
             zone, parsed_function(), ic_data_array, osr_id(), optimized());
+        flow_graph->set_intermediate_tier(intermediate_tier);
       }
 
       const bool print_flow_graph =
@@ -815,7 +843,10 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
         pass_state.call_specializer = &call_specializer;
 
-        CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        CompilerPass::RunPipeline(intermediate_tier
+                                      ? CompilerPass::kJITIntermediate
+                                      : CompilerPass::kJIT,
+                                  &pass_state);
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
@@ -1022,6 +1053,15 @@ static RawObject* CompileFunctionHelper(CompilationPipeline* pipeline,
     }
 
     per_compile_timer.Stop();
+#if !defined(PRODUCT)
+    if (optimized) {
+      isolate->GetCompileOptimizedTimeMetric()->Record(
+          per_compile_timer.TotalElapsedTime());
+    } else {
+      isolate->GetCompileUnoptimizedTimeMetric()->Record(
+          per_compile_timer.TotalElapsedTime());
+    }
+#endif  // !defined(PRODUCT)
 
     if (trace_compiler) {
       THR_Print("--> '%s' entry: %#" Px " size: %" Pd " time: %" Pd64 " us\n",
@@ -1112,6 +1152,19 @@ static RawError* ParseFunctionHelper(CompilationPipeline* pipeline,
   return Error::null();
 }
 
+// Appends the function to the startup trace, so that a snapshot of the
+// program can place the code run during startup together.
+static void RecordStartupFunction(Thread* thread, const Function& function) {
+  ObjectStore* object_store = thread->isolate()->object_store();
+  GrowableObjectArray& functions = GrowableObjectArray::Handle(
+      thread->zone(), object_store->startup_functions());
+  if (functions.IsNull()) {
+    functions = GrowableObjectArray::New();
+    object_store->set_startup_functions(functions);
+  }
+  functions.Add(function);
+}
+
 RawObject* Compiler::CompileFunction(Thread* thread, const Function& function) {
 #if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
     !defined(TARGET_ARCH_IA32)
@@ -1135,6 +1188,14 @@ RawObject* Compiler::CompileFunction(Thread* thread, const Function& function) {
            Function::KindToCString(function.kind()));
   }
 
+  const int64_t startup_trace_micros =
+      static_cast<int64_t>(FLAG_startup_trace_duration) *
+      kMicrosecondsPerMillisecond;
+  if ((startup_trace_micros > 0) && !function.WasCompiled() &&
+      (isolate->UptimeMicros() < startup_trace_micros)) {
+    RecordStartupFunction(thread, function);
+  }
+
   CompilationPipeline* pipeline =
       CompilationPipeline::New(thread->zone(), function);
 
@@ -1521,8 +1582,11 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 // C-heap allocated background compilation queue element.
 class QueueElement {
  public:
-  explicit QueueElement(const Function& function)
-      : next_(NULL), function_(function.raw()) {}
+  explicit QueueElement(const Function& function,
+                        intptr_t interpreter_usage = 0)
+      : next_(NULL),
+        function_(function.raw()),
+        interpreter_usage_(interpreter_usage) {}
 
   virtual ~QueueElement() {
     next_ = NULL;
@@ -1539,27 +1603,36 @@ class QueueElement {
     return reinterpret_cast<RawObject**>(&function_);
   }
 
+  // Usage counter collected by the interpreter before the function was
+  // queued for compilation to unoptimized code.
+  intptr_t interpreter_usage() const { return interpreter_usage_; }
+
  private:
   QueueElement* next_;
   RawFunction* function_;
+  intptr_t interpreter_usage_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// Pending functions are handed out hottest first, i.e., by decreasing usage
+// counter at the time of removal: the counter is reset when a function is
+// enqueued and keeps counting invocations while it waits. Functions being
+// compiled stay on an in-progress list until their worker is done with them,
+// so a function is never queued or compiled twice at the same time.
 class BackgroundCompilationQueue {
  public:
-  BackgroundCompilationQueue() : first_(NULL), last_(NULL) {}
-  virtual ~BackgroundCompilationQueue() { Clear(); }
+  BackgroundCompilationQueue() : first_(NULL), in_progress_(NULL) {}
+  virtual ~BackgroundCompilationQueue() {
+    Clear();
+    ASSERT(in_progress_ == NULL);
+  }
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
     ASSERT(visitor != NULL);
-    QueueElement* p = first_;
-    while (p != NULL) {
-      visitor->VisitPointer(p->function_ptr());
-      p = p->next();
-    }
+    VisitList(first_, visitor);
+    VisitList(in_progress_, visitor);
   }
 
   bool IsEmpty() const { return first_ == NULL; }
@@ -1567,40 +1640,69 @@ class BackgroundCompilationQueue {
   void Add(QueueElement* value) {
     ASSERT(value != NULL);
     ASSERT(value->next() == NULL);
-    if (first_ == NULL) {
-      first_ = value;
-      ASSERT(last_ == NULL);
-    } else {
-      ASSERT(last_ != NULL);
-      last_->set_next(value);
+    value->set_next(first_);
+    first_ = value;
+  }
+
+  // Moves the pending function with the highest usage counter to the
+  // in-progress list and returns it.
+  QueueElement* RemoveHottest() {
+    ASSERT(first_ != NULL);
+    Function& function = Function::Handle(first_->Function());
+    QueueElement* best_prev = NULL;
+    QueueElement* best = first_;
+    intptr_t best_usage = function.usage_counter();
+    QueueElement* prev = first_;
+    for (QueueElement* p = first_->next(); p != NULL; p = p->next()) {
+      function = p->Function();
+      if (function.usage_counter() > best_usage) {
+        best_prev = prev;
+        best = p;
+        best_usage = function.usage_counter();
+      }
+      prev = p;
+    }
+    Unlink(&first_, best_prev, best);
+    best->set_next(in_progress_);
+    in_progress_ = best;
+    return best;
+  }
+
+  // Removes an element returned by RemoveHottest from the in-progress list.
+  void Done(QueueElement* value) {
+    QueueElement* prev = NULL;
+    QueueElement* p = in_progress_;
+    while (p != value) {
+      ASSERT(p != NULL);
+      prev = p;
+      p = p->next();
     }
-    last_ = value;
-    ASSERT(first_ != NULL && last_ != NULL);
+    Unlink(&in_progress_, prev, value);
   }
 
-  QueueElement* Peek() const { return first_; }
+  bool ContainsObj(const Object& obj) const {
+    return ListContains(first_, obj) || ListContains(in_progress_, obj);
+  }
 
-  RawFunction* PeekFunction() const {
-    QueueElement* e = Peek();
-    if (e == NULL) {
-      return Function::null();
-    } else {
-      return e->Function();
+  // Deletes all pending elements. Elements in progress are owned by their
+  // workers.
+  void Clear() {
+    while (first_ != NULL) {
+      QueueElement* e = first_;
+      first_ = e->next();
+      delete e;
     }
   }
 
-  QueueElement* Remove() {
-    ASSERT(first_ != NULL);
-    QueueElement* result = first_;
-    first_ = first_->next();
-    if (first_ == NULL) {
-      last_ = NULL;
+ private:
+  static void VisitList(QueueElement* p, ObjectPointerVisitor* visitor) {
+    while (p != NULL) {
+      visitor->VisitPointer(p->function_ptr());
+      p = p->next();
     }
-    return result;
   }
 
-  bool ContainsObj(const Object& obj) const {
-    QueueElement* p = first_;
+  static bool ListContains(QueueElement* p, const Object& obj) {
     while (p != NULL) {
       if (p->function() == obj.raw()) {
         return true;
@@ -1610,17 +1712,20 @@ class BackgroundCompilationQueue {
     return false;
   }
 
-  void Clear() {
-    while (!IsEmpty()) {
-      QueueElement* e = Remove();
-      delete e;
+  static void Unlink(QueueElement** head,
+                     QueueElement* prev,
+                     QueueElement* value) {
+    if (prev == NULL) {
+      ASSERT(*head == value);
+      *head = value->next();
+    } else {
+      prev->set_next(value->next());
     }
-    ASSERT((first_ == NULL) && (last_ == NULL));
+    value->set_next(NULL);
   }
 
- private:
   QueueElement* first_;
-  QueueElement* last_;
+  QueueElement* in_progress_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
@@ -1631,7 +1736,7 @@ BackgroundCompiler::BackgroundCompiler(Isolate* isolate)
       function_queue_(new BackgroundCompilationQueue()),
       done_monitor_(new Monitor()),
       running_(false),
-      done_(true),
+      active_workers_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
@@ -1653,11 +1758,8 @@ void BackgroundCompiler::Run() {
       Zone* zone = stack_zone.GetZone();
       HANDLESCOPE(thread);
       Function& function = Function::Handle(zone);
-      {
-        MonitorLocker ml(queue_monitor_);
-        function = function_queue()->PeekFunction();
-      }
-      while (running_ && !function.IsNull() && !isolate_->IsTopLevelParsing()) {
+      QueueElement* qelem = NextElement(&function);
+      while (qelem != NULL) {
         // This is false if we are compiling bytecode -> unoptimized code.
         const bool optimizing = function.ShouldCompilerOptimize();
         ASSERT(FLAG_enable_interpreter || optimizing);
@@ -1666,32 +1768,32 @@ void BackgroundCompiler::Run() {
         Compiler::CompileOptimizedFunction(thread, function,
                                            Compiler::kNoOSRDeoptId);
 
-        QueueElement* qelem = NULL;
+        // Let the unoptimized code continue counting from the usage collected
+        // by the interpreter, rather than from the counter reset by the
+        // enqueueing.
+        if (!optimizing && function.HasCode() && function.IsOptimizable() &&
+            (function.usage_counter() < 0)) {
+          function.SetUsageCounter(qelem->interpreter_usage());
+        }
+
         {
           MonitorLocker ml(queue_monitor_);
-          if (function_queue()->IsEmpty()) {
-            // We are shutting down, queue was cleared.
-            function = Function::null();
-          } else {
-            qelem = function_queue()->Remove();
-            const Function& old = Function::Handle(qelem->Function());
-            // If an optimizable method is not optimized, put it back on
-            // the background queue (unless it was passed to foreground).
-            if ((optimizing && !old.HasOptimizedCode() &&
-                 old.IsOptimizable()) ||
-                FLAG_stress_test_background_compilation) {
-              if (old.is_background_optimizable() &&
-                  Compiler::CanOptimizeFunction(thread, old)) {
-                QueueElement* repeat_qelem = new QueueElement(old);
-                function_queue()->Add(repeat_qelem);
-              }
+          function_queue()->Done(qelem);
+          // If an optimizable method is not optimized, put it back on
+          // the background queue (unless it was passed to foreground or we
+          // are shutting down).
+          if (running_ &&
+              ((optimizing && !function.HasOptimizedCode() &&
+                function.IsOptimizable()) ||
+               FLAG_stress_test_background_compilation)) {
+            if (function.is_background_optimizable() &&
+                Compiler::CanOptimizeFunction(thread, function)) {
+              function_queue()->Add(new QueueElement(function));
             }
-            function = function_queue()->PeekFunction();
           }
         }
-        if (qelem != NULL) {
-          delete qelem;
-        }
+        delete qelem;
+        qelem = NextElement(&function);
       }
     }
     Thread::ExitIsolateAsHelper();
@@ -1706,14 +1808,28 @@ void BackgroundCompiler::Run() {
   }  // while running
 
   {
-    // Notify that the thread is done.
+    // Notify that the last worker is done.
     MonitorLocker ml_done(done_monitor_);
-    done_ = true;
-    ml_done.Notify();
+    ASSERT(active_workers_ > 0);
+    if (--active_workers_ == 0) {
+      ml_done.Notify();
+    }
+  }
+}
+
+QueueElement* BackgroundCompiler::NextElement(Function* function) {
+  MonitorLocker ml(queue_monitor_);
+  if (!running_ || function_queue()->IsEmpty() ||
+      isolate_->IsTopLevelParsing()) {
+    return NULL;
   }
+  QueueElement* qelem = function_queue()->RemoveHottest();
+  *function = qelem->Function();
+  return qelem;
 }
 
-void BackgroundCompiler::CompileOptimized(const Function& function) {
+void BackgroundCompiler::CompileOptimized(const Function& function,
+                                          intptr_t interpreter_usage) {
   ASSERT(Thread::Current()->IsMutatorThread());
   // TODO(srdjan): Checking different strategy for collecting garbage
   // accumulated by background compiler.
@@ -1726,7 +1842,7 @@ void BackgroundCompiler::CompileOptimized(const Function& function) {
     if (function_queue()->ContainsObj(function)) {
       return;
     }
-    QueueElement* elem = new QueueElement(function);
+    QueueElement* elem = new QueueElement(function, interpreter_usage);
     function_queue()->Add(elem);
     ml.Notify();
   }
@@ -1768,14 +1884,18 @@ void BackgroundCompiler::Start() {
   ASSERT(error.IsNull());
 
   MonitorLocker ml(done_monitor_);
-  if (running_ || !done_) return;
+  if (running_ || (active_workers_ > 0)) return;
   running_ = true;
-  done_ = false;
-  bool task_started =
-      Dart::thread_pool()->Run(new BackgroundCompilerTask(this));
-  if (!task_started) {
+  const intptr_t num_workers =
+      Utils::Maximum<intptr_t>(FLAG_background_compiler_tasks, 1);
+  for (intptr_t i = 0; i < num_workers; i++) {
+    if (!Dart::thread_pool()->Run(new BackgroundCompilerTask(this))) {
+      break;
+    }
+    active_workers_++;
+  }
+  if (active_workers_ == 0) {
     running_ = false;
-    done_ = true;
   }
 }
 
@@ -1788,12 +1908,12 @@ void BackgroundCompiler::Stop() {
     MonitorLocker ml(queue_monitor_);
     running_ = false;
     function_queue_->Clear();
-    ml.Notify();  // Stop waiting for the queue.
+    ml.NotifyAll();  // Stop waiting for the queue.
   }
 
   {
     MonitorLocker ml_done(done_monitor_);
-    while (!done_) {
+    while (active_workers_ > 0) {
       ml_done.WaitWithSafepointCheck(thread);
     }
   }
@@ -1904,7 +2024,8 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
   UNREACHABLE();
 }
 
-void BackgroundCompiler::CompileOptimized(const Function& function) {
+void BackgroundCompiler::CompileOptimized(const Function& function,
+                                          intptr_t interpreter_usage) {
   UNREACHABLE();
 }
 
@@ -161,9 +161,9 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// Class to run optimizing compilation in background threads.
+// Current implementation: FLAG_background_compiler_tasks tasks per isolate
+// sharing one queue, they die with the owning isolate.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -210,8 +210,11 @@ class BackgroundCompiler {
   }
 
   // Call to optimize a function in the background, enters the function in the
-  // compilation queue.
-  void CompileOptimized(const Function& function);
+  // compilation queue. If the function is compiled from bytecode to
+  // unoptimized code, its usage counter is set to interpreter_usage once the
+  // code is installed, so that it does not have to warm up again.
+  void CompileOptimized(const Function& function,
+                        intptr_t interpreter_usage = 0);
 
   void VisitPointers(ObjectPointerVisitor* visitor);
 
@@ -226,16 +229,20 @@ class BackgroundCompiler {
   void Enable();
   void Disable();
   bool IsDisabled();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return active_workers_ > 0; }
+
+  // Takes the hottest pending function off the queue, or returns NULL if
+  // there is none or the worker should stop compiling.
+  QueueElement* NextElement(Function* function);
 
   Isolate* isolate_;
 
   Monitor* queue_monitor_;  // Controls access to the queue.
   BackgroundCompilationQueue* function_queue_;
 
-  Monitor* done_monitor_;   // Notify/wait that the thread is done.
+  Monitor* done_monitor_;   // Notify/wait that all workers are done.
   bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  intptr_t active_workers_;  // Number of worker tasks not yet done.
 
   int16_t disabled_depth_;
 
@@ -21,8 +21,6 @@ class JitCallSpecializer : public CallSpecializer {
   // TODO(dartbug.com/30633) these methods have nothing to do with
   // specialization of calls. They are here for historical reasons.
   // Find a better place for them.
-  virtual void VisitAllocateContext(AllocateContextInstr* instr);
-  virtual void VisitCloneContext(CloneContextInstr* instr);
   virtual void VisitStoreInstanceField(StoreInstanceFieldInstr* instr);
 
  private:
@@ -30,10 +28,6 @@ class JitCallSpecializer : public CallSpecializer {
 
   virtual bool TryOptimizeStaticCallUsingStaticTypes(StaticCallInstr* call);
 
-  void LowerContextAllocation(Definition* instr,
-                              intptr_t num_context_variables,
-                              Value* context_value);
-
   void ReplaceWithStaticCall(InstanceCallInstr* instr,
                              const ICData& unary_checks,
                              const Function& target);
@@ -247,6 +247,8 @@ namespace dart {
   V(::, acos, MathAcos, Double, 0x08cf2212)                                    \
   V(::, atan, MathAtan, Double, 0x1e2731d5)                                    \
   V(::, atan2, MathAtan2, Double, 0x39f1fa41)                                  \
+  V(::, exp, MathExp, Double, 0x32ab9efa)                                      \
+  V(::, log, MathLog, Double, 0x1ee8f9fc)                                      \
 
 #define TYPED_DATA_LIB_INTRINSIC_LIST(V)                                       \
   V(Int8List, ., TypedData_Int8Array_factory, TypedDataInt8Array, 0x7e39a3a1)  \
@@ -430,8 +432,6 @@ namespace dart {
   V(_ByteDataView, getUint64, ByteDataViewGetUint64, 0x0ffadc4b)               \
   V(_ByteDataView, getFloat32, ByteDataViewGetFloat32, 0x6a205749)             \
   V(_ByteDataView, getFloat64, ByteDataViewGetFloat64, 0x69f58d27)             \
-  V(::, exp, MathExp, 0x32ab9efa)                                              \
-  V(::, log, MathLog, 0x1ee8f9fc)                                              \
   V(::, max, MathMax, 0x377e8889)                                              \
   V(::, min, MathMin, 0x32ebc57d)                                              \
   V(::, pow, MathPow, 0x79efc5a2)                                              \
@@ -463,6 +463,8 @@ namespace dart {
   V(::, atan, MathAtan, 0x1e2731d5)                                            \
   V(::, atan2, MathAtan2, 0x39f1fa41)                                          \
   V(::, cos, MathCos, 0x459bf5fe)                                              \
+  V(::, exp, MathExp, 0x32ab9efa)                                              \
+  V(::, log, MathLog, 0x1ee8f9fc)                                              \
   V(::, sin, MathSin, 0x6b7bd98c)                                              \
   V(::, sqrt, MathSqrt, 0x70482cf3)                                            \
   V(::, tan, MathTan, 0x3bcd772a)                                              \
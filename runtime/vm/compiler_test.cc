@@ -9,6 +9,7 @@
 #include "vm/dart_api_impl.h"
 #include "vm/heap/safepoint.h"
 #include "vm/kernel_isolate.h"
+#include "vm/metrics.h"
 #include "vm/object.h"
 #include "vm/symbols.h"
 #include "vm/thread_pool.h"
@@ -16,6 +17,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, max_polymorphic_range_checks);
+
 ISOLATE_UNIT_TEST_CASE(CompileScript) {
   const char* kScriptChars =
       "class A {\n"
@@ -110,6 +113,56 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+ISOLATE_UNIT_TEST_CASE(CompileFunctionsOnMultipleHelperThreads) {
+  const char* kScriptChars =
+      "class B {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 87; }\n"
+      "}\n";
+  String& url = String::Handle(
+      String::New("dart-test:CompileFunctionsOnMultipleHelperThreads"));
+  String& source = String::Handle(String::New(kScriptChars));
+  Script& script =
+      Script::Handle(Script::New(url, source, RawScript::kScriptTag));
+  Library& lib = Library::Handle(Library::CoreLibrary());
+  EXPECT(CompilerTest::TestCompileScript(lib, script));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "B"))));
+  EXPECT(!cls.IsNull());
+  Function& foo = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("foo"))));
+  Function& bar = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("bar"))));
+  CompilerTest::TestCompileFunction(foo);
+  CompilerTest::TestCompileFunction(bar);
+  EXPECT(!foo.HasOptimizedCode());
+  EXPECT(!bar.HasOptimizedCode());
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t saved_tasks = FLAG_background_compiler_tasks;
+  FLAG_background_compiler_tasks = 4;
+  Isolate* isolate = thread->isolate();
+  BackgroundCompiler::Start(isolate);
+  // Repeated requests are dropped while foo is queued or being compiled.
+  isolate->background_compiler()->CompileOptimized(foo);
+  isolate->background_compiler()->CompileOptimized(bar);
+  isolate->background_compiler()->CompileOptimized(foo);
+  Monitor* m = new Monitor();
+  {
+    MonitorLocker ml(m);
+    while (!foo.HasOptimizedCode() || !bar.HasOptimizedCode()) {
+      ml.WaitWithSafepointCheck(thread, 1);
+    }
+  }
+  delete m;
+  BackgroundCompiler::Stop(isolate);
+  EXPECT(!BackgroundCompiler::IsRunning(isolate));
+  FLAG_background_compiler_tasks = saved_tasks;
+}
+
 TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
@@ -147,6 +200,229 @@ TEST_CASE(RegenerateAllocStubs) {
   EXPECT_VALID(result);
 }
 
+// Calls go through the unoptimized, intermediate and fully optimized code of
+// value and sum, which must all compute the same result.
+TEST_CASE(CompileIntermediateTier) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  final int x;\n"
+      "  A(this.x);\n"
+      "  int get value => x;\n"
+      "}\n"
+      "int sum(List<A> l) {\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < l.length; i++) s += l[i].value;\n"
+      "  return s;\n"
+      "}\n"
+      "int main() {\n"
+      "  var l = new List<A>.generate(10, (i) => new A(i));\n"
+      "  int s = 0;\n"
+      "  for (int i = 0; i < 1000; i++) s += sum(l);\n"
+      "  return s;\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_intermediate_tier_threshold, 10);
+  SetFlagScope<int> sfs2(&FLAG_optimization_counter_threshold, 100);
+  SetFlagScope<bool> sfs3(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  EXPECT_EQ(45000, value);
+
+  TransitionNativeToVM transition(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& sum = Function::Handle(
+      library.LookupLocalFunction(String::Handle(Symbols::New(thread, "sum"))));
+  EXPECT(sum.HasOptimizedCode());
+}
+
+static void InvokeRepeatedly(Dart_Handle lib, const char* name, intptr_t n) {
+  Dart_Handle args[1] = {Dart_NewInteger(1)};
+  for (intptr_t i = 0; i < n; i++) {
+    Dart_Handle result = Dart_Invoke(lib, NewString(name), 1, args);
+    EXPECT_VALID(result);
+  }
+}
+
+static intptr_t InlinedFunctionCount(const Function& function) {
+  const Code& code = Code::Handle(function.CurrentCode());
+  // The function itself is the first entry.
+  return Array::Handle(code.inlined_id_to_function()).Length() - 1;
+}
+
+// A function is first optimized by the intermediate tier, which counts
+// invocations and does not inline ordinary callees, and later replaced by
+// fully optimized code, which inlines them.
+TEST_CASE(CompileIntermediateTierThenFullTier) {
+  const char* kScriptChars =
+      "int twice(int x) { return x + x; }\n"
+      "int run(int x) { return twice(x) + 1; }\n";
+  SetFlagScope<int> sfs(&FLAG_intermediate_tier_threshold, 10);
+  SetFlagScope<int> sfs2(&FLAG_optimization_counter_threshold, 100);
+  SetFlagScope<bool> sfs3(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  InvokeRepeatedly(lib, "run", 20);
+
+  TransitionNativeToVM transition(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& run = Function::Handle(
+      library.LookupLocalFunction(String::Handle(Symbols::New(thread, "run"))));
+  EXPECT(run.HasOptimizedCode());
+  EXPECT_EQ(0, InlinedFunctionCount(run));
+  const Code& intermediate_code = Code::Handle(run.CurrentCode());
+  intptr_t usage_counter = run.usage_counter();
+
+  // Intermediate tier code counts its invocations at entry.
+  {
+    TransitionVMToNative transition(thread);
+    InvokeRepeatedly(lib, "run", 5);
+  }
+  EXPECT(intermediate_code.raw() == run.CurrentCode());
+  EXPECT_EQ(usage_counter + 5, run.usage_counter());
+
+  {
+    TransitionVMToNative transition(thread);
+    InvokeRepeatedly(lib, "run", 200);
+  }
+  EXPECT(run.HasOptimizedCode());
+  EXPECT(intermediate_code.raw() != run.CurrentCode());
+  EXPECT_EQ(1, InlinedFunctionCount(run));
+
+  // Fully optimized code no longer counts at entry.
+  usage_counter = run.usage_counter();
+  {
+    TransitionVMToNative transition(thread);
+    InvokeRepeatedly(lib, "run", 5);
+  }
+  EXPECT_EQ(usage_counter, run.usage_counter());
+}
+
+// Calls 'callF' with instances of six subclasses of A interleaved with six
+// subclasses of B, so the call to f has twelve class id ranges but only two
+// targets. Returns the number of functions inlined into 'callF'.
+static intptr_t InlinedAtPolymorphicRanges(Thread* thread) {
+  const char* kScriptChars =
+      "class A { int f() => 1; }\n"
+      "class B extends A { int f() => 2; }\n"
+      "class A1 extends A {}\n"
+      "class B1 extends B {}\n"
+      "class A2 extends A {}\n"
+      "class B2 extends B {}\n"
+      "class A3 extends A {}\n"
+      "class B3 extends B {}\n"
+      "class A4 extends A {}\n"
+      "class B4 extends B {}\n"
+      "class A5 extends A {}\n"
+      "class B5 extends B {}\n"
+      "final objects = <A>[new A(), new B(), new A1(), new B1(), new A2(),\n"
+      "    new B2(), new A3(), new B3(), new A4(), new B4(), new A5(),\n"
+      "    new B5()];\n"
+      "A make(int i) => objects[i];\n"
+      "int callF(A a) => a.f();\n";
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 100);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  const intptr_t kNumObjects = 12;
+  Dart_Handle objects[kNumObjects];
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    Dart_Handle index = Dart_NewInteger(i);
+    objects[i] = Dart_Invoke(lib, NewString("make"), 1, &index);
+    EXPECT_VALID(objects[i]);
+  }
+  for (intptr_t n = 0; n < 20; n++) {
+    for (intptr_t i = 0; i < kNumObjects; i++) {
+      Dart_Handle result = Dart_Invoke(lib, NewString("callF"), 1, &objects[i]);
+      EXPECT_VALID(result);
+      int64_t value = 0;
+      EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+      EXPECT_EQ((i % 2) + 1, value);
+    }
+  }
+
+  TransitionNativeToVM transition(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& call_f = Function::Handle(library.LookupLocalFunction(
+      String::Handle(Symbols::New(thread, "callF"))));
+  EXPECT(call_f.HasOptimizedCode());
+  return InlinedFunctionCount(call_f);
+}
+
+// More ranges than --max_polymorphic_checks are inlined when they reach few
+// enough targets, and each target is inlined once.
+TEST_CASE(PolymorphicInliningOfSharedTargets) {
+  EXPECT_EQ(2, InlinedAtPolymorphicRanges(thread));
+}
+
+TEST_CASE(PolymorphicInliningOfTooManyRanges) {
+  SetFlagScope<int> sfs(&FLAG_max_polymorphic_range_checks, 4);
+  EXPECT_EQ(0, InlinedAtPolymorphicRanges(thread));
+}
+
+#ifndef PRODUCT
+static void InvokeLoop(Dart_Handle lib) {
+  Dart_Handle args[1] = {Dart_NewInteger(10000)};
+  Dart_Handle result = Dart_Invoke(lib, NewString("loop"), 1, args);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  EXPECT_EQ(49995000, value);
+}
+
+// A loop that gets hot again in a later unoptimized call enters the OSR code
+// compiled for it before, until its function deoptimizes.
+TEST_CASE(CompileOSRCodeOnceForLoop) {
+  const char* kScriptChars =
+      "int loop(int n) {\n"
+      "  var sum = 0;\n"
+      "  for (var i = 0; i < n; i++) sum += i;\n"
+      "  return sum;\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 100);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  HistogramMetric* optimized =
+      thread->isolate()->GetCompileOptimizedTimeMetric();
+  EXPECT(thread->isolate()->use_osr());
+
+  const int64_t compiles = optimized->count();
+  InvokeLoop(lib);
+  EXPECT_EQ(compiles + 1, optimized->count());
+
+  TransitionNativeToVM transition(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& loop = Function::Handle(library.LookupLocalFunction(
+      String::Handle(Symbols::New(thread, "loop"))));
+  // OSR code is not installed on the function.
+  EXPECT(!loop.HasOptimizedCode());
+
+  // Run unoptimized again, as while an optimization is pending.
+  loop.SetUsageCounter(0);
+  {
+    TransitionVMToNative transition(thread);
+    InvokeLoop(lib);
+  }
+  EXPECT_EQ(compiles + 1, optimized->count());
+
+  // After a deoptimization the feedback may have changed.
+  loop.set_deoptimization_counter(loop.deoptimization_counter() + 1);
+  loop.SetUsageCounter(0);
+  {
+    TransitionVMToNative transition(thread);
+    InvokeLoop(lib);
+  }
+  EXPECT_EQ(compiles + 2, optimized->count());
+}
+#endif  // !PRODUCT
+
 TEST_CASE(EvalExpression) {
   const char* kScriptChars =
       "int ten = 2 * 5;              \n"
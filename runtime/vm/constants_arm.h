@@ -284,6 +284,10 @@ const Register kStackTraceObjectReg = R1;
 const Register kWriteBarrierObjectReg = R1;
 const Register kWriteBarrierValueReg = R0;
 
+// ABI for the shared range error stub.
+const Register kRangeErrorLengthReg = R1;
+const Register kRangeErrorIndexReg = R0;
+
 // List of registers used in load/store multiple.
 typedef uint16_t RegList;
 const RegList kAllCpuRegistersList = 0xFFFF;
@@ -125,6 +125,11 @@ const Register kStackTraceObjectReg = R1;
 // ABI for write barrier stub.
 const Register kWriteBarrierObjectReg = R1;
 const Register kWriteBarrierValueReg = R0;
+const Register kWriteBarrierSlotReg = R25;
+
+// ABI for the shared range error stub.
+const Register kRangeErrorLengthReg = R1;
+const Register kRangeErrorIndexReg = R0;
 
 // Masks, sizes, etc.
 const int kXRegSizeInBits = 64;
@@ -662,14 +667,17 @@ enum FPIntCvtOp {
   SCVTFD = FPIntCvtFixed | B22 | B17,
 };
 
-#define APPLY_OP_LIST(_V)                                                      \
+// Instruction classes, which only group the instructions listed below.
+#define APPLY_OP_CLASS_LIST(_V)                                                \
   _V(DPImmediate)                                                              \
   _V(CompareBranch)                                                            \
   _V(LoadStore)                                                                \
   _V(DPRegister)                                                               \
   _V(DPSimd1)                                                                  \
   _V(DPSimd2)                                                                  \
-  _V(FP)                                                                       \
+  _V(FP)
+
+#define APPLY_LEAF_OP_LIST(_V)                                                 \
   _V(CompareAndBranch)                                                         \
   _V(ConditionalBranch)                                                        \
   _V(ExceptionGen)                                                             \
@@ -702,6 +710,10 @@ enum FPIntCvtOp {
   _V(FPImm)                                                                    \
   _V(FPIntCvt)
 
+#define APPLY_OP_LIST(_V)                                                      \
+  APPLY_OP_CLASS_LIST(_V)                                                      \
+  APPLY_LEAF_OP_LIST(_V)
+
 enum Shift {
   kNoShift = -1,
   LSL = 0,  // Logical shift left
@@ -239,7 +239,7 @@ namespace dart {
 //
 //    Arithmetic operations on unboxed doubles. FP[rA] <- FP[rB] op FP[rC].
 //
-//  - DNeg, DCos, DSin, DSqrt rA, rD
+//  - DNeg, DCos, DSin, DExp, DLog, DSqrt rA, rD
 //
 //    FP[rA] <- op(FP[rD]). Assumes FP[rD] is an unboxed double.
 //
@@ -399,13 +399,13 @@ namespace dart {
 //
 //  - StoreIndexed{N}{Type} rA, rB, rC
 //
-//    Where Type is Float32, Float64, Uint8, or OneByteString
-//    Where N is '', '4', or '8'. N may only be '4' for Float32 and '8' for
-//    Float64.
+//    Where Type is Float32, Float64, Uint8, Uint32, or OneByteString
+//    Where N is '', '4', or '8'. N may only be '4' for Float32 and Uint32, and
+//    '8' for Float64.
 //
-//    Store the unboxed double or tagged Smi in FP[rC] into the typed data array
-//    at FP[rA] at index FP[rB]. If N is not '', the index is assumed to be
-//    already scaled by N.
+//    Store the unboxed double, unboxed integer, or tagged Smi in FP[rC] into
+//    the typed data array at FP[rA] at index FP[rB]. If N is not '', the index
+//    is assumed to be already scaled by N.
 //
 //  - StoreIndexedExternalUint8 rA, rB, rC
 //
@@ -468,12 +468,12 @@ namespace dart {
 //  - LoadIndexed{N}{Type} rA, rB, rC
 //
 //    Where Type is Float32, Float64, OneByteString, TwoByteString, Uint8,
-//    Int8, and N is '', '4', or '8'. N may only be '4' for Float32, and may
-//    only be '8' for Float64.
+//    Int8, Int32, Uint32, and N is '', '4', or '8'. N may only be '4' for
+//    Float32, Int32 and Uint32, and may only be '8' for Float64.
 //
 //    Loads from typed data array FP[rB] at index FP[rC] into an unboxed double,
-//    or tagged Smi in FP[rA] as indicated by the type in the name. If N is not
-//    '', the index is assumed to be already scaled by N.
+//    unboxed integer, or tagged Smi in FP[rA] as indicated by the type in the
+//    name. If N is not '', the index is assumed to be already scaled by N.
 //
 //  - LoadIndexedExternal{Int8, Uint8} rA, rB, rC
 //
@@ -818,6 +818,8 @@ namespace dart {
   V(DMax,                              A_B_C, reg, reg, reg) \
   V(DCos,                                A_D, reg, reg, ___) \
   V(DSin,                                A_D, reg, reg, ___) \
+  V(DExp,                                A_D, reg, reg, ___) \
+  V(DLog,                                A_D, reg, reg, ___) \
   V(DPow,                              A_B_C, reg, reg, reg) \
   V(DMod,                              A_B_C, reg, reg, reg) \
   V(DTruncate,                           A_D, reg, reg, ___) \
@@ -870,6 +872,7 @@ namespace dart {
   V(StoreIndexedExternalUint8,         A_B_C, reg, reg, reg) \
   V(StoreIndexedOneByteString,         A_B_C, reg, reg, reg) \
   V(StoreIndexedUint32,                A_B_C, reg, reg, reg) \
+  V(StoreIndexed4Uint32,               A_B_C, reg, reg, reg) \
   V(StoreIndexedFloat32,               A_B_C, reg, reg, reg) \
   V(StoreIndexed4Float32,              A_B_C, reg, reg, reg) \
   V(StoreIndexedFloat64,               A_B_C, reg, reg, reg) \
@@ -889,6 +892,8 @@ namespace dart {
   V(LoadIndexedInt8,                   A_B_C, reg, reg, reg) \
   V(LoadIndexedInt32,                  A_B_C, reg, reg, reg) \
   V(LoadIndexedUint32,                 A_B_C, reg, reg, reg) \
+  V(LoadIndexed4Int32,                 A_B_C, reg, reg, reg) \
+  V(LoadIndexed4Uint32,                A_B_C, reg, reg, reg) \
   V(LoadIndexedExternalUint8,          A_B_C, reg, reg, reg) \
   V(LoadIndexedExternalInt8,           A_B_C, reg, reg, reg) \
   V(LoadIndexedFloat32,                A_B_C, reg, reg, reg) \
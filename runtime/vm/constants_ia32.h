@@ -73,6 +73,10 @@ const Register kStackTraceObjectReg = EDX;
 const Register kWriteBarrierObjectReg = EDX;
 const Register kWriteBarrierValueReg = kNoRegister;
 
+// ABI for the shared range error stub (unused, as ia32 shares no slow paths).
+const Register kRangeErrorLengthReg = EDX;
+const Register kRangeErrorIndexReg = EAX;
+
 typedef uint32_t RegList;
 const RegList kAllCpuRegistersList = 0xFF;
 
@@ -115,6 +115,11 @@ const Register kStackTraceObjectReg = RDX;
 // ABI for write barrier stub.
 const Register kWriteBarrierObjectReg = RDX;
 const Register kWriteBarrierValueReg = RAX;
+const Register kWriteBarrierSlotReg = R13;
+
+// ABI for the shared range error stub.
+const Register kRangeErrorLengthReg = RDX;
+const Register kRangeErrorIndexReg = RAX;
 
 typedef uint32_t RegList;
 const RegList kAllCpuRegistersList = 0xFFFF;
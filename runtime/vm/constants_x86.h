@@ -76,23 +76,29 @@ enum Condition {
   F(sbb, 3)                                                                    \
   F(cmp, 7)
 
-#define XMM_ALU_CODES(F)                                                       \
-  F(bad0, 0)                                                                   \
-  F(sqrt, 1)                                                                   \
-  F(rsqrt, 2)                                                                  \
-  F(rcp, 3)                                                                    \
-  F(and, 4)                                                                    \
-  F(bad1, 5)                                                                   \
-  F(or, 6)                                                                     \
-  F(xor, 7)                                                                    \
-  F(add, 8)                                                                    \
-  F(mul, 9)                                                                    \
-  F(bad2, 0xA)                                                                 \
-  F(bad3, 0xB)                                                                 \
-  F(sub, 0xC)                                                                  \
-  F(min, 0xD)                                                                  \
-  F(div, 0xE)                                                                  \
-  F(max, 0xF)
+// The packed XMM ALU operations. OP entries also have a three-operand VEX
+// form; UN entries, the unary operations and unused codes, have none.
+#define XMM_ALU_TABLE(UN, OP)                                                  \
+  UN(bad0, 0)                                                                  \
+  UN(sqrt, 1)                                                                  \
+  UN(rsqrt, 2)                                                                 \
+  UN(rcp, 3)                                                                   \
+  OP(and, 4)                                                                   \
+  UN(bad1, 5)                                                                  \
+  OP(or, 6)                                                                    \
+  OP(xor, 7)                                                                   \
+  OP(add, 8)                                                                   \
+  OP(mul, 9)                                                                   \
+  UN(bad2, 0xA)                                                                \
+  UN(bad3, 0xB)                                                                \
+  OP(sub, 0xC)                                                                 \
+  OP(min, 0xD)                                                                 \
+  OP(div, 0xE)                                                                 \
+  OP(max, 0xF)
+
+#define XMM_ALU_IGNORE(name, code)
+#define XMM_ALU_CODES(F) XMM_ALU_TABLE(F, F)
+#define XMM_VEX_ALU_CODES(F) XMM_ALU_TABLE(XMM_ALU_IGNORE, F)
 // clang-format on
 
 // Table 3-1, first part
@@ -18,6 +18,7 @@
 namespace dart {
 
 DEFINE_FLAG(bool, use_sse41, true, "Use SSE 4.1 if available");
+DEFINE_FLAG(bool, use_avx, true, "Use AVX encodings if available");
 
 void CPU::FlushICache(uword start, uword size) {
   // Nothing to be done here.
@@ -29,6 +30,7 @@ const char* CPU::Id() {
 
 bool HostCPUFeatures::sse2_supported_ = true;
 bool HostCPUFeatures::sse4_1_supported_ = false;
+bool HostCPUFeatures::avx_supported_ = false;
 const char* HostCPUFeatures::hardware_ = NULL;
 #if defined(DEBUG)
 bool HostCPUFeatures::initialized_ = false;
@@ -39,6 +41,8 @@ void HostCPUFeatures::Init() {
   hardware_ = CpuInfo::GetCpuModel();
   sse4_1_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "sse4_1") ||
                       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4.1");
+  avx_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "avx") ||
+                   CpuInfo::FieldContains(kCpuInfoFeatures, "AVX1.0");
 
 #if defined(DEBUG)
   initialized_ = true;
@@ -6,6 +6,8 @@
 #if !defined(HOST_OS_MACOS)
 #include "vm/cpuid.h"
 
+#include "platform/utils.h"
+
 #if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
 // GetCpuId() on Windows, __get_cpuid() on Linux
 #if defined(HOST_OS_WINDOWS)
@@ -19,6 +21,7 @@ namespace dart {
 
 bool CpuId::sse2_ = false;
 bool CpuId::sse41_ = false;
+bool CpuId::avx_ = false;
 const char* CpuId::id_string_ = NULL;
 const char* CpuId::brand_string_ = NULL;
 
@@ -34,6 +37,18 @@ void CpuId::GetCpuId(int32_t level, uint32_t info[4]) {
 #endif
 }
 
+// Returns the XCR0 register, which tells which register states the OS saves
+// on context switches.
+static uint64_t GetXCR0() {
+#if defined(HOST_OS_WINDOWS)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
 void CpuId::Init() {
   uint32_t info[4] = {static_cast<uint32_t>(-1)};
 
@@ -48,6 +63,12 @@ void CpuId::Init() {
   GetCpuId(1, info);
   CpuId::sse41_ = (info[2] & (1 << 19)) != 0;
   CpuId::sse2_ = (info[3] & (1 << 26)) != 0;
+  // AVX is only usable if the OS saves the XMM and YMM state (XCR0 bits 1
+  // and 2), which can only be read if OSXSAVE is set.
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const uint64_t kXmmYmmState = 0x6;
+  CpuId::avx_ = osxsave && ((info[2] & (1 << 28)) != 0) &&
+                ((GetXCR0() & kXmmYmmState) == kXmmYmmState);
 
   char* brand_string =
       reinterpret_cast<char*>(malloc(3 * 4 * sizeof(uint32_t)));
@@ -89,15 +110,13 @@ const char* CpuId::field(CpuInfoIndices idx) {
     case kCpuInfoHardware:
       return brand_string();
     case kCpuInfoFeatures: {
-      if (sse2() && sse41()) {
-        return strdup("sse2 sse4.1");
-      } else if (sse2()) {
-        return strdup("sse2");
-      } else if (sse41()) {
-        return strdup("sse4.1");
-      } else {
-        return strdup("");
-      }
+      char buffer[32];
+      Utils::SNPrint(buffer, sizeof(buffer), "%s%s%s", sse2() ? "sse2 " : "",
+                     sse41() ? "sse4.1 " : "", avx() ? "avx " : "");
+      // Drop the trailing space.
+      const intptr_t length = strlen(buffer);
+      if (length > 0) buffer[length - 1] = '\0';
+      return strdup(buffer);
     }
     default: {
       UNREACHABLE();
@@ -122,7 +122,8 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
                  Dart_FileCloseCallback file_close,
                  Dart_EntropySource entropy_source,
                  Dart_GetVMServiceAssetsArchive get_service_assets,
-                 bool start_kernel_isolate) {
+                 bool start_kernel_isolate,
+                 Dart_HeapGrowthCallback heap_growth) {
   CheckOffsets();
   // TODO(iposva): Fix race condition here.
   if (vm_isolate_ != NULL || !Flags::Initialized()) {
@@ -164,6 +165,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   start_time_micros_ = OS::GetCurrentMonotonicMicros();
   VirtualMemory::Init();
   OSThread::Init();
+  Zone::Init();
   if (FLAG_support_timeline) {
     Timeline::Init();
   }
@@ -171,6 +173,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
       TimelineDurationScope tds(Timeline::GetVMStream(), "Dart::Init"));
   Isolate::InitVM();
   IdleNotifier::Init();
+  MessageHandlerScheduler::Init();
   PortMap::Init();
   FreeListElement::Init();
   ForwardingCorpse::Init();
@@ -178,6 +181,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   NativeSymbolResolver::Init();
   NOT_IN_PRODUCT(Profiler::Init());
   SemiSpace::Init();
+  HeapPage::Init();
   NOT_IN_PRODUCT(Metric::Init());
   StoreBuffer::Init();
   MarkingStack::Init();
@@ -324,6 +328,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   Isolate::SetCreateCallback(create);
   Isolate::SetShutdownCallback(shutdown);
   Isolate::SetCleanupCallback(cleanup);
+  Isolate::SetHeapGrowthCallback(heap_growth);
 
   if (FLAG_support_service) {
     Service::SetGetServiceAssetsCallback(get_service_assets);
@@ -501,6 +506,7 @@ char* Dart::Cleanup() {
   ASSERT(Isolate::IsolateListLength() == 0);
   PortMap::Cleanup();
   IdleNotifier::Cleanup();
+  MessageHandlerScheduler::Cleanup();
   ICData::Cleanup();
   ArgumentsDescriptor::Cleanup();
   TargetCPUFeatures::Cleanup();
@@ -508,6 +514,7 @@ char* Dart::Cleanup() {
   StoreBuffer::Cleanup();
   Object::Cleanup();
   SemiSpace::Cleanup();
+  HeapPage::Cleanup();
 #if !defined(DART_PRECOMPILED_RUNTIME)
   // Stubs are generated when not precompiled, clean them up.
   StubCode::Cleanup();
@@ -540,6 +547,7 @@ char* Dart::Cleanup() {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Done\n", UptimeMillis());
   }
   MallocHooks::Cleanup();
+  Zone::Cleanup();
   Flags::Cleanup();
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
   IsolateReloadContext::SetFileModifiedCallback(NULL);
@@ -772,6 +780,8 @@ const char* Dart::FeaturesString(Isolate* isolate,
 #else
     buffer.AddString(" x64-sysv");
 #endif
+    // Code generated with AVX enabled uses VEX encodings.
+    buffer.AddString(TargetCPUFeatures::avx_supported() ? " avx" : " no-avx");
 
 #elif defined(TARGET_ARCH_DBC)
 #if defined(ARCH_IS_32_BIT)
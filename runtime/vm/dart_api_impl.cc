@@ -24,6 +24,7 @@
 #include "vm/exceptions.h"
 #include "vm/flags.h"
 #include "vm/growable_array.h"
+#include "vm/heap/pages.h"
 #include "vm/heap/verifier.h"
 #include "vm/image_snapshot.h"
 #include "vm/isolate_reload.h"
@@ -679,9 +680,17 @@ void FinalizablePersistentHandle::Finalize(
   ASSERT(callback != NULL);
   void* peer = handle->peer();
   Dart_WeakPersistentHandle object = handle->apiHandle();
-  (*callback)(isolate->init_callback_data(), object, peer);
   ApiState* state = isolate->api_state();
   ASSERT(state != NULL);
+  if (FLAG_background_finalizers && isolate->heap()->GCInProgress()) {
+    // Defer the callback until the pause is over. The handle is already
+    // invalid when it runs.
+    state->weak_persistent_handles().FreeHandle(handle);
+    state->finalization_queue()->Enqueue(
+        callback, isolate->init_callback_data(), object, peer);
+    return;
+  }
+  (*callback)(isolate->init_callback_data(), object, peer);
   state->weak_persistent_handles().FreeHandle(handle);
 }
 
@@ -1006,7 +1015,7 @@ DART_EXPORT char* Dart_Initialize(Dart_InitializeParams* params) {
                     params->thread_exit, params->file_open, params->file_read,
                     params->file_write, params->file_close,
                     params->entropy_source, params->get_service_assets,
-                    params->start_kernel_isolate);
+                    params->start_kernel_isolate, params->heap_growth);
 }
 
 DART_EXPORT char* Dart_Cleanup() {
@@ -1053,6 +1062,25 @@ VM_METRIC_LIST(VM_METRIC_API);
 ISOLATE_METRIC_LIST(ISOLATE_METRIC_API);
 #endif  // !defined(PRODUCT)
 
+DART_EXPORT void Dart_IsolateGetStats(Dart_Isolate isolate,
+                                      Dart_IsolateStats* stats) {
+  if (isolate == NULL) {
+    FATAL1("%s expects argument 'isolate' to be non-null.", CURRENT_FUNC);
+  }
+  if (stats == NULL) {
+    FATAL1("%s expects argument 'stats' to be non-null.", CURRENT_FUNC);
+  }
+  Isolate* iso = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = iso->heap();
+  stats->cpu_time_micros = iso->MutatorCpuTimeMicros();
+  stats->new_allocated_bytes = heap->AllocatedInWords(Heap::kNew) * kWordSize;
+  stats->old_allocated_bytes = heap->AllocatedInWords(Heap::kOld) * kWordSize;
+  stats->gc_time_micros =
+      heap->GCTimeInMicros(Heap::kNew) + heap->GCTimeInMicros(Heap::kOld);
+  stats->gc_count =
+      heap->Collections(Heap::kNew) + heap->Collections(Heap::kOld);
+}
+
 // --- Isolates ---
 
 static char* BuildIsolateName(const char* script_uri, const char* main) {
@@ -1436,6 +1464,8 @@ DART_EXPORT void Dart_NotifyIdle(int64_t deadline) {
 DART_EXPORT void Dart_NotifyLowMemory() {
   API_TIMELINE_BEGIN_END(Thread::Current());
   Isolate::NotifyLowMemory();
+  Zone::ClearCache();
+  HeapPage::ClearCache();
 }
 
 DART_EXPORT void Dart_ExitIsolate() {
@@ -1459,6 +1489,22 @@ static uint8_t* ApiReallocate(uint8_t* ptr,
       ->Realloc<uint8_t>(ptr, old_size, new_size);
 }
 
+// Deferred libraries that were not loaded yet would be missing from a full
+// snapshot. Kernel programs are loaded as a whole, deferred libraries
+// included, so their snapshots are complete without --load_deferred_eagerly.
+static bool AllLibrariesLoaded(Thread* T) {
+  const GrowableObjectArray& libraries = GrowableObjectArray::Handle(
+      Z, T->isolate()->object_store()->libraries());
+  Library& library = Library::Handle(Z);
+  for (intptr_t i = 0; i < libraries.Length(); i++) {
+    library ^= libraries.At(i);
+    if (!library.Loaded()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 DART_EXPORT Dart_Handle
 Dart_CreateSnapshot(uint8_t** vm_snapshot_data_buffer,
                     intptr_t* vm_snapshot_data_size,
@@ -1467,7 +1513,7 @@ Dart_CreateSnapshot(uint8_t** vm_snapshot_data_buffer,
   DARTSCOPE(Thread::Current());
   API_TIMELINE_DURATION(T);
   Isolate* I = T->isolate();
-  if (!FLAG_load_deferred_eagerly) {
+  if (!FLAG_load_deferred_eagerly && !AllLibrariesLoaded(T)) {
     return Api::NewError(
         "Creating full snapshots requires --load_deferred_eagerly");
   }
@@ -1725,6 +1771,34 @@ DART_EXPORT bool Dart_Post(Dart_Port port_id, Dart_Handle handle) {
       writer.WriteMessage(object, port_id, Message::kNormalPriority));
 }
 
+DART_EXPORT bool Dart_PostTransfer(Dart_Port port_id, Dart_Handle handle) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  NoSafepointScope no_safepoint_scope;
+  if (port_id == ILLEGAL_PORT) {
+    return false;
+  }
+
+  RawObject* raw_obj = Api::UnwrapHandle(handle);
+  if (ApiObjectConverter::CanConvert(raw_obj)) {
+    return PortMap::PostMessage(
+        new Message(port_id, raw_obj, Message::kNormalPriority));
+  }
+
+  const Object& object = Object::Handle(Z, raw_obj);
+  MessageWriter writer(false, true /* transfer_external_typed_data */);
+  Message* message =
+      writer.WriteMessage(object, port_id, Message::kNormalPriority);
+  if (!PortMap::TryPostMessage(message)) {
+    // Nothing was handed over, so the sender keeps its data.
+    writer.CancelTransfers(message->finalizable_data());
+    delete message;
+    return false;
+  }
+  writer.CompleteTransfers();
+  return true;
+}
+
 DART_EXPORT Dart_Handle Dart_NewSendPort(Dart_Port port_id) {
   DARTSCOPE(Thread::Current());
   CHECK_CALLBACK_STATE(T);
@@ -2424,6 +2498,41 @@ Dart_NewExternalLatin1String(const uint8_t* latin1_array,
                           callback, SpaceForExternal(T, length)));
 }
 
+DART_EXPORT Dart_Handle
+Dart_NewExternalUTF8String(const uint8_t* utf8_array,
+                           intptr_t length,
+                           void* peer,
+                           intptr_t external_allocation_size,
+                           Dart_WeakPersistentHandleFinalizer callback) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  if (utf8_array == NULL && length != 0) {
+    RETURN_NULL_ERROR(utf8_array);
+  }
+  if (callback == NULL) {
+    RETURN_NULL_ERROR(callback);
+  }
+  CHECK_LENGTH(length, String::kMaxElements);
+  CHECK_CALLBACK_STATE(T);
+  // ASCII is also Latin-1, one character per byte, so the array can be used
+  // as it is.
+  Utf8::Type type;
+  if ((Utf8::CodeUnitCount(utf8_array, length, &type) == length) &&
+      (type == Utf8::kLatin1)) {
+    return Api::NewHandle(
+        T,
+        String::NewExternal(utf8_array, length, peer, external_allocation_size,
+                            callback, SpaceForExternal(T, length)));
+  }
+  if (!Utf8::IsValid(utf8_array, length)) {
+    return Api::NewError("%s expects argument 'utf8_array' to be valid UTF-8.",
+                         CURRENT_FUNC);
+  }
+  const String& str = String::Handle(Z, String::FromUTF8(utf8_array, length));
+  AllocateFinalizableHandle(T, str, peer, external_allocation_size, callback);
+  return Api::NewHandle(T, str.raw());
+}
+
 DART_EXPORT Dart_Handle
 Dart_NewExternalUTF16String(const uint16_t* utf16_array,
                             intptr_t length,
@@ -3307,7 +3416,13 @@ static Dart_Handle NewByteData(Thread* thread, intptr_t length) {
 
 static Dart_Handle NewTypedData(Thread* thread, intptr_t cid, intptr_t length) {
   CHECK_LENGTH(length, TypedData::MaxElements(cid));
-  return Api::NewHandle(thread, TypedData::New(cid, length));
+  // Allocate data that needs a large page there directly, so that it is
+  // pinned and can be acquired without blocking GC.
+  const intptr_t size =
+      TypedData::InstanceSize(length * TypedData::ElementSizeInBytes(cid));
+  const Heap::Space space =
+      (size >= PageSpace::kAllocatablePageSize) ? Heap::kOld : Heap::kNew;
+  return Api::NewHandle(thread, TypedData::New(cid, length, space));
 }
 
 static Dart_Handle NewExternalTypedData(
@@ -3567,6 +3682,34 @@ class AcquiredData {
   DISALLOW_COPY_AND_ASSIGN(AcquiredData);
 };
 
+// Old-space objects too big for a regular page live alone in a large page,
+// and neither the scavenger nor the compactor ever moves them. Native code can
+// therefore keep a pointer into such typed data without blocking GC.
+static bool IsPinnedTypedData(RawObject* raw) {
+  return raw->IsOldObject() && (raw->Size() >= PageSpace::kAllocatablePageSize);
+}
+
+// Returns whether acquired data has to be protected from GC until released,
+// i.e. whether it lives in a typed data object that can be moved.
+static bool AcquireNeedsNoSafepointScope(Zone* zone,
+                                         Dart_Handle object,
+                                         intptr_t class_id) {
+  if (RawObject::IsExternalTypedDataClassId(class_id)) {
+    return false;
+  }
+  RawObject* raw = Api::UnwrapHandle(object);
+  if (RawObject::IsTypedDataViewClassId(class_id)) {
+    const Instance& view_obj = Api::UnwrapInstanceHandle(zone, object);
+    const Instance& data =
+        Instance::Handle(zone, TypedDataView::Data(view_obj));
+    if (data.IsExternalTypedData()) {
+      return false;
+    }
+    raw = data.raw();
+  }
+  return !IsPinnedTypedData(raw);
+}
+
 DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
                                                   Dart_TypedData_Type* type,
                                                   void** data,
@@ -3609,8 +3752,10 @@ DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
     ASSERT(!obj.IsNull());
     length = obj.Length();
     size_in_bytes = length * TypedData::ElementSizeInBytes(class_id);
-    T->IncrementNoSafepointScopeDepth();
-    START_NO_CALLBACK_SCOPE(T);
+    if (AcquireNeedsNoSafepointScope(Z, object, class_id)) {
+      T->IncrementNoSafepointScopeDepth();
+      START_NO_CALLBACK_SCOPE(T);
+    }
     data_tmp = obj.DataAddr(0);
   } else {
     ASSERT(RawObject::IsTypedDataViewClassId(class_id));
@@ -3623,8 +3768,10 @@ DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
     val ^= TypedDataView::OffsetInBytes(view_obj);
     intptr_t offset_in_bytes = val.Value();
     const Instance& obj = Instance::Handle(TypedDataView::Data(view_obj));
-    T->IncrementNoSafepointScopeDepth();
-    START_NO_CALLBACK_SCOPE(T);
+    if (AcquireNeedsNoSafepointScope(Z, object, class_id)) {
+      T->IncrementNoSafepointScopeDepth();
+      START_NO_CALLBACK_SCOPE(T);
+    }
     if (TypedData::IsTypedData(obj)) {
       const TypedData& data_obj = TypedData::Cast(obj);
       data_tmp = data_obj.DataAddr(offset_in_bytes);
@@ -3668,7 +3815,7 @@ DART_EXPORT Dart_Handle Dart_TypedDataReleaseData(Dart_Handle object) {
       !RawObject::IsTypedDataClassId(class_id)) {
     RETURN_TYPE_ERROR(Z, object, 'TypedData');
   }
-  if (!RawObject::IsExternalTypedDataClassId(class_id)) {
+  if (AcquireNeedsNoSafepointScope(Z, object, class_id)) {
     T->DecrementNoSafepointScopeDepth();
     END_NO_CALLBACK_SCOPE(T);
   }
@@ -4197,6 +4344,236 @@ DART_EXPORT Dart_Handle Dart_InvokeClosure(Dart_Handle closure,
   return Api::NewHandle(T, DartEntry::InvokeClosure(args));
 }
 
+DART_EXPORT Dart_Handle Dart_LookupStaticFunction(Dart_Handle target,
+                                                  Dart_Handle name) {
+  DARTSCOPE(Thread::Current());
+  const String& function_name = Api::UnwrapStringHandle(Z, name);
+  if (function_name.IsNull()) {
+    RETURN_TYPE_ERROR(Z, name, String);
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(target));
+  if (obj.IsError()) {
+    return target;
+  }
+  Function& func = Function::Handle(Z);
+  if (obj.IsType()) {
+    if (!Type::Cast(obj).IsFinalized()) {
+      return Api::NewError(
+          "%s expects argument 'target' to be a fully resolved type.",
+          CURRENT_FUNC);
+    }
+    const Class& cls = Class::Handle(Z, Type::Cast(obj).type_class());
+    const Error& error = Error::Handle(Z, cls.EnsureIsFinalized(T));
+    if (!error.IsNull()) {
+      return Api::NewHandle(T, error.raw());
+    }
+    func = cls.LookupStaticFunctionAllowPrivate(function_name);
+  } else if (obj.IsLibrary()) {
+    const Library& lib = Library::Cast(obj);
+    if (!lib.Loaded()) {
+      return Api::NewError("%s expects library argument 'target' to be loaded.",
+                           CURRENT_FUNC);
+    }
+    func = lib.LookupFunctionAllowPrivate(function_name);
+  } else {
+    return Api::NewError(
+        "%s expects argument 'target' to be a type or library.", CURRENT_FUNC);
+  }
+  if (func.IsNull() || !func.is_static() ||
+      (func.kind() != RawFunction::kRegularFunction)) {
+    return Api::NewError("%s: '%s' is not a static function.", CURRENT_FUNC,
+                         function_name.ToCString());
+  }
+  return Api::NewHandle(T, func.raw());
+}
+
+// Stores the unboxed arguments in args, starting at offset. Integers that fit
+// in a Smi, the common case, are passed without allocating a box.
+static void SetupUnboxedArguments(Zone* zone,
+                                  int number_of_arguments,
+                                  const Dart_UnboxedValue* arguments,
+                                  intptr_t offset,
+                                  const Array& args) {
+  Instance& arg = Instance::Handle(zone);
+  for (int i = 0; i < number_of_arguments; i++) {
+    if (arguments[i].is_double) {
+      arg = Double::New(arguments[i].value.as_double);
+    } else {
+      arg = Integer::New(arguments[i].value.as_int64);
+    }
+    args.SetAt(i + offset, arg);
+  }
+}
+
+// Checks the argument types, like the invocations through Dart_Invoke do,
+// and then calls func with args.
+static RawObject* InvokeCheckedFunction(
+    Zone* zone,
+    const Function& func,
+    const Array& args,
+    const TypeArguments& instantiator_type_args) {
+  const int kTypeArgsLen = 0;
+  const Array& args_descriptor_array = Array::Handle(
+      zone, ArgumentsDescriptor::New(kTypeArgsLen, args.Length()));
+  ArgumentsDescriptor args_descriptor(args_descriptor_array);
+  RawObject* type_error = func.DoArgumentTypesMatch(args, args_descriptor,
+                                                    instantiator_type_args);
+  if (type_error != Error::null()) {
+    return type_error;
+  }
+  return DartEntry::InvokeFunction(func, args, args_descriptor_array);
+}
+
+// Returns false if retval is not a number.
+static bool UnboxResult(const Object& retval, Dart_UnboxedValue* result) {
+  if (retval.IsInteger()) {
+    result->is_double = false;
+    result->value.as_int64 = Integer::Cast(retval).AsInt64Value();
+    return true;
+  }
+  if (retval.IsDouble()) {
+    result->is_double = true;
+    result->value.as_double = Double::Cast(retval).value();
+    return true;
+  }
+  return false;
+}
+
+DART_EXPORT Dart_Handle
+Dart_InvokeStaticFunction(Dart_Handle function,
+                          int number_of_arguments,
+                          const Dart_UnboxedValue* arguments,
+                          Dart_UnboxedValue* result) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  CHECK_CALLBACK_STATE(T);
+  const Function& func = Api::UnwrapFunctionHandle(Z, function);
+  if (func.IsNull()) {
+    RETURN_TYPE_ERROR(Z, function, Function);
+  }
+  const int kTypeArgsLen = 0;
+  if (!func.is_static() || func.IsGeneric() ||
+      !func.AreValidArgumentCounts(kTypeArgsLen, number_of_arguments, 0,
+                                   NULL)) {
+    return Api::NewError(
+        "%s expects argument 'function' to be a static function taking %d "
+        "arguments.",
+        CURRENT_FUNC, number_of_arguments);
+  }
+  if ((number_of_arguments > 0) && (arguments == NULL)) {
+    RETURN_NULL_ERROR(arguments);
+  }
+
+  const Array& args = Array::Handle(Z, Array::New(number_of_arguments));
+  SetupUnboxedArguments(Z, number_of_arguments, arguments, 0, args);
+  const Object& retval = Object::Handle(
+      Z, InvokeCheckedFunction(Z, func, args, Object::null_type_arguments()));
+  if (retval.IsError()) {
+    return Api::NewHandle(T, retval.raw());
+  }
+  if ((result != NULL) && !UnboxResult(retval, result)) {
+    return Api::NewError("%s expects the function to return a number.",
+                         CURRENT_FUNC);
+  }
+  return Api::Success();
+}
+
+DART_EXPORT Dart_Handle Dart_LookupMethod(Dart_Handle type, Dart_Handle name) {
+  DARTSCOPE(Thread::Current());
+  String& function_name =
+      String::Handle(Z, Api::UnwrapStringHandle(Z, name).raw());
+  if (function_name.IsNull()) {
+    RETURN_TYPE_ERROR(Z, name, String);
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(type));
+  if (obj.IsError()) {
+    return type;
+  }
+  if (!obj.IsType() || !Type::Cast(obj).IsFinalized()) {
+    return Api::NewError(
+        "%s expects argument 'type' to be a fully resolved type.",
+        CURRENT_FUNC);
+  }
+  const Class& cls = Class::Handle(Z, Type::Cast(obj).type_class());
+  const Error& error = Error::Handle(Z, cls.EnsureIsFinalized(T));
+  if (!error.IsNull()) {
+    return Api::NewHandle(T, error.raw());
+  }
+  if (Library::IsPrivate(function_name)) {
+    const Library& lib = Library::Handle(Z, cls.library());
+    function_name = lib.PrivateName(function_name);
+  }
+  const bool allow_add = false;
+  const Function& func = Function::Handle(
+      Z, Resolver::ResolveDynamicAnyArgs(Z, cls, function_name, allow_add));
+  if (func.IsNull() || func.is_static() || func.is_abstract() ||
+      (func.kind() != RawFunction::kRegularFunction)) {
+    return Api::NewError("%s: '%s' is not an instance method.", CURRENT_FUNC,
+                         function_name.ToCString());
+  }
+  return Api::NewHandle(T, func.raw());
+}
+
+DART_EXPORT Dart_Handle Dart_InvokeMethod(Dart_Handle receiver,
+                                          Dart_Handle function,
+                                          int number_of_arguments,
+                                          const Dart_UnboxedValue* arguments,
+                                          Dart_UnboxedValue* result) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  CHECK_CALLBACK_STATE(T);
+  const Function& func = Api::UnwrapFunctionHandle(Z, function);
+  if (func.IsNull()) {
+    RETURN_TYPE_ERROR(Z, function, Function);
+  }
+  const int kTypeArgsLen = 0;
+  if (func.is_static() || func.IsGeneric() ||
+      !func.AreValidArgumentCounts(kTypeArgsLen, number_of_arguments + 1, 0,
+                                   NULL)) {
+    return Api::NewError(
+        "%s expects argument 'function' to be an instance method taking %d "
+        "arguments.",
+        CURRENT_FUNC, number_of_arguments);
+  }
+  const Instance& instance = Api::UnwrapInstanceHandle(Z, receiver);
+  if (instance.IsNull()) {
+    RETURN_TYPE_ERROR(Z, receiver, Instance);
+  }
+  if ((number_of_arguments > 0) && (arguments == NULL)) {
+    RETURN_NULL_ERROR(arguments);
+  }
+  // The usual case is a receiver of the class declaring the method, which
+  // needs no lookup. Otherwise the method must not be overridden.
+  const Class& cls = Class::Handle(Z, instance.clazz());
+  if (cls.raw() != func.Owner()) {
+    const String& function_name = String::Handle(Z, func.name());
+    const bool allow_add = false;
+    if (Resolver::ResolveDynamicAnyArgs(Z, cls, function_name, allow_add) !=
+        func.raw()) {
+      return Api::NewError("%s: the receiver does not dispatch to '%s'.",
+                           CURRENT_FUNC, function_name.ToCString());
+    }
+  }
+
+  const Array& args = Array::Handle(Z, Array::New(number_of_arguments + 1));
+  args.SetAt(0, instance);
+  SetupUnboxedArguments(Z, number_of_arguments, arguments, 1, args);
+  TypeArguments& type_args = TypeArguments::Handle(Z);
+  if (cls.NumTypeArguments() > 0) {
+    type_args = instance.GetTypeArguments();
+  }
+  const Object& retval =
+      Object::Handle(Z, InvokeCheckedFunction(Z, func, args, type_args));
+  if (retval.IsError()) {
+    return Api::NewHandle(T, retval.raw());
+  }
+  if ((result != NULL) && !UnboxResult(retval, result)) {
+    return Api::NewError("%s expects the method to return a number.",
+                         CURRENT_FUNC);
+  }
+  return Api::Success();
+}
+
 DART_EXPORT Dart_Handle Dart_GetField(Dart_Handle container, Dart_Handle name) {
   DARTSCOPE(Thread::Current());
   API_TIMELINE_DURATION(T);
@@ -6104,6 +6481,48 @@ Dart_Handle Dart_SaveCompilationTrace(uint8_t** buffer,
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+DART_EXPORT
+Dart_Handle Dart_SaveStartupTrace(uint8_t** buffer, intptr_t* buffer_length) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return Api::NewError("%s: Cannot compile on an AOT runtime.", CURRENT_FUNC);
+#else
+  Thread* thread = Thread::Current();
+  API_TIMELINE_DURATION(thread);
+  DARTSCOPE(thread);
+  CHECK_NULL(buffer);
+  CHECK_NULL(buffer_length);
+  CompilationTraceSaver saver(thread->zone());
+  const GrowableObjectArray& functions = GrowableObjectArray::Handle(
+      Z, T->isolate()->object_store()->startup_functions());
+  if (!functions.IsNull()) {
+    Function& function = Function::Handle(Z);
+    for (intptr_t i = 0; i < functions.Length(); i++) {
+      function ^= functions.At(i);
+      saver.Visit(function);
+    }
+  }
+  saver.StealBuffer(buffer, buffer_length);
+  return Api::Success();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
+DART_EXPORT
+Dart_Handle Dart_SaveTypeFeedback(uint8_t** buffer, intptr_t* buffer_length) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return Api::NewError("%s: Cannot compile on an AOT runtime.", CURRENT_FUNC);
+#else
+  Thread* thread = Thread::Current();
+  API_TIMELINE_DURATION(thread);
+  DARTSCOPE(thread);
+  CHECK_NULL(buffer);
+  CHECK_NULL(buffer_length);
+  TypeFeedbackSaver saver(thread->zone());
+  ProgramVisitor::VisitFunctions(&saver);
+  saver.StealBuffer(buffer, buffer_length);
+  return Api::Success();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 DART_EXPORT
 Dart_Handle Dart_LoadCompilationTrace(uint8_t* buffer, intptr_t buffer_length) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -6378,7 +6797,7 @@ Dart_CreateAppJITSnapshotAsBlobs(uint8_t** isolate_snapshot_data_buffer,
   DARTSCOPE(Thread::Current());
   API_TIMELINE_DURATION(T);
   Isolate* I = T->isolate();
-  if (!FLAG_load_deferred_eagerly) {
+  if (!FLAG_load_deferred_eagerly && !AllLibrariesLoaded(T)) {
     return Api::NewError(
         "Creating full snapshots requires --load_deferred_eagerly");
   }
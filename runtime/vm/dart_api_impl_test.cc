@@ -12,6 +12,7 @@
 #include "platform/text_buffer.h"
 #include "platform/utils.h"
 #include "vm/class_finalizer.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
@@ -24,6 +25,8 @@
 namespace dart {
 
 DECLARE_FLAG(bool, verify_acquired_data);
+DECLARE_FLAG(int, startup_trace_duration);
+DECLARE_FLAG(int, survivor_aging_threshold);
 
 #ifndef PRODUCT
 
@@ -1442,6 +1445,47 @@ TEST_CASE(DartAPI_ExternalStringCallback) {
   }
 }
 
+TEST_CASE(DartAPI_ExternalUTF8String) {
+  int peer_ascii = 40;
+  int peer_utf8 = 41;
+
+  {
+    Dart_EnterScope();
+
+    uint8_t ascii[] = {'h', 'e', 'l', 'l', 'o'};
+    Dart_Handle ascii_str = Dart_NewExternalUTF8String(
+        ascii, ARRAY_SIZE(ascii), &peer_ascii, sizeof(ascii),
+        ExternalStringCallbackFinalizer);
+    EXPECT_VALID(ascii_str);
+    EXPECT(Dart_IsExternalString(ascii_str));
+
+    uint8_t utf8[] = {'o', 'n', 'e', 0xC2, 0xA2};
+    Dart_Handle utf8_str = Dart_NewExternalUTF8String(
+        utf8, ARRAY_SIZE(utf8), &peer_utf8, sizeof(utf8),
+        ExternalStringCallbackFinalizer);
+    EXPECT_VALID(utf8_str);
+    EXPECT(!Dart_IsExternalString(utf8_str));
+    intptr_t length = 0;
+    EXPECT_VALID(Dart_StringLength(utf8_str, &length));
+    EXPECT_EQ(4, length);
+
+    uint8_t invalid[] = {'a', 0xE2, 0x82};
+    Dart_Handle error = Dart_NewExternalUTF8String(
+        invalid, ARRAY_SIZE(invalid), NULL, 0, ExternalStringCallbackFinalizer);
+    EXPECT_ERROR(error, "expects argument 'utf8_array' to be valid UTF-8.");
+
+    Dart_ExitScope();
+  }
+
+  {
+    TransitionNativeToVM transition(thread);
+    Isolate::Current()->heap()->CollectGarbage(Heap::kNew);
+    GCTestHelper::WaitForGCTasks();
+    EXPECT_EQ(80, peer_ascii);
+    EXPECT_EQ(82, peer_utf8);
+  }
+}
+
 TEST_CASE(DartAPI_ExternalStringPretenure) {
   {
     Dart_EnterScope();
@@ -2410,6 +2454,35 @@ TEST_CASE(DartAPI_TypedDataViewDirectAccessVerified) {
   TestTypedDataViewDirectAccess();
 }
 
+TEST_CASE(DartAPI_TypedDataLargeDirectAccess) {
+  // Typed data big enough for a large page is not moved by GC, so acquiring
+  // it does not prevent allocation.
+  const intptr_t kLength = 128 * KB;
+  Dart_Handle array = Dart_NewTypedData(Dart_TypedData_kUint8, kLength);
+  EXPECT_VALID(array);
+  Dart_TypedData_Type type;
+  void* data;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(array, &type, &data, &len);
+  EXPECT_VALID(result);
+  EXPECT_EQ(Dart_TypedData_kUint8, type);
+  EXPECT_EQ(kLength, len);
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+  bytes[0] = 42;
+  bytes[kLength - 1] = 43;
+
+  EXPECT_VALID(NewString("No error expected here"));
+  {
+    TransitionNativeToVM transition(thread);
+    Isolate::Current()->heap()->CollectAllGarbage();
+  }
+
+  EXPECT_EQ(42, bytes[0]);
+  EXPECT_EQ(43, bytes[kLength - 1]);
+  result = Dart_TypedDataReleaseData(array);
+  EXPECT_VALID(result);
+}
+
 static void TestByteDataDirectAccess() {
   const char* kScriptChars =
       "import 'dart:typed_data';\n"
@@ -3053,6 +3126,57 @@ TEST_CASE(DartAPI_WeakPersistentHandleCallback) {
   }
 }
 
+TEST_CASE(DartAPI_WeakPersistentHandleBackgroundCallback) {
+  const bool saved_background_finalizers = FLAG_background_finalizers;
+  FLAG_background_finalizers = true;
+  int peer = 0;
+  {
+    Dart_EnterScope();
+    Dart_Handle obj = NewString("new string");
+    EXPECT_VALID(obj);
+    Dart_WeakPersistentHandle weak_ref = Dart_NewWeakPersistentHandle(
+        obj, &peer, 0, WeakPersistentHandlePeerFinalizer);
+    EXPECT_VALID(AsHandle(weak_ref));
+    Dart_ExitScope();
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::WaitForGCTasks();
+    // The callback may or may not have run on the background thread yet.
+    Isolate::Current()->api_state()->finalization_queue()->Drain();
+    EXPECT(peer == 42);
+  }
+  FLAG_background_finalizers = saved_background_finalizers;
+}
+
+TEST_CASE(DartAPI_WeakPersistentHandleReusedWithNewReferent) {
+  int peer1 = 0;
+  int peer2 = 0;
+  Dart_Isolate isolate = reinterpret_cast<Dart_Isolate>(Isolate::Current());
+  {
+    Dart_EnterScope();
+    Dart_Handle obj = NewString("new string");
+    EXPECT_VALID(obj);
+    // The second handle reuses the slot freed by the first one, which is
+    // still recorded as referring to new space.
+    Dart_WeakPersistentHandle weak1 = Dart_NewWeakPersistentHandle(
+        obj, &peer1, 0, WeakPersistentHandlePeerFinalizer);
+    Dart_DeleteWeakPersistentHandle(isolate, weak1);
+    Dart_WeakPersistentHandle weak2 = Dart_NewWeakPersistentHandle(
+        obj, &peer2, 0, WeakPersistentHandlePeerFinalizer);
+    EXPECT_VALID(AsHandle(weak2));
+    Dart_ExitScope();
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::WaitForGCTasks();
+    EXPECT(peer1 == 0);
+    EXPECT(peer2 == 42);
+  }
+}
+
 TEST_CASE(DartAPI_WeakPersistentHandleNoCallback) {
   Dart_WeakPersistentHandle weak_ref = NULL;
   int peer = 0;
@@ -3144,6 +3268,8 @@ TEST_CASE(DartAPI_WeakPersistentHandleExternalAllocationSize) {
 }
 
 TEST_CASE(DartAPI_WeakPersistentHandleExternalAllocationSizeNewspaceGC) {
+  // Expects promotion on the second scavenge.
+  SetFlagScope<int> sfs(&FLAG_survivor_aging_threshold, 0);
   Dart_Isolate isolate = reinterpret_cast<Dart_Isolate>(Isolate::Current());
   Heap* heap = Isolate::Current()->heap();
   Dart_WeakPersistentHandle weak1 = NULL;
@@ -5392,6 +5518,130 @@ TEST_CASE(DartAPI_InvokeClosure) {
   EXPECT(Dart_ErrorHasException(result));
 }
 
+TEST_CASE(DartAPI_InvokeStaticFunction) {
+  const char* kScriptChars =
+      "int mix(int a, double b) => a + b.floor();\n"
+      "double scale(double x, int k) => x * k;\n"
+      "void nothing() {}\n"
+      "int fails(int a) => throw 'failed $a';\n"
+      "class C {\n"
+      "  static int twice(int a) => 2 * a;\n"
+      "  int instance() => 1;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+
+  Dart_Handle mix = Dart_LookupStaticFunction(lib, NewString("mix"));
+  EXPECT_VALID(mix);
+  EXPECT(Dart_IsFunction(mix));
+  Dart_UnboxedValue args[2];
+  args[0].is_double = false;
+  args[0].value.as_int64 = kMaxInt64 - 10;
+  args[1].is_double = true;
+  args[1].value.as_double = 3.5;
+  Dart_UnboxedValue result;
+  for (intptr_t i = 0; i < 100; i++) {
+    EXPECT_VALID(Dart_InvokeStaticFunction(mix, 2, args, &result));
+    EXPECT(!result.is_double);
+    EXPECT_EQ(kMaxInt64 - 7, result.value.as_int64);
+  }
+
+  Dart_Handle scale = Dart_LookupStaticFunction(lib, NewString("scale"));
+  EXPECT_VALID(scale);
+  args[0].is_double = true;
+  args[0].value.as_double = 1.5;
+  args[1].is_double = false;
+  args[1].value.as_int64 = 3;
+  EXPECT_VALID(Dart_InvokeStaticFunction(scale, 2, args, &result));
+  EXPECT(result.is_double);
+  EXPECT_EQ(4.5, result.value.as_double);
+
+  // Arguments are type checked like in Dart_Invoke.
+  args[0].is_double = false;
+  args[0].value.as_int64 = 2;
+  EXPECT_ERROR(Dart_InvokeStaticFunction(scale, 2, args, &result),
+               "is not a subtype of type 'double' of 'x'");
+
+  Dart_Handle type = Dart_GetType(lib, NewString("C"), 0, NULL);
+  EXPECT_VALID(type);
+  Dart_Handle twice = Dart_LookupStaticFunction(type, NewString("twice"));
+  EXPECT_VALID(twice);
+  EXPECT_VALID(Dart_InvokeStaticFunction(twice, 1, args + 1, &result));
+  EXPECT_EQ(6, result.value.as_int64);
+  EXPECT_ERROR(Dart_LookupStaticFunction(type, NewString("instance")),
+               "is not a static function");
+
+  // A void function can be called without a result.
+  Dart_Handle nothing = Dart_LookupStaticFunction(lib, NewString("nothing"));
+  EXPECT_VALID(Dart_InvokeStaticFunction(nothing, 0, NULL, NULL));
+  EXPECT_ERROR(Dart_InvokeStaticFunction(nothing, 0, NULL, &result),
+               "to return a number");
+
+  EXPECT_ERROR(Dart_InvokeStaticFunction(mix, 1, args, &result),
+               "static function taking 1 arguments");
+  Dart_Handle fails = Dart_LookupStaticFunction(lib, NewString("fails"));
+  EXPECT_ERROR(Dart_InvokeStaticFunction(fails, 1, args + 1, &result),
+               "failed 3");
+}
+
+TEST_CASE(DartAPI_InvokeMethod) {
+  const char* kScriptChars =
+      "class Entity {\n"
+      "  double x = 0.0;\n"
+      "  double update(double dt) => x += dt;\n"
+      "  static int count() => 0;\n"
+      "}\n"
+      "class Plain extends Entity {}\n"
+      "class Fast extends Entity {\n"
+      "  double update(double dt) => x += 2 * dt;\n"
+      "}\n"
+      "Entity makePlain() => new Plain();\n"
+      "Entity makeFast() => new Fast();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+
+  Dart_Handle type = Dart_GetType(lib, NewString("Entity"), 0, NULL);
+  EXPECT_VALID(type);
+  Dart_Handle update = Dart_LookupMethod(type, NewString("update"));
+  EXPECT_VALID(update);
+  EXPECT(Dart_IsFunction(update));
+  EXPECT_ERROR(Dart_LookupMethod(type, NewString("count")),
+               "is not an instance method");
+
+  Dart_Handle entity = Dart_New(type, Dart_Null(), 0, NULL);
+  EXPECT_VALID(entity);
+  Dart_UnboxedValue dt;
+  dt.is_double = true;
+  dt.value.as_double = 0.25;
+  Dart_UnboxedValue result;
+  for (intptr_t i = 0; i < 4; i++) {
+    EXPECT_VALID(Dart_InvokeMethod(entity, update, 1, &dt, &result));
+  }
+  EXPECT(result.is_double);
+  EXPECT_EQ(1.0, result.value.as_double);
+
+  // A subclass that inherits the method needs a lookup but still works.
+  Dart_Handle plain = Dart_Invoke(lib, NewString("makePlain"), 0, NULL);
+  EXPECT_VALID(plain);
+  EXPECT_VALID(Dart_InvokeMethod(plain, update, 1, &dt, &result));
+  EXPECT_EQ(0.25, result.value.as_double);
+
+  // An override is not called through the looked up method.
+  Dart_Handle fast = Dart_Invoke(lib, NewString("makeFast"), 0, NULL);
+  EXPECT_VALID(fast);
+  EXPECT_ERROR(Dart_InvokeMethod(fast, update, 1, &dt, &result),
+               "does not dispatch to 'update'");
+
+  EXPECT_ERROR(Dart_InvokeMethod(entity, update, 0, NULL, &result),
+               "instance method taking 0 arguments");
+
+  // Arguments are type checked like in Dart_Invoke.
+  dt.is_double = false;
+  dt.value.as_int64 = 1;
+  EXPECT_ERROR(Dart_InvokeMethod(entity, update, 1, &dt, &result),
+               "is not a subtype of type 'double' of 'dt'");
+}
+
 void ExceptionNative(Dart_NativeArguments args) {
   Dart_EnterScope();
   Dart_ThrowException(NewString("Hello from ExceptionNative!"));
@@ -6473,6 +6723,158 @@ TEST_CASE(DartAPI_NativePortReceiveInteger) {
   EXPECT(Dart_CloseNativePort(port_id1));
 }
 
+static void NewNativePort_ignoreMessage(Dart_Port dest_port_id,
+                                        Dart_CObject* message) {}
+
+TEST_CASE(DartAPI_PostCObjectBatch) {
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "var received = [];\n"
+      "SendPort makePort(int expected) {\n"
+      "  var receivePort = new RawReceivePort();\n"
+      "  receivePort.handler = (message) {\n"
+      "    received.add(message);\n"
+      "    if (received.length == expected) receivePort.close();\n"
+      "  };\n"
+      "  return receivePort.sendPort;\n"
+      "}\n"
+      "getReceived() => received.toString();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_EnterScope();
+  Dart_Handle dart_args[1];
+  dart_args[0] = Dart_NewInteger(4);
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("makePort"), 1, dart_args);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id = ILLEGAL_PORT;
+  EXPECT_VALID(Dart_SendPortGetId(send_port, &port_id));
+
+  Dart_CObject values[6];
+  Dart_CObject* messages[6];
+  for (intptr_t i = 0; i < 6; i++) {
+    values[i].type = Dart_CObject_kInt32;
+    values[i].value.as_int32 = i + 1;
+    messages[i] = &values[i];
+  }
+  EXPECT_EQ(3, Dart_PostCObjectBatch(port_id, 3, messages));
+
+  // A message that cannot be serialized keeps it and the messages after it
+  // from being posted, and the caller learns how many were.
+  values[4].type = Dart_CObject_kString;
+  values[4].value.as_string = const_cast<char*>("\xff");
+  EXPECT_EQ(1, Dart_PostCObjectBatch(port_id, 3, &messages[3]));
+
+  EXPECT_VALID(Dart_RunLoop());
+  Dart_Handle received = Dart_Invoke(lib, NewString("getReceived"), 0, NULL);
+  EXPECT_VALID(received);
+  const char* received_chars = NULL;
+  EXPECT_VALID(Dart_StringToCString(received, &received_chars));
+  EXPECT_STREQ("[1, 2, 3, 4]", received_chars);
+  Dart_ExitScope();
+
+  // Nothing is posted to a closed port.
+  Dart_Port closed_port =
+      Dart_NewNativePort("Closed", NewNativePort_ignoreMessage, false);
+  EXPECT(closed_port != ILLEGAL_PORT);
+  EXPECT(Dart_CloseNativePort(closed_port));
+  EXPECT_EQ(0, Dart_PostCObjectBatch(closed_port, 3, messages));
+}
+
+static void TransferredTypedDataFinalizer(void* isolate_callback_data,
+                                          Dart_WeakPersistentHandle handle,
+                                          void* peer) {
+  (*static_cast<intptr_t*>(peer))++;
+}
+
+TEST_CASE(DartAPI_PostTransferExternalTypedData) {
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "var received;\n"
+      "SendPort makePort() {\n"
+      "  var receivePort = new RawReceivePort();\n"
+      "  receivePort.handler = (message) {\n"
+      "    received = message;\n"
+      "    receivePort.close();\n"
+      "  };\n"
+      "  return receivePort.sendPort;\n"
+      "}\n"
+      "getReceived() => received;\n";
+  static uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  static intptr_t finalized = 0;
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_EnterScope();
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("makePort"), 0, NULL);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id = ILLEGAL_PORT;
+  EXPECT_VALID(Dart_SendPortGetId(send_port, &port_id));
+
+  Dart_Handle sent = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, data, ARRAY_SIZE(data), &finalized, sizeof(data),
+      TransferredTypedDataFinalizer);
+  EXPECT_VALID(sent);
+  EXPECT(Dart_PostTransfer(port_id, sent));
+
+  // The sender keeps its length, but not its data.
+  Dart_TypedData_Type type;
+  void* sent_data = NULL;
+  intptr_t sent_length = 0;
+  EXPECT_VALID(Dart_TypedDataAcquireData(sent, &type, &sent_data,
+                                         &sent_length));
+  EXPECT_EQ(static_cast<intptr_t>(ARRAY_SIZE(data)), sent_length);
+  EXPECT(sent_data != data);
+  for (intptr_t i = 0; i < sent_length; i++) {
+    EXPECT_EQ(0, static_cast<uint8_t*>(sent_data)[i]);
+  }
+  EXPECT_VALID(Dart_TypedDataReleaseData(sent));
+
+  EXPECT_VALID(Dart_RunLoop());
+
+  // The receiver refers to the sender's original data.
+  Dart_Handle received = Dart_Invoke(lib, NewString("getReceived"), 0, NULL);
+  EXPECT_VALID(received);
+  void* received_data = NULL;
+  intptr_t received_length = 0;
+  EXPECT_VALID(Dart_TypedDataAcquireData(received, &type, &received_data,
+                                         &received_length));
+  EXPECT_EQ(Dart_TypedData_kUint8, type);
+  EXPECT_EQ(static_cast<intptr_t>(ARRAY_SIZE(data)), received_length);
+  EXPECT(received_data == data);
+  EXPECT_VALID(Dart_TypedDataReleaseData(received));
+  EXPECT_EQ(0, finalized);
+
+  Dart_ExitScope();
+}
+
+TEST_CASE(DartAPI_PostTransferToClosedPort) {
+  static uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  static intptr_t finalized = 0;
+  Dart_Port port_id =
+      Dart_NewNativePort("Closed", NewNativePort_ignoreMessage, false);
+  EXPECT(port_id != ILLEGAL_PORT);
+  EXPECT(Dart_CloseNativePort(port_id));
+
+  Dart_EnterScope();
+  Dart_Handle sent = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, data, ARRAY_SIZE(data), &finalized, sizeof(data),
+      TransferredTypedDataFinalizer);
+  EXPECT_VALID(sent);
+  Dart_Handle list = Dart_NewList(2);
+  EXPECT_VALID(Dart_ListSetAt(list, 0, sent));
+  EXPECT_VALID(Dart_ListSetAt(list, 1, sent));
+  EXPECT(!Dart_PostTransfer(port_id, list));
+
+  // Nothing was transferred: the sender still owns its data and finalizer.
+  Dart_TypedData_Type type;
+  void* sent_data = NULL;
+  intptr_t sent_length = 0;
+  EXPECT_VALID(Dart_TypedDataAcquireData(sent, &type, &sent_data,
+                                         &sent_length));
+  EXPECT(sent_data == data);
+  EXPECT_EQ(1, static_cast<uint8_t*>(sent_data)[0]);
+  EXPECT_VALID(Dart_TypedDataReleaseData(sent));
+  EXPECT_EQ(0, finalized);
+  Dart_ExitScope();
+}
+
 static Dart_Isolate RunLoopTestCallback(const char* script_name,
                                         const char* main,
                                         const char* package_root,
@@ -7213,6 +7615,7 @@ TEST_CASE(DartAPI_CopyNewSpacePeers) {
 // the peer to old space.  Removes the peer and check that the count
 // of peer objects is decremented by one.
 TEST_CASE(DartAPI_OnePromotedPeer) {
+  SetFlagScope<int> sfs(&FLAG_survivor_aging_threshold, 0);
   Isolate* isolate = Isolate::Current();
   Dart_Handle str = NewString("a string");
   EXPECT_VALID(str);
@@ -8219,4 +8622,135 @@ TEST_CASE(DartAPI_InvokeImportedFunction) {
 
 #endif  // !PRODUCT
 
+TEST_CASE(DartAPI_SaveTypeFeedback) {
+  const char* kScriptChars =
+      "class A { int f() => 1; }\n"
+      "class B extends A { int f() => 2; }\n"
+      "int dispatch(A a) => a.f();\n"
+      "main() {\n"
+      "  var a = new A(), b = new B();\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < 3; i++) sum += dispatch(a) + dispatch(b);\n"
+      "  return sum;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = 0;
+  result = Dart_SaveTypeFeedback(&buffer, &buffer_length);
+  EXPECT_VALID(result);
+  const char* feedback = OS::SCreate(
+      Thread::Current()->zone(), "%.*s", static_cast<int>(buffer_length),
+      reinterpret_cast<char*>(buffer));
+  // The receivers of a.f() and their counts.
+  EXPECT_SUBSTRING(",::,dispatch\n", feedback);
+  EXPECT_SUBSTRING(",f,6,", feedback);
+  EXPECT_SUBSTRING(",A,3", feedback);
+  EXPECT_SUBSTRING(",B,3", feedback);
+
+  // Load the feedback back, as the precompiler does.
+  TransitionNativeToVM transition(thread);
+  TypeFeedbackLoader* loader = new TypeFeedbackLoader(thread);
+  const Object& error =
+      Object::Handle(loader->LoadFeedback(buffer, buffer_length));
+  EXPECT(error.IsNull());
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const Function& dispatch = Function::Handle(
+      library.LookupLocalFunction(String::Handle(String::New("dispatch"))));
+  EXPECT(!dispatch.IsNull());
+  const FunctionTypeFeedback* dispatch_feedback =
+      loader->FeedbackFor(dispatch);
+  EXPECT(dispatch_feedback != NULL);
+  const FunctionTypeFeedback::Call* call = NULL;
+  for (intptr_t i = 0; i < dispatch_feedback->calls.length(); i++) {
+    if (dispatch_feedback->calls[i]->selector.Equals("f")) {
+      call = dispatch_feedback->calls[i];
+    }
+  }
+  EXPECT(call != NULL);
+  EXPECT_EQ(6, call->count);
+  EXPECT_EQ(2, call->receivers.length());
+  const Class& cls_a = Class::Handle(
+      library.LookupLocalClass(String::Handle(String::New("A"))));
+  const Class& cls_b = Class::Handle(
+      library.LookupLocalClass(String::Handle(String::New("B"))));
+  for (intptr_t i = 0; i < call->receivers.length(); i++) {
+    EXPECT((call->receivers[i].cid == cls_a.id()) ||
+           (call->receivers[i].cid == cls_b.id()));
+    EXPECT_EQ(3, call->receivers[i].count);
+  }
+
+  // Malformed lines are reported, unknown functions are skipped.
+  char malformed[] = "F,dart:core,Object\n";
+  EXPECT(Object::Handle(loader->LoadFeedback(
+                            reinterpret_cast<uint8_t*>(malformed),
+                            strlen(malformed)))
+             .IsError());
+  char unknown[] = "F,file:///unknown.dart,::,f\nI,1,f,1\n";
+  EXPECT(Object::Handle(loader->LoadFeedback(
+                            reinterpret_cast<uint8_t*>(unknown),
+                            strlen(unknown)))
+             .IsNull());
+}
+
+TEST_CASE(DartAPI_SaveStartupTrace) {
+  const char* kScriptChars =
+      "int second() => 2;\n"
+      "int first() => 1;\n"
+      "main() => first() + second();\n";
+  SetFlagScope<int> sfs(&FLAG_startup_trace_duration, 1000000);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = 0;
+  result = Dart_SaveStartupTrace(&buffer, &buffer_length);
+  EXPECT_VALID(result);
+  const char* trace = OS::SCreate(
+      Thread::Current()->zone(), "%.*s", static_cast<int>(buffer_length),
+      reinterpret_cast<char*>(buffer));
+  // The functions are in the order in which they were first called.
+  const char* main_line = strstr(trace, ",::,main,");
+  const char* first_line = strstr(trace, ",::,first,");
+  const char* second_line = strstr(trace, ",::,second,");
+  EXPECT(main_line != NULL);
+  EXPECT(main_line < first_line);
+  EXPECT(first_line < second_line);
+}
+
+TEST_CASE(DartAPI_IsolateGetStats) {
+  const char* kScriptChars =
+      "var keep;\n"
+      "main() {\n"
+      "  for (int i = 0; i < 10000; i++) {\n"
+      "    keep = new List(100);\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_IsolateStats before;
+  Dart_IsolateGetStats(Dart_CurrentIsolate(), &before);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    Isolate::Current()->heap()->CollectGarbage(Heap::kNew);
+  }
+  Dart_IsolateStats after;
+  Dart_IsolateGetStats(Dart_CurrentIsolate(), &after);
+  // The loop allocates about 10000 arrays of 100 elements.
+  EXPECT_LE(before.new_allocated_bytes + 10000 * 100 * kWordSize,
+            after.new_allocated_bytes);
+  EXPECT_LE(before.old_allocated_bytes, after.old_allocated_bytes);
+  EXPECT_LT(before.gc_count, after.gc_count);
+  EXPECT_LE(before.gc_time_micros, after.gc_time_micros);
+  EXPECT_LE(before.cpu_time_micros, after.cpu_time_micros);
+}
+
 }  // namespace dart
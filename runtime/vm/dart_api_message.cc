@@ -1236,4 +1236,37 @@ Message* ApiMessageWriter::WriteCMessage(Dart_CObject* object,
                      priority);
 }
 
+Message* ApiMessageWriter::WriteCArrayMessage(Dart_CObject* elements,
+                                              intptr_t length,
+                                              Dart_Port dest_port,
+                                              Message::Priority priority) {
+  if (length < 0 || length > Array::kMaxElements) {
+    return NULL;
+  }
+  // Same layout as WriteCObject produces for an array, without a
+  // Dart_CObject for the array itself to mark.
+  WriteInlinedObjectHeader(kMaxPredefinedObjectIds + object_id_);
+  object_id_++;
+  WriteIndexedObject(kArrayCid);
+  WriteTags(0);
+  WriteSmi(length);
+  WriteNullObject();
+  for (intptr_t i = 0; i < length; i++) {
+    Dart_CObject* element = &elements[i];
+    bool success = (element->type != Dart_CObject_kArray) &&
+                   WriteCObjectInlined(element, element->type);
+    // Elements are not shared, so their marks are never needed.
+    UnmarkAllCObjects(element);
+    if (!success) {
+      free(buffer());
+      return NULL;
+    }
+  }
+
+  MessageFinalizableData* finalizable_data = finalizable_data_;
+  finalizable_data_ = NULL;
+  return new Message(dest_port, buffer(), BytesWritten(), finalizable_data,
+                     priority);
+}
+
 }  // namespace dart
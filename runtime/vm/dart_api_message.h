@@ -163,6 +163,14 @@ class ApiMessageWriter : public BaseWriter {
                          Dart_Port dest_port,
                          Message::Priority priority);
 
+  // Writes a message with an array of length objects, taken from a
+  // contiguous buffer rather than a Dart_CObject tree. The objects cannot be
+  // arrays themselves.
+  Message* WriteCArrayMessage(Dart_CObject* elements,
+                              intptr_t length,
+                              Dart_Port dest_port,
+                              Message::Priority priority);
+
  private:
   static const intptr_t kDartCObjectTypeBits = 4;
   static const intptr_t kDartCObjectTypeMask = (1 << kDartCObjectTypeBits) - 1;
@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/dart.h"
 #include "vm/heap/heap.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
@@ -16,4 +17,84 @@ namespace dart {
 
 intptr_t ApiNativeScope::current_memory_usage_ = 0;
 
+class FinalizationQueue::FinalizerTask : public ThreadPool::Task {
+ public:
+  explicit FinalizerTask(FinalizationQueue* queue) : queue_(queue) {}
+
+  virtual void Run() {
+    // The callbacks must not call into the VM, so this thread does not enter
+    // the isolate.
+    while (queue_->RunPending()) {
+    }
+    MonitorLocker ml(&queue_->monitor_);
+    // Callbacks queued after the last RunPending are left to the next
+    // Schedule or Drain.
+    queue_->running_ = false;
+    ml.NotifyAll();
+  }
+
+ private:
+  FinalizationQueue* queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(FinalizerTask);
+};
+
+void FinalizationQueue::Enqueue(Dart_WeakPersistentHandleFinalizer callback,
+                                void* isolate_callback_data,
+                                Dart_WeakPersistentHandle handle,
+                                void* peer) {
+  Entry entry;
+  entry.callback = callback;
+  entry.isolate_callback_data = isolate_callback_data;
+  entry.handle = handle;
+  entry.peer = peer;
+  MonitorLocker ml(&monitor_);
+  entries_.Add(entry);
+}
+
+void FinalizationQueue::Schedule() {
+  {
+    MonitorLocker ml(&monitor_);
+    if (running_ || entries_.is_empty()) {
+      return;
+    }
+    running_ = true;
+  }
+  if (!Dart::thread_pool()->Run(new FinalizerTask(this))) {
+    // The thread pool is shutting down; the callbacks run on Drain.
+    MonitorLocker ml(&monitor_);
+    running_ = false;
+  }
+}
+
+void FinalizationQueue::Drain() {
+  {
+    MonitorLocker ml(&monitor_);
+    while (running_) {
+      ml.Wait();
+    }
+  }
+  while (RunPending()) {
+  }
+}
+
+bool FinalizationQueue::RunPending() {
+  MallocGrowableArray<Entry> entries;
+  {
+    MonitorLocker ml(&monitor_);
+    if (entries_.is_empty()) {
+      return false;
+    }
+    for (intptr_t i = 0; i < entries_.length(); i++) {
+      entries.Add(entries_[i]);
+    }
+    entries_.Clear();
+  }
+  for (intptr_t i = 0; i < entries.length(); i++) {
+    const Entry& entry = entries[i];
+    (*entry.callback)(entry.isolate_callback_data, entry.handle, entry.peer);
+  }
+  return true;
+}
+
 }  // namespace dart
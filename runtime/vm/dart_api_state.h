@@ -243,13 +243,22 @@ class FinalizablePersistentHandle {
     set_external_size(0);
   }
 
+  // Replaces the peer and the finalizer, e.g. after the old peer was handed
+  // over to another isolate along with the referent's external data.
+  void ReplacePeer(void* peer, Dart_WeakPersistentHandleFinalizer callback) {
+    ASSERT(callback != NULL);
+    set_peer(peer);
+    set_callback(callback);
+  }
+
   static FinalizablePersistentHandle* Cast(Dart_WeakPersistentHandle handle);
 
  private:
   enum {
     kExternalNewSpaceBit = 0,
-    kExternalSizeBits = 1,
-    kExternalSizeBitsSize = (kBitsPerWord - 1),
+    kNewSpaceListBit = 1,
+    kExternalSizeBits = 2,
+    kExternalSizeBitsSize = (kBitsPerWord - 2),
   };
 
   // This part of external_data_ is the number of externally allocated bytes.
@@ -261,6 +270,11 @@ class FinalizablePersistentHandle {
   // space and UpdateRelocated has not yet detected any promotion.
   class ExternalNewSpaceBit
       : public BitField<uword, bool, kExternalNewSpaceBit, 1> {};
+  // This bit of external_data_ is true if the handle is in the new space
+  // handle list of FinalizablePersistentHandles. It survives FreeHandle, as
+  // the list may still refer to the handle.
+  class NewSpaceListBit : public BitField<uword, bool, kNewSpaceListBit, 1> {
+  };
 
   friend class FinalizablePersistentHandles;
 
@@ -280,7 +294,9 @@ class FinalizablePersistentHandle {
     ASSERT(!raw_->IsHeapObject());
   }
   void FreeHandle(FinalizablePersistentHandle* free_list) {
+    const bool in_new_space_list = IsInNewSpaceList();
     Clear();
+    SetInNewSpaceList(in_new_space_list);
     SetNext(free_list);
   }
 
@@ -320,6 +336,14 @@ class FinalizablePersistentHandle {
     external_data_ = ExternalNewSpaceBit::update(false, external_data_);
   }
 
+  bool IsInNewSpaceList() const {
+    return NewSpaceListBit::decode(external_data_);
+  }
+
+  void SetInNewSpaceList(bool value) {
+    external_data_ = NewSpaceListBit::update(value, external_data_);
+  }
+
   // Returns the space to charge for the external size.
   Heap::Space SpaceForExternal() const {
     // Non-heap and VM-heap objects count as old space here.
@@ -494,7 +518,8 @@ class FinalizablePersistentHandles
       : Handles<kFinalizablePersistentHandleSizeInWords,
                 kFinalizablePersistentHandlesPerChunk,
                 kOffsetOfRawPtrInFinalizablePersistentHandle>(),
-        free_list_(NULL) {}
+        free_list_(NULL),
+        new_space_handles_() {}
   ~FinalizablePersistentHandles() { free_list_ = NULL; }
 
   // Accessors.
@@ -516,6 +541,40 @@ class FinalizablePersistentHandles
         VisitObjectPointers(visitor);
   }
 
+  // Records handle if its referent is in new space. Scavenges only visit
+  // handles recorded here, which saves scanning the (usually far more
+  // numerous) handles to old objects. Must be called whenever a handle is
+  // made to refer to a new-space object.
+  void AddNewSpaceHandle(FinalizablePersistentHandle* handle) {
+    if (IsNewSpaceHandle(handle) && !handle->IsInNewSpaceList()) {
+      handle->SetInNewSpaceList(true);
+      new_space_handles_.Add(handle);
+    }
+  }
+
+  // Visits the handles that may refer to new space, then drops the ones that
+  // no longer do: freed handles and those whose referent was promoted.
+  void VisitNewSpaceHandles(HandleVisitor* visitor) {
+    const intptr_t length = new_space_handles_.length();
+    intptr_t survivors = 0;
+    for (intptr_t i = 0; i < length; i++) {
+      FinalizablePersistentHandle* handle = new_space_handles_[i];
+      if (IsNewSpaceHandle(handle)) {
+        visitor->VisitHandle(reinterpret_cast<uword>(handle));
+      }
+      if (IsNewSpaceHandle(handle)) {
+        new_space_handles_[survivors++] = handle;
+      } else {
+        handle->SetInNewSpaceList(false);
+      }
+    }
+    // Keep any handles the visitor added.
+    for (intptr_t i = length; i < new_space_handles_.length(); i++) {
+      new_space_handles_[survivors++] = new_space_handles_[i];
+    }
+    new_space_handles_.SetLength(survivors);
+  }
+
   // Allocates a persistent handle, these have to be destroyed explicitly
   // by calling FreeHandle.
   FinalizablePersistentHandle* AllocateHandle() {
@@ -558,7 +617,13 @@ class FinalizablePersistentHandles
   int CountHandles() const { return CountScopedHandles(); }
 
  private:
+  static bool IsNewSpaceHandle(FinalizablePersistentHandle* handle) {
+    RawObject* raw = handle->raw();
+    return raw->IsHeapObject() && raw->IsNewObject();
+  }
+
   FinalizablePersistentHandle* free_list_;
+  MallocGrowableArray<FinalizablePersistentHandle*> new_space_handles_;
   DISALLOW_COPY_AND_ASSIGN(FinalizablePersistentHandles);
 };
 
@@ -669,6 +734,51 @@ class ApiGrowableArray : public BaseGrowableArray<T, ValueObject, Zone> {
       : BaseGrowableArray<T, ValueObject, Zone>(initial_capacity, zone) {}
 };
 
+// Finalizer callbacks of weak persistent handles whose referents died during
+// a GC. With --background_finalizers the callbacks are queued here instead of
+// being invoked in the GC pause, and run on a thread pool thread afterwards.
+class FinalizationQueue {
+ public:
+  FinalizationQueue() : monitor_(), entries_(), running_(false) {}
+  ~FinalizationQueue() {
+    ASSERT(!running_);
+    ASSERT(entries_.is_empty());
+  }
+
+  // Called during GC. The handle itself has already been freed.
+  void Enqueue(Dart_WeakPersistentHandleFinalizer callback,
+               void* isolate_callback_data,
+               Dart_WeakPersistentHandle handle,
+               void* peer);
+
+  // Starts running the queued callbacks on a background thread, unless that
+  // thread is already running. Called once a GC has finished.
+  void Schedule();
+
+  // Waits for the background thread and runs any remaining callbacks on the
+  // current thread. Called before the isolate shuts down.
+  void Drain();
+
+ private:
+  class FinalizerTask;
+
+  struct Entry {
+    Dart_WeakPersistentHandleFinalizer callback;
+    void* isolate_callback_data;
+    Dart_WeakPersistentHandle handle;
+    void* peer;
+  };
+
+  // Runs the callbacks queued so far. Returns false if the queue was empty.
+  bool RunPending();
+
+  Monitor monitor_;
+  MallocGrowableArray<Entry> entries_;
+  bool running_;
+
+  DISALLOW_COPY_AND_ASSIGN(FinalizationQueue);
+};
+
 // Implementation of the API State used in dart api for maintaining
 // local scopes, persistent handles etc. These are setup on a per isolate
 // basis and destroyed when the isolate is shutdown.
@@ -707,6 +817,8 @@ class ApiState {
     return weak_persistent_handles_;
   }
 
+  FinalizationQueue* finalization_queue() { return &finalization_queue_; }
+
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
     persistent_handles().VisitObjectPointers(visitor);
   }
@@ -715,6 +827,10 @@ class ApiState {
     weak_persistent_handles().VisitHandles(visitor);
   }
 
+  void VisitNewSpaceWeakHandles(HandleVisitor* visitor) {
+    weak_persistent_handles().VisitNewSpaceHandles(visitor);
+  }
+
   bool IsValidPersistentHandle(Dart_PersistentHandle object) const {
     return persistent_handles_.IsValidHandle(object);
   }
@@ -768,6 +884,7 @@ class ApiState {
  private:
   PersistentHandles persistent_handles_;
   FinalizablePersistentHandles weak_persistent_handles_;
+  FinalizationQueue finalization_queue_;
   WeakTable acquired_table_;
 
   // Persistent handles to important objects.
@@ -792,6 +909,7 @@ inline FinalizablePersistentHandle* FinalizablePersistentHandle::New(
   ref->set_raw(object);
   ref->set_peer(peer);
   ref->set_callback(callback);
+  state->weak_persistent_handles().AddNewSpaceHandle(ref);
   // This may trigger GC, so it must be called last.
   ref->SetExternalSize(external_size, isolate);
   return ref;
@@ -1865,16 +1865,64 @@ RawFunction* Debugger::ResolveFunction(const Library& library,
   return function.raw();
 }
 
+// Returns true if 'code' is compiled from one of 'functions' or has one of
+// them inlined. A NULL list matches all code.
+static bool CodeContainsAny(const Code& code,
+                            const GrowableObjectArray* functions) {
+  if (functions == NULL) {
+    return true;
+  }
+  const Array& inlined =
+      Array::Handle(Array::RawCast(code.inlined_id_to_function()));
+  for (intptr_t i = 0; i < functions->Length(); i++) {
+    const RawObject* target = functions->At(i);
+    if (code.function() == target) {
+      return true;
+    }
+    for (intptr_t j = 0; j < inlined.Length(); j++) {
+      if (inlined.At(j) == target) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 // Deoptimize all functions in the isolate.
-// TODO(hausner): Actually we only need to deoptimize those functions
-// that inline the function that contains the newly created breakpoint.
-// We currently don't have this info so we deoptimize all functions.
 void Debugger::DeoptimizeWorld() {
+  DeoptimizeMatching(NULL);
+}
+
+// Deoptimize only the code that runs one of 'functions', directly or
+// inlined. Compilations started later do not optimize or inline a function
+// with a breakpoint, so this is enough when breakpoints are added to them.
+void Debugger::DeoptimizeFunctionsInlining(
+    const GrowableObjectArray& functions) {
+  DeoptimizeMatching(&functions);
+}
+
+void Debugger::DeoptimizeMatching(const GrowableObjectArray* targets) {
   BackgroundCompiler::Stop(isolate_);
   if (FLAG_trace_deoptimization) {
     THR_Print("Deopt for debugger\n");
   }
-  DeoptimizeFunctionsOnStack();
+  // OSR code is not installed on its function, so it is not found below.
+  isolate_->object_store()->set_osr_code_cache(Array::Handle());
+  Code& code = Code::Handle();
+  if (targets == NULL) {
+    DeoptimizeFunctionsOnStack();
+  } else {
+    DartFrameIterator iterator(Thread::Current(),
+                               StackFrameIterator::kNoCrossThreadIteration);
+    StackFrame* frame = iterator.NextFrame();
+    while (frame != NULL) {
+      code = frame->LookupDartCode();
+      if (code.is_optimized() && CodeContainsAny(code, targets)) {
+        DeoptimizeAt(code, frame);
+      }
+      frame = iterator.NextFrame();
+    }
+  }
   // Iterate over all classes, deoptimize functions.
   // TODO(hausner): Could possibly be combined with RemoveOptimizedCode()
   const ClassTable& class_table = *isolate_->class_table();
@@ -1895,13 +1943,19 @@ void Debugger::DeoptimizeWorld() {
           function ^= functions.At(pos);
           ASSERT(!function.IsNull());
           if (function.HasOptimizedCode()) {
-            function.SwitchToUnoptimizedCode();
+            code = function.CurrentCode();
+            if (CodeContainsAny(code, targets)) {
+              function.SwitchToUnoptimizedCode();
+            }
           }
           // Also disable any optimized implicit closure functions.
           if (function.HasImplicitClosureFunction()) {
             function = function.ImplicitClosureFunction();
             if (function.HasOptimizedCode()) {
-              function.SwitchToUnoptimizedCode();
+              code = function.CurrentCode();
+              if (CodeContainsAny(code, targets)) {
+                function.SwitchToUnoptimizedCode();
+              }
             }
           }
         }
@@ -1916,7 +1970,10 @@ void Debugger::DeoptimizeWorld() {
     function ^= closures.At(pos);
     ASSERT(!function.IsNull());
     if (function.HasOptimizedCode()) {
-      function.SwitchToUnoptimizedCode();
+      code = function.CurrentCode();
+      if (CodeContainsAny(code, targets)) {
+        function.SwitchToUnoptimizedCode();
+      }
     }
   }
 }
@@ -2931,7 +2988,7 @@ BreakpointLocation* Debugger::SetBreakpoint(const Script& script,
     if (functions.Length() > 0) {
       // One or more function object containing this breakpoint location
       // have already been compiled. We can resolve the breakpoint now.
-      DeoptimizeWorld();
+      DeoptimizeFunctionsInlining(functions);
       func ^= functions.At(0);
       TokenPosition breakpoint_pos = ResolveBreakpointPos(
           func, token_pos, last_token_pos, requested_column);
@@ -662,6 +662,8 @@ class Debugger {
                                      TokenPosition last_token_pos,
                                      intptr_t requested_column);
   void DeoptimizeWorld();
+  void DeoptimizeFunctionsInlining(const GrowableObjectArray& functions);
+  void DeoptimizeMatching(const GrowableObjectArray* functions);
   BreakpointLocation* SetBreakpoint(const Script& script,
                                     TokenPosition token_pos,
                                     TokenPosition last_token_pos,
@@ -12,6 +12,7 @@
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/locations.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/json_stream.h"
 #include "vm/parser.h"
 #include "vm/stack_frame.h"
 #include "vm/thread.h"
@@ -23,6 +24,17 @@ DEFINE_FLAG(bool,
             compress_deopt_info,
             true,
             "Compress the size of the deoptimization info for optimized code.");
+DEFINE_FLAG(int,
+            deoptimization_log_size,
+            64,
+            "Number of recent deoptimizations kept per isolate for the "
+            "service protocol.");
+DEFINE_FLAG(int,
+            deoptimization_storm_threshold,
+            0,
+            "Stop optimizing a function once this many of the logged "
+            "deoptimizations are of the function for the same reason. "
+            "0 disables the check.");
 DECLARE_FLAG(bool, trace_deoptimization);
 DECLARE_FLAG(bool, trace_deoptimization_verbose);
 
@@ -47,6 +59,7 @@ DeoptContext::DeoptContext(const StackFrame* frame,
       num_args_(0),
       deopt_reason_(ICData::kDeoptUnknown),
       deopt_flags_(0),
+      deopt_id_(-1),
       thread_(Thread::Current()),
       deopt_start_micros_(0),
       deferred_slots_(NULL),
@@ -155,6 +168,35 @@ DeoptContext::~DeoptContext() {
   delete[] deferred_objects_;
   deferred_objects_ = NULL;
   deferred_objects_count_ = 0;
+  if ((FLAG_deoptimization_log_size > 0) && (deopt_start_micros_ != 0)) {
+    Isolate* isolate = thread_->isolate();
+    DeoptimizationLog* log = isolate->deoptimization_log();
+    if (log == NULL) {
+      log = new DeoptimizationLog(FLAG_deoptimization_log_size);
+      isolate->set_deoptimization_log(log);
+    }
+    const Code& code = Code::Handle(zone(), code_);
+    const Function& function = Function::Handle(zone(), code.function());
+    const intptr_t same_reason_count =
+        log->Add(function, deopt_reason(), deopt_id(), is_lazy_deopt(),
+                 deopt_start_micros_);
+    // Feedback recorded at the deopt site, such as the deopt reasons in the
+    // ICData, did not stop the function from deoptimizing in the same way
+    // again, so further optimizations are likely to fail the same way.
+    if ((FLAG_deoptimization_storm_threshold > 0) &&
+        (same_reason_count >= FLAG_deoptimization_storm_threshold) &&
+        function.is_optimizable()) {
+      if (FLAG_trace_deoptimization) {
+        THR_Print("Disabling optimization of '%s' after %" Pd
+                  " deoptimizations (reason '%s')\n",
+                  function.ToFullyQualifiedCString(), same_reason_count,
+                  DeoptReasonToCString(deopt_reason()));
+      }
+      function.SetIsOptimizable(false);
+      function.SetUsageCounter(INT_MIN);
+      log->MarkLastDisabledOptimization();
+    }
+  }
 #ifndef PRODUCT
   if (FLAG_support_timeline && (deopt_start_micros_ != 0)) {
     TimelineStream* compiler_stream = Timeline::GetCompilerStream();
@@ -172,10 +214,11 @@ DeoptContext::~DeoptContext() {
       if (timeline_event != NULL) {
         timeline_event->Duration("Deoptimize", deopt_start_micros_,
                                  OS::GetCurrentMonotonicMicros());
-        timeline_event->SetNumArguments(3);
+        timeline_event->SetNumArguments(4);
         timeline_event->CopyArgument(0, "function", function_name.ToCString());
         timeline_event->CopyArgument(1, "reason", reason);
         timeline_event->FormatArgument(2, "deoptimizationCount", "%d", counter);
+        timeline_event->FormatArgument(3, "deoptId", "%" Pd, deopt_id());
         timeline_event->Complete();
       }
     }
@@ -276,6 +319,8 @@ static bool IsObjectInstruction(DeoptInstr::Kind kind) {
   return false;
 }
 
+static intptr_t RetAddressDeoptId(DeoptInstr* instr);
+
 void DeoptContext::FillDestFrame() {
   const Code& code = Code::Handle(code_);
   const TypedData& deopt_info = TypedData::Handle(deopt_info_);
@@ -319,6 +364,10 @@ void DeoptContext::FillDestFrame() {
        to_index--, from_index--) {
     intptr_t* to_addr = GetDestFrameAddressAt(to_index);
     DeoptInstr* instr = deopt_instructions[from_index];
+    if (instr->kind() == DeoptInstr::kRetAddress) {
+      // Frames are filled from the outermost to the innermost one.
+      deopt_id_ = RetAddressDeoptId(instr);
+    }
     if (!objects_only || IsObjectInstruction(instr->kind())) {
       instr->Execute(this, to_addr);
     } else {
@@ -483,6 +532,11 @@ class DeoptRetAddressInstr : public DeoptInstr {
   DISALLOW_COPY_AND_ASSIGN(DeoptRetAddressInstr);
 };
 
+static intptr_t RetAddressDeoptId(DeoptInstr* instr) {
+  ASSERT(instr->kind() == DeoptInstr::kRetAddress);
+  return static_cast<DeoptRetAddressInstr*>(instr)->deopt_id();
+}
+
 // Deoptimization instruction moving a constant stored at 'object_table_index'.
 class DeoptConstantInstr : public DeoptInstr {
  public:
@@ -1476,6 +1530,78 @@ bool DeoptInfo::VerifyDecompression(const GrowableArray<DeoptInstr*>& original,
   return true;
 }
 
+DeoptimizationLog::DeoptimizationLog(intptr_t capacity)
+    : entries_(new Entry[capacity]),
+      capacity_(capacity),
+      length_(0),
+      cursor_(0) {
+  ASSERT(capacity > 0);
+}
+
+DeoptimizationLog::~DeoptimizationLog() {
+  for (intptr_t i = 0; i < length_; i++) {
+    free(entries_[i].function_name);
+  }
+  delete[] entries_;
+}
+
+intptr_t DeoptimizationLog::Add(const Function& function,
+                                ICData::DeoptReasonId reason,
+                                intptr_t deopt_id,
+                                bool is_lazy,
+                                int64_t timestamp_micros) {
+  const char* function_name = function.ToFullyQualifiedCString();
+  intptr_t same_reason_count = 1;
+  for (intptr_t i = 0; i < length_; i++) {
+    // Once the log is full the entry at the cursor is about to be dropped.
+    if ((length_ == capacity_) && (i == cursor_)) {
+      continue;
+    }
+    if ((entries_[i].reason == reason) &&
+        (strcmp(entries_[i].function_name, function_name) == 0)) {
+      same_reason_count++;
+    }
+  }
+  Entry* entry = &entries_[cursor_];
+  if (length_ < capacity_) {
+    length_++;
+  } else {
+    free(entry->function_name);
+  }
+  entry->function_name = strdup(function_name);
+  entry->reason = reason;
+  entry->deopt_id = deopt_id;
+  entry->deoptimization_count = function.deoptimization_counter();
+  entry->is_lazy = is_lazy;
+  entry->disabled_optimization = false;
+  entry->timestamp_micros = timestamp_micros;
+  cursor_ = (cursor_ + 1) % capacity_;
+  return same_reason_count;
+}
+
+void DeoptimizationLog::MarkLastDisabledOptimization() {
+  ASSERT(length_ > 0);
+  entries_[(cursor_ + capacity_ - 1) % capacity_].disabled_optimization = true;
+}
+
+#ifndef PRODUCT
+void DeoptimizationLog::PrintToJSONObject(JSONObject* jsobj) const {
+  JSONArray events(jsobj, "deoptimizations");
+  const intptr_t start = (length_ < capacity_) ? 0 : cursor_;
+  for (intptr_t i = 0; i < length_; i++) {
+    const Entry& entry = entries_[(start + i) % capacity_];
+    JSONObject event(&events);
+    event.AddProperty("function", entry.function_name);
+    event.AddProperty("reason", DeoptReasonToCString(entry.reason));
+    event.AddProperty("deoptId", entry.deopt_id);
+    event.AddProperty("deoptimizationCount", entry.deoptimization_count);
+    event.AddProperty("lazy", entry.is_lazy);
+    event.AddProperty("disabledOptimization", entry.disabled_optimization);
+    event.AddPropertyTimeMicros("timestamp", entry.timestamp_micros);
+  }
+}
+#endif  // !PRODUCT
+
 }  // namespace dart
 
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
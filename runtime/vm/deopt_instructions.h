@@ -22,6 +22,7 @@ namespace dart {
 class Location;
 class Value;
 class MaterializeObjectInstr;
+class JSONObject;
 class StackFrame;
 class TimelineEvent;
 
@@ -156,6 +157,11 @@ class DeoptContext {
   bool deoptimizing_code() const { return deoptimizing_code_; }
 
   ICData::DeoptReasonId deopt_reason() const { return deopt_reason_; }
+
+  // The deopt id in the innermost function of the deoptimized frame, known
+  // once FillDestFrame has run.
+  intptr_t deopt_id() const { return deopt_id_; }
+
   bool HasDeoptFlag(ICData::DeoptFlags flag) {
     return (deopt_flags_ & flag) != 0;
   }
@@ -274,6 +280,7 @@ class DeoptContext {
   intptr_t num_args_;
   ICData::DeoptReasonId deopt_reason_;
   uint32_t deopt_flags_;
+  intptr_t deopt_id_;
   intptr_t caller_fp_;
   Thread* thread_;
   int64_t deopt_start_micros_;
@@ -646,6 +653,51 @@ class DeoptInfo : public AllStatic {
                          intptr_t length);
 };
 
+// Ring buffer of the most recent deoptimizations in an isolate, reported
+// through the service protocol. Also used to find functions that keep
+// deoptimizing for the same reason, which are then no longer optimized.
+class DeoptimizationLog {
+ public:
+  explicit DeoptimizationLog(intptr_t capacity);
+  ~DeoptimizationLog();
+
+  // Returns the number of logged deoptimizations of the same function for
+  // the same reason, including this one.
+  intptr_t Add(const Function& function,
+               ICData::DeoptReasonId reason,
+               intptr_t deopt_id,
+               bool is_lazy,
+               int64_t timestamp_micros);
+
+  // Notes that the last added deoptimization disabled optimization of its
+  // function.
+  void MarkLastDisabledOptimization();
+
+#ifndef PRODUCT
+  // Adds the deoptimizations, oldest first, as the "deoptimizations"
+  // property.
+  void PrintToJSONObject(JSONObject* jsobj) const;
+#endif  // !PRODUCT
+
+ private:
+  struct Entry {
+    char* function_name;  // Malloc'ed.
+    ICData::DeoptReasonId reason;
+    intptr_t deopt_id;
+    intptr_t deoptimization_count;
+    bool is_lazy;
+    bool disabled_optimization;
+    int64_t timestamp_micros;
+  };
+
+  Entry* entries_;
+  const intptr_t capacity_;
+  intptr_t length_;
+  intptr_t cursor_;  // Index of the next entry to write.
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationLog);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_DEOPT_INSTRUCTIONS_H_
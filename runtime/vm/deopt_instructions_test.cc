@@ -0,0 +1,82 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/deopt_instructions.h"
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/json_stream.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+static RawFunction* LookupFunction(const Library& lib, const char* name) {
+  Thread* thread = Thread::Current();
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, name))));
+  EXPECT(!function.IsNull());
+  return function.raw();
+}
+
+TEST_CASE(DeoptimizationLog_SameReasonCount) {
+  const char* kScript =
+      "foo() => 1;\n"
+      "bar() => 2;\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(h_lib);
+
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Function& foo = Function::Handle(LookupFunction(lib, "foo"));
+  const Function& bar = Function::Handle(LookupFunction(lib, "bar"));
+
+  DeoptimizationLog log(3);
+  EXPECT_EQ(1, log.Add(foo, ICData::kDeoptBinarySmiOp, 1, false, 100));
+  EXPECT_EQ(2, log.Add(foo, ICData::kDeoptBinarySmiOp, 1, false, 200));
+  // Other functions and other reasons are counted separately.
+  EXPECT_EQ(1, log.Add(bar, ICData::kDeoptBinarySmiOp, 1, false, 300));
+  EXPECT_EQ(1, log.Add(foo, ICData::kDeoptCheckSmi, 2, true, 400));
+  // The oldest entry has been dropped, and the one this replaces is not
+  // counted either.
+  EXPECT_EQ(1, log.Add(foo, ICData::kDeoptBinarySmiOp, 1, false, 500));
+  log.MarkLastDisabledOptimization();
+
+#ifndef PRODUCT
+  // Entries are printed oldest first.
+  JSONStream js;
+  {
+    JSONObject jsobj(&js);
+    log.PrintToJSONObject(&jsobj);
+  }
+  const char* json = js.ToCString();
+  const char* check_smi = strstr(json, "\"reason\":\"CheckSmi\"");
+  EXPECT(check_smi != NULL);
+  const char* lazy = strstr(json, "\"lazy\":true");
+  EXPECT(lazy != NULL);
+  EXPECT(strstr(lazy + 1, "\"lazy\":true") == NULL);
+  const char* disabled = strstr(json, "\"disabledOptimization\":true");
+  EXPECT(disabled != NULL);
+  EXPECT(check_smi < disabled);
+  EXPECT(strstr(disabled + 1, "\"disabledOptimization\":true") == NULL);
+  const char* bar_entry = strstr(json, "bar");
+  EXPECT(bar_entry != NULL);
+  EXPECT(bar_entry < check_smi);
+  intptr_t entries = 0;
+  for (const char* p = strstr(json, "\"deoptId\""); p != NULL;
+       p = strstr(p + 1, "\"deoptId\"")) {
+    entries++;
+  }
+  EXPECT_EQ(3, entries);
+#endif  // !PRODUCT
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
@@ -16,7 +16,7 @@ static const char kDoubleToStringCommonExponentChar = 'e';
 static const char* kDoubleToStringCommonInfinitySymbol = "Infinity";
 static const char* kDoubleToStringCommonNaNSymbol = "NaN";
 
-void DoubleToCString(double d, char* buffer, int buffer_size) {
+intptr_t DoubleToCString(double d, char* buffer, int buffer_size) {
   static const int kDecimalLow = -6;
   static const int kDecimalHigh = 21;
 
@@ -46,8 +46,10 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   double_conversion::StringBuilder builder(buffer, buffer_size);
   bool status = converter.ToShortest(d, &builder);
   ASSERT(status);
+  const intptr_t length = builder.position();
   char* result = builder.Finalize();
   ASSERT(result == buffer);
+  return length;
 }
 
 RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
@@ -156,11 +158,423 @@ RawString* DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+// The 128-bit mantissas of 10^kMinFastExponent to 10^kMaxFastExponent,
+// normalized to have the most significant bit set and rounded down.
+static const int kMinFastExponent = -128;
+static const int kMaxFastExponent = 127;
+static const uint64_t kPowersOfTen128[][2] = {
+    {0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde},  // 1e-128
+    {0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b},  // 1e-127
+    {0xad4ab7112eb3929d, 0x86c16c98d2c953c6},  // 1e-126
+    {0xd89d64d57a607744, 0xe871c7bf077ba8b7},  // 1e-125
+    {0x87625f056c7c4a8b, 0x11471cd764ad4972},  // 1e-124
+    {0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf},  // 1e-123
+    {0xd389b47879823479, 0x4aff1d108d4ec2c3},  // 1e-122
+    {0x843610cb4bf160cb, 0xcedf722a585139ba},  // 1e-121
+    {0xa54394fe1eedb8fe, 0xc2974eb4ee658828},  // 1e-120
+    {0xce947a3da6a9273e, 0x733d226229feea32},  // 1e-119
+    {0x811ccc668829b887, 0x0806357d5a3f525f},  // 1e-118
+    {0xa163ff802a3426a8, 0xca07c2dcb0cf26f7},  // 1e-117
+    {0xc9bcff6034c13052, 0xfc89b393dd02f0b5},  // 1e-116
+    {0xfc2c3f3841f17c67, 0xbbac2078d443ace2},  // 1e-115
+    {0x9d9ba7832936edc0, 0xd54b944b84aa4c0d},  // 1e-114
+    {0xc5029163f384a931, 0x0a9e795e65d4df11},  // 1e-113
+    {0xf64335bcf065d37d, 0x4d4617b5ff4a16d5},  // 1e-112
+    {0x99ea0196163fa42e, 0x504bced1bf8e4e45},  // 1e-111
+    {0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6},  // 1e-110
+    {0xf07da27a82c37088, 0x5d767327bb4e5a4c},  // 1e-109
+    {0x964e858c91ba2655, 0x3a6a07f8d510f86f},  // 1e-108
+    {0xbbe226efb628afea, 0x890489f70a55368b},  // 1e-107
+    {0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e},  // 1e-106
+    {0x92c8ae6b464fc96f, 0x3b0b8bc90012929d},  // 1e-105
+    {0xb77ada0617e3bbcb, 0x09ce6ebb40173744},  // 1e-104
+    {0xe55990879ddcaabd, 0xcc420a6a101d0515},  // 1e-103
+    {0x8f57fa54c2a9eab6, 0x9fa946824a12232d},  // 1e-102
+    {0xb32df8e9f3546564, 0x47939822dc96abf9},  // 1e-101
+    {0xdff9772470297ebd, 0x59787e2b93bc56f7},  // 1e-100
+    {0x8bfbea76c619ef36, 0x57eb4edb3c55b65a},  // 1e-99
+    {0xaefae51477a06b03, 0xede622920b6b23f1},  // 1e-98
+    {0xdab99e59958885c4, 0xe95fab368e45eced},  // 1e-97
+    {0x88b402f7fd75539b, 0x11dbcb0218ebb414},  // 1e-96
+    {0xaae103b5fcd2a881, 0xd652bdc29f26a119},  // 1e-95
+    {0xd59944a37c0752a2, 0x4be76d3346f0495f},  // 1e-94
+    {0x857fcae62d8493a5, 0x6f70a4400c562ddb},  // 1e-93
+    {0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952},  // 1e-92
+    {0xd097ad07a71f26b2, 0x7e2000a41346a7a7},  // 1e-91
+    {0x825ecc24c873782f, 0x8ed400668c0c28c8},  // 1e-90
+    {0xa2f67f2dfa90563b, 0x728900802f0f32fa},  // 1e-89
+    {0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9},  // 1e-88
+    {0xfea126b7d78186bc, 0xe2f610c84987bfa8},  // 1e-87
+    {0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9},  // 1e-86
+    {0xc6ede63fa05d3143, 0x91503d1c79720dbb},  // 1e-85
+    {0xf8a95fcf88747d94, 0x75a44c6397ce912a},  // 1e-84
+    {0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba},  // 1e-83
+    {0xc24452da229b021b, 0xfbe85badce996168},  // 1e-82
+    {0xf2d56790ab41c2a2, 0xfae27299423fb9c3},  // 1e-81
+    {0x97c560ba6b0919a5, 0xdccd879fc967d41a},  // 1e-80
+    {0xbdb6b8e905cb600f, 0x5400e987bbc1c920},  // 1e-79
+    {0xed246723473e3813, 0x290123e9aab23b68},  // 1e-78
+    {0x9436c0760c86e30b, 0xf9a0b6720aaf6521},  // 1e-77
+    {0xb94470938fa89bce, 0xf808e40e8d5b3e69},  // 1e-76
+    {0xe7958cb87392c2c2, 0xb60b1d1230b20e04},  // 1e-75
+    {0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2},  // 1e-74
+    {0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3},  // 1e-73
+    {0xe2280b6c20dd5232, 0x25c6da63c38de1b0},  // 1e-72
+    {0x8d590723948a535f, 0x579c487e5a38ad0e},  // 1e-71
+    {0xb0af48ec79ace837, 0x2d835a9df0c6d851},  // 1e-70
+    {0xdcdb1b2798182244, 0xf8e431456cf88e65},  // 1e-69
+    {0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff},  // 1e-68
+    {0xac8b2d36eed2dac5, 0xe272467e3d222f3f},  // 1e-67
+    {0xd7adf884aa879177, 0x5b0ed81dcc6abb0f},  // 1e-66
+    {0x86ccbb52ea94baea, 0x98e947129fc2b4e9},  // 1e-65
+    {0xa87fea27a539e9a5, 0x3f2398d747b36224},  // 1e-64
+    {0xd29fe4b18e88640e, 0x8eec7f0d19a03aad},  // 1e-63
+    {0x83a3eeeef9153e89, 0x1953cf68300424ac},  // 1e-62
+    {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7},  // 1e-61
+    {0xcdb02555653131b6, 0x3792f412cb06794d},  // 1e-60
+    {0x808e17555f3ebf11, 0xe2bbd88bbee40bd0},  // 1e-59
+    {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4},  // 1e-58
+    {0xc8de047564d20a8b, 0xf245825a5a445275},  // 1e-57
+    {0xfb158592be068d2e, 0xeed6e2f0f0d56712},  // 1e-56
+    {0x9ced737bb6c4183d, 0x55464dd69685606b},  // 1e-55
+    {0xc428d05aa4751e4c, 0xaa97e14c3c26b886},  // 1e-54
+    {0xf53304714d9265df, 0xd53dd99f4b3066a8},  // 1e-53
+    {0x993fe2c6d07b7fab, 0xe546a8038efe4029},  // 1e-52
+    {0xbf8fdb78849a5f96, 0xde98520472bdd033},  // 1e-51
+    {0xef73d256a5c0f77c, 0x963e66858f6d4440},  // 1e-50
+    {0x95a8637627989aad, 0xdde7001379a44aa8},  // 1e-49
+    {0xbb127c53b17ec159, 0x5560c018580d5d52},  // 1e-48
+    {0xe9d71b689dde71af, 0xaab8f01e6e10b4a6},  // 1e-47
+    {0x9226712162ab070d, 0xcab3961304ca70e8},  // 1e-46
+    {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22},  // 1e-45
+    {0xe45c10c42a2b3b05, 0x8cb89a7db77c506a},  // 1e-44
+    {0x8eb98a7a9a5b04e3, 0x77f3608e92adb242},  // 1e-43
+    {0xb267ed1940f1c61c, 0x55f038b237591ed3},  // 1e-42
+    {0xdf01e85f912e37a3, 0x6b6c46dec52f6688},  // 1e-41
+    {0x8b61313bbabce2c6, 0x2323ac4b3b3da015},  // 1e-40
+    {0xae397d8aa96c1b77, 0xabec975e0a0d081a},  // 1e-39
+    {0xd9c7dced53c72255, 0x96e7bd358c904a21},  // 1e-38
+    {0x881cea14545c7575, 0x7e50d64177da2e54},  // 1e-37
+    {0xaa242499697392d2, 0xdde50bd1d5d0b9e9},  // 1e-36
+    {0xd4ad2dbfc3d07787, 0x955e4ec64b44e864},  // 1e-35
+    {0x84ec3c97da624ab4, 0xbd5af13bef0b113e},  // 1e-34
+    {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e},  // 1e-33
+    {0xcfb11ead453994ba, 0x67de18eda5814af2},  // 1e-32
+    {0x81ceb32c4b43fcf4, 0x80eacf948770ced7},  // 1e-31
+    {0xa2425ff75e14fc31, 0xa1258379a94d028d},  // 1e-30
+    {0xcad2f7f5359a3b3e, 0x096ee45813a04330},  // 1e-29
+    {0xfd87b5f28300ca0d, 0x8bca9d6e188853fc},  // 1e-28
+    {0x9e74d1b791e07e48, 0x775ea264cf55347d},  // 1e-27
+    {0xc612062576589dda, 0x95364afe032a819d},  // 1e-26
+    {0xf79687aed3eec551, 0x3a83ddbd83f52204},  // 1e-25
+    {0x9abe14cd44753b52, 0xc4926a9672793542},  // 1e-24
+    {0xc16d9a0095928a27, 0x75b7053c0f178293},  // 1e-23
+    {0xf1c90080baf72cb1, 0x5324c68b12dd6338},  // 1e-22
+    {0x971da05074da7bee, 0xd3f6fc16ebca5e03},  // 1e-21
+    {0xbce5086492111aea, 0x88f4bb1ca6bcf584},  // 1e-20
+    {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e5},  // 1e-19
+    {0x9392ee8e921d5d07, 0x3aff322e62439fcf},  // 1e-18
+    {0xb877aa3236a4b449, 0x09befeb9fad487c2},  // 1e-17
+    {0xe69594bec44de15b, 0x4c2ebe687989a9b3},  // 1e-16
+    {0x901d7cf73ab0acd9, 0x0f9d37014bf60a10},  // 1e-15
+    {0xb424dc35095cd80f, 0x538484c19ef38c94},  // 1e-14
+    {0xe12e13424bb40e13, 0x2865a5f206b06fb9},  // 1e-13
+    {0x8cbccc096f5088cb, 0xf93f87b7442e45d3},  // 1e-12
+    {0xafebff0bcb24aafe, 0xf78f69a51539d748},  // 1e-11
+    {0xdbe6fecebdedd5be, 0xb573440e5a884d1b},  // 1e-10
+    {0x89705f4136b4a597, 0x31680a88f8953030},  // 1e-9
+    {0xabcc77118461cefc, 0xfdc20d2b36ba7c3d},  // 1e-8
+    {0xd6bf94d5e57a42bc, 0x3d32907604691b4c},  // 1e-7
+    {0x8637bd05af6c69b5, 0xa63f9a49c2c1b10f},  // 1e-6
+    {0xa7c5ac471b478423, 0x0fcf80dc33721d53},  // 1e-5
+    {0xd1b71758e219652b, 0xd3c36113404ea4a8},  // 1e-4
+    {0x83126e978d4fdf3b, 0x645a1cac083126e9},  // 1e-3
+    {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a3},  // 1e-2
+    {0xcccccccccccccccc, 0xcccccccccccccccc},  // 1e-1
+    {0x8000000000000000, 0x0000000000000000},  // 1e0
+    {0xa000000000000000, 0x0000000000000000},  // 1e1
+    {0xc800000000000000, 0x0000000000000000},  // 1e2
+    {0xfa00000000000000, 0x0000000000000000},  // 1e3
+    {0x9c40000000000000, 0x0000000000000000},  // 1e4
+    {0xc350000000000000, 0x0000000000000000},  // 1e5
+    {0xf424000000000000, 0x0000000000000000},  // 1e6
+    {0x9896800000000000, 0x0000000000000000},  // 1e7
+    {0xbebc200000000000, 0x0000000000000000},  // 1e8
+    {0xee6b280000000000, 0x0000000000000000},  // 1e9
+    {0x9502f90000000000, 0x0000000000000000},  // 1e10
+    {0xba43b74000000000, 0x0000000000000000},  // 1e11
+    {0xe8d4a51000000000, 0x0000000000000000},  // 1e12
+    {0x9184e72a00000000, 0x0000000000000000},  // 1e13
+    {0xb5e620f480000000, 0x0000000000000000},  // 1e14
+    {0xe35fa931a0000000, 0x0000000000000000},  // 1e15
+    {0x8e1bc9bf04000000, 0x0000000000000000},  // 1e16
+    {0xb1a2bc2ec5000000, 0x0000000000000000},  // 1e17
+    {0xde0b6b3a76400000, 0x0000000000000000},  // 1e18
+    {0x8ac7230489e80000, 0x0000000000000000},  // 1e19
+    {0xad78ebc5ac620000, 0x0000000000000000},  // 1e20
+    {0xd8d726b7177a8000, 0x0000000000000000},  // 1e21
+    {0x878678326eac9000, 0x0000000000000000},  // 1e22
+    {0xa968163f0a57b400, 0x0000000000000000},  // 1e23
+    {0xd3c21bcecceda100, 0x0000000000000000},  // 1e24
+    {0x84595161401484a0, 0x0000000000000000},  // 1e25
+    {0xa56fa5b99019a5c8, 0x0000000000000000},  // 1e26
+    {0xcecb8f27f4200f3a, 0x0000000000000000},  // 1e27
+    {0x813f3978f8940984, 0x4000000000000000},  // 1e28
+    {0xa18f07d736b90be5, 0x5000000000000000},  // 1e29
+    {0xc9f2c9cd04674ede, 0xa400000000000000},  // 1e30
+    {0xfc6f7c4045812296, 0x4d00000000000000},  // 1e31
+    {0x9dc5ada82b70b59d, 0xf020000000000000},  // 1e32
+    {0xc5371912364ce305, 0x6c28000000000000},  // 1e33
+    {0xf684df56c3e01bc6, 0xc732000000000000},  // 1e34
+    {0x9a130b963a6c115c, 0x3c7f400000000000},  // 1e35
+    {0xc097ce7bc90715b3, 0x4b9f100000000000},  // 1e36
+    {0xf0bdc21abb48db20, 0x1e86d40000000000},  // 1e37
+    {0x96769950b50d88f4, 0x1314448000000000},  // 1e38
+    {0xbc143fa4e250eb31, 0x17d955a000000000},  // 1e39
+    {0xeb194f8e1ae525fd, 0x5dcfab0800000000},  // 1e40
+    {0x92efd1b8d0cf37be, 0x5aa1cae500000000},  // 1e41
+    {0xb7abc627050305ad, 0xf14a3d9e40000000},  // 1e42
+    {0xe596b7b0c643c719, 0x6d9ccd05d0000000},  // 1e43
+    {0x8f7e32ce7bea5c6f, 0xe4820023a2000000},  // 1e44
+    {0xb35dbf821ae4f38b, 0xdda2802c8a800000},  // 1e45
+    {0xe0352f62a19e306e, 0xd50b2037ad200000},  // 1e46
+    {0x8c213d9da502de45, 0x4526f422cc340000},  // 1e47
+    {0xaf298d050e4395d6, 0x9670b12b7f410000},  // 1e48
+    {0xdaf3f04651d47b4c, 0x3c0cdd765f114000},  // 1e49
+    {0x88d8762bf324cd0f, 0xa5880a69fb6ac800},  // 1e50
+    {0xab0e93b6efee0053, 0x8eea0d047a457a00},  // 1e51
+    {0xd5d238a4abe98068, 0x72a4904598d6d880},  // 1e52
+    {0x85a36366eb71f041, 0x47a6da2b7f864750},  // 1e53
+    {0xa70c3c40a64e6c51, 0x999090b65f67d924},  // 1e54
+    {0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},  // 1e55
+    {0x82818f1281ed449f, 0xbff8f10e7a8921a4},  // 1e56
+    {0xa321f2d7226895c7, 0xaff72d52192b6a0d},  // 1e57
+    {0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490},  // 1e58
+    {0xfee50b7025c36a08, 0x02f236d04753d5b4},  // 1e59
+    {0x9f4f2726179a2245, 0x01d762422c946590},  // 1e60
+    {0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5},  // 1e61
+    {0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2},  // 1e62
+    {0x9b934c3b330c8577, 0x63cc55f49f88eb2f},  // 1e63
+    {0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb},  // 1e64
+    {0xf316271c7fc3908a, 0x8bef464e3945ef7a},  // 1e65
+    {0x97edd871cfda3a56, 0x97758bf0e3cbb5ac},  // 1e66
+    {0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317},  // 1e67
+    {0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd},  // 1e68
+    {0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a},  // 1e69
+    {0xb975d6b6ee39e436, 0xb3e2fd538e122b44},  // 1e70
+    {0xe7d34c64a9c85d44, 0x60dbbca87196b616},  // 1e71
+    {0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd},  // 1e72
+    {0xb51d13aea4a488dd, 0x6babab6398bdbe41},  // 1e73
+    {0xe264589a4dcdab14, 0xc696963c7eed2dd1},  // 1e74
+    {0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2},  // 1e75
+    {0xb0de65388cc8ada8, 0x3b25a55f43294bcb},  // 1e76
+    {0xdd15fe86affad912, 0x49ef0eb713f39ebe},  // 1e77
+    {0x8a2dbf142dfcc7ab, 0x6e3569326c784337},  // 1e78
+    {0xacb92ed9397bf996, 0x49c2c37f07965404},  // 1e79
+    {0xd7e77a8f87daf7fb, 0xdc33745ec97be906},  // 1e80
+    {0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3},  // 1e81
+    {0xa8acd7c0222311bc, 0xc40832ea0d68ce0c},  // 1e82
+    {0xd2d80db02aabd62b, 0xf50a3fa490c30190},  // 1e83
+    {0x83c7088e1aab65db, 0x792667c6da79e0fa},  // 1e84
+    {0xa4b8cab1a1563f52, 0x577001b891185938},  // 1e85
+    {0xcde6fd5e09abcf26, 0xed4c0226b55e6f86},  // 1e86
+    {0x80b05e5ac60b6178, 0x544f8158315b05b4},  // 1e87
+    {0xa0dc75f1778e39d6, 0x696361ae3db1c721},  // 1e88
+    {0xc913936dd571c84c, 0x03bc3a19cd1e38e9},  // 1e89
+    {0xfb5878494ace3a5f, 0x04ab48a04065c723},  // 1e90
+    {0x9d174b2dcec0e47b, 0x62eb0d64283f9c76},  // 1e91
+    {0xc45d1df942711d9a, 0x3ba5d0bd324f8394},  // 1e92
+    {0xf5746577930d6500, 0xca8f44ec7ee36479},  // 1e93
+    {0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb},  // 1e94
+    {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e},  // 1e95
+    {0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e},  // 1e96
+    {0x95d04aee3b80ece5, 0xbba1f1d158724a12},  // 1e97
+    {0xbb445da9ca61281f, 0x2a8a6e45ae8edc97},  // 1e98
+    {0xea1575143cf97226, 0xf52d09d71a3293bd},  // 1e99
+    {0x924d692ca61be758, 0x593c2626705f9c56},  // 1e100
+    {0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c},  // 1e101
+    {0xe498f455c38b997a, 0x0b6dfb9c0f956447},  // 1e102
+    {0x8edf98b59a373fec, 0x4724bd4189bd5eac},  // 1e103
+    {0xb2977ee300c50fe7, 0x58edec91ec2cb657},  // 1e104
+    {0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed},  // 1e105
+    {0x8b865b215899f46c, 0xbd79e0d20082ee74},  // 1e106
+    {0xae67f1e9aec07187, 0xecd8590680a3aa11},  // 1e107
+    {0xda01ee641a708de9, 0xe80e6f4820cc9495},  // 1e108
+    {0x884134fe908658b2, 0x3109058d147fdcdd},  // 1e109
+    {0xaa51823e34a7eede, 0xbd4b46f0599fd415},  // 1e110
+    {0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a},  // 1e111
+    {0x850fadc09923329e, 0x03e2cf6bc604ddb0},  // 1e112
+    {0xa6539930bf6bff45, 0x84db8346b786151c},  // 1e113
+    {0xcfe87f7cef46ff16, 0xe612641865679a63},  // 1e114
+    {0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e},  // 1e115
+    {0xa26da3999aef7749, 0xe3be5e330f38f09d},  // 1e116
+    {0xcb090c8001ab551c, 0x5cadf5bfd3072cc5},  // 1e117
+    {0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6},  // 1e118
+    {0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa},  // 1e119
+    {0xc646d63501a1511d, 0xb281e1fd541501b8},  // 1e120
+    {0xf7d88bc24209a565, 0x1f225a7ca91a4226},  // 1e121
+    {0x9ae757596946075f, 0x3375788de9b06958},  // 1e122
+    {0xc1a12d2fc3978937, 0x0052d6b1641c83ae},  // 1e123
+    {0xf209787bb47d6b84, 0xc0678c5dbd23a49a},  // 1e124
+    {0x9745eb4d50ce6332, 0xf840b7ba963646e0},  // 1e125
+    {0xbd176620a501fbff, 0xb650e5a93bc3d898},  // 1e126
+    {0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe},  // 1e127
+};
+
+static void Multiply64To128(uint64_t a,
+                            uint64_t b,
+                            uint64_t* hi,
+                            uint64_t* lo) {
+#if defined(ARCH_IS_64_BIT) && !defined(HOST_OS_WINDOWS)
+  const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *hi = static_cast<uint64_t>(product >> 64);
+  *lo = static_cast<uint64_t>(product);
+#else
+  const uint64_t a_lo = a & 0xffffffff;
+  const uint64_t a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xffffffff;
+  const uint64_t b_hi = b >> 32;
+  const uint64_t p0 = a_lo * b_lo;
+  const uint64_t p1 = a_lo * b_hi;
+  const uint64_t p2 = a_hi * b_lo;
+  const uint64_t p3 = a_hi * b_hi;
+  const uint64_t mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+  *lo = (mid << 32) | (p0 & 0xffffffff);
+  *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+// Computes mantissa * 10^exponent rounded to the nearest double with the
+// Eisel-Lemire algorithm. Returns false if the result is subnormal, infinite
+// or too close to a rounding boundary to be decided from 128 bits of the
+// power of ten; the caller then falls back to the exact algorithm.
+static bool EiselLemire(uint64_t mantissa,
+                        int exponent,
+                        bool negative,
+                        double* result) {
+  ASSERT(mantissa != 0);
+  if (exponent < kMinFastExponent || exponent > kMaxFastExponent) {
+    return false;
+  }
+  const uint64_t* power = kPowersOfTen128[exponent - kMinFastExponent];
+  int leading_zeros = 0;
+  while ((mantissa >> 63) == 0) {
+    mantissa <<= 1;
+    leading_zeros++;
+  }
+  // floor(exponent * log2(10)) + 64 + bias, adjusted for the normalization.
+  uint64_t binary_exponent =
+      static_cast<uint64_t>(((217706 * exponent) >> 16) + 64 + 1023 -
+                            leading_zeros);
+  uint64_t hi, lo;
+  Multiply64To128(mantissa, power[0], &hi, &lo);
+  if ((hi & 0x1ff) == 0x1ff && lo + mantissa < mantissa) {
+    // The truncated power may have been too small: add the next 64 bits.
+    uint64_t next_hi, next_lo;
+    Multiply64To128(mantissa, power[1], &next_hi, &next_lo);
+    const uint64_t merged_lo = lo + next_hi;
+    if (merged_lo < lo) {
+      hi++;
+    }
+    if ((hi & 0x1ff) == 0x1ff && merged_lo + 1 == 0 &&
+        next_lo + mantissa < mantissa) {
+      return false;
+    }
+    lo = merged_lo;
+  }
+  const uint64_t msb = hi >> 63;
+  uint64_t bits = hi >> (msb + 9);
+  binary_exponent -= 1 ^ msb;
+  if (lo == 0 && (hi & 0x1ff) == 0 && (bits & 3) == 1) {
+    // Exactly halfway between two doubles.
+    return false;
+  }
+  bits += bits & 1;
+  bits >>= 1;
+  if ((bits >> 53) != 0) {
+    bits >>= 1;
+    binary_exponent++;
+  }
+  if (binary_exponent - 1 >= 0x7ff - 1) {
+    return false;
+  }
+  const uint64_t kFractionMask = (static_cast<uint64_t>(1) << 52) - 1;
+  bits = (binary_exponent << 52) | (bits & kFractionMask);
+  if (negative) {
+    bits |= static_cast<uint64_t>(1) << 63;
+  }
+  *result = bit_cast<double>(bits);
+  return true;
+}
+
+// Parses decimal literals of at most 19 significant digits, the common case
+// for numbers that were produced by a formatter. Returns false for anything
+// else, including inputs that are not valid literals.
+static bool CStringToDoubleFast(const char* str,
+                                intptr_t length,
+                                double* result) {
+  const char* end = str + length;
+  const char* p = str;
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    p++;
+  }
+  uint64_t mantissa = 0;
+  intptr_t significant_digits = 0;
+  bool digits_seen = false;
+  intptr_t exponent = 0;
+  // Integer part.
+  for (; p < end && *p >= '0' && *p <= '9'; p++) {
+    digits_seen = true;
+    if (mantissa == 0 && *p == '0') continue;
+    if (++significant_digits > 19) return false;
+    mantissa = 10 * mantissa + (*p - '0');
+  }
+  // Fraction part.
+  if (p < end && *p == '.') {
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+      digits_seen = true;
+      exponent--;
+      if (mantissa == 0 && *p == '0') continue;
+      if (++significant_digits > 19) return false;
+      mantissa = 10 * mantissa + (*p - '0');
+    }
+  }
+  if (!digits_seen) return false;
+  // Exponent part.
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative_exponent = (*p == '-');
+      p++;
+    }
+    if (p == end || *p < '0' || *p > '9') return false;
+    intptr_t explicit_exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+      if (explicit_exponent > 10000) return false;
+      explicit_exponent = 10 * explicit_exponent + (*p - '0');
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  if (p != end) return false;
+  if (mantissa == 0) {
+    *result = negative ? -0.0 : 0.0;
+    return true;
+  }
+  return EiselLemire(mantissa, exponent, negative, result);
+}
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
 
+  if (CStringToDoubleFast(str, length, result)) {
+    return true;
+  }
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kDoubleToStringCommonInfinitySymbol, kDoubleToStringCommonNaNSymbol);
@@ -10,7 +10,10 @@
 
 namespace dart {
 
-void DoubleToCString(double d, char* buffer, int buffer_size);
+// Writes the shortest representation of [d] that parses back to [d] into
+// [buffer], followed by a \0. Returns the number of characters written,
+// excluding the \0.
+intptr_t DoubleToCString(double d, char* buffer, int buffer_size);
 RawString* DoubleToStringAsFixed(double d, int fraction_digits);
 RawString* DoubleToStringAsExponential(double d, int fraction_digits);
 RawString* DoubleToStringAsPrecision(double d, int precision);
@@ -0,0 +1,130 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include <stdlib.h>
+
+#include "vm/double_conversion.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static void ExpectParses(const char* str, double expected) {
+  double result = 0.0;
+  EXPECT(CStringToDouble(str, strlen(str), &result));
+  if (bit_cast<uint64_t>(result) != bit_cast<uint64_t>(expected)) {
+    dart::Expect(__FILE__, __LINE__)
+        .Fail("'%s' parsed as %.17g, expected %.17g", str, result, expected);
+  }
+}
+
+// Checks the parsed value against the compiler's reading of the literal.
+#define EXPECT_PARSES(literal) ExpectParses(#literal, literal)
+
+VM_UNIT_TEST_CASE(DoubleConversion_Boundaries) {
+  EXPECT_PARSES(0.0);
+  EXPECT_PARSES(-0.0);
+  EXPECT_PARSES(0.1);
+  EXPECT_PARSES(-2.5e-3);
+  EXPECT_PARSES(0.000000000000000000000000000123);
+  // The ends of the table of powers of ten, and just outside them.
+  EXPECT_PARSES(1e-128);
+  EXPECT_PARSES(1e-129);
+  EXPECT_PARSES(9.999999999999999999e-109);
+  EXPECT_PARSES(1e127);
+  EXPECT_PARSES(1e128);
+  EXPECT_PARSES(1234567890123456789e127);
+  // 19 significant digits take the fast path, 20 do not.
+  EXPECT_PARSES(9999999999999999999.0);
+  EXPECT_PARSES(18446744073709551615.0);
+  EXPECT_PARSES(0.1234567890123456789);
+  EXPECT_PARSES(0.12345678901234567891);
+  // Around the largest and smallest normal doubles, and subnormals.
+  EXPECT_PARSES(1.7976931348623157e308);
+  EXPECT_PARSES(1.7976931348623158e308);
+  EXPECT_PARSES(2.2250738585072014e-308);
+  EXPECT_PARSES(2.2250738585072011e-308);
+  EXPECT_PARSES(4.9406564584124654e-324);
+  // Around powers of two, where the spacing of doubles changes.
+  EXPECT_PARSES(9007199254740991.0);
+  EXPECT_PARSES(9007199254740992.0);
+  EXPECT_PARSES(9007199254740994.0);
+  EXPECT_PARSES(0.9999999999999999);
+  EXPECT_PARSES(1.0000000000000002);
+
+  double result = 0.0;
+  EXPECT(!CStringToDouble("1e", 2, &result));
+  EXPECT(!CStringToDouble(".", 1, &result));
+  EXPECT(!CStringToDouble("1.5x", 4, &result));
+}
+
+VM_UNIT_TEST_CASE(DoubleConversion_Halfway) {
+  // Exactly halfway between two doubles, rounded to the even one.
+  EXPECT_PARSES(9007199254740993.0);
+  EXPECT_PARSES(9007199254740995.0);
+  EXPECT_PARSES(4503599627370496.5);
+  EXPECT_PARSES(4503599627370497.5);
+  EXPECT_PARSES(2251799813685248.25);
+  EXPECT_PARSES(1125899906842624.125);
+  EXPECT_PARSES(1.00000000000000011102230246251565404236316680908203125);
+  // Just either side of halfway.
+  EXPECT_PARSES(9007199254740993.000000001);
+  EXPECT_PARSES(9007199254740992.999999999);
+  EXPECT_PARSES(4503599627370496.5000000001);
+  EXPECT_PARSES(4503599627370496.4999999999);
+
+  // Halfway points of 19 digits or less, ulp * (b + 1/2) for every spacing of
+  // doubles in [2^50, 2^63).
+  uint64_t state = 0x2545f4914f6cdd1d;
+  char buffer[64];
+  for (intptr_t i = 0; i < 10000; i++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const uint64_t kFractionMask = (static_cast<uint64_t>(1) << 52) - 1;
+    const uint64_t b =
+        (static_cast<uint64_t>(1) << 52) | ((state >> 12) & kFractionMask);
+    const intptr_t shift = static_cast<intptr_t>(state % 13) - 3;
+    if (shift >= 0) {
+      // An integer halfway between b * 2^(shift + 1) and the next double.
+      const uint64_t halfway = ((2 * b + 1) << shift);
+      Utils::SNPrint(buffer, sizeof(buffer), "%" Pu64, halfway);
+    } else {
+      // Halfway between b / 2^bits and the next double, which has a fraction
+      // of bits + 1 binary digits.
+      const intptr_t bits = -shift;
+      const uint64_t whole = b >> bits;
+      const uint64_t fraction = ((b & ((1 << bits) - 1)) << 1) | 1;
+      // fraction / 2^(bits + 1), written with bits + 1 decimal digits.
+      uint64_t scaled = fraction;
+      for (intptr_t j = 0; j < bits + 1; j++) {
+        scaled *= 5;
+      }
+      Utils::SNPrint(buffer, sizeof(buffer), "%" Pu64 ".%0*" Pu64, whole,
+                     static_cast<int>(bits + 1), scaled);
+    }
+    ExpectParses(buffer, strtod(buffer, NULL));
+  }
+}
+
+VM_UNIT_TEST_CASE(DoubleConversion_Random) {
+  // Literals across the whole range of the fast path, and a little beyond.
+  uint64_t state = 0x853c49e6748fea9b;
+  char buffer[64];
+  for (intptr_t i = 0; i < 100000; i++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const intptr_t digits = 1 + static_cast<intptr_t>((state >> 59) % 19);
+    uint64_t mantissa = state >> 3;
+    uint64_t limit = 1;
+    for (intptr_t j = 0; j < digits; j++) {
+      limit *= 10;
+    }
+    mantissa %= limit;
+    const intptr_t exponent = static_cast<intptr_t>((state >> 20) % 301) - 150;
+    Utils::SNPrint(buffer, sizeof(buffer), "%s%" Pu64 "e%" Pd,
+                   (state & 1) != 0 ? "-" : "", mantissa, exponent);
+    ExpectParses(buffer, strtod(buffer, NULL));
+  }
+}
+
+}  // namespace dart
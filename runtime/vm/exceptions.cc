@@ -150,7 +150,10 @@ class ExceptionHandlerFinder : public StackResource {
   // exception handler. Once found, set the pc, sp and fp so that execution
   // can continue in that frame. Sets 'needs_stacktrace' if there is no
   // cath-all handler or if a stack-trace is specified in the catch.
-  bool Find() {
+  // A handler whose guard types are known to match 'exception' ends the
+  // search like a catch-all handler, so that throws caught by a typed
+  // catch without a stack trace do not walk and record the whole stack.
+  bool Find(const Instance& exception) {
     StackFrameIterator frames(ValidationPolicy::kDontValidateFrames,
                               Thread::Current(),
                               StackFrameIterator::kNoCrossThreadIteration);
@@ -166,7 +169,7 @@ class ExceptionHandlerFinder : public StackResource {
 
     while (!frame->IsEntryFrame()) {
       if (frame->IsDartFrame()) {
-        if (frame->FindExceptionHandler(thread_, &temp_handler_pc,
+        if (frame->FindExceptionHandler(thread_, exception, &temp_handler_pc,
                                         &needs_stacktrace, &is_catch_all,
                                         &is_optimized)) {
           if (!handler_pc_set_) {
@@ -630,7 +633,7 @@ static void ThrowExceptionHelper(Thread* thread,
   // Find the exception handler and determine if the handler needs a
   // stacktrace.
   ExceptionHandlerFinder finder(thread);
-  bool handler_exists = finder.Find();
+  bool handler_exists = finder.Find(exception);
   uword handler_pc = finder.handler_pc;
   uword handler_sp = finder.handler_sp;
   uword handler_fp = finder.handler_fp;
@@ -114,4 +114,51 @@ TEST_CASE(UnhandledExceptions) {
   EXPECT_VALID(Dart_Invoke(lib, NewString("testMain"), 0, NULL));
 }
 
+// Typed catches that are known to match end the handler search early; the
+// ones that do not match must still pass the exception and a stack trace on.
+TEST_CASE(TypedCatchHandlerSearch) {
+  const char* kScriptChars =
+      "class A implements Exception {}\n"
+      "class B extends A {}\n"
+      "class C implements Exception {}\n"
+      "thrower(e) { throw e; }\n"
+      "int inner(e) {\n"
+      "  try {\n"
+      "    thrower(e);\n"
+      "  } on A catch (x) {\n"
+      "    return 1;\n"
+      "  }\n"
+      "  return 0;\n"
+      "}\n"
+      "int outer(e) {\n"
+      "  try {\n"
+      "    return inner(e);\n"
+      "  } on C catch (x, st) {\n"
+      "    return st.toString().contains('thrower') ? 2 : -1;\n"
+      "  }\n"
+      "}\n"
+      "int main() {\n"
+      "  int errors = 0;\n"
+      "  for (int i = 0; i < 3; i++) {\n"
+      "    if (outer(new A()) != 1) errors++;\n"
+      "    if (outer(new B()) != 1) errors++;\n"
+      "    if (outer(new C()) != 2) errors++;\n"
+      "    try {\n"
+      "      outer('string');\n"
+      "      errors++;\n"
+      "    } on String catch (x, st) {\n"
+      "      if (!st.toString().contains('inner')) errors++;\n"
+      "    }\n"
+      "  }\n"
+      "  return errors;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t errors = -1;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &errors));
+  EXPECT_EQ(0, errors);
+}
+
 }  // namespace dart
@@ -23,20 +23,31 @@ class MessageFinalizableData {
 
   ~MessageFinalizableData() {
     for (intptr_t i = position_; i < records_.length(); i++) {
-      records_[i].callback(NULL, NULL, records_[i].peer);
+      if (records_[i].callback != NULL) {
+        records_[i].callback(NULL, NULL, records_[i].peer);
+      }
     }
   }
 
-  void Put(intptr_t external_size,
-           void* data,
-           void* peer,
-           Dart_WeakPersistentHandleFinalizer callback) {
+  // Returns the index of the new record.
+  intptr_t Put(intptr_t external_size,
+               void* data,
+               void* peer,
+               Dart_WeakPersistentHandleFinalizer callback) {
     FinalizableData finalizable_data;
     finalizable_data.data = data;
     finalizable_data.peer = peer;
     finalizable_data.callback = callback;
     records_.Add(finalizable_data);
     external_size_ += external_size;
+    return records_.length() - 1;
+  }
+
+  // Drops the finalizer of a record that was never delivered, when its data
+  // is still owned by someone else.
+  void Forget(intptr_t index) {
+    ASSERT(index >= position_);
+    records_[index].callback = NULL;
   }
 
   FinalizableData Take() {
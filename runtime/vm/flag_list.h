@@ -57,8 +57,13 @@ constexpr bool kDartPrecompiledRuntime = false;
     "Debugger support async functions.")                                       \
   P(background_compilation, bool, USING_MULTICORE,                             \
     "Run optimizing compilation in background")                                \
+  P(background_finalizers, bool, false,                                        \
+    "Run weak persistent handle finalizers on a background thread after GC "   \
+    "instead of in the GC pause.")                                             \
   R(background_compilation_stop_alot, false, bool, false,                      \
     "Stress test system: stop background compiler often.")                     \
+  P(background_compiler_tasks, int, 1,                                         \
+    "The number of tasks to use for background optimizing compilation.")       \
   P(causal_async_stacks, bool, !USING_PRODUCT, "Improved async stacks")        \
   P(collect_code, bool, true, "Attempt to GC infrequently used code.")         \
   P(collect_dynamic_function_names, bool, true,                                \
@@ -68,6 +73,9 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(compilation_counter_threshold, int, 10,                                    \
     "Function's usage-counter value before interpreted function is compiled, " \
     "-1 means never")                                                          \
+  C(compiler_pass_stats, false, false, bool, false,                            \
+    "Collect the time, zone memory and IL size of each compiler pass and the " \
+    "size of the generated code, for _getCompilerPassStats.")                  \
   P(concurrent_sweep, bool, USING_MULTICORE,                                   \
     "Concurrent sweep for old generation.")                                    \
   R(dedup_instructions, true, bool, false,                                     \
@@ -76,6 +84,8 @@ constexpr bool kDartPrecompiledRuntime = false;
     "Deoptimizes we are about to return to Dart code from native entries.")    \
   C(deoptimize_every, 0, 0, int, 0,                                            \
     "Deoptimize on every N stack overflow checks")                             \
+  P(deserialization_tasks, int, 2,                                             \
+    "The number of tasks to use for filling snapshot clusters in parallel.")   \
   R(disable_alloc_stubs_after_gc, false, bool, false, "Stress testing flag.")  \
   R(disassemble, false, bool, false, "Disassemble dart code.")                 \
   R(disassemble_optimized, false, bool, false, "Disassemble optimized code.")  \
@@ -100,18 +110,37 @@ constexpr bool kDartPrecompiledRuntime = false;
   C(force_clone_compiler_objects, false, false, bool, false,                   \
     "Force cloning of objects needed in compiler (ICData and Field).")         \
   R(gc_at_alloc, false, bool, false, "GC at every allocation.")                \
+  P(gc_target_max_pause, int, 0,                                               \
+    "Target maximum GC pause in milliseconds used to size the new and old "    \
+    "generations (0 means no target).")                                        \
+  P(gc_target_overhead, int, 0,                                                \
+    "Target percentage of time spent in GC used to size the new and old "      \
+    "generations (0 means no target).")                                        \
   P(getter_setter_ratio, int, 13,                                              \
     "Ratio of getter/setter usage used for double field unboxing heuristics")  \
   P(guess_icdata_cid, bool, true,                                              \
     "Artificially create type feedback for arithmetic etc. operations")        \
   P(huge_method_cutoff_in_tokens, int, 20000,                                  \
     "Huge method cutoff in tokens: Disables optimizations for huge methods.")  \
+  P(idle_incremental_marking, bool, false,                                     \
+    "Advance concurrent marking on the mutator during idle notifications "     \
+    "that are too short for a whole old-space collection.")                    \
   P(idle_timeout_micros, int, 1000 * kMicrosecondsPerMillisecond,              \
     "Consider thread pool isolates for idle tasks after this long.")           \
   P(idle_duration_micros, int, 500 * kMicrosecondsPerMillisecond,              \
     "Allow idle tasks to run for this long.")                                  \
+  P(incremental_compaction, bool, false,                                       \
+    "Evacuate the most fragmented pages during mark-sweep instead of "         \
+    "sweeping them.")                                                          \
+  P(incremental_compaction_pages, int, 16,                                     \
+    "The maximum number of pages evacuated by one incremental compaction.")    \
+  P(intermediate_tier_threshold, int, -1,                                      \
+    "Function's usage-counter value before it is compiled by the cheaper "     \
+    "intermediate tier, -1 means no intermediate tier")                        \
   P(interpret_irregexp, bool, USING_DBC, "Use irregexp bytecode interpreter")  \
   P(lazy_dispatchers, bool, true, "Generate dispatchers lazily")               \
+  P(lazy_toplevel_loading, bool, false,                                        \
+    "Load top level members of non-dart: libraries from kernel on first use.") \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   C(load_deferred_eagerly, true, true, bool, false,                            \
     "Load deferred libraries eagerly.")                                        \
@@ -124,15 +153,22 @@ constexpr bool kDartPrecompiledRuntime = false;
     "Maximum number of polymorphic check, otherwise it is megamorphic.")       \
   P(max_equality_polymorphic_checks, int, 32,                                  \
     "Maximum number of polymorphic checks in equality operator,")              \
+  P(message_batch_size, int, 1,                                                \
+    "Handle up to this many queued messages of an isolate without taking "     \
+    "its message queue lock in between.")                                      \
   P(new_gen_semi_max_size, int, (kWordSize <= 4) ? 8 : 16,                     \
     "Max size of new gen semi space in MB")                                    \
   P(new_gen_semi_initial_size, int, (kWordSize <= 4) ? 1 : 2,                  \
     "Initial size of new gen semi space in MB")                                \
+  P(numa_aware_heap, bool, false,                                              \
+    "Bind heap pages and GC tasks to NUMA nodes.")                             \
   P(optimization_counter_threshold, int, 30000,                                \
     "Function's usage-counter value before it is optimized, -1 means never")   \
   P(old_gen_heap_size, int, kDefaultMaxOldGenHeapSize,                         \
     "Max size of old gen heap size in MB, or 0 for unlimited,"                 \
     "e.g: --old_gen_heap_size=1024 allows up to 1024MB old gen heap")          \
+  P(old_space_thread_buffers, bool, false,                                     \
+    "Bump allocate small old-space objects from per-thread buffers.")          \
   R(pause_isolates_on_start, false, bool, false,                               \
     "Pause isolates before starting.")                                         \
   R(pause_isolates_on_exit, false, bool, false, "Pause isolates exiting.")     \
@@ -159,6 +195,12 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(reify_generic_functions, bool, true,                                       \
     "Enable reification of generic functions (not yet supported).")            \
   P(reorder_basic_blocks, bool, true, "Reorder basic blocks")                  \
+  P(scavenger_tasks, int, 0,                                                   \
+    "The number of tasks to spawn during scavenging (0 means perform all "     \
+    "scavenging on main thread).")                                             \
+  P(split_cold_code, bool, true,                                               \
+    "Move blocks that are rarely or never executed to the end of optimized "   \
+    "code.")                                                                   \
   C(stress_async_stacks, false, false, bool, false,                            \
     "Stress test async stack traces")                                          \
   P(strong, bool, true, "Enable strong mode.")                                 \
@@ -181,6 +223,8 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(trace_strong_mode_types, bool, false,                                      \
     "Trace optimizations based on strong mode types.")                         \
   D(trace_zones, bool, false, "Traces allocation sizes in the zone.")          \
+  P(transparent_huge_pages, bool, false,                                       \
+    "Back new-space, old-space and code pages with transparent huge pages.")   \
   P(truncating_left_shift, bool, true,                                         \
     "Optimize left shift to truncate if possible")                             \
   C(use_bytecode_compiler, false, false, bool, false, "Compile from bytecode") \
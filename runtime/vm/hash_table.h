@@ -222,6 +222,26 @@ class HashTable : public ValueObject {
     return false;
   }
 
+  // Returns the first unused entry on the probe sequence of 'key', without
+  // comparing it against the keys already in the table. Only valid when 'key'
+  // is known not to be present and there are no deleted entries, e.g., when
+  // rehashing into a freshly initialized table.
+  template <typename Key>
+  intptr_t FindUnused(const Key& key) const {
+    const intptr_t num_entries = NumEntries();
+    ASSERT(NumOccupied() < num_entries);
+    ASSERT(NumDeleted() == 0);
+    uword hash = KeyTraits::Hash(key);
+    ASSERT(Utils::IsPowerOfTwo(num_entries));
+    intptr_t probe = hash & (num_entries - 1);
+    int probe_distance = 1;
+    while (!IsUnused(probe)) {
+      probe = (probe + probe_distance) & (num_entries - 1);
+      probe_distance++;
+    }
+    return probe;
+  }
+
   // Sets the key of a previously unoccupied entry. This must not be the last
   // unoccupied entry.
   void InsertKey(intptr_t entry, const Object& key) const {
@@ -464,10 +484,9 @@ class HashTables : public AllStatic {
     while (it.MoveNext()) {
       intptr_t from_entry = it.Current();
       obj = from.GetKey(from_entry);
-      intptr_t to_entry = -1;
+      // Keys in 'from' are distinct, so there is no need to compare them.
       const Object& key = obj;
-      bool present = to.FindKeyOrDeletedOrUnused(key, &to_entry);
-      ASSERT(!present);
+      intptr_t to_entry = to.FindUnused(key);
       to.InsertKey(to_entry, obj);
       for (intptr_t i = 0; i < From::kPayloadSize; ++i) {
         obj = from.GetPayload(from_entry, i);
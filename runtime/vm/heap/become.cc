@@ -139,6 +139,8 @@ class ForwardHeapPointersHandleVisitor : public HandleVisitor {
         reinterpret_cast<FinalizablePersistentHandle*>(addr);
     if (IsForwardingObject(handle->raw())) {
       *handle->raw_addr() = GetForwardedObject(handle->raw());
+      ApiState* state = thread()->isolate()->api_state();
+      state->weak_persistent_handles().AddNewSpaceHandle(handle);
     }
   }
 
@@ -286,7 +288,13 @@ void Become::FollowForwardingPointers(Thread* thread) {
     // Heap pointers.
     WritableCodeLiteralsScope writable_code(heap);
     ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
+#if defined(TARGET_ARCH_IA32)
     heap->VisitObjects(&object_visitor);
+#else
+    // Image pages hold read-only snapshot objects, which never reference
+    // objects that can be forwarded, so skip walking them.
+    heap->VisitObjectsNoImagePages(&object_visitor);
+#endif
     pointer_visitor.VisitingObject(NULL);
   }
 
@@ -130,7 +130,8 @@ class CompactorTask : public ThreadPool::Task {
         freelist_(freelist),
         free_page_(NULL),
         free_current_(0),
-        free_end_(0) {}
+        free_end_(0),
+        stats_(PageSpaceTaskStats::kCompactor) {}
 
  private:
   void Run();
@@ -150,6 +151,7 @@ class CompactorTask : public ThreadPool::Task {
   HeapPage* free_page_;
   uword free_current_;
   uword free_end_;
+  PageSpaceTaskStats stats_;
 
   DISALLOW_COPY_AND_ASSIGN(CompactorTask);
 };
@@ -162,8 +164,10 @@ class CompactorTask : public ThreadPool::Task {
 // the freelist.
 void GCCompactor::Compact(HeapPage* pages,
                           FreeList* freelist,
-                          Mutex* pages_lock) {
+                          Mutex* pages_lock,
+                          HeapPage* uncompacted_pages) {
   SetupImagePageBoundaries();
+  uncompacted_pages_ = uncompacted_pages;
 
   // Divide the heap.
   // TODO(30978): Try to divide based on live bytes or with work stealing.
@@ -269,6 +273,7 @@ void CompactorTask::Run() {
   ASSERT(result);
   NOT_IN_PRODUCT(Thread* thread = Thread::Current());
   {
+    int64_t start = OS::GetCurrentMonotonicMicros();
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "Plan");
       free_page_ = head_;
@@ -278,10 +283,21 @@ void CompactorTask::Run() {
       for (HeapPage* page = head_; page != NULL; page = page->next()) {
         PlanPage(page);
       }
+#if !defined(PRODUCT)
+      if (tds.enabled()) {
+        tds.SetNumArguments(2);
+        tds.FormatArgument(0, "pages", "%" Pd, stats_.pages());
+        tds.FormatArgument(1, "freed (kB)", "%" Pd,
+                           RoundWordsToKB(stats_.freed_in_bytes() / kWordSize));
+      }
+#endif  // !defined(PRODUCT)
     }
+    int64_t end = OS::GetCurrentMonotonicMicros();
+    stats_.set_plan_micros(end - start);
 
     barrier_->Sync();
 
+    start = OS::GetCurrentMonotonicMicros();
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "Slide");
       free_page_ = head_;
@@ -301,7 +317,22 @@ void CompactorTask::Run() {
 
       ASSERT(free_page_ != NULL);
       *tail_ = free_page_;  // Last live page.
+
+      // The pages after the last live page are released by GCCompactor.
+      for (HeapPage* page = free_page_->next(); page != NULL;
+           page = page->next()) {
+        stats_.AddFreedPage();
+      }
+#if !defined(PRODUCT)
+      if (tds.enabled()) {
+        tds.SetNumArguments(1);
+        tds.FormatArgument(0, "freedPages", "%" Pd, stats_.freed_pages());
+      }
+#endif  // !defined(PRODUCT)
     }
+    end = OS::GetCurrentMonotonicMicros();
+    stats_.set_slide_micros(end - start);
+    start = end;
 
     // Heap: Regular pages already visited during sliding. Code and image pages
     // have no pointers to forward. Visit large pages and new-space.
@@ -340,8 +371,15 @@ void CompactorTask::Run() {
           isolate_->VisitWeakPersistentHandles(compactor_);
           break;
         }
-#ifndef PRODUCT
         case 5: {
+          if (compactor_->uncompacted_pages_ != NULL) {
+            TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardUncompactedPages");
+            compactor_->ForwardUncompactedPages();
+          }
+          break;
+        }
+#ifndef PRODUCT
+        case 6: {
           if (FLAG_support_service) {
             TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardObjectIdRing");
             isolate_->object_id_ring()->VisitPointers(compactor_);
@@ -353,6 +391,8 @@ void CompactorTask::Run() {
           more_forwarding_tasks = false;
       }
     }
+    stats_.set_forward_micros(OS::GetCurrentMonotonicMicros() - start);
+    isolate_->heap()->old_space()->RecordTaskStats(stats_);
 
     barrier_->Sync();
   }
@@ -370,6 +410,7 @@ void CompactorTask::PlanPage(HeapPage* page) {
   while (current < end) {
     current = PlanBlock(current, forwarding_page);
   }
+  stats_.AddPage();
 }
 
 void CompactorTask::SlidePage(HeapPage* page) {
@@ -414,6 +455,7 @@ uword CompactorTask::PlanBlock(uword first_object,
   PlanMoveToContiguousSize(block_live_size);
   forwarding_block->set_new_address(free_current_);
   free_current_ += block_live_size;
+  stats_.AddFreed(block_dead_size);
 
   return current;  // First object in the next block
 }
@@ -552,6 +594,25 @@ void GCCompactor::VisitHandle(uword addr) {
   ForwardPointer(handle->raw_addr());
 }
 
+// The objects on pages that are not compacted still carry their mark bits, as
+// these pages are swept only after compaction. Only marked objects are visited:
+// unmarked objects may refer to pages that have since been released.
+void GCCompactor::ForwardUncompactedPages() {
+  for (HeapPage* page = uncompacted_pages_; page != NULL;
+       page = page->next()) {
+    ASSERT(page->forwarding_page() == NULL);
+    uword current = page->object_start();
+    uword end = page->object_end();
+    while (current < end) {
+      RawObject* obj = RawObject::FromAddr(current);
+      if (obj->IsMarked()) {
+        obj->VisitPointers(this);
+      }
+      current += obj->Size();
+    }
+  }
+}
+
 void GCCompactor::ForwardStackPointers() {
   // N.B.: Heap pointers have already been forwarded. We forward the heap before
   // forwarding the stack to limit the number of places that need to be aware of
@@ -26,10 +26,19 @@ class GCCompactor : public ValueObject,
   GCCompactor(Thread* thread, Heap* heap)
       : HandleVisitor(thread),
         ObjectPointerVisitor(thread->isolate()),
-        heap_(heap) {}
+        heap_(heap),
+        uncompacted_pages_(NULL) {}
   ~GCCompactor() {}
 
-  void Compact(HeapPage* pages, FreeList* freelist, Mutex* mutex);
+  // Slides the live objects of 'pages' together and releases the pages that
+  // become empty. Pointers into the compacted pages are forwarded in the rest
+  // of the heap, including the marked objects of the regular data pages in
+  // 'uncompacted_pages', which may be NULL when 'pages' is the entire list of
+  // regular pages.
+  void Compact(HeapPage* pages,
+               FreeList* freelist,
+               Mutex* mutex,
+               HeapPage* uncompacted_pages);
 
  private:
   void SetupImagePageBoundaries();
@@ -37,8 +46,10 @@ class GCCompactor : public ValueObject,
   void ForwardPointer(RawObject** ptr);
   void VisitPointers(RawObject** first, RawObject** last);
   void VisitHandle(uword addr);
+  void ForwardUncompactedPages();
 
   Heap* heap_;
+  HeapPage* uncompacted_pages_;
 
   struct ImagePageRange {
     uword base;
@@ -48,6 +59,8 @@ class GCCompactor : public ValueObject,
   // {instructions, data} x {vm isolate, current isolate, shared}
   static const intptr_t kMaxImagePages = 6;
   ImagePageRange image_page_ranges_[kMaxImagePages];
+
+  friend class CompactorTask;
 };
 
 }  // namespace dart
@@ -7,6 +7,7 @@
 #include "platform/assert.h"
 #include "platform/utils.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/safepoint.h"
@@ -346,6 +347,7 @@ void Heap::EndNewSpaceGC() {
   ASSERT(gc_new_space_in_progress_);
   gc_new_space_in_progress_ = false;
   ml.NotifyAll();
+  ScheduleFinalizers();
 }
 
 bool Heap::BeginOldSpaceGC(Thread* thread) {
@@ -367,6 +369,15 @@ void Heap::EndOldSpaceGC() {
   ASSERT(gc_old_space_in_progress_);
   gc_old_space_in_progress_ = false;
   ml.NotifyAll();
+  ScheduleFinalizers();
+}
+
+void Heap::ScheduleFinalizers() {
+  // Finalizers deferred by --background_finalizers run outside the pause.
+  ApiState* state = isolate()->api_state();
+  if (state != NULL) {
+    state->finalization_queue()->Schedule();
+  }
 }
 
 void Heap::NotifyIdle(int64_t deadline) {
@@ -384,11 +395,87 @@ void Heap::NotifyIdle(int64_t deadline) {
   } else if (old_space_.ShouldPerformIdleMarkSweep(deadline)) {
     TIMELINE_FUNCTION_GC_DURATION(thread, "IdleGC");
     CollectOldSpaceGarbage(thread, kMarkSweep, kIdle);
+  } else if (FLAG_idle_incremental_marking) {
+    IncrementalMarkUntil(thread, deadline);
+  }
+  // Only worth walking old space again if a collection has produced new free
+  // blocks since the last release. Don't wait for marking or sweeping to
+  // finish; a later idle notification will pick it up.
+  bool old_space_idle;
+  {
+    MonitorLocker ml(old_space_.tasks_lock());
+    old_space_idle =
+        (old_space_.tasks() == 0) && (old_space_.phase() == PageSpace::kDone);
+  }
+  if (old_space_idle && old_space_.HasUnreleasedFreeMemory() &&
+      (OS::GetCurrentMonotonicMicros() < deadline)) {
+    ReleaseFreeMemory(deadline);
+  }
+}
+
+void Heap::ShrinkNewSpace() {
+  if (new_space_.CapacityInWords() <=
+      FLAG_new_gen_semi_initial_size * MBInWords) {
+    return;
+  }
+  Thread* thread = Thread::Current();
+  TIMELINE_FUNCTION_GC_DURATION(thread, "ShrinkNewSpace");
+  new_space_.RequestShrink();
+  CollectNewSpaceGarbage(thread, kIdle);
+}
+
+void Heap::IncrementalMarkUntil(Thread* thread, int64_t deadline) {
+  if (old_space_.ShouldStartIdleMarking() && BeginOldSpaceGC(thread)) {
+    // Only the roots are marked in a pause; the rest is left to the marker
+    // tasks and to the following idle notifications.
+    TIMELINE_FUNCTION_GC_DURATION_BASIC(thread, "StartConcurrentMarking");
+    old_space_.CollectGarbage(false /* compact */, false /* finish */);
+    EndOldSpaceGC();
+  }
+  bool drained = false;
+  if (BeginOldSpaceGC(thread)) {
+    TIMELINE_FUNCTION_GC_DURATION(thread, "IdleMark");
+    drained = old_space_.IncrementalMarkWithDeadline(deadline);
+    EndOldSpaceGC();
+  }
+  // With the marking queue empty, finalizing only remarks the roots and
+  // whatever the mutator has since greyed.
+  if (drained && (OS::GetCurrentMonotonicMicros() < deadline)) {
+    CheckFinishConcurrentMarking(thread);
   }
 }
 
 void Heap::NotifyLowMemory() {
+  // Also drop unused unoptimized code, even if the last attempt was recent.
+  old_space_.ForceCodeCollection();
+  const int64_t used_before = UsedInWords(kNew) + UsedInWords(kOld);
   CollectAllGarbage(kLowMemory);
+  const int64_t used_after = UsedInWords(kNew) + UsedInWords(kOld);
+  const int64_t new_capacity_before = CapacityInWords(kNew);
+  ShrinkNewSpace();
+  const int64_t new_capacity_after = CapacityInWords(kNew);
+  if (FLAG_verbose_gc) {
+    OS::PrintErr("Low memory: collection freed %" Pd64
+                 "kB, shrinking new space freed %" Pd64 "kB\n",
+                 (used_before - used_after) * kWordSize / KB,
+                 (new_capacity_before - new_capacity_after) * kWordSize / KB);
+  }
+  ReleaseFreeMemory();
+}
+
+intptr_t Heap::ReleaseFreeMemory(int64_t deadline) {
+  Thread* thread = Thread::Current();
+  TIMELINE_FUNCTION_GC_DURATION(thread, "ReleaseFreeMemory");
+  // Waits for the sweeper, so that all free blocks are on the free lists.
+  HeapIterationScope heap_iteration_scope(thread);
+  intptr_t released = old_space_.ReleaseFreeMemory(deadline);
+  if (FLAG_verbose_gc) {
+    const char* suffix =
+        old_space_.HasUnreleasedFreeMemory() ? " (stopped at deadline)" : "";
+    OS::PrintErr("Released %" Pd "kB of free old space memory%s\n",
+                 released / KB, suffix);
+  }
+  return released;
 }
 
 void Heap::EvacuateNewSpace(Thread* thread, GCReason reason) {
@@ -447,6 +534,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     // Some Code objects may have been collected so invalidate handler cache.
     thread->isolate()->handler_info_cache()->Clear();
     thread->isolate()->catch_entry_moves_cache()->Clear();
+    thread->isolate()->token_position_cache()->Clear();
     EndOldSpaceGC();
   }
 }
@@ -685,6 +773,11 @@ int64_t Heap::GCTimeInMicros(Space space) const {
   return old_space_.gc_time_micros();
 }
 
+int64_t Heap::AllocatedInWords(Space space) const {
+  return space == kNew ? new_space_.AllocatedInWords()
+                       : old_space_.allocated_in_words();
+}
+
 intptr_t Heap::Collections(Space space) const {
   if (space == kNew) {
     return new_space_.collections();
@@ -836,6 +929,13 @@ void Heap::RecordAfterGC(GCType type) {
          (type == kMarkSweep && gc_old_space_in_progress_) ||
          (type == kMarkCompact && gc_old_space_in_progress_));
 #ifndef PRODUCT
+  if (stats_.type_ == kScavenge) {
+    isolate()->GetGCScavengePauseMetric()->Record(delta);
+    isolate()->GetGCScavengeSurvivedMetric()->Record(
+        stats_.after_.new_.used_in_words * kWordSize);
+  } else {
+    isolate()->GetGCMarkSweepPauseMetric()->Record(delta);
+  }
   if (FLAG_support_service && Service::gc_stream.enabled() &&
       !Isolate::IsVMInternalIsolate(isolate())) {
     ServiceEvent event(isolate(), ServiceEvent::kGC);
@@ -995,4 +1095,19 @@ BumpAllocateScope::~BumpAllocateScope() {
   BackgroundCompiler::Enable(thread()->isolate());
 }
 
+GCTaskNumaScope::GCTaskNumaScope(intptr_t task_index) : bound_(false) {
+  if (FLAG_numa_aware_heap) {
+    const intptr_t num_nodes = OSThread::NumberOfNumaNodes();
+    if (num_nodes > 1) {
+      bound_ = OSThread::BindCurrentThreadToNumaNode(task_index % num_nodes);
+    }
+  }
+}
+
+GCTaskNumaScope::~GCTaskNumaScope() {
+  if (bound_) {
+    OSThread::BindCurrentThreadToNumaNode(OSThread::kAnyNumaNode);
+  }
+}
+
 }  // namespace dart
@@ -116,6 +116,13 @@ class Heap {
   void NotifyIdle(int64_t deadline);
   void NotifyLowMemory();
 
+  // Scavenges new space into a semispace of the initial size.
+  void ShrinkNewSpace();
+
+  // Returns the memory of large free blocks in old space to the OS, stopping
+  // early at the deadline. Returns the number of bytes released.
+  intptr_t ReleaseFreeMemory(int64_t deadline = kMaxInt64);
+
   // Collect a single generation.
   void CollectGarbage(Space space);
   void CollectGarbage(GCType type, GCReason reason);
@@ -137,6 +144,11 @@ class Heap {
 
   void CheckStartConcurrentMarking(Thread* thread, GCReason reason);
   void CheckFinishConcurrentMarking(Thread* thread);
+
+  // Advances concurrent marking on the current thread until 'deadline',
+  // starting it first if the old generation would benefit from an idle GC.
+  void IncrementalMarkUntil(Thread* thread, int64_t deadline);
+
   void WaitForMarkerTasks(Thread* thread);
   void WaitForSweeperTasks(Thread* thread);
 
@@ -181,6 +193,10 @@ class Heap {
 
   intptr_t Collections(Space space) const;
 
+  // Return the amount of memory allocated in a space since the heap was
+  // created. Promotions do not count as allocations in old space.
+  int64_t AllocatedInWords(Space space) const;
+
   ObjectSet* CreateAllocatedObjectSet(Zone* zone,
                                       MarkExpectation mark_expectation) const;
 
@@ -244,6 +260,12 @@ class Heap {
   void ForwardWeakEntries(RawObject* before_object, RawObject* after_object);
   void ForwardWeakTables(ObjectPointerVisitor* visitor);
 
+  // Whether a scavenge or an old-space collection is running. Only reliable on
+  // the thread performing the collection.
+  bool GCInProgress() const {
+    return gc_new_space_in_progress_ || gc_old_space_in_progress_;
+  }
+
   // Stats collection.
   void RecordTime(int id, int64_t micros) {
     ASSERT((id >= 0) && (id < GCStats::kTimeEntries));
@@ -349,6 +371,7 @@ class Heap {
   void EndNewSpaceGC();
   bool BeginOldSpaceGC(Thread* thread);
   void EndOldSpaceGC();
+  void ScheduleFinalizers();
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
@@ -452,6 +475,20 @@ class BumpAllocateScope : StackResource {
   DISALLOW_COPY_AND_ASSIGN(BumpAllocateScope);
 };
 
+// With --numa_aware_heap, runs a GC task on the CPUs of one NUMA node, chosen
+// round-robin by task index, so that the pages it touches and allocates are
+// local to it. The thread pool worker is unbound again on exit.
+class GCTaskNumaScope : public ValueObject {
+ public:
+  explicit GCTaskNumaScope(intptr_t task_index);
+  ~GCTaskNumaScope();
+
+ private:
+  bool bound_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCTaskNumaScope);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_HEAP_HEAP_H_
@@ -9,11 +9,17 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/json_stream.h"
 #include "vm/symbols.h"
 #include "vm/unit_test.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
+DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(int, survivor_aging_threshold);
+DECLARE_FLAG(int, pretenure_survival_threshold);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -110,6 +116,8 @@ TEST_CASE(ClassHeapStats) {
       "}\n";
   bool saved_concurrent_sweep_mode = FLAG_concurrent_sweep;
   FLAG_concurrent_sweep = false;
+  // The expectations below assume promotion on the second scavenge.
+  SetFlagScope<int> sfs(&FLAG_survivor_aging_threshold, 0);
   Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
   Isolate* isolate = Isolate::Current();
   ClassTable* class_table = isolate->class_table();
@@ -193,6 +201,50 @@ TEST_CASE(ClassHeapStats) {
   FLAG_concurrent_sweep = saved_concurrent_sweep_mode;
 }
 
+TEST_CASE(ClassHeapStatsPretenure) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  var a;\n"
+      "}\n"
+      "var retained;\n"
+      "fill() {\n"
+      "  retained = new List(2000);\n"
+      "  for (var i = 0; i < 2000; i++) retained[i] = new A();\n"
+      "}\n"
+      "allocate() => new A();\n";
+  SetFlagScope<int> sfs(&FLAG_pretenure_survival_threshold, 90);
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Isolate* isolate = Isolate::Current();
+  ClassTable* class_table = isolate->class_table();
+  Heap* heap = isolate->heap();
+  Dart_EnterScope();
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("fill"), 0, NULL);
+  EXPECT_VALID(result);
+  intptr_t cid;
+  {
+    TransitionNativeToVM transition(thread);
+    Library& lib = Library::Handle();
+    lib ^= Api::UnwrapHandle(h_lib);
+    const Class& cls = Class::Handle(GetClass(lib, "A"));
+    ASSERT(!cls.IsNull());
+    cid = cls.id();
+    EXPECT(!class_table->PretenureFor(cid));
+    // Every instance survives the scavenge.
+    heap->CollectGarbage(Heap::kNew);
+    EXPECT(class_table->PretenureFor(cid));
+  }
+  result = Dart_Invoke(h_lib, NewString("allocate"), 0, NULL);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT(Api::UnwrapHandle(result)->IsOldObject());
+    // A full collection gives the class another chance in new space.
+    heap->CollectGarbage(Heap::kOld);
+    EXPECT(!class_table->PretenureFor(cid));
+  }
+  Dart_ExitScope();
+}
+
 TEST_CASE(ArrayHeapStats) {
   const char* kScriptChars =
       "List f(int len) {\n"
@@ -273,6 +325,72 @@ ISOLATE_UNIT_TEST_CASE(FindObject) {
   }
 }
 
+static intptr_t heap_growth_requests = 0;
+
+static bool AllowHeapGrowth(void* callback_data, intptr_t capacity_in_bytes) {
+  heap_growth_requests++;
+  return true;
+}
+
+static bool RefuseHeapGrowth(void* callback_data, intptr_t capacity_in_bytes) {
+  heap_growth_requests++;
+  return false;
+}
+
+ISOLATE_UNIT_TEST_CASE(HeapGrowthCallback) {
+  PageSpace* old_space = Isolate::Current()->heap()->old_space();
+  const intptr_t kLargeSize = 2 * MB;
+  Dart_HeapGrowthCallback saved_callback = Isolate::HeapGrowthCallback();
+
+  heap_growth_requests = 0;
+  Isolate::SetHeapGrowthCallback(RefuseHeapGrowth);
+  EXPECT_EQ(0u, old_space->TryAllocate(kLargeSize, HeapPage::kData,
+                                       PageSpace::kForceGrowth));
+  EXPECT_EQ(1, heap_growth_requests);
+
+  heap_growth_requests = 0;
+  Isolate::SetHeapGrowthCallback(AllowHeapGrowth);
+  const Array& array =
+      Array::Handle(Array::New(kLargeSize / kWordSize, Heap::kOld));
+  EXPECT(!array.IsNull());
+  EXPECT(heap_growth_requests > 0);
+
+  Isolate::SetHeapGrowthCallback(saved_callback);
+}
+
+ISOLATE_UNIT_TEST_CASE(ReleaseFreeMemory) {
+  Heap* heap = thread->isolate()->heap();
+  heap->CollectAllGarbage();
+  // Leave large free blocks between live arrays, so that the pages are not
+  // empty and released whole by the sweeper.
+  const intptr_t kNumArrays = 64;
+  const intptr_t kArrayLength = 4 * VirtualMemory::PageSize() / kWordSize;
+  const Array& live = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < 2 * kNumArrays; i++) {
+    array = Array::New(kArrayLength, Heap::kOld);
+    if ((i % 2) == 0) {
+      array.SetAt(0, Smi::Handle(Smi::New(i)));
+      live.SetAt(i / 2, array);
+    }
+  }
+  array = Array::null();
+  heap->CollectAllGarbage();
+
+  // A passed deadline leaves all the work for a later call.
+  EXPECT_EQ(0, heap->ReleaseFreeMemory(0));
+  EXPECT(heap->old_space()->HasUnreleasedFreeMemory());
+  EXPECT_LE(kNumArrays * VirtualMemory::PageSize(), heap->ReleaseFreeMemory());
+  EXPECT(!heap->old_space()->HasUnreleasedFreeMemory());
+
+  // Live objects are untouched.
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array ^= live.At(i);
+    EXPECT_EQ(kArrayLength, array.Length());
+    EXPECT_EQ(Smi::New(2 * i), array.At(0));
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(IterateReadOnly) {
   const String& obj = String::Handle(String::New("x", Heap::kOld));
   Heap* heap = Thread::Current()->isolate()->heap();
@@ -654,10 +772,372 @@ ISOLATE_UNIT_TEST_CASE(CollectAllGarbage_LiveOldToNewChain) {
   EXPECT(size_before < size_after);
 }
 
+ISOLATE_UNIT_TEST_CASE(ParallelScavenge) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 2;
+
+  const intptr_t kLength = 1000;
+  const Array& list = Array::Handle(Array::New(kLength, Heap::kNew));
+  String& str = String::Handle();
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(2, Heap::kNew);
+    str = String::New("parallel", Heap::kNew);
+    element.SetAt(0, str);
+    element.SetAt(1, Smi::Handle(Smi::New(i)));
+    list.SetAt(i, element);
+  }
+
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT_EQ(2, heap->new_space()->LastStats().NumTasks());
+  heap->CollectGarbage(Heap::kNew);
+
+  Smi& smi = Smi::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element ^= list.At(i);
+    str ^= element.At(0);
+    EXPECT(str.Equals("parallel"));
+    smi ^= element.At(1);
+    EXPECT_EQ(i, smi.Value());
+  }
+
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
+ISOLATE_UNIT_TEST_CASE(SweepAndCompactTaskStats) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  PageSpace* old_space = heap->old_space();
+  const bool saved_concurrent_sweep = FLAG_concurrent_sweep;
+  FLAG_concurrent_sweep = false;
+
+  heap->CollectGarbage(Heap::kMarkSweep, Heap::kDebugging);
+  EXPECT_EQ(1, old_space->NumTaskStats());
+  PageSpaceTaskStats stats = old_space->TaskStatsAt(0);
+  EXPECT_EQ(PageSpaceTaskStats::kSweeper, stats.kind());
+  EXPECT(stats.pages() > 0);
+  EXPECT(stats.freed_in_bytes() >= 0);
+
+  heap->CollectGarbage(Heap::kMarkCompact, Heap::kDebugging);
+  EXPECT(old_space->NumTaskStats() >= 1);
+  EXPECT(old_space->NumTaskStats() <= FLAG_compactor_tasks);
+  intptr_t pages = 0;
+  for (intptr_t i = 0; i < old_space->NumTaskStats(); i++) {
+    stats = old_space->TaskStatsAt(i);
+    EXPECT_EQ(PageSpaceTaskStats::kCompactor, stats.kind());
+    pages += stats.pages();
+  }
+  EXPECT(pages > 0);
+
+  FLAG_concurrent_sweep = saved_concurrent_sweep;
+}
+
+ISOLATE_UNIT_TEST_CASE(IncrementalCompaction) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  PageSpace* old_space = heap->old_space();
+  const bool saved_concurrent_sweep = FLAG_concurrent_sweep;
+  const bool saved_incremental_compaction = FLAG_incremental_compaction;
+  FLAG_concurrent_sweep = false;
+
+  // Fragment old space by keeping every tenth of many small arrays alive.
+  const intptr_t kNumArrays = 20000;
+  const Array& all = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    element = Array::New(4, Heap::kOld);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    all.SetAt(i, element);
+  }
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    if ((i % 10) != 0) {
+      all.SetAt(i, Object::null_object());
+    }
+  }
+  heap->CollectGarbage(Heap::kMarkSweep, Heap::kDebugging);
+
+  FLAG_incremental_compaction = true;
+  heap->CollectGarbage(Heap::kMarkSweep, Heap::kDebugging);
+  intptr_t compacted_pages = 0;
+  for (intptr_t i = 0; i < old_space->NumTaskStats(); i++) {
+    PageSpaceTaskStats stats = old_space->TaskStatsAt(i);
+    if (stats.kind() == PageSpaceTaskStats::kCompactor) {
+      compacted_pages += stats.pages();
+    }
+  }
+  EXPECT(compacted_pages > 1);
+  EXPECT(compacted_pages <= FLAG_incremental_compaction_pages);
+
+  Smi& smi = Smi::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i += 10) {
+    element ^= all.At(i);
+    smi ^= element.At(0);
+    EXPECT_EQ(i, smi.Value());
+  }
+
+  FLAG_incremental_compaction = saved_incremental_compaction;
+  FLAG_concurrent_sweep = saved_concurrent_sweep;
+}
+
+ISOLATE_UNIT_TEST_CASE(OldSpaceThreadBuffers) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const bool saved_thread_buffers = FLAG_old_space_thread_buffers;
+  FLAG_old_space_thread_buffers = true;
+
+  const intptr_t kNumArrays = 1000;
+  const Array& all = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  Array& element = Array::Handle();
+  intptr_t adjacent = 0;
+  uword previous_end = 0;
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    element = Array::New(1, Heap::kOld);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    all.SetAt(i, element);
+    uword start = RawObject::ToAddr(element.raw());
+    if (start == previous_end) {
+      adjacent++;
+    }
+    previous_end = start + element.raw()->Size();
+  }
+  // Most consecutive allocations are bump allocated from the same buffer.
+  EXPECT(adjacent > kNumArrays / 2);
+  EXPECT(thread->old_space_top() != 0);
+
+  heap->CollectAllGarbage();
+  EXPECT_EQ(0u, thread->old_space_top());
+
+  Smi& smi = Smi::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    element ^= all.At(i);
+    smi ^= element.At(0);
+    EXPECT_EQ(i, smi.Value());
+  }
+
+  FLAG_old_space_thread_buffers = saved_thread_buffers;
+}
+
+ISOLATE_UNIT_TEST_CASE(CardRememberedArray) {
+  Heap* heap = Isolate::Current()->heap();
+  // Too large for new space, so the array is card-remembered.
+  const intptr_t kLength = Heap::kNewAllocatableSize / kWordSize + 1024;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kNew));
+  EXPECT(array.raw()->IsOldObject());
+  EXPECT(array.raw()->IsCardRemembered());
+
+  const intptr_t kStride = 1000;
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i += kStride) {
+    element = Array::New(1, Heap::kNew);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    array.SetAt(i, element);
+  }
+  // Stores dirty cards instead of adding the array to the store buffer.
+  EXPECT(!array.raw()->IsRemembered());
+
+  // The first scavenge copies the elements, the second promotes them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(!array.raw()->IsRemembered());
+
+  Smi& smi = Smi::Handle();
+  for (intptr_t i = 0; i < kLength; i += kStride) {
+    element ^= array.At(i);
+    smi ^= element.At(0);
+    EXPECT_EQ(i, smi.Value());
+  }
+}
+
 static void NoopFinalizer(void* isolate_callback_data,
                           Dart_WeakPersistentHandle handle,
                           void* peer) {}
 
+ISOLATE_UNIT_TEST_CASE(PauseTargetedHeapSizing) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const intptr_t saved_max_pause = FLAG_gc_target_max_pause;
+  const intptr_t saved_overhead = FLAG_gc_target_overhead;
+  FLAG_gc_target_max_pause = 1;
+  FLAG_gc_target_overhead = 1;
+
+  const intptr_t kLength = 1000;
+  const Array& list = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t round = 0; round < 8; round++) {
+    for (intptr_t i = 0; i < kLength; i++) {
+      element = Array::New(8, Heap::kNew);
+      list.SetAt(i, element);
+    }
+    heap->CollectGarbage(Heap::kNew);
+    Scavenger* new_space = heap->new_space();
+    EXPECT(new_space->CapacityInWords() >= new_space->UsedInWords());
+    EXPECT(new_space->CapacityInWords() <=
+           FLAG_new_gen_semi_max_size * MBInWords);
+  }
+  heap->CollectGarbage(Heap::kMarkSweep, Heap::kDebugging);
+
+#ifndef PRODUCT
+  JSONStream js;
+  {
+    JSONObject heaps(&js);
+    heap->PrintToJSONObject(Heap::kNew, &heaps);
+    heap->PrintToJSONObject(Heap::kOld, &heaps);
+  }
+  EXPECT_SUBSTRING("\"_sizing\"", js.ToCString());
+  EXPECT_SUBSTRING("\"targetMaxPauseMillis\":1", js.ToCString());
+  EXPECT_SUBSTRING("\"decision\"", js.ToCString());
+#endif  // !PRODUCT
+
+  FLAG_gc_target_max_pause = saved_max_pause;
+  FLAG_gc_target_overhead = saved_overhead;
+}
+
+ISOLATE_UNIT_TEST_CASE(ParallelWeakTableProcessing) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 2;
+
+  const intptr_t kLength = 1000;
+  const Array& list = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  const int64_t count_before = heap->PeerCount();
+  for (intptr_t i = 0; i < 2 * kLength; i++) {
+    element = Array::New(1, Heap::kNew);
+    heap->SetWeakEntry(element.raw(), Heap::kPeers, i + 1);
+    if ((i % 2) == 0) {
+      list.SetAt(i / 2, element);
+    }
+  }
+  EXPECT_EQ(count_before + 2 * kLength, heap->PeerCount());
+
+  // Half of the keys die; the others are copied and then promoted.
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT_EQ(count_before + kLength, heap->PeerCount());
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  for (intptr_t i = 0; i < kLength; i++) {
+    element ^= list.At(i);
+    EXPECT_EQ(2 * i + 1, heap->GetWeakEntry(element.raw(), Heap::kPeers));
+  }
+
+  // Keys in the old-space tables die in a mark-sweep.
+  for (intptr_t i = kLength / 2; i < kLength; i++) {
+    list.SetAt(i, Object::null_object());
+  }
+  heap->CollectGarbage(Heap::kMarkSweep, Heap::kDebugging);
+  EXPECT_EQ(count_before + kLength / 2, heap->PeerCount());
+  for (intptr_t i = 0; i < kLength / 2; i++) {
+    element ^= list.At(i);
+    EXPECT_EQ(2 * i + 1, heap->GetWeakEntry(element.raw(), Heap::kPeers));
+  }
+
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
+#if !defined(TARGET_ARCH_IA32) && defined(CONCURRENT_MARKING)
+ISOLATE_UNIT_TEST_CASE(IdleIncrementalMarking) {
+  if ((FLAG_marker_tasks == 0) || FLAG_write_protect_code) {
+    return;  // Concurrent marking disabled.
+  }
+  Heap* heap = thread->isolate()->heap();
+  PageSpace* old_space = heap->old_space();
+  heap->CollectAllGarbage();
+  heap->WaitForSweeperTasks(thread);
+
+  const intptr_t kLength = 1000;
+  const Array& list = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(1, Heap::kOld);
+    element.SetAt(0, list);
+    list.SetAt(i, element);
+  }
+
+  old_space->CollectGarbage(false /* compact */, false /* finalize */);
+  // A deadline in the past still gives back any work it took.
+  old_space->IncrementalMarkWithDeadline(0);
+  EXPECT(old_space->IncrementalMarkWithDeadline(kMaxInt64));
+  heap->WaitForMarkerTasks(thread);
+  EXPECT_EQ(PageSpace::kDone, old_space->phase());
+
+  for (intptr_t i = 0; i < kLength; i++) {
+    element ^= list.At(i);
+    EXPECT(element.At(0) == list.raw());
+  }
+}
+#endif  // !defined(TARGET_ARCH_IA32) && defined(CONCURRENT_MARKING)
+
+// Keys reached only through long chains are usually marked by a different
+// marker than the one that found their weak property first, which then has to
+// pick the property up from its pending index.
+ISOLATE_UNIT_TEST_CASE(ParallelMarkingWeakPropertiesMarkedElsewhere) {
+  SetFlagScope<int> sfs(&FLAG_marker_tasks, 4);
+  Heap* heap = thread->isolate()->heap();
+  const intptr_t kLength = 2000;
+  const intptr_t kChainLength = 20;
+  const Array& weaks = Array::Handle(Array::New(kLength, Heap::kOld));
+  const Array& chains = Array::Handle(Array::New(kLength, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    WeakProperty& weak = WeakProperty::Handle();
+    Array& key = Array::Handle();
+    Array& link = Array::Handle();
+    Array& next = Array::Handle();
+    Array& value = Array::Handle();
+    for (intptr_t i = 0; i < kLength; i++) {
+      key = Array::New(1, Heap::kOld);
+      link = key.raw();
+      for (intptr_t j = 0; j < kChainLength; j++) {
+        next = Array::New(1, Heap::kOld);
+        next.SetAt(0, link);
+        link = next.raw();
+      }
+      chains.SetAt(i, link);
+      value = Array::New(1, Heap::kOld);
+      value.SetAt(0, Smi::Handle(Smi::New(i)));
+      weak ^= WeakProperty::New(Heap::kOld);
+      weak.set_key(key);
+      weak.set_value(value);
+      weaks.SetAt(i, weak);
+    }
+  }
+  for (intptr_t round = 0; round < 3; round++) {
+    heap->CollectAllGarbage();
+    WeakProperty& weak = WeakProperty::Handle();
+    Array& value = Array::Handle();
+    for (intptr_t i = 0; i < kLength; i++) {
+      weak ^= weaks.At(i);
+      EXPECT(weak.key() != Object::null());
+      value ^= weak.value();
+      EXPECT(!value.IsNull());
+      EXPECT(value.At(0) == Smi::New(i));
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(SurvivorAging) {
+  Heap* heap = Isolate::Current()->heap();
+  SetFlagScope<int> sfs(&FLAG_survivor_aging_threshold, 100);
+  SetFlagScope<int> sfs2(&FLAG_early_tenuring_threshold, 101);
+  // Start from a scavenge that did not tenure early.
+  heap->CollectGarbage(Heap::kNew);
+
+  const Array& array = Array::Handle(Array::New(1, Heap::kNew));
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(array.raw()->IsNewObject());
+  // A survivor of one scavenge is aged instead of promoted...
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(array.raw()->IsNewObject());
+  EXPECT(array.raw()->IsCardRemembered());
+  // ... and promoted by the next scavenge, without its age.
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(array.raw()->IsOldObject());
+  EXPECT(!array.raw()->IsCardRemembered());
+}
+
 ISOLATE_UNIT_TEST_CASE(ExternalPromotion) {
   Isolate* isolate = Isolate::Current();
   Heap* heap = isolate->heap();
@@ -689,4 +1169,27 @@ ISOLATE_UNIT_TEST_CASE(ExternalPromotion) {
   EXPECT_EQ(size_before, size_after);
 }
 
+VM_UNIT_TEST_CASE(PageCacheClearedOnLowMemory) {
+  HeapPage::ClearCache();
+  TestCase::CreateTestIsolate();
+  {
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    // Spread old-space objects over several regular pages.
+    const intptr_t kLength = kPageSizeInWords / 8;
+    Array& list = Array::Handle(Array::New(64, Heap::kOld));
+    for (intptr_t i = 0; i < list.Length(); i++) {
+      list.SetAt(i, Array::Handle(Array::New(kLength, Heap::kOld)));
+    }
+  }
+  // Shutting down the isolate hands its freed pages to the cache.
+  Dart_ShutdownIsolate();
+  EXPECT_LT(0, HeapPage::CachedPageCount());
+
+  Dart_NotifyLowMemory();
+  EXPECT_EQ(0, HeapPage::CachedPageCount());
+}
+
 }  // namespace dart
@@ -158,6 +158,129 @@ class MarkerWorkList : public ValueObject {
   MarkingStack* marking_stack_;
 };
 
+// Weak properties whose keys are not marked yet, indexed by key so that
+// marking a key finds its dependent properties without rescanning all of
+// them. The properties are chained through their next_ field, both within a
+// bucket and in the lists returned by the Remove methods.
+class WeakPropertyIndex {
+ public:
+  WeakPropertyIndex()
+      : buckets_(NULL), capacity_(0), hash_shift_(kBitsPerWord), count_(0) {}
+  ~WeakPropertyIndex() { free(buckets_); }
+
+  bool IsEmpty() const { return count_ == 0; }
+
+  void Insert(RawWeakProperty* raw_weak) {
+    ASSERT(raw_weak->ptr()->next_ == 0);
+    if (count_ >= capacity_) {
+      Grow();
+    }
+    RawWeakProperty** bucket = BucketFor(raw_weak->ptr()->key_);
+    raw_weak->ptr()->next_ = reinterpret_cast<uword>(*bucket);
+    *bucket = raw_weak;
+    count_++;
+  }
+
+  // Removes and returns the properties whose key is 'raw_key'.
+  RawWeakProperty* RemoveKey(RawObject* raw_key) {
+    RawWeakProperty* result = NULL;
+    RawWeakProperty** link = BucketFor(raw_key);
+    while (*link != NULL) {
+      RawWeakProperty* cur_weak = *link;
+      RawWeakProperty** next_link =
+          reinterpret_cast<RawWeakProperty**>(&cur_weak->ptr()->next_);
+      if (cur_weak->ptr()->key_ == raw_key) {
+        *link = *next_link;
+        cur_weak->ptr()->next_ = reinterpret_cast<uword>(result);
+        result = cur_weak;
+        count_--;
+      } else {
+        link = next_link;
+      }
+    }
+    return result;
+  }
+
+  // Removes and returns the properties whose key was marked by someone else
+  // than the owner of this index.
+  RawWeakProperty* RemoveMarkedKeys() {
+    RawWeakProperty* result = NULL;
+    for (intptr_t i = 0; (i < capacity_) && (count_ > 0); i++) {
+      RawWeakProperty** link = &buckets_[i];
+      while (*link != NULL) {
+        RawWeakProperty* cur_weak = *link;
+        RawWeakProperty** next_link =
+            reinterpret_cast<RawWeakProperty**>(&cur_weak->ptr()->next_);
+        if (cur_weak->ptr()->key_->IsMarked()) {
+          *link = *next_link;
+          cur_weak->ptr()->next_ = reinterpret_cast<uword>(result);
+          result = cur_weak;
+          count_--;
+        } else {
+          link = next_link;
+        }
+      }
+    }
+    return result;
+  }
+
+  RawWeakProperty* RemoveAll() {
+    RawWeakProperty* result = NULL;
+    for (intptr_t i = 0; (i < capacity_) && (count_ > 0); i++) {
+      RawWeakProperty* cur_weak = buckets_[i];
+      buckets_[i] = NULL;
+      while (cur_weak != NULL) {
+        RawWeakProperty* next_weak =
+            reinterpret_cast<RawWeakProperty*>(cur_weak->ptr()->next_);
+        cur_weak->ptr()->next_ = reinterpret_cast<uword>(result);
+        result = cur_weak;
+        count_--;
+        cur_weak = next_weak;
+      }
+    }
+    ASSERT(count_ == 0);
+    return result;
+  }
+
+ private:
+  static const intptr_t kInitialCapacity = 64;
+
+  RawWeakProperty** BucketFor(RawObject* raw_key) {
+    ASSERT(Utils::IsPowerOfTwo(capacity_));
+    uword hash = reinterpret_cast<uword>(raw_key) >> kObjectAlignmentLog2;
+    // Fibonacci hashing spreads the consecutive addresses of keys that were
+    // allocated together.
+    hash *= static_cast<uword>(0x9E3779B97F4A7C15ULL);
+    return &buckets_[hash >> hash_shift_];
+  }
+
+  void Grow() {
+    RawWeakProperty* all = RemoveAll();
+    free(buckets_);
+    capacity_ = (capacity_ == 0) ? kInitialCapacity : (capacity_ * 2);
+    hash_shift_ = kBitsPerWord - Utils::ShiftForPowerOfTwo(capacity_);
+    buckets_ = reinterpret_cast<RawWeakProperty**>(
+        calloc(capacity_, sizeof(RawWeakProperty*)));
+    if (buckets_ == NULL) {
+      OUT_OF_MEMORY();
+    }
+    while (all != NULL) {
+      RawWeakProperty* next_weak =
+          reinterpret_cast<RawWeakProperty*>(all->ptr()->next_);
+      all->ptr()->next_ = 0;
+      Insert(all);
+      all = next_weak;
+    }
+  }
+
+  RawWeakProperty** buckets_;
+  intptr_t capacity_;
+  intptr_t hash_shift_;
+  intptr_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(WeakPropertyIndex);
+};
+
 template <bool sync>
 class MarkingVisitorBase : public ObjectPointerVisitor {
  public:
@@ -174,7 +297,7 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
 #endif  // !PRODUCT
         page_space_(page_space),
         work_list_(marking_stack),
-        delayed_weak_properties_(NULL),
+        ready_weak_properties_(NULL),
         skipped_code_functions_(skipped_code_functions),
         marked_bytes_(0),
         marked_micros_(0) {
@@ -207,68 +330,78 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   intptr_t live_size(intptr_t class_id) { return class_stats_size_[class_id]; }
 #endif  // !PRODUCT
 
+  // Picks up the pending weak properties whose keys were marked elsewhere:
+  // by other markers, or by the write barrier during concurrent marking.
+  // Returns whether this made any new values reachable.
   bool ProcessPendingWeakProperties() {
+    if (pending_weak_properties_.IsEmpty()) {
+      return false;
+    }
+    RawWeakProperty* cur_weak = pending_weak_properties_.RemoveMarkedKeys();
     bool marked = false;
-    RawWeakProperty* cur_weak = delayed_weak_properties_;
-    delayed_weak_properties_ = NULL;
     while (cur_weak != NULL) {
-      uword next_weak = cur_weak->ptr()->next_;
-      RawObject* raw_key = cur_weak->ptr()->key_;
-      // Reset the next pointer in the weak property.
-      cur_weak->ptr()->next_ = 0;
-      if (raw_key->IsMarked()) {
-        RawObject* raw_val = cur_weak->ptr()->value_;
-        marked = marked || (raw_val->IsHeapObject() && !raw_val->IsMarked());
-
-        // The key is marked so we make sure to properly visit all pointers
-        // originating from this weak property.
-        cur_weak->VisitPointersNonvirtual(this);
-      } else {
-        // Requeue this weak property to be handled later.
-        EnqueueWeakProperty(cur_weak);
-      }
-      // Advance to next weak property in the queue.
-      cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+      RawWeakProperty* next_weak =
+          reinterpret_cast<RawWeakProperty*>(cur_weak->ptr()->next_);
+      RawObject* raw_val = cur_weak->ptr()->value_;
+      marked = marked || (raw_val->IsHeapObject() && !raw_val->IsMarked());
+      cur_weak->ptr()->next_ = reinterpret_cast<uword>(ready_weak_properties_);
+      ready_weak_properties_ = cur_weak;
+      cur_weak = next_weak;
     }
+    ProcessReadyWeakProperties();
     return marked;
   }
 
   void DrainMarkingStack() {
-    RawObject* raw_obj = work_list_.Pop();
-    if ((raw_obj == NULL) && ProcessPendingWeakProperties()) {
-      raw_obj = work_list_.Pop();
-    }
-
-    if (raw_obj == NULL) {
-      return;
-    }
-
+    // Keys marked by this visitor release their weak properties directly (see
+    // MarkObject), so each property is visited once its key is marked instead
+    // of being rescanned after every drain.
     do {
-      do {
-        // First drain the marking stacks.
-        const intptr_t class_id = raw_obj->GetClassId();
+      RawObject* raw_obj = work_list_.Pop();
+      while (raw_obj != NULL) {
+        VisitMarkedObject(raw_obj);
+        raw_obj = work_list_.Pop();
+      }
+    } while (ProcessReadyWeakProperties());
+  }
 
-        intptr_t size;
-        if (class_id != kWeakPropertyCid) {
-          size = raw_obj->VisitPointersNonvirtual(this);
-        } else {
-          RawWeakProperty* raw_weak =
-              reinterpret_cast<RawWeakProperty*>(raw_obj);
-          size = ProcessWeakProperty(raw_weak);
+  // Like DrainMarkingStack, but stops once 'deadline' has passed. Returns
+  // whether the marking stack was drained.
+  bool DrainMarkingStackWithDeadline(int64_t deadline) {
+    // Reading the clock for every object would dominate small objects.
+    const intptr_t kObjectsPerDeadlineCheck = 256;
+    intptr_t objects_until_check = kObjectsPerDeadlineCheck;
+    do {
+      RawObject* raw_obj = work_list_.Pop();
+      while (raw_obj != NULL) {
+        VisitMarkedObject(raw_obj);
+        if (--objects_until_check == 0) {
+          if (OS::GetCurrentMonotonicMicros() >= deadline) {
+            return false;
+          }
+          objects_until_check = kObjectsPerDeadlineCheck;
         }
-        marked_bytes_ += size;
-        NOT_IN_PRODUCT(UpdateLiveOld(class_id, size));
-
         raw_obj = work_list_.Pop();
-      } while (raw_obj != NULL);
-
-      // Marking stack is empty.
-      ProcessPendingWeakProperties();
+      }
+    } while (ProcessReadyWeakProperties() || ProcessPendingWeakProperties());
+    return true;
+  }
 
-      // Check whether any further work was pushed either by other markers or
-      // by the handling of weak properties.
-      raw_obj = work_list_.Pop();
-    } while (raw_obj != NULL);
+  // Gives the unfinished work of this visitor back to the marking stack,
+  // including the weak properties whose keys are not marked yet, so that
+  // another marker can complete it. The visitor cannot be used afterwards.
+  void YieldWork() {
+    ASSERT(ready_weak_properties_ == NULL);
+    RawWeakProperty* cur_weak = pending_weak_properties_.RemoveAll();
+    while (cur_weak != NULL) {
+      uword next_weak = cur_weak->ptr()->next_;
+      cur_weak->ptr()->next_ = 0;
+      // The weak property is already marked; pushing it again makes its
+      // next visitor look at its key again.
+      PushMarked(cur_weak);
+      cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+    }
+    work_list_.AbandonWork();
   }
 
   void VisitPointers(RawObject** first, RawObject** last) {
@@ -289,9 +422,7 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     ASSERT(raw_weak->IsOldObject());
     ASSERT(raw_weak->IsWeakProperty());
     ASSERT(raw_weak->IsMarked());
-    ASSERT(raw_weak->ptr()->next_ == 0);
-    raw_weak->ptr()->next_ = reinterpret_cast<uword>(delayed_weak_properties_);
-    delayed_weak_properties_ = raw_weak;
+    pending_weak_properties_.Insert(raw_weak);
   }
 
   intptr_t ProcessWeakProperty(RawWeakProperty* raw_weak) {
@@ -315,8 +446,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
       skipped_code_functions_->DetachCode();
     }
     // Clear pending weak properties.
-    RawWeakProperty* cur_weak = delayed_weak_properties_;
-    delayed_weak_properties_ = NULL;
+    ASSERT(ready_weak_properties_ == NULL);
+    RawWeakProperty* cur_weak = pending_weak_properties_.RemoveAll();
     intptr_t weak_properties_cleared = 0;
     while (cur_weak != NULL) {
       uword next_weak = cur_weak->ptr()->next_;
@@ -332,6 +463,51 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   void AbandonWork() { work_list_.AbandonWork(); }
 
  private:
+  // Visits the weak properties whose keys were found marked. Returns whether
+  // there were any.
+  bool ProcessReadyWeakProperties() {
+    if (ready_weak_properties_ == NULL) {
+      return false;
+    }
+    do {
+      RawWeakProperty* cur_weak = ready_weak_properties_;
+      ready_weak_properties_ =
+          reinterpret_cast<RawWeakProperty*>(cur_weak->ptr()->next_);
+      cur_weak->ptr()->next_ = 0;
+      // The key is marked so we make sure to properly visit all pointers
+      // originating from this weak property. This may release further
+      // properties onto the ready list.
+      cur_weak->VisitPointersNonvirtual(this);
+    } while (ready_weak_properties_ != NULL);
+    return true;
+  }
+
+  // Moves the weak properties waiting for 'raw_key' to the ready list.
+  void ReleaseWeakPropertiesFor(RawObject* raw_key) {
+    RawWeakProperty* cur_weak = pending_weak_properties_.RemoveKey(raw_key);
+    while (cur_weak != NULL) {
+      RawWeakProperty* next_weak =
+          reinterpret_cast<RawWeakProperty*>(cur_weak->ptr()->next_);
+      cur_weak->ptr()->next_ = reinterpret_cast<uword>(ready_weak_properties_);
+      ready_weak_properties_ = cur_weak;
+      cur_weak = next_weak;
+    }
+  }
+
+  void VisitMarkedObject(RawObject* raw_obj) {
+    const intptr_t class_id = raw_obj->GetClassId();
+
+    intptr_t size;
+    if (class_id != kWeakPropertyCid) {
+      size = raw_obj->VisitPointersNonvirtual(this);
+    } else {
+      RawWeakProperty* raw_weak = reinterpret_cast<RawWeakProperty*>(raw_obj);
+      size = ProcessWeakProperty(raw_weak);
+    }
+    marked_bytes_ += size;
+    NOT_IN_PRODUCT(UpdateLiveOld(class_id, size));
+  }
+
   void PushMarked(RawObject* raw_obj) {
     ASSERT(raw_obj->IsHeapObject());
     ASSERT(raw_obj->IsOldObject());
@@ -370,6 +546,9 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     }
 
     PushMarked(raw_obj);
+    if (!pending_weak_properties_.IsEmpty()) {
+      ReleaseWeakPropertiesFor(raw_obj);
+    }
   }
 
 #ifndef PRODUCT
@@ -388,7 +567,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
 #endif  // !PRODUCT
   PageSpace* page_space_;
   MarkerWorkList work_list_;
-  RawWeakProperty* delayed_weak_properties_;
+  WeakPropertyIndex pending_weak_properties_;
+  RawWeakProperty* ready_weak_properties_;
   SkippedCodeFunctions* skipped_code_functions_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
@@ -499,20 +679,40 @@ void GCMarker::IterateWeakRoots(HandleVisitor* visitor) {
   isolate_->VisitWeakPersistentHandles(visitor);
 }
 
-void GCMarker::ProcessWeakTables(PageSpace* page_space) {
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+void GCMarker::ProcessWeakTableShards() {
+  const uintptr_t num_shards = Heap::kNumWeakSelectors * WeakTable::kNumShards;
+  uintptr_t shard;
+  while ((shard = AtomicOperations::FetchAndIncrement(
+              &next_weak_table_shard_)) < num_shards) {
+    const intptr_t sel = shard / WeakTable::kNumShards;
+    const intptr_t shard_in_table = shard % WeakTable::kNumShards;
     WeakTable* table =
         heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
+    const intptr_t end = table->ShardStart(shard_in_table + 1);
+    intptr_t invalidated = 0;
+    for (intptr_t i = table->ShardStart(shard_in_table); i < end; i++) {
       if (table->IsValidEntryAt(i)) {
         RawObject* raw_obj = table->ObjectAt(i);
         ASSERT(raw_obj->IsHeapObject());
         if (!raw_obj->IsMarked()) {
-          table->InvalidateAt(i);
+          table->InvalidateAtUnsynchronized(i);
+          invalidated++;
         }
       }
     }
+    if (invalidated > 0) {
+      table->AddInvalidated(invalidated);
+    }
+  }
+}
+
+void GCMarker::ProcessWeakTables(PageSpace* page_space) {
+  // With marker tasks, most shards have already been processed by the tasks
+  // while the main thread was processing weak persistent handles.
+  ProcessWeakTableShards();
+  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel))
+        ->RemoveInvalidated();
   }
 }
 
@@ -569,6 +769,7 @@ class MarkTask : public ThreadPool::Task {
         Thread::EnterIsolateAsHelper(isolate_, Thread::kMarkerTask, true);
     ASSERT(result);
     {
+      GCTaskNumaScope numa_scope(task_index_);
       TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MarkTask");
       int64_t start = OS::GetCurrentMonotonicMicros();
 
@@ -628,7 +829,9 @@ class MarkTask : public ThreadPool::Task {
         barrier_->Sync();
       } while (more_to_mark);
 
-      // Phase 2: Weak processing and follow-up marking on main thread.
+      // Phase 2: Weak processing on main thread, while the tasks clear weak
+      // table entries.
+      marker_->ProcessWeakTableShards();
       barrier_->Sync();
 
       // Phase 3: Finalize results from all markers (detach code, etc.).
@@ -691,6 +894,7 @@ class ConcurrentMarkTask : public ThreadPool::Task {
         Thread::EnterIsolateAsHelper(isolate_, Thread::kMarkerTask, true);
     ASSERT(result);
     {
+      GCTaskNumaScope numa_scope(task_index_);
       TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ConcurrentMarkTask");
       int64_t start = OS::GetCurrentMonotonicMicros();
 
@@ -786,7 +990,8 @@ GCMarker::GCMarker(Isolate* isolate, Heap* heap)
       marking_stack_(),
       visitors_(),
       marked_bytes_(0),
-      marked_micros_(0) {
+      marked_micros_(0),
+      next_weak_table_shard_(0) {
   visitors_ = new SyncMarkingVisitor*[FLAG_marker_tasks];
   for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
     visitors_[i] = NULL;
@@ -846,6 +1051,24 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space, bool collect_code) {
   }
 }
 
+bool GCMarker::IncrementalMarkWithDeadline(PageSpace* page_space,
+                                           int64_t deadline) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "IncrementalMark");
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  // Functions whose code was skipped are only detached by the final marking,
+  // so this visitor marks code strongly.
+  SyncMarkingVisitor visitor(isolate_, page_space, &marking_stack_, NULL);
+  const bool drained = visitor.DrainMarkingStackWithDeadline(deadline);
+  visitor.YieldWork();
+  visitor.AddMicros(OS::GetCurrentMonotonicMicros() - start);
+  // Class heap stats are reset before the final marking, so only the totals
+  // are kept.
+  MutexLocker ml(&stats_mutex_);
+  marked_bytes_ += visitor.marked_bytes();
+  marked_micros_ += visitor.marked_micros();
+  return drained;
+}
+
 void GCMarker::MarkObjects(PageSpace* page_space, bool collect_code) {
   if (isolate_->marking_stack() != NULL) {
     isolate_->DisableIncrementalBarrier();
@@ -920,7 +1143,8 @@ void GCMarker::MarkObjects(PageSpace* page_space, bool collect_code) {
         barrier.Sync();
       } while (more_to_mark);
 
-      // Phase 2: Weak processing on main thread.
+      // Phase 2: Weak processing on main thread, while the tasks clear weak
+      // table entries.
       {
         TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakHandles");
         MarkingWeakVisitor mark_weak(thread);
@@ -931,7 +1155,10 @@ void GCMarker::MarkObjects(PageSpace* page_space, bool collect_code) {
       // Phase 3: Finalize results from all markers (detach code, etc.).
       barrier.Exit();
     }
-    ProcessWeakTables(page_space);
+    {
+      TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakTables");
+      ProcessWeakTables(page_space);
+    }
     ProcessObjectIdTable();
   }
   Epilogue();
@@ -37,6 +37,12 @@ class GCMarker {
   // Marking must later be finalized by calling MarkObjects.
   void StartConcurrentMark(PageSpace* page_space, bool collect_code);
 
+  // Drains the marking queue on the current thread, alongside the concurrent
+  // marker tasks, until it is empty or 'deadline' has passed. Returns whether
+  // the queue was drained. Only called between StartConcurrentMark and
+  // MarkObjects.
+  bool IncrementalMarkWithDeadline(PageSpace* page_space, int64_t deadline);
+
   // (Re)mark roots, drain the marking queue and finalize weak references.
   // Does not required StartConcurrentMark to have been previously called.
   void MarkObjects(PageSpace* page_space, bool collect_code);
@@ -53,6 +59,9 @@ class GCMarker {
   void IterateWeakRoots(HandleVisitor* visitor);
   template <class MarkingVisitorType>
   void IterateWeakReferences(MarkingVisitorType* visitor);
+  // Called by anyone: clears the entries with unmarked keys in the unclaimed
+  // shards of the old-space weak tables.
+  void ProcessWeakTableShards();
   void ProcessWeakTables(PageSpace* page_space);
   void ProcessObjectIdTable();
 
@@ -69,6 +78,9 @@ class GCMarker {
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
 
+  // Next old-space weak table shard to process, counting over all selectors.
+  uintptr_t next_weak_table_shard_;
+
   friend class ConcurrentMarkTask;
   friend class MarkTask;
   DISALLOW_IMPLICIT_CONSTRUCTORS(GCMarker);
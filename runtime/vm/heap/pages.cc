@@ -6,6 +6,7 @@
 
 #include "platform/address_sanitizer.h"
 #include "platform/assert.h"
+#include "vm/dart.h"
 #include "vm/heap/become.h"
 #include "vm/heap/compactor.h"
 #include "vm/heap/marker.h"
@@ -16,6 +17,7 @@
 #include "vm/object.h"
 #include "vm/object_set.h"
 #include "vm/os_thread.h"
+#include "vm/runtime_entry.h"
 #include "vm/virtual_memory.h"
 
 namespace dart {
@@ -60,10 +62,32 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   bool is_executable = (type == kExecutable);
   // Create the new page executable (RWX) only if we're not in W^X mode
   bool create_executable = !FLAG_write_protect_code && is_executable;
-  VirtualMemory* memory = VirtualMemory::AllocateAligned(
-      size_in_words << kWordSizeLog2, kPageSize, create_executable, name);
+  const intptr_t size = size_in_words << kWordSizeLog2;
+  VirtualMemory* memory = NULL;
+  if ((size == kPageSize) && (type == kData)) {
+    memory = TakeCachedPage();
+  }
   if (memory == NULL) {
-    return NULL;
+    intptr_t alignment = kPageSize;
+    if (FLAG_transparent_huge_pages &&
+        (size >= VirtualMemory::kHugePageSize)) {
+      alignment = VirtualMemory::kHugePageSize;
+    }
+    memory = VirtualMemory::AllocateAligned(size, alignment, create_executable,
+                                            name);
+    if (memory == NULL) {
+      return NULL;
+    }
+    if (FLAG_transparent_huge_pages) {
+      // Regular pages are smaller than a huge page, but adjacent mappings are
+      // merged by the OS and can then be collapsed into huge pages.
+      memory->AdviseHugePages();
+    }
+    if (FLAG_numa_aware_heap) {
+      // Local to the allocating thread: the mutator, or a GC task bound to
+      // its node (see GCTaskNumaScope).
+      memory->BindToNumaNode(OSThread::GetCurrentNumaNode());
+    }
   }
 
   HeapPage* result = reinterpret_cast<HeapPage*>(memory->address());
@@ -72,6 +96,7 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   result->next_ = NULL;
   result->used_in_bytes_ = 0;
   result->forwarding_page_ = NULL;
+  result->card_table_ = NULL;
   result->type_ = type;
 
   LSAN_REGISTER_ROOT_REGION(result, sizeof(*result));
@@ -79,9 +104,62 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   return result;
 }
 
+Mutex* HeapPage::page_cache_mutex_ = NULL;
+VirtualMemory* HeapPage::page_cache_[kPageCacheCapacity];
+intptr_t HeapPage::page_cache_size_ = 0;
+
+void HeapPage::Init() {
+  if (page_cache_mutex_ == NULL) {
+    page_cache_mutex_ = new Mutex();
+  }
+  ASSERT(page_cache_mutex_ != NULL);
+}
+
+void HeapPage::Cleanup() {
+  ClearCache();
+}
+
+void HeapPage::ClearCache() {
+  MutexLocker ml(page_cache_mutex_);
+  while (page_cache_size_ > 0) {
+    delete page_cache_[--page_cache_size_];
+  }
+}
+
+intptr_t HeapPage::CachedPageCount() {
+  MutexLocker ml(page_cache_mutex_);
+  return page_cache_size_;
+}
+
+VirtualMemory* HeapPage::TakeCachedPage() {
+  MutexLocker ml(page_cache_mutex_);
+  if (page_cache_size_ == 0) {
+    return NULL;
+  }
+  return page_cache_[--page_cache_size_];
+}
+
+bool HeapPage::CachePage(VirtualMemory* memory) {
+  // A page bound to a NUMA node is only a good fit for that node.
+  if (FLAG_numa_aware_heap) {
+    return false;
+  }
+  MutexLocker ml(page_cache_mutex_);
+  if (page_cache_size_ == kPageCacheCapacity) {
+    return false;
+  }
+  // The page may have been write protected along with its heap.
+  memory->Protect(VirtualMemory::kReadWrite);
+  page_cache_[page_cache_size_++] = memory;
+  return true;
+}
+
 void HeapPage::Deallocate() {
   ASSERT(forwarding_page_ == NULL);
 
+  free(card_table_);
+  card_table_ = NULL;
+
   bool image_page = is_image_page();
 
   if (!image_page) {
@@ -89,8 +167,11 @@ void HeapPage::Deallocate() {
   }
 
   // For a regular heap pages, the memory for this object will become
-  // unavailable after the delete below.
-  delete memory_;
+  // unavailable after the delete below, or once it is reused.
+  if (image_page || (type_ != kData) || (memory_->size() != kPageSize) ||
+      !CachePage(memory_)) {
+    delete memory_;
+  }
 
   // For a heap page from a snapshot, the HeapPage object lives in the malloc
   // heap rather than the page itself.
@@ -125,6 +206,76 @@ void HeapPage::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   ASSERT(obj_addr == end_addr);
 }
 
+void HeapPage::AllocateCardTable() {
+  uint8_t* table =
+      reinterpret_cast<uint8_t*>(calloc(card_table_size(), sizeof(uint8_t)));
+  if (table == NULL) {
+    OUT_OF_MEMORY();
+  }
+  // Helper threads may store into the array too; the loser frees its table.
+  if (AtomicOperations::CompareAndSwapPointer(&card_table_,
+                                              static_cast<uint8_t*>(NULL),
+                                              table) != NULL) {
+    free(table);
+  }
+}
+
+// Called by the array write barrier stub when the card table of the page has
+// not been allocated yet.
+DEFINE_LEAF_RUNTIME_ENTRY(void,
+                          RememberCard,
+                          2,
+                          RawObject* object,
+                          RawObject** slot) {
+  ASSERT(object->IsOldObject());
+  ASSERT(object->IsCardRemembered());
+  HeapPage::Of(object)->RememberCard(slot);
+}
+END_LEAF_RUNTIME_ENTRY
+
+void HeapPage::RememberAllCards() {
+  if (card_table_ == NULL) {
+    AllocateCardTable();
+  }
+  memset(card_table_, 1, card_table_size());
+}
+
+void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
+  if (card_table_ == NULL) {
+    return;
+  }
+  NoSafepointScope no_safepoint;
+  RawArray* obj = static_cast<RawArray*>(RawObject::FromAddr(object_start()));
+  ASSERT(obj->IsArray() || obj->IsImmutableArray());
+  ASSERT(obj->IsCardRemembered());
+  RawObject** obj_from = obj->from();
+  RawObject** obj_to = obj->to(Smi::Value(obj->ptr()->length_));
+
+  const intptr_t size = card_table_size();
+  for (intptr_t i = 0; i < size; i++) {
+    if (card_table_[i] == 0) {
+      continue;
+    }
+    card_table_[i] = 0;
+    RawObject** card_from =
+        reinterpret_cast<RawObject**>(this) + (i << kSlotsPerCardLog2);
+    // Minus 1 because to is inclusive.
+    RawObject** card_to = card_from + (1 << kSlotsPerCardLog2) - 1;
+    if (card_from < obj_from) {
+      // First card overlaps with header.
+      card_from = obj_from;
+    }
+    if (card_to > obj_to) {
+      // Last card(s) may extend past the object. Array truncation can make
+      // this happen for more than one card.
+      card_to = obj_to;
+    }
+    if (card_from <= card_to) {
+      visitor->VisitPointers(card_from, card_to);
+    }
+  }
+}
+
 RawObject* HeapPage::FindObject(FindObjectVisitor* visitor) const {
   uword obj_addr = object_start();
   uword end_addr = object_end();
@@ -194,7 +345,10 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       marker_(NULL),
       gc_time_micros_(0),
       collections_(0),
-      mark_words_per_micro_(kConservativeInitialMarkSpeed) {
+      collections_at_last_release_(0),
+      allocated_in_words_(0),
+      mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      num_task_stats_(0) {
   // We aren't holding the lock but no one can reference us yet.
   UpdateMaxCapacityLocked();
   UpdateMaxUsed();
@@ -407,6 +561,17 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
   uword result = 0;
   if (size < kAllocatablePageSize) {
+    if (FLAG_old_space_thread_buffers && (type == HeapPage::kData) &&
+        !is_locked) {
+      Thread* thread = Thread::Current();
+      if ((thread != NULL) && (thread->heap() == heap_) &&
+          !thread->BypassSafepoints()) {
+        result = TryAllocateInThreadBuffer(thread, size);
+        if (result != 0) {
+          return result;
+        }
+      }
+    }
     if (is_locked) {
       result = freelist_[type].TryAllocateLocked(size, is_protected);
     } else {
@@ -445,6 +610,20 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+bool PageSpace::EmbedderAllowsIncreaseInWords(intptr_t increase_in_words) {
+  Dart_HeapGrowthCallback callback = Isolate::HeapGrowthCallback();
+  if (callback == NULL) {
+    return true;
+  }
+  Isolate* isolate = heap_->isolate();
+  if (isolate == Dart::vm_isolate()) {
+    return true;
+  }
+  const intptr_t capacity_in_words = CapacityInWords() + increase_in_words;
+  return callback(isolate->init_callback_data(),
+                  capacity_in_words << kWordSizeLog2);
+}
+
 void PageSpace::AcquireDataLock() {
   freelist_[HeapPage::kData].mutex()->Lock();
 }
@@ -694,6 +873,54 @@ void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   }
 }
 
+// Hands the whole OS pages inside free blocks back to the OS. The header of
+// each block, which links it into the free list, is left untouched.
+class FreeMemoryReleaser : public ObjectVisitor {
+ public:
+  FreeMemoryReleaser() : released_(0) {}
+
+  void VisitObject(RawObject* obj) {
+    if (!obj->IsFreeListElement()) {
+      return;
+    }
+    const uword addr = RawObject::ToAddr(obj);
+    const intptr_t size = obj->Size();
+    const uword start =
+        Utils::RoundUp(addr + FreeListElement::HeaderSizeFor(size),
+                       VirtualMemory::PageSize());
+    const uword end = Utils::RoundDown(addr + size, VirtualMemory::PageSize());
+    if (start < end) {
+      VirtualMemory::DontNeed(reinterpret_cast<void*>(start), end - start);
+      released_ += end - start;
+    }
+  }
+
+  intptr_t released() const { return released_; }
+
+ private:
+  intptr_t released_;
+
+  DISALLOW_COPY_AND_ASSIGN(FreeMemoryReleaser);
+};
+
+intptr_t PageSpace::ReleaseFreeMemory(int64_t deadline) {
+  // Fold the bump allocation area into the free list so it is released too.
+  AbandonBumpAllocation();
+  FreeMemoryReleaser releaser;
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    if (OS::GetCurrentMonotonicMicros() >= deadline) {
+      return releaser.released();
+    }
+    // Executable pages are left alone, as they may be write protected.
+    if ((it.page()->type() == HeapPage::kData) &&
+        !it.page()->is_image_page()) {
+      it.page()->VisitObjects(&releaser);
+    }
+  }
+  collections_at_last_release_ = collections_;
+  return releaser.released();
+}
+
 RawObject* PageSpace::FindObject(FindObjectVisitor* visitor,
                                  HeapPage::PageType type) const {
   if (type == HeapPage::kExecutable) {
@@ -739,7 +966,45 @@ void PageSpace::WriteProtect(bool read_only) {
   }
 }
 
+void PageSpace::ResetTaskStats() {
+  MonitorLocker ml(tasks_lock());
+  num_task_stats_ = 0;
+}
+
+void PageSpace::RecordTaskStats(const PageSpaceTaskStats& stats) {
+  MonitorLocker ml(tasks_lock());
+  if (num_task_stats_ < kMaxRecordedTasks) {
+    task_stats_[num_task_stats_++] = stats;
+  }
+}
+
+intptr_t PageSpace::NumTaskStats() const {
+  MonitorLocker ml(tasks_lock());
+  return num_task_stats_;
+}
+
+PageSpaceTaskStats PageSpace::TaskStatsAt(intptr_t index) const {
+  MonitorLocker ml(tasks_lock());
+  ASSERT((index >= 0) && (index < num_task_stats_));
+  return task_stats_[index];
+}
+
 #ifndef PRODUCT
+void PageSpaceTaskStats::PrintToJSONArray(JSONArray* array) const {
+  JSONObject task(array);
+  task.AddProperty("kind", KindToCString());
+  task.AddProperty("pages", pages());
+  task.AddProperty("freedPages", freed_pages());
+  task.AddProperty64("freed", freed_in_bytes());
+  if (kind() == kSweeper) {
+    task.AddProperty64("sweepMicros", sweep_micros());
+  } else {
+    task.AddProperty64("planMicros", plan_micros());
+    task.AddProperty64("slideMicros", slide_micros());
+    task.AddProperty64("forwardMicros", forward_micros());
+  }
+}
+
 void PageSpace::PrintToJSONObject(JSONObject* object) const {
   if (!FLAG_support_service) {
     return;
@@ -766,6 +1031,14 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   } else {
     space.AddProperty("avgCollectionPeriodMillis", 0.0);
   }
+  {
+    MonitorLocker ml(tasks_lock());
+    JSONArray tasks(&space, "_tasks");
+    for (intptr_t i = 0; i < num_task_stats_; i++) {
+      task_stats_[i].PrintToJSONArray(&tasks);
+    }
+  }
+  page_space_controller_.PrintToJSONObject(&space);
 }
 
 class HeapMapAsJSONVisitor : public ObjectVisitor {
@@ -885,6 +1158,30 @@ bool PageSpace::ShouldPerformIdleMarkSweep(int64_t deadline) {
   return estimated_mark_completion <= deadline;
 }
 
+bool PageSpace::ShouldStartIdleMarking() {
+  NoSafepointScope no_safepoint;
+
+  if (!page_space_controller_.NeedsIdleGarbageCollection(usage_)) {
+    return false;
+  }
+
+  MonitorLocker locker(tasks_lock());
+  return (tasks() == 0) && (phase() == kDone);
+}
+
+bool PageSpace::IncrementalMarkWithDeadline(int64_t deadline) {
+  {
+    MonitorLocker locker(tasks_lock());
+    if ((phase() != kMarking) && (phase() != kAwaitingFinalization)) {
+      return false;
+    }
+  }
+  // The caller holds the old-space GC, so marking cannot be finalized by
+  // another thread meanwhile.
+  ASSERT(marker_ != NULL);
+  return marker_->IncrementalMarkWithDeadline(this, deadline);
+}
+
 bool PageSpace::ShouldPerformIdleMarkCompact(int64_t deadline) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
@@ -1043,8 +1340,11 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
 
   int64_t mid1 = OS::GetCurrentMonotonicMicros();
 
+  ResetTaskStats();
+
   // Abandon the remainder of the bump allocation block.
   AbandonBumpAllocation();
+  ResetThreadBuffers();
   // Reset the freelists and setup sweeping.
   freelist_[HeapPage::kData].Reset();
   freelist_[HeapPage::kExecutable].Reset();
@@ -1104,11 +1404,19 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   if (compact) {
     Compact(thread);
     set_phase(kDone);
-  } else if (FLAG_concurrent_sweep) {
-    ConcurrentSweep(isolate);
   } else {
-    BlockingSweep();
-    set_phase(kDone);
+    HeapPage* last = pages_tail_;
+    if (FLAG_incremental_compaction) {
+      last = CompactIncremental(thread);
+    }
+    if (last == NULL) {
+      set_phase(kDone);
+    } else if (FLAG_concurrent_sweep) {
+      ConcurrentSweep(isolate, last);
+    } else {
+      BlockingSweep(last);
+      set_phase(kDone);
+    }
   }
 
   // Make code pages read-only.
@@ -1140,27 +1448,36 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   }
 }
 
-void PageSpace::BlockingSweep() {
+void PageSpace::BlockingSweep(HeapPage* last) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "Sweep");
 
   MutexLocker mld(freelist_[HeapPage::kData].mutex());
   MutexLocker mle(freelist_[HeapPage::kExecutable].mutex());
 
   // Sweep all regular sized pages now.
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  PageSpaceTaskStats stats(PageSpaceTaskStats::kSweeper);
   GCSweeper sweeper;
   HeapPage* prev_page = NULL;
   HeapPage* page = pages_;
   while (page != NULL) {
     HeapPage* next_page = page->next();
     bool page_in_use = sweeper.SweepPage(page, &freelist_[page->type()], true);
+    stats.AddPage();
+    stats.AddFreed(page->object_end() - page->object_start() -
+                   page->used_in_bytes());
     if (page_in_use) {
       prev_page = page;
     } else {
       FreePage(page, prev_page);
+      stats.AddFreedPage();
     }
+    if (page == last) break;
     // Advance to the next page.
     page = next_page;
   }
+  stats.set_sweep_micros(OS::GetCurrentMonotonicMicros() - start);
+  RecordTaskStats(stats);
 
   if (FLAG_verify_after_gc) {
     OS::PrintErr("Verifying after sweeping...");
@@ -1169,16 +1486,16 @@ void PageSpace::BlockingSweep() {
   }
 }
 
-void PageSpace::ConcurrentSweep(Isolate* isolate) {
+void PageSpace::ConcurrentSweep(Isolate* isolate, HeapPage* last) {
   // Start the concurrent sweeper task now.
-  GCSweeper::SweepConcurrent(isolate, pages_, pages_tail_,
+  GCSweeper::SweepConcurrent(isolate, pages_, last,
                              &freelist_[HeapPage::kData]);
 }
 
 void PageSpace::Compact(Thread* thread) {
   thread->isolate()->set_compaction_in_progress(true);
   GCCompactor compactor(thread, heap_);
-  compactor.Compact(pages_, &freelist_[HeapPage::kData], pages_lock_);
+  compactor.Compact(pages_, &freelist_[HeapPage::kData], pages_lock_, NULL);
   thread->isolate()->set_compaction_in_progress(false);
 
   if (FLAG_verify_after_gc) {
@@ -1188,6 +1505,113 @@ void PageSpace::Compact(Thread* thread) {
   }
 }
 
+// Pages whose occupancy after the previous sweep was at least this fraction of
+// their capacity are not worth evacuating.
+static const intptr_t kMaxEvacuationOccupancyPercent = 50;
+
+static int CompareOccupancy(HeapPage* const* a, HeapPage* const* b) {
+  if ((*a)->used_in_bytes() < (*b)->used_in_bytes()) return -1;
+  if ((*a)->used_in_bytes() > (*b)->used_in_bytes()) return 1;
+  return 0;
+}
+
+// Only the selected pages are planned and slid; the remaining pages keep their
+// mark bits until they are swept, so that their live objects can be found and
+// forwarded. This keeps the copying work proportional to the budget, though
+// forwarding still visits every live object in old space.
+HeapPage* PageSpace::CompactIncremental(Thread* thread) {
+  // Select the candidate pages. Pages that have not been swept yet report no
+  // usage and are skipped.
+  MallocGrowableArray<HeapPage*> candidates;
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    const intptr_t used = page->used_in_bytes();
+    const intptr_t capacity = page->object_end() - page->object_start();
+    if ((used > 0) &&
+        (used * 100 < capacity * kMaxEvacuationOccupancyPercent)) {
+      candidates.Add(page);
+    }
+  }
+  const intptr_t num_evacuated = Utils::Minimum(
+      candidates.length(),
+      static_cast<intptr_t>(FLAG_incremental_compaction_pages));
+  if (num_evacuated < 2) {
+    // Nothing to gain from sliding objects within a single page.
+    return pages_tail_;
+  }
+  candidates.Sort(CompareOccupancy);
+  const uword cutoff = candidates[num_evacuated - 1]->used_in_bytes();
+  intptr_t num_at_cutoff = 0;
+  for (intptr_t i = 0; i < num_evacuated; i++) {
+    if (candidates[i]->used_in_bytes() == cutoff) {
+      num_at_cutoff++;
+    }
+  }
+
+  // Split the page list, preserving the relative order of the pages.
+  HeapPage* evacuated = NULL;
+  HeapPage* evacuated_tail = NULL;
+  HeapPage* remaining = NULL;
+  HeapPage* remaining_tail = NULL;
+  {
+    MutexLocker ml(pages_lock_);
+    HeapPage* page = pages_;
+    while (page != NULL) {
+      HeapPage* next_page = page->next();
+      page->set_next(NULL);
+      const uword used = page->used_in_bytes();
+      bool evacuate = (used > 0) && (used < cutoff);
+      if (!evacuate && (used == cutoff) && (num_at_cutoff > 0)) {
+        evacuate = true;
+        num_at_cutoff--;
+      }
+      if (evacuate) {
+        if (evacuated_tail == NULL) {
+          evacuated = page;
+        } else {
+          evacuated_tail->set_next(page);
+        }
+        evacuated_tail = page;
+      } else {
+        if (remaining_tail == NULL) {
+          remaining = page;
+        } else {
+          remaining_tail->set_next(page);
+        }
+        remaining_tail = page;
+      }
+      page = next_page;
+    }
+    pages_ = remaining;
+    pages_tail_ = remaining_tail;
+  }
+
+  {
+    TIMELINE_FUNCTION_GC_DURATION(thread, "CompactIncremental");
+    thread->isolate()->set_compaction_in_progress(true);
+    GCCompactor compactor(thread, heap_);
+    compactor.Compact(evacuated, &freelist_[HeapPage::kData], pages_lock_,
+                      remaining);
+    thread->isolate()->set_compaction_in_progress(false);
+  }
+
+  {
+    // The compactor has set pages_tail_ to the last surviving evacuated page.
+    MutexLocker ml(pages_lock_);
+    if (remaining_tail == NULL) {
+      pages_ = evacuated;
+    } else {
+      remaining_tail->set_next(evacuated);
+    }
+    // The evacuated pages are now densely packed; keep them out of the next
+    // selection until they have been swept again.
+    for (HeapPage* page = evacuated; page != NULL; page = page->next()) {
+      page->set_used_in_bytes(page->object_end() - page->object_start());
+    }
+  }
+
+  return remaining_tail;
+}
+
 uword PageSpace::TryAllocateDataBumpInternal(intptr_t size,
                                              GrowthPolicy growth_policy,
                                              bool is_locked) {
@@ -1263,6 +1687,73 @@ uword PageSpace::TryAllocatePromoLocked(intptr_t size,
   return TryAllocateDataLocked(size, growth_policy);
 }
 
+uword PageSpace::TryAllocatePromo(intptr_t size, GrowthPolicy growth_policy) {
+  MutexLocker ml(freelist_[HeapPage::kData].mutex());
+  return TryAllocatePromoLocked(size, growth_policy);
+}
+
+void PageSpace::AbandonPromoBuffer(uword addr, intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  if (size == 0) {
+    return;
+  }
+  freelist_[HeapPage::kData].Free(addr, size);
+  AtomicOperations::DecrementBy(&(usage_.used_in_words),
+                                (size >> kWordSizeLog2));
+}
+
+uword PageSpace::TryAllocateInThreadBuffer(Thread* thread, intptr_t size) {
+  ASSERT(thread->heap() == heap_);
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  if (size > kMaxThreadBufferObjectSize) {
+    return 0;
+  }
+  uword top = thread->old_space_top();
+  uword end = thread->old_space_end();
+  if (static_cast<intptr_t>(end - top) < size) {
+    // Refill, returning the remainder of the old buffer under the same lock.
+    FreeList* freelist = &freelist_[HeapPage::kData];
+    MutexLocker ml(freelist->mutex());
+    if (top < end) {
+      freelist->FreeLocked(top, end - top);
+    }
+    top = freelist->TryAllocateLocked(kThreadBufferSize, false);
+    if (top == 0) {
+      thread->set_old_space_top(0);
+      thread->set_old_space_end(0);
+      return 0;
+    }
+    end = top + kThreadBufferSize;
+    thread->set_old_space_end(end);
+  }
+  uword result = top;
+  top += size;
+  thread->set_old_space_top(top);
+  if (top < end) {
+    // Keep the page walkable.
+    FreeListElement::AsElement(top, end - top);
+  }
+  AtomicOperations::IncrementBy(&(usage_.used_in_words),
+                                (size >> kWordSizeLog2));
+  return result;
+}
+
+void PageSpace::AbandonThreadBuffer(Thread* thread) {
+  const uword top = thread->old_space_top();
+  const uword end = thread->old_space_end();
+  if (top < end) {
+    freelist_[HeapPage::kData].Free(top, end - top);
+  }
+  thread->set_old_space_top(0);
+  thread->set_old_space_end(0);
+}
+
+void PageSpace::ResetThreadBuffers() {
+  if (heap_ != NULL) {
+    heap_->isolate()->thread_registry()->ResetOldSpaceBuffers();
+  }
+}
+
 void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   // Setup a HeapPage so precompiled Instructions can be traversed.
   // Instructions are contiguous at [pointer, pointer + size). HeapPage
@@ -1280,6 +1771,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->object_end_ = memory->end();
   page->used_in_bytes_ = page->object_end_ - page->object_start();
   page->forwarding_page_ = NULL;
+  page->card_table_ = NULL;
   if (is_executable) {
     ASSERT(Utils::IsAligned(pointer, OS::PreferredCodeAlignment()));
     page->type_ = HeapPage::kExecutable;
@@ -1303,7 +1795,11 @@ PageSpaceController::PageSpaceController(Heap* heap,
       heap_growth_max_(heap_growth_max),
       garbage_collection_time_ratio_(garbage_collection_time_ratio),
       last_code_collection_in_us_(OS::GetCurrentMonotonicMicros()),
-      idle_gc_threshold_in_words_(0) {
+      idle_gc_threshold_in_words_(0),
+      last_gc_time_fraction_(0),
+      last_pause_micros_(0),
+      last_grow_heap_(0),
+      limited_by_pause_(false) {
   intptr_t grow_heap = heap_growth_max / 2;
   gc_threshold_in_words_ =
       last_usage_.capacity_in_words + (kPageSizeInWords * grow_heap);
@@ -1354,6 +1850,13 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
   heap_->RecordData(PageSpace::kGCTimeFraction, gc_time_fraction);
+  last_gc_time_fraction_ = gc_time_fraction;
+  last_pause_micros_ = end - start;
+  limited_by_pause_ = false;
+  // An explicit overhead target replaces the default time ratio.
+  const int garbage_collection_time_ratio =
+      (FLAG_gc_target_overhead > 0) ? FLAG_gc_target_overhead
+                                    : garbage_collection_time_ratio_;
 
   // Assume garbage increases linearly with allocation:
   // G = kA, and estimate k from the previous cycle.
@@ -1375,8 +1878,8 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
     // Define GC to be 'worthwhile' iff at least fraction t of heap is garbage.
     double t = 1.0 - desired_utilization_;
     // If we spend too much time in GC, strive for even more free space.
-    if (gc_time_fraction > garbage_collection_time_ratio_) {
-      t += (gc_time_fraction - garbage_collection_time_ratio_) / 100.0;
+    if (gc_time_fraction > garbage_collection_time_ratio) {
+      t += (gc_time_fraction - garbage_collection_time_ratio) / 100.0;
     }
 
     // Number of pages we can allocate and still be within the desired growth
@@ -1431,7 +1934,28 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
       (before.CombinedCapacityInWords() - after.CombinedCapacityInWords()) /
       kPageSizeInWords;
   grow_heap = Utils::Maximum(grow_heap, freed_pages / 2);
+
+  if ((FLAG_gc_target_max_pause > 0) && (last_pause_micros_ > 0) &&
+      (before.CombinedUsedInWords() > 0)) {
+    // Assume the pause scales with the amount of data in the heap when the
+    // collection starts, and cap growth so the next pause stays within the
+    // target. Always allow one page so the mutator keeps making progress.
+    const double micros_per_word =
+        static_cast<double>(last_pause_micros_) / before.CombinedUsedInWords();
+    const intptr_t max_used_in_words = static_cast<intptr_t>(
+        FLAG_gc_target_max_pause * kMicrosecondsPerMillisecond /
+        micros_per_word);
+    const intptr_t max_grow_heap = Utils::Maximum(
+        static_cast<intptr_t>(1),
+        (max_used_in_words - after.CombinedCapacityInWords()) /
+            kPageSizeInWords);
+    if (grow_heap > max_grow_heap) {
+      grow_heap = max_grow_heap;
+      limited_by_pause_ = true;
+    }
+  }
   heap_->RecordData(PageSpace::kAllowedGrowth, grow_heap);
+  last_grow_heap_ = grow_heap;
   last_usage_ = after;
 
   // Save final threshold compared before growing.
@@ -1478,6 +2002,24 @@ void PageSpaceController::EvaluateSnapshotLoad(SpaceUsage after) {
   }
 }
 
+#ifndef PRODUCT
+void PageSpaceController::PrintToJSONObject(JSONObject* object) const {
+  JSONObject sizing(object, "_sizing");
+  sizing.AddProperty("targetMaxPauseMillis",
+                     static_cast<intptr_t>(FLAG_gc_target_max_pause));
+  sizing.AddProperty("targetOverheadPercent",
+                     static_cast<intptr_t>(FLAG_gc_target_overhead));
+  sizing.AddProperty("overheadPercent",
+                     static_cast<intptr_t>(last_gc_time_fraction_));
+  sizing.AddProperty("lastPauseMillis",
+                     MicrosecondsToMilliseconds(last_pause_micros_));
+  sizing.AddProperty64("threshold", gc_threshold_in_words_ * kWordSize);
+  sizing.AddProperty64("growth", last_grow_heap_ * kPageSize);
+  sizing.AddProperty("decision",
+                     limited_by_pause_ ? "limit-for-pause" : "grow");
+}
+#endif  // !PRODUCT
+
 void PageSpaceGarbageCollectionHistory::AddGarbageCollectionTime(int64_t start,
                                                                  int64_t end) {
   Entry entry;
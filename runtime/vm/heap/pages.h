@@ -21,6 +21,7 @@ DECLARE_FLAG(bool, write_protect_code);
 
 // Forward declarations.
 class Heap;
+class JSONArray;
 class JSONObject;
 class ObjectPointerVisitor;
 class ObjectSet;
@@ -37,6 +38,14 @@ class HeapPage {
  public:
   enum PageType { kData = 0, kExecutable, kNumPageTypes };
 
+  static void Init();
+  static void Cleanup();
+
+  // Unmap the freed pages held in the cache, at most
+  // kPageCacheCapacity * kPageSize bytes.
+  static void ClearCache();
+  static intptr_t CachedPageCount();
+
   HeapPage* next() const { return next_; }
   void set_next(HeapPage* next) { next_ = next; }
 
@@ -82,6 +91,37 @@ class HeapPage {
     return reinterpret_cast<HeapPage*>(addr & kPageMask);
   }
 
+  // Card table of a large page holding a card-remembered array: one byte per
+  // kSlotsPerCard slots, set when a new-space pointer may have been stored
+  // into the card. Allocated on the first store.
+  static const intptr_t kSlotsPerCardLog2 = 9;
+  static const intptr_t kBytesPerCardLog2 = kWordSizeLog2 + kSlotsPerCardLog2;
+
+  static intptr_t card_table_offset() {
+    return OFFSET_OF(HeapPage, card_table_);
+  }
+  intptr_t card_table_size() const {
+    return Utils::RoundUp(memory_->size(), 1 << kBytesPerCardLog2) >>
+           kBytesPerCardLog2;
+  }
+
+  void RememberCard(RawObject* const* slot) {
+    ASSERT(Contains(reinterpret_cast<uword>(slot)));
+    if (card_table_ == NULL) {
+      AllocateCardTable();
+    }
+    intptr_t offset =
+        reinterpret_cast<uword>(slot) - reinterpret_cast<uword>(this);
+    intptr_t index = offset >> kBytesPerCardLog2;
+    ASSERT((index >= 0) && (index < card_table_size()));
+    card_table_[index] = 1;
+  }
+  void RememberAllCards();
+
+  // Clears the dirty cards and visits their slots. The visitor is expected to
+  // dirty them again (RememberCard) if they still point into new space.
+  void VisitRememberedCards(ObjectPointerVisitor* visitor);
+
  private:
   void set_object_end(uword value) {
     ASSERT((value & kObjectAlignmentMask) == kOldObjectAlignmentOffset);
@@ -97,11 +137,24 @@ class HeapPage {
   // page becomes immediately inaccessible.
   void Deallocate();
 
+  void AllocateCardTable();
+
+  // Regular data pages freed by one heap are kept for the next one, which
+  // makes creating and shutting down short-lived isolates cheaper.
+  static VirtualMemory* TakeCachedPage();
+  static bool CachePage(VirtualMemory* memory);
+
+  static const intptr_t kPageCacheCapacity = 16;
+  static Mutex* page_cache_mutex_;
+  static VirtualMemory* page_cache_[kPageCacheCapacity];
+  static intptr_t page_cache_size_;
+
   VirtualMemory* memory_;
   HeapPage* next_;
   uword object_end_;
   uword used_in_bytes_;
   ForwardingPage* forwarding_page_;
+  uint8_t* card_table_;
   PageType type_;
 
   friend class PageSpace;
@@ -174,6 +227,11 @@ class PageSpaceController {
   void Disable() { is_enabled_ = false; }
   bool is_enabled() { return is_enabled_; }
 
+#ifndef PRODUCT
+  // Reports the targets and the most recent sizing decision.
+  void PrintToJSONObject(JSONObject* object) const;
+#endif  // !PRODUCT
+
  private:
   Heap* heap_;
 
@@ -212,14 +270,86 @@ class PageSpaceController {
 
   PageSpaceGarbageCollectionHistory history_;
 
+  // Feedback from the last evaluated GC, reported through the service.
+  int last_gc_time_fraction_;
+  int64_t last_pause_micros_;
+  intptr_t last_grow_heap_;
+  // Whether --gc_target_max_pause capped the last growth decision.
+  bool limited_by_pause_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
 };
 
+// Work done by a single sweeper or compactor task during the most recent
+// old-space collection. Times are in microseconds.
+class PageSpaceTaskStats {
+ public:
+  enum Kind { kSweeper, kCompactor };
+
+  explicit PageSpaceTaskStats(Kind kind = kSweeper)
+      : kind_(kind),
+        pages_(0),
+        freed_pages_(0),
+        freed_in_bytes_(0),
+        sweep_micros_(0),
+        plan_micros_(0),
+        slide_micros_(0),
+        forward_micros_(0) {}
+
+  Kind kind() const { return kind_; }
+  const char* KindToCString() const {
+    return kind_ == kSweeper ? "Sweeper" : "Compactor";
+  }
+
+  // Number of regular pages swept or compacted by this task.
+  intptr_t pages() const { return pages_; }
+  // Number of pages that were empty afterwards and released.
+  intptr_t freed_pages() const { return freed_pages_; }
+  // Bytes on the visited pages not occupied by live objects, i.e., returned
+  // to the freelist or released along with empty pages.
+  intptr_t freed_in_bytes() const { return freed_in_bytes_; }
+
+  void AddPage() { pages_++; }
+  void AddFreedPage() { freed_pages_++; }
+  void AddFreed(intptr_t size) { freed_in_bytes_ += size; }
+
+  // Sweeper only.
+  int64_t sweep_micros() const { return sweep_micros_; }
+  void set_sweep_micros(int64_t value) { sweep_micros_ = value; }
+
+  // Compactor only: computing forwarding addresses, sliding objects while
+  // updating their pointers, and updating the remaining roots.
+  int64_t plan_micros() const { return plan_micros_; }
+  void set_plan_micros(int64_t value) { plan_micros_ = value; }
+  int64_t slide_micros() const { return slide_micros_; }
+  void set_slide_micros(int64_t value) { slide_micros_ = value; }
+  int64_t forward_micros() const { return forward_micros_; }
+  void set_forward_micros(int64_t value) { forward_micros_ = value; }
+
+#ifndef PRODUCT
+  void PrintToJSONArray(JSONArray* array) const;
+#endif  // !PRODUCT
+
+ private:
+  Kind kind_;
+  intptr_t pages_;
+  intptr_t freed_pages_;
+  intptr_t freed_in_bytes_;
+  int64_t sweep_micros_;
+  int64_t plan_micros_;
+  int64_t slide_micros_;
+  int64_t forward_micros_;
+};
+
 class PageSpace {
  public:
   enum GrowthPolicy { kControlGrowth, kForceGrowth };
   enum Phase { kDone, kMarking, kAwaitingFinalization, kSweeping };
 
+  // Objects of at least this size get a large page of their own, and are
+  // never moved.
+  static const intptr_t kAllocatablePageSize = 64 * KB;
+
   PageSpace(Heap* heap, intptr_t max_capacity_in_words);
   ~PageSpace();
 
@@ -229,8 +359,13 @@ class PageSpace {
     bool is_protected =
         (type == HeapPage::kExecutable) && FLAG_write_protect_code;
     bool is_locked = false;
-    return TryAllocateInternal(size, type, growth_policy, is_protected,
-                               is_locked);
+    uword result = TryAllocateInternal(size, type, growth_policy, is_protected,
+                                       is_locked);
+    if (result != 0) {
+      AtomicOperations::IncrementInt64By(&allocated_in_words_,
+                                         size >> kWordSizeLog2);
+    }
+    return result;
   }
 
   bool NeedsGarbageCollection() const {
@@ -277,6 +412,32 @@ class PageSpace {
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Gives the page-aligned interior of free blocks in data pages back to the
+  // OS. The blocks stay on the free list. The caller must be iterating the
+  // heap. Stops between pages once the deadline has passed; the next call
+  // then starts over. Returns the number of bytes released.
+  intptr_t ReleaseFreeMemory(int64_t deadline);
+  // Whether a collection has run since the last ReleaseFreeMemory that
+  // finished.
+  bool HasUnreleasedFreeMemory() const {
+    return collections_ != collections_at_last_release_;
+  }
+
+  // Visits the dirty cards of the card-remembered arrays. The visitor is told
+  // which array it is visiting, as with store buffer entries. Does not take
+  // the pages lock: the scavenger may add large pages while visiting, but
+  // only at the head of the list.
+  template <typename Visitor>
+  void VisitRememberedCards(Visitor* visitor) const {
+    for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+      if (page->card_table_ != NULL) {
+        visitor->VisitingOldObject(RawObject::FromAddr(page->object_start()));
+        page->VisitRememberedCards(visitor);
+      }
+    }
+    visitor->VisitingOldObject(NULL);
+  }
+
   RawObject* FindObject(FindObjectVisitor* visitor,
                         HeapPage::PageType type) const;
 
@@ -284,6 +445,12 @@ class PageSpace {
   // code.
   bool ShouldCollectCode();
 
+  // Makes the next collection attempt to collect code regardless of when the
+  // last attempt was.
+  void ForceCodeCollection() {
+    page_space_controller_.set_last_code_collection_in_us(0);
+  }
+
   // Collect the garbage in the page space using mark-sweep or mark-compact.
   void CollectGarbage(bool compact, bool finalize);
 
@@ -312,14 +479,33 @@ class PageSpace {
   bool ShouldPerformIdleMarkSweep(int64_t deadline);
   bool ShouldPerformIdleMarkCompact(int64_t deadline);
 
+  // Whether an idle notification that cannot fit a whole mark-sweep should
+  // start concurrent marking, so that later notifications can advance it.
+  bool ShouldStartIdleMarking();
+  // Marks on the current thread until 'deadline' while concurrent marking is
+  // in progress. Returns whether the marking queue was drained.
+  bool IncrementalMarkWithDeadline(int64_t deadline);
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
+  // Per-task statistics of the sweeper and compactor tasks of the most recent
+  // collection. Tasks record their statistics when they finish, which for the
+  // concurrent sweeper may be after the collection itself has completed.
+  void ResetTaskStats();
+  void RecordTaskStats(const PageSpaceTaskStats& stats);
+  intptr_t NumTaskStats() const;
+  PageSpaceTaskStats TaskStatsAt(intptr_t index) const;
+
   int64_t gc_time_micros() const { return gc_time_micros_; }
 
   void IncrementCollections() { collections_++; }
 
   intptr_t collections() const { return collections_; }
 
+  // Words allocated through TryAllocate since the space was created, which
+  // excludes objects promoted by the scavenger.
+  int64_t allocated_in_words() const { return allocated_in_words_; }
+
 #ifndef PRODUCT
   void PrintToJSONObject(JSONObject* object) const;
   void PrintHeapMapToJSONStream(Isolate* isolate, JSONStream* stream) const;
@@ -366,6 +552,22 @@ class PageSpace {
   uword TryAllocateDataBumpLocked(intptr_t size, GrowthPolicy growth_policy);
   // Prefer small freelist blocks, then chip away at the bump block.
   uword TryAllocatePromoLocked(intptr_t size, GrowthPolicy growth_policy);
+  // As above, but takes the data lock. Used by parallel scavenger tasks to
+  // refill their promotion buffers.
+  uword TryAllocatePromo(intptr_t size, GrowthPolicy growth_policy);
+  // Return the unused remainder of a promotion buffer to the freelist.
+  void AbandonPromoBuffer(uword addr, intptr_t size);
+
+  // Bump allocate from a data-page buffer owned by 'thread', refilling it from
+  // the freelist in bulk so that the freelist lock is only taken once per
+  // buffer. Returns 0 if the size is not suitable or no buffer is available.
+  uword TryAllocateInThreadBuffer(Thread* thread, intptr_t size);
+  // Return the remainder of the thread's buffer to the freelist.
+  void AbandonThreadBuffer(Thread* thread);
+  // Drop the buffers of all threads scheduled in the isolate. Must be called at
+  // a safepoint, before the freelists are rebuilt by sweeping: the remainders
+  // are formatted as free-list elements and are reclaimed by the sweeper.
+  void ResetThreadBuffers();
 
   void SetupImagePage(void* pointer, uword size, bool is_executable);
 
@@ -391,7 +593,8 @@ class PageSpace {
     kAllowedGrowth = 3
   };
 
-  static const intptr_t kAllocatablePageSize = 64 * KB;
+  static const intptr_t kThreadBufferSize = 8 * KB;
+  static const intptr_t kMaxThreadBufferObjectSize = 512;
 
   uword TryAllocateInternal(intptr_t size,
                             HeapPage::PageType type,
@@ -418,26 +621,36 @@ class PageSpace {
                                  bool finalize,
                                  int64_t pre_wait_for_sweepers,
                                  int64_t pre_safe_point);
-  void BlockingSweep();
-  void ConcurrentSweep(Isolate* isolate);
+  // Sweep the regular pages from the start of the page list up to and
+  // including 'last'.
+  void BlockingSweep(HeapPage* last);
+  void ConcurrentSweep(Isolate* isolate, HeapPage* last);
   void Compact(Thread* thread);
+  // Evacuates the most fragmented regular pages and moves the surviving ones
+  // to the end of the page list. Returns the last page that still needs to be
+  // swept, or NULL if none remain.
+  HeapPage* CompactIncremental(Thread* thread);
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
   bool CanIncreaseCapacityInWords(intptr_t increase_in_words) {
-    if (max_capacity_in_words_ == 0) {
-      // Unlimited.
-      return true;
+    if (max_capacity_in_words_ != 0) {
+      // TODO(issue 27413): Make the check against capacity and the bump
+      // of capacity atomic so that CapacityInWords does not exceed
+      // max_capacity_in_words_.
+      intptr_t free_capacity_in_words =
+          (max_capacity_in_words_ - CapacityInWords());
+      if ((free_capacity_in_words <= 0) ||
+          (increase_in_words > free_capacity_in_words)) {
+        return false;
+      }
     }
-    // TODO(issue 27413): Make the check against capacity and the bump
-    // of capacity atomic so that CapacityInWords does not exceed
-    // max_capacity_in_words_.
-    intptr_t free_capacity_in_words =
-        (max_capacity_in_words_ - CapacityInWords());
-    return ((free_capacity_in_words > 0) &&
-            (increase_in_words <= free_capacity_in_words));
+    return EmbedderAllowsIncreaseInWords(increase_in_words);
   }
 
+  // Asks the embedder's heap growth callback, if any.
+  bool EmbedderAllowsIncreaseInWords(intptr_t increase_in_words);
+
   FreeList freelist_[HeapPage::kNumPageTypes];
 
   Heap* heap_;
@@ -478,8 +691,15 @@ class PageSpace {
 
   int64_t gc_time_micros_;
   intptr_t collections_;
+  intptr_t collections_at_last_release_;
+  int64_t allocated_in_words_;
   intptr_t mark_words_per_micro_;
 
+  // Guarded by tasks_lock_.
+  static const intptr_t kMaxRecordedTasks = 32;
+  intptr_t num_task_stats_;
+  PageSpaceTaskStats task_stats_[kMaxRecordedTasks];
+
   friend class ExclusivePageIterator;
   friend class ExclusiveCodePageIterator;
   friend class ExclusiveLargePageIterator;
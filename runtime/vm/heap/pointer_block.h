@@ -175,6 +175,19 @@ class MarkingStack : public BlockStack<kMarkingStackBlockSize> {
 
 typedef MarkingStack::Block MarkingStackBlock;
 
+// Work list shared by the tasks of a parallel scavenge: holds objects that have
+// been copied but whose slots have not yet been visited. Shares the block size
+// (and thus the cache of empty blocks) with the marking stack.
+class ScavengerStack : public BlockStack<kMarkingStackBlockSize> {
+ public:
+  // Adds and transfers ownership of the block to the buffer.
+  void PushBlock(Block* block) {
+    BlockStack<Block::kSize>::PushBlockImpl(block);
+  }
+};
+
+typedef ScavengerStack::Block ScavengerStackBlock;
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_HEAP_POINTER_BLOCK_H_
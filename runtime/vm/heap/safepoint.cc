@@ -4,8 +4,10 @@
 
 #include "vm/heap/safepoint.h"
 
+#include "vm/os.h"
 #include "vm/thread.h"
 #include "vm/thread_registry.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
@@ -38,6 +40,7 @@ SafepointHandler::SafepointHandler(Isolate* isolate)
     : isolate_(isolate),
       safepoint_lock_(new Monitor()),
       number_threads_not_at_safepoint_(0),
+      safepoint_request_micros_(0),
       safepoint_operation_count_(0),
       owner_(NULL) {}
 
@@ -53,6 +56,7 @@ void SafepointHandler::SafepointThreads(Thread* T) {
   ASSERT(T->no_safepoint_scope_depth() == 0);
   ASSERT(T->execution_state() == Thread::kThreadInVM);
 
+  int64_t start;
   {
     // First grab the threads list lock for this isolate
     // and check if a safepoint is already in progress. This
@@ -75,6 +79,11 @@ void SafepointHandler::SafepointThreads(Thread* T) {
 
     // Set safepoint in progress state by this thread.
     SetSafepointInProgress(T);
+    start = OS::GetCurrentMonotonicMicros();
+    {
+      MonitorLocker sl(safepoint_lock_);
+      safepoint_request_micros_ = start;
+    }
 
     // Go over the active thread list and ensure that all threads active
     // in the isolate reach a safepoint.
@@ -104,6 +113,9 @@ void SafepointHandler::SafepointThreads(Thread* T) {
   // Now wait for all threads that are not already at a safepoint to check-in.
   {
     MonitorLocker sl(safepoint_lock_);
+    if (number_threads_not_at_safepoint_ == 0) {
+      return;
+    }
     intptr_t num_attempts = 0;
     while (number_threads_not_at_safepoint_ > 0) {
       Monitor::WaitResult retval = sl.Wait(1000);
@@ -118,6 +130,9 @@ void SafepointHandler::SafepointThreads(Thread* T) {
       }
     }
   }
+  // The time until the last thread checked in.
+  RecordTimeToSafepoint("SafepointThreads",
+                        OS::GetCurrentMonotonicMicros() - start);
 }
 
 void SafepointHandler::ResumeThreads(Thread* T) {
@@ -154,14 +169,43 @@ void SafepointHandler::ResumeThreads(Thread* T) {
   sl.NotifyAll();
 }
 
+int64_t SafepointHandler::CheckIn(Thread* T) {
+  ASSERT(T->thread_lock()->IsOwnedByCurrentThread());
+  MonitorLocker sl(safepoint_lock_);
+  ASSERT(number_threads_not_at_safepoint_ > 0);
+  number_threads_not_at_safepoint_ -= 1;
+  sl.Notify();
+  return OS::GetCurrentMonotonicMicros() - safepoint_request_micros_;
+}
+
+void SafepointHandler::RecordTimeToSafepoint(const char* label,
+                                             int64_t micros) {
+#if !defined(PRODUCT)
+  if (!FLAG_support_timeline) {
+    return;
+  }
+  TimelineStream* stream = Timeline::GetGCStream();
+  TimelineEvent* event = stream->StartEvent();
+  if (event != NULL) {
+    event->Counter(label);
+    event->SetNumArguments(1);
+    event->FormatArgument(0, "micros", "%" Pd64, micros);
+    event->Complete();
+  }
+#endif  // !defined(PRODUCT)
+}
+
 void SafepointHandler::EnterSafepointUsingLock(Thread* T) {
-  MonitorLocker tl(T->thread_lock());
-  T->SetAtSafepoint(true);
-  if (T->IsSafepointRequested()) {
-    MonitorLocker sl(safepoint_lock_);
-    ASSERT(number_threads_not_at_safepoint_ > 0);
-    number_threads_not_at_safepoint_ -= 1;
-    sl.Notify();
+  int64_t time_to_safepoint = -1;
+  {
+    MonitorLocker tl(T->thread_lock());
+    T->SetAtSafepoint(true);
+    if (T->IsSafepointRequested()) {
+      time_to_safepoint = CheckIn(T);
+    }
+  }
+  if (time_to_safepoint >= 0) {
+    RecordTimeToSafepoint("TimeToSafepoint", time_to_safepoint);
   }
 }
 
@@ -178,21 +222,22 @@ void SafepointHandler::ExitSafepointUsingLock(Thread* T) {
 
 void SafepointHandler::BlockForSafepoint(Thread* T) {
   ASSERT(!T->BypassSafepoints());
-  MonitorLocker tl(T->thread_lock());
-  if (T->IsSafepointRequested()) {
-    T->SetAtSafepoint(true);
-    {
-      MonitorLocker sl(safepoint_lock_);
-      ASSERT(number_threads_not_at_safepoint_ > 0);
-      number_threads_not_at_safepoint_ -= 1;
-      sl.Notify();
-    }
-    while (T->IsSafepointRequested()) {
-      T->SetBlockedForSafepoint(true);
-      tl.Wait();
-      T->SetBlockedForSafepoint(false);
+  int64_t time_to_safepoint = -1;
+  {
+    MonitorLocker tl(T->thread_lock());
+    if (T->IsSafepointRequested()) {
+      T->SetAtSafepoint(true);
+      time_to_safepoint = CheckIn(T);
+      while (T->IsSafepointRequested()) {
+        T->SetBlockedForSafepoint(true);
+        tl.Wait();
+        T->SetBlockedForSafepoint(false);
+      }
+      T->SetAtSafepoint(false);
     }
-    T->SetAtSafepoint(false);
+  }
+  if (time_to_safepoint >= 0) {
+    RecordTimeToSafepoint("TimeToSafepoint", time_to_safepoint);
   }
 }
 
@@ -38,6 +38,14 @@ class SafepointHandler {
   void SafepointThreads(Thread* T);
   void ResumeThreads(Thread* T);
 
+  // Called by T with its thread lock held when it checks in for a requested
+  // safepoint, returns the time elapsed since the request.
+  int64_t CheckIn(Thread* T);
+
+  // Emits a timeline counter with the time it took to reach a safepoint,
+  // for a single thread or for the whole operation.
+  void RecordTimeToSafepoint(const char* label, int64_t micros);
+
   Isolate* isolate() const { return isolate_; }
   Monitor* threads_lock() const { return isolate_->threads_lock(); }
   bool SafepointInProgress() const {
@@ -80,6 +88,10 @@ class SafepointHandler {
   Monitor* safepoint_lock_;
   int32_t number_threads_not_at_safepoint_;
 
+  // Time at which the current safepoint operation requested the threads to
+  // check in, protected by safepoint_lock_.
+  int64_t safepoint_request_micros_;
+
   // Count that indicates if a safepoint operation is currently in progress
   // and also tracks the number of recursive safepoint operations on the
   // same thread.
@@ -17,6 +17,8 @@
 #include "vm/object_id_ring.h"
 #include "vm/object_set.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
@@ -28,11 +30,25 @@ DEFINE_FLAG(int,
             66,
             "When more than this percentage of promotion candidates survive, "
             "promote all survivors of next scavenge.");
+DEFINE_FLAG(int,
+            survivor_aging_threshold,
+            25,
+            "When survivors occupy less than this percentage of new space, "
+            "keep survivors of one scavenge in new space for one more "
+            "scavenge before promoting them (0 disables).");
 DEFINE_FLAG(int,
             new_gen_garbage_threshold,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+#if !defined(PRODUCT)
+DEFINE_FLAG(int,
+            new_allocation_sample_bytes,
+            0,
+            "If positive, the profiler samples new space allocations at "
+            "random points, on average once per this many allocated bytes.");
+DECLARE_FLAG(bool, profiler);
+#endif  // !defined(PRODUCT)
 
 // Scavenger uses RawObject::kMarkBit to distinguish forwarded and non-forwarded
 // objects. The kMarkBit does not intersect with the target address because of
@@ -54,25 +70,137 @@ static inline uword ForwardedAddr(uword header) {
   return header & ~kForwardingMask;
 }
 
+// New-space objects are never card remembered, so the scavenger reuses that
+// tag bit to mark survivors that stay in new space for a second scavenge.
+// It is cleared again on promotion.
+enum {
+  kAgedBit = RawObject::kCardRememberedBit,
+  kAgedMask = 1 << kAgedBit,
+};
+
+static inline bool IsAged(uword header) {
+  return (header & kAgedMask) != 0;
+}
+
 static inline void ForwardTo(uword original, uword target) {
   // Make sure forwarding can be encoded.
   ASSERT((target & kForwardingMask) == 0);
   *reinterpret_cast<uword*>(original) = target | kForwarded;
 }
 
-class ScavengerVisitor : public ObjectPointerVisitor {
+// Formats [addr, addr + size) in the to space as a dead object, so that the
+// space stays walkable after a parallel scavenger task gives up part of its
+// copy buffer (cf. Object::MakeUnusedSpaceTraversable).
+static void MakeNewSpaceFiller(uword addr, intptr_t size) {
+  if (size == 0) {
+    return;
+  }
+  ASSERT(size >= kObjectAlignment);
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  ASSERT((addr & kNewObjectAlignmentOffset) == kNewObjectAlignmentOffset);
+  uint32_t tags = 0;
+  tags = RawObject::SizeTag::update(size, tags);
+  tags = RawObject::NewBit::update(true, tags);
+  if (size >= TypedData::InstanceSize(0)) {
+    tags = RawObject::ClassIdTag::update(kTypedDataInt8ArrayCid, tags);
+    const intptr_t length = size - TypedData::InstanceSize(0);
+    ASSERT(TypedData::InstanceSize(length) == size);
+    *reinterpret_cast<RawSmi**>(addr + TypedData::length_offset()) =
+        Smi::New(length);
+  } else {
+    ASSERT(size == Object::InstanceSize());
+    tags = RawObject::ClassIdTag::update(kInstanceCid, tags);
+  }
+  // Writing the whole header word also clears the hash, if any.
+  *reinterpret_cast<uword*>(addr + Object::tags_offset()) = tags;
+}
+
+// Work list of a parallel scavenger task: objects which have been copied (or
+// promoted) but whose slots have not been visited yet. Full blocks are shared
+// through a ScavengerStack, from which idle tasks take over work
+// (cf. MarkerWorkList). The serial scavenger has no stack and never uses its
+// work list.
+class ScavengerWorkList : public ValueObject {
  public:
-  explicit ScavengerVisitor(Isolate* isolate,
-                            Scavenger* scavenger,
-                            SemiSpace* from)
+  explicit ScavengerWorkList(ScavengerStack* stack)
+      : work_(NULL), stack_(stack), stolen_blocks_(0) {
+    if (stack_ != NULL) {
+      work_ = stack_->PopEmptyBlock();
+    }
+  }
+
+  ~ScavengerWorkList() { ASSERT(work_ == NULL); }
+
+  // Returns NULL if no more work was found.
+  RawObject* Pop() {
+    ASSERT(work_ != NULL);
+    if (work_->IsEmpty()) {
+      ScavengerStackBlock* new_work = stack_->PopNonEmptyBlock();
+      if (new_work == NULL) {
+        return NULL;
+      }
+      stack_->PushBlock(work_);
+      work_ = new_work;
+      stolen_blocks_++;
+    }
+    return work_->Pop();
+  }
+
+  void Push(RawObject* raw_obj) {
+    if (work_->IsFull()) {
+      stack_->PushBlock(work_);
+      work_ = stack_->PopEmptyBlock();
+    }
+    work_->Push(raw_obj);
+  }
+
+  void Finalize() {
+    ASSERT(work_->IsEmpty());
+    stack_->PushBlock(work_);
+    work_ = NULL;
+  }
+
+  intptr_t stolen_blocks() const { return stolen_blocks_; }
+
+ private:
+  ScavengerStackBlock* work_;
+  ScavengerStack* stack_;
+  intptr_t stolen_blocks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScavengerWorkList);
+};
+
+// The serial visitor (parallel == false) copies objects with the Cheney
+// algorithm: survivors are scanned linearly in the to space and promoted
+// objects are tracked with the promoted stack at the end of the to space.
+//
+// The parallel visitor (parallel == true) runs in several tasks at once.
+// Objects are claimed by installing the forwarding pointer with a
+// compare-and-swap, copied into task-local buffers carved from the to space
+// (or from old space when promoting) and pushed to a shared work list.
+template <bool parallel>
+class ScavengerVisitorBase : public ObjectPointerVisitor {
+ public:
+  ScavengerVisitorBase(Isolate* isolate,
+                       Scavenger* scavenger,
+                       SemiSpace* from,
+                       ScavengerStack* work_stack)
       : ObjectPointerVisitor(isolate),
         thread_(Thread::Current()),
         scavenger_(scavenger),
         from_(from),
         heap_(scavenger->heap_),
         page_space_(scavenger->heap_->old_space()),
+        work_list_(work_stack),
+        delayed_weak_properties_(NULL),
+        bytes_copied_(0),
         bytes_promoted_(0),
-        visiting_old_object_(NULL) {}
+        bytes_aged_(0),
+        visiting_old_object_(NULL),
+        copy_top_(0),
+        copy_end_(0),
+        promo_top_(0),
+        promo_end_(0) {}
 
   void VisitPointers(RawObject** first, RawObject** last) {
     ASSERT(Utils::IsAligned(first, sizeof(*first)));
@@ -92,9 +220,95 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     visiting_old_object_ = obj;
   }
 
+  intptr_t bytes_copied() const { return bytes_copied_; }
   intptr_t bytes_promoted() const { return bytes_promoted_; }
+  intptr_t bytes_aged() const { return bytes_aged_; }
+  intptr_t stolen_blocks() const { return work_list_.stolen_blocks(); }
+
+  // Parallel only: visit the slots of all objects on the work list, including
+  // work taken over from other tasks.
+  void ProcessWorkList() {
+    ASSERT(parallel);
+    RawObject* raw_obj = work_list_.Pop();
+    while (raw_obj != NULL) {
+      if (raw_obj->IsNewObject()) {
+        if (raw_obj->GetClassId() == kWeakPropertyCid) {
+          ProcessWeakProperty(reinterpret_cast<RawWeakProperty*>(raw_obj));
+        } else {
+          raw_obj->VisitPointersNonvirtual(this);
+        }
+      } else {
+        // Promoted objects are visited as old objects, so that any remaining
+        // new-space references are added to the store buffer. As in the serial
+        // visitor, promoted weak properties are treated strongly.
+        ASSERT(!raw_obj->IsRemembered());
+        VisitingOldObject(raw_obj);
+        raw_obj->VisitPointersNonvirtual(this);
+        if (raw_obj->IsMarked()) {
+          // Complete our promise from ScavengePointer.
+          thread_->MarkingStackAddObject(raw_obj);
+        }
+        VisitingOldObject(NULL);
+      }
+      raw_obj = work_list_.Pop();
+    }
+  }
+
+  // Parallel only: revisit weak properties whose keys have been copied since
+  // they were enqueued. Returns true if that produced more work.
+  bool ProcessPendingWeakProperties() {
+    ASSERT(parallel);
+    bool more_work = false;
+    RawWeakProperty* cur_weak = delayed_weak_properties_;
+    delayed_weak_properties_ = NULL;
+    while (cur_weak != NULL) {
+      uword next_weak = cur_weak->ptr()->next_;
+      cur_weak->ptr()->next_ = 0;
+      RawObject* raw_key = cur_weak->ptr()->key_;
+      ASSERT(raw_key->IsHeapObject());
+      ASSERT(raw_key->IsNewObject());
+      uword header = ReadHeader(RawObject::ToAddr(raw_key));
+      if (IsForwarding(header)) {
+        cur_weak->VisitPointersNonvirtual(this);
+        more_work = true;
+      } else {
+        EnqueueWeakProperty(cur_weak);
+      }
+      cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+    }
+    return more_work;
+  }
+
+  // Parallel only: called when all scavenging is complete. Gives back the
+  // unused parts of the copy buffers and returns the list of weak properties
+  // whose keys did not survive.
+  RawWeakProperty* Finalize() {
+    ASSERT(parallel);
+    work_list_.Finalize();
+    MakeNewSpaceFiller(copy_top_, copy_end_ - copy_top_);
+    copy_top_ = copy_end_ = 0;
+    page_space_->AbandonPromoBuffer(promo_top_, promo_end_ - promo_top_);
+    promo_top_ = promo_end_ = 0;
+    RawWeakProperty* result = delayed_weak_properties_;
+    delayed_weak_properties_ = NULL;
+    return result;
+  }
 
  private:
+  // Size of the buffers parallel tasks carve out of the to space and old space.
+  static const intptr_t kCopyBufferSize = 32 * KB;
+  static const intptr_t kPromoBufferSize = 32 * KB;
+  // Larger objects are allocated directly to bound the waste at the end of a
+  // buffer.
+  static const intptr_t kMaxBufferedObjectSize = 2 * KB;
+
+  static uword ReadHeader(uword raw_addr) {
+    if (parallel) {
+      return AtomicOperations::LoadRelaxed(reinterpret_cast<uword*>(raw_addr));
+    }
+    return *reinterpret_cast<uword*>(raw_addr);
+  }
+
   void UpdateStoreBuffer(RawObject** p, RawObject* obj) {
     ASSERT(obj->IsHeapObject());
     if (FLAG_verify_gc_contains) {
@@ -103,7 +317,14 @@ class ScavengerVisitor : public ObjectPointerVisitor {
       ASSERT(heap_->DataContains(ptr));
     }
     // If the newly written object is not a new object, drop it immediately.
-    if (!obj->IsNewObject() || visiting_old_object_->IsRemembered()) {
+    if (!obj->IsNewObject()) {
+      return;
+    }
+    if (visiting_old_object_->IsCardRemembered()) {
+      HeapPage::Of(visiting_old_object_)->RememberCard(p);
+      return;
+    }
+    if (visiting_old_object_->IsRemembered()) {
       return;
     }
     visiting_old_object_->SetRememberedBit();
@@ -124,26 +345,32 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     ASSERT(from_->Contains(raw_addr));
     // Read the header word of the object and determine if the object has
     // already been copied.
-    uword header = *reinterpret_cast<uword*>(raw_addr);
+    uword header = ReadHeader(raw_addr);
     uword new_addr = 0;
     if (IsForwarding(header)) {
       // Get the new location of the object.
       new_addr = ForwardedAddr(header);
+    } else if (parallel) {
+      new_addr = CopyParallel(raw_obj, header);
     } else {
       intptr_t size = raw_obj->Size();
       NOT_IN_PRODUCT(intptr_t cid = raw_obj->GetClassId());
       NOT_IN_PRODUCT(ClassTable* class_table = isolate()->class_table());
+      bool age = false;
       // Check whether object should be promoted.
       if (scavenger_->survivor_end_ <= raw_addr) {
         // Not a survivor of a previous scavenge. Just copy the object into the
         // to space.
         new_addr = scavenger_->AllocateGC(size);
         NOT_IN_PRODUCT(class_table->UpdateLiveNew(cid, size));
+      } else if (scavenger_->age_survivors_ && !IsAged(header)) {
+        // This object survived exactly one scavenge. Give it one more chance
+        // to die in new space before it is promoted.
+        age = true;
+        new_addr = scavenger_->AllocateGC(size);
+        bytes_aged_ += size;
+        NOT_IN_PRODUCT(class_table->UpdateLiveNew(cid, size));
       } else {
-        // TODO(iposva): Experiment with less aggressive promotion. For example
-        // a coin toss determines if an object is promoted or whether it should
-        // survive in this generation.
-        //
         // This object is a survivor of a previous scavenge. Attempt to promote
         // the object.
         new_addr =
@@ -170,19 +397,9 @@ class ScavengerVisitor : public ObjectPointerVisitor {
 
       RawObject* new_obj = RawObject::FromAddr(new_addr);
       if (new_obj->IsOldObject()) {
-        // Promoted: update age/barrier tags.
-        uint32_t tags = new_obj->ptr()->tags_;
-        tags = RawObject::OldBit::update(true, tags);
-        tags = RawObject::OldAndNotRememberedBit::update(true, tags);
-        tags = RawObject::NewBit::update(false, tags);
-        // Setting the forwarding pointer below will make this tenured object
-        // visible to the concurrent marker, but we haven't visited its slots
-        // yet. We mark the object here to prevent the concurrent marker from
-        // adding it to the mark stack and visiting its unprocessed slots. We
-        // push it to the mark stack after forwarding its slots.
-        tags =
-            RawObject::OldAndNotMarkedBit::update(!thread_->is_marking(), tags);
-        new_obj->ptr()->tags_ = tags;
+        UpdatePromotedTags(new_obj);
+      } else if (age) {
+        SetAged(new_obj);
       }
 
       // Remember forwarding address.
@@ -197,18 +414,200 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     }
   }
 
+  void SetAged(RawObject* new_obj) { new_obj->ptr()->tags_ |= kAgedMask; }
+
+  void UpdatePromotedTags(RawObject* new_obj) {
+    // Promoted: update age/barrier tags.
+    uint32_t tags = new_obj->ptr()->tags_;
+    tags = RawObject::OldBit::update(true, tags);
+    tags = RawObject::OldAndNotRememberedBit::update(true, tags);
+    tags = RawObject::NewBit::update(false, tags);
+    tags &= ~kAgedMask;
+    // Setting the forwarding pointer below will make this tenured object
+    // visible to the concurrent marker, but we haven't visited its slots
+    // yet. We mark the object here to prevent the concurrent marker from
+    // adding it to the mark stack and visiting its unprocessed slots. We
+    // push it to the mark stack after forwarding its slots.
+    tags = RawObject::OldAndNotMarkedBit::update(!thread_->is_marking(), tags);
+    new_obj->ptr()->tags_ = tags;
+  }
+
+  // Copies 'raw_obj', which had the given (non-forwarding) header, and races
+  // with other tasks to install the forwarding pointer. Returns the address of
+  // the winning copy.
+  uword CopyParallel(RawObject* raw_obj, uword header) {
+    uword raw_addr = RawObject::ToAddr(raw_obj);
+    // Another task may replace the header with a forwarding pointer at any
+    // time, so only trust the tags we read before attempting the copy.
+    uint32_t tags = static_cast<uint32_t>(header);
+    intptr_t size = raw_obj->Size(tags);
+    NOT_IN_PRODUCT(intptr_t cid = RawObject::ClassIdTag::decode(tags));
+    NOT_IN_PRODUCT(ClassTable* class_table = isolate()->class_table());
+
+    uword new_addr = 0;
+    bool age = false;
+    if (scavenger_->survivor_end_ <= raw_addr) {
+      new_addr = TryAllocateCopy(size);
+    } else if (scavenger_->age_survivors_ && !IsAged(header)) {
+      // Survived exactly one scavenge: keep it in new space once more.
+      new_addr = TryAllocateCopy(size);
+      age = (new_addr != 0);
+    }
+    if (new_addr == 0) {
+      // Either a survivor of a previous scavenge, or the to space is
+      // exhausted: promote.
+      new_addr = TryAllocatePromo(size);
+      if (new_addr == 0) {
+        // Unlike the serial scavenger, the to space may not have room left
+        // because of the space given up at the end of copy buffers.
+        scavenger_->failed_to_promote_ = true;
+        new_addr = TryAllocateCopy(size);
+        if (new_addr == 0) {
+          OUT_OF_MEMORY();
+        }
+      }
+    }
+
+    memmove(reinterpret_cast<void*>(new_addr),
+            reinterpret_cast<void*>(raw_addr), size);
+    RawObject* new_obj = RawObject::FromAddr(new_addr);
+    if (new_obj->IsOldObject()) {
+      UpdatePromotedTags(new_obj);
+    } else if (age) {
+      SetAged(new_obj);
+    }
+
+    // Make sure forwarding can be encoded.
+    ASSERT((new_addr & kForwardingMask) == 0);
+    uword old_header = AtomicOperations::CompareAndSwapWord(
+        reinterpret_cast<uword*>(raw_addr), header, new_addr | kForwarded);
+    if (old_header != header) {
+      // Another task copied the object first. Give back our copy.
+      ASSERT(IsForwarding(old_header));
+      if (new_obj->IsOldObject()) {
+        UndoAllocatePromo(new_addr, size);
+      } else {
+        UndoAllocateCopy(new_addr, size);
+      }
+      return ForwardedAddr(old_header);
+    }
+
+    if (new_obj->IsOldObject()) {
+      bytes_promoted_ += size;
+      NOT_IN_PRODUCT(class_table->UpdateAllocatedOld(cid, size));
+    } else {
+      bytes_copied_ += size;
+      if (age) {
+        bytes_aged_ += size;
+      }
+      NOT_IN_PRODUCT(class_table->UpdateLiveNew(cid, size));
+    }
+    work_list_.Push(new_obj);
+    return new_addr;
+  }
+
+  uword TryAllocateCopy(intptr_t size) {
+    uword result = copy_top_;
+    if (static_cast<intptr_t>(copy_end_ - result) >= size) {
+      copy_top_ += size;
+      return result;
+    }
+    if (size > kMaxBufferedObjectSize) {
+      return scavenger_->TryAllocateGCParallel(size);
+    }
+    MakeNewSpaceFiller(copy_top_, copy_end_ - copy_top_);
+    copy_top_ = copy_end_ = 0;
+    uword buffer = scavenger_->TryAllocateGCParallel(kCopyBufferSize);
+    if (buffer == 0) {
+      return scavenger_->TryAllocateGCParallel(size);
+    }
+    copy_top_ = buffer + size;
+    copy_end_ = buffer + kCopyBufferSize;
+    return buffer;
+  }
+
+  void UndoAllocateCopy(uword addr, intptr_t size) {
+    if (addr + size == copy_top_) {
+      copy_top_ = addr;
+    } else {
+      MakeNewSpaceFiller(addr, size);
+    }
+  }
+
+  uword TryAllocatePromo(intptr_t size) {
+    uword result = promo_top_;
+    if (static_cast<intptr_t>(promo_end_ - result) >= size) {
+      promo_top_ += size;
+      return result;
+    }
+    if (size > kMaxBufferedObjectSize) {
+      return page_space_->TryAllocatePromo(size, PageSpace::kForceGrowth);
+    }
+    page_space_->AbandonPromoBuffer(promo_top_, promo_end_ - promo_top_);
+    promo_top_ = promo_end_ = 0;
+    uword buffer = page_space_->TryAllocatePromo(kPromoBufferSize,
+                                                 PageSpace::kForceGrowth);
+    if (buffer == 0) {
+      return page_space_->TryAllocatePromo(size, PageSpace::kForceGrowth);
+    }
+    promo_top_ = buffer + size;
+    promo_end_ = buffer + kPromoBufferSize;
+    return buffer;
+  }
+
+  void UndoAllocatePromo(uword addr, intptr_t size) {
+    if (addr + size == promo_top_) {
+      promo_top_ = addr;
+    } else {
+      page_space_->AbandonPromoBuffer(addr, size);
+    }
+  }
+
+  void EnqueueWeakProperty(RawWeakProperty* raw_weak) {
+    ASSERT(parallel);
+    ASSERT(raw_weak->IsNewObject());
+    ASSERT(raw_weak->ptr()->next_ == 0);
+    raw_weak->ptr()->next_ = reinterpret_cast<uword>(delayed_weak_properties_);
+    delayed_weak_properties_ = raw_weak;
+  }
+
+  void ProcessWeakProperty(RawWeakProperty* raw_weak) {
+    ASSERT(parallel);
+    // The fate of the weak property is determined by its key.
+    RawObject* raw_key = raw_weak->ptr()->key_;
+    if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
+      uword header = ReadHeader(RawObject::ToAddr(raw_key));
+      if (!IsForwarding(header)) {
+        // Key is white.  Enqueue the weak property.
+        EnqueueWeakProperty(raw_weak);
+        return;
+      }
+    }
+    // Key is gray or black.  Make the weak property black.
+    raw_weak->VisitPointersNonvirtual(this);
+  }
+
   Thread* thread_;
   Scavenger* scavenger_;
   SemiSpace* from_;
   Heap* heap_;
   PageSpace* page_space_;
+  ScavengerWorkList work_list_;
   RawWeakProperty* delayed_weak_properties_;
+  intptr_t bytes_copied_;
   intptr_t bytes_promoted_;
+  intptr_t bytes_aged_;
   RawObject* visiting_old_object_;
 
+  // Parallel only: task-local copy and promotion buffers.
+  uword copy_top_;
+  uword copy_end_;
+  uword promo_top_;
+  uword promo_end_;
+
   friend class Scavenger;
 
-  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitor);
+  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitorBase);
 };
 
 class ScavengerWeakVisitor : public HandleVisitor {
@@ -269,8 +668,13 @@ class VerifyStoreBufferPointerVisitor : public ObjectPointerVisitor {
   DISALLOW_COPY_AND_ASSIGN(VerifyStoreBufferPointerVisitor);
 };
 
-SemiSpace::SemiSpace(VirtualMemory* reserved)
-    : reserved_(reserved), region_(NULL, 0) {
+SemiSpace::SemiSpace(VirtualMemory* reserved,
+                     intptr_t numa_node,
+                     bool huge_pages)
+    : reserved_(reserved),
+      region_(NULL, 0),
+      numa_node_(numa_node),
+      huge_pages_(huge_pages) {
   if (reserved != NULL) {
     region_ = MemoryRegion(reserved_->address(), reserved_->size());
   }
@@ -296,12 +700,17 @@ void SemiSpace::Cleanup() {
   cache_ = NULL;
 }
 
-SemiSpace* SemiSpace::New(intptr_t size_in_words, const char* name) {
+SemiSpace* SemiSpace::New(intptr_t size_in_words,
+                          const char* name,
+                          intptr_t numa_node) {
+  const bool huge_pages = FLAG_transparent_huge_pages;
   SemiSpace* result = nullptr;
   {
     MutexLocker locker(mutex_);
     // TODO(koda): Cache one entry per size.
-    if (cache_ != nullptr && cache_->size_in_words() == size_in_words) {
+    // Reusing the cached space also keeps its huge pages resident.
+    if (cache_ != nullptr && cache_->size_in_words() == size_in_words &&
+        cache_->numa_node_ == numa_node && cache_->huge_pages_ == huge_pages) {
       result = cache_;
       cache_ = nullptr;
     }
@@ -314,20 +723,29 @@ SemiSpace* SemiSpace::New(intptr_t size_in_words, const char* name) {
   }
 
   if (size_in_words == 0) {
-    return new SemiSpace(nullptr);
+    return new SemiSpace(nullptr, numa_node, huge_pages);
   } else {
     intptr_t size_in_bytes = size_in_words << kWordSizeLog2;
     const bool kExecutable = false;
     VirtualMemory* memory =
-        VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
+        huge_pages ? VirtualMemory::AllocateAligned(
+                         size_in_bytes, VirtualMemory::kHugePageSize,
+                         kExecutable, name)
+                   : VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
     if (memory == nullptr) {
       // TODO(koda): If cache_ is not empty, we could try to delete it.
       return nullptr;
     }
+    if (huge_pages) {
+      memory->AdviseHugePages();
+    }
+    if (numa_node != OSThread::kAnyNumaNode) {
+      memory->BindToNumaNode(numa_node);
+    }
 #if defined(DEBUG)
     memset(memory->address(), Heap::kZapByte, size_in_bytes);
 #endif  // defined(DEBUG)
-    return new SemiSpace(memory);
+    return new SemiSpace(memory, numa_node, huge_pages);
   }
 }
 
@@ -371,10 +789,18 @@ Scavenger::Scavenger(Heap* heap,
       delayed_weak_properties_(NULL),
       gc_time_micros_(0),
       collections_(0),
+      allocated_in_words_(0),
+      used_after_scavenge_in_words_(0),
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
       external_size_(0),
-      failed_to_promote_(false) {
+      failed_to_promote_(false),
+      next_weak_table_shard_(0),
+      sizing_reason_(kKeepSize),
+      shrink_requested_(false),
+      numa_node_(FLAG_numa_aware_heap ? OSThread::GetCurrentNumaNode()
+                                      : OSThread::kAnyNumaNode),
+      allocation_sample_pending_(false) {
   // Verify assumptions about the first word in objects which the scavenger is
   // going to use for forwarding pointers.
   ASSERT(Object::tags_offset() == 0);
@@ -386,7 +812,7 @@ Scavenger::Scavenger(Heap* heap,
   const intptr_t kVmNameSize = 128;
   char vm_name[kVmNameSize];
   Heap::RegionName(heap_, Heap::kNew, vm_name, kVmNameSize);
-  to_ = SemiSpace::New(initial_semi_capacity_in_words, vm_name);
+  to_ = SemiSpace::New(initial_semi_capacity_in_words, vm_name, numa_node_);
   if (to_ == NULL) {
     OUT_OF_MEMORY();
   }
@@ -396,6 +822,8 @@ Scavenger::Scavenger(Heap* heap,
   end_ = to_->end();
 
   survivor_end_ = FirstObjectStart();
+  age_survivors_ = false;
+  bytes_aged_ = 0;
   idle_scavenge_threshold_in_words_ = initial_semi_capacity_in_words;
 
   UpdateMaxHeapCapacity();
@@ -407,19 +835,113 @@ Scavenger::~Scavenger() {
   to_->Delete();
 }
 
-intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words) const {
+intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
+                                   intptr_t used_in_words) {
+  if (shrink_requested_) {
+    shrink_requested_ = false;
+    sizing_reason_ = kShrinkForIdle;
+    const intptr_t initial_size_in_words =
+        Utils::Minimum(max_semi_capacity_in_words_,
+                       FLAG_new_gen_semi_initial_size * MBInWords);
+    return Utils::Maximum(initial_size_in_words,
+                          Utils::RoundUp(used_in_words, kPageSizeInWords));
+  }
   if (stats_history_.Size() == 0) {
     return old_size_in_words;
   }
+  if ((FLAG_gc_target_max_pause > 0) || (FLAG_gc_target_overhead > 0)) {
+    return TargetedSizeInWords(old_size_in_words, used_in_words);
+  }
   double garbage = stats_history_.Get(0).ExpectedGarbageFraction();
   if (garbage < (FLAG_new_gen_garbage_threshold / 100.0)) {
+    sizing_reason_ = kGrowForGarbage;
     return Utils::Minimum(max_semi_capacity_in_words_,
                           old_size_in_words * FLAG_new_gen_growth_factor);
   } else {
+    sizing_reason_ = kKeepSize;
     return old_size_in_words;
   }
 }
 
+intptr_t Scavenger::TargetedSizeInWords(intptr_t old_size_in_words,
+                                        intptr_t used_in_words) {
+  const ScavengeStats& last = stats_history_.Get(0);
+  intptr_t new_size_in_words = old_size_in_words;
+  sizing_reason_ = kKeepSize;
+  if ((FLAG_gc_target_overhead > 0) &&
+      (OverheadPercent() > FLAG_gc_target_overhead)) {
+    // Fewer, larger scavenges: the survival rate drops as objects get more
+    // time to die, so the total copying work goes down.
+    new_size_in_words = old_size_in_words * FLAG_new_gen_growth_factor;
+    sizing_reason_ = kGrowForOverhead;
+  } else if (last.ExpectedGarbageFraction() <
+             (FLAG_new_gen_garbage_threshold / 100.0)) {
+    new_size_in_words = old_size_in_words * FLAG_new_gen_growth_factor;
+    sizing_reason_ = kGrowForGarbage;
+  }
+  new_size_in_words = Utils::Minimum(max_semi_capacity_in_words_,
+                                     new_size_in_words);
+
+  if ((FLAG_gc_target_max_pause > 0) && (last.DurationMicros() > 0)) {
+    // Assume the survival rate stays the same, so the pause scales with the
+    // size of the semispace that was scavenged.
+    const int64_t target_micros =
+        FLAG_gc_target_max_pause * kMicrosecondsPerMillisecond;
+    const intptr_t max_size_in_words = static_cast<intptr_t>(
+        old_size_in_words * (static_cast<double>(target_micros) /
+                             last.DurationMicros()));
+    while ((new_size_in_words > max_size_in_words) &&
+           (new_size_in_words > kPageSizeInWords)) {
+      new_size_in_words /= FLAG_new_gen_growth_factor;
+      sizing_reason_ = kShrinkForPause;
+    }
+  }
+
+  // The to-space must be able to hold everything currently in the from-space,
+  // since a scavenge always succeeds in copying all live objects.
+  return Utils::Maximum(new_size_in_words,
+                        Utils::RoundUp(used_in_words, kPageSizeInWords));
+}
+
+int Scavenger::OverheadPercent() const {
+  if (stats_history_.Size() < 2) {
+    return 0;
+  }
+  // The oldest entry only marks the start of the measured window.
+  int64_t gc_micros = 0;
+  for (intptr_t i = 0; i < stats_history_.Size() - 1; i++) {
+    gc_micros += stats_history_.Get(i).DurationMicros();
+  }
+  const int64_t total_micros =
+      stats_history_.Get(0).end_micros() -
+      stats_history_.Get(stats_history_.Size() - 1).end_micros();
+  if (total_micros <= 0) {
+    return 0;
+  }
+  return static_cast<int>(
+      (static_cast<double>(gc_micros) / static_cast<double>(total_micros)) *
+      100);
+}
+
+#ifndef PRODUCT
+static const char* SizingReasonToCString(Scavenger::SizingReason reason) {
+  switch (reason) {
+    case Scavenger::kKeepSize:
+      return "keep";
+    case Scavenger::kGrowForGarbage:
+      return "grow-for-garbage";
+    case Scavenger::kGrowForOverhead:
+      return "grow-for-overhead";
+    case Scavenger::kShrinkForPause:
+      return "shrink-for-pause";
+    case Scavenger::kShrinkForIdle:
+      return "shrink-for-idle";
+  }
+  UNREACHABLE();
+  return NULL;
+}
+#endif  // !PRODUCT
+
 SemiSpace* Scavenger::Prologue(Isolate* isolate) {
   NOT_IN_PRODUCT(isolate->class_table()->ResetCountersNew());
 
@@ -432,7 +954,8 @@ SemiSpace* Scavenger::Prologue(Isolate* isolate) {
   const intptr_t kVmNameSize = 128;
   char vm_name[kVmNameSize];
   Heap::RegionName(heap_, Heap::kNew, vm_name, kVmNameSize);
-  to_ = SemiSpace::New(NewSizeInWords(from->size_in_words()), vm_name);
+  to_ = SemiSpace::New(NewSizeInWords(from->size_in_words(), UsedInWords()),
+                       vm_name, numa_node_);
   if (to_ == NULL) {
     // TODO(koda): We could try to recover (collect old space, wait for another
     // isolate to finish scavenge, etc.).
@@ -463,6 +986,9 @@ void Scavenger::Epilogue(Isolate* isolate, SemiSpace* from) {
     Thread* thread = isolate->mutator_thread();
     thread->set_top(top_);
     thread->set_end(end_);
+#if !defined(PRODUCT)
+    SetAllocationSampleLimit(thread);
+#endif  // !defined(PRODUCT)
   }
 
   double avg_frac = stats_history_.Get(0).PromoCandidatesSuccessFraction();
@@ -474,10 +1000,16 @@ void Scavenger::Epilogue(Isolate* isolate, SemiSpace* from) {
   if (avg_frac < (FLAG_early_tenuring_threshold / 100.0)) {
     // Remember the limit to which objects have been copied.
     survivor_end_ = top_;
+    // Survivors that take little room are cheap to copy once more, and
+    // medium-lived objects then die in new space instead of bloating old
+    // space. Larger survivor volumes are promoted after a single scavenge.
+    age_survivors_ = stats_history_.Get(0).SurvivorFraction() <
+                     (FLAG_survivor_aging_threshold / 100.0);
   } else {
     // Move survivor end to the end of the to_ space, making all surviving
     // objects candidates for promotion next time.
     survivor_end_ = end_;
+    age_survivors_ = false;
   }
 
   // Update estimate of scavenger speed. This statistic assumes survivorship
@@ -557,7 +1089,7 @@ bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
 }
 
 void Scavenger::IterateStoreBuffers(Isolate* isolate,
-                                    ScavengerVisitor* visitor) {
+                                    SerialScavengerVisitor* visitor) {
   // Iterating through the store buffers.
   // Grab the deduplication sets out of the isolate's consolidated store buffer.
   StoreBufferBlock* pending = isolate->store_buffer()->Blocks();
@@ -573,6 +1105,12 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
       ASSERT(!raw_object->IsForwardingCorpse());
       ASSERT(raw_object->IsRemembered());
       raw_object->ClearRememberedBit();
+      if (raw_object->IsCardRemembered()) {
+        // Added by a store that does not know about cards; its slots are
+        // visited with the remembered cards.
+        HeapPage::Of(raw_object)->RememberAllCards();
+        continue;
+      }
       visitor->VisitingOldObject(raw_object);
       raw_object->VisitPointersNonvirtual(visitor);
     }
@@ -586,10 +1124,12 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
   heap_->RecordData(kDataUnused2, 0);
   // Done iterating through old objects remembered in the store buffers.
   visitor->VisitingOldObject(NULL);
+  heap_->old_space()->VisitRememberedCards(visitor);
 }
 
+template <class ScavengerVisitorType>
 void Scavenger::IterateObjectIdTable(Isolate* isolate,
-                                     ScavengerVisitor* visitor) {
+                                     ScavengerVisitorType* visitor) {
 #ifndef PRODUCT
   if (!FLAG_support_service) {
     return;
@@ -604,7 +1144,8 @@ void Scavenger::IterateObjectIdTable(Isolate* isolate,
 #endif  // !PRODUCT
 }
 
-void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
+void Scavenger::IterateRoots(Isolate* isolate,
+                             SerialScavengerVisitor* visitor) {
   NOT_IN_PRODUCT(Thread* thread = Thread::Current());
   int64_t start = OS::GetCurrentMonotonicMicros();
   {
@@ -647,10 +1188,13 @@ bool Scavenger::IsUnreachable(RawObject** p) {
 }
 
 void Scavenger::IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor) {
-  isolate->VisitWeakPersistentHandles(visitor);
+  // Handles to old objects are unaffected by a scavenge.
+  if (isolate->api_state() != NULL) {
+    isolate->api_state()->VisitNewSpaceWeakHandles(visitor);
+  }
 }
 
-void Scavenger::ProcessToSpace(ScavengerVisitor* visitor) {
+void Scavenger::ProcessToSpace(SerialScavengerVisitor* visitor) {
   Thread* thread = Thread::Current();
 
   // Iterate until all work has been drained.
@@ -765,7 +1309,7 @@ void Scavenger::EnqueueWeakProperty(RawWeakProperty* raw_weak) {
 }
 
 uword Scavenger::ProcessWeakProperty(RawWeakProperty* raw_weak,
-                                     ScavengerVisitor* visitor) {
+                                     SerialScavengerVisitor* visitor) {
   // The fate of the weak property is determined by its key.
   RawObject* raw_key = raw_weak->ptr()->key_;
   if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
@@ -781,11 +1325,51 @@ uword Scavenger::ProcessWeakProperty(RawWeakProperty* raw_weak,
   return raw_weak->VisitPointersNonvirtual(visitor);
 }
 
+void Scavenger::ForwardWeakTableShards() {
+  const uintptr_t num_shards = Heap::kNumWeakSelectors * WeakTable::kNumShards;
+  uintptr_t shard;
+  while ((shard = AtomicOperations::FetchAndIncrement(
+              &next_weak_table_shard_)) < num_shards) {
+    const intptr_t sel = shard / WeakTable::kNumShards;
+    const intptr_t shard_in_table = shard % WeakTable::kNumShards;
+    WeakTable* table =
+        heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
+    const intptr_t end = table->ShardStart(shard_in_table + 1);
+    intptr_t invalidated = 0;
+    for (intptr_t i = table->ShardStart(shard_in_table); i < end; i++) {
+      if (table->IsValidEntryAt(i)) {
+        RawObject* raw_obj = table->ObjectAt(i);
+        ASSERT(raw_obj->IsHeapObject());
+        uword raw_addr = RawObject::ToAddr(raw_obj);
+        uword header = *reinterpret_cast<uword*>(raw_addr);
+        if (IsForwarding(header)) {
+          // The object has survived.  Preserve its record.
+          table->ForwardObjectAt(i,
+                                 RawObject::FromAddr(ForwardedAddr(header)));
+        } else {
+          table->InvalidateAtUnsynchronized(i);
+          invalidated++;
+        }
+      }
+    }
+    if (invalidated > 0) {
+      table->AddInvalidated(invalidated);
+    }
+  }
+}
+
 void Scavenger::ProcessWeakReferences() {
-  // Rehash the weak tables now that we know which objects survive this cycle.
+  // With scavenger tasks, the shards have already been forwarded by the
+  // tasks. This only rebuilds the tables, since surviving keys may have been
+  // promoted and therefore belong to the old-space tables now.
+  {
+    TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardWeakTables");
+    ForwardWeakTableShards();
+  }
   for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
     WeakTable* table =
         heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
+    table->RemoveInvalidated();
     heap_->SetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel),
                         WeakTable::NewFrom(table));
     intptr_t size = table->size();
@@ -793,15 +1377,8 @@ void Scavenger::ProcessWeakReferences() {
       if (table->IsValidEntryAt(i)) {
         RawObject* raw_obj = table->ObjectAt(i);
         ASSERT(raw_obj->IsHeapObject());
-        uword raw_addr = RawObject::ToAddr(raw_obj);
-        uword header = *reinterpret_cast<uword*>(raw_addr);
-        if (IsForwarding(header)) {
-          // The object has survived.  Preserve its record.
-          uword new_addr = ForwardedAddr(header);
-          raw_obj = RawObject::FromAddr(new_addr);
-          heap_->SetWeakEntry(raw_obj, static_cast<Heap::WeakSelector>(sel),
-                              table->ValueAt(i));
-        }
+        heap_->SetWeakEntry(raw_obj, static_cast<Heap::WeakSelector>(sel),
+                            table->ValueAt(i));
       }
     }
     // Remove the old table as it has been replaced with the newly allocated
@@ -836,6 +1413,35 @@ void Scavenger::ProcessWeakReferences() {
   }
 }
 
+#if !defined(PRODUCT)
+void Scavenger::SetAllocationSampleLimit(Thread* thread) {
+  ASSERT(thread->end() == end_);
+  if (!FLAG_profiler || (FLAG_new_allocation_sample_bytes <= 0)) {
+    return;
+  }
+  // Exponentially distributed gaps make the sample points a Poisson process
+  // over the allocated bytes, so that every byte is equally likely to be
+  // sampled regardless of the allocation pattern.
+  const double uniform =
+      (allocation_sample_random_.NextUInt32() + 1.0) / 4294967296.0;
+  const double gap = -log(uniform) * FLAG_new_allocation_sample_bytes;
+  const uword top = thread->top();
+  if (gap < static_cast<double>(end_ - top)) {
+    thread->set_end(top + static_cast<uword>(gap));
+  }
+}
+
+uword Scavenger::TryAllocateAtSamplePoint(Thread* thread, intptr_t size) {
+  thread->set_end(end_);
+  uword result = TryAllocateInTLAB(thread, size);
+  if (result != 0) {
+    allocation_sample_pending_ = true;
+    SetAllocationSampleLimit(thread);
+  }
+  return result;
+}
+#endif  // !defined(PRODUCT)
+
 void Scavenger::FlushTLS() const {
   ASSERT(heap_ != NULL);
   if (heap_->isolate()->IsMutatorThreadScheduled()) {
@@ -890,6 +1496,292 @@ RawObject* Scavenger::FindObject(FindObjectVisitor* visitor) const {
   return Object::null();
 }
 
+class ParallelScavengerTask : public ThreadPool::Task {
+ public:
+  ParallelScavengerTask(Scavenger* scavenger,
+                        Isolate* isolate,
+                        SemiSpace* from,
+                        ScavengerStack* work_stack,
+                        ThreadBarrier* barrier,
+                        Mutex* lock,
+                        StoreBufferBlock** remembered_blocks,
+                        RawWeakProperty** delayed_weak_properties,
+                        intptr_t* bytes_promoted,
+                        ScavengeTaskStats* stats,
+                        intptr_t task_index,
+                        uintptr_t* num_busy)
+      : scavenger_(scavenger),
+        isolate_(isolate),
+        from_(from),
+        work_stack_(work_stack),
+        barrier_(barrier),
+        lock_(lock),
+        remembered_blocks_(remembered_blocks),
+        delayed_weak_properties_(delayed_weak_properties),
+        bytes_promoted_(bytes_promoted),
+        stats_(stats),
+        task_index_(task_index),
+        num_busy_(num_busy) {}
+
+  virtual void Run() {
+    bool result =
+        Thread::EnterIsolateAsHelper(isolate_, Thread::kScavengerTask, true);
+    ASSERT(result);
+    {
+      GCTaskNumaScope numa_scope(task_index_);
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ParallelScavengeTask");
+      int64_t start = OS::GetCurrentMonotonicMicros();
+      // The visitor must be created on this thread, as it appends to this
+      // thread's store buffer and marking stack blocks.
+      ParallelScavengerVisitor visitor(isolate_, scavenger_, from_,
+                                       work_stack_);
+
+      // Phase 1: Visit a slice of the roots and drain the work list.
+      IterateRoots(&visitor);
+
+      bool more_to_scavenge = false;
+      do {
+        do {
+          visitor.ProcessWorkList();
+
+          // I can't find more work right now. If no other task is busy,
+          // then there will never be more work (NB: 1 is *before* decrement).
+          if (AtomicOperations::FetchAndDecrement(num_busy_) == 1) break;
+
+          // Wait for some work to appear.
+          while (work_stack_->IsEmpty() &&
+                 AtomicOperations::LoadRelaxed(num_busy_) > 0) {
+          }
+
+          // If no tasks are busy, there will never be more work.
+          if (AtomicOperations::LoadRelaxed(num_busy_) == 0) break;
+
+          // I saw some work; get busy and compete for it.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        } while (true);
+        // Wait for all tasks to stop.
+        barrier_->Sync();
+#if defined(DEBUG)
+        ASSERT(AtomicOperations::LoadRelaxed(num_busy_) == 0);
+        // Caveat: must not allow any task to continue past the barrier
+        // before we checked num_busy, otherwise one of them might rush
+        // ahead and increment it.
+        barrier_->Sync();
+#endif
+        // Check if we have any pending weak properties whose keys have since
+        // been copied, possibly by another task.
+        more_to_scavenge = visitor.ProcessPendingWeakProperties();
+        if (more_to_scavenge) {
+          // We have more work to do. Notify others.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        }
+
+        // Wait for all other tasks to finish processing their pending weak
+        // properties and decide if they need to continue scavenging.
+        // Caveat: we need two barriers here to make this decision in lock step
+        // between all tasks and the main thread.
+        barrier_->Sync();
+        if (!more_to_scavenge &&
+            (AtomicOperations::LoadRelaxed(num_busy_) > 0)) {
+          // All tasks continue to scavenge as long as any single task has
+          // some work to do.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+          more_to_scavenge = true;
+        }
+        barrier_->Sync();
+      } while (more_to_scavenge);
+
+      // Phase 2: Forward the weak tables. Copying is done, so every
+      // surviving key has a forwarding address by now.
+      scavenger_->ForwardWeakTableShards();
+
+      // Phase 3: Give back unused buffers and report results.
+      RawWeakProperty* pending_weak = visitor.Finalize();
+      int64_t stop = OS::GetCurrentMonotonicMicros();
+      *stats_ = ScavengeTaskStats(
+          stop - start, visitor.bytes_copied() >> kWordSizeLog2,
+          visitor.bytes_promoted() >> kWordSizeLog2, visitor.stolen_blocks());
+      {
+        MutexLocker ml(lock_);
+        *bytes_promoted_ += visitor.bytes_promoted();
+        scavenger_->bytes_aged_ += visitor.bytes_aged();
+        while (pending_weak != NULL) {
+          RawWeakProperty* next_weak =
+              reinterpret_cast<RawWeakProperty*>(pending_weak->ptr()->next_);
+          pending_weak->ptr()->next_ =
+              reinterpret_cast<uword>(*delayed_weak_properties_);
+          *delayed_weak_properties_ = pending_weak;
+          pending_weak = next_weak;
+        }
+      }
+    }
+    Thread::ExitIsolateAsHelper(true);
+
+    // This task is done. Notify the original thread.
+    barrier_->Exit();
+  }
+
+ private:
+  void IterateRoots(ParallelScavengerVisitor* visitor) {
+    if (task_index_ == 0) {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRoots");
+      isolate_->VisitObjectPointers(visitor,
+                                    ValidationPolicy::kDontValidateFrames);
+      scavenger_->IterateObjectIdTable(isolate_, visitor);
+    }
+
+    // All tasks share the blocks of the remembered set.
+    TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRememberedSet");
+    while (true) {
+      StoreBufferBlock* block;
+      {
+        MutexLocker ml(lock_);
+        block = *remembered_blocks_;
+        if (block == NULL) {
+          break;
+        }
+        *remembered_blocks_ = block->next();
+      }
+      // Generated code appends to store buffers; tell MemorySanitizer.
+      MSAN_UNPOISON(block, sizeof(*block));
+      while (!block->IsEmpty()) {
+        RawObject* raw_object = block->Pop();
+        ASSERT(!raw_object->IsForwardingCorpse());
+        if (raw_object->IsCardRemembered()) {
+          // Moved to the card table by ParallelScavenge.
+          ASSERT(!raw_object->IsRemembered());
+          continue;
+        }
+        ASSERT(raw_object->IsRemembered());
+        raw_object->ClearRememberedBit();
+        visitor->VisitingOldObject(raw_object);
+        raw_object->VisitPointersNonvirtual(visitor);
+      }
+      block->Reset();
+      // Return the emptied block for recycling (no need to check threshold).
+      isolate_->store_buffer()->PushBlock(block, StoreBuffer::kIgnoreThreshold);
+    }
+    visitor->VisitingOldObject(NULL);
+
+    if (task_index_ == 0) {
+      // No other task visits card-remembered arrays or dirties their cards.
+      scavenger_->heap_->old_space()->VisitRememberedCards(visitor);
+    }
+  }
+
+  Scavenger* scavenger_;
+  Isolate* isolate_;
+  SemiSpace* from_;
+  ScavengerStack* work_stack_;
+  ThreadBarrier* barrier_;
+  Mutex* lock_;
+  StoreBufferBlock** remembered_blocks_;
+  RawWeakProperty** delayed_weak_properties_;
+  intptr_t* bytes_promoted_;
+  ScavengeTaskStats* stats_;
+  const intptr_t task_index_;
+  uintptr_t* num_busy_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavengerTask);
+};
+
+class CardRememberedVisitor : public ObjectPointerVisitor {
+ public:
+  explicit CardRememberedVisitor(Isolate* isolate)
+      : ObjectPointerVisitor(isolate) {}
+
+  void VisitPointers(RawObject** first, RawObject** last) {
+    for (RawObject** current = first; current <= last; current++) {
+      RawObject* raw_object = *current;
+      if (raw_object->IsCardRemembered()) {
+        ASSERT(raw_object->IsRemembered());
+        raw_object->ClearRememberedBit();
+        HeapPage::Of(raw_object)->RememberAllCards();
+      }
+    }
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CardRememberedVisitor);
+};
+
+intptr_t Scavenger::ParallelScavenge(Isolate* isolate,
+                                     SemiSpace* from,
+                                     intptr_t num_tasks,
+                                     ScavengeTaskStats* task_stats) {
+  ASSERT(num_tasks > 0);
+  // Grab the remembered set up front, so that tasks do not process the blocks
+  // they add to the store buffer while scavenging.
+  StoreBufferBlock* remembered_blocks = isolate->store_buffer()->Blocks();
+  // Card-remembered arrays must be visited only once, so those in the store
+  // buffer are moved to their card tables before the tasks start.
+  CardRememberedVisitor card_visitor(isolate);
+  intptr_t total_count = 0;
+  for (StoreBufferBlock* block = remembered_blocks; block != NULL;
+       block = block->next()) {
+    // Generated code appends to store buffers; tell MemorySanitizer.
+    MSAN_UNPOISON(block, sizeof(*block));
+    total_count += block->Count();
+    block->VisitObjectPointers(&card_visitor);
+  }
+  heap_->RecordData(kStoreBufferEntries, total_count);
+  heap_->RecordData(kDataUnused1, 0);
+  heap_->RecordData(kDataUnused2, 0);
+  heap_->RecordTime(kDummyScavengeTime, 0);
+  // Roots and remembered set are processed by the tasks, interleaved with
+  // copying.
+  heap_->RecordTime(kVisitIsolateRoots, 0);
+  heap_->RecordTime(kIterateStoreBuffers, 0);
+
+  ScavengerStack work_stack;
+  Mutex lock;
+  intptr_t bytes_promoted = 0;
+  RawWeakProperty* delayed_weak_properties = NULL;
+  {
+    ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
+                          heap_->barrier_done());
+    // Used to coordinate draining among tasks; all start out as 'busy'.
+    uintptr_t num_busy = num_tasks;
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      bool result = Dart::thread_pool()->Run(new ParallelScavengerTask(
+          this, isolate, from, &work_stack, &barrier, &lock,
+          &remembered_blocks, &delayed_weak_properties, &bytes_promoted,
+          &task_stats[i], i, &num_busy));
+      ASSERT(result);
+    }
+    bool more_to_scavenge = false;
+    do {
+      // Wait for all tasks to stop.
+      barrier.Sync();
+#if defined(DEBUG)
+      ASSERT(AtomicOperations::LoadRelaxed(&num_busy) == 0);
+      // Caveat: must not allow any task to continue past the barrier
+      // before we checked num_busy, otherwise one of them might rush
+      // ahead and increment it.
+      barrier.Sync();
+#endif
+      // Wait for all tasks to go through their weak properties and verify
+      // that there is no more work.
+      // Note: we need to have two barriers here because we want all tasks
+      // and main thread to make decisions in lock step.
+      barrier.Sync();
+      more_to_scavenge = AtomicOperations::LoadRelaxed(&num_busy) > 0;
+      barrier.Sync();
+    } while (more_to_scavenge);
+    ForwardWeakTableShards();
+    barrier.Exit();
+    // The barrier's destructor waits for all tasks to exit.
+  }
+  ASSERT(remembered_blocks == NULL);
+  heap_->RecordData(kToKBAfterStoreBuffer, RoundWordsToKB(UsedInWords()));
+
+  // The weak properties that are still pending have unreachable keys and are
+  // cleared by ProcessWeakReferences.
+  ASSERT(delayed_weak_properties_ == NULL);
+  delayed_weak_properties_ = delayed_weak_properties;
+  return bytes_promoted;
+}
+
 void Scavenger::Scavenge() {
   Isolate* isolate = heap_->isolate();
   // Ensure that all threads for this isolate are at a safepoint (either stopped
@@ -908,6 +1800,8 @@ void Scavenger::Scavenge() {
   scavenging_ = true;
 
   failed_to_promote_ = false;
+  next_weak_table_shard_ = 0;
+  bytes_aged_ = 0;
 
   PageSpace* page_space = heap_->old_space();
   NoSafepointScope no_safepoints;
@@ -925,6 +1819,8 @@ void Scavenger::Scavenge() {
   // Prepare for a scavenge.
   FlushTLS();
   SpaceUsage usage_before = GetCurrentUsage();
+  allocated_in_words_ +=
+      usage_before.used_in_words - used_after_scavenge_in_words_;
   intptr_t promo_candidate_words =
       (survivor_end_ - FirstObjectStart()) / kWordSize;
   SemiSpace* from = Prologue(isolate);
@@ -932,16 +1828,37 @@ void Scavenger::Scavenge() {
   // depend on zone allocations surviving beyond the epilogue callback.
   {
     StackZone zone(thread);
-    // Setup the visitor and run the scavenge.
-    ScavengerVisitor visitor(isolate, this, from);
-    page_space->AcquireDataLock();
-    IterateRoots(isolate, &visitor);
-    int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
-    {
-      TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessToSpace");
-      ProcessToSpace(&visitor);
+    const intptr_t num_tasks = FLAG_scavenger_tasks;
+    intptr_t bytes_promoted = 0;
+    ScavengeTaskStats* task_stats = NULL;
+    int64_t iterate_roots = 0;
+    int64_t process_to_space = 0;
+    if (num_tasks == 0) {
+      // Setup the visitor and run the scavenge.
+      SerialScavengerVisitor visitor(isolate, this, from, NULL);
+      page_space->AcquireDataLock();
+      IterateRoots(isolate, &visitor);
+      iterate_roots = OS::GetCurrentMonotonicMicros();
+      {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessToSpace");
+        ProcessToSpace(&visitor);
+      }
+      process_to_space = OS::GetCurrentMonotonicMicros();
+      bytes_promoted = visitor.bytes_promoted();
+      bytes_aged_ = visitor.bytes_aged();
+    } else {
+      iterate_roots = OS::GetCurrentMonotonicMicros();
+      task_stats = new ScavengeTaskStats[num_tasks];
+      {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelScavenge");
+        bytes_promoted =
+            ParallelScavenge(isolate, from, num_tasks, task_stats);
+      }
+      process_to_space = OS::GetCurrentMonotonicMicros();
+      // The tasks take the data lock for each promotion buffer; the remaining
+      // work on this thread uses it in bulk.
+      page_space->AcquireDataLock();
     }
-    int64_t process_to_space = OS::GetCurrentMonotonicMicros();
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakHandles");
       ScavengerWeakVisitor weak_visitor(thread, this);
@@ -954,11 +1871,18 @@ void Scavenger::Scavenge() {
     int64_t end = OS::GetCurrentMonotonicMicros();
     heap_->RecordTime(kProcessToSpace, process_to_space - iterate_roots);
     heap_->RecordTime(kIterateWeaks, end - process_to_space);
-    stats_history_.Add(ScavengeStats(
-        start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-        visitor.bytes_promoted() >> kWordSizeLog2));
+    ScavengeStats stats(start, end, usage_before, GetCurrentUsage(),
+                        promo_candidate_words,
+                        bytes_promoted >> kWordSizeLog2,
+                        bytes_aged_ >> kWordSizeLog2);
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      stats.AddTask(task_stats[i]);
+    }
+    delete[] task_stats;
+    stats_history_.Add(stats);
   }
   Epilogue(isolate, from);
+  used_after_scavenge_in_words_ = UsedInWords();
 
   // TODO(koda): Make verification more compatible with concurrent sweep.
   if (FLAG_verify_after_gc && !FLAG_concurrent_sweep) {
@@ -1004,6 +1928,23 @@ void Scavenger::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
+  {
+    JSONObject sizing(&space, "_sizing");
+    sizing.AddProperty("targetMaxPauseMillis",
+                       static_cast<intptr_t>(FLAG_gc_target_max_pause));
+    sizing.AddProperty("targetOverheadPercent",
+                       static_cast<intptr_t>(FLAG_gc_target_overhead));
+    sizing.AddProperty("overheadPercent",
+                       static_cast<intptr_t>(OverheadPercent()));
+    if (collections() > 0) {
+      sizing.AddProperty(
+          "lastPauseMillis",
+          MicrosecondsToMilliseconds(LastStats().DurationMicros()));
+    }
+    sizing.AddProperty64("maxCapacity",
+                         max_semi_capacity_in_words_ * kWordSize);
+    sizing.AddProperty("decision", SizingReasonToCString(sizing_reason_));
+  }
 }
 #endif  // !PRODUCT
 
@@ -1031,6 +1972,7 @@ void Scavenger::Evacuate() {
 
   // Forces the next scavenge to promote all the objects in the new space.
   survivor_end_ = top_;
+  age_survivors_ = false;
 
   if (heap_->isolate()->IsMutatorThreadScheduled()) {
     Thread* mutator_thread = heap_->isolate()->mutator_thread();
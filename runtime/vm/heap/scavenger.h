@@ -11,6 +11,7 @@
 #include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/heap/spaces.h"
+#include "vm/random.h"
 #include "vm/raw_object.h"
 #include "vm/ring_buffer.h"
 #include "vm/virtual_memory.h"
@@ -23,7 +24,10 @@ class Heap;
 class Isolate;
 class JSONObject;
 class ObjectSet;
-class ScavengerVisitor;
+template <bool parallel>
+class ScavengerVisitorBase;
+typedef ScavengerVisitorBase<false> SerialScavengerVisitor;
+typedef ScavengerVisitorBase<true> ParallelScavengerVisitor;
 
 // Wrapper around VirtualMemory that adds caching and handles the empty case.
 class SemiSpace {
@@ -34,8 +38,11 @@ class SemiSpace {
   // Get a space of the given size. Returns NULL on out of memory. If size is 0,
   // returns an empty space: pointer(), start() and end() all return NULL.
   // The name parameter may be NULL. If non-NULL it is ued to give the OS a name
-  // for the underlying virtual memory region.
-  static SemiSpace* New(intptr_t size_in_words, const char* name);
+  // for the underlying virtual memory region. Unless numa_node is
+  // OSThread::kAnyNumaNode, the space is placed on that node.
+  static SemiSpace* New(intptr_t size_in_words,
+                        const char* name,
+                        intptr_t numa_node);
 
   // Hand back an unused space.
   void Delete();
@@ -54,32 +61,73 @@ class SemiSpace {
   void WriteProtect(bool read_only);
 
  private:
-  explicit SemiSpace(VirtualMemory* reserved);
+  SemiSpace(VirtualMemory* reserved, intptr_t numa_node, bool huge_pages);
   ~SemiSpace();
 
   VirtualMemory* reserved_;  // NULL for an empty space.
   MemoryRegion region_;
+  intptr_t numa_node_;
+  bool huge_pages_;
 
   static SemiSpace* cache_;
   static Mutex* mutex_;
 };
 
+// Statistics for a single task of a parallel scavenge.
+class ScavengeTaskStats {
+ public:
+  ScavengeTaskStats()
+      : micros_(0),
+        copied_in_words_(0),
+        promoted_in_words_(0),
+        stolen_blocks_(0) {}
+  ScavengeTaskStats(int64_t micros,
+                    intptr_t copied_in_words,
+                    intptr_t promoted_in_words,
+                    intptr_t stolen_blocks)
+      : micros_(micros),
+        copied_in_words_(copied_in_words),
+        promoted_in_words_(promoted_in_words),
+        stolen_blocks_(stolen_blocks) {}
+
+  // Time this task spent scavenging, including waiting for other tasks.
+  int64_t micros() const { return micros_; }
+  // Words copied within new space by this task.
+  intptr_t copied_in_words() const { return copied_in_words_; }
+  // Words promoted to old space by this task.
+  intptr_t promoted_in_words() const { return promoted_in_words_; }
+  // Number of work blocks this task took from the shared work list.
+  intptr_t stolen_blocks() const { return stolen_blocks_; }
+
+ private:
+  int64_t micros_;
+  intptr_t copied_in_words_;
+  intptr_t promoted_in_words_;
+  intptr_t stolen_blocks_;
+};
+
 // Statistics for a particular scavenge.
 class ScavengeStats {
  public:
-  ScavengeStats() {}
+  // Per-task statistics are only recorded for this many tasks.
+  static const intptr_t kMaxRecordedTasks = 32;
+
+  ScavengeStats() : num_tasks_(0) {}
   ScavengeStats(int64_t start_micros,
                 int64_t end_micros,
                 SpaceUsage before,
                 SpaceUsage after,
                 intptr_t promo_candidates_in_words,
-                intptr_t promoted_in_words)
+                intptr_t promoted_in_words,
+                intptr_t aged_in_words)
       : start_micros_(start_micros),
         end_micros_(end_micros),
         before_(before),
         after_(after),
         promo_candidates_in_words_(promo_candidates_in_words),
-        promoted_in_words_(promoted_in_words) {}
+        promoted_in_words_(promoted_in_words),
+        aged_in_words_(aged_in_words),
+        num_tasks_(0) {}
 
   // Of all data before scavenge, what fraction was found to be garbage?
   // If this scavenge included growth, assume the extra capacity would become
@@ -89,19 +137,44 @@ class ScavengeStats {
     return 1.0 - (survived / static_cast<double>(after_.capacity_in_words));
   }
 
-  // Fraction of promotion candidates that survived and was thereby promoted.
+  // Fraction of promotion candidates that survived, and was either promoted
+  // or kept in new space for one more scavenge by survivor aging.
   // Returns zero if there were no promotion candidates.
   double PromoCandidatesSuccessFraction() const {
     return promo_candidates_in_words_ > 0
-               ? promoted_in_words_ /
+               ? (promoted_in_words_ + aged_in_words_) /
                      static_cast<double>(promo_candidates_in_words_)
                : 0.0;
   }
 
+  // Fraction of the capacity occupied by survivors after this scavenge.
+  double SurvivorFraction() const {
+    return after_.used_in_words /
+           static_cast<double>(after_.capacity_in_words);
+  }
+
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
 
+  int64_t end_micros() const { return end_micros_; }
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
 
+  // Number of parallel tasks that took part in this scavenge (0 if the
+  // scavenge ran on the main thread only).
+  intptr_t NumTasks() const { return num_tasks_; }
+  const ScavengeTaskStats& TaskAt(intptr_t index) const {
+    ASSERT((index >= 0) && (index < NumRecordedTasks()));
+    return tasks_[index];
+  }
+  intptr_t NumRecordedTasks() const {
+    return Utils::Minimum(num_tasks_, kMaxRecordedTasks);
+  }
+  void AddTask(const ScavengeTaskStats& task) {
+    if (num_tasks_ < kMaxRecordedTasks) {
+      tasks_[num_tasks_] = task;
+    }
+    num_tasks_++;
+  }
+
  private:
   int64_t start_micros_;
   int64_t end_micros_;
@@ -109,6 +182,9 @@ class ScavengeStats {
   SpaceUsage after_;
   intptr_t promo_candidates_in_words_;
   intptr_t promoted_in_words_;
+  intptr_t aged_in_words_;
+  intptr_t num_tasks_;
+  ScavengeTaskStats tasks_[kMaxRecordedTasks];
 };
 
 class Scavenger {
@@ -143,6 +219,29 @@ class Scavenger {
     return result;
   }
 
+  // Like AllocateGC, but may be called concurrently by parallel scavenger
+  // tasks, which carve their copy buffers out of the to space. Returns 0 if
+  // the to space is exhausted.
+  uword TryAllocateGCParallel(intptr_t size) {
+    ASSERT(Utils::IsAligned(size, kObjectAlignment));
+    ASSERT(scavenging_);
+    uword result = AtomicOperations::LoadRelaxed(&top_);
+    while (true) {
+      if (static_cast<intptr_t>(end_ - result) < size) {
+        return 0;
+      }
+      uword old_top =
+          AtomicOperations::CompareAndSwapWord(&top_, result, result + size);
+      if (old_top == result) {
+        break;
+      }
+      result = old_top;
+    }
+    ASSERT(to_->Contains(result));
+    ASSERT((result & kObjectAlignmentMask) == object_alignment_);
+    return result;
+  }
+
   uword TryAllocateInTLAB(Thread* thread, intptr_t size) {
     ASSERT(Utils::IsAligned(size, kObjectAlignment));
     ASSERT(heap_ != Dart::vm_isolate()->heap());
@@ -159,6 +258,11 @@ class Scavenger {
     uword result = top;
     intptr_t remaining = end - top;
     if (remaining < size) {
+#if !defined(PRODUCT)
+      if (end != end_) {
+        return TryAllocateAtSamplePoint(thread, size);
+      }
+#endif  // !defined(PRODUCT)
       return 0;
     }
     ASSERT(to_->Contains(result));
@@ -169,7 +273,8 @@ class Scavenger {
     return result;
   }
 
-  // Collect the garbage in this scavenger.
+  // Collect the garbage in this scavenger. Uses FLAG_scavenger_tasks parallel
+  // tasks if set, otherwise scavenges on the current thread.
   void Scavenge();
 
   // Promote all live objects.
@@ -206,6 +311,10 @@ class Scavenger {
 
   bool ShouldPerformIdleScavenge(int64_t deadline);
 
+  // Makes the next scavenge shrink the semispace back to its initial size, or
+  // to the size of the surviving objects if that is larger.
+  void RequestShrink() { shrink_requested_ = true; }
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
   int64_t gc_time_micros() const { return gc_time_micros_; }
@@ -214,6 +323,26 @@ class Scavenger {
 
   intptr_t collections() const { return collections_; }
 
+  // Words allocated in this space since it was created.
+  int64_t AllocatedInWords() const {
+    return allocated_in_words_ + UsedInWords() - used_after_scavenge_in_words_;
+  }
+
+  // Statistics of the most recent scavenge. Only valid if collections() > 0.
+  const ScavengeStats& LastStats() const { return stats_history_.Get(0); }
+
+  // Percentage of time spent scavenging over the recent history.
+  int OverheadPercent() const;
+
+  // Why the semispace was last resized, as reported through the service.
+  enum SizingReason {
+    kKeepSize,
+    kGrowForGarbage,
+    kGrowForOverhead,
+    kShrinkForPause,
+    kShrinkForIdle,
+  };
+
 #ifndef PRODUCT
   void PrintToJSONObject(JSONObject* object) const;
 #endif  // !PRODUCT
@@ -223,6 +352,21 @@ class Scavenger {
 
   void FlushTLS() const;
 
+#if !defined(PRODUCT)
+  // With --new_allocation_sample_bytes, lowers the mutator's allocation limit
+  // to a random point, so that the allocation crossing it leaves the inline
+  // fast path and can be sampled.
+  void SetAllocationSampleLimit(Thread* thread);
+
+  // Returns whether the last allocation reached the sample point, and resets
+  // it.
+  bool TakeAllocationSample() {
+    const bool result = allocation_sample_pending_;
+    allocation_sample_pending_ = false;
+    return result;
+  }
+#endif  // !defined(PRODUCT)
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -242,16 +386,21 @@ class Scavenger {
 
   uword FirstObjectStart() const { return to_->start() | object_alignment_; }
   SemiSpace* Prologue(Isolate* isolate);
-  void IterateStoreBuffers(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateObjectIdTable(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateRoots(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakProperties(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakReferences(Isolate* isolate, ScavengerVisitor* visitor);
+  void IterateStoreBuffers(Isolate* isolate, SerialScavengerVisitor* visitor);
+  template <class ScavengerVisitorType>
+  void IterateObjectIdTable(Isolate* isolate, ScavengerVisitorType* visitor);
+  void IterateRoots(Isolate* isolate, SerialScavengerVisitor* visitor);
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
-  void ProcessToSpace(ScavengerVisitor* visitor);
+  void ProcessToSpace(SerialScavengerVisitor* visitor);
   void EnqueueWeakProperty(RawWeakProperty* raw_weak);
   uword ProcessWeakProperty(RawWeakProperty* raw_weak,
-                            ScavengerVisitor* visitor);
+                            SerialScavengerVisitor* visitor);
+  // Copies all live objects using 'num_tasks' parallel tasks, recording their
+  // statistics in 'task_stats'. Returns the number of bytes promoted.
+  intptr_t ParallelScavenge(Isolate* isolate,
+                            SemiSpace* from,
+                            intptr_t num_tasks,
+                            ScavengeTaskStats* task_stats);
   void Epilogue(Isolate* isolate, SemiSpace* from);
 
   bool IsUnreachable(RawObject** p);
@@ -281,9 +430,22 @@ class Scavenger {
   void UpdateMaxHeapCapacity();
   void UpdateMaxHeapUsage();
 
+  // Called by the main thread and scavenger tasks once copying is done:
+  // forwards or clears the entries in unclaimed shards of the new-space weak
+  // tables.
+  void ForwardWeakTableShards();
   void ProcessWeakReferences();
 
-  intptr_t NewSizeInWords(intptr_t old_size_in_words) const;
+#if !defined(PRODUCT)
+  uword TryAllocateAtSamplePoint(Thread* thread, intptr_t size);
+#endif  // !defined(PRODUCT)
+
+  // Returns the size of the next to-space. It is never smaller than
+  // 'used_in_words', the amount of data in the space being scavenged.
+  intptr_t NewSizeInWords(intptr_t old_size_in_words, intptr_t used_in_words);
+  // Sizing used when --gc_target_max_pause or --gc_target_overhead is set.
+  intptr_t TargetedSizeInWords(intptr_t old_size_in_words,
+                               intptr_t used_in_words);
 
   uword top_;
   uword end_;
@@ -299,6 +461,12 @@ class Scavenger {
   // Objects below this address have survived a scavenge.
   uword survivor_end_;
 
+  // Whether survivors of a single scavenge are copied once more instead of
+  // being promoted. Objects kept this way carry kAgedBit and are promoted
+  // by the following scavenge.
+  bool age_survivors_;
+  intptr_t bytes_aged_;
+
   intptr_t max_semi_capacity_in_words_;
 
   // All object are aligned to this value.
@@ -312,6 +480,9 @@ class Scavenger {
 
   int64_t gc_time_micros_;
   intptr_t collections_;
+  // Words allocated before the last scavenge, and the words that survived it.
+  int64_t allocated_in_words_;
+  int64_t used_after_scavenge_in_words_;
   static const int kStatsHistoryCapacity = 4;
   RingBuffer<ScavengeStats, kStatsHistoryCapacity> stats_history_;
 
@@ -323,8 +494,24 @@ class Scavenger {
 
   bool failed_to_promote_;
 
-  friend class ScavengerVisitor;
+  // Next new-space weak table shard to forward, counting over all selectors.
+  uintptr_t next_weak_table_shard_;
+
+  SizingReason sizing_reason_;
+  bool shrink_requested_;
+
+  // The NUMA node of the isolate's mutator, which backs the semispaces with
+  // --numa_aware_heap.
+  intptr_t numa_node_;
+
+  // State of --new_allocation_sample_bytes.
+  Random allocation_sample_random_;
+  bool allocation_sample_pending_;
+
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class ScavengerWeakVisitor;
+  friend class ParallelScavengerTask;
 
   DISALLOW_COPY_AND_ASSIGN(Scavenger);
 };
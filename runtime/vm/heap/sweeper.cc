@@ -126,6 +126,8 @@ class SweeperTask : public ThreadPool::Task {
     {
       Thread* thread = Thread::Current();
       TIMELINE_FUNCTION_GC_DURATION(thread, "SweeperTask");
+      const int64_t start = OS::GetCurrentMonotonicMicros();
+      PageSpaceTaskStats stats(PageSpaceTaskStats::kSweeper);
       GCSweeper sweeper;
 
       HeapPage* page = first_;
@@ -136,10 +138,14 @@ class SweeperTask : public ThreadPool::Task {
         HeapPage* next_page = page->next();
         ASSERT(page->type() == HeapPage::kData);
         bool page_in_use = sweeper.SweepPage(page, freelist_, false);
+        stats.AddPage();
+        stats.AddFreed(page->object_end() - page->object_start() -
+                       page->used_in_bytes());
         if (page_in_use) {
           prev_page = page;
         } else {
           old_space_->FreePage(page, prev_page);
+          stats.AddFreedPage();
         }
         {
           // Notify the mutator thread that we have added elements to the free
@@ -150,6 +156,17 @@ class SweeperTask : public ThreadPool::Task {
         if (page == last_) break;
         page = next_page;
       }
+      stats.set_sweep_micros(OS::GetCurrentMonotonicMicros() - start);
+      old_space_->RecordTaskStats(stats);
+#if !defined(PRODUCT)
+      if (tds.enabled()) {
+        tds.SetNumArguments(3);
+        tds.FormatArgument(0, "pages", "%" Pd, stats.pages());
+        tds.FormatArgument(1, "freedPages", "%" Pd, stats.freed_pages());
+        tds.FormatArgument(2, "freed (kB)", "%" Pd,
+                           RoundWordsToKB(stats.freed_in_bytes() / kWordSize));
+      }
+#endif  // !defined(PRODUCT)
     }
     // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
     Thread::ExitIsolateAsHelper(true);
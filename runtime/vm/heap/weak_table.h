@@ -8,17 +8,18 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/raw_object.h"
 
 namespace dart {
 
 class WeakTable {
  public:
-  WeakTable() : size_(kMinSize), used_(0), count_(0) {
+  WeakTable() : size_(kMinSize), used_(0), count_(0), invalidated_(0) {
     ASSERT(Utils::IsPowerOfTwo(size_));
     data_ = reinterpret_cast<intptr_t*>(calloc(size_, kEntrySize * kWordSize));
   }
-  explicit WeakTable(intptr_t size) : used_(0), count_(0) {
+  explicit WeakTable(intptr_t size) : used_(0), count_(0), invalidated_(0) {
     ASSERT(size >= 0);
     ASSERT(Utils::IsPowerOfTwo(kMinSize));
     if (size < kMinSize) {
@@ -59,6 +60,44 @@ class WeakTable {
     SetValueAt(i, 0);
   }
 
+  // During GC the table is processed in this many shards of consecutive
+  // entries, which may be claimed by different tasks.
+  static const intptr_t kNumShards = 16;
+
+  // Index of the first entry of 'shard'. Shard 'kNumShards' marks the end of
+  // the table.
+  intptr_t ShardStart(intptr_t shard) const {
+    ASSERT((shard >= 0) && (shard <= kNumShards));
+    const intptr_t shard_size = (size_ + kNumShards - 1) / kNumShards;
+    return Utils::Minimum(size_, shard * shard_size);
+  }
+
+  // Like InvalidateAt, but may be called for entries in different shards at
+  // the same time. The count is not updated until the shard's task reports
+  // its invalidated entries with AddInvalidated and all shards are done.
+  void InvalidateAtUnsynchronized(intptr_t i) {
+    ASSERT(IsValidEntryAt(i));
+    data_[ObjectIndex(i)] = kDeletedEntry;
+    data_[ValueIndex(i)] = 0;
+  }
+
+  void AddInvalidated(intptr_t invalidated) {
+    AtomicOperations::IncrementBy(&invalidated_, invalidated);
+  }
+
+  // Applies the entries invalidated by AddInvalidated to the count.
+  void RemoveInvalidated() {
+    set_count(count() - invalidated_);
+    invalidated_ = 0;
+  }
+
+  // Replaces the key of a valid entry with its new location. The table must
+  // be rehashed or rebuilt before it is used for lookups again.
+  void ForwardObjectAt(intptr_t i, RawObject* key) {
+    ASSERT(IsValidEntryAt(i));
+    SetObjectAt(i, key);
+  }
+
   RawObject* ObjectAt(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
@@ -182,6 +221,8 @@ class WeakTable {
   intptr_t size_;
   intptr_t used_;
   intptr_t count_;
+  // Entries invalidated by GC tasks but not yet subtracted from count_.
+  intptr_t invalidated_;
 
   DISALLOW_COPY_AND_ASSIGN(WeakTable);
 };
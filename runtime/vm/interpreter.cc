@@ -31,6 +31,11 @@ DEFINE_FLAG(uint64_t,
             trace_interpreter_after,
             ULLONG_MAX,
             "Trace interpreter execution after instruction count reached.");
+DEFINE_FLAG(bool,
+            interpreter_pair_histogram,
+            false,
+            "Print the most frequently executed pairs of bytecodes when the "
+            "interpreter is destroyed (debug mode only).");
 
 #define LIKELY(cond) __builtin_expect((cond), 1)
 #define UNLIKELY(cond) __builtin_expect((cond), 0)
@@ -563,10 +568,27 @@ Interpreter::Interpreter()
 
   last_setjmp_buffer_ = NULL;
 
+  ClearLookupCache();
+
   DEBUG_ONLY(icount_ = 1);  // So that tracing after 0 traces first bytecode.
+
+#if defined(DEBUG)
+  pair_counts_ = NULL;
+  last_opcode_ = 0;
+  if (FLAG_interpreter_pair_histogram) {
+    pair_counts_ = new uint64_t[kBytecodePairCount];
+    memset(pair_counts_, 0, kBytecodePairCount * sizeof(uint64_t));
+  }
+#endif  // defined(DEBUG)
 }
 
 Interpreter::~Interpreter() {
+#if defined(DEBUG)
+  if (pair_counts_ != NULL) {
+    PrintBytecodePairHistogram();
+    delete[] pair_counts_;
+  }
+#endif  // defined(DEBUG)
   delete[] stack_;
 }
 
@@ -597,6 +619,42 @@ DART_NOINLINE void Interpreter::TraceInstruction(uint32_t* pc) const {
     THR_Print("Disassembler not supported in this mode.\n");
   }
 }
+
+DART_FORCE_INLINE void Interpreter::RecordBytecodePair(uint32_t op) {
+  const uint32_t opcode = op & 0xFF;
+  pair_counts_[(last_opcode_ << 8) | opcode]++;
+  last_opcode_ = opcode;
+}
+
+static int CompareBytecodePairCounts(const uint64_t* const* a,
+                                     const uint64_t* const* b) {
+  // Sort in descending order of counts.
+  if (**a < **b) return 1;
+  if (**a > **b) return -1;
+  return 0;
+}
+
+void Interpreter::PrintBytecodePairHistogram() const {
+  const intptr_t kMaxPrintedPairs = 50;
+  GrowableArray<const uint64_t*> pairs;
+  uint64_t total = 0;
+  for (intptr_t i = 0; i < kBytecodePairCount; i++) {
+    if (pair_counts_[i] != 0) {
+      pairs.Add(&pair_counts_[i]);
+      total += pair_counts_[i];
+    }
+  }
+  pairs.Sort(CompareBytecodePairCounts);
+  OS::PrintErr("Interpreter bytecode pair histogram (%" Pu64 " pairs):\n",
+               total);
+  for (intptr_t i = 0; (i < pairs.length()) && (i < kMaxPrintedPairs); i++) {
+    const intptr_t index = pairs[i] - pair_counts_;
+    const uint64_t count = *pairs[i];
+    OS::PrintErr("%12" Pu64 " %5.2f%% %s %s\n", count,
+                 100.0 * count / total, KernelBytecode::NameOf(index >> 8),
+                 KernelBytecode::NameOf(index & 0xFF));
+  }
+}
 #endif  // defined(DEBUG)
 
 // Calls into the Dart runtime are based on this interface.
@@ -1123,6 +1181,97 @@ void Interpreter::InlineCacheMiss(int checked_args,
               result, reinterpret_cast<uword>(handler));
 }
 
+void Interpreter::ClearLookupCache() {
+  for (intptr_t i = 0; i < kLookupCacheSize; i++) {
+    lookup_cache_[i].receiver_cid = NULL;
+    lookup_cache_[i].target_name = NULL;
+    lookup_cache_[i].args_descriptor = NULL;
+    lookup_cache_[i].target = NULL;
+  }
+  lookup_cache_table_ = NULL;
+}
+
+#define LOOKUP_CACHE_INDEX(cid, name, desc)                                    \
+  (((reinterpret_cast<uword>(cid) >> kSmiTagShift) ^                           \
+    (reinterpret_cast<uword>(name) >> kObjectAlignmentLog2) ^                  \
+    (reinterpret_cast<uword>(desc) >> kObjectAlignmentLog2)) &                 \
+   (kLookupCacheSize - 1))
+
+DART_FORCE_INLINE bool Interpreter::LookupMegamorphicTarget(
+    Thread* thread,
+    RawSmi* receiver_cid,
+    RawICData* icdata,
+    RawObject** target) {
+  if (lookup_cache_table_ !=
+      thread->isolate()->object_store()->megamorphic_cache_table()) {
+    return false;
+  }
+  RawString* target_name = icdata->ptr()->target_name_;
+  RawArray* args_descriptor = icdata->ptr()->args_descriptor_;
+  const LookupCacheEntry& entry = lookup_cache_[LOOKUP_CACHE_INDEX(
+      receiver_cid, target_name, args_descriptor)];
+  if ((entry.receiver_cid == receiver_cid) &&
+      (entry.target_name == target_name) &&
+      (entry.args_descriptor == args_descriptor)) {
+    *target = entry.target;
+    return true;
+  }
+  return false;
+}
+
+void Interpreter::InsertMegamorphicTarget(Thread* thread,
+                                          RawSmi* receiver_cid,
+                                          RawICData* icdata,
+                                          RawFunction* target) {
+  RawObject* table =
+      thread->isolate()->object_store()->megamorphic_cache_table();
+  if (lookup_cache_table_ != table) {
+    ClearLookupCache();
+    lookup_cache_table_ = table;
+  }
+  RawString* target_name = icdata->ptr()->target_name_;
+  RawArray* args_descriptor = icdata->ptr()->args_descriptor_;
+  LookupCacheEntry* entry = &lookup_cache_[LOOKUP_CACHE_INDEX(
+      receiver_cid, target_name, args_descriptor)];
+  entry->receiver_cid = receiver_cid;
+  entry->target_name = target_name;
+  entry->args_descriptor = args_descriptor;
+  entry->target = target;
+}
+
+#undef LOOKUP_CACHE_INDEX
+
+void Interpreter::MegamorphicCacheMiss(Thread* thread,
+                                       RawICData* icdata,
+                                       RawSmi* receiver_cid,
+                                       RawObject** receiver,
+                                       RawObject** top,
+                                       uint32_t* pc,
+                                       RawObject** FP,
+                                       RawObject** SP) {
+  RawObject** result = top;
+  top[0] = 0;  // Clean up result slot.
+  RawObject** miss_handler_args = top + 1;
+  miss_handler_args[0] = receiver[0];
+  miss_handler_args[1] = icdata;
+
+  // Handler arguments: receiver and an ICData object.
+  const intptr_t miss_handler_argc = 2;
+  RawObject** exit_frame = miss_handler_args + miss_handler_argc;
+  CallRuntime(thread, FP, exit_frame, pc, miss_handler_argc, miss_handler_args,
+              result,
+              reinterpret_cast<uword>(
+                  DRT_InterpretedMegamorphicCacheMissHandler));
+
+  // The runtime call may have moved the ICData, reload it from its argument
+  // slot.
+  if (result[0] != Object::null()) {
+    InsertMegamorphicTarget(
+        thread, receiver_cid, static_cast<RawICData*>(miss_handler_args[1]),
+        static_cast<RawFunction*>(result[0]));
+  }
+}
+
 DART_FORCE_INLINE bool Interpreter::InstanceCall1(Thread* thread,
                                                   RawICData* icdata,
                                                   RawObject** call_base,
@@ -1160,6 +1309,15 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall1(Thread* thread,
     if (!optimized) {
       InterpreterHelpers::IncrementICUsageCount(cache->data(), i, kCheckedArgs);
     }
+  } else if ((length / (kCheckedArgs + 2)) >
+             (FLAG_max_polymorphic_checks + 1)) {
+    // The call site is megamorphic. Stop growing its ICData, which is also
+    // the receiver type feedback of the JIT, and find the target in the
+    // MegamorphicCache of the selector instead.
+    if (!LookupMegamorphicTarget(thread, receiver_cid, icdata, top)) {
+      MegamorphicCacheMiss(thread, icdata, receiver_cid,
+                           call_base + receiver_idx, top, *pc, *FP, *SP);
+    }
   } else {
     InlineCacheMiss(kCheckedArgs, thread, icdata, call_base + receiver_idx, top,
                     *pc, *FP, *SP);
@@ -1243,6 +1401,9 @@ DART_FORCE_INLINE void Interpreter::PrepareForTailCall(
   if (IsTracingExecution()) {                                                  \
     TraceInstruction(pc - 1);                                                  \
   }                                                                            \
+  if (pair_counts_ != NULL) {                                                  \
+    RecordBytecodePair(op);                                                    \
+  }                                                                            \
   icount_++;
 #else
 #define TRACE_INSTRUCTION
@@ -1261,6 +1422,20 @@ DART_FORCE_INLINE void Interpreter::PrepareForTailCall(
 // Fetch next operation from PC, increment program counter and dispatch.
 #define DISPATCH() DISPATCH_OP(*pc++)
 
+// Dispatch after a bytecode pushing a value. Pushes are mostly followed by
+// more pushes, e.g. of call arguments, so a following Push of a local is
+// executed inline as part of the same superinstruction, saving the indirect
+// jump of its dispatch.
+#define DISPATCH_AFTER_PUSH()                                                  \
+  do {                                                                         \
+    if ((*pc & 0xFF) == KernelBytecode::kPush) {                               \
+      op = *pc++;                                                              \
+      TRACE_INSTRUCTION                                                        \
+      *++SP = FP[static_cast<int32_t>(op) >> KernelBytecode::kDShift];         \
+    }                                                                          \
+    DISPATCH();                                                                \
+  } while (0)
+
 // Load target of a jump instruction into PC.
 #define LOAD_JUMP_TARGET() pc += ((static_cast<int32_t>(op) >> 8) - 1)
 
@@ -2015,37 +2190,37 @@ RawObject* Interpreter::Call(RawFunction* function,
   {
     BYTECODE(PushConstant, __D);
     *++SP = LOAD_CONSTANT(rD);
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
     BYTECODE(PushNull, 0);
     *++SP = null_value;
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
     BYTECODE(PushTrue, 0);
     *++SP = true_value;
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
     BYTECODE(PushFalse, 0);
     *++SP = false_value;
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
     BYTECODE(PushInt, A_X);
     *++SP = Smi::New(rD);
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
     BYTECODE(Push, A_X);
     *++SP = FP[rD];
-    DISPATCH();
+    DISPATCH_AFTER_PUSH();
   }
 
   {
@@ -3040,6 +3215,8 @@ void Interpreter::JumpToFrame(uword pc, uword sp, uword fp, Thread* thread) {
 void Interpreter::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   visitor->VisitPointer(reinterpret_cast<RawObject**>(&pp_));
   visitor->VisitPointer(reinterpret_cast<RawObject**>(&argdesc_));
+  // The lookup cache is keyed by raw pointers, which may be moved.
+  ClearLookupCache();
 }
 
 }  // namespace dart
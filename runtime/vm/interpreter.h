@@ -24,6 +24,8 @@ class RawImmutableArray;
 class RawArray;
 class RawObjectPool;
 class RawFunction;
+class RawSmi;
+class RawString;
 class RawSubtypeTestCache;
 class ObjectPointerVisitor;
 
@@ -104,6 +106,15 @@ class Interpreter {
   RawObject** fp_;
   uword pc_;
   DEBUG_ONLY(uint64_t icount_;)
+#if defined(DEBUG)
+  static const intptr_t kBytecodePairCount = 256 * 256;
+
+  // Execution counts of pairs of consecutive bytecodes, indexed by
+  // (previous opcode << 8) | opcode. Only allocated when
+  // --interpreter_pair_histogram is enabled.
+  uint64_t* pair_counts_;
+  uint32_t last_opcode_;
+#endif  // defined(DEBUG)
 
   InterpreterSetjmpBuffer* last_setjmp_buffer_;
 
@@ -112,6 +123,30 @@ class Interpreter {
                        // call instruction and the function entry.
   RawObject* special_[KernelBytecode::kSpecialIndexCount];
 
+  // Cache of targets of megamorphic instance calls, filled from the shared
+  // MegamorphicCache of each selector. Entries are keyed by raw pointers,
+  // so the cache is cleared on GC. It is also cleared when the isolate's
+  // table of megamorphic caches changes, e.g. on reload.
+  struct LookupCacheEntry {
+    RawSmi* receiver_cid;
+    RawString* target_name;
+    RawArray* args_descriptor;
+    RawFunction* target;
+  };
+  static const intptr_t kLookupCacheSize = 256;
+  LookupCacheEntry lookup_cache_[kLookupCacheSize];
+  RawObject* lookup_cache_table_;
+
+  void ClearLookupCache();
+  bool LookupMegamorphicTarget(Thread* thread,
+                               RawSmi* receiver_cid,
+                               RawICData* icdata,
+                               RawObject** target);
+  void InsertMegamorphicTarget(Thread* thread,
+                               RawSmi* receiver_cid,
+                               RawICData* icdata,
+                               RawFunction* target);
+
   static IntrinsicHandler intrinsics_[kIntrinsicCount];
 
   void Exit(Thread* thread,
@@ -167,6 +202,15 @@ class Interpreter {
                        RawObject** FP,
                        RawObject** SP);
 
+  void MegamorphicCacheMiss(Thread* thread,
+                            RawICData* icdata,
+                            RawSmi* receiver_cid,
+                            RawObject** receiver,
+                            RawObject** top,
+                            uint32_t* pc,
+                            RawObject** FP,
+                            RawObject** SP);
+
   bool InstanceCall1(Thread* thread,
                      RawICData* icdata,
                      RawObject** call_base,
@@ -210,6 +254,12 @@ class Interpreter {
 
   // Prints bytecode instruction at given pc for instruction tracing.
   void TraceInstruction(uint32_t* pc) const;
+
+  // Counts the execution of op after the previously executed bytecode.
+  void RecordBytecodePair(uint32_t op);
+
+  // Prints the most frequently executed pairs of bytecodes.
+  void PrintBytecodePairHistogram() const;
 #endif  // defined(DEBUG)
 
   // Longjmp support for exceptions.
@@ -11,6 +11,7 @@
 #include "platform/text_buffer.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_observers.h"
+#include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_api_state.h"
@@ -894,8 +895,11 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       reload_context_(NULL),
       last_reload_timestamp_(OS::GetCurrentTimeMillis()),
       object_id_ring_(NULL),
+      compiler_pass_stats_(NULL),
 #endif  // !defined(PRODUCT)
       start_time_micros_(OS::GetCurrentMonotonicMicros()),
+      mutator_cpu_time_micros_(0),
+      mutator_cpu_start_micros_(0),
       thread_registry_(new ThreadRegistry()),
       safepoint_handler_(new SafepointHandler(this)),
       message_notify_callback_(NULL),
@@ -927,6 +931,7 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       defer_finalization_count_(0),
       pending_deopts_(new MallocGrowableArray<PendingLazyDeopt>()),
       deopt_context_(NULL),
+      deoptimization_log_(NULL),
       tag_table_(GrowableObjectArray::null()),
       deoptimized_code_array_(GrowableObjectArray::null()),
       sticky_error_(Error::null()),
@@ -959,6 +964,9 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
   }
 
   NOT_IN_PRECOMPILED(background_compiler_ = new BackgroundCompiler(this));
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  compiler_pass_stats_ = new CompilerPassStats();
+#endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 }
 
 #undef REUSABLE_HANDLE_SCOPE_INIT
@@ -982,6 +990,10 @@ Isolate::~Isolate() {
   object_id_ring_ = NULL;
   delete pause_loop_monitor_;
   pause_loop_monitor_ = NULL;
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  delete compiler_pass_stats_;
+  compiler_pass_stats_ = NULL;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
 #endif  // !defined(PRODUCT)
 
   free(name_);
@@ -1012,6 +1024,10 @@ Isolate::~Isolate() {
   delete message_handler_;
   message_handler_ = NULL;  // Fail fast if we send messages to a dead isolate.
   ASSERT(deopt_context_ == NULL);  // No deopt in progress when isolate deleted.
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  delete deoptimization_log_;
+  deoptimization_log_ = NULL;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
   delete spawn_state_;
   delete field_list_mutex_;
   field_list_mutex_ = NULL;
@@ -1191,6 +1207,16 @@ int64_t Isolate::UptimeMicros() const {
   return OS::GetCurrentMonotonicMicros() - start_time_micros_;
 }
 
+int64_t Isolate::MutatorCpuTimeMicros() const {
+  Thread* thread = Thread::Current();
+  if ((thread != NULL) && (thread == scheduled_mutator_thread_) &&
+      (thread->isolate() == this)) {
+    return mutator_cpu_time_micros_ +
+           (OS::GetCurrentThreadCPUMicros() - mutator_cpu_start_micros_);
+  }
+  return mutator_cpu_time_micros_;
+}
+
 bool Isolate::IsPaused() const {
 #if defined(PRODUCT)
   return false;
@@ -1802,7 +1828,9 @@ void Isolate::LowLevelShutdown() {
   }
 #endif  // !PRODUCT
 
-  // Finalize any weak persistent handles with a non-null referent.
+  // Run the finalizers deferred by earlier collections, then finalize any
+  // weak persistent handles with a non-null referent.
+  api_state()->finalization_queue()->Drain();
   FinalizeWeakPersistentHandlesVisitor visitor;
   api_state()->weak_persistent_handles().VisitHandles(&visitor);
 
@@ -1928,6 +1956,7 @@ void Isolate::Shutdown() {
 Dart_IsolateCreateCallback Isolate::create_callback_ = NULL;
 Dart_IsolateShutdownCallback Isolate::shutdown_callback_ = NULL;
 Dart_IsolateCleanupCallback Isolate::cleanup_callback_ = NULL;
+Dart_HeapGrowthCallback Isolate::heap_growth_callback_ = NULL;
 
 Monitor* Isolate::isolates_list_monitor_ = NULL;
 Isolate* Isolate::isolates_list_head_ = NULL;
@@ -2139,6 +2168,21 @@ void Isolate::PrintJSON(JSONStream* stream, bool ref) {
     heap()->PrintToJSONObject(Heap::kNew, &jsheap);
     heap()->PrintToJSONObject(Heap::kOld, &jsheap);
   }
+  {
+    JSONObject jsusage(&jsobj, "_resourceUsage");
+    jsusage.AddProperty64("cpuTimeMicros", MutatorCpuTimeMicros());
+    jsusage.AddProperty64(
+        "newAllocatedBytes",
+        heap()->AllocatedInWords(Heap::kNew) * kWordSize);
+    jsusage.AddProperty64(
+        "oldAllocatedBytes",
+        heap()->AllocatedInWords(Heap::kOld) * kWordSize);
+    jsusage.AddProperty64("gcTimeMicros",
+                          heap()->GCTimeInMicros(Heap::kNew) +
+                              heap()->GCTimeInMicros(Heap::kOld));
+    jsusage.AddProperty64("gcCount", heap()->Collections(Heap::kNew) +
+                                         heap()->Collections(Heap::kOld));
+  }
 
   jsobj.AddProperty("runnable", is_runnable());
   jsobj.AddProperty("livePorts", message_handler()->live_ports());
@@ -2807,6 +2851,11 @@ Thread* Isolate::ScheduleThread(bool is_mutator, bool bypass_safepoint) {
       if (this != Dart::vm_isolate()) {
         scheduled_mutator_thread_->set_top(heap()->new_space()->top());
         scheduled_mutator_thread_->set_end(heap()->new_space()->end());
+#if !defined(PRODUCT)
+        heap()->new_space()->SetAllocationSampleLimit(
+            scheduled_mutator_thread_);
+#endif  // !defined(PRODUCT)
+        mutator_cpu_start_micros_ = OS::GetCurrentThreadCPUMicros();
       }
     }
     Thread::SetCurrent(thread);
@@ -2847,8 +2896,11 @@ void Isolate::UnscheduleThread(Thread* thread,
   OSThread::SetCurrent(os_thread);
   if (is_mutator) {
     if (this != Dart::vm_isolate()) {
+      // The thread's end may be lowered to an allocation sample point. The
+      // new space's end is not changed by scheduling threads.
       heap()->new_space()->set_top(scheduled_mutator_thread_->top_);
-      heap()->new_space()->set_end(scheduled_mutator_thread_->end_);
+      mutator_cpu_time_micros_ +=
+          OS::GetCurrentThreadCPUMicros() - mutator_cpu_start_micros_;
     }
     scheduled_mutator_thread_->top_ = 0;
     scheduled_mutator_thread_->end_ = 0;
@@ -30,8 +30,10 @@ class ApiState;
 class BackgroundCompiler;
 class Capability;
 class CodeIndexTable;
+class CompilerPassStats;
 class Debugger;
 class DeoptContext;
+class DeoptimizationLog;
 class ExternalTypedData;
 class HandleScope;
 class HandleVisitor;
@@ -125,10 +127,20 @@ class NoReloadScope : public StackResource {
   DISALLOW_COPY_AND_ASSIGN(NoReloadScope);
 };
 
+// Exception handler found for a pc, with the try index needed to look up
+// the types it catches.
+struct CachedHandlerInfo {
+  intptr_t try_index;
+  ExceptionHandlerInfo info;
+};
+
 // Fixed cache for exception handler lookup.
-typedef FixedCache<intptr_t, ExceptionHandlerInfo, 16> HandlerInfoCache;
+typedef FixedCache<intptr_t, CachedHandlerInfo, 16> HandlerInfoCache;
 // Fixed cache for catch entry state lookup.
 typedef FixedCache<intptr_t, CatchEntryMovesRefPtr, 16> CatchEntryMovesCache;
+// Fixed cache for the token position of a pc, which otherwise needs a
+// sequential decoding of the code's pc descriptors. Sized for deep stacks.
+typedef FixedCache<intptr_t, TokenPosition, 64> TokenPositionCache;
 
 // List of Isolate flags with corresponding members of Dart_IsolateFlags and
 // corresponding global command line flags.
@@ -239,6 +251,12 @@ class Isolate : public BaseIsolate {
 
   int64_t UptimeMicros() const;
 
+  // CPU time spent by the threads that ran the mutator of this isolate. It is
+  // accounted for each time the mutator thread is unscheduled, e.g. after a
+  // batch of messages was handled, and includes the current run only when
+  // called on the mutator thread.
+  int64_t MutatorCpuTimeMicros() const;
+
   Dart_Port main_port() const { return main_port_; }
   void set_main_port(Dart_Port port) {
     ASSERT(main_port_ == 0);  // Only set main port once.
@@ -450,6 +468,13 @@ class Isolate : public BaseIsolate {
     return cleanup_callback_;
   }
 
+  static void SetHeapGrowthCallback(Dart_HeapGrowthCallback cb) {
+    heap_growth_callback_ = cb;
+  }
+  static Dart_HeapGrowthCallback HeapGrowthCallback() {
+    return heap_growth_callback_;
+  }
+
 #if !defined(PRODUCT)
   void set_object_id_ring(ObjectIdRing* ring) { object_id_ring_ = ring; }
   ObjectIdRing* object_id_ring() { return object_id_ring_; }
@@ -468,6 +493,13 @@ class Isolate : public BaseIsolate {
     deopt_context_ = value;
   }
 
+  // Created on the first deoptimization.
+  DeoptimizationLog* deoptimization_log() const { return deoptimization_log_; }
+  void set_deoptimization_log(DeoptimizationLog* value) {
+    ASSERT(deoptimization_log_ == NULL);
+    deoptimization_log_ = value;
+  }
+
   BackgroundCompiler* background_compiler() const {
     return background_compiler_;
   }
@@ -533,6 +565,11 @@ class Isolate : public BaseIsolate {
     last_reload_timestamp_ = value;
   }
   int64_t last_reload_timestamp() const { return last_reload_timestamp_; }
+
+  // Guarded by mutex().
+  CompilerPassStats* compiler_pass_stats() const {
+    return compiler_pass_stats_;
+  }
 #else
   bool IsReloading() const { return false; }
   bool HasAttemptedReload() const { return false; }
@@ -783,6 +820,7 @@ class Isolate : public BaseIsolate {
   CatchEntryMovesCache* catch_entry_moves_cache() {
     return &catch_entry_moves_cache_;
   }
+  TokenPositionCache* token_position_cache() { return &token_position_cache_; }
 
   void MaybeIncreaseReloadEveryNStackOverflowChecks();
 
@@ -951,10 +989,13 @@ class Isolate : public BaseIsolate {
   int64_t last_reload_timestamp_;
   // Ring buffer of objects assigned an id.
   ObjectIdRing* object_id_ring_;
+  CompilerPassStats* compiler_pass_stats_;
 #endif  // !defined(PRODUCT)
 
   // All other fields go here.
   int64_t start_time_micros_;
+  int64_t mutator_cpu_time_micros_;
+  int64_t mutator_cpu_start_micros_;
   ThreadRegistry* thread_registry_;
   SafepointHandler* safepoint_handler_;
   Dart_MessageNotifyCallback message_notify_callback_;
@@ -981,6 +1022,7 @@ class Isolate : public BaseIsolate {
   intptr_t defer_finalization_count_;
   MallocGrowableArray<PendingLazyDeopt>* pending_deopts_;
   DeoptContext* deopt_context_;
+  DeoptimizationLog* deoptimization_log_;
 
   RawGrowableObjectArray* tag_table_;
 
@@ -1015,6 +1057,7 @@ class Isolate : public BaseIsolate {
 
   HandlerInfoCache handler_info_cache_;
   CatchEntryMovesCache catch_entry_moves_cache_;
+  TokenPositionCache token_position_cache_;
 
   Dart_QualifiedFunctionName* embedder_entry_points_;
   const char** obfuscation_map_;
@@ -1022,6 +1065,7 @@ class Isolate : public BaseIsolate {
   static Dart_IsolateCreateCallback create_callback_;
   static Dart_IsolateShutdownCallback shutdown_callback_;
   static Dart_IsolateCleanupCallback cleanup_callback_;
+  static Dart_HeapGrowthCallback heap_growth_callback_;
 
 #if !defined(PRODUCT)
   static void WakePauseEventHandler(Dart_Isolate isolate);
@@ -1046,6 +1090,7 @@ class Isolate : public BaseIsolate {
   friend class GCMarker;  // VisitObjectPointers
   friend class SafepointHandler;
   friend class ObjectGraph;  // VisitObjectPointers
+  friend class ParallelScavengerTask;  // VisitObjectPointers
   friend class Scavenger;    // VisitObjectPointers
   friend class HeapIterationScope;  // VisitObjectPointers
   friend class ServiceIsolate;
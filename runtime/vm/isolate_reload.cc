@@ -2004,6 +2004,9 @@ void IsolateReloadContext::RunInvalidationVisitors() {
 void IsolateReloadContext::InvalidateWorld() {
   TIR_Print("---- INVALIDATING WORLD\n");
   ResetMegamorphicCaches();
+  // The classes cached for incoming messages may have been replaced.
+  object_store()->set_message_class_cache(Array::Handle());
+  object_store()->set_osr_code_cache(Array::Handle());
   if (FLAG_trace_deoptimization) {
     THR_Print("Deopt for reload\n");
   }
@@ -81,6 +81,20 @@ TEST_CASE(JSON_JSONStream_Primitives) {
   }
 }
 
+TEST_CASE(JSON_JSONStream_Integers) {
+  JSONStream js;
+  {
+    JSONArray jsarr(&js);
+    jsarr.AddValue(static_cast<intptr_t>(0));
+    jsarr.AddValue(static_cast<intptr_t>(-7));
+    jsarr.AddValue(static_cast<intptr_t>(1234567890));
+    jsarr.AddValue64(9007199254740991LL);
+    jsarr.AddValue64(-9007199254740991LL);
+  }
+  EXPECT_STREQ("[0,-7,1234567890,9007199254740991,-9007199254740991]",
+               js.ToCString());
+}
+
 TEST_CASE(JSON_JSONStream_Array) {
   JSONStream js;
   {
@@ -201,6 +215,15 @@ TEST_CASE(JSON_JSONStream_EscapedString) {
   EXPECT_STREQ("[\"Hel\\\"\\\"lo\\r\\n\\t\"]", js.ToCString());
 }
 
+TEST_CASE(JSON_JSONStream_EscapedStringRuns) {
+  JSONStream js;
+  {
+    JSONArray jsarr(&js);
+    jsarr.AddValue("a/b\\c\xC3\xA9" "d\x01");
+  }
+  EXPECT_STREQ("[\"a\\/b\\\\c\xC3\xA9" "d\\u0001\"]", js.ToCString());
+}
+
 TEST_CASE(JSON_JSONStream_DartString) {
   const char* kScriptChars =
       "var ascii = 'Hello, World!';\n"
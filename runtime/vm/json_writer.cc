@@ -96,24 +96,24 @@ void JSONWriter::CloseArray() {
 
 void JSONWriter::PrintValueNull() {
   PrintCommaIfNeeded();
-  buffer_.Printf("null");
+  buffer_.AddString("null");
 }
 
 void JSONWriter::PrintValueBool(bool b) {
   PrintCommaIfNeeded();
-  buffer_.Printf("%s", b ? "true" : "false");
+  buffer_.AddString(b ? "true" : "false");
 }
 
 void JSONWriter::PrintValue(intptr_t i) {
   EnsureIntegerIsRepresentableInJavaScript(static_cast<int64_t>(i));
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd "", i);
+  AddInteger(i);
 }
 
 void JSONWriter::PrintValue64(int64_t i) {
   EnsureIntegerIsRepresentableInJavaScript(i);
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd64 "", i);
+  AddInteger(i);
 }
 
 void JSONWriter::PrintValue(double d) {
@@ -334,6 +334,31 @@ void JSONWriter::AddEscapedUTF8String(const char* s) {
   AddEscapedUTF8String(s, len);
 }
 
+// Formats integers without going through printf, as profiles and source
+// reports are mostly made of them.
+void JSONWriter::AddInteger(int64_t i) {
+  // Enough for the 19 digits and sign of the most negative int64_t.
+  char digits[20];
+  char* start = &digits[sizeof(digits)];
+  uint64_t magnitude =
+      (i < 0) ? -static_cast<uint64_t>(i) : static_cast<uint64_t>(i);
+  do {
+    *--start = '0' + static_cast<char>(magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (i < 0) {
+    *--start = '-';
+  }
+  buffer_.AddRaw(reinterpret_cast<const uint8_t*>(start),
+                 &digits[sizeof(digits)] - start);
+}
+
+// Whether the ASCII character 'ch' is written unchanged in a JSON string.
+static bool IsUnescapedASCII(uint8_t ch) {
+  return (ch >= 0x20) && (ch < 0x80) && (ch != '"') && (ch != '\\') &&
+         (ch != '/');
+}
+
 void JSONWriter::AddEscapedUTF8String(const char* s, intptr_t len) {
   if (s == NULL) {
     return;
@@ -341,6 +366,16 @@ void JSONWriter::AddEscapedUTF8String(const char* s, intptr_t len) {
   const uint8_t* s8 = reinterpret_cast<const uint8_t*>(s);
   intptr_t i = 0;
   for (; i < len;) {
+    // Copy runs of characters that need no escaping at once.
+    intptr_t run_end = i;
+    while ((run_end < len) && IsUnescapedASCII(s8[run_end])) {
+      run_end++;
+    }
+    if (run_end > i) {
+      buffer_.AddRaw(&s8[i], run_end - i);
+      i = run_end;
+      continue;
+    }
     // Extract next UTF8 character.
     int32_t ch = 0;
     int32_t ch_len = Utf8::Decode(&s8[i], len - i, &ch);
@@ -366,7 +401,9 @@ bool JSONWriter::AddDartString(const String& s,
   intptr_t limit = offset + count;
   for (intptr_t i = offset; i < limit; i++) {
     uint16_t code_unit = s.CharAt(i);
-    if (Utf16::IsTrailSurrogate(code_unit)) {
+    if ((code_unit < 0x80) && IsUnescapedASCII(code_unit)) {
+      buffer_.AddChar(static_cast<char>(code_unit));
+    } else if (Utf16::IsTrailSurrogate(code_unit)) {
       buffer_.EscapeAndAddUTF16CodeUnit(code_unit);
     } else if (Utf16::IsLeadSurrogate(code_unit)) {
       if (i + 1 == limit) {
@@ -79,6 +79,7 @@ class JSONWriter : ValueObject {
 
  private:
   bool NeedComma();
+  void AddInteger(int64_t i);
   bool AddDartString(const String& s, intptr_t offset, intptr_t count);
 
   // Debug only fatal assertion.
@@ -254,6 +254,39 @@ static RawArray* AsSortedDuplicateFreeArray(GrowableArray<intptr_t>* source) {
   return array_object.raw();
 }
 
+class KernelSourceReader : public KernelReaderHelper {
+ public:
+  KernelSourceReader(Zone* zone,
+                     TranslationHelper* translation_helper,
+                     const Script& script,
+                     const ExternalTypedData& component)
+      : KernelReaderHelper(zone, translation_helper, script, component, 0) {}
+
+  RawString* ReadSource(intptr_t index) { return GetSourceFor(index).raw(); }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(KernelSourceReader);
+};
+
+RawString* GetSourceFor(const Script& script) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const KernelProgramInfo& info =
+      KernelProgramInfo::Handle(zone, script.kernel_program_info());
+  if (info.IsNull()) {
+    return String::null();
+  }
+  const ExternalTypedData& component =
+      ExternalTypedData::Handle(zone, info.kernel_component());
+  if (component.IsNull()) {
+    return String::null();
+  }
+  TranslationHelper helper(thread);
+  helper.InitFromKernelProgramInfo(info);
+  KernelSourceReader reader(zone, &helper, script, component);
+  return reader.ReadSource(script.kernel_script_index());
+}
+
 static void ProcessTokenPositionsEntry(
     const ExternalTypedData& kernel_data,
     const Script& script,
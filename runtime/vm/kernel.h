@@ -190,6 +190,10 @@ bool FieldHasFunctionLiteralInitializer(const Field& field,
 
 void CollectTokenPositionsFor(const Script& script);
 
+// Returns the source of the given kernel script, or null if the kernel
+// component it was loaded from is no longer available.
+RawString* GetSourceFor(const Script& script);
+
 RawObject* EvaluateMetadata(const Field& metadata_field,
                             bool is_annotations_offset);
 RawObject* BuildParameterDescriptor(const Function& function);
@@ -335,6 +335,10 @@ void KernelLoader::InitializeFields() {
       offsets, data, names, metadata_payloads, metadata_mappings,
       constants_table, scripts, libraries_cache, classes_cache);
 
+  // Script sources are read from the component when they are needed.
+  kernel_program_info_.set_kernel_component(ExternalTypedData::Handle(
+      Z, reader.ExternalDataFromTo(0, program_->kernel_data_size())));
+
   H.InitFromKernelProgramInfo(kernel_program_info_);
 
   Script& script = Script::Handle(Z);
@@ -406,6 +410,10 @@ const Array& KernelLoader::ReadConstantTable() {
 }
 
 void KernelLoader::EvaluateDelayedPragmas() {
+  // Top level members loaded on demand by other loaders may have added to the
+  // list since this loader last looked at it.
+  potential_pragma_functions_ =
+      kernel_program_info_.potential_pragma_functions();
   if (potential_pragma_functions_.IsNull()) return;
   Thread* thread = Thread::Current();
   NoOOBMessageScope no_msg_scope(thread);
@@ -861,7 +869,6 @@ RawLibrary* KernelLoader::LoadLibrary(intptr_t index) {
 
   LibraryIndex library_index(library_kernel_data_);
   intptr_t class_count = library_index.class_count();
-  intptr_t procedure_count = library_index.procedure_count();
 
   library_helper.ReadUntilIncluding(LibraryHelper::kName);
   library.SetName(H.DartSymbolObfuscate(library_helper.name_index_));
@@ -932,6 +939,35 @@ RawLibrary* KernelLoader::LoadLibrary(intptr_t index) {
   }
   helper_.SetOffset(next_class_offset);
 
+  // The top level members of libraries other than the core libraries can be
+  // loaded on first use. The kernel offset of the top level class marks
+  // them as not loaded yet.
+  if (FLAG_lazy_toplevel_loading && !FLAG_precompiled_mode &&
+      register_class && !loading_native_wrappers_library_ &&
+      !library.is_dart_scheme()) {
+    toplevel_class.set_kernel_offset(next_class_offset - correction_offset_);
+  } else {
+    FinishTopLevelClassLoading(library, toplevel_class, library_index);
+  }
+
+  if (FLAG_enable_mirrors && annotation_count > 0) {
+    ASSERT(annotations_kernel_offset > 0);
+    library.AddLibraryMetadata(toplevel_class, TokenPosition::kNoSource,
+                               annotations_kernel_offset);
+  }
+
+  if (register_class) {
+    classes.Add(toplevel_class, Heap::kOld);
+  }
+  if (!library.Loaded()) library.SetLoaded();
+
+  return library.raw();
+}
+
+void KernelLoader::FinishTopLevelClassLoading(
+    const Library& library,
+    const Class& toplevel_class,
+    const LibraryIndex& library_index) {
   fields_.Clear();
   functions_.Clear();
   ActiveClassScope active_class_scope(&active_class_, &toplevel_class);
@@ -993,27 +1029,19 @@ RawLibrary* KernelLoader::LoadLibrary(intptr_t index) {
   }
   toplevel_class.AddFields(fields_);
 
-  // Load toplevel procedures.
-  intptr_t next_procedure_offset = library_index.ProcedureOffset(0);
+  // Load toplevel procedures. Procedure offsets within a library index are
+  // whole program offsets, see FinishClassLoading.
+  const intptr_t correction = correction_offset_ - library_kernel_offset_;
+  const intptr_t procedure_count = library_index.procedure_count();
+  intptr_t next_procedure_offset =
+      library_index.ProcedureOffset(0) + correction;
   for (intptr_t i = 0; i < procedure_count; ++i) {
     helper_.SetOffset(next_procedure_offset);
-    next_procedure_offset = library_index.ProcedureOffset(i + 1);
+    next_procedure_offset = library_index.ProcedureOffset(i + 1) + correction;
     LoadProcedure(library, toplevel_class, false, next_procedure_offset);
   }
 
-  if (FLAG_enable_mirrors && annotation_count > 0) {
-    ASSERT(annotations_kernel_offset > 0);
-    library.AddLibraryMetadata(toplevel_class, TokenPosition::kNoSource,
-                               annotations_kernel_offset);
-  }
-
   toplevel_class.SetFunctions(Array::Handle(MakeFunctionsArray()));
-  if (register_class) {
-    classes.Add(toplevel_class, Heap::kOld);
-  }
-  if (!library.Loaded()) library.SetLoaded();
-
-  return library.raw();
 }
 
 void KernelLoader::LoadLibraryImportsAndExports(Library* library,
@@ -1510,6 +1538,19 @@ void KernelLoader::FinishLoading(const Class& klass) {
   KernelLoader kernel_loader(script, library_kernel_data,
                              library_kernel_offset);
   LibraryIndex library_index(library_kernel_data);
+
+  if (klass.IsTopLevel()) {
+    // Clear the marker first, so that lookups made while loading the members
+    // do not try to load them again.
+    klass.set_kernel_offset(0);
+    kernel_loader.helper_.SetOffset(class_offset);
+    kernel_loader.FinishTopLevelClassLoading(library, klass, library_index);
+    if (klass.is_finalized()) {
+      ClassFinalizer::ResolveAndFinalizeMemberTypes(klass);
+    }
+    return;
+  }
+
   ClassIndex class_index(
       library_kernel_data, class_offset,
       // Class offsets in library index are whole program offsets.
@@ -1786,12 +1827,13 @@ const Object& KernelLoader::ClassForScriptAt(const Class& klass,
 
 RawScript* KernelLoader::LoadScriptAt(intptr_t index) {
   const String& uri_string = helper_.SourceTableUriFor(index);
-  const String& script_source = helper_.GetSourceFor(index);
+  // The source itself is left null, and is decoded from the kernel component
+  // by Script::Source when it is needed.
   String& sources = String::Handle(Z);
   TypedData& line_starts =
       TypedData::Handle(Z, helper_.GetLineStartsFor(index));
-  if (script_source.raw() == Symbols::Empty().raw() &&
-      line_starts.Length() == 0 && uri_string.Length() > 0) {
+  if (helper_.GetSourceSizeFor(index) == 0 && line_starts.Length() == 0 &&
+      uri_string.Length() > 0) {
     // Entry included only to provide URI - actual source should already exist
     // in the VM, so try to find it.
     Library& lib = Library::Handle(Z);
@@ -1807,8 +1849,6 @@ RawScript* KernelLoader::LoadScriptAt(intptr_t index) {
         break;
       }
     }
-  } else {
-    sources = script_source.raw();
   }
 
   const Script& script = Script::Handle(
@@ -172,6 +172,9 @@ class KernelLoader : public ValueObject {
 
   RawLibrary* LoadLibrary(intptr_t index);
 
+  // Loads the members of a class, or the top level members of a library
+  // if klass is a top level class with a kernel offset, see
+  // --lazy_toplevel_loading.
   static void FinishLoading(const Class& klass);
 
   const Array& ReadConstantTable();
@@ -262,6 +265,12 @@ class KernelLoader : public ValueObject {
                           const ClassIndex& class_index,
                           ClassHelper* class_helper);
 
+  // Loads the top level fields and procedures of a library. The reader must
+  // be positioned at the list of top level fields.
+  void FinishTopLevelClassLoading(const Library& library,
+                                  const Class& toplevel_class,
+                                  const LibraryIndex& library_index);
+
   void LoadProcedure(const Library& library,
                      const Class& owner,
                      bool in_class,
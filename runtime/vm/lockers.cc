@@ -14,7 +14,9 @@ Monitor::WaitResult MonitorLocker::WaitWithSafepointCheck(Thread* thread,
   ASSERT(thread->execution_state() == Thread::kThreadInVM);
   thread->set_execution_state(Thread::kThreadInBlockedState);
   thread->EnterSafepoint();
+  thread->os_thread()->EnterBlockedWait();
   Monitor::WaitResult result = monitor_->Wait(millis);
+  thread->os_thread()->ExitBlockedWait();
   // First try a fast update of the thread state to indicate it is not at a
   // safepoint anymore.
   if (!thread->TryExitSafepoint()) {
@@ -73,7 +75,9 @@ Monitor::WaitResult SafepointMonitorLocker::Wait(int64_t millis) {
   if (thread != NULL) {
     thread->set_execution_state(Thread::kThreadInBlockedState);
     thread->EnterSafepoint();
+    thread->os_thread()->EnterBlockedWait();
     Monitor::WaitResult result = monitor_->Wait(millis);
+    thread->os_thread()->ExitBlockedWait();
     // First try a fast update of the thread state to indicate it is not at a
     // safepoint anymore.
     if (!thread->TryExitSafepoint()) {
@@ -23,7 +23,8 @@ Message::Message(Dart_Port dest_port,
       snapshot_(snapshot),
       snapshot_length_(snapshot_length),
       finalizable_data_(finalizable_data),
-      priority_(priority) {
+      priority_(priority),
+      post_timestamp_(0) {
   ASSERT((priority == kNormalPriority) ||
          (delivery_failure_port == kIllegalPort));
   ASSERT(!IsRaw());
@@ -39,7 +40,8 @@ Message::Message(Dart_Port dest_port,
       snapshot_(reinterpret_cast<uint8_t*>(raw_obj)),
       snapshot_length_(0),
       finalizable_data_(NULL),
-      priority_(priority) {
+      priority_(priority),
+      post_timestamp_(0) {
   ASSERT(!raw_obj->IsHeapObject() || raw_obj->IsVMHeapObject());
   ASSERT((priority == kNormalPriority) ||
          (delivery_failure_port == kIllegalPort));
@@ -85,6 +87,7 @@ const char* Message::PriorityAsString(Priority priority) {
 MessageQueue::MessageQueue() {
   head_ = NULL;
   tail_ = NULL;
+  length_ = 0;
 }
 
 MessageQueue::~MessageQueue() {
@@ -96,6 +99,7 @@ MessageQueue::~MessageQueue() {
 void MessageQueue::Enqueue(Message* msg, bool before_events) {
   // Make sure messages are not reused.
   ASSERT(msg->next_ == NULL);
+  length_++;
   if (head_ == NULL) {
     // Only element in the queue.
     ASSERT(tail_ == NULL);
@@ -137,6 +141,7 @@ void MessageQueue::Enqueue(Message* msg, bool before_events) {
 Message* MessageQueue::Dequeue() {
   Message* result = head_;
   if (result != NULL) {
+    length_--;
     head_ = result->next_;
     // The following update to tail_ is not strictly needed.
     if (head_ == NULL) {
@@ -150,10 +155,64 @@ Message* MessageQueue::Dequeue() {
   return NULL;
 }
 
+void MessageQueue::DequeueBatch(intptr_t max_count, MessageQueue* batch) {
+  ASSERT(batch->IsEmpty());
+  if ((head_ == NULL) || (max_count <= 0)) {
+    return;
+  }
+  Message* last = head_;
+  intptr_t count = 1;
+  while ((count < max_count) && (last->next_ != NULL)) {
+    last = last->next_;
+    count++;
+  }
+  batch->head_ = head_;
+  batch->tail_ = last;
+  batch->length_ = count;
+  head_ = last->next_;
+  last->next_ = NULL;
+  if (head_ == NULL) {
+    tail_ = NULL;
+  }
+  length_ -= count;
+}
+
+void MessageQueue::Prepend(MessageQueue* other) {
+  if (other->head_ == NULL) {
+    return;
+  }
+  Message* first = other->head_;
+  Message* last = other->tail_;
+  length_ += other->length_;
+  other->head_ = NULL;
+  other->tail_ = NULL;
+  other->length_ = 0;
+  if ((head_ == NULL) || (head_->dest_port() != Message::kIllegalPort)) {
+    last->next_ = head_;
+    head_ = first;
+    if (tail_ == NULL) {
+      tail_ = last;
+    }
+    return;
+  }
+  Message* cur = head_;
+  while ((cur->next_ != NULL) &&
+         (cur->next_->dest_port() == Message::kIllegalPort)) {
+    cur = cur->next_;
+  }
+  // Splice in the messages after the control messages.
+  last->next_ = cur->next_;
+  cur->next_ = first;
+  if (tail_ == cur) {
+    tail_ = last;
+  }
+}
+
 void MessageQueue::Clear() {
   Message* cur = head_;
   head_ = NULL;
   tail_ = NULL;
+  length_ = 0;
   while (cur != NULL) {
     Message* next = cur->next_;
     if (cur->RedirectToDeliveryFailurePort()) {
@@ -189,13 +248,7 @@ Message* MessageQueue::Iterator::Next() {
 }
 
 intptr_t MessageQueue::Length() const {
-  MessageQueue::Iterator it(this);
-  intptr_t length = 0;
-  while (it.HasNext()) {
-    it.Next();
-    length++;
-  }
-  return length;
+  return length_;
 }
 
 Message* MessageQueue::FindMessageById(intptr_t id) {
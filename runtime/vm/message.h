@@ -92,6 +92,11 @@ class Message {
 
   intptr_t Id() const;
 
+  // Time the message was posted, if the isolate timeline stream was enabled
+  // then, otherwise 0.
+  int64_t post_timestamp() const { return post_timestamp_; }
+  void set_post_timestamp(int64_t micros) { post_timestamp_ = micros; }
+
   static const char* PriorityAsString(Priority priority);
 
  private:
@@ -104,6 +109,7 @@ class Message {
   intptr_t snapshot_length_;
   MessageFinalizableData* finalizable_data_;
   Priority priority_;
+  int64_t post_timestamp_;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
@@ -120,6 +126,14 @@ class MessageQueue {
   // message is available.  This function will not block.
   Message* Dequeue();
 
+  // Moves up to max_count messages from the head of this queue to the empty
+  // queue batch.
+  void DequeueBatch(intptr_t max_count, MessageQueue* batch);
+
+  // Moves all messages of other in front of the messages in this queue, but
+  // behind any leading isolate library control messages.
+  void Prepend(MessageQueue* other);
+
   bool IsEmpty() { return head_ == NULL; }
 
   // Clear all messages from the message queue.
@@ -153,6 +167,7 @@ class MessageQueue {
  private:
   Message* head_;
   Message* tail_;
+  intptr_t length_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
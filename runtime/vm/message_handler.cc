@@ -11,11 +11,30 @@
 #include "vm/os.h"
 #include "vm/port.h"
 #include "vm/thread_interrupter.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+DEFINE_FLAG(int,
+            message_handler_threads,
+            0,
+            "If positive, message handlers running on the thread pool share "
+            "at most this many threads.");
+DEFINE_FLAG(int,
+            message_handler_quantum,
+            100,
+            "Maximum number of normal messages a message handler handles "
+            "before it yields its thread to the other message handlers, when "
+            "--message_handler_threads is set.");
+
+// Idle isolates run by the scheduler shrink their new space at most this
+// often, so that isolates which are idle between short bursts of messages do
+// not scavenge and regrow their new space on every burst.
+static const int64_t kShrinkNewSpaceIntervalMicros =
+    5 * kMicrosecondsPerSecond;
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
   explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
@@ -67,7 +86,9 @@ MessageHandler::MessageHandler()
       delete_me_(false),
       pool_(NULL),
       task_(NULL),
+      yielded_(false),
       idle_start_time_(0),
+      last_shrink_time_(0),
       start_callback_(NULL),
       end_callback_(NULL),
       callback_data_(0) {
@@ -117,43 +138,67 @@ void MessageHandler::Run(ThreadPool* pool,
   start_callback_ = start_callback;
   end_callback_ = end_callback;
   callback_data_ = data;
-  task_ = new MessageHandlerTask(this);
-  task_running = pool_->Run(task_);
+  task_running = StartTaskLocked();
   ASSERT(task_running);
 }
 
+bool MessageHandler::IsSchedulable() const {
+  Isolate* owner = isolate();
+  return (owner == NULL) || !Isolate::IsVMInternalIsolate(owner);
+}
+
+bool MessageHandler::StartTaskLocked() {
+  ASSERT(pool_ != NULL);
+  ASSERT(task_ == NULL);
+  task_ = new MessageHandlerTask(this);
+  if (MessageHandlerScheduler::enabled() && IsSchedulable()) {
+    return MessageHandlerScheduler::Run(pool_, task_);
+  }
+  return pool_->Run(task_);
+}
+
+void MessageHandler::EnqueueLocked(Message* message, bool before_events) {
+  // TODO(turnidge): Add assert that monitor_ is held here.
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
+    }
+  }
+#if !defined(PRODUCT)
+  if (FLAG_support_timeline && Timeline::GetIsolateStream()->enabled()) {
+    message->set_post_timestamp(OS::GetCurrentMonotonicMicros());
+  }
+#endif
+
+  if (message->IsOOB()) {
+    oob_queue_->Enqueue(message, before_events);
+  } else {
+    queue_->Enqueue(message, before_events);
+  }
+}
+
 void MessageHandler::PostMessage(Message* message, bool before_events) {
   Message::Priority saved_priority;
   bool task_running = true;
   {
     MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
-      }
-    }
-
     saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(message, before_events);
-    } else {
-      queue_->Enqueue(message, before_events);
-    }
+    EnqueueLocked(message, before_events);
     if (paused_for_messages_) {
       ml.Notify();
     }
@@ -161,8 +206,7 @@ void MessageHandler::PostMessage(Message* message, bool before_events) {
 
     if ((pool_ != NULL) && (task_ == NULL)) {
       ASSERT(!delete_me_);
-      task_ = new MessageHandlerTask(this);
-      task_running = pool_->Run(task_);
+      task_running = StartTaskLocked();
     }
   }
   ASSERT(task_running);
@@ -171,11 +215,34 @@ void MessageHandler::PostMessage(Message* message, bool before_events) {
   MessageNotify(saved_priority);
 }
 
+void MessageHandler::PostMessages(Message** messages, intptr_t count) {
+  bool task_running = true;
+  {
+    MonitorLocker ml(&monitor_);
+    for (intptr_t i = 0; i < count; i++) {
+      ASSERT(!messages[i]->IsOOB());
+      EnqueueLocked(messages[i], false);
+      messages[i] = NULL;  // Do not access message.  May have been deleted.
+    }
+    if (paused_for_messages_) {
+      ml.Notify();
+    }
+
+    if ((pool_ != NULL) && (task_ == NULL)) {
+      ASSERT(!delete_me_);
+      task_running = StartTaskLocked();
+    }
+  }
+  ASSERT(task_running);
+
+  // Invoke any custom message notification.
+  MessageNotify(Message::kNormalPriority);
+}
+
 void MessageHandler::EnsureTaskForIdleCheck() {
   MonitorLocker ml(&monitor_);
   if ((pool_ != NULL) && (task_ == NULL)) {
-    task_ = new MessageHandlerTask(this);
-    bool task_running = pool_->Run(task_);
+    bool task_running = StartTaskLocked();
     if (!task_running) {
       OS::PrintErr("Failed to start idle wakeup\n");
       delete task_;
@@ -197,52 +264,111 @@ void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
 
+#if !defined(PRODUCT)
+// Records the depth of the queue a message was taken from and how long the
+// message waited in it.
+static void RecordMessageDispatch(Message* message, intptr_t queue_depth) {
+  if (!FLAG_support_timeline || (message->post_timestamp() == 0)) {
+    return;
+  }
+  TimelineStream* stream = Timeline::GetIsolateStream();
+  TimelineEvent* event = stream->StartEvent();
+  if (event != NULL) {
+    int64_t now = OS::GetCurrentMonotonicMicros();
+    event->Counter("MessageQueue", now);
+    event->SetNumArguments(2);
+    event->FormatArgument(0, "depth", "%" Pd, queue_depth);
+    event->FormatArgument(1, "latencyMicros", "%" Pd64,
+                          now - message->post_timestamp());
+    event->Complete();
+  }
+}
+#endif  // !defined(PRODUCT)
+
 MessageHandler::MessageStatus MessageHandler::HandleMessages(
     MonitorLocker* ml,
     bool allow_normal_messages,
-    bool allow_multiple_normal_messages) {
+    bool allow_multiple_normal_messages,
+    bool yield_after_quantum) {
   // TODO(turnidge): Add assert that monitor_ is held here.
 
   // If isolate() returns NULL StartIsolateScope does nothing.
   StartIsolateScope start_isolate(isolate());
 
+  // Normal messages taken from queue_ together with the current message, which
+  // are handled before the monitor_ is reacquired.
+  MessageQueue batch;
+
+  // Under the scheduler a task handles at most a quantum of normal messages,
+  // after which it yields to the other message handlers.
+  intptr_t quantum = kMaxInt32;
+  if (yield_after_quantum && MessageHandlerScheduler::enabled() &&
+      (FLAG_message_handler_quantum > 0)) {
+    quantum = FLAG_message_handler_quantum;
+  }
+
   MessageStatus max_status = kOK;
   Message::Priority min_priority =
       ((allow_normal_messages && !paused()) ? Message::kNormalPriority
                                             : Message::kOOBPriority);
   Message* message = DequeueMessage(min_priority);
   while (message != NULL) {
-    intptr_t message_len = message->Size();
-    if (FLAG_trace_isolates) {
-      OS::PrintErr(
-          "[<] Handling message:\n"
-          "\tlen:        %" Pd
-          "\n"
-          "\thandler:    %s\n"
-          "\tport:       %" Pd64 "\n",
-          message_len, name(), message->dest_port());
+    if (!message->IsOOB() && allow_multiple_normal_messages &&
+        (FLAG_message_batch_size > 1) && (quantum > 1)) {
+      queue_->DequeueBatch(
+          Utils::Minimum<intptr_t>(FLAG_message_batch_size, quantum) - 1,
+          &batch);
     }
+#if !defined(PRODUCT)
+    MessageQueue* source = message->IsOOB() ? oob_queue_ : queue_;
+    RecordMessageDispatch(message, source->Length() + batch.Length());
+#endif
 
     // Release the monitor_ temporarily while we handle the message.
     // The monitor was acquired in MessageHandler::TaskCallback().
     ml->Exit();
     Message::Priority saved_priority = message->priority();
-    Dart_Port saved_dest_port = message->dest_port();
-    MessageStatus status = HandleMessage(message);
-    if (status > max_status) {
-      max_status = status;
+    MessageStatus status = kOK;
+    while (message != NULL) {
+      intptr_t message_len = message->Size();
+      if (FLAG_trace_isolates) {
+        OS::PrintErr(
+            "[<] Handling message:\n"
+            "\tlen:        %" Pd
+            "\n"
+            "\thandler:    %s\n"
+            "\tport:       %" Pd64 "\n",
+            message_len, name(), message->dest_port());
+      }
+      Dart_Port saved_dest_port = message->dest_port();
+      if (!message->IsOOB()) {
+        quantum--;
+      }
+      status = HandleMessage(message);
+      if (status > max_status) {
+        max_status = status;
+      }
+      message = NULL;  // May be deleted by now.
+      if (FLAG_trace_isolates) {
+        OS::PrintErr(
+            "[.] Message handled (%s):\n"
+            "\tlen:        %" Pd
+            "\n"
+            "\thandler:    %s\n"
+            "\tport:       %" Pd64 "\n",
+            MessageStatusString(status), message_len, name(),
+            saved_dest_port);
+      }
+      // Continue with the batch only while the next message could have been
+      // dequeued by the outer loop.
+      if ((max_status == kOK) && !paused()) {
+        message = batch.Dequeue();
+      }
     }
-    message = NULL;  // May be deleted by now.
     ml->Enter();
-    if (FLAG_trace_isolates) {
-      OS::PrintErr(
-          "[.] Message handled (%s):\n"
-          "\tlen:        %" Pd
-          "\n"
-          "\thandler:    %s\n"
-          "\tport:       %" Pd64 "\n",
-          MessageStatusString(status), message_len, name(), saved_dest_port);
-    }
+    // Return the messages of the batch that were not handled.
+    queue_->Prepend(&batch);
+
     // If we are shutting down, do not process any more messages.
     if (status == kShutdown) {
       ClearOOBQueue();
@@ -263,6 +389,12 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
       // We processed one normal message.  Allow no more.
       allow_normal_messages = false;
     }
+    if (allow_normal_messages && (quantum <= 0) && !queue_->IsEmpty()) {
+      // The quantum is used up. Leave the remaining normal messages to the
+      // next turn of this message handler.
+      allow_normal_messages = false;
+      yielded_ = true;
+    }
 
     // Reevaluate the minimum allowable priority.  The paused state
     // may have changed as part of handling the message.  We may also
@@ -374,6 +506,7 @@ void MessageHandler::TaskCallback() {
     // all pending OOB messages, or we may miss a request for vm
     // shutdown.
     MonitorLocker ml(&monitor_);
+    yielded_ = false;
 #if !defined(PRODUCT)
     if (ShouldPauseOnStart(kOK)) {
       if (!is_paused_on_start()) {
@@ -423,10 +556,10 @@ void MessageHandler::TaskCallback() {
 
         // Handle any pending messages for this message handler.
         if (status != kShutdown) {
-          status = HandleMessages(&ml, (status == kOK), true);
+          status = HandleMessages(&ml, (status == kOK), true, true);
         }
 
-        if (status == kOK) {
+        if ((status == kOK) && !yielded_) {
           handle_messages = CheckAndRunIdleLocked(&ml);
         }
       }
@@ -483,6 +616,12 @@ void MessageHandler::TaskCallback() {
     // for this message handler.
     ASSERT(oob_queue_->IsEmpty());
     task_ = NULL;
+    if (yielded_ && (pool_ != NULL)) {
+      // Take another turn after the message handlers waiting for a thread.
+      ASSERT(!delete_me_);
+      bool task_running = StartTaskLocked();
+      ASSERT(task_running);
+    }
   }
 
   // The handler may have been deleted by another thread here if it is a native
@@ -524,6 +663,13 @@ bool MessageHandler::CheckAndRunIdleLocked(MonitorLocker* ml) {
   {
     StartIsolateScope start_isolate(isolate());
     isolate()->NotifyIdle(deadline);
+    if (MessageHandlerScheduler::enabled() &&
+        (now - last_shrink_time_ >= kShrinkNewSpaceIntervalMicros)) {
+      // Many isolates may share the scheduler's threads, most of them idle
+      // at any time: give back the new space they grew while they were busy.
+      isolate()->heap()->ShrinkNewSpace();
+      last_shrink_time_ = now;
+    }
     idle_start_time_ = 0;
   }
   ml->Enter();
@@ -786,4 +932,75 @@ void IdleNotifier::Update(MessageHandler* handler, int64_t expirary) {
   }
 }
 
+Monitor* MessageHandlerScheduler::monitor_ = NULL;
+MessageHandlerScheduler::Entry* MessageHandlerScheduler::head_ = NULL;
+MessageHandlerScheduler::Entry* MessageHandlerScheduler::tail_ = NULL;
+intptr_t MessageHandlerScheduler::workers_ = 0;
+
+void MessageHandlerScheduler::Init() {
+  ASSERT(monitor_ == NULL);
+  monitor_ = new Monitor();
+}
+
+void MessageHandlerScheduler::Cleanup() {
+  ASSERT(head_ == NULL);
+  ASSERT(workers_ == 0);
+  ASSERT(monitor_ != NULL);
+  delete monitor_;
+  monitor_ = NULL;
+}
+
+bool MessageHandlerScheduler::enabled() {
+  return FLAG_message_handler_threads > 0;
+}
+
+class MessageHandlerScheduler::Worker : public ThreadPool::Task {
+ private:
+  void Run() {
+    MonitorLocker ml(monitor_);
+    while (head_ != NULL) {
+      Entry* entry = head_;
+      head_ = entry->next;
+      if (head_ == NULL) {
+        tail_ = NULL;
+      }
+      ThreadPool::Task* task = entry->task;
+      delete entry;
+      // The task may make other message handlers ready, or run again itself.
+      ml.Exit();
+      task->Run();
+      delete task;
+      ml.Enter();
+    }
+    workers_--;
+  }
+};
+
+bool MessageHandlerScheduler::Run(ThreadPool* pool, ThreadPool::Task* task) {
+  MonitorLocker ml(monitor_);
+  if (workers_ < FLAG_message_handler_threads) {
+    Worker* worker = new Worker();
+    if (pool->Run(worker)) {
+      workers_++;
+    } else if (workers_ == 0) {
+      delete worker;
+      return false;
+    } else {
+      // Leave the task to the running workers.
+      delete worker;
+    }
+  }
+
+  Entry* entry = new Entry;
+  entry->task = task;
+  entry->next = NULL;
+  if (tail_ == NULL) {
+    head_ = entry;
+  } else {
+    tail_->next = entry;
+  }
+  tail_ = entry;
+  return true;
+}
+
 }  // namespace dart
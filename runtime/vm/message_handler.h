@@ -165,11 +165,21 @@ class MessageHandler {
   // Return Isolate to which this message handler corresponds to.
   virtual Isolate* isolate() const { return NULL; }
 
+  // Returns false if other isolates may block waiting for this message
+  // handler, as they do for the kernel service. Such handlers always get a
+  // thread of their own, since queueing them on the scheduler behind the
+  // isolates waiting for them would deadlock.
+  virtual bool IsSchedulable() const;
+
   // Posts a message on this handler's message queue.
   // If before_events is true, then the message is enqueued before any pending
   // events, but after any pending isolate library events.
   void PostMessage(Message* message, bool before_events = false);
 
+  // Posts count normal priority messages on this handler's message queue,
+  // taking its lock only once.
+  void PostMessages(Message** messages, intptr_t count);
+
   // Notifies this handler that a port is being closed.
   void ClosePort(Dart_Port port);
 
@@ -220,16 +230,25 @@ class MessageHandler {
   void PausedOnStartLocked(MonitorLocker* ml, bool paused);
   void PausedOnExitLocked(MonitorLocker* ml, bool paused);
 
+  // Enqueues a posted message. Must be called with the monitor_ held.
+  void EnqueueLocked(Message* message, bool before_events);
+
   // Dequeue the next message.  Prefer messages from the oob_queue_ to
   // messages from the queue_.
   Message* DequeueMessage(Message::Priority min_priority);
 
   void ClearOOBQueue();
 
-  // Handles any pending messages.
+  // Handles any pending messages. If yield_after_quantum is true and the
+  // scheduler is enabled, stops handling normal messages after a quantum and
+  // sets yielded_.
   MessageStatus HandleMessages(MonitorLocker* ml,
                                bool allow_normal_messages,
-                               bool allow_multiple_normal_messages);
+                               bool allow_multiple_normal_messages,
+                               bool yield_after_quantum = false);
+
+  // Creates task_ and runs it on pool_, or on the scheduler if it is enabled.
+  bool StartTaskLocked();
 
   Monitor monitor_;  // Protects all fields in MessageHandler.
   MessageQueue* queue_;
@@ -250,7 +269,9 @@ class MessageHandler {
   bool delete_me_;
   ThreadPool* pool_;
   ThreadPool::Task* task_;
+  bool yielded_;  // The current task used up its quantum.
   int64_t idle_start_time_;
+  int64_t last_shrink_time_;
   StartCallback start_callback_;
   EndCallback end_callback_;
   CallbackData callback_data_;
@@ -280,6 +301,39 @@ class IdleNotifier : public AllStatic {
   static Timer* queue_;
 };
 
+// Multiplexes the tasks of message handlers over at most
+// --message_handler_threads threads of the thread pool, so that thousands of
+// mostly idle isolates do not need a thread each. Tasks run in the order they
+// became ready, and a task that handled --message_handler_quantum messages
+// goes to the back of the queue. The scheduling is cooperative: a message
+// handler blocked in a message keeps its thread until it returns. Handlers
+// that are not IsSchedulable(), e.g. the kernel and service isolates, bypass
+// the scheduler.
+class MessageHandlerScheduler : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  static bool enabled();
+
+  // Runs the task on one of the scheduler's threads, starting a thread on the
+  // pool if fewer than --message_handler_threads are running.
+  static bool Run(ThreadPool* pool, ThreadPool::Task* task);
+
+ private:
+  class Worker;
+
+  struct Entry {
+    ThreadPool::Task* task;
+    Entry* next;
+  };
+
+  static Monitor* monitor_;
+  static Entry* head_;
+  static Entry* tail_;
+  static intptr_t workers_;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_MESSAGE_HANDLER_H_
@@ -8,12 +8,19 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, message_batch_size);
+DECLARE_FLAG(int, message_handler_threads);
+DECLARE_FLAG(int, message_handler_quantum);
+
 class MessageHandlerTestPeer {
  public:
   explicit MessageHandlerTestPeer(MessageHandler* handler)
       : handler_(handler) {}
 
   void PostMessage(Message* message) { handler_->PostMessage(message); }
+  void PostMessages(Message** messages, intptr_t count) {
+    handler_->PostMessages(messages, count);
+  }
   void ClosePort(Dart_Port port) { handler_->ClosePort(port); }
   void CloseAllPorts() { handler_->CloseAllPorts(); }
 
@@ -399,4 +406,178 @@ VM_UNIT_TEST_CASE(MessageHandler_Run) {
   delete[] ports;
 }
 
+VM_UNIT_TEST_CASE(MessageHandler_RunBatches) {
+  SetFlagScope<int> sfs(&FLAG_message_batch_size, 4);
+  ThreadPool pool;
+  TestMessageHandler handler;
+  MessageHandlerTestPeer handler_peer(&handler);
+  int sleep = 0;
+  const int kMaxSleep = 20 * 1000;  // 20 seconds.
+
+  handler_peer.increment_live_ports();
+  const int kCount = 10;
+  Dart_Port ports[kCount];
+  Message* messages[kCount];
+  for (int i = 0; i < kCount; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    messages[i] = BlankMessage(ports[i], Message::kNormalPriority);
+  }
+  // Posting the messages together notifies the handler once.
+  handler_peer.PostMessages(messages, kCount);
+  EXPECT_EQ(1, handler.notify_count());
+  EXPECT_EQ(kCount, handler_peer.queue()->Length());
+
+  handler.Run(&pool, TestStartFunction, TestEndFunction,
+              reinterpret_cast<uword>(&handler));
+  while (sleep < kMaxSleep && handler.message_count() < kCount) {
+    OS::Sleep(10);
+    sleep += 10;
+  }
+  EXPECT_EQ(kCount, handler.message_count());
+  Dart_Port* handler_ports = handler.port_buffer();
+  for (int i = 0; i < kCount; i++) {
+    EXPECT_EQ(ports[i], handler_ports[i]);
+  }
+  handler_peer.decrement_live_ports();
+  EXPECT(!handler.HasLivePorts());
+}
+
+// Appends the ports of the messages it handles to a log shared with other
+// handlers, to check the order in which the scheduler runs them.
+class LoggingMessageHandler : public TestMessageHandler {
+ public:
+  LoggingMessageHandler(Dart_Port* log, intptr_t* log_length)
+      : log_(log), log_length_(log_length) {}
+
+  MessageStatus HandleMessage(Message* message) {
+    log_[(*log_length_)++] = message->dest_port();
+    return TestMessageHandler::HandleMessage(message);
+  }
+
+ private:
+  Dart_Port* log_;
+  intptr_t* log_length_;
+};
+
+static intptr_t scheduler_start_released = 0;
+
+// Keeps the only scheduler thread busy until the test released it.
+static MessageHandler::MessageStatus WaitingStartFunction(uword data) {
+  while (AtomicOperations::LoadRelaxed(&scheduler_start_released) == 0) {
+    OS::Sleep(1);
+  }
+  return TestStartFunction(data);
+}
+
+VM_UNIT_TEST_CASE(MessageHandler_RunScheduled) {
+  SetFlagScope<int> sfs(&FLAG_message_handler_threads, 1);
+  SetFlagScope<int> sfs2(&FLAG_message_handler_quantum, 2);
+  ThreadPool pool;
+  const int kCount = 6;
+  Dart_Port log[2 * kCount];
+  intptr_t log_length = 0;
+  LoggingMessageHandler handler1(log, &log_length);
+  LoggingMessageHandler handler2(log, &log_length);
+  MessageHandlerTestPeer handler1_peer(&handler1);
+  MessageHandlerTestPeer handler2_peer(&handler2);
+  int sleep = 0;
+  const int kMaxSleep = 20 * 1000;  // 20 seconds.
+
+  handler1_peer.increment_live_ports();
+  handler2_peer.increment_live_ports();
+  Dart_Port port1 = PortMap::CreatePort(&handler1);
+  Dart_Port port2 = PortMap::CreatePort(&handler2);
+  for (int i = 0; i < kCount; i++) {
+    handler1_peer.PostMessage(BlankMessage(port1, Message::kNormalPriority));
+    handler2_peer.PostMessage(BlankMessage(port2, Message::kNormalPriority));
+  }
+
+  // Both handlers are queued before the scheduler thread runs either.
+  scheduler_start_released = 0;
+  handler1.Run(&pool, WaitingStartFunction, TestEndFunction,
+               reinterpret_cast<uword>(&handler1));
+  handler2.Run(&pool, TestStartFunction, TestEndFunction,
+               reinterpret_cast<uword>(&handler2));
+  AtomicOperations::FetchAndIncrement(&scheduler_start_released);
+  while (sleep < kMaxSleep &&
+         (handler1.message_count() + handler2.message_count()) < 2 * kCount) {
+    OS::Sleep(10);
+    sleep += 10;
+  }
+  EXPECT_EQ(kCount, handler1.message_count());
+  EXPECT_EQ(kCount, handler2.message_count());
+
+  // The handlers take turns of two messages each.
+  EXPECT_EQ(2 * kCount, log_length);
+  for (intptr_t i = 0; i < log_length; i++) {
+    EXPECT_EQ(((i / 2) % 2 == 0) ? port1 : port2, log[i]);
+  }
+  handler1_peer.decrement_live_ports();
+  handler2_peer.decrement_live_ports();
+}
+
+// A message handler that blocks in its message until another handler,
+// standing in for the kernel service, has handled one.
+class WaitingMessageHandler : public TestMessageHandler {
+ public:
+  explicit WaitingMessageHandler(TestMessageHandler* other) : other_(other) {}
+
+  MessageStatus HandleMessage(Message* message) {
+    const int kMaxSleep = 20 * 1000;  // 20 seconds.
+    for (int sleep = 0; sleep < kMaxSleep && other_->message_count() == 0;
+         sleep += 10) {
+      OS::Sleep(10);
+    }
+    return TestMessageHandler::HandleMessage(message);
+  }
+
+ private:
+  TestMessageHandler* other_;
+};
+
+class UnschedulableMessageHandler : public TestMessageHandler {
+ protected:
+  bool IsSchedulable() const { return false; }
+};
+
+VM_UNIT_TEST_CASE(MessageHandler_RunUnschedulable) {
+  SetFlagScope<int> sfs(&FLAG_message_handler_threads, 1);
+  ThreadPool pool;
+  UnschedulableMessageHandler service;
+  WaitingMessageHandler client(&service);
+  MessageHandlerTestPeer service_peer(&service);
+  MessageHandlerTestPeer client_peer(&client);
+
+  service_peer.increment_live_ports();
+  client_peer.increment_live_ports();
+  Dart_Port service_port = PortMap::CreatePort(&service);
+  Dart_Port client_port = PortMap::CreatePort(&client);
+  client.Run(&pool, TestStartFunction, TestEndFunction,
+             reinterpret_cast<uword>(&client));
+  service.Run(&pool, TestStartFunction, TestEndFunction,
+              reinterpret_cast<uword>(&service));
+
+  // The client holds the only scheduler thread until the service handled
+  // its message, so the service must run on a thread of its own.
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  client_peer.PostMessage(
+      BlankMessage(client_port, Message::kNormalPriority));
+  OS::Sleep(10);
+  service_peer.PostMessage(
+      BlankMessage(service_port, Message::kNormalPriority));
+  int sleep = 0;
+  const int kMaxSleep = 20 * 1000;  // 20 seconds.
+  while (sleep < kMaxSleep && client.message_count() < 1) {
+    OS::Sleep(10);
+    sleep += 10;
+  }
+  EXPECT_EQ(1, service.message_count());
+  EXPECT_EQ(1, client.message_count());
+  // The client did not have to wait out its timeout.
+  EXPECT_LT(OS::GetCurrentMonotonicMicros() - start,
+            10 * kMicrosecondsPerSecond);
+  service_peer.decrement_live_ports();
+  client_peer.decrement_live_ports();
+}
+
 }  // namespace dart
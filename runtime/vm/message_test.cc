@@ -145,4 +145,60 @@ TEST_CASE(MessageQueue_Clear) {
   // msg1 and msg2 already delete by FlushAll.
 }
 
+TEST_CASE(MessageQueue_DequeueBatchAndPrepend) {
+  MessageQueue queue;
+  Message* msgs[5];
+  for (intptr_t i = 0; i < 5; i++) {
+    msgs[i] = new Message(i + 1, AllocMsg("msg"), 4, NULL,
+                          Message::kNormalPriority);
+    queue.Enqueue(msgs[i], false);
+  }
+
+  MessageQueue batch;
+  queue.DequeueBatch(3, &batch);
+  EXPECT_EQ(3, batch.Length());
+  EXPECT_EQ(2, queue.Length());
+  MessageQueue::Iterator it(&queue);
+  EXPECT(it.Next() == msgs[3]);
+  EXPECT(it.Next() == msgs[4]);
+  EXPECT(!it.HasNext());
+
+  // Handle one message of the batch and return the others. They go behind
+  // the isolate library control messages that arrived in the meantime.
+  delete batch.Dequeue();
+  Message* control = new Message(Message::kIllegalPort, AllocMsg("ctl"), 4,
+                                 NULL, Message::kNormalPriority);
+  queue.Enqueue(control, true);
+  queue.Prepend(&batch);
+  EXPECT(batch.IsEmpty());
+  EXPECT_EQ(0, batch.Length());
+  EXPECT_EQ(5, queue.Length());
+  it.Reset(&queue);
+  EXPECT(it.Next() == control);
+  EXPECT(it.Next() == msgs[1]);
+  EXPECT(it.Next() == msgs[2]);
+  EXPECT(it.Next() == msgs[3]);
+  EXPECT(it.Next() == msgs[4]);
+  EXPECT(!it.HasNext());
+
+  // A batch larger than the queue takes all messages.
+  queue.DequeueBatch(10, &batch);
+  EXPECT(queue.IsEmpty());
+  EXPECT_EQ(5, batch.Length());
+  Message* msg6 = new Message(6, AllocMsg("msg"), 4, NULL,
+                              Message::kNormalPriority);
+  queue.Enqueue(msg6, false);
+  queue.Prepend(&batch);
+  EXPECT_EQ(6, queue.Length());
+  it.Reset(&queue);
+  EXPECT(it.Next() == control);
+  EXPECT(it.Next() == msgs[1]);
+  it.Next();
+  it.Next();
+  EXPECT(it.Next() == msgs[4]);
+  EXPECT(it.Next() == msg6);
+  EXPECT(!it.HasNext());
+  queue.Clear();
+}
+
 }  // namespace dart
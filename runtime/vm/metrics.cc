@@ -6,12 +6,15 @@
 
 #include "vm/metrics.h"
 
+#include "platform/text_buffer.h"
+#include "vm/dart.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/runtime_entry.h"
+#include "vm/thread_pool.h"
 
 namespace dart {
 
@@ -106,6 +109,126 @@ void Metric::PrintJSON(JSONStream* stream) {
   double value_as_double = static_cast<double>(Value());
   obj.AddProperty("value", value_as_double);
 }
+
+static const intptr_t kPrometheusNameLength = 128;
+
+// Prometheus metric names only allow [a-zA-Z0-9_:], and by convention carry
+// their unit as a suffix.
+static void PrometheusFamilyName(const Metric* metric, char* family) {
+  intptr_t length = Utils::SNPrint(family, kPrometheusNameLength, "dart_%s",
+                                   metric->name());
+  for (intptr_t i = 0; (i < length) && (family[i] != '\0'); i++) {
+    const char ch = family[i];
+    if (!(((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z')) ||
+          ((ch >= '0') && (ch <= '9')) || (ch == ':'))) {
+      family[i] = '_';
+    }
+  }
+  const char* suffix = NULL;
+  switch (metric->unit()) {
+    case Metric::kByte:
+      suffix = "_bytes";
+      break;
+    case Metric::kMicrosecond:
+      suffix = "_microseconds";
+      break;
+    default:
+      return;
+  }
+  length = strlen(family);
+  Utils::SNPrint(family + length, kPrometheusNameLength - length, "%s",
+                 suffix);
+}
+
+void Metric::PrintPrometheusSamples(TextBuffer* buffer,
+                                    const char* family,
+                                    const char* labels) const {
+  if (labels[0] == '\0') {
+    buffer->Printf("%s %" Pd64 "\n", family, Value());
+  } else {
+    buffer->Printf("%s{%s} %" Pd64 "\n", family, labels, Value());
+  }
+}
+
+static void PrintPrometheusType(TextBuffer* buffer,
+                                const char* family,
+                                const char* type) {
+  buffer->Printf("# TYPE %s %s\n", family, type);
+}
+
+// Label values escape backslash, double quote and line feed.
+static void PrintPrometheusIsolateLabels(TextBuffer* labels,
+                                         Isolate* isolate) {
+  labels->AddString("isolate=\"");
+  for (const char* ch = isolate->name(); *ch != '\0'; ch++) {
+    if (*ch == '\n') {
+      labels->AddString("\\n");
+    } else {
+      if ((*ch == '\\') || (*ch == '"')) {
+        labels->AddChar('\\');
+      }
+      labels->AddChar(*ch);
+    }
+  }
+  labels->Printf("\",isolate_id=\"%" Pd64 "\"",
+                 static_cast<int64_t>(isolate->main_port()));
+}
+
+// Prints the samples of one isolate metric family for every isolate. The
+// isolates' lists are only read, and metrics that must be computed on the
+// isolate's thread are skipped.
+class PrometheusIsolateMetricVisitor : public IsolateVisitor {
+ public:
+  PrometheusIsolateMetricVisitor(TextBuffer* buffer,
+                                 const char* name,
+                                 const char* family)
+      : buffer_(buffer), name_(name), family_(family) {}
+
+  virtual void VisitIsolate(Isolate* isolate) {
+    if (IsVMInternalIsolate(isolate)) {
+      return;
+    }
+    for (Metric* metric = isolate->metrics_list_head(); metric != NULL;
+         metric = metric->next()) {
+      if (strcmp(metric->name(), name_) == 0) {
+        TextBuffer labels(64);
+        PrintPrometheusIsolateLabels(&labels, isolate);
+        metric->PrintPrometheusSamples(buffer_, family_, labels.buf());
+        return;
+      }
+    }
+  }
+
+ private:
+  TextBuffer* buffer_;
+  const char* name_;
+  const char* family_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrometheusIsolateMetricVisitor);
+};
+
+void Metric::PrintPrometheus(TextBuffer* buffer) {
+  char family[kPrometheusNameLength];
+  for (Metric* metric = vm_head(); metric != NULL; metric = metric->next()) {
+    PrometheusFamilyName(metric, family);
+    PrintPrometheusType(buffer, family, metric->PrometheusType());
+    metric->PrintPrometheusSamples(buffer, family, "");
+  }
+  // Every isolate registers the same metrics, so the families are taken from
+  // the current isolate and their samples gathered from all isolates.
+  Isolate* isolate = Isolate::Current();
+  ASSERT(isolate != NULL);
+  for (Metric* metric = isolate->metrics_list_head(); metric != NULL;
+       metric = metric->next()) {
+    if (metric->IsIsolateLocal()) {
+      continue;
+    }
+    PrometheusFamilyName(metric, family);
+    PrintPrometheusType(buffer, family, metric->PrometheusType());
+    PrometheusIsolateMetricVisitor visitor(buffer, metric->name(), family);
+    Isolate::VisitIsolates(&visitor);
+  }
+}
 #endif  // !PRODUCT
 
 char* Metric::ValueToString(int64_t value, Unit unit) {
@@ -303,6 +426,19 @@ int64_t MetricPeakRSS::Value() const {
   return Service::MaxRSS();
 }
 
+int64_t MetricThreadPoolTasks::Value() const {
+  ThreadPool* pool = Dart::thread_pool();
+  return (pool == NULL) ? 0 : pool->tasks_started();
+}
+
+int64_t MetricThreadPoolTaskLatency::Value() const {
+  ThreadPool* pool = Dart::thread_pool();
+  if ((pool == NULL) || (pool->tasks_started() == 0)) {
+    return 0;
+  }
+  return pool->task_start_latency_micros() / pool->tasks_started();
+}
+
 void Metric::Init() {
 #define VM_METRIC_INIT(type, variable, name, unit)                             \
   vm_metric_##variable##_.InitInstance(name, NULL, Metric::unit);
@@ -348,6 +484,52 @@ void MinMetric::SetValue(int64_t new_value) {
   }
 }
 
+HistogramMetric::HistogramMetric() : Metric(), count_(0) {
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i] = 0;
+  }
+}
+
+intptr_t HistogramMetric::BucketIndex(int64_t value) {
+  if (value <= 1) {
+    return 0;
+  }
+  const intptr_t index = Utils::HighestBit(value - 1) + 1;
+  return (index < kNumBuckets) ? index : kNumBuckets - 1;
+}
+
+void HistogramMetric::Record(int64_t value) {
+  AtomicOperations::IncrementInt64By(&buckets_[BucketIndex(value)], 1);
+  AtomicOperations::IncrementInt64By(&count_, 1);
+  AtomicIncrementBy(value);
+}
+
+void HistogramMetric::PrintPrometheusSamples(TextBuffer* buffer,
+                                             const char* family,
+                                             const char* labels) const {
+  const char* separator = (labels[0] == '\0') ? "" : ",";
+  // Buckets are cumulative in Prometheus. The count is taken from the
+  // buckets, which may be updated concurrently, so that it matches the
+  // last bucket.
+  int64_t cumulative = 0;
+  for (intptr_t i = 0; i < kNumBuckets - 1; i++) {
+    cumulative += buckets_[i];
+    buffer->Printf("%s_bucket{%s%sle=\"%" Pd64 "\"} %" Pd64 "\n", family,
+                   labels, separator, static_cast<int64_t>(1) << i,
+                   cumulative);
+  }
+  cumulative += buckets_[kNumBuckets - 1];
+  buffer->Printf("%s_bucket{%s%sle=\"+Inf\"} %" Pd64 "\n", family, labels,
+                 separator, cumulative);
+  if (labels[0] == '\0') {
+    buffer->Printf("%s_sum %" Pd64 "\n", family, Value());
+    buffer->Printf("%s_count %" Pd64 "\n", family, cumulative);
+  } else {
+    buffer->Printf("%s_sum{%s} %" Pd64 "\n", family, labels, Value());
+    buffer->Printf("%s_count{%s} %" Pd64 "\n", family, labels, cumulative);
+  }
+}
+
 }  // namespace dart
 
 #endif  // !defined(PRODUCT)
@@ -5,12 +5,14 @@
 #ifndef RUNTIME_VM_METRICS_H_
 #define RUNTIME_VM_METRICS_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 
 namespace dart {
 
 class Isolate;
 class JSONStream;
+class TextBuffer;
 
 // Metrics for each isolate.
 #define ISOLATE_METRIC_LIST(V)                                                 \
@@ -27,12 +29,23 @@ class JSONStream;
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
   V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(HistogramMetric, GCScavengePause, "gc.scavenge.pause", kMicrosecond)       \
+  V(HistogramMetric, GCScavengeSurvived, "gc.scavenge.survived", kByte)        \
+  V(HistogramMetric, GCMarkSweepPause, "gc.marksweep.pause", kMicrosecond)     \
+  V(HistogramMetric, CompileUnoptimizedTime, "compiler.unoptimized.time",      \
+    kMicrosecond)                                                              \
+  V(HistogramMetric, CompileOptimizedTime, "compiler.optimized.time",          \
+    kMicrosecond)                                                              \
+  V(Metric, DeoptimizationCount, "compiler.deopt.count", kCounter)
 
 #define VM_METRIC_LIST(V)                                                      \
   V(MetricIsolateCount, IsolateCount, "vm.isolate.count", kCounter)            \
   V(MetricCurrentRSS, CurrentRSS, "vm.memory.current", kByte)                  \
-  V(MetricPeakRSS, PeakRSS, "vm.memory.max", kByte)
+  V(MetricPeakRSS, PeakRSS, "vm.memory.max", kByte)                           \
+  V(MetricThreadPoolTasks, ThreadPoolTasks, "vm.threadpool.tasks", kCounter)   \
+  V(MetricThreadPoolTaskLatency, ThreadPoolTaskLatency,                        \
+    "vm.threadpool.task.latency", kMicrosecond)
 
 class Metric {
  public:
@@ -63,6 +76,10 @@ class Metric {
 
 #ifndef PRODUCT
   void PrintJSON(JSONStream* stream);
+
+  // Prints the VM metrics and the metrics of all isolates in the Prometheus
+  // text exposition format.
+  static void PrintPrometheus(TextBuffer* buffer);
 #endif  // !PRODUCT
 
   // Returns a zone allocated string.
@@ -76,6 +93,11 @@ class Metric {
 
   void increment() { value_++; }
 
+  // Unlike increment, safe to call from any thread.
+  void AtomicIncrementBy(int64_t delta) {
+    AtomicOperations::IncrementInt64By(&value_, delta);
+  }
+
   Metric* next() const { return next_; }
   void set_next(Metric* next) { next_ = next; }
 
@@ -93,6 +115,17 @@ class Metric {
   // Use this for metrics that produce their value on demand.
   virtual int64_t Value() const { return value(); }
 
+  // Override to return true for isolate metrics whose Value may only be
+  // computed on the isolate's own thread.
+  virtual bool IsIsolateLocal() const { return false; }
+
+#ifndef PRODUCT
+  virtual const char* PrometheusType() const { return "gauge"; }
+  virtual void PrintPrometheusSamples(TextBuffer* buffer,
+                                      const char* family,
+                                      const char* labels) const;
+#endif  // !PRODUCT
+
  private:
   Isolate* isolate_;
   const char* name_;
@@ -109,6 +142,8 @@ class Metric {
   void DeregisterWithVM();
 
   static Metric* vm_list_head_;
+
+  friend class PrometheusIsolateMetricVisitor;
   DISALLOW_COPY_AND_ASSIGN(Metric);
 };
 
@@ -130,34 +165,74 @@ class MinMetric : public Metric {
   void SetValue(int64_t new_value);
 };
 
+// A Metric class that records the distribution of the values passed to
+// Record, in buckets whose upper bounds are powers of two. Its value is the
+// sum of the recorded values. Values may be recorded from any thread.
+class HistogramMetric : public Metric {
+ public:
+  // Bucket i counts the values in (2^(i-1), 2^i], except for bucket 0, which
+  // counts the values up to 1, and the last bucket, which has no upper bound.
+  static const intptr_t kNumBuckets = 32;
+
+  HistogramMetric();
+
+  void Record(int64_t value);
+
+  int64_t count() const { return count_; }
+  int64_t bucket_count(intptr_t i) const {
+    ASSERT((i >= 0) && (i < kNumBuckets));
+    return buckets_[i];
+  }
+
+  static intptr_t BucketIndex(int64_t value);
+
+ protected:
+#ifndef PRODUCT
+  virtual const char* PrometheusType() const { return "histogram"; }
+  virtual void PrintPrometheusSamples(TextBuffer* buffer,
+                                      const char* family,
+                                      const char* labels) const;
+#endif  // !PRODUCT
+
+ private:
+  int64_t count_;
+  int64_t buckets_[kNumBuckets];
+};
+
 class MetricHeapOldUsed : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricHeapOldCapacity : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricHeapOldExternal : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricHeapNewUsed : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricHeapNewCapacity : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricHeapNewExternal : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 class MetricIsolateCount : public Metric {
@@ -175,9 +250,22 @@ class MetricPeakRSS : public Metric {
   virtual int64_t Value() const;
 };
 
+class MetricThreadPoolTasks : public Metric {
+ protected:
+  virtual int64_t Value() const;
+};
+
+// Average time between handing a task to the thread pool and a worker
+// starting to run it.
+class MetricThreadPoolTaskLatency : public Metric {
+ protected:
+  virtual int64_t Value() const;
+};
+
 class MetricHeapUsed : public Metric {
  protected:
   virtual int64_t Value() const;
+  virtual bool IsIsolateLocal() const { return true; }
 };
 
 #if !defined(PRODUCT)
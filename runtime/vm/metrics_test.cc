@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "platform/assert.h"
+#include "platform/text_buffer.h"
 
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
@@ -72,6 +73,93 @@ VM_UNIT_TEST_CASE(Metric_OnDemand) {
   Dart_ShutdownIsolate();
 }
 
+VM_UNIT_TEST_CASE(Metric_Histogram) {
+  TestCase::CreateTestIsolate();
+  {
+    HistogramMetric metric;
+    metric.InitInstance(Isolate::Current(), "a.b.c", "foobar",
+                        Metric::kMicrosecond);
+    EXPECT_EQ(0, HistogramMetric::BucketIndex(0));
+    EXPECT_EQ(0, HistogramMetric::BucketIndex(1));
+    EXPECT_EQ(1, HistogramMetric::BucketIndex(2));
+    EXPECT_EQ(2, HistogramMetric::BucketIndex(3));
+    EXPECT_EQ(2, HistogramMetric::BucketIndex(4));
+    EXPECT_EQ(3, HistogramMetric::BucketIndex(5));
+    EXPECT_EQ(HistogramMetric::kNumBuckets - 1,
+              HistogramMetric::BucketIndex(kMaxInt64));
+
+    metric.Record(1);
+    metric.Record(3);
+    metric.Record(4);
+    metric.Record(100);
+    EXPECT_EQ(4, metric.count());
+    EXPECT_EQ(108, metric.value());
+    EXPECT_EQ(1, metric.bucket_count(0));
+    EXPECT_EQ(0, metric.bucket_count(1));
+    EXPECT_EQ(2, metric.bucket_count(2));
+    EXPECT_EQ(1, metric.bucket_count(7));
+  }
+  Dart_ShutdownIsolate();
+}
+
+VM_UNIT_TEST_CASE(Metric_PrintPrometheus) {
+  TestCase::CreateTestIsolate();
+  {
+    Isolate* isolate = Isolate::Current();
+    isolate->GetGCScavengePauseMetric()->Record(3);
+    TextBuffer buffer(1024);
+    Metric::PrintPrometheus(&buffer);
+    const char* text = buffer.buf();
+    EXPECT_SUBSTRING("# TYPE dart_vm_isolate_count gauge\n", text);
+    EXPECT_SUBSTRING("# TYPE dart_gc_scavenge_pause_microseconds histogram\n",
+                     text);
+    char expected[256];
+    Utils::SNPrint(expected, sizeof(expected),
+                   "dart_gc_scavenge_pause_microseconds_bucket{isolate=\"%s\","
+                   "isolate_id=\"%" Pd64 "\",le=\"+Inf\"} ",
+                   isolate->name(),
+                   static_cast<int64_t>(isolate->main_port()));
+    EXPECT_SUBSTRING(expected, text);
+    // Heap usage can only be computed on the isolate's own thread.
+    EXPECT_NOTSUBSTRING("dart_heap_old_used_bytes ", text);
+  }
+  Dart_ShutdownIsolate();
+}
+
+TEST_CASE(Metric_RecordedByGCAndCompiler) {
+  Isolate* isolate = thread->isolate();
+  HistogramMetric* unoptimized = isolate->GetCompileUnoptimizedTimeMetric();
+  HistogramMetric* scavenge = isolate->GetGCScavengePauseMetric();
+  HistogramMetric* survived = isolate->GetGCScavengeSurvivedMetric();
+  HistogramMetric* mark_sweep = isolate->GetGCMarkSweepPauseMetric();
+
+  const char* kScript =
+      "foo() => 42;\n"
+      "main() => foo();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(lib);
+  const int64_t compiled = unoptimized->count();
+  EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 0, NULL));
+  // Both main and foo are compiled on their first call.
+  EXPECT_LE(compiled + 2, unoptimized->count());
+
+  const int64_t scavenges = scavenge->count();
+  const int64_t mark_sweeps = mark_sweep->count();
+  {
+    TransitionNativeToVM transition(thread);
+    isolate->heap()->CollectAllGarbage();
+  }
+  EXPECT_EQ(scavenges + 1, scavenge->count());
+  EXPECT_EQ(scavenges + 1, survived->count());
+  EXPECT_EQ(mark_sweeps + 1, mark_sweep->count());
+
+  // The embedder API reports the sum of the recorded values.
+  Dart_Isolate api_isolate = Api::CastIsolate(isolate);
+  EXPECT_EQ(scavenge->value(), Dart_IsolateGCScavengePauseMetric(api_isolate));
+  EXPECT_EQ(unoptimized->value(),
+            Dart_IsolateCompileUnoptimizedTimeMetric(api_isolate));
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
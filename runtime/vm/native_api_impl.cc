@@ -56,6 +56,42 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message) {
   return PostCObjectHelper(port_id, message);
 }
 
+DART_EXPORT intptr_t Dart_PostCObjectBatch(Dart_Port port_id,
+                                           intptr_t count,
+                                           Dart_CObject** messages) {
+  if (count <= 0) {
+    return 0;
+  }
+  Message** batch = new Message*[count];
+  intptr_t written = 0;
+  while (written < count) {
+    ApiMessageWriter writer;
+    Message* msg = writer.WriteCMessage(messages[written], port_id,
+                                        Message::kNormalPriority);
+    if (msg == NULL) {
+      break;
+    }
+    batch[written++] = msg;
+  }
+  // Post the messages that could be written, in one go.
+  bool posted = (written > 0) && PortMap::PostMessages(port_id, batch, written);
+  delete[] batch;
+  return posted ? written : 0;
+}
+
+DART_EXPORT bool Dart_PostCObjectArray(Dart_Port port_id,
+                                       intptr_t length,
+                                       Dart_CObject* elements) {
+  ApiMessageWriter writer;
+  Message* msg = writer.WriteCArrayMessage(elements, length, port_id,
+                                           Message::kNormalPriority);
+  if (msg == NULL) {
+    return false;
+  }
+  // Post the message at the given port.
+  return PortMap::PostMessage(msg);
+}
+
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   if (Smi::IsValid(message)) {
     return PortMap::PostMessage(
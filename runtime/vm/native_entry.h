@@ -88,6 +88,36 @@ typedef void (*NativeFunctionWrapper)(Dart_NativeArguments args,
   static RawObject* DN_Helper##name(Isolate* isolate, Thread* thread,          \
                                     Zone* zone, NativeArguments* arguments)
 
+// Leaf natives stay in generated code state and give the body neither a
+// zone nor the isolate: they read their raw arguments and must not allocate
+// handles or heap objects, throw, or otherwise reach a safepoint. They are
+// meant for tiny natives such as length and hash getters, where setting up
+// the transition and the stack zone costs more than the native itself.
+#if defined(DEBUG)
+#define LEAF_NATIVE_NO_SAFEPOINT_SCOPE NoSafepointScope no_safepoint_scope;
+#else
+#define LEAF_NATIVE_NO_SAFEPOINT_SCOPE
+#endif
+
+#define DEFINE_LEAF_NATIVE_ENTRY(name, argument_count)                         \
+  static RawObject* DN_Helper##name(Thread* thread,                            \
+                                    NativeArguments* arguments);               \
+  void NATIVE_ENTRY_FUNCTION(name)(Dart_NativeArguments args) {                \
+    CHECK_STACK_ALIGNMENT;                                                     \
+    NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);     \
+    /* Tell MemorySanitizer 'arguments' is initialized by generated code. */   \
+    MSAN_UNPOISON(arguments, sizeof(*arguments));                              \
+    ASSERT(arguments->NativeArgCount() == argument_count);                     \
+    TRACE_NATIVE_CALL("%s", "" #name);                                         \
+    {                                                                          \
+      Thread* thread = arguments->thread();                                    \
+      ASSERT(thread == Thread::Current());                                     \
+      LEAF_NATIVE_NO_SAFEPOINT_SCOPE                                           \
+      SET_NATIVE_RETVAL(arguments, DN_Helper##name(thread, arguments));        \
+    }                                                                          \
+  }                                                                            \
+  static RawObject* DN_Helper##name(Thread* thread, NativeArguments* arguments)
+
 // Helper that throws an argument exception.
 void DartNativeThrowArgumentException(const Instance& instance);
 
@@ -2069,8 +2069,10 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
   } else {
     class_table->UpdateAllocatedOld(cls_id, size);
   }
+  const bool at_sample_point =
+      (space == Heap::kNew) && heap->new_space()->TakeAllocationSample();
   const Class& cls = Class::Handle(class_table->At(cls_id));
-  if (FLAG_profiler && cls.TraceAllocation(isolate)) {
+  if (FLAG_profiler && (at_sample_point || cls.TraceAllocation(isolate))) {
     Profiler::SampleAllocation(thread, cls_id);
   }
 #endif  // !PRODUCT
@@ -2102,7 +2104,7 @@ class WriteBarrierUpdateVisitor : public ObjectPointerVisitor {
     for (RawObject** slot = from; slot <= to; ++slot) {
       RawObject* value = *slot;
       if (value->IsHeapObject()) {
-        old_obj_->CheckHeapPointerStore(value, thread_);
+        old_obj_->CheckHeapPointerStore(slot, value, thread_);
       }
     }
   }
@@ -9520,10 +9522,33 @@ void Field::ForceDynamicGuardedCidAndLength() const {
 }
 
 bool Script::HasSource() const {
-  return raw_ptr()->source_ != String::null();
+  if (raw_ptr()->source_ != String::null()) {
+    return true;
+  }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // A kernel source that is not decoded yet can still be read from its
+  // component. This does not allocate, so it is safe off the mutator.
+  if (kind() == RawScript::kKernelTag) {
+    const KernelProgramInfo& info =
+        KernelProgramInfo::Handle(kernel_program_info());
+    return !info.IsNull() &&
+           (info.kernel_component() != ExternalTypedData::null());
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+  return false;
 }
 
 RawString* Script::Source() const {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Kernel sources are decoded when they are first needed by the mutator,
+  // e.g. by the debugger or for a stack trace, rather than when the script is
+  // loaded. Background compiler threads only see sources decoded already.
+  if ((raw_ptr()->source_ == String::null()) &&
+      (kind() == RawScript::kKernelTag) &&
+      Thread::Current()->IsMutatorThread()) {
+    set_source(String::Handle(kernel::GetSourceFor(*this)));
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
   return raw_ptr()->source_;
 }
 
@@ -9963,8 +9988,15 @@ RawLibrary* Script::FindLibrary() const {
   return Library::null();
 }
 
+// Returns the dictionary of the library after loading any top level members
+// that are still pending, since loading them may grow the dictionary.
+RawArray* DictionaryIterator::LoadedDictionary(const Library& library) {
+  library.EnsureTopLevelMembersLoaded();
+  return library.dictionary();
+}
+
 DictionaryIterator::DictionaryIterator(const Library& library)
-    : array_(Array::Handle(library.dictionary())),
+    : array_(Array::Handle(LoadedDictionary(library))),
       // Last element in array is a Smi indicating the number of entries used.
       size_(Array::Handle(library.dictionary()).Length() - 1),
       next_ix_(0) {
@@ -10672,7 +10704,8 @@ RawObject* Library::LookupReExport(const String& name,
   return obj.raw();
 }
 
-RawObject* Library::LookupEntry(const String& name, intptr_t* index) const {
+RawObject* Library::LookupEntryNoLoad(const String& name,
+                                      intptr_t* index) const {
   Thread* thread = Thread::Current();
   REUSABLE_ARRAY_HANDLESCOPE(thread);
   REUSABLE_OBJECT_HANDLESCOPE(thread);
@@ -10697,6 +10730,17 @@ RawObject* Library::LookupEntry(const String& name, intptr_t* index) const {
   return Object::null();
 }
 
+RawObject* Library::LookupEntry(const String& name, intptr_t* index) const {
+  RawObject* result = LookupEntryNoLoad(name, index);
+  if ((result == Object::null()) && HasPendingTopLevelMembers()) {
+    EnsureTopLevelMembersLoaded();
+    if (!HasPendingTopLevelMembers()) {
+      result = LookupEntryNoLoad(name, index);
+    }
+  }
+  return result;
+}
+
 void Library::ReplaceObject(const Object& obj, const String& name) const {
   ASSERT(!Compiler::IsBackgroundCompilation());
   ASSERT(obj.IsClass() || obj.IsFunction() || obj.IsField());
@@ -11039,6 +11083,34 @@ void Library::set_toplevel_class(const Class& value) const {
   StorePointer(&raw_ptr()->toplevel_class_, value.raw());
 }
 
+bool Library::HasPendingTopLevelMembers() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return false;
+#else
+  if (raw_ptr()->toplevel_class_ == Class::null()) {
+    return false;
+  }
+  return Class::Handle(toplevel_class()).kernel_offset() > 0;
+#endif
+}
+
+void Library::EnsureTopLevelMembersLoaded() const {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (!HasPendingTopLevelMembers()) {
+    return;
+  }
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const Class& cls = Class::Handle(zone, toplevel_class());
+  if (Compiler::IsBackgroundCompilation()) {
+    Compiler::AbortBackgroundCompilation(
+        DeoptId::kNone, "Loading top level members while compiling");
+  }
+  ASSERT(thread->IsMutatorThread());
+  kernel::KernelLoader::FinishLoading(cls);
+#endif
+}
+
 void Library::set_metadata(const GrowableObjectArray& value) const {
   StorePointer(&raw_ptr()->metadata_, value.raw());
 }
@@ -12344,6 +12416,11 @@ void KernelProgramInfo::set_constants_table(
   StorePointer(&raw_ptr()->constants_table_, value.raw());
 }
 
+void KernelProgramInfo::set_kernel_component(
+    const ExternalTypedData& value) const {
+  StorePointer(&raw_ptr()->kernel_component_, value.raw());
+}
+
 void KernelProgramInfo::set_potential_natives(
     const GrowableObjectArray& candidates) const {
   StorePointer(&raw_ptr()->potential_natives_, candidates.raw());
@@ -13005,9 +13082,7 @@ void StackMap::SetBit(intptr_t bit_index, bool value) const {
   }
 }
 
-RawStackMap* StackMap::New(intptr_t pc_offset,
-                           BitmapBuilder* bmap,
-                           intptr_t slow_path_bit_count) {
+RawStackMap* StackMap::New(BitmapBuilder* bmap, intptr_t slow_path_bit_count) {
   ASSERT(Object::stackmap_class() != Class::null());
   ASSERT(bmap != NULL);
   StackMap& result = StackMap::Handle();
@@ -13034,8 +13109,6 @@ RawStackMap* StackMap::New(intptr_t pc_offset,
     result ^= raw;
     result.SetLength(length);
   }
-  ASSERT(pc_offset >= 0);
-  result.SetPcOffset(pc_offset);
   if (payload_size > 0) {
     // Ensure leftover bits are deterministic.
     result.raw()->ptr()->data()[payload_size - 1] = 0;
@@ -13047,9 +13120,7 @@ RawStackMap* StackMap::New(intptr_t pc_offset,
   return result.raw();
 }
 
-RawStackMap* StackMap::New(intptr_t length,
-                           intptr_t slow_path_bit_count,
-                           intptr_t pc_offset) {
+RawStackMap* StackMap::New(intptr_t length, intptr_t slow_path_bit_count) {
   ASSERT(Object::stackmap_class() != Class::null());
   StackMap& result = StackMap::Handle();
   // Guard against integer overflow of the instance size computation.
@@ -13075,36 +13146,42 @@ RawStackMap* StackMap::New(intptr_t length,
     result ^= raw;
     result.SetLength(length);
   }
-  ASSERT(pc_offset >= 0);
-  result.SetPcOffset(pc_offset);
   result.SetSlowPathBitCount(slow_path_bit_count);
   return result.raw();
 }
 
+intptr_t StackMap::Hash() const {
+  uint32_t hash = SlowPathBitCount();
+  NoSafepointScope no_safepoint;
+  const intptr_t payload_size =
+      UnroundedSize(Length()) - static_cast<intptr_t>(sizeof(RawStackMap));
+  for (intptr_t i = 0; i < payload_size; i++) {
+    hash = CombineHashes(hash, raw_ptr()->data()[i]);
+  }
+  return FinalizeHash(hash, String::kHashBits);
+}
+
 const char* StackMap::ToCString() const {
-#define FORMAT "%#05x: "
   if (IsNull()) {
     return "{null}";
   } else {
-    intptr_t fixed_length = Utils::SNPrint(NULL, 0, FORMAT, PcOffset()) + 1;
     Thread* thread = Thread::Current();
     // Guard against integer overflow in the computation of alloc_size.
     //
     // TODO(kmillikin): We could just truncate the string if someone
     // tries to print a 2 billion plus entry stackmap.
-    if (Length() > (kIntptrMax - fixed_length)) {
+    if (Length() > (kIntptrMax - 1)) {
       FATAL1("Length() is unexpectedly large (%" Pd ")", Length());
     }
-    intptr_t alloc_size = fixed_length + Length();
+    intptr_t alloc_size = Length() + 1;
     char* chars = thread->zone()->Alloc<char>(alloc_size);
-    intptr_t index = Utils::SNPrint(chars, alloc_size, FORMAT, PcOffset());
+    intptr_t index = 0;
     for (intptr_t i = 0; i < Length(); i++) {
       chars[index++] = IsObject(i) ? '1' : '0';
     }
     chars[index] = '\0';
     return chars;
   }
-#undef FORMAT
 }
 
 RawString* LocalVarDescriptors::GetName(intptr_t var_index) const {
@@ -15118,15 +15195,23 @@ RawCode* Code::FindCode(uword pc, int64_t timestamp) {
 }
 
 TokenPosition Code::GetTokenIndexOfPC(uword pc) const {
+  TokenPositionCache* cache = Isolate::Current()->token_position_cache();
+  TokenPosition* cached = cache->Lookup(pc);
+  if (cached != NULL) {
+    return *cached;
+  }
   uword pc_offset = pc - PayloadStart();
   const PcDescriptors& descriptors = PcDescriptors::Handle(pc_descriptors());
   PcDescriptors::Iterator iter(descriptors, RawPcDescriptors::kAnyKind);
+  TokenPosition result = TokenPosition::kNoSource;
   while (iter.MoveNext()) {
     if (iter.PcOffset() == pc_offset) {
-      return iter.TokenPos();
+      result = iter.TokenPos();
+      break;
     }
   }
-  return TokenPosition::kNoSource;
+  cache->Insert(pc, result);
+  return result;
 }
 
 uword Code::GetPcForDeoptId(intptr_t deopt_id,
@@ -15267,15 +15352,27 @@ RawStackMap* Code::GetStackMap(uint32_t pc_offset,
     return StackMap::null();
   }
   // A stack map is present in the code object, use the stack map to visit
-  // frame slots which are marked as having objects.
+  // frame slots which are marked as having objects. The table is sorted by
+  // pc offset.
   *maps = stackmaps();
   *map = StackMap::null();
-  for (intptr_t i = 0; i < maps->Length(); i++) {
-    *map ^= maps->At(i);
-    ASSERT(!map->IsNull());
-    if (map->PcOffset() == pc_offset) {
+  intptr_t lo = 0;
+  intptr_t hi = maps->Length() / kSMEntryLength - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    const intptr_t entry = mid * kSMEntryLength;
+    const uint32_t mid_pc_offset =
+        Smi::Value(Smi::RawCast(maps->At(entry + kSMPcOffsetEntry)));
+    if (mid_pc_offset == pc_offset) {
+      *map ^= maps->At(entry + kSMStackMapEntry);
+      ASSERT(!map->IsNull());
       return map->raw();  // We found a stack map for this frame.
     }
+    if (mid_pc_offset < pc_offset) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
   }
   // If we are missing a stack map, this must either be unoptimized code, or
   // the entry to an osr function. (In which case all stack slots are
@@ -15668,6 +15765,25 @@ void MegamorphicCache::Insert(const Smi& class_id,
   UNREACHABLE();
 }
 
+RawObject* MegamorphicCache::Lookup(const Smi& class_id) const {
+  const Array& backing_array = Array::Handle(buckets());
+  intptr_t id_mask = mask();
+  intptr_t index = (class_id.Value() * kSpreadFactor) & id_mask;
+  intptr_t i = index;
+  do {
+    const intptr_t current_cid =
+        Smi::Value(Smi::RawCast(GetClassId(backing_array, i)));
+    if (current_cid == class_id.Value()) {
+      return GetTargetFunction(backing_array, i);
+    }
+    if (current_cid == kIllegalCid) {
+      break;
+    }
+    i = (i + 1) & id_mask;
+  } while (i != index);
+  return Object::null();
+}
+
 const char* MegamorphicCache::ToCString() const {
   const String& name = String::Handle(target_name());
   return OS::SCreate(Thread::Current()->zone(), "MegamorphicCache(%s)",
@@ -15697,8 +15813,21 @@ void SubtypeTestCache::set_cache(const Array& value) const {
 
 intptr_t SubtypeTestCache::NumberOfChecks() const {
   NoSafepointScope no_safepoint;
-  // Do not count the sentinel;
-  return (Smi::Value(cache()->ptr()->length_) / kTestEntryLength) - 1;
+  // The checks are followed by at least one sentinel entry, and possibly by
+  // more unused entries, all of which are null. Find the first sentinel.
+  RawArray* data = cache();
+  intptr_t lo = 0;
+  intptr_t hi = (Smi::Value(data->ptr()->length_) / kTestEntryLength) - 1;
+  while (lo < hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (data->ptr()->data()[mid * kTestEntryLength +
+                            kInstanceClassIdOrFunction] == Object::null()) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
 }
 
 void SubtypeTestCache::AddCheck(
@@ -15711,9 +15840,13 @@ void SubtypeTestCache::AddCheck(
     const Bool& test_result) const {
   intptr_t old_num = NumberOfChecks();
   Array& data = Array::Handle(cache());
-  intptr_t new_len = data.Length() + kTestEntryLength;
-  data = Array::Grow(data, new_len);
-  set_cache(data);
+  // Grow geometrically, so that adding a check does not copy the cache
+  // every time, while keeping a sentinel after the new check.
+  if ((old_num + 2) * kTestEntryLength > data.Length()) {
+    intptr_t new_len = 2 * (old_num + 1) * kTestEntryLength;
+    data = Array::Grow(data, new_len, Heap::kOld);
+    set_cache(data);
+  }
   intptr_t data_pos = old_num * kTestEntryLength;
   data.SetAt(data_pos + kInstanceClassIdOrFunction,
              instance_class_id_or_function);
@@ -16048,16 +16181,35 @@ RawObject* Instance::InvokeGetter(const String& getter_name,
   Zone* zone = Thread::Current()->zone();
 
   Class& klass = Class::Handle(zone, clazz());
-  TypeArguments& type_args = TypeArguments::Handle(zone);
-  if (klass.NumTypeArguments() > 0) {
-    type_args ^= GetTypeArguments();
-  }
-
   const String& internal_getter_name =
       String::Handle(zone, Field::GetterName(getter_name));
   Function& function = Function::Handle(
       zone, Resolver::ResolveDynamicAnyArgs(zone, klass, internal_getter_name));
 
+  // An implicit getter only loads its field, so read the field directly
+  // instead of building an argument list and entering Dart code. Fields whose
+  // value may be kept in a mutable box still go through the getter, which
+  // returns a fresh copy.
+  if (!function.IsNull() && function.IsImplicitGetterFunction() &&
+      (!respect_reflectable || function.is_reflectable())) {
+    const Field& field = Field::Handle(zone, function.accessor_field());
+    if (!field.IsNull()) {
+      const intptr_t cid = field.guarded_cid();
+      const bool may_be_boxed_in_place =
+          field.is_unboxing_candidate() && !field.is_final() &&
+          ((cid == kDoubleCid) || (cid == kFloat32x4Cid) ||
+           (cid == kFloat64x2Cid));
+      if (!may_be_boxed_in_place) {
+        return GetField(field);
+      }
+    }
+  }
+
+  TypeArguments& type_args = TypeArguments::Handle(zone);
+  if (klass.NumTypeArguments() > 0) {
+    type_args ^= GetTypeArguments();
+  }
+
   // Check for method extraction when method extractors are not created.
   if (function.IsNull() && !FLAG_lazy_dispatchers) {
     function = Resolver::ResolveDynamicAnyArgs(zone, klass, getter_name);
@@ -16221,6 +16373,17 @@ RawObject* Instance::HashCode() const {
 }
 
 RawObject* Instance::IdentityHashCode() const {
+#if defined(HASH_IN_OBJECT_HEADER)
+  // Objects without their own _identityHashCode keep it in the header once
+  // Object._objectHashCode has assigned one, so avoid calling into Dart.
+  if (!IsNull() && raw()->IsHeapObject() && !IsInteger() && !IsDouble() &&
+      !IsBool() && !IsString()) {
+    const uint32_t hash = Object::GetCachedHash(raw());
+    if (hash != 0) {
+      return Smi::New(hash);
+    }
+  }
+#endif
   return DartLibraryCalls::IdentityHashCode(*this);
 }
 
@@ -19916,6 +20079,18 @@ RawDouble* Double::NewCanonical(const String& str) {
 }
 
 RawString* Number::ToString(Heap::Space space) const {
+  if (IsDouble()) {
+    // double.toString is hot in serialization code: format on the stack and
+    // copy straight into the result.
+    const double value = Double::Cast(*this).value();
+    if (!isnan(value) && !isinf(value)) {
+      const int kBufferSize = 128;
+      char buffer[kBufferSize];
+      const intptr_t length = DoubleToCString(value, buffer, kBufferSize);
+      return OneByteString::New(reinterpret_cast<const uint8_t*>(buffer),
+                                length, space);
+    }
+  }
   // Refactoring can avoid Zone::Alloc and strlen, but gains are insignificant.
   const char* cstr = ToCString();
   intptr_t len = strlen(cstr);
@@ -20256,6 +20431,78 @@ bool String::StartsWith(const String& other) const {
   return true;
 }
 
+intptr_t String::IndexOf(const String& str,
+                         const String& pattern,
+                         intptr_t start) {
+  ASSERT(!str.IsNull() && !pattern.IsNull());
+  ASSERT((start >= 0) && (start <= str.Length()));
+  const intptr_t pattern_len = pattern.Length();
+  const intptr_t max_index = str.Length() - pattern_len;
+  if (start > max_index) {
+    return -1;
+  }
+  if (pattern_len == 0) {
+    return start;
+  }
+  NoSafepointScope no_safepoint;
+  const bool str_one_byte =
+      str.IsOneByteString() || str.IsExternalOneByteString();
+  const bool pattern_one_byte =
+      pattern.IsOneByteString() || pattern.IsExternalOneByteString();
+  if (str_one_byte && pattern_one_byte) {
+    // Find candidates for the first character with memchr and compare the
+    // rest of the pattern with memcmp.
+    const uint8_t* data = str.IsOneByteString()
+                              ? OneByteString::DataStart(str)
+                              : ExternalOneByteString::DataStart(str);
+    const uint8_t* chars = pattern.IsOneByteString()
+                               ? OneByteString::DataStart(pattern)
+                               : ExternalOneByteString::DataStart(pattern);
+    intptr_t i = start;
+    while (i <= max_index) {
+      const void* found = memchr(data + i, chars[0], max_index - i + 1);
+      if (found == NULL) {
+        return -1;
+      }
+      i = reinterpret_cast<const uint8_t*>(found) - data;
+      if (memcmp(data + i + 1, chars + 1, pattern_len - 1) == 0) {
+        return i;
+      }
+      i++;
+    }
+    return -1;
+  }
+  if (!str_one_byte && !pattern_one_byte) {
+    const uint16_t* data = str.IsTwoByteString()
+                               ? TwoByteString::DataStart(str)
+                               : ExternalTwoByteString::DataStart(str);
+    const uint16_t* chars = pattern.IsTwoByteString()
+                                ? TwoByteString::DataStart(pattern)
+                                : ExternalTwoByteString::DataStart(pattern);
+    const uint16_t first = chars[0];
+    const intptr_t rest_size = (pattern_len - 1) * sizeof(uint16_t);
+    for (intptr_t i = start; i <= max_index; i++) {
+      if ((data[i] == first) &&
+          (memcmp(data + i + 1, chars + 1, rest_size) == 0)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  // Strings of different widths. A two-byte string may still contain only
+  // Latin-1 characters, so the code units are compared one by one.
+  for (intptr_t i = start; i <= max_index; i++) {
+    intptr_t j = 0;
+    while ((j < pattern_len) && (str.CharAt(i + j) == pattern.CharAt(j))) {
+      j++;
+    }
+    if (j == pattern_len) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 RawInstance* String::CheckAndCanonicalize(Thread* thread,
                                           const char** error_str) const {
   if (IsCanonical()) {
@@ -21522,10 +21769,17 @@ RawArray* Array::New(intptr_t class_id, intptr_t len, Heap::Space space) {
     FATAL1("Fatal error in Array::New: invalid len %" Pd "\n", len);
   }
   {
+    const intptr_t size = Array::InstanceSize(len);
     RawArray* raw = reinterpret_cast<RawArray*>(
-        Object::Allocate(class_id, Array::InstanceSize(len), space));
+        Object::Allocate(class_id, size, space));
     NoSafepointScope no_safepoint;
     raw->StoreSmi(&(raw->ptr()->length_), Smi::New(len));
+    if (size > Heap::kNewAllocatableSize) {
+      // Too large for new space, so alone on a large page: remember stores
+      // into it by card.
+      ASSERT(raw->IsOldObject());
+      raw->SetCardRememberedBitUnsynchronized();
+    }
     return raw;
   }
 }
@@ -21583,6 +21837,13 @@ RawArray* Array::Grow(const Array& source,
   }
   ASSERT(new_length >= len);  // Cannot copy 'source' into new array.
   ASSERT(new_length != len);  // Unnecessary copying of array.
+  if ((len > 0) && result.raw()->IsNewObject()) {
+    // Stores into a new-space object need no barrier, so copy in bulk.
+    NoSafepointScope no_safepoint;
+    memmove(const_cast<RawObject**>(result.ObjectAddr(0)), source.ObjectAddr(0),
+            len * kWordSize);
+    return result.raw();
+  }
   PassiveObject& obj = PassiveObject::Handle(zone);
   for (int i = 0; i < len; i++) {
     obj = source.At(i);
@@ -22654,6 +22915,10 @@ void RegExp::set_pattern(const String& pattern) const {
   StorePointer(&raw_ptr()->pattern_, pattern.raw());
 }
 
+void RegExp::set_literal_prefix(const String& prefix) const {
+  StorePointer(&raw_ptr()->literal_prefix_, prefix.raw());
+}
+
 void RegExp::set_function(intptr_t cid,
                           bool sticky,
                           const Function& value) const {
@@ -3700,6 +3700,7 @@ class DictionaryIterator : public ValueObject {
 
  private:
   void MoveToNextObject();
+  static RawArray* LoadedDictionary(const Library& library);
 
   const Array& array_;
   const int size_;  // Number of elements to iterate over.
@@ -3880,6 +3881,10 @@ class Library : public Object {
   RawClass* toplevel_class() const { return raw_ptr()->toplevel_class_; }
   void set_toplevel_class(const Class& value) const;
 
+  // Loads the top level fields and procedures of this library from kernel if
+  // their loading was deferred (see --lazy_toplevel_loading).
+  void EnsureTopLevelMembersLoaded() const;
+
   RawGrowableObjectArray* patch_classes() const {
     return raw_ptr()->patch_classes_;
   }
@@ -4060,6 +4065,8 @@ class Library : public Object {
   void RehashDictionary(const Array& old_dict, intptr_t new_dict_size) const;
   static RawLibrary* NewLibraryHelper(const String& url, bool import_core_lib);
   RawObject* LookupEntry(const String& name, intptr_t* index) const;
+  RawObject* LookupEntryNoLoad(const String& name, intptr_t* index) const;
+  bool HasPendingTopLevelMembers() const;
 
   void AllocatePrivateKey() const;
 
@@ -4155,6 +4162,13 @@ class KernelProgramInfo : public Object {
 
   void set_constants_table(const ExternalTypedData& value) const;
 
+  // A view of the whole kernel component, used to read the sources of its
+  // scripts on demand. Not included in snapshots.
+  RawExternalTypedData* kernel_component() const {
+    return raw_ptr()->kernel_component_;
+  }
+  void set_kernel_component(const ExternalTypedData& value) const;
+
   RawArray* scripts() const { return raw_ptr()->scripts_; }
 
   RawArray* constants() const { return raw_ptr()->constants_; }
@@ -4709,12 +4723,6 @@ class StackMap : public Object {
 
   intptr_t Length() const { return raw_ptr()->length_; }
 
-  uint32_t PcOffset() const { return raw_ptr()->pc_offset_; }
-  void SetPcOffset(uint32_t value) const {
-    ASSERT(value <= kMaxUint32);
-    StoreNonPointer(&raw_ptr()->pc_offset_, value);
-  }
-
   intptr_t SlowPathBitCount() const { return raw_ptr()->slow_path_bit_count_; }
   void SetSlowPathBitCount(intptr_t bit_count) const {
     ASSERT(bit_count <= kMaxUint16);
@@ -4725,9 +4733,15 @@ class StackMap : public Object {
     if (Length() != other.Length()) {
       return false;
     }
+    if (SlowPathBitCount() != other.SlowPathBitCount()) {
+      return false;
+    }
     NoSafepointScope no_safepoint;
-    return memcmp(raw_ptr(), other.raw_ptr(), InstanceSize(Length())) == 0;
+    const intptr_t payload_size = UnroundedSize(Length()) - sizeof(RawStackMap);
+    return memcmp(raw_ptr()->data(), other.raw_ptr()->data(), payload_size) ==
+           0;
   }
+  intptr_t Hash() const;
 
   static const intptr_t kMaxLengthInBytes = kSmiMax;
 
@@ -4746,13 +4760,9 @@ class StackMap : public Object {
   static intptr_t InstanceSize(intptr_t length) {
     return RoundedAllocationSize(UnroundedSize(length));
   }
-  static RawStackMap* New(intptr_t pc_offset,
-                          BitmapBuilder* bmap,
-                          intptr_t register_bit_count);
+  static RawStackMap* New(BitmapBuilder* bmap, intptr_t register_bit_count);
 
-  static RawStackMap* New(intptr_t length,
-                          intptr_t register_bit_count,
-                          intptr_t pc_offset);
+  static RawStackMap* New(intptr_t length, intptr_t register_bit_count);
 
  private:
   void SetLength(intptr_t length) const {
@@ -4962,12 +4972,21 @@ class Code : public Object {
   void set_catch_entry_moves_maps(const TypedData& maps) const;
 #endif
 
+  // The stack map table holds the pc offset of every safepoint, as a Smi,
+  // followed by its StackMap, sorted by pc offset. StackMaps do not record
+  // their pc offset, so safepoints with the same live slots share one.
   RawArray* stackmaps() const { return raw_ptr()->stackmaps_; }
   void set_stackmaps(const Array& maps) const;
   RawStackMap* GetStackMap(uint32_t pc_offset,
                            Array* stackmaps,
                            StackMap* map) const;
 
+  enum {
+    kSMPcOffsetEntry = 0,
+    kSMStackMapEntry = 1,
+    kSMEntryLength = 2,
+  };
+
   enum {
     kSCallTableOffsetEntry = 0,
     kSCallTableFunctionEntry = 1,
@@ -5457,6 +5476,9 @@ class MegamorphicCache : public Object {
 
   void Insert(const Smi& class_id, const Function& target) const;
 
+  // Returns the target function for class_id, or null if there is none.
+  RawObject* Lookup(const Smi& class_id) const;
+
   static intptr_t InstanceSize() {
     return RoundedAllocationSize(sizeof(RawMegamorphicCache));
   }
@@ -7256,6 +7278,9 @@ class String : public Instance {
   };
 
   intptr_t Length() const { return Smi::Value(raw_ptr()->length_); }
+  static intptr_t LengthOf(const RawString* str) {
+    return Smi::Value(str->ptr()->length_);
+  }
   static intptr_t length_offset() { return OFFSET_OF(RawString, length_); }
 
   intptr_t Hash() const {
@@ -7268,6 +7293,17 @@ class String : public Instance {
     return result;
   }
 
+  // Same as Hash(), for callers that cannot allocate a handle.
+  static intptr_t HashOf(RawString* str) {
+    intptr_t result = GetCachedHash(str);
+    if (result != 0) {
+      return result;
+    }
+    result = String::Hash(str);
+    SetCachedHash(str, result);
+    return result;
+  }
+
   static intptr_t Hash(RawString* raw);
 
   bool HasHash() const {
@@ -7334,6 +7370,12 @@ class String : public Instance {
 
   bool StartsWith(const String& other) const;
 
+  // Returns the index of the first occurrence of 'pattern' in 'str' at or
+  // after 'start', or -1 if there is none.
+  static intptr_t IndexOf(const String& str,
+                          const String& pattern,
+                          intptr_t start);
+
   // Strings are canonicalized using the symbol table.
   virtual RawInstance* CheckAndCanonicalize(Thread* thread,
                                             const char** error_str) const;
@@ -7554,6 +7596,22 @@ class OneByteString : public AllStatic {
     NoSafepointScope no_safepoint;
     *CharAddr(str, index) = code_unit;
   }
+
+  // Returns the index of the first 'code_unit' in 'str' at or after 'start',
+  // or -1 if there is none.
+  static intptr_t IndexOf(const String& str,
+                          uint8_t code_unit,
+                          intptr_t start) {
+    ASSERT((start >= 0) && (start <= str.Length()));
+    ASSERT(str.IsOneByteString());
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = DataStart(str);
+    const void* found = memchr(data + start, code_unit, str.Length() - start);
+    if (found == NULL) {
+      return -1;
+    }
+    return reinterpret_cast<const uint8_t*>(found) - data;
+  }
   static RawOneByteString* EscapeSpecialCharacters(const String& str);
   // We use the same maximum elements for all strings.
   static const intptr_t kBytesPerElement = 1;
@@ -7677,6 +7735,7 @@ class OneByteString : public AllStatic {
 
   friend class Class;
   friend class String;
+  friend class IrregexpInterpreter;
   friend class Symbols;
   friend class ExternalOneByteString;
   friend class SnapshotReader;
@@ -7803,7 +7862,9 @@ class TwoByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class IrregexpInterpreter;
   friend class Symbols;
+  friend class Utf8;
 };
 
 class ExternalOneByteString : public AllStatic {
@@ -7893,6 +7954,7 @@ class ExternalOneByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class IrregexpInterpreter;
   friend class Symbols;
   friend class Utf8;
 };
@@ -7980,7 +8042,9 @@ class ExternalTwoByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class IrregexpInterpreter;
   friend class Symbols;
+  friend class Utf8;
 };
 
 // Class Bool implements Dart core class bool.
@@ -8028,6 +8092,9 @@ class Array : public Instance {
     ASSERT(!IsNull());
     return Smi::Value(raw_ptr()->length_);
   }
+  static intptr_t LengthOf(const RawArray* array) {
+    return Smi::Value(array->ptr()->length_);
+  }
   static intptr_t length_offset() { return OFFSET_OF(RawArray, length_); }
   static intptr_t data_offset() {
     return OFFSET_OF_RETURNED_VALUE(RawArray, data);
@@ -8188,6 +8255,12 @@ class GrowableObjectArray : public Instance {
     ASSERT(!IsNull());
     return Smi::Value(raw_ptr()->length_);
   }
+  static intptr_t CapacityOf(const RawGrowableObjectArray* array) {
+    return Smi::Value(array->ptr()->data_->ptr()->length_);
+  }
+  static intptr_t LengthOf(const RawGrowableObjectArray* array) {
+    return Smi::Value(array->ptr()->length_);
+  }
   void SetLength(intptr_t value) const {
     // This is only safe because we create a new Smi, which does not cause
     // heap allocation.
@@ -9106,6 +9179,9 @@ class RegExp : public Instance {
   intptr_t num_registers() const { return raw_ptr()->num_registers_; }
 
   RawString* pattern() const { return raw_ptr()->pattern_; }
+  // The literal text that every match starts with, or null if there is
+  // none. Set when the pattern is compiled to bytecode.
+  RawString* literal_prefix() const { return raw_ptr()->literal_prefix_; }
   RawSmi* num_bracket_expressions() const {
     return raw_ptr()->num_bracket_expressions_;
   }
@@ -9159,6 +9235,7 @@ class RegExp : public Instance {
   }
 
   void set_pattern(const String& pattern) const;
+  void set_literal_prefix(const String& prefix) const;
   void set_function(intptr_t cid, bool sticky, const Function& value) const;
   void set_bytecode(bool is_one_byte,
                     bool sticky,
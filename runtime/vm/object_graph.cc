@@ -518,13 +518,24 @@ static void WritePtr(RawObject* raw, WriteStream* stream) {
   stream->WriteUnsigned(addr / kObjectAlignment);
 }
 
+// Hands the bytes written so far to 'sink' once they fill a chunk.
+static void MaybeWriteChunk(WriteStream* stream,
+                            ObjectGraph::ChunkSink* sink) {
+  if ((sink != NULL) && (stream->bytes_written() >= sink->chunk_size())) {
+    sink->WriteChunk(stream->buffer(), stream->bytes_written());
+    stream->SetPosition(0);
+  }
+}
+
 class WritePointerVisitor : public ObjectPointerVisitor {
  public:
   WritePointerVisitor(Isolate* isolate,
                       WriteStream* stream,
+                      ObjectGraph::ChunkSink* sink,
                       bool only_instances)
       : ObjectPointerVisitor(isolate),
         stream_(stream),
+        sink_(sink),
         only_instances_(only_instances),
         count_(0) {}
   virtual void VisitPointers(RawObject** first, RawObject** last) {
@@ -541,6 +552,7 @@ class WritePointerVisitor : public ObjectPointerVisitor {
         continue;
       }
       WritePtr(object, stream_);
+      MaybeWriteChunk(stream_, sink_);
       ++count_;
     }
   }
@@ -549,6 +561,7 @@ class WritePointerVisitor : public ObjectPointerVisitor {
 
  private:
   WriteStream* stream_;
+  ObjectGraph::ChunkSink* sink_;
   bool only_instances_;
   intptr_t count_;
 };
@@ -567,9 +580,11 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
  public:
   WriteGraphVisitor(Isolate* isolate,
                     WriteStream* stream,
+                    ObjectGraph::ChunkSink* sink,
                     ObjectGraph::SnapshotRoots roots)
       : stream_(stream),
-        ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
+        sink_(sink),
+        ptr_writer_(isolate, stream, sink, roots == ObjectGraph::kUser),
         roots_(roots),
         count_(0) {}
 
@@ -585,6 +600,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
       WriteHeader(raw_obj, raw_obj->Size(), obj.GetClassId(), stream_);
       raw_obj->VisitPointers(&ptr_writer_);
       stream_->WriteUnsigned(0);
+      MaybeWriteChunk(stream_, sink_);
       ++count_;
     }
     return kProceed;
@@ -594,6 +610,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
 
  private:
   WriteStream* stream_;
+  ObjectGraph::ChunkSink* sink_;
   WritePointerVisitor ptr_writer_;
   ObjectGraph::SnapshotRoots roots_;
   intptr_t count_;
@@ -601,8 +618,10 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
 
 class WriteGraphExternalSizesVisitor : public HandleVisitor {
  public:
-  WriteGraphExternalSizesVisitor(Thread* thread, WriteStream* stream)
-      : HandleVisitor(thread), stream_(stream) {}
+  WriteGraphExternalSizesVisitor(Thread* thread,
+                                 WriteStream* stream,
+                                 ObjectGraph::ChunkSink* sink)
+      : HandleVisitor(thread), stream_(stream), sink_(sink) {}
 
   void VisitHandle(uword addr) {
     FinalizablePersistentHandle* weak_persistent_handle =
@@ -613,15 +632,18 @@ class WriteGraphExternalSizesVisitor : public HandleVisitor {
 
     WritePtr(weak_persistent_handle->raw(), stream_);
     stream_->WriteUnsigned(weak_persistent_handle->external_size());
+    MaybeWriteChunk(stream_, sink_);
   }
 
  private:
   WriteStream* stream_;
+  ObjectGraph::ChunkSink* sink_;
 };
 
 intptr_t ObjectGraph::Serialize(WriteStream* stream,
                                 SnapshotRoots roots,
-                                bool collect_garbage) {
+                                bool collect_garbage,
+                                ChunkSink* sink) {
   if (collect_garbage) {
     isolate()->heap()->CollectAllGarbage();
   }
@@ -642,7 +664,7 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
   if (roots == kVM) {
     // Write root "object".
     WriteHeader(kRootAddress, 0, kRootCid, stream);
-    WritePointerVisitor ptr_writer(isolate(), stream, false);
+    WritePointerVisitor ptr_writer(isolate(), stream, sink, false);
     isolate()->VisitObjectPointers(&ptr_writer,
                                    ValidationPolicy::kDontValidateFrames);
     stream->WriteUnsigned(0);
@@ -650,7 +672,7 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
     {
       // Write root "object".
       WriteHeader(kRootAddress, 0, kRootCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, false);
+      WritePointerVisitor ptr_writer(isolate(), stream, sink, false);
       IterateUserFields(&ptr_writer);
       WritePtr(kStackAddress, stream);
       stream->WriteUnsigned(0);
@@ -659,18 +681,19 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
     {
       // Write stack "object".
       WriteHeader(kStackAddress, 0, kStackCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, true);
+      WritePointerVisitor ptr_writer(isolate(), stream, sink, true);
       isolate()->VisitStackPointers(&ptr_writer,
                                     ValidationPolicy::kDontValidateFrames);
       stream->WriteUnsigned(0);
     }
   }
 
-  WriteGraphVisitor visitor(isolate(), stream, roots);
+  WriteGraphVisitor visitor(isolate(), stream, sink, roots);
   IterateObjects(&visitor);
   stream->WriteUnsigned(0);
 
-  WriteGraphExternalSizesVisitor external_visitor(Thread::Current(), stream);
+  WriteGraphExternalSizesVisitor external_visitor(Thread::Current(), stream,
+                                                  sink);
   isolate()->VisitWeakPersistentHandles(&external_visitor);
   stream->WriteUnsigned(0);
 
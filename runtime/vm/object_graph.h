@@ -57,6 +57,24 @@ class ObjectGraph : public StackResource {
     virtual Direction VisitObject(StackIterator* it) = 0;
   };
 
+  // Receives the serialized graph in pieces while it is being written, so
+  // the whole graph never has to be held in memory.
+  class ChunkSink {
+   public:
+    explicit ChunkSink(intptr_t chunk_size) : chunk_size_(chunk_size) {}
+    virtual ~ChunkSink() {}
+
+    intptr_t chunk_size() const { return chunk_size_; }
+
+    // Receives the next 'length' bytes of the graph. This method is called
+    // during the heap walk and must not allocate from the heap or trigger GC
+    // in any way.
+    virtual void WriteChunk(const uint8_t* bytes, intptr_t length) = 0;
+
+   private:
+    intptr_t chunk_size_;
+  };
+
   explicit ObjectGraph(Thread* thread);
   ~ObjectGraph();
 
@@ -103,10 +121,14 @@ class ObjectGraph : public StackResource {
   // Returns the number of nodes in the stream, including the root.
   // If collect_garbage is false, the graph will include weakly-reachable
   // objects.
-  // TODO(koda): Document format; support streaming/chunking.
+  // If 'sink' is not NULL, the contents of 'stream' are handed to it whenever
+  // they reach its chunk size, and 'stream' is rewound. The bytes left in
+  // 'stream' on return are the end of the graph.
+  // TODO(koda): Document format.
   intptr_t Serialize(WriteStream* stream,
                      SnapshotRoots roots,
-                     bool collect_garbage);
+                     bool collect_garbage,
+                     ChunkSink* sink = NULL);
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectGraph);
@@ -4,6 +4,8 @@
 
 #include "vm/object_graph.h"
 #include "platform/assert.h"
+#include "vm/datastream.h"
+#include "vm/growable_array.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -138,4 +140,61 @@ ISOLATE_UNIT_TEST_CASE(ObjectGraph) {
   }
 }
 
+static uint8_t* MallocAllocator(uint8_t* ptr,
+                                intptr_t old_size,
+                                intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
+}
+
+class CollectingChunkSink : public ObjectGraph::ChunkSink {
+ public:
+  explicit CollectingChunkSink(intptr_t chunk_size)
+      : ObjectGraph::ChunkSink(chunk_size), bytes_(KB), num_chunks_(0) {}
+
+  virtual void WriteChunk(const uint8_t* bytes, intptr_t length) {
+    EXPECT_LE(chunk_size(), length);
+    for (intptr_t i = 0; i < length; i++) {
+      bytes_.Add(bytes[i]);
+    }
+    ++num_chunks_;
+  }
+
+  MallocGrowableArray<uint8_t>* bytes() { return &bytes_; }
+  intptr_t num_chunks() const { return num_chunks_; }
+
+ private:
+  MallocGrowableArray<uint8_t> bytes_;
+  intptr_t num_chunks_;
+};
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraph_SerializeInChunks) {
+  Array& array = Array::Handle(Array::New(100, Heap::kOld));
+  for (intptr_t i = 0; i < array.Length(); i++) {
+    array.SetAt(i, Array::Handle(Array::New(1, Heap::kOld)));
+  }
+  ObjectGraph graph(thread);
+
+  uint8_t* whole = NULL;
+  WriteStream whole_stream(&whole, MallocAllocator, KB);
+  const intptr_t node_count =
+      graph.Serialize(&whole_stream, ObjectGraph::kVM, false);
+
+  // The same graph handed out in small chunks, with the end left in the
+  // stream, gives the same bytes.
+  uint8_t* end = NULL;
+  WriteStream end_stream(&end, MallocAllocator, KB);
+  CollectingChunkSink sink(256);
+  EXPECT_EQ(node_count,
+            graph.Serialize(&end_stream, ObjectGraph::kVM, false, &sink));
+  EXPECT_LT(1, sink.num_chunks());
+  EXPECT_LT(end_stream.bytes_written(), 256 + KB);
+  for (intptr_t i = 0; i < end_stream.bytes_written(); i++) {
+    sink.bytes()->Add(end[i]);
+  }
+  EXPECT_EQ(whole_stream.bytes_written(), sink.bytes()->length());
+  EXPECT_EQ(0, memcmp(whole, sink.bytes()->data(), sink.bytes()->length()));
+  free(whole);
+  free(end);
+}
+
 }  // namespace dart
@@ -44,7 +44,7 @@ int32_t ObjectIdRing::GetIdForObject(RawObject* object, IdPolicy policy) {
 }
 
 int32_t ObjectIdRing::FindExistingIdForObject(RawObject* raw_obj) {
-  for (int32_t i = 0; i < capacity_; i++) {
+  for (int32_t i = 0; i < used_; i++) {
     if (table_[i] == raw_obj) {
       return IdOfIndex(i);
     }
@@ -71,7 +71,9 @@ RawObject* ObjectIdRing::GetObjectForId(int32_t id, LookupResult* kind) {
 
 void ObjectIdRing::VisitPointers(ObjectPointerVisitor* visitor) {
   ASSERT(table_ != NULL);
-  visitor->VisitPointers(table_, capacity_);
+  if (used_ > 0) {
+    visitor->VisitPointers(table_, used_);
+  }
 }
 
 void ObjectIdRing::PrintJSON(JSONStream* js) {
@@ -84,7 +86,7 @@ void ObjectIdRing::PrintJSON(JSONStream* js) {
   {
     JSONArray objects(&jsobj, "objects");
     Object& obj = Object::Handle();
-    for (int32_t i = 0; i < capacity_; i++) {
+    for (int32_t i = 0; i < used_; i++) {
       obj = table_[i];
       if (obj.IsNull()) {
         // Collected object.
@@ -108,6 +110,7 @@ void ObjectIdRing::SetCapacityAndMaxSerial(int32_t capacity,
                                            int32_t max_serial) {
   ASSERT(max_serial <= kMaxId);
   capacity_ = capacity;
+  used_ = 0;
   if (table_ != NULL) {
     free(table_);
   }
@@ -137,6 +140,9 @@ int32_t ObjectIdRing::AllocateNewId(RawObject* raw_obj) {
   int32_t index = IndexOfId(id);
   ASSERT(index != kInvalidId);
   table_[index] = raw_obj;
+  if (index >= used_) {
+    used_ = index + 1;
+  }
   return id;
 }
 
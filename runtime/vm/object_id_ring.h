@@ -66,6 +66,9 @@ class ObjectIdRing {
   RawObject** table_;
   int32_t max_serial_;
   int32_t capacity_;
+  // Number of leading table_ entries that have ever been assigned. Entries
+  // past it are still null, so GC visits and lookups can skip them.
+  int32_t used_;
   int32_t serial_num_;
   bool wrapped_;
 
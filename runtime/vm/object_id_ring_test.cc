@@ -42,6 +42,8 @@ class ObjectIdRingTestHelper {
     return Symbols::New(Thread::Current(), s);
   }
 
+  static intptr_t Used(ObjectIdRing* ring) { return ring->used_; }
+
   static void ExpectString(RawObject* obj, const char* s) {
     String& str = String::Handle();
     str ^= obj;
@@ -271,6 +273,51 @@ ISOLATE_UNIT_TEST_CASE(ObjectIdRingExpiredEntryTest) {
   EXPECT_EQ(Object::null(), obj_lookup);
 }
 
+class CountingPointerVisitor : public ObjectPointerVisitor {
+ public:
+  explicit CountingPointerVisitor(Isolate* isolate)
+      : ObjectPointerVisitor(isolate), count_(0) {}
+
+  void VisitPointers(RawObject** first, RawObject** last) {
+    count_ += last - first + 1;
+  }
+
+  intptr_t count() const { return count_; }
+
+ private:
+  intptr_t count_;
+};
+
+// Test that only the assigned part of the ring is visited.
+ISOLATE_UNIT_TEST_CASE(ObjectIdRingVisitUsedEntriesTest) {
+  Isolate* isolate = Isolate::Current();
+  ObjectIdRing* ring = isolate->object_id_ring();
+  ObjectIdRingTestHelper::SetCapacityAndMaxSerial(ring, 16, 32);
+  {
+    CountingPointerVisitor visitor(isolate);
+    ring->VisitPointers(&visitor);
+    EXPECT_EQ(0, visitor.count());
+  }
+  for (intptr_t i = 0; i < 3; i++) {
+    ring->GetIdForObject(ObjectIdRingTestHelper::MakeString("a"));
+  }
+  EXPECT_EQ(3, ObjectIdRingTestHelper::Used(ring));
+  {
+    CountingPointerVisitor visitor(isolate);
+    ring->VisitPointers(&visitor);
+    EXPECT_EQ(3, visitor.count());
+  }
+  for (intptr_t i = 0; i < 20; i++) {
+    ring->GetIdForObject(ObjectIdRingTestHelper::MakeString("b"));
+  }
+  EXPECT_EQ(16, ObjectIdRingTestHelper::Used(ring));
+  {
+    CountingPointerVisitor visitor(isolate);
+    ring->VisitPointers(&visitor);
+    EXPECT_EQ(16, visitor.count());
+  }
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
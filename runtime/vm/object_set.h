@@ -8,6 +8,7 @@
 #include "platform/utils.h"
 #include "vm/bit_vector.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/raw_object.h"
 #include "vm/zone.h"
 
@@ -18,8 +19,10 @@ class ObjectSetRegion : public ZoneAllocated {
   ObjectSetRegion(Zone* zone, uword start, uword end)
       : start_(start),
         end_(end),
-        bit_vector_(zone, (end - start) >> kWordSizeLog2),
-        next_(NULL) {}
+        bit_vector_(zone, (end - start) >> kWordSizeLog2) {}
+
+  uword start() const { return start_; }
+  uword end() const { return end_; }
 
   bool ContainsAddress(uword address) {
     return address >= start_ && address < end_;
@@ -36,51 +39,71 @@ class ObjectSetRegion : public ZoneAllocated {
     return bit_vector_.Contains(IndexForAddress(address));
   }
 
-  ObjectSetRegion* next() { return next_; }
-  void set_next(ObjectSetRegion* region) { next_ = region; }
-
  private:
   uword start_;
   uword end_;
   BitVector bit_vector_;
-  ObjectSetRegion* next_;
 };
 
 class ObjectSet : public ZoneAllocated {
  public:
-  explicit ObjectSet(Zone* zone) : zone_(zone), head_(NULL) {}
+  explicit ObjectSet(Zone* zone)
+      : zone_(zone), regions_(zone, 16), last_region_(NULL) {}
 
   void AddRegion(uword start, uword end) {
     ObjectSetRegion* region = new (zone_) ObjectSetRegion(zone_, start, end);
-    region->set_next(head_);
-    head_ = region;
+    // Keep the regions sorted by start address, so that lookups stay
+    // logarithmic in the number of heap pages.
+    regions_.Add(region);
+    intptr_t i = regions_.length() - 1;
+    while ((i > 0) && (regions_[i - 1]->start() > start)) {
+      regions_[i] = regions_[i - 1];
+      i--;
+    }
+    regions_[i] = region;
   }
 
   bool Contains(RawObject* raw_obj) const {
     uword raw_addr = RawObject::ToAddr(raw_obj);
-    for (ObjectSetRegion* region = head_; region != NULL;
-         region = region->next()) {
-      if (region->ContainsAddress(raw_addr)) {
-        return region->ContainsObject(raw_addr);
-      }
-    }
-    return false;
+    ObjectSetRegion* region = FindRegion(raw_addr);
+    return (region != NULL) && region->ContainsObject(raw_addr);
   }
 
   void Add(RawObject* raw_obj) {
     uword raw_addr = RawObject::ToAddr(raw_obj);
-    for (ObjectSetRegion* region = head_; region != NULL;
-         region = region->next()) {
-      if (region->ContainsAddress(raw_addr)) {
-        return region->AddObject(raw_addr);
-      }
+    ObjectSetRegion* region = FindRegion(raw_addr);
+    if (region == NULL) {
+      FATAL("Address not in any heap region");
     }
-    FATAL("Address not in any heap region");
+    region->AddObject(raw_addr);
   }
 
  private:
+  ObjectSetRegion* FindRegion(uword address) const {
+    // Objects are mostly added in address order, so try the last hit first.
+    if ((last_region_ != NULL) && last_region_->ContainsAddress(address)) {
+      return last_region_;
+    }
+    intptr_t lo = 0;
+    intptr_t hi = regions_.length() - 1;
+    while (lo <= hi) {
+      const intptr_t mid = lo + (hi - lo) / 2;
+      ObjectSetRegion* region = regions_[mid];
+      if (address < region->start()) {
+        hi = mid - 1;
+      } else if (address >= region->end()) {
+        lo = mid + 1;
+      } else {
+        last_region_ = region;
+        return region;
+      }
+    }
+    return NULL;
+  }
+
   Zone* zone_;
-  ObjectSetRegion* head_;
+  GrowableArray<ObjectSetRegion*> regions_;
+  mutable ObjectSetRegion* last_region_;
 };
 
 }  // namespace dart
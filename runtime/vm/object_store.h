@@ -129,6 +129,9 @@ class ObjectPointerVisitor;
   RW(Array, obfuscation_map)                                                   \
   RW(GrowableObjectArray, type_testing_stubs)                                  \
   RW(GrowableObjectArray, changed_in_last_reload)                              \
+  RW(Array, message_class_cache)                                               \
+  RW(GrowableObjectArray, startup_functions)                                   \
+  RW(Array, osr_code_cache)                                                    \
 // Please remember the last entry must be referred in the 'to' function below.
 
 // The object store is a per isolate instance which stores references to
@@ -221,7 +224,7 @@ class ObjectStore {
                           DECLARE_OBJECT_STORE_FIELD)
 #undef DECLARE_OBJECT_STORE_FIELD
   RawObject** to() {
-    return reinterpret_cast<RawObject**>(&changed_in_last_reload_);
+    return reinterpret_cast<RawObject**>(&osr_code_cache_);
   }
   RawObject** to_snapshot(Snapshot::Kind kind) {
     switch (kind) {
@@ -15,6 +15,7 @@
 #include "vm/debugger_api_impl_test.h"
 #include "vm/isolate.h"
 #include "vm/malloc_hooks.h"
+#include "vm/megamorphic_cache_table.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/simulator.h"
@@ -23,6 +24,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, lazy_toplevel_loading);
 DECLARE_FLAG(bool, write_protect_code);
 
 static RawClass* CreateDummyClass(const String& class_name,
@@ -335,6 +337,38 @@ ISOLATE_UNIT_TEST_CASE(StringCompareTo) {
   EXPECT(monkey_face.CompareTo(abce) > 0);
 }
 
+ISOLATE_UNIT_TEST_CASE(StringIndexOf) {
+  const String& str = String::Handle(
+      String::New("abcabdabcabcabdxyzabcabdabcabcabdxyz"));
+  const String& abd = String::Handle(String::New("abd"));
+  const String& xyz = String::Handle(String::New("xyz"));
+  const String& empty = String::Handle(String::New(""));
+  EXPECT_EQ(3, String::IndexOf(str, abd, 0));
+  EXPECT_EQ(12, String::IndexOf(str, abd, 4));
+  EXPECT_EQ(15, String::IndexOf(str, xyz, 0));
+  EXPECT_EQ(33, String::IndexOf(str, xyz, 16));
+  EXPECT_EQ(-1, String::IndexOf(str, xyz, 34));
+  EXPECT_EQ(5, String::IndexOf(str, empty, 5));
+  EXPECT_EQ(-1, String::IndexOf(str, str, 1));
+  EXPECT_EQ(0, String::IndexOf(str, str, 0));
+  EXPECT_EQ(2, OneByteString::IndexOf(str, 'c', 0));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, 'q', 0));
+
+  // Two-byte strings, and strings of different widths.
+  const uint16_t kTwoByte[] = {'a', 0x1234, 'b', 'a', 0x1234, 'c', 'x'};
+  const String& two_byte =
+      String::Handle(String::FromUTF16(kTwoByte, ARRAY_SIZE(kTwoByte)));
+  const uint16_t kPattern[] = {0x1234, 'c'};
+  const String& pattern =
+      String::Handle(String::FromUTF16(kPattern, ARRAY_SIZE(kPattern)));
+  EXPECT(two_byte.IsTwoByteString());
+  EXPECT_EQ(4, String::IndexOf(two_byte, pattern, 0));
+  EXPECT_EQ(-1, String::IndexOf(str, pattern, 0));
+  const String& cx = String::Handle(String::New("cx"));
+  EXPECT_EQ(5, String::IndexOf(two_byte, cx, 0));
+  EXPECT_EQ(-1, String::IndexOf(two_byte, abd, 0));
+}
+
 ISOLATE_UNIT_TEST_CASE(StringEncodeIRI) {
   const char* kInput =
       "file:///usr/local/johnmccutchan/workspace/dart-repo/dart/test.dart";
@@ -1754,6 +1788,26 @@ ISOLATE_UNIT_TEST_CASE(SymbolUnicode) {
   EXPECT_EQ(cat2.raw(), cat.raw());
 }
 
+ISOLATE_UNIT_TEST_CASE(SymbolOneChar) {
+  const String& t = String::Handle(Symbols::New(thread, "T"));
+  EXPECT(t.IsSymbol());
+  EXPECT(t.raw()->IsVMHeapObject());
+  EXPECT_EQ(Symbols::FromCharCode(thread, 'T'), t.raw());
+  uint16_t t_utf16[] = {'T'};
+  EXPECT_EQ(t.raw(), Symbols::FromUTF16(thread, t_utf16, 1));
+  int32_t t_utf32[] = {'T'};
+  EXPECT_EQ(t.raw(), Symbols::FromUTF32(thread, t_utf32, 1));
+  const String& str = String::Handle(String::New("ATB"));
+  EXPECT_EQ(t.raw(), Symbols::New(thread, str, 1, 1));
+
+  // Characters outside Latin1 still go through the symbol table.
+  uint16_t omega_utf16[] = {0x3a9};
+  const String& omega =
+      String::Handle(Symbols::FromUTF16(thread, omega_utf16, 1));
+  EXPECT(omega.IsSymbol());
+  EXPECT_EQ(omega.raw(), Symbols::FromCharCode(thread, 0x3a9));
+}
+
 ISOLATE_UNIT_TEST_CASE(Bool) {
   EXPECT(Bool::True().value());
   EXPECT(!Bool::False().value());
@@ -1979,6 +2033,55 @@ ISOLATE_UNIT_TEST_CASE(StringCodePointIteratorRange) {
   EXPECT(!it1.Next());
 }
 
+// Fills 'array' with new-space strings "0", "1", ...
+static void FillWithNewStrings(const Array& array) {
+  String& str = String::Handle();
+  char buffer[16];
+  for (intptr_t i = 0; i < array.Length(); i++) {
+    Utils::SNPrint(buffer, sizeof(buffer), "%" Pd, i);
+    str = String::New(buffer, Heap::kNew);
+    array.SetAt(i, str);
+  }
+}
+
+static void ExpectGrownStrings(const Array& array, intptr_t used) {
+  String& str = String::Handle();
+  char buffer[16];
+  for (intptr_t i = 0; i < used; i++) {
+    Utils::SNPrint(buffer, sizeof(buffer), "%" Pd, i);
+    str ^= array.At(i);
+    EXPECT(str.Equals(buffer));
+  }
+  for (intptr_t i = used; i < array.Length(); i++) {
+    EXPECT(array.At(i) == Object::null());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(Array_Grow) {
+  const intptr_t kLength = 100;
+  Array& source = Array::Handle(Array::New(kLength, Heap::kOld));
+  FillWithNewStrings(source);
+
+  // Into new space, where the elements are copied in bulk.
+  Array& grown = Array::Handle(Array::Grow(source, 2 * kLength, Heap::kNew));
+  EXPECT(grown.raw()->IsNewObject());
+  EXPECT_EQ(2 * kLength, grown.Length());
+  for (intptr_t i = 0; i < kLength; i++) {
+    EXPECT(grown.At(i) == source.At(i));
+  }
+  ExpectGrownStrings(grown, kLength);
+
+  // Into old space, where the copy must record the new-space elements so
+  // that they survive a scavenge through the grown array alone.
+  source = Array::New(kLength, Heap::kNew);
+  FillWithNewStrings(source);
+  grown = Array::Grow(source, 2 * kLength, Heap::kOld);
+  EXPECT(grown.raw()->IsOldObject());
+  source = Array::null();
+  Isolate::Current()->heap()->CollectGarbage(Heap::kNew);
+  ExpectGrownStrings(grown, kLength);
+}
+
 ISOLATE_UNIT_TEST_CASE(GrowableObjectArray) {
   const int kArrayLen = 5;
   Smi& value = Smi::Handle();
@@ -2869,6 +2972,47 @@ ISOLATE_UNIT_TEST_CASE(ICData) {
   EXPECT_EQ(target1.raw(), scall_icdata.GetTargetAt(0));
 }
 
+ISOLATE_UNIT_TEST_CASE(MegamorphicCache) {
+  Isolate* isolate = thread->isolate();
+  const String& target_name = String::Handle(Symbols::New(thread, "Thun"));
+  const intptr_t kTypeArgsLen = 0;
+  const intptr_t kNumArgs = 1;
+  const Array& args_descriptor = Array::Handle(
+      ArgumentsDescriptor::New(kTypeArgsLen, kNumArgs, Object::null_array()));
+  const MegamorphicCache& cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(isolate, target_name, args_descriptor));
+  EXPECT_EQ(target_name.raw(), cache.target_name());
+  EXPECT_EQ(args_descriptor.raw(), cache.arguments_descriptor());
+  EXPECT_EQ(cache.raw(), MegamorphicCacheTable::Lookup(isolate, target_name,
+                                                       args_descriptor));
+
+  const Smi& smi_cid = Smi::Handle(Smi::New(kSmiCid));
+  const Smi& double_cid = Smi::Handle(Smi::New(kDoubleCid));
+  EXPECT(cache.Lookup(smi_cid) == Object::null());
+
+  const Function& target1 = Function::Handle(GetDummyTarget("Thun"));
+  const Function& target2 = Function::Handle(GetDummyTarget("Thun"));
+  cache.EnsureCapacity();
+  cache.Insert(smi_cid, target1);
+  cache.EnsureCapacity();
+  cache.Insert(double_cid, target2);
+  EXPECT_EQ(2, cache.filled_entry_count());
+  EXPECT_EQ(target1.raw(), cache.Lookup(smi_cid));
+  EXPECT_EQ(target2.raw(), cache.Lookup(double_cid));
+
+  // Entries stay reachable when the cache grows.
+  for (intptr_t cid = kNumPredefinedCids; cid < kNumPredefinedCids + 64;
+       cid++) {
+    cache.EnsureCapacity();
+    cache.Insert(Smi::Handle(Smi::New(cid)), target2);
+  }
+  EXPECT_EQ(target1.raw(), cache.Lookup(smi_cid));
+  EXPECT_EQ(target2.raw(),
+            cache.Lookup(Smi::Handle(Smi::New(kNumPredefinedCids + 63))));
+  EXPECT(cache.Lookup(Smi::Handle(Smi::New(kNumPredefinedCids + 64))) ==
+         Object::null());
+}
+
 ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   String& class_name = String::Handle(Symbols::New(thread, "EmptyClass"));
   Script& script = Script::Handle();
@@ -2902,6 +3046,28 @@ ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   EXPECT_EQ(Bool::True().raw(), test_result.raw());
 }
 
+ISOLATE_UNIT_TEST_CASE(SubtypeTestCache_Grow) {
+  SubtypeTestCache& cache = SubtypeTestCache::Handle(SubtypeTestCache::New());
+  const TypeArguments& targ = TypeArguments::Handle(TypeArguments::New(2));
+  Object& class_id_or_fun = Object::Handle();
+  for (intptr_t i = 0; i < 20; i++) {
+    class_id_or_fun = Smi::New(kNumPredefinedCids + i);
+    cache.AddCheck(class_id_or_fun, targ, targ, targ, targ, targ,
+                   (i % 2 == 0) ? Bool::True() : Bool::False());
+    EXPECT_EQ(i + 1, cache.NumberOfChecks());
+  }
+  TypeArguments& test_targ = TypeArguments::Handle();
+  Bool& test_result = Bool::Handle();
+  for (intptr_t i = 0; i < 20; i++) {
+    cache.GetCheck(i, &class_id_or_fun, &test_targ, &test_targ, &test_targ,
+                   &test_targ, &test_targ, &test_result);
+    EXPECT_EQ(Smi::New(kNumPredefinedCids + i), class_id_or_fun.raw());
+    EXPECT_EQ(targ.raw(), test_targ.raw());
+    EXPECT_EQ(((i % 2) == 0) ? Bool::True().raw() : Bool::False().raw(),
+              test_result.raw());
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(FieldTests) {
   const String& f = String::Handle(String::New("oneField"));
   const String& getter_f = String::Handle(Field::GetterName(f));
@@ -3506,6 +3672,45 @@ ISOLATE_UNIT_TEST_CASE(WeakProperty_ClearTwoShared_OldSpace) {
   EXPECT(weak2.value() == Object::null());
 }
 
+ISOLATE_UNIT_TEST_CASE(WeakProperty_PreserveChain_OldSpace) {
+  Isolate* isolate = Isolate::Current();
+  // Each property's value is the key of the previous one, so the keys only
+  // become reachable one at a time, starting from the last property.
+  const intptr_t kLength = 1000;
+  const Array& weaks = Array::Handle(Array::New(kLength, Heap::kOld));
+  const Array& root = Array::Handle(Array::New(1, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& key = Array::Handle();
+    Array& value = Array::Handle(Array::New(0, Heap::kOld));
+    WeakProperty& weak = WeakProperty::Handle();
+    for (intptr_t i = 0; i < kLength; i++) {
+      key = Array::New(0, Heap::kOld);
+      weak ^= WeakProperty::New(Heap::kOld);
+      weak.set_key(key);
+      weak.set_value(value);
+      weaks.SetAt(i, weak);
+      value = key.raw();
+    }
+    root.SetAt(0, key);
+  }
+  isolate->heap()->CollectAllGarbage();
+  WeakProperty& weak = WeakProperty::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    weak ^= weaks.At(i);
+    EXPECT(weak.key() != Object::null());
+    EXPECT(weak.value() != Object::null());
+  }
+  // Dropping the root key clears the whole chain.
+  root.SetAt(0, Object::null_object());
+  isolate->heap()->CollectAllGarbage();
+  for (intptr_t i = 0; i < kLength; i++) {
+    weak ^= weaks.At(i);
+    EXPECT(weak.key() == Object::null());
+    EXPECT(weak.value() == Object::null());
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(MirrorReference) {
   const MirrorReference& reference =
       MirrorReference::Handle(MirrorReference::New(Object::Handle()));
@@ -3852,6 +4057,52 @@ TEST_CASE(FunctionWithBreakpointNotInlined) {
   EXPECT(!func_b.CanBeInlined());
 }
 
+static void InvokeWithInt(Dart_Handle lib, const char* name, intptr_t n) {
+  Dart_Handle args[1] = {Dart_NewInteger(1)};
+  for (intptr_t i = 0; i < n; i++) {
+    EXPECT_VALID(Dart_Invoke(lib, NewString(name), 1, args));
+  }
+}
+
+TEST_CASE(BreakpointDeoptimizesOnlyInliningCode) {
+  const char* kScriptChars =
+      "int inner(int x) {\n"
+      "  return x + 1;\n"  // This is line 2.
+      "}\n"
+      "int outer(int x) => inner(x) * 2;\n"
+      "int other(int x) => x * 3;\n";
+  const int kBreakpointLine = 2;
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 10);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  InvokeWithInt(lib, "outer", 50);
+  InvokeWithInt(lib, "other", 50);
+
+  Function& outer = Function::Handle();
+  Function& other = Function::Handle();
+  {
+    TransitionNativeToVM transition(thread);
+    const String& name = String::Handle(String::New(TestCase::url()));
+    const Library& vmlib =
+        Library::Handle(Library::LookupLibrary(thread, name));
+    EXPECT(!vmlib.IsNull());
+    outer = vmlib.LookupLocalFunction(
+        String::Handle(Symbols::New(thread, "outer")));
+    other = vmlib.LookupLocalFunction(
+        String::Handle(Symbols::New(thread, "other")));
+  }
+  EXPECT(outer.HasOptimizedCode());
+  EXPECT(other.HasOptimizedCode());
+
+  // Only code that inlines the function with the breakpoint is deoptimized.
+  Dart_Handle result =
+      Dart_SetBreakpoint(NewString(TestCase::url()), kBreakpointLine);
+  EXPECT_VALID(result);
+  EXPECT(!outer.HasOptimizedCode());
+  EXPECT(other.HasOptimizedCode());
+}
+
 ISOLATE_UNIT_TEST_CASE(SpecialClassesHaveEmptyArrays) {
   ObjectStore* object_store = Isolate::Current()->object_store();
   Class& cls = Class::Handle();
@@ -4453,6 +4704,120 @@ ISOLATE_UNIT_TEST_CASE(String_ScrubName) {
   }
 }
 
+TEST_CASE(LazyTopLevelLoading) {
+  const char* kScript =
+      "int counter = 40;\n"
+      "int helper(int x) => x + 1;\n"
+      "const helpers = const [helper];\n"
+      "class A {\n"
+      "  int bump() => helpers[0](counter);\n"
+      "}\n"
+      "int main() => new A().bump() + 1;\n";
+  SetFlagScope<bool> sfs(&FLAG_lazy_toplevel_loading, true);
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(h_lib);
+  Dart_Handle h_result = Dart_Invoke(h_lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(h_result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(h_result, &value));
+  EXPECT_EQ(42, value);
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Class& toplevel_class = Class::Handle(lib.toplevel_class());
+  EXPECT_EQ(0, toplevel_class.kernel_offset());
+  const Field& field = Field::Handle(
+      lib.LookupLocalField(String::Handle(String::New("counter"))));
+  EXPECT(!field.IsNull());
+}
+
+class ScriptSourceReader : public ThreadPool::Task {
+ public:
+  ScriptSourceReader(Isolate* isolate,
+                     const Script& script,
+                     Monitor* monitor,
+                     bool* done,
+                     bool* has_source,
+                     bool* decoded)
+      : isolate_(isolate),
+        script_(script),
+        monitor_(monitor),
+        done_(done),
+        has_source_(has_source),
+        decoded_(decoded) {}
+
+  virtual void Run() {
+    Thread::EnterIsolateAsHelper(isolate_, Thread::kUnknownTask);
+    {
+      Thread* thread = Thread::Current();
+      StackZone stack_zone(thread);
+      HANDLESCOPE(thread);
+      *has_source_ = script_.HasSource();
+      *decoded_ = script_.Source() != String::null();
+    }
+    Thread::ExitIsolateAsHelper();
+    MonitorLocker ml(monitor_);
+    *done_ = true;
+    ml.Notify();
+  }
+
+ private:
+  Isolate* isolate_;
+  const Script& script_;
+  Monitor* monitor_;
+  bool* done_;
+  bool* has_source_;
+  bool* decoded_;
+};
+
+static void RunScriptSourceReader(Isolate* isolate,
+                                  const Script& script,
+                                  bool* has_source,
+                                  bool* decoded) {
+  Monitor monitor;
+  bool done = false;
+  Dart::thread_pool()->Run(new ScriptSourceReader(
+      isolate, script, &monitor, &done, has_source, decoded));
+  MonitorLocker ml(&monitor);
+  while (!done) {
+    ml.Wait();
+  }
+}
+
+TEST_CASE(KernelScriptSource) {
+  const char* kScript =
+      "int main() {\n"
+      "  return 42;\n"
+      "}\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(h_lib);
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Array& scripts = Array::Handle(lib.LoadedScripts());
+  EXPECT(scripts.Length() > 0);
+  Script& script = Script::Handle();
+  script ^= scripts.At(0);
+  EXPECT_EQ(RawScript::kKernelTag, script.kind());
+
+  // A helper thread sees that the source is there, but does not decode it.
+  bool has_source = false;
+  bool decoded = true;
+  RunScriptSourceReader(thread->isolate(), script, &has_source, &decoded);
+  EXPECT(has_source);
+  EXPECT(!decoded);
+
+  // The source is decoded from the kernel binary on first use.
+  EXPECT(script.HasSource());
+  EXPECT_STREQ(kScript, String::Handle(script.Source()).ToCString());
+
+  RunScriptSourceReader(thread->isolate(), script, &has_source, &decoded);
+  EXPECT(has_source);
+  EXPECT(decoded);
+}
+
 ISOLATE_UNIT_TEST_CASE(String_EqualsUTF32) {
   // Regression test for Issue 27433. Checks that comparisons between Strings
   // and utf32 arrays happens after conversion to utf16 instead of utf32, as
@@ -37,6 +37,7 @@ OSThread::OSThread()
       timeline_block_(NULL),
       thread_list_next_(NULL),
       thread_interrupt_disabled_(1),  // Thread interrupts disabled by default.
+      blocked_wait_depth_(0),
       log_(new class Log()),
       stack_base_(0),
       stack_limit_(0),
@@ -132,6 +133,21 @@ bool OSThread::ThreadInterruptsEnabled() {
   return AtomicOperations::LoadRelaxed(&thread_interrupt_disabled_) == 0;
 }
 
+void OSThread::EnterBlockedWait() {
+  ASSERT(OSThread::Current() == this);
+  AtomicOperations::FetchAndIncrement(&blocked_wait_depth_);
+}
+
+void OSThread::ExitBlockedWait() {
+  ASSERT(OSThread::Current() == this);
+  ASSERT(IsInBlockedWait());
+  AtomicOperations::FetchAndDecrement(&blocked_wait_depth_);
+}
+
+bool OSThread::IsInBlockedWait() {
+  return AtomicOperations::LoadRelaxed(&blocked_wait_depth_) != 0;
+}
+
 static void DeleteThread(void* thread) {
   delete reinterpret_cast<OSThread*>(thread);
 }
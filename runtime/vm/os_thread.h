@@ -134,6 +134,12 @@ class OSThread : public BaseThread {
   void EnableThreadInterrupts();
   bool ThreadInterruptsEnabled();
 
+  // Used to mark the thread as blocked waiting on a monitor. The thread
+  // interrupter does not sample blocked threads.
+  void EnterBlockedWait();
+  void ExitBlockedWait();
+  bool IsInBlockedWait();
+
   // The currently executing thread, or NULL if not yet initialized.
   static OSThread* TryCurrent() {
     BaseThread* thread = GetCurrentTLS();
@@ -199,6 +205,15 @@ class OSThread : public BaseThread {
   static ThreadId ThreadIdFromIntPtr(intptr_t id);
   static bool Compare(ThreadId a, ThreadId b);
 
+  // NUMA topology. Where it is not supported there is a single node 0 and
+  // binding fails.
+  static const intptr_t kAnyNumaNode = -1;
+  static intptr_t NumberOfNumaNodes();
+  static intptr_t GetCurrentNumaNode();
+  // Restricts the current thread to the CPUs of the given node, or lifts the
+  // restriction for kAnyNumaNode. Returns false on failure.
+  static bool BindCurrentThreadToNumaNode(intptr_t node);
+
   // This function can be called only once per OSThread, and should only be
   // called when the retunred id will eventually be passed to OSThread::Join().
   static ThreadJoinId GetCurrentThreadJoinId(OSThread* thread);
@@ -259,6 +274,7 @@ class OSThread : public BaseThread {
   OSThread* thread_list_next_;
 
   uintptr_t thread_interrupt_disabled_;
+  uintptr_t blocked_wait_depth_;
   Log* log_;
   uword stack_base_;
   uword stack_limit_;
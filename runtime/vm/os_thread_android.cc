@@ -224,6 +224,18 @@ bool OSThread::Compare(ThreadId a, ThreadId b) {
   return a == b;
 }
 
+intptr_t OSThread::NumberOfNumaNodes() {
+  return 1;
+}
+
+intptr_t OSThread::GetCurrentNumaNode() {
+  return 0;
+}
+
+bool OSThread::BindCurrentThreadToNumaNode(intptr_t node) {
+  return false;
+}
+
 bool OSThread::GetCurrentStackBounds(uword* lower, uword* upper) {
   pthread_attr_t attr;
   // May fail on the main thread.
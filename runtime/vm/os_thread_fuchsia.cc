@@ -212,6 +212,18 @@ bool OSThread::Compare(ThreadId a, ThreadId b) {
   return pthread_equal(a, b) != 0;
 }
 
+intptr_t OSThread::NumberOfNumaNodes() {
+  return 1;
+}
+
+intptr_t OSThread::GetCurrentNumaNode() {
+  return 0;
+}
+
+bool OSThread::BindCurrentThreadToNumaNode(intptr_t node) {
+  return false;
+}
+
 bool OSThread::GetCurrentStackBounds(uword* lower, uword* upper) {
   pthread_attr_t attr;
   if (pthread_getattr_np(pthread_self(), &attr) != 0) {
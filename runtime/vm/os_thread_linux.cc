@@ -9,6 +9,9 @@
 #include "vm/os_thread.h"
 
 #include <errno.h>         // NOLINT
+#include <sched.h>         // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/syscall.h>   // NOLINT
 #include <sys/time.h>      // NOLINT
@@ -226,6 +229,99 @@ bool OSThread::Compare(ThreadId a, ThreadId b) {
   return pthread_equal(a, b) != 0;
 }
 
+// The CPUs of each NUMA node, read from sysfs on first use.
+static const intptr_t kMaxNumaNodes = 64;
+static pthread_once_t numa_once = PTHREAD_ONCE_INIT;
+static intptr_t num_numa_nodes = 1;
+static cpu_set_t numa_node_cpus[kMaxNumaNodes];
+static cpu_set_t numa_all_cpus;
+
+// Parses a cpulist such as "0-3,8-11".
+static bool ParseCpuList(const char* list, cpu_set_t* cpus) {
+  CPU_ZERO(cpus);
+  const char* current = list;
+  while ((*current != '\0') && (*current != '\n')) {
+    char* end;
+    intptr_t first = strtol(current, &end, 10);
+    if (end == current) {
+      return false;
+    }
+    intptr_t last = first;
+    if (*end == '-') {
+      current = end + 1;
+      last = strtol(current, &end, 10);
+      if (end == current) {
+        return false;
+      }
+    }
+    for (intptr_t cpu = first; (cpu <= last) && (cpu < CPU_SETSIZE); cpu++) {
+      CPU_SET(cpu, cpus);
+    }
+    current = (*end == ',') ? end + 1 : end;
+  }
+  return true;
+}
+
+static void InitNumaTopology() {
+  CPU_ZERO(&numa_all_cpus);
+  intptr_t nodes = 0;
+  for (; nodes < kMaxNumaNodes; nodes++) {
+    char path[64];
+    Utils::SNPrint(path, sizeof(path),
+                   "/sys/devices/system/node/node%" Pd "/cpulist", nodes);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+      break;
+    }
+    char list[1024];
+    bool ok = (fgets(list, sizeof(list), file) != NULL) &&
+              ParseCpuList(list, &numa_node_cpus[nodes]);
+    fclose(file);
+    if (!ok) {
+      break;
+    }
+    CPU_OR(&numa_all_cpus, &numa_all_cpus, &numa_node_cpus[nodes]);
+  }
+  num_numa_nodes = (nodes > 0) ? nodes : 1;
+  if (nodes == 0) {
+    // No sysfs: treat the CPUs we may run on as a single node.
+    if (sched_getaffinity(0, sizeof(numa_all_cpus), &numa_all_cpus) != 0) {
+      CPU_ZERO(&numa_all_cpus);
+    }
+    numa_node_cpus[0] = numa_all_cpus;
+  }
+}
+
+intptr_t OSThread::NumberOfNumaNodes() {
+  pthread_once(&numa_once, InitNumaTopology);
+  return num_numa_nodes;
+}
+
+intptr_t OSThread::GetCurrentNumaNode() {
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+    return 0;
+  }
+  return node;
+}
+
+bool OSThread::BindCurrentThreadToNumaNode(intptr_t node) {
+  pthread_once(&numa_once, InitNumaTopology);
+  cpu_set_t* cpus;
+  if (node == kAnyNumaNode) {
+    cpus = &numa_all_cpus;
+  } else if ((node >= 0) && (node < num_numa_nodes)) {
+    cpus = &numa_node_cpus[node];
+  } else {
+    return false;
+  }
+  if (CPU_COUNT(cpus) == 0) {
+    return false;
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(*cpus), cpus) == 0;
+}
+
 bool OSThread::GetCurrentStackBounds(uword* lower, uword* upper) {
   pthread_attr_t attr;
   // May fail on the main thread.
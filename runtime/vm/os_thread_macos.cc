@@ -202,6 +202,18 @@ bool OSThread::Compare(ThreadId a, ThreadId b) {
   return pthread_equal(a, b) != 0;
 }
 
+intptr_t OSThread::NumberOfNumaNodes() {
+  return 1;
+}
+
+intptr_t OSThread::GetCurrentNumaNode() {
+  return 0;
+}
+
+bool OSThread::BindCurrentThreadToNumaNode(intptr_t node) {
+  return false;
+}
+
 bool OSThread::GetCurrentStackBounds(uword* lower, uword* upper) {
   *upper = reinterpret_cast<uword>(pthread_get_stackaddr_np(pthread_self()));
   *lower = *upper - pthread_get_stacksize_np(pthread_self());
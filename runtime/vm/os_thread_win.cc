@@ -161,6 +161,18 @@ bool OSThread::Compare(ThreadId a, ThreadId b) {
   return a == b;
 }
 
+intptr_t OSThread::NumberOfNumaNodes() {
+  return 1;
+}
+
+intptr_t OSThread::GetCurrentNumaNode() {
+  return 0;
+}
+
+bool OSThread::BindCurrentThreadToNumaNode(intptr_t node) {
+  return false;
+}
+
 bool OSThread::GetCurrentStackBounds(uword* lower, uword* upper) {
 // On Windows stack limits for the current thread are available in
 // the thread information block (TIB). Its fields can be accessed through
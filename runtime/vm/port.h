@@ -48,6 +48,18 @@ class PortMap : public AllStatic {
   // Claims ownership of 'message'.
   static bool PostMessage(Message* message);
 
+  // Like PostMessage, but leaves 'message' with the caller if the port is not
+  // active any longer, so that the caller can take back what it handed over.
+  static bool TryPostMessage(Message* message);
+
+  // Enqueues count messages, which all have dest_port, in order. Returns
+  // false if the port is not active any longer.
+  //
+  // Claims ownership of the messages.
+  static bool PostMessages(Dart_Port dest_port,
+                           Message** messages,
+                           intptr_t count);
+
   // Returns whether a port is local to the current isolate.
   static bool IsLocalPort(Dart_Port id);
 
@@ -75,29 +87,41 @@ class PortMap : public AllStatic {
     PortState state;
   } Entry;
 
+  // The port map is split into shards by port id, each with its own lock,
+  // so that posting messages to ports in different shards does not contend.
+  // A handler's ports may be spread over all shards. Handlers are deleted
+  // only after their ports were removed from the map, so a handler found
+  // while holding a shard's lock stays valid until the lock is released.
+  struct Shard {
+    // Lock protecting access to the fields below.
+    Mutex* mutex;
+
+    // Hashmap of ports.
+    Entry* map;
+    intptr_t capacity;
+    intptr_t used;
+    intptr_t deleted;
+  };
+
+  static const intptr_t kNumShards = 16;
+
   static const char* PortStateString(PortState state);
 
-  // Allocate a new unique port.
-  static Dart_Port AllocatePort();
+  static Shard* ShardFor(Dart_Port port);
 
   static bool IsActivePort(Dart_Port id);
   static bool IsLivePort(Dart_Port id);
 
-  static intptr_t FindPort(Dart_Port port);
-  static void Rehash(intptr_t new_capacity);
-
-  static void MaintainInvariants();
+  static intptr_t FindPort(Shard* shard, Dart_Port port);
+  static void Rehash(Shard* shard, intptr_t new_capacity);
 
-  // Lock protecting access to the port map.
-  static Mutex* mutex_;
+  static void MaintainInvariants(Shard* shard);
 
-  // Hashmap of ports.
-  static Entry* map_;
+  static Shard shards_[kNumShards];
   static MessageHandler* deleted_entry_;
-  static intptr_t capacity_;
-  static intptr_t used_;
-  static intptr_t deleted_;
 
+  // Lock protecting prng_, which allocates new port ids.
+  static Mutex* mutex_;
   static Random* prng_;
 };
 
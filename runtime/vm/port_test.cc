@@ -7,6 +7,7 @@
 #include "vm/lockers.h"
 #include "vm/message_handler.h"
 #include "vm/os.h"
+#include "vm/thread_pool.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -15,18 +16,26 @@ namespace dart {
 class PortMapTestPeer {
  public:
   static bool IsActivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    return (PortMap::FindPort(port) >= 0);
+    PortMap::Shard* shard = PortMap::ShardFor(port);
+    MutexLocker ml(shard->mutex);
+    return (PortMap::FindPort(shard, port) >= 0);
   }
 
   static bool IsLivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    intptr_t index = PortMap::FindPort(port);
+    PortMap::Shard* shard = PortMap::ShardFor(port);
+    MutexLocker ml(shard->mutex);
+    intptr_t index = PortMap::FindPort(shard, port);
     if (index < 0) {
       return false;
     }
-    return PortMap::map_[index].state == PortMap::kLivePort;
+    return shard->map[index].state == PortMap::kLivePort;
   }
+
+  static intptr_t ShardIndex(Dart_Port port) {
+    return PortMap::ShardFor(port) - PortMap::shards_;
+  }
+
+  static const intptr_t kNumShards = PortMap::kNumShards;
 };
 
 class PortTestMessageHandler : public MessageHandler {
@@ -92,6 +101,30 @@ TEST_CASE(PortMap_CreateManyPorts) {
   }
 }
 
+TEST_CASE(PortMap_PortsSpreadOverShards) {
+  PortTestMessageHandler handler;
+  const intptr_t kNumPorts = 32 * PortMapTestPeer::kNumShards;
+  Dart_Port ports[kNumPorts];
+  intptr_t ports_in_shard[PortMapTestPeer::kNumShards] = {0};
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    ports_in_shard[PortMapTestPeer::ShardIndex(ports[i])]++;
+  }
+  // Every shard holds some of the ports, so each had to grow its table.
+  for (intptr_t i = 0; i < PortMapTestPeer::kNumShards; i++) {
+    EXPECT_LT(0, ports_in_shard[i]);
+  }
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    EXPECT(PortMapTestPeer::IsActivePort(ports[i]));
+  }
+
+  // Closing the handler's ports visits every shard.
+  PortMap::ClosePorts(&handler);
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    EXPECT(!PortMapTestPeer::IsActivePort(ports[i]));
+  }
+}
+
 TEST_CASE(PortMap_SetPortState) {
   PortTestMessageHandler handler;
 
@@ -167,6 +200,55 @@ TEST_CASE(PortMap_PostNullMessage) {
   PortMap::ClosePorts(&handler);
 }
 
+class PortPostTask : public ThreadPool::Task {
+ public:
+  static const intptr_t kMessageCount = 1000;
+
+  PortPostTask(Dart_Port port, Monitor* monitor, intptr_t* done)
+      : port_(port), monitor_(monitor), done_(done) {}
+
+  virtual void Run() {
+    for (intptr_t i = 0; i < kMessageCount; i++) {
+      EXPECT(PortMap::PostMessage(
+          new Message(port_, Smi::New(i), Message::kNormalPriority)));
+    }
+    MonitorLocker ml(monitor_);
+    ++*done_;
+    ml.Notify();
+  }
+
+ private:
+  Dart_Port port_;
+  Monitor* monitor_;
+  intptr_t* done_;
+};
+
+// Threads posting to ports in different shards at the same time each
+// deliver all of their messages.
+TEST_CASE(PortMap_PostMessageConcurrently) {
+  const intptr_t kTaskCount = 4;
+  PortTestMessageHandler handlers[kTaskCount];
+  Dart_Port ports[kTaskCount];
+  for (intptr_t i = 0; i < kTaskCount; i++) {
+    ports[i] = PortMap::CreatePort(&handlers[i]);
+  }
+  Monitor monitor;
+  intptr_t done = 0;
+  for (intptr_t i = 0; i < kTaskCount; i++) {
+    Dart::thread_pool()->Run(new PortPostTask(ports[i], &monitor, &done));
+  }
+  {
+    MonitorLocker ml(&monitor);
+    while (done < kTaskCount) {
+      ml.Wait();
+    }
+  }
+  for (intptr_t i = 0; i < kTaskCount; i++) {
+    EXPECT_EQ(PortPostTask::kMessageCount, handlers[i].notify_count);
+    PortMap::ClosePorts(&handlers[i]);
+  }
+}
+
 TEST_CASE(PortMap_PostMessageClosedPort) {
   // Create a port id and make it invalid.
   PortTestMessageHandler handler;
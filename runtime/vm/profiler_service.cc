@@ -2531,6 +2531,186 @@ void Profile::PrintProfileJSON(JSONStream* stream) {
   }
 }
 
+// Field numbers of the messages in pprof's profile.proto.
+enum PprofField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12,
+
+  kValueTypeType = 1,
+  kValueTypeUnit = 2,
+
+  kSampleLocationId = 1,
+  kSampleValue = 2,
+
+  kLocationId = 1,
+  kLocationLine = 4,
+
+  kLineFunctionId = 1,
+
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFilename = 4,
+};
+
+// Encodes a protocol buffer message. Nested messages are encoded into their
+// own writer and then appended as length delimited fields.
+class PprofWriter : public ValueObject {
+ public:
+  explicit PprofWriter(Zone* zone) : buffer_(zone, 64), num_strings_(0) {}
+
+  const uint8_t* data() const { return buffer_.data(); }
+  intptr_t length() const { return buffer_.length(); }
+
+  void WriteInt(intptr_t field, int64_t value) {
+    WriteVarint(field << 3);
+    WriteVarint(static_cast<uint64_t>(value));
+  }
+
+  void WriteBytes(intptr_t field, const uint8_t* bytes, intptr_t length) {
+    WriteVarint((field << 3) | kLengthDelimited);
+    WriteVarint(length);
+    for (intptr_t i = 0; i < length; i++) {
+      buffer_.Add(bytes[i]);
+    }
+  }
+
+  void WriteMessage(intptr_t field, const PprofWriter& message) {
+    WriteBytes(field, message.data(), message.length());
+  }
+
+  // Appends 'str' to the string table of a Profile message and returns its
+  // index.
+  intptr_t AddString(const char* str) {
+    WriteBytes(kProfileStringTable, reinterpret_cast<const uint8_t*>(str),
+               strlen(str));
+    return num_strings_++;
+  }
+
+ private:
+  static const intptr_t kLengthDelimited = 2;
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.Add(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.Add(static_cast<uint8_t>(value));
+  }
+
+  GrowableArray<uint8_t> buffer_;
+  intptr_t num_strings_;
+};
+
+void Profile::PrintPprofSamples(PprofWriter* writer,
+                                ProfileTrieNode* node,
+                                GrowableArray<intptr_t>* stack,
+                                int64_t period_nanos) {
+  // Location ids are function table indexes plus one, as 0 is not a valid id.
+  stack->Add(node->table_index() + 1);
+  // Samples that end at this node have this function as the outermost frame.
+  intptr_t ending_here = node->count();
+  for (intptr_t i = 0; i < node->NumChildren(); i++) {
+    ProfileTrieNode* child = node->At(i);
+    ending_here -= child->count();
+    PrintPprofSamples(writer, child, stack, period_nanos);
+  }
+  if (ending_here > 0) {
+    PprofWriter sample(zone_);
+    for (intptr_t i = 0; i < stack->length(); i++) {
+      sample.WriteInt(kSampleLocationId, stack->At(i));
+    }
+    sample.WriteInt(kSampleValue, ending_here);
+    sample.WriteInt(kSampleValue, ending_here * period_nanos);
+    writer->WriteMessage(kProfileSample, sample);
+  }
+  stack->RemoveLast();
+}
+
+void Profile::PrintPprofJSON(JSONStream* stream) {
+  ScopeTimer sw("Profile::PrintPprofJSON", FLAG_trace_profiler);
+  PprofWriter writer(zone_);
+  writer.AddString("");
+  const intptr_t samples_string = writer.AddString("samples");
+  const intptr_t count_string = writer.AddString("count");
+  const intptr_t cpu_string = writer.AddString("cpu");
+  const intptr_t nanoseconds_string = writer.AddString("nanoseconds");
+  {
+    PprofWriter value_type(zone_);
+    value_type.WriteInt(kValueTypeType, samples_string);
+    value_type.WriteInt(kValueTypeUnit, count_string);
+    writer.WriteMessage(kProfileSampleType, value_type);
+  }
+  {
+    PprofWriter value_type(zone_);
+    value_type.WriteInt(kValueTypeType, cpu_string);
+    value_type.WriteInt(kValueTypeUnit, nanoseconds_string);
+    writer.WriteMessage(kProfileSampleType, value_type);
+    writer.WriteMessage(kProfilePeriodType, value_type);
+  }
+  const int64_t period_nanos =
+      static_cast<int64_t>(FLAG_profile_period) * kNanosecondsPerMicrosecond;
+  writer.WriteInt(kProfilePeriod, period_nanos);
+  writer.WriteInt(kProfileTimeNanos, min_time() * kNanosecondsPerMicrosecond);
+  writer.WriteInt(kProfileDurationNanos,
+                  GetTimeSpan() * kNanosecondsPerMicrosecond);
+
+  // Every function gets a location of its own with the same id.
+  Script& script = Script::Handle(zone_);
+  String& url = String::Handle(zone_);
+  for (intptr_t i = 0; i < functions_->length(); i++) {
+    ProfileFunction* function = functions_->At(i);
+    ASSERT(function != NULL);
+    const intptr_t id = function->table_index() + 1;
+    const intptr_t name_string = writer.AddString(function->Name());
+    intptr_t filename_string = 0;
+    if (!function->function()->IsNull()) {
+      script = function->function()->script();
+      if (!script.IsNull()) {
+        url = script.url();
+        filename_string = writer.AddString(url.ToCString());
+      }
+    }
+    {
+      PprofWriter message(zone_);
+      message.WriteInt(kFunctionId, id);
+      message.WriteInt(kFunctionName, name_string);
+      message.WriteInt(kFunctionSystemName, name_string);
+      message.WriteInt(kFunctionFilename, filename_string);
+      writer.WriteMessage(kProfileFunction, message);
+    }
+    {
+      PprofWriter line(zone_);
+      line.WriteInt(kLineFunctionId, id);
+      PprofWriter location(zone_);
+      location.WriteInt(kLocationId, id);
+      location.WriteMessage(kLocationLine, line);
+      writer.WriteMessage(kProfileLocation, location);
+    }
+  }
+
+  // The exclusive function trie goes from the innermost frame outwards,
+  // which is the order pprof expects for the locations of a sample.
+  ProfileTrieNode* root = roots_[static_cast<intptr_t>(kExclusiveFunction)];
+  ASSERT(root != NULL);
+  GrowableArray<intptr_t> stack(zone_, FLAG_max_profile_depth);
+  for (intptr_t i = 0; i < root->NumChildren(); i++) {
+    PrintPprofSamples(&writer, root->At(i), &stack, period_nanos);
+  }
+
+  JSONObject obj(stream);
+  obj.AddProperty("type", "_CpuProfilePprof");
+  PrintHeaderJSON(&obj);
+  obj.AddPropertyBase64("pprof", writer.data(), writer.length());
+}
+
 void ProfileTrieWalker::Reset(Profile::TrieKind trie_kind) {
   code_trie_ = Profile::IsCodeTrie(trie_kind);
   parent_ = NULL;
@@ -2684,7 +2864,7 @@ void ProfilerService::PrintJSONImpl(Thread* thread,
                                     intptr_t extra_tags,
                                     SampleFilter* filter,
                                     SampleBuffer* sample_buffer,
-                                    bool as_timeline) {
+                                    Format format) {
   Isolate* isolate = thread->isolate();
   // Disable thread interrupts while processing the buffer.
   DisableThreadInterruptsScope dtis(thread);
@@ -2699,10 +2879,16 @@ void ProfilerService::PrintJSONImpl(Thread* thread,
     HANDLESCOPE(thread);
     Profile profile(isolate);
     profile.Build(thread, filter, sample_buffer, tag_order, extra_tags);
-    if (as_timeline) {
-      profile.PrintTimelineJSON(stream);
-    } else {
-      profile.PrintProfileJSON(stream);
+    switch (format) {
+      case kProfileFormat:
+        profile.PrintProfileJSON(stream);
+        break;
+      case kTimelineFormat:
+        profile.PrintTimelineJSON(stream);
+        break;
+      case kPprofFormat:
+        profile.PrintPprofJSON(stream);
+        break;
     }
   }
 }
@@ -2730,9 +2916,8 @@ void ProfilerService::PrintJSON(JSONStream* stream,
   Isolate* isolate = thread->isolate();
   NoAllocationSampleFilter filter(isolate->main_port(), Thread::kMutatorTask,
                                   time_origin_micros, time_extent_micros);
-  const bool as_timeline = false;
   PrintJSONImpl(thread, stream, tag_order, extra_tags, &filter,
-                Profiler::sample_buffer(), as_timeline);
+                Profiler::sample_buffer(), kProfileFormat);
 }
 
 class ClassAllocationSampleFilter : public SampleFilter {
@@ -2769,9 +2954,8 @@ void ProfilerService::PrintAllocationJSON(JSONStream* stream,
   ClassAllocationSampleFilter filter(isolate->main_port(), cls,
                                      Thread::kMutatorTask, time_origin_micros,
                                      time_extent_micros);
-  const bool as_timeline = false;
   PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
-                Profiler::sample_buffer(), as_timeline);
+                Profiler::sample_buffer(), kProfileFormat);
 }
 
 void ProfilerService::PrintNativeAllocationJSON(JSONStream* stream,
@@ -2780,9 +2964,8 @@ void ProfilerService::PrintNativeAllocationJSON(JSONStream* stream,
                                                 int64_t time_extent_micros) {
   Thread* thread = Thread::Current();
   NativeAllocationSampleFilter filter(time_origin_micros, time_extent_micros);
-  const bool as_timeline = false;
   PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
-                Profiler::allocation_sample_buffer(), as_timeline);
+                Profiler::allocation_sample_buffer(), kProfileFormat);
 }
 
 void ProfilerService::PrintTimelineJSON(JSONStream* stream,
@@ -2796,9 +2979,20 @@ void ProfilerService::PrintTimelineJSON(JSONStream* stream,
                                     Thread::kSweeperTask | Thread::kMarkerTask;
   NoAllocationSampleFilter filter(isolate->main_port(), thread_task_mask,
                                   time_origin_micros, time_extent_micros);
-  const bool as_timeline = true;
   PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
-                Profiler::sample_buffer(), as_timeline);
+                Profiler::sample_buffer(), kTimelineFormat);
+}
+
+void ProfilerService::PrintPprofJSON(JSONStream* stream,
+                                     Profile::TagOrder tag_order,
+                                     int64_t time_origin_micros,
+                                     int64_t time_extent_micros) {
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  NoAllocationSampleFilter filter(isolate->main_port(), Thread::kMutatorTask,
+                                  time_origin_micros, time_extent_micros);
+  PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
+                Profiler::sample_buffer(), kPprofFormat);
 }
 
 void ProfilerService::ClearSamples() {
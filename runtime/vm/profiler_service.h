@@ -25,6 +25,7 @@ class Function;
 class JSONArray;
 class JSONStream;
 class ProfileFunctionTable;
+class PprofWriter;
 class ProfileCodeTable;
 class RawCode;
 class RawFunction;
@@ -386,6 +387,8 @@ class Profile : public ValueObject {
 
   void PrintProfileJSON(JSONStream* stream);
   void PrintTimelineJSON(JSONStream* stream);
+  // Prints the samples as a base64 encoded pprof profile.proto message.
+  void PrintPprofJSON(JSONStream* stream);
 
   ProfileFunction* FindFunction(const Function& function);
 
@@ -395,6 +398,10 @@ class Profile : public ValueObject {
                               ProfileTrieNode* current,
                               ProfileTrieNode* parent,
                               intptr_t* next_id);
+  void PrintPprofSamples(PprofWriter* writer,
+                         ProfileTrieNode* node,
+                         GrowableArray<intptr_t>* stack,
+                         int64_t period_nanos);
 
   Isolate* isolate_;
   Zone* zone_;
@@ -484,16 +491,27 @@ class ProfilerService : public AllStatic {
                                 int64_t time_origin_micros,
                                 int64_t time_extent_micros);
 
+  static void PrintPprofJSON(JSONStream* stream,
+                             Profile::TagOrder tag_order,
+                             int64_t time_origin_micros,
+                             int64_t time_extent_micros);
+
   static void ClearSamples();
 
  private:
+  enum Format {
+    kProfileFormat,
+    kTimelineFormat,
+    kPprofFormat,
+  };
+
   static void PrintJSONImpl(Thread* thread,
                             JSONStream* stream,
                             Profile::TagOrder tag_order,
                             intptr_t extra_tags,
                             SampleFilter* filter,
                             SampleBuffer* sample_buffer,
-                            bool as_timline);
+                            Format format);
 };
 
 }  // namespace dart
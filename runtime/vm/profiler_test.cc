@@ -21,6 +21,7 @@ DECLARE_FLAG(bool, profile_vm);
 DECLARE_FLAG(int, max_profile_depth);
 DECLARE_FLAG(bool, enable_inlining_annotations);
 DECLARE_FLAG(int, optimization_counter_threshold);
+DECLARE_FLAG(int, new_allocation_sample_bytes);
 
 // Some tests are written assuming native stack trace profiling is disabled.
 class DisableNativeProfileScope : public ValueObject {
@@ -320,6 +321,61 @@ TEST_CASE(Profiler_TrivialRecordAllocation) {
   }
 }
 
+TEST_CASE(Profiler_SampledNewSpaceAllocation) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  SetFlagScope<int> sfs(&FLAG_new_allocation_sample_bytes, 1024);
+  const char* kScript =
+      "class A {\n"
+      "  var a;\n"
+      "  var b;\n"
+      "}\n"
+      "main() {\n"
+      "  var list = new List(10000);\n"
+      "  for (var i = 0; i < list.length; i++) {\n"
+      "    list[i] = new A();\n"
+      "  }\n"
+      "  return list;\n"
+      "}\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(lib);
+  Library& root_library = Library::Handle();
+  root_library ^= Api::UnwrapHandle(lib);
+  const Class& class_a = Class::Handle(GetClass(root_library, "A"));
+  EXPECT(!class_a.IsNull());
+  EXPECT(!class_a.TraceAllocation(Isolate::Current()));
+
+  {
+    // The sample points are placed when a scavenge finishes.
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    thread->isolate()->heap()->CollectGarbage(Heap::kNew);
+  }
+  const int64_t before_allocations_micros = Dart_TimelineGetMicros();
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  const int64_t allocation_extent_micros =
+      Dart_TimelineGetMicros() - before_allocations_micros;
+
+  {
+    Thread* thread = Thread::Current();
+    Isolate* isolate = thread->isolate();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    Profile profile(isolate);
+    AllocationFilter filter(isolate->main_port(), class_a.id(),
+                            before_allocations_micros,
+                            allocation_extent_micros);
+    profile.Build(thread, &filter, Profiler::sample_buffer(), Profile::kNoTags);
+    // The instances of A take well over 100KB, so a few hundred of them
+    // should have been sampled, but not all of them.
+    EXPECT_LT(10, profile.sample_count());
+    EXPECT_GT(10000, profile.sample_count());
+  }
+}
+
 #if defined(DART_USE_TCMALLOC) && defined(HOST_OS_LINUX) && defined(DEBUG) &&  \
     defined(HOST_ARCH_x64)
 
@@ -151,7 +151,7 @@ class StackMapKeyValueTrait {
 
   static Value ValueOf(Pair kv) { return kv; }
 
-  static inline intptr_t Hashcode(Key key) { return key->PcOffset(); }
+  static inline intptr_t Hashcode(Key key) { return key->Hash(); }
 
   static inline bool IsKeyEqual(Pair pair, Key key) {
     return pair->Equals(*key);
@@ -181,7 +181,8 @@ void ProgramVisitor::DedupStackMaps() {
       code_ = function.CurrentCode();
       stackmaps_ = code_.stackmaps();
       if (stackmaps_.IsNull()) return;
-      for (intptr_t i = 0; i < stackmaps_.Length(); i++) {
+      for (intptr_t i = Code::kSMStackMapEntry; i < stackmaps_.Length();
+           i += Code::kSMEntryLength) {
         stackmap_ ^= stackmaps_.At(i);
         stackmap_ = DedupStackMap(stackmap_);
         stackmaps_.SetAt(i, stackmap_);
@@ -300,6 +301,110 @@ void ProgramVisitor::DedupPcDescriptors() {
   ProgramVisitor::VisitFunctions(&visitor);
 }
 
+class ExceptionHandlersKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const ExceptionHandlers* Key;
+  typedef const ExceptionHandlers* Value;
+  typedef const ExceptionHandlers* Pair;
+
+  static Key KeyOf(Pair kv) { return kv; }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline intptr_t Hashcode(Key key) {
+    const intptr_t num_entries = key->num_entries();
+    if (num_entries == 0) {
+      return 0;
+    }
+    return num_entries * 31 + key->HandlerPCOffset(0);
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    const intptr_t num_entries = pair->num_entries();
+    if (num_entries != key->num_entries()) {
+      return false;
+    }
+    ExceptionHandlerInfo pair_info;
+    ExceptionHandlerInfo key_info;
+    for (intptr_t i = 0; i < num_entries; i++) {
+      pair->GetHandlerInfo(i, &pair_info);
+      key->GetHandlerInfo(i, &key_info);
+      if ((pair_info.handler_pc_offset != key_info.handler_pc_offset) ||
+          (pair_info.outer_try_index != key_info.outer_try_index) ||
+          (pair_info.needs_stacktrace != key_info.needs_stacktrace) ||
+          (pair_info.has_catch_all != key_info.has_catch_all) ||
+          (pair_info.is_generated != key_info.is_generated)) {
+        return false;
+      }
+      if (pair->GetHandledTypes(i) == key->GetHandledTypes(i)) {
+        continue;
+      }
+      const Array& pair_types = Array::Handle(pair->GetHandledTypes(i));
+      const Array& key_types = Array::Handle(key->GetHandledTypes(i));
+      if (pair_types.IsNull() || key_types.IsNull() ||
+          (pair_types.Length() != key_types.Length())) {
+        return false;
+      }
+      for (intptr_t j = 0; j < pair_types.Length(); j++) {
+        if (pair_types.At(j) != key_types.At(j)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+typedef DirectChainedHashMap<ExceptionHandlersKeyValueTrait>
+    ExceptionHandlersSet;
+
+// Code objects whose try blocks are laid out alike, e.g. in generated
+// forwarders and small catch-all wrappers, can share one handler table.
+void ProgramVisitor::DedupExceptionHandlers() {
+  class DedupExceptionHandlersVisitor : public FunctionVisitor {
+   public:
+    explicit DedupExceptionHandlersVisitor(Zone* zone)
+        : zone_(zone),
+          canonical_handlers_(),
+          code_(Code::Handle(zone)),
+          handlers_(ExceptionHandlers::Handle(zone)) {}
+
+    void Visit(const Function& function) {
+      if (!function.HasCode()) {
+        return;
+      }
+      code_ = function.CurrentCode();
+      handlers_ = code_.exception_handlers();
+      if (handlers_.IsNull() || handlers_.InVMHeap()) return;
+      handlers_ = DedupExceptionHandler(handlers_);
+      code_.set_exception_handlers(handlers_);
+    }
+
+    RawExceptionHandlers* DedupExceptionHandler(
+        const ExceptionHandlers& handlers) {
+      const ExceptionHandlers* canonical_handlers =
+          canonical_handlers_.LookupValue(&handlers);
+      if (canonical_handlers == NULL) {
+        canonical_handlers_.Insert(
+            &ExceptionHandlers::ZoneHandle(zone_, handlers.raw()));
+        return handlers.raw();
+      } else {
+        return canonical_handlers->raw();
+      }
+    }
+
+   private:
+    Zone* zone_;
+    ExceptionHandlersSet canonical_handlers_;
+    Code& code_;
+    ExceptionHandlers& handlers_;
+  };
+
+  DedupExceptionHandlersVisitor visitor(Thread::Current()->zone());
+  ProgramVisitor::VisitFunctions(&visitor);
+}
+
 class TypedDataKeyValueTrait {
  public:
   // Typedefs needed for the DirectChainedHashMap template.
@@ -722,6 +827,7 @@ void ProgramVisitor::Dedup() {
   ShareMegamorphicBuckets();
   DedupStackMaps();
   DedupPcDescriptors();
+  DedupExceptionHandlers();
   NOT_IN_PRECOMPILED(DedupDeoptEntries());
 #if defined(DART_PRECOMPILER)
   DedupCatchEntryMovesMaps();
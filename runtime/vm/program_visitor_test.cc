@@ -0,0 +1,64 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/program_visitor.h"
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static RawExceptionHandlers* HandlersOf(const Library& lib, const char* name) {
+  Thread* thread = Thread::Current();
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, name))));
+  EXPECT(!function.IsNull());
+  EXPECT(function.HasCode());
+  const Code& code = Code::Handle(function.CurrentCode());
+  return code.exception_handlers();
+}
+
+TEST_CASE(ProgramVisitor_DedupExceptionHandlers) {
+  const char* kScript =
+      "bar() { throw 'bar'; }\n"
+      "foo() { try { bar(); } catch (e) { return 1; } return 0; }\n"
+      "baz() { try { bar(); } catch (e) { return 1; } return 0; }\n"
+      "qux() { try { bar(); } on String catch (e) { return 1; } return 0; }\n"
+      "main() { return foo() + baz() + qux(); }\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(h_lib);
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  EXPECT(!lib.IsNull());
+
+  ExceptionHandlers& foo = ExceptionHandlers::Handle(HandlersOf(lib, "foo"));
+  ExceptionHandlers& baz = ExceptionHandlers::Handle(HandlersOf(lib, "baz"));
+  ExceptionHandlers& qux = ExceptionHandlers::Handle(HandlersOf(lib, "qux"));
+  EXPECT_EQ(1, foo.num_entries());
+  EXPECT(foo.raw() != baz.raw());
+  EXPECT(foo.raw() != qux.raw());
+
+  ProgramVisitor::Dedup();
+
+  // Functions with the same try blocks share one table, others keep theirs.
+  foo = HandlersOf(lib, "foo");
+  baz = HandlersOf(lib, "baz");
+  qux = HandlersOf(lib, "qux");
+  EXPECT(foo.raw() == baz.raw());
+  EXPECT(foo.raw() != qux.raw());
+  EXPECT_EQ(1, foo.num_entries());
+  EXPECT(foo.HasCatchAll(0));
+  EXPECT_EQ(1, qux.num_entries());
+  EXPECT(!qux.HasCatchAll(0));
+}
+
+}  // namespace dart
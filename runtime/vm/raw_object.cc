@@ -8,6 +8,7 @@
 #include "vm/dart.h"
 #include "vm/heap/become.h"
 #include "vm/heap/freelist.h"
+#include "vm/heap/pages.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/visitor.h"
@@ -66,14 +67,18 @@ void RawObject::Validate(Isolate* isolate) const {
   }
 }
 
+void RawObject::RememberCard(RawObject* const* slot) {
+  HeapPage::Of(this)->RememberCard(slot);
+}
+
 // Can't look at the class object because it can be called during
 // compaction when the class objects are moving. Can use the class
 // id in the header and the sizes in the Class Table.
-intptr_t RawObject::SizeFromClass() const {
+intptr_t RawObject::SizeFromClass(uint32_t tags) const {
   // Only reasonable to be called on heap objects.
   ASSERT(IsHeapObject());
 
-  intptr_t class_id = GetClassId();
+  intptr_t class_id = ClassIdTag::decode(tags);
   intptr_t instance_size = 0;
   switch (class_id) {
     case kCodeCid: {
@@ -135,9 +140,9 @@ intptr_t RawObject::SizeFromClass() const {
       CLASS_LIST_TYPED_DATA(SIZE_FROM_CLASS) {
         const RawTypedData* raw_obj =
             reinterpret_cast<const RawTypedData*>(this);
-        intptr_t cid = raw_obj->GetClassId();
         intptr_t array_len = Smi::Value(raw_obj->ptr()->length_);
-        intptr_t lengthInBytes = array_len * TypedData::ElementSizeInBytes(cid);
+        intptr_t lengthInBytes =
+            array_len * TypedData::ElementSizeInBytes(class_id);
         instance_size = TypedData::InstanceSize(lengthInBytes);
         break;
       }
@@ -203,8 +208,7 @@ intptr_t RawObject::SizeFromClass() const {
       ClassTable* class_table = isolate->class_table();
       if (!class_table->IsValidIndex(class_id) ||
           !class_table->HasValidClassAt(class_id)) {
-        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id,
-               ptr()->tags_);
+        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id, tags);
       }
 #endif  // DEBUG
       instance_size = isolate->GetClassSizeForHeapWalkAt(class_id);
@@ -212,7 +216,6 @@ intptr_t RawObject::SizeFromClass() const {
   }
   ASSERT(instance_size != 0);
 #if defined(DEBUG)
-  uint32_t tags = ptr()->tags_;
   intptr_t tags_size = SizeTag::decode(tags);
   if ((class_id == kArrayCid) && (instance_size > tags_size && tags_size > 0)) {
     // TODO(22501): Array::MakeFixedLength could be in the process of shrinking
@@ -287,7 +287,8 @@ class RawObject {
   // The tags field which is a part of the object header uses the following
   // bit fields for storing tags.
   enum TagBits {
-    kReservedBit = 0,
+    kCardRememberedBit = 0,       // Card table remembered set (old), or
+                                  // aged survivor (new, see scavenger.cc).
     kOldAndNotMarkedBit = 1,      // Incremental barrier target.
     kNewBit = 2,                  // Generational barrier target.
     kOldBit = 3,                  // Incremental barrier source.
@@ -315,7 +316,7 @@ class RawObject {
   // The bit in the Smi tag position must be something that can be set to 0
   // for a dead filler object of either generation.
   // See Object::MakeUnusedSpaceTraversable.
-  COMPILE_ASSERT(kReservedBit == 0);
+  COMPILE_ASSERT(kCardRememberedBit == 0);
 
   COMPILE_ASSERT(kClassIdTagSize == (sizeof(classid_t) * kBitsPerByte));
 
@@ -372,6 +373,9 @@ class RawObject {
   class OldAndNotRememberedBit
       : public BitField<uint32_t, bool, kOldAndNotRememberedBit, 1> {};
 
+  class CardRememberedBit
+      : public BitField<uint32_t, bool, kCardRememberedBit, 1> {};
+
   bool IsWellFormed() const {
     uword value = reinterpret_cast<uword>(this);
     return (value & kSmiTagMask) == 0 ||
@@ -478,6 +482,18 @@ class RawObject {
     UpdateTagBit<OldAndNotRememberedBit>(true);
   }
 
+  // Support for card marking. Stores into a card-remembered object dirty the
+  // card of the written slot instead of adding the whole object to the store
+  // buffer. Only arrays that are alone on a large page are card-remembered.
+  bool IsCardRemembered() const {
+    return CardRememberedBit::decode(ptr()->tags_);
+  }
+  void SetCardRememberedBitUnsynchronized() {
+    ASSERT(!IsCardRemembered());
+    uint32_t tags = ptr()->tags_;
+    ptr()->tags_ = CardRememberedBit::update(true, tags);
+  }
+
 #define DEFINE_IS_CID(clazz)                                                   \
   bool Is##clazz() const { return ((GetClassId() == k##clazz##Cid)); }
   CLASS_LIST(DEFINE_IS_CID)
@@ -539,6 +555,19 @@ class RawObject {
     return result;
   }
 
+  // Like Size(), but computes the size from the given header tags instead of
+  // reloading them. Used by the parallel scavenger, where the header of an
+  // object in from-space may concurrently be replaced by a forwarding pointer.
+  intptr_t Size(uint32_t tags) const {
+    intptr_t result = SizeTag::decode(tags);
+    if (result != 0) {
+      return result;
+    }
+    result = SizeFromClass(tags);
+    ASSERT(result > SizeTag::kMaxSizeTag);
+    return result;
+  }
+
   bool Contains(uword addr) const {
     intptr_t this_size = Size();
     uword this_addr = RawObject::ToAddr(this);
@@ -645,7 +674,8 @@ class RawObject {
   intptr_t VisitPointersPredefined(ObjectPointerVisitor* visitor,
                                    intptr_t class_id);
 
-  intptr_t SizeFromClass() const;
+  intptr_t SizeFromClass() const { return SizeFromClass(ptr()->tags_); }
+  intptr_t SizeFromClass(uint32_t tags) const;
 
   intptr_t GetClassId() const {
     uint32_t tags = ptr()->tags_;
@@ -689,7 +719,8 @@ class RawObject {
   void StorePointer(type const* addr, type value) {
     *const_cast<type*>(addr) = value;
     if (value->IsHeapObject()) {
-      CheckHeapPointerStore(value, Thread::Current());
+      CheckHeapPointerStore(reinterpret_cast<RawObject* const*>(addr), value,
+                            Thread::Current());
     }
   }
 
@@ -697,12 +728,15 @@ class RawObject {
   void StorePointer(type const* addr, type value, Thread* thread) {
     *const_cast<type*>(addr) = value;
     if (value->IsHeapObject()) {
-      CheckHeapPointerStore(value, thread);
+      CheckHeapPointerStore(reinterpret_cast<RawObject* const*>(addr), value,
+                            thread);
     }
   }
 
   DART_FORCE_INLINE
-  void CheckHeapPointerStore(RawObject* value, Thread* thread) {
+  void CheckHeapPointerStore(RawObject* const* slot,
+                             RawObject* value,
+                             Thread* thread) {
     uint32_t source_tags = this->ptr()->tags_;
     uint32_t target_tags = value->ptr()->tags_;
     if (((source_tags >> kBarrierOverlapShift) & target_tags &
@@ -711,8 +745,12 @@ class RawObject {
         // Generational barrier: record when a store creates an
         // old-and-not-remembered -> new reference.
         ASSERT(!this->IsRemembered());
-        this->SetRememberedBit();
-        thread->StoreBufferAddObject(this);
+        if (this->IsCardRemembered()) {
+          RememberCard(slot);
+        } else {
+          this->SetRememberedBit();
+          thread->StoreBufferAddObject(this);
+        }
       } else {
         // Incremental barrier: record when a store creates an
         // old -> old-and-not-marked reference.
@@ -724,6 +762,8 @@ class RawObject {
     }
   }
 
+  void RememberCard(RawObject* const* slot);
+
   // Use for storing into an explicitly Smi-typed field of an object
   // (i.e., both the previous and new value are Smis).
   void StoreSmi(RawSmi* const* addr, RawSmi* value) {
@@ -765,7 +805,8 @@ class RawObject {
   friend class RawString;
   friend class RawTypedData;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class SizeExcludingClassVisitor;  // GetClassId
   friend class InstanceAccumulator;        // GetClassId
   friend class RetainingPathVisitor;       // GetClassId
@@ -1291,7 +1332,8 @@ class RawKernelProgramInfo : public RawObject {
   RawExternalTypedData* constants_table_;
   RawArray* libraries_cache_;
   RawArray* classes_cache_;
-  VISIT_TO(RawObject*, classes_cache_);
+  RawExternalTypedData* kernel_component_;
+  VISIT_TO(RawObject*, kernel_component_);
 
   RawObject** to_snapshot(Snapshot::Kind kind) {
     return reinterpret_cast<RawObject**>(&ptr()->potential_natives_);
@@ -1551,10 +1593,6 @@ class RawStackMap : public RawObject {
   RAW_HEAP_OBJECT_IMPLEMENTATION(StackMap);
   VISIT_NOTHING();
 
-  // Offset from code entry point corresponding to this stack map
-  // representation.
-  uint32_t pc_offset_;
-
   uint16_t length_;               // Length of payload, in bits.
   uint16_t slow_path_bit_count_;  // Slow path live values, included in length_.
   // ARM64 requires register_bit_count_ to be as large as 96.
@@ -2169,6 +2207,7 @@ class RawArray : public RawInstance {
   friend class RawImmutableArray;
   friend class SnapshotReader;
   friend class GrowableObjectArray;
+  friend class HeapPage;  // VisitRememberedCards
   friend class LinkedHashMap;
   friend class RawLinkedHashMap;
   friend class Object;
@@ -2297,6 +2336,8 @@ class RawExternalTypedData : public RawInstance {
   VISIT_TO(RawCompressed, length_)
 
   uint8_t* data_;
+
+  friend class MessageWriter;  // For transferring data_.
 };
 
 // VM implementations of the basic types in the isolate.
@@ -2348,6 +2389,7 @@ class RawRegExp : public RawInstance {
   VISIT_FROM(RawObject*, num_bracket_expressions_)
   RawSmi* num_bracket_expressions_;
   RawString* pattern_;  // Pattern to be used for matching.
+  RawString* literal_prefix_;  // Text every match starts with, or null.
   union {
     RawFunction* function_;
     RawTypedData* bytecode_;
@@ -2394,7 +2436,10 @@ class RawWeakProperty : public RawInstance {
   template <bool>
   friend class MarkingVisitorBase;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
+  friend class ParallelScavengerTask;
+  friend class WeakPropertyIndex;
 };
 
 // MirrorReferences are used by mirrors to hold reflectees that are VM
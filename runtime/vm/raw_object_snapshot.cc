@@ -2,6 +2,7 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+#include "vm/dart_api_state.h"
 #include "vm/message.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
@@ -2054,13 +2055,32 @@ void RawExternalTypedData::WriteTo(SnapshotWriter* writer,
   writer->WriteIndexedObject(cid);
   writer->WriteTags(writer->GetObjectTags(this));
   writer->Write<RawObject*>(ptr()->length_);
+  MessageWriter* message_writer = static_cast<MessageWriter*>(writer);
   uint8_t* data = reinterpret_cast<uint8_t*>(ptr()->data_);
+  if (message_writer->transfer_external_typed_data()) {
+    FinalizablePersistentHandle* handle =
+        message_writer->FindExternalTypedDataFinalizer(this);
+    if (handle != NULL) {
+      // Hand the data and its finalizer to the receiver. The sender keeps
+      // its object, which must not change length since compiled code treats
+      // typed data lengths as immutable, so it gets zero-filled data instead
+      // once the message is posted. For large lengths calloc maps fresh
+      // pages without touching them.
+      void* detached_data = calloc(bytes > 0 ? bytes : 1, 1);
+      if (detached_data == NULL) {
+        OUT_OF_MEMORY();
+      }
+      message_writer->AddTransfer(this, handle, bytes, detached_data,
+                                  IsolateMessageTypedDataFinalizer);
+      return;
+    }
+  }
   void* passed_data = malloc(bytes);
   if (passed_data == NULL) {
     OUT_OF_MEMORY();
   }
   memmove(passed_data, data, bytes);
-  static_cast<MessageWriter*>(writer)->finalizable_data()->Put(
+  message_writer->finalizable_data()->Put(
       bytes,
       passed_data,  // data
       passed_data,  // peer,
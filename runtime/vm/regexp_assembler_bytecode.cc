@@ -410,6 +410,61 @@ void BytecodeRegExpMacroAssembler::Expand() {
     buffer_->Add(0);
 }
 
+// Appends the literal text that every match of 'tree' starts with to
+// 'prefix'. Returns true if all of 'tree' is literal text or zero-width, so
+// that the text of what follows it can be appended too.
+static bool AppendLiteralPrefix(RegExpTree* tree,
+                                ZoneGrowableArray<uint16_t>* prefix) {
+  if (tree->IsAtom()) {
+    ZoneGrowableArray<uint16_t>* data = tree->AsAtom()->data();
+    for (intptr_t i = 0; i < data->length(); i++) {
+      prefix->Add(data->At(i));
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->At(i);
+      if ((element.text_type() != TextElement::ATOM) ||
+          !AppendLiteralPrefix(element.atom(), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return AppendLiteralPrefix(tree->AsCapture()->body(), prefix);
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!AppendLiteralPrefix(nodes->At(i), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Assertions and lookaheads do not consume input, so the text after them
+  // still starts the match.
+  return tree->IsAssertion() || tree->IsLookahead() || tree->IsEmpty();
+}
+
+static RawString* LiteralPrefix(const RegExp& regexp,
+                                RegExpTree* tree,
+                                Zone* zone) {
+  if (regexp.is_ignore_case()) {
+    return String::null();
+  }
+  ZoneGrowableArray<uint16_t>* prefix =
+      new (zone) ZoneGrowableArray<uint16_t>(8);
+  AppendLiteralPrefix(tree, prefix);
+  if (prefix->length() == 0) {
+    return String::null();
+  }
+  return String::FromUTF16(prefix->data(), prefix->length(), Heap::kOld);
+}
+
 static intptr_t Prepare(const RegExp& regexp,
                         const String& subject,
                         bool sticky,
@@ -436,6 +491,8 @@ static intptr_t Prepare(const RegExp& regexp,
     }
 
     regexp.set_num_bracket_expressions(compile_data->capture_count);
+    regexp.set_literal_prefix(String::Handle(
+        zone, LiteralPrefix(regexp, compile_data->tree, zone)));
     if (compile_data->simple) {
       regexp.set_is_simple();
     } else {
@@ -486,7 +543,7 @@ static IrregexpInterpreter::IrregexpResult ExecRaw(const RegExp& regexp,
       TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
   ASSERT(!bytecode.IsNull());
   IrregexpInterpreter::IrregexpResult result =
-      IrregexpInterpreter::Match(bytecode, subject, raw_output, index, zone);
+      IrregexpInterpreter::Match(bytecode, subject, raw_output, index);
 
   if (result == IrregexpInterpreter::RE_SUCCESS) {
     // Copy capture results to the start of the registers array.
@@ -517,9 +574,27 @@ RawInstance* BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
   // V8 uses a shared copy on the isolate when smaller than some threshold.
   int32_t* output_registers = zone->Alloc<int32_t>(required_registers);
 
-  IrregexpInterpreter::IrregexpResult result =
-      ExecRaw(regexp, subject, start_index.Value(), sticky, output_registers,
-              required_registers, zone);
+  const String& prefix = String::Handle(zone, regexp.literal_prefix());
+  IrregexpInterpreter::IrregexpResult result;
+  if (!sticky && !prefix.IsNull() &&
+      (start_index.Value() <= subject.Length())) {
+    // A match can only start where the prefix occurs, so search for it and
+    // run the sticky matcher there instead of trying every position.
+    Prepare(regexp, subject, /*sticky=*/true, zone);
+    result = IrregexpInterpreter::RE_FAILURE;
+    intptr_t index = start_index.Value();
+    while ((index = String::IndexOf(subject, prefix, index)) != -1) {
+      result = ExecRaw(regexp, subject, index, /*sticky=*/true,
+                       output_registers, required_registers, zone);
+      if (result != IrregexpInterpreter::RE_FAILURE) {
+        break;
+      }
+      index++;
+    }
+  } else {
+    result = ExecRaw(regexp, subject, start_index.Value(), sticky,
+                     output_registers, required_registers, zone);
+  }
 
   if (result == IrregexpInterpreter::RE_SUCCESS) {
     intptr_t capture_count = Smi::Value(regexp.num_bracket_expressions());
@@ -6,6 +6,7 @@
 
 #include "vm/regexp_interpreter.h"
 
+#include "platform/atomic.h"
 #include "vm/object.h"
 #include "vm/regexp_assembler.h"
 #include "vm/regexp_bytecodes.h"
@@ -24,17 +25,17 @@ static bool BackRefMatchesNoCase(Canonicalize* interp_canonicalize,
                                  intptr_t from,
                                  intptr_t current,
                                  intptr_t len,
-                                 const String& subject);
+                                 const Char* subject);
 
 template <>
 bool BackRefMatchesNoCase<uint16_t>(Canonicalize* interp_canonicalize,
                                     intptr_t from,
                                     intptr_t current,
                                     intptr_t len,
-                                    const String& subject) {
+                                    const uint16_t* subject) {
   for (int i = 0; i < len; i++) {
-    int32_t old_char = subject.CharAt(from++);
-    int32_t new_char = subject.CharAt(current++);
+    int32_t old_char = subject[from++];
+    int32_t new_char = subject[current++];
     if (old_char == new_char) continue;
     int32_t old_string[1] = {old_char};
     int32_t new_string[1] = {new_char};
@@ -52,10 +53,10 @@ bool BackRefMatchesNoCase<uint8_t>(Canonicalize* interp_canonicalize,
                                    intptr_t from,
                                    intptr_t current,
                                    intptr_t len,
-                                   const String& subject) {
+                                   const uint8_t* subject) {
   for (int i = 0; i < len; i++) {
-    unsigned int old_char = subject.CharAt(from++);
-    unsigned int new_char = subject.CharAt(current++);
+    unsigned int old_char = subject[from++];
+    unsigned int new_char = subject[current++];
     if (old_char == new_char) continue;
     // Convert both characters to lower case.
     old_char |= 0x20;
@@ -127,8 +128,31 @@ static int32_t Load16Aligned(const uint8_t* pc) {
 // matching terminates.
 class BacktrackStack {
  public:
-  explicit BacktrackStack(Zone* zone) {
-    data_ = zone->Alloc<intptr_t>(kBacktrackStackSize);
+  BacktrackStack() {
+    // Take the cached stack, if there is one. The stack is not zone
+    // allocated, as that would keep the memory of every match in a loop
+    // alive until the zone is deleted.
+    intptr_t* cached = AtomicOperations::LoadRelaxed(&cache_);
+    intptr_t* none = NULL;
+    if ((cached != NULL) &&
+        (AtomicOperations::CompareAndSwapPointer(&cache_, cached, none) ==
+         cached)) {
+      data_ = cached;
+    } else {
+      data_ = reinterpret_cast<intptr_t*>(
+          malloc(kBacktrackStackSize * sizeof(intptr_t)));
+      if (data_ == NULL) {
+        OUT_OF_MEMORY();
+      }
+    }
+  }
+
+  ~BacktrackStack() {
+    intptr_t* none = NULL;
+    if (AtomicOperations::CompareAndSwapPointer(&cache_, none, data_) !=
+        NULL) {
+      free(data_);
+    }
   }
 
   intptr_t* data() const { return data_; }
@@ -138,23 +162,28 @@ class BacktrackStack {
  private:
   static const intptr_t kBacktrackStackSize = 10000;
 
+  // A stack that is not in use, shared by all threads.
+  static intptr_t* cache_;
+
   intptr_t* data_;
 
   DISALLOW_COPY_AND_ASSIGN(BacktrackStack);
 };
 
+intptr_t* BacktrackStack::cache_ = NULL;
+
 template <typename Char>
 static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
-                                                    const String& subject,
+                                                    const Char* subject,
+                                                    intptr_t subject_length,
                                                     int32_t* registers,
                                                     intptr_t current,
-                                                    uint32_t current_char,
-                                                    Zone* zone) {
+                                                    uint32_t current_char) {
   const uint8_t* pc = code_base;
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
   // the moment.
-  BacktrackStack backtrack_stack(zone);
+  BacktrackStack backtrack_stack;
   intptr_t* backtrack_stack_base = backtrack_stack.data();
   intptr_t* backtrack_sp = backtrack_stack_base;
   intptr_t backtrack_stack_space = backtrack_stack.max_size();
@@ -163,8 +192,6 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
   // isolate member.
   unibrow::Mapping<unibrow::Ecma262Canonicalize> canonicalize;
 
-  intptr_t subject_length = subject.Length();
-
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     OS::PrintErr("Start irregexp bytecode interpreter\n");
@@ -271,14 +298,14 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         if (pos >= subject_length) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
-          current_char = subject.CharAt(pos);
+          current_char = subject[pos];
           pc += BC_LOAD_CURRENT_CHAR_LENGTH;
         }
         break;
       }
       BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
-        current_char = subject.CharAt(pos);
+        current_char = subject[pos];
         pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_LENGTH;
         break;
       }
@@ -287,18 +314,18 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         if (pos + 2 > subject_length) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
-          Char next = subject.CharAt(pos + 1);
+          Char next = subject[pos + 1];
           current_char =
-              subject.CharAt(pos) | (next << (kBitsPerByte * sizeof(Char)));
+              subject[pos] | (next << (kBitsPerByte * sizeof(Char)));
           pc += BC_LOAD_2_CURRENT_CHARS_LENGTH;
         }
         break;
       }
       BYTECODE(LOAD_2_CURRENT_CHARS_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
-        Char next = subject.CharAt(pos + 1);
+        Char next = subject[pos + 1];
         current_char =
-            subject.CharAt(pos) | (next << (kBitsPerByte * sizeof(Char)));
+            subject[pos] | (next << (kBitsPerByte * sizeof(Char)));
         pc += BC_LOAD_2_CURRENT_CHARS_UNCHECKED_LENGTH;
         break;
       }
@@ -308,10 +335,10 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         if (pos + 4 > subject_length) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
-          Char next1 = subject.CharAt(pos + 1);
-          Char next2 = subject.CharAt(pos + 2);
-          Char next3 = subject.CharAt(pos + 3);
-          current_char = (subject.CharAt(pos) | (next1 << 8) | (next2 << 16) |
+          Char next1 = subject[pos + 1];
+          Char next2 = subject[pos + 2];
+          Char next3 = subject[pos + 3];
+          current_char = (subject[pos] | (next1 << 8) | (next2 << 16) |
                           (next3 << 24));
           pc += BC_LOAD_4_CURRENT_CHARS_LENGTH;
         }
@@ -320,10 +347,10 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
       BYTECODE(LOAD_4_CURRENT_CHARS_UNCHECKED) {
         ASSERT(sizeof(Char) == 1);
         int pos = current + (insn >> BYTECODE_SHIFT);
-        Char next1 = subject.CharAt(pos + 1);
-        Char next2 = subject.CharAt(pos + 2);
-        Char next3 = subject.CharAt(pos + 3);
-        current_char = (subject.CharAt(pos) | (next1 << 8) | (next2 << 16) |
+        Char next1 = subject[pos + 1];
+        Char next2 = subject[pos + 2];
+        Char next3 = subject[pos + 3];
+        current_char = (subject[pos] | (next1 << 8) | (next2 << 16) |
                         (next3 << 24));
         pc += BC_LOAD_4_CURRENT_CHARS_UNCHECKED_LENGTH;
         break;
@@ -502,7 +529,7 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         } else {
           int i;
           for (i = 0; i < len; i++) {
-            if (subject.CharAt(from + i) != subject.CharAt(current + i)) {
+            if (subject[from + i] != subject[current + i]) {
               pc = code_base + Load32Aligned(pc + 4);
               break;
             }
@@ -552,7 +579,7 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         int by = static_cast<uint32_t>(insn) >> BYTECODE_SHIFT;
         if (subject_length - current > by) {
           current = subject_length - by;
-          current_char = subject.CharAt(current - 1);
+          current_char = subject[current - 1];
         }
         pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
         break;
@@ -568,8 +595,7 @@ IrregexpInterpreter::IrregexpResult IrregexpInterpreter::Match(
     const TypedData& bytecode,
     const String& subject,
     int32_t* registers,
-    intptr_t start_position,
-    Zone* zone) {
+    intptr_t start_position) {
   NoSafepointScope no_safepoint;
   const uint8_t* code_base = reinterpret_cast<uint8_t*>(bytecode.DataAddr(0));
 
@@ -578,12 +604,27 @@ IrregexpInterpreter::IrregexpResult IrregexpInterpreter::Match(
     previous_char = subject.CharAt(start_position - 1);
   }
 
-  if (subject.IsOneByteString() || subject.IsExternalOneByteString()) {
-    return RawMatch<uint8_t>(code_base, subject, registers, start_position,
-                             previous_char, zone);
-  } else if (subject.IsTwoByteString() || subject.IsExternalTwoByteString()) {
-    return RawMatch<uint16_t>(code_base, subject, registers, start_position,
-                              previous_char, zone);
+  // The subject is read directly rather than through String::CharAt, which
+  // dispatches on the string's class for every character.
+  const intptr_t subject_length = subject.Length();
+  if (subject.IsOneByteString()) {
+    return RawMatch<uint8_t>(code_base, OneByteString::DataStart(subject),
+                             subject_length, registers, start_position,
+                             previous_char);
+  } else if (subject.IsExternalOneByteString()) {
+    return RawMatch<uint8_t>(code_base,
+                             ExternalOneByteString::DataStart(subject),
+                             subject_length, registers, start_position,
+                             previous_char);
+  } else if (subject.IsTwoByteString()) {
+    return RawMatch<uint16_t>(code_base, TwoByteString::DataStart(subject),
+                              subject_length, registers, start_position,
+                              previous_char);
+  } else if (subject.IsExternalTwoByteString()) {
+    return RawMatch<uint16_t>(code_base,
+                              ExternalTwoByteString::DataStart(subject),
+                              subject_length, registers, start_position,
+                              previous_char);
   } else {
     UNREACHABLE();
     return IrregexpInterpreter::RE_FAILURE;
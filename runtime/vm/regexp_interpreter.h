@@ -9,7 +9,6 @@
 
 #include "vm/allocation.h"
 #include "vm/object.h"
-#include "vm/zone.h"
 
 namespace dart {
 
@@ -20,8 +19,7 @@ class IrregexpInterpreter : public AllStatic {
   static IrregexpResult Match(const TypedData& bytecode,
                               const String& subject,
                               int32_t* captures,
-                              intptr_t start_position,
-                              Zone* zone);
+                              intptr_t start_position);
 };
 
 }  // namespace dart
@@ -7,6 +7,7 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
 #include "vm/unit_test.h"
 
@@ -110,4 +111,32 @@ ISOLATE_UNIT_TEST_CASE(RegExp_ExternalTwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+// Returns the start of the first match of 'pat' in 'str' at or after
+// 'start', found by the bytecode interpreter, or -1.
+static intptr_t InterpretMatchStart(const char* pat,
+                                    const char* str,
+                                    intptr_t start) {
+  Thread* thread = Thread::Current();
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+      thread, String::Handle(String::New(pat)), false, false));
+  const Instance& result =
+      Instance::Handle(BytecodeRegExpMacroAssembler::Interpret(
+          regexp, String::Handle(String::New(str)),
+          Smi::Handle(Smi::New(start)), /*sticky=*/false, thread->zone()));
+  if (result.IsNull()) {
+    return -1;
+  }
+  return TypedData::Cast(result).GetInt32(0);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LiteralPrefix) {
+  EXPECT_EQ(9, InterpretMatchStart("ERROR:\\d", "ERROR:x  ERROR:1", 0));
+  EXPECT_EQ(-1, InterpretMatchStart("ERROR:\\d", "ERROR:x  ERROR:1", 10));
+  EXPECT_EQ(4, InterpretMatchStart("(ab)+c", "abd ababc", 0));
+  EXPECT_EQ(7, InterpretMatchStart("\\bcat", "concat cat", 0));
+  EXPECT_EQ(2, InterpretMatchStart("ab*|c", "xxcab", 0));
+  EXPECT_EQ(-1, InterpretMatchStart("abc", "ab", 0));
+  EXPECT_EQ(2, InterpretMatchStart("abc", "ababc", 2));
+}
+
 }  // namespace dart
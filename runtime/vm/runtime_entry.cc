@@ -328,6 +328,12 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   }
 #endif
   Heap::Space space = Heap::kNew;
+#if !defined(PRODUCT)
+  // Most instances of this class survive scavenges; skip the copying.
+  if (isolate->class_table()->PretenureFor(cls.id())) {
+    space = Heap::kOld;
+  }
+#endif  // !defined(PRODUCT)
   const Instance& instance = Instance::Handle(Instance::New(cls, space));
 
   arguments.SetReturn(instance);
@@ -1737,6 +1743,51 @@ DEFINE_RUNTIME_ENTRY(MegamorphicCacheMissHandler, 3) {
 #endif  // !defined(TARGET_ARCH_DBC)
 }
 
+// Handle a miss of an interpreted instance call that went megamorphic, by
+// looking up the target in the megamorphic cache of its selector, which is
+// shared with the megamorphic calls of compiled code.
+//   Arg0: Receiver.
+//   Arg1: ICData of the call site.
+//   Returns: target function to call or null.
+DEFINE_RUNTIME_ENTRY(InterpretedMegamorphicCacheMissHandler, 2) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  UNREACHABLE();
+#else
+  const Instance& receiver = Instance::CheckedHandle(zone, arguments.ArgAt(0));
+  const ICData& ic_data = ICData::CheckedHandle(zone, arguments.ArgAt(1));
+  const String& name = String::Handle(zone, ic_data.target_name());
+  const Array& descriptor =
+      Array::Handle(zone, ic_data.arguments_descriptor());
+  const MegamorphicCache& cache = MegamorphicCache::Handle(
+      zone, MegamorphicCacheTable::Lookup(isolate, name, descriptor));
+  const Class& cls = Class::Handle(zone, receiver.clazz());
+  ASSERT(!cls.IsNull());
+  const Smi& class_id = Smi::Handle(zone, Smi::New(cls.id()));
+  Function& target_function = Function::Handle(zone);
+  target_function ^= cache.Lookup(class_id);
+  if (target_function.IsNull()) {
+    ArgumentsDescriptor args_desc(descriptor);
+    target_function =
+        Resolver::ResolveDynamicForReceiverClass(cls, name, args_desc);
+    if (target_function.IsNull()) {
+      target_function = InlineCacheMissHelper(receiver, descriptor, name);
+      if (target_function.IsNull()) {
+        ASSERT(!FLAG_lazy_dispatchers);
+        arguments.SetReturn(target_function);
+        return;
+      }
+    }
+    cache.EnsureCapacity();
+    cache.Insert(class_id, target_function);
+  }
+  if (FLAG_trace_ic) {
+    OS::PrintErr("Interpreted megamorphic IC miss, class=%s, function=%s\n",
+                 cls.ToCString(), target_function.ToCString());
+  }
+  arguments.SetReturn(target_function);
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 // Invoke appropriate noSuchMethod or closure from getter.
 // Arg0: receiver
 // Arg1: ICData or MegamorphicCache
@@ -2014,6 +2065,76 @@ static void HandleStackOverflowTestCases(Thread* thread) {
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+// OSR code is not installed on its function, so a loop that deoptimizes out
+// of the function's optimized code, or is entered again by a later call that
+// runs unoptimized, would otherwise compile a fresh OSR variant every time it
+// gets hot. Keep recent OSR code in a small direct-mapped cache keyed by the
+// unoptimized code and the OSR deopt id. An entry is only reused while the
+// function has not deoptimized since it was compiled and the code has not
+// been disabled by CHA or field guard invalidation.
+enum {
+  kOsrCodeCacheCodeIndex,
+  kOsrCodeCacheUnoptimizedCodeIndex,
+  kOsrCodeCacheIdIndex,
+  kOsrCodeCacheDeoptCounterIndex,
+  kOsrCodeCacheEntrySize,
+};
+static const intptr_t kOsrCodeCacheEntries = 16;
+
+static intptr_t OsrCodeCacheIndex(const Function& function, intptr_t osr_id) {
+  const intptr_t hash = (function.kernel_offset() > 0)
+                            ? function.kernel_offset()
+                            : function.token_pos().value();
+  return ((hash * 31 + osr_id) & (kOsrCodeCacheEntries - 1)) *
+         kOsrCodeCacheEntrySize;
+}
+
+static RawCode* LookupOsrCode(Zone* zone,
+                              Isolate* isolate,
+                              const Function& function,
+                              intptr_t osr_id) {
+  const Array& cache =
+      Array::Handle(zone, isolate->object_store()->osr_code_cache());
+  if (cache.IsNull()) {
+    return Code::null();
+  }
+  const intptr_t index = OsrCodeCacheIndex(function, osr_id);
+  if ((cache.At(index + kOsrCodeCacheUnoptimizedCodeIndex) !=
+       function.unoptimized_code()) ||
+      (cache.At(index + kOsrCodeCacheIdIndex) != Smi::New(osr_id)) ||
+      (cache.At(index + kOsrCodeCacheDeoptCounterIndex) !=
+       Smi::New(function.deoptimization_counter()))) {
+    return Code::null();
+  }
+  Code& code = Code::Handle(zone);
+  code ^= cache.At(index + kOsrCodeCacheCodeIndex);
+  if (!code.is_alive() || code.IsDisabled()) {
+    return Code::null();
+  }
+  return code.raw();
+}
+
+static void InsertOsrCode(Zone* zone,
+                          Isolate* isolate,
+                          const Function& function,
+                          intptr_t osr_id,
+                          const Code& code) {
+  Array& cache = Array::Handle(zone, isolate->object_store()->osr_code_cache());
+  if (cache.IsNull()) {
+    cache = Array::New(kOsrCodeCacheEntries * kOsrCodeCacheEntrySize,
+                       Heap::kOld);
+    isolate->object_store()->set_osr_code_cache(cache);
+  }
+  const intptr_t index = OsrCodeCacheIndex(function, osr_id);
+  cache.SetAt(index + kOsrCodeCacheCodeIndex, code);
+  cache.SetAt(index + kOsrCodeCacheUnoptimizedCodeIndex,
+              Code::Handle(zone, function.unoptimized_code()));
+  cache.SetAt(index + kOsrCodeCacheIdIndex,
+              Smi::Handle(zone, Smi::New(osr_id)));
+  cache.SetAt(index + kOsrCodeCacheDeoptCounterIndex,
+              Smi::Handle(zone, Smi::New(function.deoptimization_counter())));
+}
+
 static void HandleOSRRequest(Thread* thread) {
   Isolate* isolate = thread->isolate();
   ASSERT(isolate->use_osr());
@@ -2055,12 +2176,24 @@ static void HandleOSRRequest(Thread* thread) {
                  function.usage_counter());
   }
 
-  // Since the code is referenced from the frame and the ZoneHandle,
-  // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  if (result.IsError()) {
-    Exceptions::PropagateError(Error::Cast(result));
+  Zone* zone = thread->zone();
+  Object& result =
+      Object::Handle(zone, LookupOsrCode(zone, isolate, function, osr_id));
+  if (!result.IsNull()) {
+    if (FLAG_trace_osr) {
+      OS::PrintErr("Reusing OSR code for %s at id=%" Pd "\n",
+                   function.ToFullyQualifiedCString(), osr_id);
+    }
+  } else {
+    // Since the code is referenced from the frame and the ZoneHandle,
+    // it cannot have been removed from the function.
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    if (result.IsError()) {
+      Exceptions::PropagateError(Error::Cast(result));
+    }
+    if (!result.IsNull()) {
+      InsertOsrCode(zone, isolate, function, osr_id, Code::Cast(result));
+    }
   }
 
   if (!result.IsNull()) {
@@ -2163,6 +2296,15 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
 
   ASSERT(unoptimized_compilation || function.HasCode());
 
+  // The unoptimized code continues from the usage counted by the interpreter
+  // instead of warming up again. This way a function can stay interpreted
+  // until it is hot, see --compilation_counter_threshold, and the ICData it
+  // collected there feeds its optimization soon after.
+  intptr_t interpreter_usage = 0;
+  if (unoptimized_compilation && (function.usage_counter() > 0)) {
+    interpreter_usage = function.usage_counter();
+  }
+
   if (unoptimized_compilation ||
       Compiler::CanOptimizeFunction(thread, function)) {
     if (FLAG_background_compilation) {
@@ -2193,7 +2335,8 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
         // Note that the background compilation queue rejects duplicate entries.
         function.SetUsageCounter(INT_MIN);
         BackgroundCompiler::Start(isolate);
-        isolate->background_compiler()->CompileOptimized(function);
+        isolate->background_compiler()->CompileOptimized(function,
+                                                         interpreter_usage);
 
         // Continue in the same code.
         arguments.SetReturn(function);
@@ -2215,6 +2358,9 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
     if (result.IsError()) {
       Exceptions::PropagateError(Error::Cast(result));
     }
+    if (unoptimized_compilation && (function.usage_counter() == 0)) {
+      function.SetUsageCounter(interpreter_usage);
+    }
   }
   arguments.SetReturn(function);
 #else
@@ -2480,6 +2626,9 @@ DEFINE_LEAF_RUNTIME_ENTRY(intptr_t,
               deoptimizing_code ? "code & frame" : "frame",
               is_lazy_deopt ? "lazy-deopt" : "");
   }
+#if !defined(PRODUCT)
+  isolate->GetDeoptimizationCountMetric()->increment();
+#endif  // !defined(PRODUCT)
 
 #if !defined(TARGET_ARCH_DBC)
   if (is_lazy_deopt) {
@@ -2719,6 +2868,18 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(
     true /* is_float */,
     reinterpret_cast<RuntimeFunction>(static_cast<UnaryMathCFunction>(&tan)));
 
+DEFINE_RAW_LEAF_RUNTIME_ENTRY(
+    LibcExp,
+    1,
+    true /* is_float */,
+    reinterpret_cast<RuntimeFunction>(static_cast<UnaryMathCFunction>(&exp)));
+
+DEFINE_RAW_LEAF_RUNTIME_ENTRY(
+    LibcLog,
+    1,
+    true /* is_float */,
+    reinterpret_cast<RuntimeFunction>(static_cast<UnaryMathCFunction>(&log)));
+
 DEFINE_RAW_LEAF_RUNTIME_ENTRY(
     LibcAtan,
     1,
@@ -7,14 +7,17 @@
 #include "include/dart_api.h"
 #include "include/dart_native_api.h"
 #include "platform/globals.h"
+#include "platform/text_buffer.h"
 
 #include "vm/base64.h"
+#include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/cpu.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
+#include "vm/deopt_instructions.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
 #include "vm/kernel_isolate.h"
@@ -51,6 +54,7 @@ namespace dart {
 DECLARE_FLAG(bool, trace_service);
 DECLARE_FLAG(bool, trace_service_pause_events);
 DECLARE_FLAG(bool, profile_vm);
+DECLARE_FLAG(int, deoptimization_log_size);
 DEFINE_FLAG(charp,
             vm_name,
             "vm",
@@ -3060,6 +3064,7 @@ static const char* const report_enum_names[] = {
     SourceReport::kCoverageStr,
     SourceReport::kPossibleBreakpointsStr,
     SourceReport::kProfileStr,
+    SourceReport::kExecutedStr,
     NULL,
 };
 
@@ -3092,6 +3097,8 @@ static bool GetSourceReport(Thread* thread, JSONStream* js) {
       report_set |= SourceReport::kPossibleBreakpoints;
     } else if (strcmp(*reports, SourceReport::kProfileStr) == 0) {
       report_set |= SourceReport::kProfile;
+    } else if (strcmp(*reports, SourceReport::kExecutedStr) == 0) {
+      report_set |= SourceReport::kExecuted;
     }
     reports++;
   }
@@ -3531,6 +3538,19 @@ static bool GetVMMetric(Thread* thread, JSONStream* js) {
   return false;
 }
 
+static const MethodParameter* get_vm_metrics_prometheus_params[] = {
+    NO_ISOLATE_PARAMETER, NULL,
+};
+
+static bool GetVMMetricsPrometheus(Thread* thread, JSONStream* js) {
+  TextBuffer buffer(4 * KB);
+  Metric::PrintPrometheus(&buffer);
+  JSONObject obj(js);
+  obj.AddProperty("type", "_PrometheusMetrics");
+  obj.AddProperty("text", buffer.buf());
+  return true;
+}
+
 static const char* const timeline_streams_enum_names[] = {
     "all",
 #define DEFINE_NAME(name, unused) #name,
@@ -3777,6 +3797,34 @@ static bool GetTagProfile(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_compiler_pass_stats_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new BoolParameter("reset", false),
+    NULL,
+};
+
+// Prints the time and zone memory used by each compiler pass, summed over
+// the compilations of the isolate, and optionally clears them.
+static bool GetCompilerPassStats(Thread* thread, JSONStream* js) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  js->PrintError(kFeatureDisabled, "Compiler is disabled in AOT mode.");
+  return true;
+#else
+  const bool reset = BoolParameter::Parse(js->LookupParam("reset"), false);
+  Isolate* isolate = thread->isolate();
+  MutexLocker ml(isolate->mutex());
+  {
+    JSONObject jsobj(js);
+    jsobj.AddProperty("type", "_CompilerPassStats");
+    isolate->compiler_pass_stats()->PrintToJSONObject(&jsobj);
+  }
+  if (reset) {
+    isolate->compiler_pass_stats()->Clear();
+  }
+  return true;
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 static const char* const tags_enum_names[] = {
     "None", "UserVM", "UserOnly", "VMUser", "VMOnly", NULL,
 };
@@ -3833,6 +3881,26 @@ static bool GetCpuProfileTimeline(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_cpu_profile_pprof_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new EnumParameter("tags", true, tags_enum_names),
+    new Int64Parameter("timeOriginMicros", false),
+    new Int64Parameter("timeExtentMicros", false),
+    NULL,
+};
+
+static bool GetCpuProfilePprof(Thread* thread, JSONStream* js) {
+  Profile::TagOrder tag_order =
+      EnumMapper(js->LookupParam("tags"), tags_enum_names, tags_enum_values);
+  int64_t time_origin_micros =
+      Int64Parameter::Parse(js->LookupParam("timeOriginMicros"));
+  int64_t time_extent_micros =
+      Int64Parameter::Parse(js->LookupParam("timeExtentMicros"));
+  ProfilerService::PrintPprofJSON(js, tag_order, time_origin_micros,
+                                  time_extent_micros);
+  return true;
+}
+
 static const MethodParameter* get_allocation_samples_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     new EnumParameter("tags", true, tags_enum_names),
@@ -3943,6 +4011,30 @@ static bool CollectAllGarbage(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_deoptimization_log_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER, NULL,
+};
+
+// Prints the most recent deoptimizations of the isolate, oldest first.
+static bool GetDeoptimizationLog(Thread* thread, JSONStream* js) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  js->PrintError(kFeatureDisabled, "Compiler is disabled in AOT mode.");
+  return true;
+#else
+  JSONObject jsobj(js);
+  jsobj.AddProperty("type", "_DeoptimizationLog");
+  jsobj.AddProperty("capacity",
+                    static_cast<intptr_t>(FLAG_deoptimization_log_size));
+  DeoptimizationLog* log = thread->isolate()->deoptimization_log();
+  if (log == NULL) {
+    JSONArray events(&jsobj, "deoptimizations");
+  } else {
+    log->PrintToJSONObject(&jsobj);
+  }
+  return true;
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 static const MethodParameter* get_heap_map_params[] = {
     RUNNABLE_ISOLATE_PARAMETER, NULL,
 };
@@ -3995,20 +4087,34 @@ static bool RequestHeapSnapshot(Thread* thread, JSONStream* js) {
   return true;
 }
 
-void Service::SendGraphEvent(Thread* thread,
-                             ObjectGraph::SnapshotRoots roots,
-                             bool collect_garbage) {
-  uint8_t* buffer = NULL;
-  WriteStream stream(&buffer, &allocator, 1 * MB);
-  ObjectGraph graph(thread);
-  intptr_t node_count = graph.Serialize(&stream, roots, collect_garbage);
-
-  // Chrome crashes receiving a single tens-of-megabytes blob, so send the
-  // snapshot in megabyte-sized chunks instead.
-  const intptr_t kChunkSize = 1 * MB;
-  intptr_t num_chunks =
-      (stream.bytes_written() + (kChunkSize - 1)) / kChunkSize;
-  for (intptr_t i = 0; i < num_chunks; i++) {
+// Sends the graph to the graph stream while it is being serialized, so only
+// one chunk of it is held in memory. Chrome crashes receiving a single
+// tens-of-megabytes blob, so the chunks are megabyte-sized. The number of
+// chunks is only known at the end of the walk, so it is only given with the
+// last chunk, together with the number of nodes.
+class GraphEventSender : public ObjectGraph::ChunkSink {
+ public:
+  explicit GraphEventSender(Thread* thread)
+      : ObjectGraph::ChunkSink(kChunkSize), thread_(thread), num_chunks_(0) {}
+
+  void WriteChunk(const uint8_t* bytes, intptr_t length) {
+    SendChunk(bytes, length, false, 0);
+  }
+
+  void WriteLastChunk(const uint8_t* bytes,
+                      intptr_t length,
+                      intptr_t node_count) {
+    SendChunk(bytes, length, true, node_count);
+  }
+
+ private:
+  static const intptr_t kChunkSize = 1 * MB;
+
+  void SendChunk(const uint8_t* bytes,
+                 intptr_t length,
+                 bool last,
+                 intptr_t node_count) {
+    const intptr_t chunk_index = num_chunks_++;
     JSONStream js;
     {
       JSONObject jsobj(&js);
@@ -4016,29 +4122,41 @@ void Service::SendGraphEvent(Thread* thread,
       jsobj.AddProperty("method", "streamNotify");
       {
         JSONObject params(&jsobj, "params");
-        params.AddProperty("streamId", graph_stream.id());
+        params.AddProperty("streamId", Service::graph_stream.id());
         {
           JSONObject event(&params, "event");
           event.AddProperty("type", "Event");
           event.AddProperty("kind", "_Graph");
-          event.AddProperty("isolate", thread->isolate());
+          event.AddProperty("isolate", thread_->isolate());
           event.AddPropertyTimeMillis("timestamp", OS::GetCurrentTimeMillis());
-
-          event.AddProperty("chunkIndex", i);
-          event.AddProperty("chunkCount", num_chunks);
-          event.AddProperty("nodeCount", node_count);
+          event.AddProperty("chunkIndex", chunk_index);
+          if (last) {
+            event.AddProperty("chunkCount", num_chunks_);
+            event.AddProperty("nodeCount", node_count);
+          }
         }
       }
     }
+    Service::SendEventWithData(Service::graph_stream.id(), "_Graph",
+                               js.buffer()->buf(), js.buffer()->length(),
+                               bytes, length);
+  }
 
-    uint8_t* chunk_start = buffer + (i * kChunkSize);
-    intptr_t chunk_size = (i + 1 == num_chunks)
-                              ? stream.bytes_written() - (i * kChunkSize)
-                              : kChunkSize;
+  Thread* thread_;
+  intptr_t num_chunks_;
+};
 
-    SendEventWithData(graph_stream.id(), "_Graph", js.buffer()->buf(),
-                      js.buffer()->length(), chunk_start, chunk_size);
-  }
+void Service::SendGraphEvent(Thread* thread,
+                             ObjectGraph::SnapshotRoots roots,
+                             bool collect_garbage) {
+  uint8_t* buffer = NULL;
+  WriteStream stream(&buffer, &allocator, 1 * MB);
+  ObjectGraph graph(thread);
+  GraphEventSender sender(thread);
+  intptr_t node_count =
+      graph.Serialize(&stream, roots, collect_garbage, &sender);
+  sender.WriteLastChunk(buffer, stream.bytes_written(), node_count);
+  free(buffer);
 }
 
 void Service::SendInspectEvent(Isolate* isolate, const Object& inspectee) {
@@ -4797,10 +4915,16 @@ static const ServiceMethodDescriptor service_methods_[] = {
       get_native_allocation_samples_params },
   { "getClassList", GetClassList,
     get_class_list_params },
+  { "_getCompilerPassStats", GetCompilerPassStats,
+    get_compiler_pass_stats_params },
   { "_getCpuProfile", GetCpuProfile,
     get_cpu_profile_params },
+  { "_getCpuProfilePprof", GetCpuProfilePprof,
+    get_cpu_profile_pprof_params },
   { "_getCpuProfileTimeline", GetCpuProfileTimeline,
     get_cpu_profile_timeline_params },
+  { "_getDeoptimizationLog", GetDeoptimizationLog,
+    get_deoptimization_log_params },
   { "getFlagList", GetFlagList,
     get_flag_list_params },
   { "_getHeapMap", GetHeapMap,
@@ -4849,6 +4973,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_vm_metric_params },
   { "_getVMMetricList", GetVMMetricList,
     get_vm_metric_list_params },
+  { "_getVMMetricsPrometheus", GetVMMetricsPrometheus,
+    get_vm_metrics_prometheus_params },
   { "_getVMTimeline", GetVMTimeline,
     get_vm_timeline_params },
   { "_getVMTimelineFlags", GetVMTimelineFlags,
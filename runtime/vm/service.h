@@ -224,6 +224,8 @@ class Service : public AllStatic {
   static bool needs_gc_events_;
   static bool needs_echo_events_;
   static bool needs_graph_events_;
+
+  friend class GraphEventSender;
 };
 
 }  // namespace dart
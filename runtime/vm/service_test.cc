@@ -800,6 +800,58 @@ ISOLATE_UNIT_TEST_CASE(Service_Profile) {
 
 #endif  // !defined(TARGET_ARCH_ARM64)
 
+ISOLATE_UNIT_TEST_CASE(Service_CompilerPassStats) {
+  const char* kScript =
+      "var port;\n"  // Set to our mock port by C++.
+      "\n"
+      "int fib(int n) => n < 2 ? n : fib(n - 1) + fib(n - 2);\n"
+      "main() {\n"
+      "  return fib(20);\n"
+      "}";
+
+  SetFlagScope<int> sfs(&FLAG_optimization_counter_threshold, 100);
+  SetFlagScope<bool> sfs2(&FLAG_background_compilation, false);
+  SetFlagScope<bool> sfs3(&FLAG_compiler_pass_stats, true);
+  Isolate* isolate = thread->isolate();
+  isolate->set_is_runnable(true);
+  Dart_Handle lib;
+  {
+    TransitionVMToNative transition(thread);
+
+    lib = TestCase::LoadTestScript(kScript, NULL);
+    EXPECT_VALID(lib);
+    Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+    EXPECT_VALID(result);
+  }
+
+  // Build a mock message handler and wrap it in a dart port.
+  ServiceTestMessageHandler handler;
+  Dart_Port port_id = PortMap::CreatePort(&handler);
+  Dart_Handle port = Api::NewHandle(thread, SendPort::New(port_id));
+  EXPECT_VALID(port);
+  {
+    TransitionVMToNative transition(thread);
+    EXPECT_VALID(Dart_SetField(lib, NewString("port"), port));
+  }
+
+  Array& service_msg = Array::Handle();
+  service_msg = Eval(lib,
+                     "[0, port, '0', '_getCompilerPassStats', "
+                     "['reset'], ['true']]");
+  HandleIsolateMessage(isolate, service_msg);
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  EXPECT_SUBSTRING("\"type\":\"_CompilerPassStats\"", handler.msg());
+  EXPECT_SUBSTRING("\"name\":\"AllocateRegisters\"", handler.msg());
+  EXPECT_SUBSTRING("fib\"", handler.msg());
+  EXPECT_NOTSUBSTRING("\"totalInitialInstructions\":0,", handler.msg());
+
+  // The stats were cleared by the previous request.
+  service_msg = Eval(lib, "[0, port, '0', '_getCompilerPassStats', [], []]");
+  HandleIsolateMessage(isolate, service_msg);
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  EXPECT_SUBSTRING("\"passes\":[]", handler.msg());
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
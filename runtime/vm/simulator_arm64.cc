@@ -728,6 +728,11 @@ Simulator::Simulator() : exclusive_access_addr_(0), exclusive_access_value_(0) {
 
   pc_modified_ = false;
   icount_ = 0;
+  for (intptr_t i = 0; i < kDecodeCacheSize; i++) {
+    decode_cache_[i].pc = 0;
+    decode_cache_[i].bits = 0;
+    decode_cache_[i].decoder = NULL;
+  }
   break_pc_ = NULL;
   break_instr_ = 0;
   last_setjmp_buffer_ = NULL;
@@ -1412,22 +1417,6 @@ void Simulator::DecodePCRel(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPImmediate(Instr* instr) {
-  if (instr->IsMoveWideOp()) {
-    DecodeMoveWide(instr);
-  } else if (instr->IsAddSubImmOp()) {
-    DecodeAddSubImm(instr);
-  } else if (instr->IsBitfieldOp()) {
-    DecodeBitfield(instr);
-  } else if (instr->IsLogicalImmOp()) {
-    DecodeLogicalImm(instr);
-  } else if (instr->IsPCRelOp()) {
-    DecodePCRel(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
 void Simulator::DecodeCompareAndBranch(Instr* instr) {
   const int op = instr->Bit(24);
   const Register rt = instr->RtField();
@@ -1762,26 +1751,6 @@ void Simulator::DecodeUnconditionalBranchReg(Instr* instr) {
   }
 }
 
-void Simulator::DecodeCompareBranch(Instr* instr) {
-  if (instr->IsCompareAndBranchOp()) {
-    DecodeCompareAndBranch(instr);
-  } else if (instr->IsConditionalBranchOp()) {
-    DecodeConditionalBranch(instr);
-  } else if (instr->IsExceptionGenOp()) {
-    DecodeExceptionGen(instr);
-  } else if (instr->IsSystemOp()) {
-    DecodeSystem(instr);
-  } else if (instr->IsTestAndBranchOp()) {
-    DecodeTestAndBranch(instr);
-  } else if (instr->IsUnconditionalBranchOp()) {
-    DecodeUnconditionalBranch(instr);
-  } else if (instr->IsUnconditionalBranchRegOp()) {
-    DecodeUnconditionalBranchReg(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
 void Simulator::DecodeLoadStoreReg(Instr* instr) {
   // Calculate the address.
   const Register rn = instr->RnField();
@@ -2129,20 +2098,6 @@ void Simulator::DecodeLoadStoreExclusive(Instr* instr) {
   }
 }
 
-void Simulator::DecodeLoadStore(Instr* instr) {
-  if (instr->IsLoadStoreRegOp()) {
-    DecodeLoadStoreReg(instr);
-  } else if (instr->IsLoadStoreRegPairOp()) {
-    DecodeLoadStoreRegPair(instr);
-  } else if (instr->IsLoadRegLiteralOp()) {
-    DecodeLoadRegLiteral(instr);
-  } else if (instr->IsLoadStoreExclusiveOp()) {
-    DecodeLoadStoreExclusive(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
 int64_t Simulator::ShiftOperand(uint8_t reg_size,
                                 int64_t value,
                                 Shift shift_type,
@@ -2657,26 +2612,6 @@ void Simulator::DecodeConditionalSelect(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPRegister(Instr* instr) {
-  if (instr->IsAddSubShiftExtOp()) {
-    DecodeAddSubShiftExt(instr);
-  } else if (instr->IsAddSubWithCarryOp()) {
-    DecodeAddSubWithCarry(instr);
-  } else if (instr->IsLogicalShiftOp()) {
-    DecodeLogicalShift(instr);
-  } else if (instr->IsMiscDP1SourceOp()) {
-    DecodeMiscDP1Source(instr);
-  } else if (instr->IsMiscDP2SourceOp()) {
-    DecodeMiscDP2Source(instr);
-  } else if (instr->IsMiscDP3SourceOp()) {
-    DecodeMiscDP3Source(instr);
-  } else if (instr->IsConditionalSelectOp()) {
-    DecodeConditionalSelect(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
 void Simulator::DecodeSIMDCopy(Instr* instr) {
   const int32_t Q = instr->Bit(30);
   const int32_t op = instr->Bit(29);
@@ -3118,18 +3053,6 @@ void Simulator::DecodeSIMDTwoReg(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPSimd1(Instr* instr) {
-  if (instr->IsSIMDCopyOp()) {
-    DecodeSIMDCopy(instr);
-  } else if (instr->IsSIMDThreeSameOp()) {
-    DecodeSIMDThreeSame(instr);
-  } else if (instr->IsSIMDTwoRegOp()) {
-    DecodeSIMDTwoReg(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
 void Simulator::DecodeFPImm(Instr* instr) {
   if ((instr->Bit(31) != 0) || (instr->Bit(29) != 0) || (instr->Bit(23) != 0) ||
       (instr->Bits(5, 5) != 0)) {
@@ -3345,28 +3268,86 @@ void Simulator::DecodeFPCompare(Instr* instr) {
   }
 }
 
-void Simulator::DecodeFP(Instr* instr) {
-  if (instr->IsFPImmOp()) {
-    DecodeFPImm(instr);
-  } else if (instr->IsFPIntCvtOp()) {
-    DecodeFPIntCvt(instr);
-  } else if (instr->IsFPOneSourceOp()) {
-    DecodeFPOneSource(instr);
-  } else if (instr->IsFPTwoSourceOp()) {
-    DecodeFPTwoSource(instr);
-  } else if (instr->IsFPCompareOp()) {
-    DecodeFPCompare(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-void Simulator::DecodeDPSimd2(Instr* instr) {
-  if (instr->IsFPOp()) {
-    DecodeFP(instr);
-  } else {
-    UnimplementedInstruction(instr);
+// Returns the handler for the instruction class of |instr|.
+Simulator::Decoder Simulator::FindDecoder(Instr* instr) {
+  if (instr->IsDPImmediateOp()) {
+    if (instr->IsMoveWideOp()) {
+      return &Simulator::DecodeMoveWide;
+    } else if (instr->IsAddSubImmOp()) {
+      return &Simulator::DecodeAddSubImm;
+    } else if (instr->IsBitfieldOp()) {
+      return &Simulator::DecodeBitfield;
+    } else if (instr->IsLogicalImmOp()) {
+      return &Simulator::DecodeLogicalImm;
+    } else if (instr->IsPCRelOp()) {
+      return &Simulator::DecodePCRel;
+    }
+  } else if (instr->IsCompareBranchOp()) {
+    if (instr->IsCompareAndBranchOp()) {
+      return &Simulator::DecodeCompareAndBranch;
+    } else if (instr->IsConditionalBranchOp()) {
+      return &Simulator::DecodeConditionalBranch;
+    } else if (instr->IsExceptionGenOp()) {
+      return &Simulator::DecodeExceptionGen;
+    } else if (instr->IsSystemOp()) {
+      return &Simulator::DecodeSystem;
+    } else if (instr->IsTestAndBranchOp()) {
+      return &Simulator::DecodeTestAndBranch;
+    } else if (instr->IsUnconditionalBranchOp()) {
+      return &Simulator::DecodeUnconditionalBranch;
+    } else if (instr->IsUnconditionalBranchRegOp()) {
+      return &Simulator::DecodeUnconditionalBranchReg;
+    }
+  } else if (instr->IsLoadStoreOp()) {
+    if (instr->IsLoadStoreRegOp()) {
+      return &Simulator::DecodeLoadStoreReg;
+    } else if (instr->IsLoadStoreRegPairOp()) {
+      return &Simulator::DecodeLoadStoreRegPair;
+    } else if (instr->IsLoadRegLiteralOp()) {
+      return &Simulator::DecodeLoadRegLiteral;
+    } else if (instr->IsLoadStoreExclusiveOp()) {
+      return &Simulator::DecodeLoadStoreExclusive;
+    }
+  } else if (instr->IsDPRegisterOp()) {
+    if (instr->IsAddSubShiftExtOp()) {
+      return &Simulator::DecodeAddSubShiftExt;
+    } else if (instr->IsAddSubWithCarryOp()) {
+      return &Simulator::DecodeAddSubWithCarry;
+    } else if (instr->IsLogicalShiftOp()) {
+      return &Simulator::DecodeLogicalShift;
+    } else if (instr->IsMiscDP1SourceOp()) {
+      return &Simulator::DecodeMiscDP1Source;
+    } else if (instr->IsMiscDP2SourceOp()) {
+      return &Simulator::DecodeMiscDP2Source;
+    } else if (instr->IsMiscDP3SourceOp()) {
+      return &Simulator::DecodeMiscDP3Source;
+    } else if (instr->IsConditionalSelectOp()) {
+      return &Simulator::DecodeConditionalSelect;
+    }
+  } else if (instr->IsDPSimd1Op()) {
+    if (instr->IsSIMDCopyOp()) {
+      return &Simulator::DecodeSIMDCopy;
+    } else if (instr->IsSIMDThreeSameOp()) {
+      return &Simulator::DecodeSIMDThreeSame;
+    } else if (instr->IsSIMDTwoRegOp()) {
+      return &Simulator::DecodeSIMDTwoReg;
+    }
+  } else if (instr->IsDPSimd2Op()) {
+    if (instr->IsFPOp()) {
+      if (instr->IsFPImmOp()) {
+        return &Simulator::DecodeFPImm;
+      } else if (instr->IsFPIntCvtOp()) {
+        return &Simulator::DecodeFPIntCvt;
+      } else if (instr->IsFPOneSourceOp()) {
+        return &Simulator::DecodeFPOneSource;
+      } else if (instr->IsFPTwoSourceOp()) {
+        return &Simulator::DecodeFPTwoSource;
+      } else if (instr->IsFPCompareOp()) {
+        return &Simulator::DecodeFPCompare;
+      }
+    }
   }
+  return &Simulator::UnimplementedInstruction;
 }
 
 // Executes the current instruction.
@@ -3383,21 +3364,18 @@ void Simulator::InstructionDecode(Instr* instr) {
     }
   }
 
-  if (instr->IsDPImmediateOp()) {
-    DecodeDPImmediate(instr);
-  } else if (instr->IsCompareBranchOp()) {
-    DecodeCompareBranch(instr);
-  } else if (instr->IsLoadStoreOp()) {
-    DecodeLoadStore(instr);
-  } else if (instr->IsDPRegisterOp()) {
-    DecodeDPRegister(instr);
-  } else if (instr->IsDPSimd1Op()) {
-    DecodeDPSimd1(instr);
-  } else if (instr->IsDPSimd2Op()) {
-    DecodeDPSimd2(instr);
-  } else {
-    UnimplementedInstruction(instr);
+  // Entries are checked against the instruction bits as well as the pc, so
+  // patched code is decoded afresh without needing an explicit flush.
+  const uword pc = reinterpret_cast<uword>(instr);
+  const int32_t bits = instr->InstructionBits();
+  DecodeCacheEntry* entry =
+      &decode_cache_[(pc >> Instr::kInstrSizeLog2) & (kDecodeCacheSize - 1)];
+  if ((entry->pc != pc) || (entry->bits != bits)) {
+    entry->pc = pc;
+    entry->bits = bits;
+    entry->decoder = FindDecoder(instr);
   }
+  (this->*entry->decoder)(instr);
 
   if (!pc_modified_) {
     set_pc(reinterpret_cast<int64_t>(instr) + Instr::kInstrSize);
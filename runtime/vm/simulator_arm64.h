@@ -139,6 +139,15 @@ class Simulator {
   uword stack_base_;
   bool pc_modified_;
   uint64_t icount_;
+
+  // Direct-mapped cache of the handler for recently executed instructions.
+  struct DecodeCacheEntry {
+    uword pc;
+    int32_t bits;
+    void (Simulator::*decoder)(Instr* instr);
+  };
+  static const intptr_t kDecodeCacheSize = 4096;
+  DecodeCacheEntry decode_cache_[kDecodeCacheSize];
   static int64_t flag_stop_sim_at_;
   SimulatorSetjmpBuffer* last_setjmp_buffer_;
 
@@ -222,9 +231,11 @@ class Simulator {
   void DoRedirectedCall(Instr* instr);
 
   // Decode instructions.
+  typedef void (Simulator::*Decoder)(Instr* instr);
   void InstructionDecode(Instr* instr);
+  static Decoder FindDecoder(Instr* instr);
 #define DECODE_OP(op) void Decode##op(Instr* instr);
-  APPLY_OP_LIST(DECODE_OP)
+  APPLY_LEAF_OP_LIST(DECODE_OP)
 #undef DECODE_OP
 
   // Executes ARM64 instructions until the PC reaches kEndSimulatingPC.
@@ -2186,6 +2186,20 @@ RawObject* Simulator::Call(const Code& code,
     DISPATCH();
   }
 
+  {
+    BYTECODE(DExp, A_D);
+    const double value = bit_cast<double, RawObject*>(FP[rD]);
+    FP[rA] = bit_cast<RawObject*, double>(exp(value));
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(DLog, A_D);
+    const double value = bit_cast<double, RawObject*>(FP[rD]);
+    FP[rA] = bit_cast<RawObject*, double>(log(value));
+    DISPATCH();
+  }
+
   {
     BYTECODE(DPow, A_B_C);
     const double lhs = bit_cast<double, RawObject*>(FP[rB]);
@@ -2452,6 +2466,18 @@ RawObject* Simulator::Call(const Code& code,
     DISPATCH();
   }
 
+  {
+    BYTECODE(DExp, A_D);
+    UNREACHABLE();
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(DLog, A_D);
+    UNREACHABLE();
+    DISPATCH();
+  }
+
   {
     BYTECODE(DPow, A_B_C);
     UNREACHABLE();
@@ -3685,6 +3711,18 @@ RawObject* Simulator::Call(const Code& code,
     DISPATCH();
   }
 
+  {
+    BYTECODE(StoreIndexed4Uint32, A_B_C);
+    ASSERT(RawObject::IsTypedDataClassId(FP[rA]->GetClassId()));
+    RawTypedData* array = reinterpret_cast<RawTypedData*>(FP[rA]);
+    RawSmi* index = RAW_CAST(Smi, FP[rB]);
+    ASSERT(SimulatorHelpers::CheckIndex(index, array->ptr()->length_));
+    const uintptr_t value = reinterpret_cast<uintptr_t>(FP[rC]);
+    reinterpret_cast<uint32_t*>(array->ptr()->data())[Smi::Value(index)] =
+        static_cast<uint32_t>(value);
+    DISPATCH();
+  }
+
   {
     BYTECODE(TailCall, 0);
     RawCode* code = RAW_CAST(Code, SP[-0]);
@@ -3809,6 +3847,30 @@ RawObject* Simulator::Call(const Code& code,
     DISPATCH();
   }
 
+  {
+    BYTECODE(LoadIndexed4Uint32, A_B_C);
+    ASSERT(RawObject::IsTypedDataClassId(FP[rB]->GetClassId()));
+    RawTypedData* array = reinterpret_cast<RawTypedData*>(FP[rB]);
+    RawSmi* index = RAW_CAST(Smi, FP[rC]);
+    ASSERT(SimulatorHelpers::CheckIndex(index, array->ptr()->length_));
+    const uint32_t value =
+        reinterpret_cast<uint32_t*>(array->ptr()->data())[Smi::Value(index)];
+    FP[rA] = reinterpret_cast<RawObject*>(value);
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(LoadIndexed4Int32, A_B_C);
+    ASSERT(RawObject::IsTypedDataClassId(FP[rB]->GetClassId()));
+    RawTypedData* array = reinterpret_cast<RawTypedData*>(FP[rB]);
+    RawSmi* index = RAW_CAST(Smi, FP[rC]);
+    ASSERT(SimulatorHelpers::CheckIndex(index, array->ptr()->length_));
+    const int32_t value =
+        reinterpret_cast<int32_t*>(array->ptr()->data())[Smi::Value(index)];
+    FP[rA] = reinterpret_cast<RawObject*>(value);
+    DISPATCH();
+  }
+
   {
     BYTECODE(LoadIndexedExternalUint8, A_B_C);
     uint8_t* data = reinterpret_cast<uint8_t*>(FP[rB]);
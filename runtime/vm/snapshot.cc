@@ -8,6 +8,7 @@
 #include "vm/bootstrap.h"
 #include "vm/class_finalizer.h"
 #include "vm/dart.h"
+#include "vm/dart_api_state.h"
 #include "vm/exceptions.h"
 #include "vm/heap/heap.h"
 #include "vm/longjump.h"
@@ -317,26 +318,58 @@ RawClass* SnapshotReader::ReadClassId(intptr_t object_id) {
   Class& cls = Class::ZoneHandle(zone(), Class::null());
   AddBackRef(object_id, &cls, kIsDeserialized);
   // Read the library/class information and lookup the class.
-  str_ ^= ReadObjectImpl(class_header, kAsInlinedObject, kInvalidPatchIndex, 0);
-  library_ = Library::LookupLibrary(thread(), str_);
+  String& library_url = String::Handle(zone());
+  library_url ^=
+      ReadObjectImpl(class_header, kAsInlinedObject, kInvalidPatchIndex, 0);
+  String& class_name = String::Handle(zone());
+  class_name ^= ReadObjectImpl(kAsInlinedObject);
+  // Isolates exchanging messages tend to send the same few classes over and
+  // over, so look in the class cache of the isolate before scanning the
+  // libraries.
+  const intptr_t cache_index = ClassCacheIndex(library_url, class_name);
+  array_ = object_store()->message_class_cache();
+  if (!array_.IsNull()) {
+    obj_ = array_.At(cache_index + kClassCacheUrlOffset);
+    if (obj_.IsString() && library_url.Equals(String::Cast(obj_))) {
+      obj_ = array_.At(cache_index + kClassCacheNameOffset);
+      if (obj_.IsString() && class_name.Equals(String::Cast(obj_))) {
+        cls ^= array_.At(cache_index + kClassCacheClassOffset);
+        return cls.raw();
+      }
+    }
+  }
+  library_ = Library::LookupLibrary(thread(), library_url);
   if (library_.IsNull() || !library_.Loaded()) {
     SetReadException(
         "Invalid object found in message: library is not found or loaded.");
   }
-  str_ ^= ReadObjectImpl(kAsInlinedObject);
-  if (str_.raw() == Symbols::TopLevel().raw()) {
+  if (class_name.raw() == Symbols::TopLevel().raw()) {
     cls = library_.toplevel_class();
   } else {
-    str_ = String::ScrubName(str_);
+    str_ = String::ScrubName(class_name);
     cls = library_.LookupClassAllowPrivate(str_);
   }
   if (cls.IsNull()) {
     SetReadException("Invalid object found in message: class not found");
   }
   cls.EnsureIsFinalized(thread());
+  if (array_.IsNull()) {
+    array_ = Array::New(kClassCacheSize * kClassCacheEntryLength, Heap::kOld);
+    object_store()->set_message_class_cache(array_);
+  }
+  array_.SetAt(cache_index + kClassCacheUrlOffset, library_url);
+  array_.SetAt(cache_index + kClassCacheNameOffset, class_name);
+  array_.SetAt(cache_index + kClassCacheClassOffset, cls);
   return cls.raw();
 }
 
+intptr_t SnapshotReader::ClassCacheIndex(const String& library_url,
+                                         const String& class_name) {
+  const uword hash = static_cast<uword>(library_url.Hash()) * 31 +
+                     static_cast<uword>(class_name.Hash());
+  return (hash & (kClassCacheSize - 1)) * kClassCacheEntryLength;
+}
+
 RawObject* SnapshotReader::ReadStaticImplicitClosure(intptr_t object_id,
                                                      intptr_t class_header) {
   ASSERT(!Snapshot::IsFull(kind_));
@@ -1481,7 +1514,8 @@ static void malloc_deallocator(uint8_t* ptr) {
   free(reinterpret_cast<void*>(ptr));
 }
 
-MessageWriter::MessageWriter(bool can_send_any_object)
+MessageWriter::MessageWriter(bool can_send_any_object,
+                             bool transfer_external_typed_data)
     : SnapshotWriter(Thread::Current(),
                      Snapshot::kMessage,
                      malloc_allocator,
@@ -1490,10 +1524,96 @@ MessageWriter::MessageWriter(bool can_send_any_object)
                      &forward_list_,
                      can_send_any_object),
       forward_list_(thread(), kMaxPredefinedObjectIds),
-      finalizable_data_(new MessageFinalizableData()) {}
+      finalizable_data_(new MessageFinalizableData()),
+      transfer_external_typed_data_(transfer_external_typed_data),
+      finalizers_(NULL),
+      transfers_() {}
 
 MessageWriter::~MessageWriter() {
   delete finalizable_data_;
+  delete finalizers_;
+}
+
+typedef RawPointerKeyValueTrait<RawObject, FinalizablePersistentHandle*>
+    ExternalTypedDataFinalizerTrait;
+
+// Indexes the finalizers of external typed data objects by object.
+class ExternalTypedDataFinalizerVisitor : public HandleVisitor {
+ public:
+  ExternalTypedDataFinalizerVisitor(
+      Thread* thread,
+      MallocDirectChainedHashMap<ExternalTypedDataFinalizerTrait>* finalizers)
+      : HandleVisitor(thread), finalizers_(finalizers) {}
+
+  void VisitHandle(uword addr) {
+    FinalizablePersistentHandle* handle =
+        reinterpret_cast<FinalizablePersistentHandle*>(addr);
+    RawObject* raw = handle->raw();
+    if (!RawObject::IsExternalTypedDataClassId(raw->GetClassIdMayBeSmi()) ||
+        (handle->callback() == NULL)) {
+      return;
+    }
+    ExternalTypedDataFinalizerTrait::Pair* pair = finalizers_->Lookup(raw);
+    if (pair == NULL) {
+      finalizers_->Insert(ExternalTypedDataFinalizerTrait::Pair(raw, handle));
+    } else {
+      // Objects with several finalizers cannot be transferred.
+      pair->value = NULL;
+    }
+  }
+
+ private:
+  MallocDirectChainedHashMap<ExternalTypedDataFinalizerTrait>* finalizers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExternalTypedDataFinalizerVisitor);
+};
+
+FinalizablePersistentHandle* MessageWriter::FindExternalTypedDataFinalizer(
+    RawExternalTypedData* raw) {
+  if (finalizers_ == NULL) {
+    finalizers_ = new MallocDirectChainedHashMap<FinalizerTrait>();
+    ApiState* state = isolate()->api_state();
+    ASSERT(state != NULL);
+    ExternalTypedDataFinalizerVisitor visitor(thread(), finalizers_);
+    state->VisitWeakHandles(&visitor);
+  }
+  return finalizers_->LookupValue(raw);
+}
+
+void MessageWriter::AddTransfer(
+    RawExternalTypedData* raw,
+    FinalizablePersistentHandle* handle,
+    intptr_t external_size,
+    void* detached_data,
+    Dart_WeakPersistentHandleFinalizer detached_callback) {
+  Transfer transfer;
+  transfer.raw = raw;
+  transfer.handle = handle;
+  transfer.detached_data = detached_data;
+  transfer.detached_callback = detached_callback;
+  transfer.index = finalizable_data_->Put(
+      external_size, raw->ptr()->data_, handle->peer(), handle->callback());
+  transfers_.Add(transfer);
+}
+
+void MessageWriter::CompleteTransfers() {
+  for (intptr_t i = 0; i < transfers_.length(); i++) {
+    const Transfer& transfer = transfers_[i];
+    transfer.handle->ReplacePeer(transfer.detached_data,
+                                 transfer.detached_callback);
+    transfer.raw->ptr()->data_ =
+        reinterpret_cast<uint8_t*>(transfer.detached_data);
+  }
+  transfers_.Clear();
+}
+
+void MessageWriter::CancelTransfers(MessageFinalizableData* finalizable_data) {
+  for (intptr_t i = 0; i < transfers_.length(); i++) {
+    const Transfer& transfer = transfers_[i];
+    finalizable_data->Forget(transfer.index);
+    free(transfer.detached_data);
+  }
+  transfers_.Clear();
 }
 
 Message* MessageWriter::WriteMessage(const Object& obj,
@@ -1510,6 +1630,8 @@ Message* MessageWriter::WriteMessage(const Object& obj,
     WriteObject(obj.raw());
   } else {
     FreeBuffer();
+    // The sender keeps the data of anything it was going to transfer.
+    CancelTransfers(finalizable_data_);
     ThrowException(exception_type(), exception_msg());
   }
 
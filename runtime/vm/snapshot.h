@@ -12,6 +12,7 @@
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
 #include "vm/growable_array.h"
+#include "vm/hash_map.h"
 #include "vm/isolate.h"
 #include "vm/message.h"
 #include "vm/visitor.h"
@@ -26,6 +27,7 @@ class ClassTable;
 class Closure;
 class Code;
 class ExternalTypedData;
+class FinalizablePersistentHandle;
 class GrowableObjectArray;
 class Heap;
 class Instructions;
@@ -49,6 +51,7 @@ class RawContext;
 class RawContextScope;
 class RawDouble;
 class RawExceptionHandlers;
+class RawExternalTypedData;
 class RawField;
 class RawFloat32x4;
 class RawFloat64x2;
@@ -371,7 +374,19 @@ class SnapshotReader : public BaseReader {
   void EnqueueRehashingOfMap(const LinkedHashMap& map);
   RawObject* RunDelayedRehashingOfMaps();
 
+  // Entries of the message class cache in the object store, a direct mapped
+  // table from library url and class name to the class.
+  enum {
+    kClassCacheUrlOffset = 0,
+    kClassCacheNameOffset,
+    kClassCacheClassOffset,
+    kClassCacheEntryLength,
+  };
+  static const intptr_t kClassCacheSize = 64;
+
   RawClass* ReadClassId(intptr_t object_id);
+  static intptr_t ClassCacheIndex(const String& library_url,
+                                  const String& class_name);
   RawObject* ReadStaticImplicitClosure(intptr_t object_id, intptr_t cls_header);
 
   // Implementation to read an object.
@@ -781,7 +796,13 @@ class SerializedObjectBuffer : public StackResource {
 class MessageWriter : public SnapshotWriter {
  public:
   static const intptr_t kInitialSize = 512;
-  explicit MessageWriter(bool can_send_any_object);
+  // If transfer_external_typed_data is true, the external data of external
+  // typed data in the message is moved to the receiver instead of copied.
+  // Once the message has been posted, CompleteTransfers leaves the sender's
+  // objects with zero-filled data of their own. If it could not be posted,
+  // CancelTransfers leaves them as they were.
+  explicit MessageWriter(bool can_send_any_object,
+                         bool transfer_external_typed_data = false);
   ~MessageWriter();
 
   Message* WriteMessage(const Object& obj,
@@ -789,10 +810,42 @@ class MessageWriter : public SnapshotWriter {
                         Message::Priority priority);
 
   MessageFinalizableData* finalizable_data() const { return finalizable_data_; }
+  bool transfer_external_typed_data() const {
+    return transfer_external_typed_data_;
+  }
+
+  // Returns the only finalizer of [raw], or NULL if it has none or several.
+  // The isolate's finalizers are indexed on first use.
+  FinalizablePersistentHandle* FindExternalTypedDataFinalizer(
+      RawExternalTypedData* raw);
+
+  // Puts the data of [raw], owned by [handle], in the message. The sender's
+  // object is switched over to [detached_data], to be freed by
+  // [detached_callback], by CompleteTransfers.
+  void AddTransfer(RawExternalTypedData* raw,
+                   FinalizablePersistentHandle* handle,
+                   intptr_t external_size,
+                   void* detached_data,
+                   Dart_WeakPersistentHandleFinalizer detached_callback);
+  void CompleteTransfers();
+  void CancelTransfers(MessageFinalizableData* finalizable_data);
 
  private:
+  struct Transfer {
+    RawExternalTypedData* raw;
+    FinalizablePersistentHandle* handle;
+    void* detached_data;
+    Dart_WeakPersistentHandleFinalizer detached_callback;
+    intptr_t index;
+  };
+  typedef RawPointerKeyValueTrait<RawObject, FinalizablePersistentHandle*>
+      FinalizerTrait;
+
   ForwardList forward_list_;
   MessageFinalizableData* finalizable_data_;
+  bool transfer_external_typed_data_;
+  MallocDirectChainedHashMap<FinalizerTrait>* finalizers_;
+  MallocGrowableArray<Transfer> transfers_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageWriter);
 };
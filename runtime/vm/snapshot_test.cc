@@ -2083,6 +2083,95 @@ VM_UNIT_TEST_CASE(PostCObject) {
   Dart_ExitScope();
 }
 
+VM_UNIT_TEST_CASE(PostCObjectArray) {
+  TestIsolateScope __test_isolate__;
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "main() {\n"
+      "  var messageCount = 0;\n"
+      "  var exception = '';\n"
+      "  var port = new RawReceivePort();\n"
+      "  var sendPort = port.sendPort;\n"
+      "  port.handler = (message) {\n"
+      "    exception = '$exception${message}';\n"
+      "    messageCount++;\n"
+      "    if (messageCount == 2) throw new Exception(exception);\n"
+      "  };\n"
+      "  return sendPort;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_EnterScope();
+
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id;
+  Dart_Handle result = Dart_SendPortGetId(send_port, &port_id);
+  ASSERT(!Dart_IsError(result));
+
+  // The same element buffer is used for every message.
+  Dart_CObject elements[3];
+  for (intptr_t i = 0; i < 2; i++) {
+    elements[0].type = Dart_CObject_kInt64;
+    elements[0].value.as_int64 = kMaxInt64 - i;
+    elements[1].type = Dart_CObject_kString;
+    elements[1].value.as_string = const_cast<char*>("abc");
+    elements[2].type = Dart_CObject_kNull;
+    EXPECT(Dart_PostCObjectArray(port_id, 3, elements));
+    EXPECT_EQ(Dart_CObject_kInt64, elements[0].type);
+    EXPECT_EQ(Dart_CObject_kString, elements[1].type);
+  }
+
+  // Nested arrays have to be posted as a Dart_CObject tree.
+  elements[0].type = Dart_CObject_kArray;
+  elements[0].value.as_array.length = 0;
+  EXPECT(!Dart_PostCObjectArray(port_id, 1, elements));
+
+  result = Dart_RunLoop();
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_ErrorHasException(result));
+  EXPECT_SUBSTRING(
+      "Exception: [9223372036854775807, abc, null]"
+      "[9223372036854775806, abc, null]\n",
+      Dart_GetError(result));
+
+  Dart_ExitScope();
+}
+
+TEST_CASE(MessageClassCache) {
+  const char* kScriptChars =
+      "class Point {\n"
+      "  var x, y;\n"
+      "  Point(this.x, this.y);\n"
+      "}\n"
+      "getPoint() => new Point(1, 2);\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle point = Dart_Invoke(lib, NewString("getPoint"), 0, NULL);
+  EXPECT_VALID(point);
+
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  const Instance& instance = Api::UnwrapInstanceHandle(zone.GetZone(), point);
+  const Class& cls = Class::Handle(instance.clazz());
+  ObjectStore* object_store = thread->isolate()->object_store();
+  EXPECT(Array::Handle(object_store->message_class_cache()).IsNull());
+
+  // The first message looks up the class and caches it, the second one is
+  // served from the cache. Both must resolve to the same class.
+  Object& result = Object::Handle();
+  for (intptr_t i = 0; i < 2; i++) {
+    MessageWriter writer(true);
+    Message* message =
+        writer.WriteMessage(instance, ILLEGAL_PORT, Message::kNormalPriority);
+    MessageSnapshotReader reader(message, thread);
+    result = reader.ReadObject();
+    EXPECT(result.IsInstance());
+    EXPECT_EQ(cls.raw(), result.clazz());
+    delete message;
+  }
+  EXPECT(!Array::Handle(object_store->message_class_cache()).IsNull());
+}
+
 TEST_CASE(OmittedObjectEncodingLength) {
   StackZone zone(Thread::Current());
   MessageWriter writer(true);
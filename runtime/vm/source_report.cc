@@ -17,6 +17,7 @@ const char* SourceReport::kCallSitesStr = "_CallSites";
 const char* SourceReport::kCoverageStr = "Coverage";
 const char* SourceReport::kPossibleBreakpointsStr = "PossibleBreakpoints";
 const char* SourceReport::kProfileStr = "_Profile";
+const char* SourceReport::kExecutedStr = "_Executed";
 
 SourceReport::SourceReport(intptr_t report_set, CompileMode compile_mode)
     : report_set_(report_set),
@@ -366,6 +367,43 @@ void SourceReport::PrintProfileData(JSONObject* jsobj,
   }
 }
 
+void SourceReport::RecordExecuted(const Function& func) {
+  const Script& script = Script::Handle(zone(), func.script());
+  ScriptTableEntry* entry = script_table_entries_[GetScriptIndex(script)];
+  if (entry->function_positions == NULL) {
+    entry->function_positions =
+        new (zone()) ZoneGrowableArray<TokenPosition>(zone(), 16);
+    entry->executed_bitmap = new (zone()) ZoneGrowableArray<uint8_t>(zone(), 2);
+  }
+  const intptr_t bit = entry->function_positions->length();
+  entry->function_positions->Add(func.token_pos());
+  if ((bit % kBitsPerByte) == 0) {
+    entry->executed_bitmap->Add(0);
+  }
+  if (func.WasExecuted()) {
+    (*entry->executed_bitmap)[bit / kBitsPerByte] |= 1 << (bit % kBitsPerByte);
+  }
+}
+
+void SourceReport::PrintExecutedTable(JSONArray* jsarr) {
+  for (intptr_t i = 0; i < script_table_entries_.length(); i++) {
+    ScriptTableEntry* entry = script_table_entries_[i];
+    if (entry->function_positions == NULL) {
+      continue;
+    }
+    JSONObject executed(jsarr);
+    executed.AddProperty("scriptIndex", entry->index);
+    {
+      JSONArray positions(&executed, "functionPositions");
+      for (intptr_t j = 0; j < entry->function_positions->length(); j++) {
+        positions.AddValue(entry->function_positions->At(j));
+      }
+    }
+    executed.AddPropertyBase64("bitmap", entry->executed_bitmap->data(),
+                               entry->executed_bitmap->length());
+  }
+}
+
 void SourceReport::PrintScriptTable(JSONArray* scripts) {
   for (intptr_t i = 0; i < script_table_entries_.length(); i++) {
     const Script* script = script_table_entries_[i]->script;
@@ -378,6 +416,15 @@ void SourceReport::VisitFunction(JSONArray* jsarr, const Function& func) {
     return;
   }
 
+  if (IsReportRequested(kExecuted)) {
+    RecordExecuted(func);
+    if (report_set_ == kExecuted) {
+      // Whether a function ran is known without looking at its code, so
+      // nothing gets compiled for this report.
+      return;
+    }
+  }
+
   const Script& script = Script::Handle(zone(), func.script());
   const TokenPosition begin_pos = func.token_pos();
   const TokenPosition end_pos = func.end_token_pos();
@@ -543,6 +590,11 @@ void SourceReport::PrintJSON(JSONStream* js,
     VisitClosures(&ranges);
   }
 
+  if (IsReportRequested(kExecuted)) {
+    JSONArray executed(&report, "_executed");
+    PrintExecutedTable(&executed);
+  }
+
   // Print the script table.
   JSONArray scripts(&report, "scripts");
   PrintScriptTable(&scripts);
@@ -24,12 +24,14 @@ class SourceReport {
     kCoverage = 0x2,
     kPossibleBreakpoints = 0x4,
     kProfile = 0x8,
+    kExecuted = 0x10,
   };
 
   static const char* kCallSitesStr;
   static const char* kCoverageStr;
   static const char* kPossibleBreakpointsStr;
   static const char* kProfileStr;
+  static const char* kExecutedStr;
 
   enum CompileMode { kNoCompile, kForceCompile };
 
@@ -73,6 +75,8 @@ class SourceReport {
                                     const Function& func,
                                     const Code& code);
   void PrintProfileData(JSONObject* jsobj, ProfileFunction* profile_function);
+  void RecordExecuted(const Function& func);
+  void PrintExecutedTable(JSONArray* jsarr);
 #if defined(DEBUG)
   void VerifyScriptTable();
 #endif
@@ -84,11 +88,21 @@ class SourceReport {
 
   // An entry in the script table.
   struct ScriptTableEntry {
-    ScriptTableEntry() : key(NULL), index(-1), script(NULL) {}
+    ScriptTableEntry()
+        : key(NULL),
+          index(-1),
+          script(NULL),
+          function_positions(NULL),
+          executed_bitmap(NULL) {}
 
     const String* key;
     intptr_t index;
     const Script* script;
+
+    // For the executed report: the start positions of the script's
+    // functions, and a bitmap with a bit set for each function that ran.
+    ZoneGrowableArray<TokenPosition>* function_positions;
+    ZoneGrowableArray<uint8_t>* executed_bitmap;
   };
 
   // Needed for DirectChainedHashMap.
@@ -95,6 +95,43 @@ ISOLATE_UNIT_TEST_CASE(SourceReport_Coverage_SimpleCall) {
       buffer);
 }
 
+ISOLATE_UNIT_TEST_CASE(SourceReport_Executed_SimpleCall) {
+  char buffer[1024];
+  const char* kScript =
+      "helper0() {}\n"
+      "helper1() {}\n"
+      "main() {\n"
+      "  if (true) {\n"
+      "    helper0();\n"
+      "  } else {\n"
+      "    helper1();\n"
+      "  }\n"
+      "}";
+
+  Library& lib = Library::Handle();
+  lib ^= ExecuteScript(kScript);
+  ASSERT(!lib.IsNull());
+  const Script& script =
+      Script::Handle(lib.LookupScript(String::Handle(String::New("test-lib"))));
+
+  SourceReport report(SourceReport::kExecuted);
+  JSONStream js;
+  report.PrintJSON(&js, script);
+  ElideJSONSubstring("classes", js.ToCString(), buffer);
+  ElideJSONSubstring("libraries", buffer, buffer);
+  EXPECT_STREQ(
+      "{\"type\":\"SourceReport\",\"ranges\":[],"
+
+      // helper0 and main ran, helper1 did not: bits 0 and 2 are set.
+      "\"_executed\":[{\"scriptIndex\":0,\"functionPositions\":[0,6,12],"
+      "\"bitmap\":\"BQ==\"}],"
+
+      // Only one script in the script table.
+      "\"scripts\":[{\"type\":\"@Script\",\"fixedId\":true,\"id\":\"\","
+      "\"uri\":\"test-lib\",\"_kind\":\"script\"}]}",
+      buffer);
+}
+
 ISOLATE_UNIT_TEST_CASE(SourceReport_Coverage_ForceCompile) {
   char buffer[1024];
   const char* kScript =
@@ -327,7 +327,41 @@ RawCode* StackFrame::UncheckedGetCodeObject() const {
               kWordSize)));
 }
 
+// Returns true if the handler with the given try index is known to catch
+// the exception, i.e. the exception is an instance of one of its instantiated
+// handled types. Uninstantiated and malformed types are left for the catch
+// block to test.
+static bool HandlerCatchesException(const Code& code,
+                                    intptr_t try_index,
+                                    const Instance& exception) {
+  Zone* zone = Thread::Current()->zone();
+  const ExceptionHandlers& handlers =
+      ExceptionHandlers::Handle(zone, code.exception_handlers());
+  const Array& handled_types =
+      Array::Handle(zone, handlers.GetHandledTypes(try_index));
+  if (handled_types.IsNull()) {
+    return false;
+  }
+  AbstractType& type = AbstractType::Handle(zone);
+  Error& bound_error = Error::Handle(zone);
+  for (intptr_t i = 0; i < handled_types.Length(); i++) {
+    type ^= handled_types.At(i);
+    if (type.IsNull() || !type.IsInstantiated() ||
+        type.IsMalformedOrMalbounded()) {
+      continue;
+    }
+    if (exception.IsInstanceOf(type, Object::null_type_arguments(),
+                               Object::null_type_arguments(), &bound_error) &&
+        bound_error.IsNull()) {
+      return true;
+    }
+    bound_error = Error::null();
+  }
+  return false;
+}
+
 bool StackFrame::FindExceptionHandler(Thread* thread,
+                                      const Instance& exception,
                                       uword* handler_pc,
                                       bool* needs_stacktrace,
                                       bool* has_catch_all,
@@ -340,11 +374,14 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
   }
   *is_optimized = code.is_optimized();
   HandlerInfoCache* cache = thread->isolate()->handler_info_cache();
-  ExceptionHandlerInfo* info = cache->Lookup(pc());
-  if (info != NULL) {
-    *handler_pc = code.PayloadStart() + info->handler_pc_offset;
-    *needs_stacktrace = info->needs_stacktrace;
-    *has_catch_all = info->has_catch_all;
+  CachedHandlerInfo* cached = cache->Lookup(pc());
+  if (cached != NULL) {
+    *handler_pc = code.PayloadStart() + cached->info.handler_pc_offset;
+    *needs_stacktrace = cached->info.needs_stacktrace;
+    *has_catch_all =
+        cached->info.has_catch_all ||
+        (!exception.IsNull() &&
+         HandlerCatchesException(code, cached->try_index, exception));
     return true;
   }
   uword pc_offset = pc() - code.PayloadStart();
@@ -396,8 +433,13 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
   handlers.GetHandlerInfo(try_index, &handler_info);
   *handler_pc = code.PayloadStart() + handler_info.handler_pc_offset;
   *needs_stacktrace = handler_info.needs_stacktrace;
-  *has_catch_all = handler_info.has_catch_all;
-  cache->Insert(pc(), handler_info);
+  *has_catch_all = handler_info.has_catch_all ||
+                   (!exception.IsNull() &&
+                    HandlerCatchesException(code, try_index, exception));
+  CachedHandlerInfo cached_info;
+  cached_info.try_index = try_index;
+  cached_info.info = handler_info;
+  cache->Insert(pc(), cached_info);
   return true;
 }
 
@@ -406,17 +448,7 @@ TokenPosition StackFrame::GetTokenPos() const {
   if (code.IsNull()) {
     return TokenPosition::kNoSource;  // Stub frames do not have token_pos.
   }
-  uword pc_offset = pc() - code.PayloadStart();
-  const PcDescriptors& descriptors =
-      PcDescriptors::Handle(code.pc_descriptors());
-  ASSERT(!descriptors.IsNull());
-  PcDescriptors::Iterator iter(descriptors, RawPcDescriptors::kAnyKind);
-  while (iter.MoveNext()) {
-    if (iter.PcOffset() == pc_offset) {
-      return TokenPosition(iter.TokenPos());
-    }
-  }
-  return TokenPosition::kNoSource;
+  return code.GetTokenIndexOfPC(pc());
 }
 
 bool StackFrame::IsValid() const {
@@ -165,7 +165,11 @@ class StackFrame : public ValueObject {
 
   RawFunction* LookupDartFunction() const;
   RawCode* LookupDartCode() const;
+  // Sets 'is_catch_all' if the handler catches all exceptions, or if
+  // 'exception' is not null and is an instance of one of the instantiated
+  // types the handler catches.
   bool FindExceptionHandler(Thread* thread,
+                            const Instance& exception,
                             uword* handler_pc,
                             bool* needs_stacktrace,
                             bool* is_catch_all,
@@ -117,7 +117,9 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
                                   bool save_fpu_registers,
                                   const RuntimeEntry* target,
                                   intptr_t self_code_stub_offset_from_thread,
-                                  bool allow_return) {
+                                  bool allow_return,
+                                  Register arg0,
+                                  Register arg1) {
   __ Push(LR);
 
   // We want the saved registers to appear like part of the caller's frame, so
@@ -144,9 +146,21 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
 
   __ EnterStubFrame();
 
+  // Arguments of the runtime call are passed in registers, which still hold
+  // their values after being saved above.
+  intptr_t argument_count = 0;
+  if (arg0 != kNoRegister) {
+    __ Push(arg0);
+    argument_count++;
+  }
+  if (arg1 != kNoRegister) {
+    __ Push(arg1);
+    argument_count++;
+  }
+
   __ ldr(CODE_REG, Address(THR, Thread::call_to_runtime_stub_offset()));
   __ ldr(R9, Address(THR, Thread::OffsetFromThread(target)));
-  __ mov(R4, Operand(/*argument_count=*/0));
+  __ mov(R4, Operand(argument_count));
   __ ldr(TMP, Address(THR, Thread::call_to_runtime_entry_point_offset()));
   __ blx(TMP);
 
@@ -261,6 +275,23 @@ void StubCode::GenerateNullErrorSharedWithFPURegsStub(Assembler* assembler) {
                      /*allow_return=*/false);
 }
 
+void StubCode::GenerateRangeErrorSharedWithoutFPURegsStub(
+    Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/false,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_without_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
+void StubCode::GenerateRangeErrorSharedWithFPURegsStub(Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/true,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_with_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
 void StubCode::GenerateStackOverflowSharedWithoutFPURegsStub(
     Assembler* assembler) {
   GenerateSharedStub(
@@ -1339,6 +1370,12 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
 #endif
 }
 
+// Card marking is only implemented on x64 and arm64. Elsewhere StoreIndexed
+// uses the WriteBarrier stub and this stub is never called.
+void StubCode::GenerateArrayWriteBarrierStub(Assembler* assembler) {
+  __ Stop("ArrayWriteBarrier");
+}
+
 // Called for inline allocation of objects.
 // Input parameters:
 //   LR : return address.
@@ -1378,6 +1415,13 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // next object start and initialize the allocated object.
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
 
+    // Load the address of the allocation stats table. Pretenured classes are
+    // allocated in old space by the runtime.
+    NOT_IN_PRODUCT(static Register kAllocationStatsReg = R4);
+    NOT_IN_PRODUCT(
+        __ LoadAllocationStatsAddress(kAllocationStatsReg, cls.id()));
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kAllocationStatsReg, &slow_case));
+
     RELEASE_ASSERT((Thread::top_offset() + kWordSize) == Thread::end_offset());
     __ ldrd(kInstanceReg, kEndReg, THR, Thread::top_offset());
     __ AddImmediate(kEndOfInstanceReg, kInstanceReg, instance_size);
@@ -1389,12 +1433,6 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     }
     __ str(kEndOfInstanceReg, Address(THR, Thread::top_offset()));
 
-    // Load the address of the allocation stats table. We split up the load
-    // and the increment so that the dependent load is not too nearby.
-    NOT_IN_PRODUCT(static Register kAllocationStatsReg = R4);
-    NOT_IN_PRODUCT(
-        __ LoadAllocationStatsAddress(kAllocationStatsReg, cls.id()));
-
     // Set the tags.
     uint32_t tags = 0;
     tags = RawObject::SizeTag::update(instance_size, tags);
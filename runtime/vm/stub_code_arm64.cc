@@ -10,6 +10,7 @@
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart_entry.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/pages.h"
 #include "vm/instructions.h"
 #include "vm/object_store.h"
 #include "vm/runtime_entry.h"
@@ -140,7 +141,9 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
                                   bool save_fpu_registers,
                                   const RuntimeEntry* target,
                                   intptr_t self_code_stub_offset_from_thread,
-                                  bool allow_return) {
+                                  bool allow_return,
+                                  Register arg0,
+                                  Register arg1) {
   __ Push(LR);
 
   // We want the saved registers to appear like part of the caller's frame, so
@@ -167,9 +170,21 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
 
   __ EnterStubFrame();
 
+  // Arguments of the runtime call are passed in registers, which still hold
+  // their values after being saved above.
+  intptr_t argument_count = 0;
+  if (arg0 != kNoRegister) {
+    __ Push(arg0);
+    argument_count++;
+  }
+  if (arg1 != kNoRegister) {
+    __ Push(arg1);
+    argument_count++;
+  }
+
   __ ldr(CODE_REG, Address(THR, Thread::call_to_runtime_stub_offset()));
   __ ldr(R5, Address(THR, Thread::OffsetFromThread(target)));
-  __ LoadImmediate(R4, /*argument_count=*/0);
+  __ LoadImmediate(R4, argument_count);
   __ ldr(TMP, Address(THR, Thread::call_to_runtime_entry_point_offset()));
   __ blr(TMP);
 
@@ -286,6 +301,23 @@ void StubCode::GenerateNullErrorSharedWithFPURegsStub(Assembler* assembler) {
                      /*allow_return=*/false);
 }
 
+void StubCode::GenerateRangeErrorSharedWithoutFPURegsStub(
+    Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/false,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_without_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
+void StubCode::GenerateRangeErrorSharedWithFPURegsStub(Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/true,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_with_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
 void StubCode::GenerateStackOverflowSharedWithoutFPURegsStub(
     Assembler* assembler) {
   GenerateSharedStub(
@@ -1411,15 +1443,20 @@ void StubCode::GenerateWriteBarrierWrappersStub(Assembler* assembler) {
   }
 }
 
-// Helper stub to implement Assembler::StoreIntoObject.
+// Helper stub to implement Assembler::StoreIntoObject/Array.
 // Input parameters:
 //   R1: Object (old)
 //   R0: Value (old or new)
+//   R25: Slot
 // If R0 is new, add R1 to the store buffer. Otherwise R0 is old, mark R0
 // and add it to the mark list.
 COMPILE_ASSERT(kWriteBarrierObjectReg == R1);
 COMPILE_ASSERT(kWriteBarrierValueReg == R0);
-void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
+COMPILE_ASSERT(kWriteBarrierSlotReg == R25);
+static void GenerateWriteBarrierStubHelper(Assembler* assembler,
+                                           Address stub_code,
+                                           bool cards) {
+  Label remember_card;
 #if defined(CONCURRENT_MARKING)
   Label add_to_mark_stack;
   __ tbz(&add_to_mark_stack, R0, kNewObjectBitPosition);
@@ -1434,6 +1471,11 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ Bind(&add_to_buffer);
 #endif
 
+  if (cards) {
+    __ LoadFieldFromOffset(TMP, R1, Object::tags_offset(), kWord);
+    __ tbnz(&remember_card, TMP, RawObject::kCardRememberedBit);
+  }
+
   // Save values being destroyed.
   __ Push(R2);
   __ Push(R3);
@@ -1478,7 +1520,7 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   // Setup frame, push callee-saved registers.
 
   __ Push(CODE_REG);
-  __ ldr(CODE_REG, Address(THR, Thread::write_barrier_code_offset()));
+  __ ldr(CODE_REG, stub_code);
   __ EnterCallRuntimeFrame(0 * kWordSize);
   __ mov(R0, THR);
   __ CallRuntime(kStoreBufferBlockProcessRuntimeEntry, 1);
@@ -1522,7 +1564,7 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
 
   __ Bind(&marking_overflow);
   __ Push(CODE_REG);
-  __ ldr(CODE_REG, Address(THR, Thread::write_barrier_code_offset()));
+  __ ldr(CODE_REG, stub_code);
   __ EnterCallRuntimeFrame(0 * kWordSize);
   __ mov(R0, THR);
   __ CallRuntime(kMarkingStackBlockProcessRuntimeEntry, 1);
@@ -1536,6 +1578,49 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ Pop(R2);  // Unspill.
   __ ret();
 #endif
+
+  if (cards) {
+    Label remember_card_slow;
+
+    // Get card table.
+    __ Bind(&remember_card);
+    __ AndImmediate(TMP, R1, kPageMask);                       // HeapPage.
+    __ ldr(TMP, Address(TMP, HeapPage::card_table_offset()));  // Card table.
+    __ cbz(&remember_card_slow, TMP);
+
+    // Dirty the card.
+    __ AndImmediate(TMP2, R1, kPageMask);  // HeapPage.
+    __ sub(R25, R25, Operand(TMP2));       // Offset in page.
+    __ LsrImmediate(R25, R25, HeapPage::kBytesPerCardLog2);  // Card index.
+    __ LoadImmediate(TMP2, 1);
+    __ str(TMP2, Address(TMP, R25, UXTX, Address::Unscaled), kUnsignedByte);
+    __ ret();
+
+    // Card table not yet allocated.
+    __ Bind(&remember_card_slow);
+    __ Push(CODE_REG);
+    __ PushPair(R0, R1);
+    __ ldr(CODE_REG, stub_code);
+    __ mov(R0, R1);   // Arg0 = Object
+    __ mov(R1, R25);  // Arg1 = Slot
+    __ EnterCallRuntimeFrame(0);
+    __ CallRuntime(kRememberCardRuntimeEntry, 2);
+    __ LeaveCallRuntimeFrame();
+    __ PopPair(R0, R1);
+    __ Pop(CODE_REG);
+    __ ret();
+  }
+}
+
+void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
+  GenerateWriteBarrierStubHelper(
+      assembler, Address(THR, Thread::write_barrier_code_offset()), false);
+}
+
+void StubCode::GenerateArrayWriteBarrierStub(Assembler* assembler) {
+  GenerateWriteBarrierStubHelper(
+      assembler, Address(THR, Thread::array_write_barrier_code_offset()),
+      true);
 }
 
 // Called for inline allocation of objects.
@@ -108,6 +108,15 @@ void StubCode::GenerateNullErrorSharedWithFPURegsStub(Assembler* assembler) {
   __ Breakpoint();
 }
 
+void StubCode::GenerateRangeErrorSharedWithoutFPURegsStub(
+    Assembler* assembler) {
+  __ Breakpoint();
+}
+
+void StubCode::GenerateRangeErrorSharedWithFPURegsStub(Assembler* assembler) {
+  __ Breakpoint();
+}
+
 void StubCode::GenerateStackOverflowSharedWithoutFPURegsStub(
     Assembler* assembler) {
   // TODO(sjindel): implement.
@@ -1045,6 +1054,12 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ ret();
 }
 
+// Card marking is only implemented on x64 and arm64. Elsewhere StoreIndexed
+// uses the WriteBarrier stub and this stub is never called.
+void StubCode::GenerateArrayWriteBarrierStub(Assembler* assembler) {
+  __ Stop("ArrayWriteBarrier");
+}
+
 // Called for inline allocation of objects.
 // Input parameters:
 //   ESP + 4 : type arguments object (only if class is parameterized).
@@ -1078,6 +1093,9 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // EDX: instantiated type arguments (if is_cls_parameterized).
+    // Pretenured classes are allocated in old space by the runtime.
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cls.id(), ECX, &slow_case,
+                                           Assembler::kFarJump));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ movl(EAX, Address(THR, Thread::top_offset()));
     __ leal(EBX, Address(EAX, instance_size));
@@ -15,6 +15,7 @@
 #include "vm/constants_x64.h"
 #include "vm/dart_entry.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/pages.h"
 #include "vm/heap/scavenger.h"
 #include "vm/instructions.h"
 #include "vm/object_store.h"
@@ -114,7 +115,9 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
                                   bool save_fpu_registers,
                                   const RuntimeEntry* target,
                                   intptr_t self_code_stub_offset_from_thread,
-                                  bool allow_return) {
+                                  bool allow_return,
+                                  Register arg0,
+                                  Register arg1) {
   // We want the saved registers to appear like part of the caller's frame, so
   // we push them before calling EnterStubFrame.
   __ PushRegisters(kDartAvailableCpuRegs,
@@ -137,9 +140,21 @@ void StubCode::GenerateSharedStub(Assembler* assembler,
 
   __ EnterStubFrame();
 
+  // Arguments of the runtime call are passed in registers, which still hold
+  // their values after being saved above.
+  intptr_t argument_count = 0;
+  if (arg0 != kNoRegister) {
+    __ pushq(arg0);
+    argument_count++;
+  }
+  if (arg1 != kNoRegister) {
+    __ pushq(arg1);
+    argument_count++;
+  }
+
   __ movq(CODE_REG, Address(THR, Thread::call_to_runtime_stub_offset()));
   __ movq(RBX, Address(THR, Thread::OffsetFromThread(target)));
-  __ movq(R10, Immediate(/*argument_count=*/0));
+  __ movq(R10, Immediate(argument_count));
   __ call(Address(THR, Thread::call_to_runtime_entry_point_offset()));
 
   if (!allow_return) {
@@ -256,6 +271,23 @@ void StubCode::GenerateNullErrorSharedWithFPURegsStub(Assembler* assembler) {
                      /*allow_return=*/false);
 }
 
+void StubCode::GenerateRangeErrorSharedWithoutFPURegsStub(
+    Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/false,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_without_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
+void StubCode::GenerateRangeErrorSharedWithFPURegsStub(Assembler* assembler) {
+  GenerateSharedStub(assembler, /*save_fpu_registers=*/true,
+                     &kRangeErrorRuntimeEntry,
+                     Thread::range_error_shared_with_fpu_regs_stub_offset(),
+                     /*allow_return=*/false, kRangeErrorLengthReg,
+                     kRangeErrorIndexReg);
+}
+
 void StubCode::GenerateStackOverflowSharedWithoutFPURegsStub(
     Assembler* assembler) {
   GenerateSharedStub(
@@ -1344,15 +1376,20 @@ void StubCode::GenerateWriteBarrierWrappersStub(Assembler* assembler) {
   }
 }
 
-// Helper stub to implement Assembler::StoreIntoObject.
+// Helper stub to implement Assembler::StoreIntoObject/Array.
 // Input parameters:
 //   RDX: Object (old)
 //   RAX: Value (old or new)
+//   R13: Slot
 // If RAX is new, add RDX to the store buffer. Otherwise RAX is old, mark RAX
 // and add it to the mark list.
 COMPILE_ASSERT(kWriteBarrierObjectReg == RDX);
 COMPILE_ASSERT(kWriteBarrierValueReg == RAX);
-void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
+COMPILE_ASSERT(kWriteBarrierSlotReg == R13);
+static void GenerateWriteBarrierStubHelper(Assembler* assembler,
+                                           Address stub_code,
+                                           bool cards) {
+  Label remember_card;
 #if defined(CONCURRENT_MARKING)
   Label add_to_mark_stack;
   __ testq(RAX, Immediate(1 << kNewObjectBitPosition));
@@ -1370,6 +1407,12 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ Bind(&add_to_buffer);
 #endif
 
+  if (cards) {
+    __ movl(TMP, FieldAddress(RDX, Object::tags_offset()));
+    __ testl(TMP, Immediate(1 << RawObject::kCardRememberedBit));
+    __ j(NOT_ZERO, &remember_card, Assembler::kFarJump);
+  }
+
   // Update the tags that this object has been remembered.
   // Note that we use 32 bit operations here to match the size of the
   // background sweeper which is also manipulating this 32 bit word.
@@ -1408,7 +1451,7 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ Bind(&overflow);
   // Setup frame, push callee-saved registers.
   __ pushq(CODE_REG);
-  __ movq(CODE_REG, Address(THR, Thread::write_barrier_code_offset()));
+  __ movq(CODE_REG, stub_code);
   __ EnterCallRuntimeFrame(0);
   __ movq(CallingConventions::kArg1Reg, THR);
   __ CallRuntime(kStoreBufferBlockProcessRuntimeEntry, 1);
@@ -1449,7 +1492,7 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
 
   __ Bind(&marking_overflow);
   __ pushq(CODE_REG);
-  __ movq(CODE_REG, Address(THR, Thread::write_barrier_code_offset()));
+  __ movq(CODE_REG, stub_code);
   __ EnterCallRuntimeFrame(0);
   __ movq(CallingConventions::kArg1Reg, THR);
   __ CallRuntime(kMarkingStackBlockProcessRuntimeEntry, 1);
@@ -1462,6 +1505,48 @@ void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
   __ popq(RAX);  // Unspill.
   __ ret();
 #endif
+
+  if (cards) {
+    Label remember_card_slow;
+
+    // Get card table.
+    __ Bind(&remember_card);
+    __ movq(TMP, RDX);                   // Object.
+    __ andq(TMP, Immediate(kPageMask));  // HeapPage.
+    __ cmpq(Address(TMP, HeapPage::card_table_offset()), Immediate(0));
+    __ j(EQUAL, &remember_card_slow, Assembler::kNearJump);
+
+    // Dirty the card.
+    __ subq(R13, TMP);  // Offset in page.
+    __ movq(TMP, Address(TMP, HeapPage::card_table_offset()));  // Card table.
+    __ shrq(R13,
+            Immediate(HeapPage::kBytesPerCardLog2));  // Index in card table.
+    __ movb(Address(TMP, R13, TIMES_1, 0), Immediate(1));
+    __ ret();
+
+    // Card table not yet allocated.
+    __ Bind(&remember_card_slow);
+    __ pushq(CODE_REG);
+    __ movq(CODE_REG, stub_code);
+    __ EnterCallRuntimeFrame(0);
+    __ movq(CallingConventions::kArg1Reg, RDX);
+    __ movq(CallingConventions::kArg2Reg, R13);
+    __ CallRuntime(kRememberCardRuntimeEntry, 2);
+    __ LeaveCallRuntimeFrame();
+    __ popq(CODE_REG);
+    __ ret();
+  }
+}
+
+void StubCode::GenerateWriteBarrierStub(Assembler* assembler) {
+  GenerateWriteBarrierStubHelper(
+      assembler, Address(THR, Thread::write_barrier_code_offset()), false);
+}
+
+void StubCode::GenerateArrayWriteBarrierStub(Assembler* assembler) {
+  GenerateWriteBarrierStubHelper(
+      assembler, Address(THR, Thread::array_write_barrier_code_offset()),
+      true);
 }
 
 // Called for inline allocation of objects.
@@ -1493,6 +1578,9 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // RDX: instantiated type arguments (if is_cls_parameterized).
+    // Pretenured classes are allocated in old space by the runtime.
+    NOT_IN_PRODUCT(
+        __ MaybeTraceAllocation(cls.id(), &slow_case, Assembler::kFarJump));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ movq(RAX, Address(THR, Thread::top_offset()));
     __ leaq(RBX, Address(RAX, instance_size));
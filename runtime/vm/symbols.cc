@@ -426,21 +426,34 @@ RawString* Symbols::FromUTF8(Thread* thread,
   return FromUTF16(thread, characters, len);
 }
 
+// One character symbols are all predefined in the vm isolate. Kernel names of
+// type parameters and operators hit them often, so answer those without
+// hashing or probing either symbol table.
 RawString* Symbols::FromLatin1(Thread* thread,
                                const uint8_t* latin1_array,
                                intptr_t len) {
+  if (len == 1) {
+    return predefined_[latin1_array[0]];
+  }
   return NewSymbol(thread, Latin1Array(latin1_array, len));
 }
 
 RawString* Symbols::FromUTF16(Thread* thread,
                               const uint16_t* utf16_array,
                               intptr_t len) {
+  if ((len == 1) && (utf16_array[0] <= kMaxOneCharCodeSymbol)) {
+    return predefined_[utf16_array[0]];
+  }
   return NewSymbol(thread, UTF16Array(utf16_array, len));
 }
 
 RawString* Symbols::FromUTF32(Thread* thread,
                               const int32_t* utf32_array,
                               intptr_t len) {
+  if ((len == 1) && (utf32_array[0] >= 0) &&
+      (utf32_array[0] <= kMaxOneCharCodeSymbol)) {
+    return predefined_[utf32_array[0]];
+  }
   return NewSymbol(thread, UTF32Array(utf32_array, len));
 }
 
@@ -637,6 +650,12 @@ RawString* Symbols::New(Thread* thread,
                         const String& str,
                         intptr_t begin_index,
                         intptr_t len) {
+  if (len == 1) {
+    const uint16_t ch = str.CharAt(begin_index);
+    if (ch <= kMaxOneCharCodeSymbol) {
+      return predefined_[ch];
+    }
+  }
   return NewSymbol(thread, StringSlice(str, begin_index, len));
 }
 
@@ -96,6 +96,8 @@ Thread::Thread(Isolate* isolate)
       deferred_interrupts_(0),
       stack_overflow_count_(0),
       bump_allocate_(false),
+      old_space_top_(0),
+      old_space_end_(0),
       hierarchy_info_(NULL),
       type_usage_info_(NULL),
       pending_functions_(GrowableObjectArray::null()),
@@ -302,6 +304,10 @@ const char* Thread::TaskKindToCString(TaskKind kind) {
       return "kSweeperTask";
     case kMarkerTask:
       return "kMarkerTask";
+    case kCompactorTask:
+      return "kCompactorTask";
+    case kScavengerTask:
+      return "kScavengerTask";
     default:
       UNREACHABLE();
       return "";
@@ -355,6 +361,7 @@ void Thread::ExitIsolate() {
     thread->MarkingStackRelease();
   }
   thread->StoreBufferRelease();
+  isolate->heap()->old_space()->AbandonThreadBuffer(thread);
   if (isolate->is_runnable()) {
     thread->set_vm_tag(VMTag::kIdleTagId);
   } else {
@@ -403,6 +410,7 @@ void Thread::ExitIsolateAsHelper(bool bypass_safepoint) {
   thread->StoreBufferRelease();
   Isolate* isolate = thread->isolate();
   ASSERT(isolate != NULL);
+  isolate->heap()->old_space()->AbandonThreadBuffer(thread);
   const bool kIsNotMutatorThread = false;
   isolate->UnscheduleThread(thread, kIsNotMutatorThread, bypass_safepoint);
 }
@@ -85,6 +85,8 @@ class Zone;
 #define CACHED_VM_STUBS_LIST(V)                                                \
   V(RawCode*, write_barrier_code_, StubCode::WriteBarrier_entry()->code(),     \
     NULL)                                                                      \
+  V(RawCode*, array_write_barrier_code_,                                       \
+    StubCode::ArrayWriteBarrier_entry()->code(), NULL)                         \
   V(RawCode*, fix_callers_target_code_,                                        \
     StubCode::FixCallersTarget_entry()->code(), NULL)                          \
   V(RawCode*, fix_allocation_stub_code_,                                       \
@@ -99,6 +101,10 @@ class Zone;
     StubCode::NullErrorSharedWithoutFPURegs_entry()->code(), NULL)             \
   V(RawCode*, null_error_shared_with_fpu_regs_stub_,                           \
     StubCode::NullErrorSharedWithFPURegs_entry()->code(), NULL)                \
+  V(RawCode*, range_error_shared_without_fpu_regs_stub_,                       \
+    StubCode::RangeErrorSharedWithoutFPURegs_entry()->code(), NULL)            \
+  V(RawCode*, range_error_shared_with_fpu_regs_stub_,                          \
+    StubCode::RangeErrorSharedWithFPURegs_entry()->code(), NULL)               \
   V(RawCode*, stack_overflow_shared_without_fpu_regs_stub_,                    \
     StubCode::StackOverflowSharedWithoutFPURegs_entry()->code(), NULL)         \
   V(RawCode*, stack_overflow_shared_with_fpu_regs_stub_,                       \
@@ -142,12 +148,18 @@ class Zone;
 #define CACHED_VM_STUBS_ADDRESSES_LIST(V)                                      \
   V(uword, write_barrier_entry_point_,                                         \
     StubCode::WriteBarrier_entry()->EntryPoint(), 0)                           \
+  V(uword, array_write_barrier_entry_point_,                                   \
+    StubCode::ArrayWriteBarrier_entry()->EntryPoint(), 0)                      \
   V(uword, call_to_runtime_entry_point_,                                       \
     StubCode::CallToRuntime_entry()->EntryPoint(), 0)                          \
   V(uword, null_error_shared_without_fpu_regs_entry_point_,                    \
     StubCode::NullErrorSharedWithoutFPURegs_entry()->EntryPoint(), 0)          \
   V(uword, null_error_shared_with_fpu_regs_entry_point_,                       \
     StubCode::NullErrorSharedWithFPURegs_entry()->EntryPoint(), 0)             \
+  V(uword, range_error_shared_without_fpu_regs_entry_point_,                   \
+    StubCode::RangeErrorSharedWithoutFPURegs_entry()->EntryPoint(), 0)         \
+  V(uword, range_error_shared_with_fpu_regs_entry_point_,                      \
+    StubCode::RangeErrorSharedWithFPURegs_entry()->EntryPoint(), 0)            \
   V(uword, stack_overflow_shared_without_fpu_regs_entry_point_,                \
     StubCode::StackOverflowSharedWithoutFPURegs_entry()->EntryPoint(), 0)      \
   V(uword, stack_overflow_shared_with_fpu_regs_entry_point_,                   \
@@ -208,6 +220,7 @@ class Thread : public BaseThread {
     kMarkerTask = 0x4,
     kSweeperTask = 0x8,
     kCompactorTask = 0x10,
+    kScavengerTask = 0x20,
   };
   // Converts a TaskKind to its corresponding C-String name.
   static const char* TaskKindToCString(TaskKind kind);
@@ -344,6 +357,14 @@ class Thread : public BaseThread {
 
   void ResetHighWatermark() { zone_high_watermark_ = current_zone_capacity_; }
 
+  // Restores a high watermark saved before ResetHighWatermark, unless a
+  // higher one was reached since.
+  void RestoreHighWatermark(uintptr_t value) {
+    if (value > zone_high_watermark_) {
+      zone_high_watermark_ = value;
+    }
+  }
+
   // The reusable api local scope for this thread.
   ApiLocalScope* api_reusable_scope() const { return api_reusable_scope_; }
   void set_api_reusable_scope(ApiLocalScope* value) {
@@ -471,6 +492,13 @@ class Thread : public BaseThread {
   static intptr_t top_offset() { return OFFSET_OF(Thread, top_); }
   static intptr_t end_offset() { return OFFSET_OF(Thread, end_); }
 
+  // Bounds of this thread's old-space allocation buffer (see
+  // PageSpace::TryAllocateInThreadBuffer).
+  uword old_space_top() const { return old_space_top_; }
+  uword old_space_end() const { return old_space_end_; }
+  void set_old_space_top(uword value) { old_space_top_ = value; }
+  void set_old_space_end(uword value) { old_space_end_ = value; }
+
   bool bump_allocate() const { return bump_allocate_; }
   void set_bump_allocate(bool b) { bump_allocate_ = b; }
 
@@ -876,6 +904,8 @@ class Thread : public BaseThread {
   uint16_t deferred_interrupts_;
   int32_t stack_overflow_count_;
   bool bump_allocate_;
+  uword old_space_top_;
+  uword old_space_end_;
 
   // Compiler state:
   CompilerState* compiler_state_ = nullptr;
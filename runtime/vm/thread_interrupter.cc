@@ -48,6 +48,10 @@ namespace dart {
 // update the signal handler will immediately return.
 
 DEFINE_FLAG(bool, trace_thread_interrupter, false, "Trace thread interrupter");
+DEFINE_FLAG(bool,
+            profile_blocked_threads,
+            false,
+            "Also sample threads that are blocked waiting on a monitor.");
 
 bool ThreadInterrupter::initialized_ = false;
 bool ThreadInterrupter::shutdown_ = false;
@@ -196,8 +200,12 @@ void ThreadInterrupter::ThreadMain(uword parameters) {
         while (it.HasNext()) {
           OSThread* thread = it.Next();
           if (thread->ThreadInterruptsEnabled()) {
+            // Blocked threads still count, so that the interrupter keeps its
+            // period and samples them again once they resume.
             interrupted_thread_count++;
-            InterruptThread(thread);
+            if (FLAG_profile_blocked_threads || !thread->IsInBlockedWait()) {
+              InterruptThread(thread);
+            }
           }
         }
       }
@@ -4,6 +4,11 @@
 
 #include "vm/thread_pool.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "platform/atomic.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/lockers.h"
@@ -14,6 +19,11 @@ DEFINE_FLAG(int,
             worker_timeout_millis,
             5000,
             "Free workers when they have been idle for this amount of time.");
+DEFINE_FLAG(int,
+            worker_idle_spin_micros,
+            50,
+            "Spin for this amount of time waiting for a new task before an "
+            "idle worker goes to sleep.");
 
 ThreadPool::ThreadPool()
     : shutting_down_(false),
@@ -23,6 +33,9 @@ ThreadPool::ThreadPool()
       count_stopped_(0),
       count_running_(0),
       count_idle_(0),
+      count_tasks_started_(0),
+      count_tasks_taken_spinning_(0),
+      total_task_start_latency_micros_(0),
       shutting_down_workers_(NULL),
       join_list_(NULL) {}
 
@@ -315,6 +328,7 @@ ThreadPool::Task::~Task() {}
 ThreadPool::Worker::Worker(ThreadPool* pool)
     : pool_(pool),
       task_(NULL),
+      task_posted_micros_(0),
       id_(OSThread::kInvalidThreadId),
       done_(false),
       owned_(false),
@@ -345,6 +359,7 @@ void ThreadPool::Worker::StartThread() {
 void ThreadPool::Worker::SetTask(Task* task) {
   MonitorLocker ml(&monitor_);
   ASSERT(task_ == NULL);
+  task_posted_micros_ = OS::GetCurrentMonotonicMicros();
   task_ = task;
   ml.Notify();
 }
@@ -368,6 +383,33 @@ static int64_t ComputeTimeout(int64_t idle_start) {
   }
 }
 
+// Tells the processor that this is a spin-wait loop, so that it can save
+// power and give way to the other hardware thread of its core.
+static inline void SpinPause() {
+#if defined(HOST_ARCH_X64) || defined(HOST_ARCH_IA32)
+#if defined(_MSC_VER)
+  _mm_pause();
+#else
+  __builtin_ia32_pause();
+#endif
+#elif defined(HOST_ARCH_ARM) || defined(HOST_ARCH_ARM64)
+  asm volatile("yield");
+#endif
+}
+
+void ThreadPool::Worker::SpinWhileIdle() {
+  if (FLAG_worker_idle_spin_micros <= 0) {
+    return;
+  }
+  const int64_t deadline =
+      OS::GetCurrentMonotonicMicros() + FLAG_worker_idle_spin_micros;
+  while ((AtomicOperations::LoadRelaxed(&task_) == NULL) &&
+         !AtomicOperations::LoadRelaxed(&done_) &&
+         (OS::GetCurrentMonotonicMicros() < deadline)) {
+    SpinPause();
+  }
+}
+
 bool ThreadPool::Worker::Loop() {
   MonitorLocker ml(&monitor_);
   int64_t idle_start;
@@ -375,9 +417,14 @@ bool ThreadPool::Worker::Loop() {
     ASSERT(task_ != NULL);
     Task* task = task_;
     task_ = NULL;
+    const int64_t latency =
+        OS::GetCurrentMonotonicMicros() - task_posted_micros_;
 
     // Release monitor while handling the task.
     ml.Exit();
+    AtomicOperations::IncrementInt64By(&pool_->count_tasks_started_, 1);
+    AtomicOperations::IncrementInt64By(
+        &pool_->total_task_start_latency_micros_, latency);
     task->Run();
     ASSERT(Isolate::Current() == NULL);
     delete task;
@@ -389,6 +436,21 @@ bool ThreadPool::Worker::Loop() {
     }
     ASSERT(!done_);
     pool_->SetIdleAndReapExited(this);
+
+    // Tasks are often started in bursts, for instance the marker and sweeper
+    // tasks of a GC, so an idle worker spins for a little while before it
+    // sleeps, sparing the next task a thread wake up.
+    ml.Exit();
+    SpinWhileIdle();
+    ml.Enter();
+    if (task_ != NULL) {
+      AtomicOperations::IncrementInt64By(&pool_->count_tasks_taken_spinning_,
+                                         1);
+      continue;
+    }
+    if (IsDone()) {
+      return false;
+    }
     idle_start = OS::GetCurrentMonotonicMicros();
     while (true) {
       Monitor::WaitResult result = ml.WaitMicros(ComputeTimeout(idle_start));
@@ -43,6 +43,16 @@ class ThreadPool {
   uint64_t workers_started() const { return count_started_; }
   uint64_t workers_stopped() const { return count_stopped_; }
 
+  // Number of tasks that have started running, and the total time between
+  // handing these tasks to the pool and a worker starting them.
+  int64_t tasks_started() const { return count_tasks_started_; }
+  int64_t task_start_latency_micros() const {
+    return total_task_start_latency_micros_;
+  }
+  // Number of tasks that were handed to a worker while it was still
+  // spinning, before it went to sleep.
+  int64_t tasks_taken_spinning() const { return count_tasks_taken_spinning_; }
+
  private:
   class Worker {
    public:
@@ -71,12 +81,17 @@ class ThreadPool {
     // The main entry point for new worker threads.
     static void Main(uword args);
 
+    // Spins for a short while without holding the monitor in the hope of
+    // being handed another task before parking the thread.
+    void SpinWhileIdle();
+
     bool IsDone() const { return done_; }
 
     // Fields owned by Worker.
     Monitor monitor_;
     ThreadPool* pool_;
     Task* task_;
+    int64_t task_posted_micros_;
     ThreadId id_;
     bool done_;
 
@@ -136,6 +151,9 @@ class ThreadPool {
   uint64_t count_stopped_;
   uint64_t count_running_;
   uint64_t count_idle_;
+  int64_t count_tasks_started_;
+  int64_t count_tasks_taken_spinning_;
+  int64_t total_task_start_latency_micros_;
 
   Monitor exit_monitor_;
   Worker* shutting_down_workers_;
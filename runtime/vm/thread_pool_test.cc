@@ -10,6 +10,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, worker_timeout_millis);
+DECLARE_FLAG(int, worker_idle_spin_micros);
 
 VM_UNIT_TEST_CASE(ThreadPool_Create) {
   ThreadPool thread_pool;
@@ -60,6 +61,43 @@ VM_UNIT_TEST_CASE(ThreadPool_RunOne) {
   EXPECT_EQ(0U, thread_pool.workers_stopped());
 }
 
+// Runs two tasks one after the other on the same worker, and returns the
+// number of them that the worker took while spinning.
+static int64_t RunTwoTasksInTurn(ThreadPool* thread_pool) {
+  Monitor sync;
+  bool done = true;
+  for (int i = 0; i < 2; i++) {
+    while (thread_pool->workers_running() != 0) {
+      OS::Sleep(1);
+    }
+    thread_pool->Run(new TestTask(&sync, &done));
+    MonitorLocker ml(&sync);
+    done = false;
+    ml.Notify();
+    while (!done) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(1U, thread_pool->workers_started());
+  EXPECT_EQ(2, thread_pool->tasks_started());
+  EXPECT(thread_pool->task_start_latency_micros() >= 0);
+  return thread_pool->tasks_taken_spinning();
+}
+
+VM_UNIT_TEST_CASE(ThreadPool_SpinningWorkerTakesTask) {
+  // Keep the idle worker spinning for much longer than the test takes.
+  SetFlagScope<int> sfs(&FLAG_worker_idle_spin_micros,
+                        10 * kMicrosecondsPerSecond);
+  ThreadPool thread_pool;
+  EXPECT_EQ(1, RunTwoTasksInTurn(&thread_pool));
+}
+
+VM_UNIT_TEST_CASE(ThreadPool_SleepingWorkerTakesTask) {
+  SetFlagScope<int> sfs(&FLAG_worker_idle_spin_micros, 0);
+  ThreadPool thread_pool;
+  EXPECT_EQ(0, RunTwoTasksInTurn(&thread_pool));
+}
+
 VM_UNIT_TEST_CASE(ThreadPool_RunMany) {
   const int kTaskCount = 100;
   ThreadPool thread_pool;
@@ -115,6 +115,16 @@ void ThreadRegistry::ReleaseMarkingStacks() {
   }
 }
 
+void ThreadRegistry::ResetOldSpaceBuffers() {
+  MonitorLocker ml(threads_lock());
+  Thread* thread = active_list_;
+  while (thread != NULL) {
+    thread->set_old_space_top(0);
+    thread->set_old_space_end(0);
+    thread = thread->next_;
+  }
+}
+
 #ifndef PRODUCT
 void ThreadRegistry::PrintJSON(JSONStream* stream) const {
   MonitorLocker ml(threads_lock());
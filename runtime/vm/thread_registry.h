@@ -35,6 +35,7 @@ class ThreadRegistry {
   void ReleaseStoreBuffers();
   void AcquireMarkingStacks();
   void ReleaseMarkingStacks();
+  void ResetOldSpaceBuffers();
 
   Thread* mutator_thread() const { return mutator_thread_; }
 
@@ -12,6 +12,7 @@
 #include <cstdlib>
 
 #include "platform/atomic.h"
+#include "vm/hash_map.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/lockers.h"
@@ -54,6 +55,11 @@ DEFINE_FLAG(charp,
             "ring",
             "Select the timeline recorder used. "
             "Valid values: ring, endless, startup, and systrace.")
+DEFINE_FLAG(charp,
+            timeline_format,
+            "json",
+            "Select the format of the trace written to --timeline_dir. "
+            "Valid values: json and perfetto.");
 
 // Implementation notes:
 //
@@ -1105,6 +1111,276 @@ void TimelineEventRecorder::ThreadBlockCompleteEvent(TimelineEvent* event) {
   thread_block_lock->Unlock();
 }
 
+// Streams timeline events to a file as a Perfetto trace, a Trace protobuf
+// message made of one TracePacket per event (see perfetto's trace_packet.proto
+// and track_event.proto). Event names and categories are interned, so each
+// distinct string is written once, and every thread and async id gets a track
+// of its own.
+class TimelinePerfettoWriter : public ValueObject {
+ public:
+  TimelinePerfettoWriter(Dart_FileWriteCallback file_write, void* file)
+      : file_write_(file_write),
+        file_(file),
+        output_(kFlushThreshold + KB),
+        packet_(64),
+        payload_(64),
+        interned_data_(64),
+        nested_(64),
+        pid_(OS::ProcessId()),
+        next_iid_(1) {
+    // The first packet makes the interned strings of the sequence valid.
+    packet_.WriteInt(kPacketSequenceId, kSequenceId);
+    packet_.WriteInt(kPacketSequenceFlags, kSequenceIncrementalStateCleared);
+    FinishPacket();
+  }
+
+  ~TimelinePerfettoWriter() { Flush(); }
+
+  void WriteBlock(TimelineEventBlock* block, TimelineEventFilter* filter) {
+    if (!filter->IncludeBlock(block)) {
+      return;
+    }
+    for (intptr_t i = 0; i < block->length(); i++) {
+      TimelineEvent* event = block->At(i);
+      if (filter->IncludeEvent(event) &&
+          event->Within(filter->time_origin_micros(),
+                        filter->time_extent_micros())) {
+        WriteEvent(event);
+      }
+    }
+  }
+
+ private:
+  // Field numbers of the messages used from perfetto's protos.
+  enum Field {
+    kTracePacket = 1,
+    kPacketTimestamp = 8,
+    kPacketSequenceId = 10,
+    kPacketTrackEvent = 11,
+    kPacketInternedData = 12,
+    kPacketSequenceFlags = 13,
+    kPacketTrackDescriptor = 60,
+    kTrackEventCategoryIid = 3,
+    kTrackEventType = 9,
+    kTrackEventNameIid = 10,
+    kTrackEventTrackUuid = 11,
+    kInternedDataCategories = 1,
+    kInternedDataNames = 2,
+    kInternedStringIid = 1,
+    kInternedStringName = 2,
+    kTrackDescriptorUuid = 1,
+    kTrackDescriptorName = 2,
+    kTrackDescriptorThread = 4,
+    kThreadDescriptorPid = 1,
+    kThreadDescriptorTid = 2,
+  };
+
+  enum TrackEventType {
+    kSliceBegin = 1,
+    kSliceEnd = 2,
+    kInstant = 3,
+  };
+
+  static const intptr_t kSequenceId = 1;
+  static const intptr_t kSequenceIncrementalStateCleared = 1;
+  static const intptr_t kSequenceNeedsIncrementalState = 2;
+  static const intptr_t kFlushThreshold = 64 * KB;
+
+  class Message {
+   public:
+    explicit Message(intptr_t initial_capacity) : buffer_(initial_capacity) {}
+
+    const uint8_t* data() const { return buffer_.data(); }
+    intptr_t length() const { return buffer_.length(); }
+    void Clear() { buffer_.Clear(); }
+
+    void WriteInt(intptr_t field, int64_t value) {
+      WriteVarint(field << 3);
+      WriteVarint(static_cast<uint64_t>(value));
+    }
+
+    void WriteBytes(intptr_t field, const uint8_t* bytes, intptr_t length) {
+      WriteVarint((field << 3) | kLengthDelimited);
+      WriteVarint(length);
+      for (intptr_t i = 0; i < length; i++) {
+        buffer_.Add(bytes[i]);
+      }
+    }
+
+    void WriteString(intptr_t field, const char* str) {
+      WriteBytes(field, reinterpret_cast<const uint8_t*>(str), strlen(str));
+    }
+
+    void WriteMessage(intptr_t field, const Message& message) {
+      WriteBytes(field, message.data(), message.length());
+    }
+
+   private:
+    static const intptr_t kLengthDelimited = 2;
+
+    void WriteVarint(uint64_t value) {
+      while (value >= 0x80) {
+        buffer_.Add(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+      }
+      buffer_.Add(static_cast<uint8_t>(value));
+    }
+
+    MallocGrowableArray<uint8_t> buffer_;
+
+    DISALLOW_COPY_AND_ASSIGN(Message);
+  };
+
+  typedef RawPointerKeyValueTrait<const char, intptr_t> InternTrait;
+  typedef MallocDirectChainedHashMap<InternTrait> InternMap;
+  typedef IntKeyRawPointerValueTrait<bool> TrackTrait;
+  typedef MallocDirectChainedHashMap<TrackTrait> TrackMap;
+
+  void WriteEvent(TimelineEvent* event) {
+    const int64_t tid = OSThread::ThreadIdToIntPtr(event->thread());
+    // Thread and async tracks share the uuid space, told apart by the low bit.
+    const int64_t thread_track = tid << 1;
+    switch (event->event_type()) {
+      case TimelineEvent::kDuration:
+        if (!event->IsFinishedDuration()) {
+          return;
+        }
+        WriteThreadTrack(tid);
+        WriteTrackEvent(event, thread_track, kSliceBegin, event->TimeOrigin());
+        WriteTrackEvent(event, thread_track, kSliceEnd, event->TimeEnd());
+        break;
+      case TimelineEvent::kBegin:
+        WriteThreadTrack(tid);
+        WriteTrackEvent(event, thread_track, kSliceBegin, event->TimeOrigin());
+        break;
+      case TimelineEvent::kEnd:
+        WriteThreadTrack(tid);
+        WriteTrackEvent(event, thread_track, kSliceEnd, event->TimeOrigin());
+        break;
+      case TimelineEvent::kInstant:
+        WriteThreadTrack(tid);
+        WriteTrackEvent(event, thread_track, kInstant, event->TimeOrigin());
+        break;
+      case TimelineEvent::kAsyncBegin:
+      case TimelineEvent::kAsyncInstant:
+      case TimelineEvent::kAsyncEnd: {
+        const int64_t async_track = (event->AsyncId() << 1) | 1;
+        WriteAsyncTrack(async_track, event->label());
+        const TrackEventType type =
+            (event->event_type() == TimelineEvent::kAsyncBegin)
+                ? kSliceBegin
+                : (event->event_type() == TimelineEvent::kAsyncEnd)
+                      ? kSliceEnd
+                      : kInstant;
+        WriteTrackEvent(event, async_track, type, event->TimeOrigin());
+        break;
+      }
+      default:
+        // Counters, flows and metadata have no track event equivalent here.
+        break;
+    }
+  }
+
+  void WriteTrackEvent(TimelineEvent* event,
+                       int64_t track,
+                       TrackEventType type,
+                       int64_t micros) {
+    const intptr_t category_iid =
+        Intern(&categories_, kInternedDataCategories, event->category());
+    const intptr_t name_iid =
+        Intern(&names_, kInternedDataNames, event->label());
+    payload_.WriteInt(kTrackEventCategoryIid, category_iid);
+    payload_.WriteInt(kTrackEventType, type);
+    payload_.WriteInt(kTrackEventNameIid, name_iid);
+    payload_.WriteInt(kTrackEventTrackUuid, track);
+    packet_.WriteInt(kPacketTimestamp, micros * kNanosecondsPerMicrosecond);
+    packet_.WriteInt(kPacketSequenceId, kSequenceId);
+    packet_.WriteInt(kPacketSequenceFlags, kSequenceNeedsIncrementalState);
+    packet_.WriteMessage(kPacketTrackEvent, payload_);
+    if (interned_data_.length() > 0) {
+      packet_.WriteMessage(kPacketInternedData, interned_data_);
+    }
+    payload_.Clear();
+    interned_data_.Clear();
+    FinishPacket();
+  }
+
+  // Returns the interning id of |str|, adding it to the interned data of the
+  // current packet the first time it is seen. Strings are interned by
+  // address, as labels and categories are almost always constants.
+  intptr_t Intern(InternMap* map, intptr_t field, const char* str) {
+    InternTrait::Pair* pair = map->Lookup(str);
+    if (pair != NULL) {
+      return pair->value;
+    }
+    const intptr_t iid = next_iid_++;
+    map->Insert(InternTrait::Pair(str, iid));
+    nested_.WriteInt(kInternedStringIid, iid);
+    nested_.WriteString(kInternedStringName, str);
+    interned_data_.WriteMessage(field, nested_);
+    nested_.Clear();
+    return iid;
+  }
+
+  void WriteThreadTrack(int64_t tid) {
+    if (tracks_.HasKey(tid << 1)) {
+      return;
+    }
+    tracks_.Insert(TrackTrait::Pair(tid << 1, true));
+    nested_.WriteInt(kThreadDescriptorPid, pid_);
+    nested_.WriteInt(kThreadDescriptorTid, tid);
+    payload_.WriteInt(kTrackDescriptorUuid, tid << 1);
+    payload_.WriteMessage(kTrackDescriptorThread, nested_);
+    packet_.WriteMessage(kPacketTrackDescriptor, payload_);
+    nested_.Clear();
+    payload_.Clear();
+    FinishPacket();
+  }
+
+  void WriteAsyncTrack(int64_t track, const char* name) {
+    if (tracks_.HasKey(track)) {
+      return;
+    }
+    tracks_.Insert(TrackTrait::Pair(track, true));
+    payload_.WriteInt(kTrackDescriptorUuid, track);
+    payload_.WriteString(kTrackDescriptorName, name);
+    packet_.WriteMessage(kPacketTrackDescriptor, payload_);
+    payload_.Clear();
+    FinishPacket();
+  }
+
+  void FinishPacket() {
+    output_.WriteMessage(kTracePacket, packet_);
+    packet_.Clear();
+    if (output_.length() >= kFlushThreshold) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    if (output_.length() > 0) {
+      (*file_write_)(output_.data(), output_.length(), file_);
+      output_.Clear();
+    }
+  }
+
+  Dart_FileWriteCallback file_write_;
+  void* file_;
+  Message output_;
+  Message packet_;
+  Message payload_;
+  Message interned_data_;
+  Message nested_;
+  const int64_t pid_;
+  intptr_t next_iid_;
+  InternMap categories_;
+  InternMap names_;
+  // The tracks whose descriptor was written.
+  TrackMap tracks_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimelinePerfettoWriter);
+};
+
 void TimelineEventRecorder::WriteTo(const char* directory) {
   if (!FLAG_support_service) {
     return;
@@ -1118,9 +1394,12 @@ void TimelineEventRecorder::WriteTo(const char* directory) {
 
   Timeline::ReclaimCachedBlocksFromThreads();
 
+  const bool perfetto = (FLAG_timeline_format != NULL) &&
+                        (strcmp(FLAG_timeline_format, "perfetto") == 0);
   intptr_t pid = OS::ProcessId();
   char* filename =
-      OS::SCreate(NULL, "%s/dart-timeline-%" Pd ".json", directory, pid);
+      OS::SCreate(NULL, "%s/dart-timeline-%" Pd ".%s", directory, pid,
+                  perfetto ? "perfetto-trace" : "json");
   void* file = (*file_open)(filename, true);
   if (file == NULL) {
     OS::PrintErr("Failed to write timeline file: %s\n", filename);
@@ -1129,16 +1408,23 @@ void TimelineEventRecorder::WriteTo(const char* directory) {
   }
   free(filename);
 
-  JSONStream js;
   TimelineEventFilter filter;
-  PrintTraceEvent(&js, &filter);
-  // Steal output from JSONStream.
-  char* output = NULL;
-  intptr_t output_length = 0;
-  js.Steal(&output, &output_length);
-  (*file_write)(output, output_length, file);
-  // Free the stolen output.
-  free(output);
+  if (perfetto) {
+    // Written in chunks as the events are visited, so long traces are never
+    // held in memory in full.
+    TimelinePerfettoWriter writer(file_write, file);
+    PrintPerfettoEvents(&writer, &filter);
+  } else {
+    JSONStream js;
+    PrintTraceEvent(&js, &filter);
+    // Steal output from JSONStream.
+    char* output = NULL;
+    intptr_t output_length = 0;
+    js.Steal(&output, &output_length);
+    (*file_write)(output, output_length, file);
+    // Free the stolen output.
+    free(output);
+  }
   (*file_close)(file);
 
   return;
@@ -1254,6 +1540,20 @@ void TimelineEventFixedBufferRecorder::PrintTraceEvent(
   PrintJSONEvents(&events, filter);
 }
 
+void TimelineEventFixedBufferRecorder::PrintPerfettoEvents(
+    TimelinePerfettoWriter* writer,
+    TimelineEventFilter* filter) {
+  if (!FLAG_support_service) {
+    return;
+  }
+  MutexLocker ml(&lock_);
+  // Perfetto sorts events by timestamp, so the blocks are written in any
+  // order.
+  for (intptr_t block_idx = 0; block_idx < num_blocks_; block_idx++) {
+    writer->WriteBlock(&blocks_[block_idx], filter);
+  }
+}
+
 TimelineEventBlock* TimelineEventFixedBufferRecorder::GetHeadBlockLocked() {
   return &blocks_[0];
 }
@@ -1429,6 +1729,19 @@ void TimelineEventEndlessRecorder::PrintTraceEvent(
   PrintJSONEvents(&events, filter);
 }
 
+void TimelineEventEndlessRecorder::PrintPerfettoEvents(
+    TimelinePerfettoWriter* writer,
+    TimelineEventFilter* filter) {
+  if (!FLAG_support_service) {
+    return;
+  }
+  MutexLocker ml(&lock_);
+  for (TimelineEventBlock* current = head_; current != NULL;
+       current = current->next()) {
+    writer->WriteBlock(current, filter);
+  }
+}
+
 TimelineEventBlock* TimelineEventEndlessRecorder::GetHeadBlockLocked() {
   return head_;
 }
@@ -26,6 +26,7 @@ class Thread;
 class TimelineEvent;
 class TimelineEventBlock;
 class TimelineEventRecorder;
+class TimelinePerfettoWriter;
 class TimelineStream;
 class VirtualMemory;
 class Zone;
@@ -321,6 +322,8 @@ class TimelineEvent {
 
   const char* label() const { return label_; }
 
+  const char* category() const { return category_; }
+
   // Does this duration end before |micros| ?
   bool DurationFinishedBefore(int64_t micros) const {
     return TimeEnd() <= micros;
@@ -706,6 +709,11 @@ class TimelineEventRecorder {
   virtual TimelineEventBlock* GetNewBlockLocked() = 0;
   virtual void Clear() = 0;
 
+  // Writes the events in the recorder's blocks to |writer|. Recorders that
+  // do not keep their events in blocks have nothing to write.
+  virtual void PrintPerfettoEvents(TimelinePerfettoWriter* writer,
+                                   TimelineEventFilter* filter) {}
+
   // Utility method(s).
   void PrintJSONMeta(JSONArray* array) const;
   TimelineEvent* ThreadBlockStartEvent();
@@ -750,6 +758,8 @@ class TimelineEventFixedBufferRecorder : public TimelineEventRecorder {
   void Clear();
 
   void PrintJSONEvents(JSONArray* array, TimelineEventFilter* filter);
+  void PrintPerfettoEvents(TimelinePerfettoWriter* writer,
+                           TimelineEventFilter* filter);
 
   VirtualMemory* memory_;
   TimelineEventBlock* blocks_;
@@ -831,6 +841,8 @@ class TimelineEventEndlessRecorder : public TimelineEventRecorder {
   void Clear();
 
   void PrintJSONEvents(JSONArray* array, TimelineEventFilter* filter);
+  void PrintPerfettoEvents(TimelinePerfettoWriter* writer,
+                           TimelineEventFilter* filter);
 
   TimelineEventBlock* head_;
   intptr_t block_index_;
@@ -17,6 +17,8 @@ namespace dart {
 
 #ifndef PRODUCT
 
+DECLARE_FLAG(charp, timeline_format);
+
 class TimelineRecorderOverride : public ValueObject {
  public:
   explicit TimelineRecorderOverride(TimelineEventRecorder* new_recorder)
@@ -32,6 +34,10 @@ class TimelineRecorderOverride : public ValueObject {
 
 class TimelineTestHelper : public AllStatic {
  public:
+  static void WriteTo(TimelineEventRecorder* recorder, const char* directory) {
+    recorder->WriteTo(directory);
+  }
+
   static void SetStream(TimelineEvent* event, TimelineStream* stream) {
     event->StreamInit(stream);
   }
@@ -505,6 +511,140 @@ TEST_CASE(TimelineRingRecorderJSONOrder) {
   delete recorder;
 }
 
+// Collects a trace written with the embedder's file callbacks in memory.
+class TraceCapture : public AllStatic {
+ public:
+  static void* Open(const char* name, bool write) {
+    EXPECT(write);
+    const char* suffix = ".perfetto-trace";
+    EXPECT(strlen(name) > strlen(suffix));
+    EXPECT_STREQ(suffix, name + strlen(name) - strlen(suffix));
+    return &data_;
+  }
+  static void Write(const void* bytes, intptr_t length, void* stream) {
+    EXPECT(stream == &data_);
+    writes_++;
+    for (intptr_t i = 0; i < length; i++) {
+      data_.Add(static_cast<const uint8_t*>(bytes)[i]);
+    }
+  }
+  static void Close(void* stream) { EXPECT(stream == &data_); }
+
+  static MallocGrowableArray<uint8_t> data_;
+  static intptr_t writes_;
+};
+
+MallocGrowableArray<uint8_t> TraceCapture::data_;
+intptr_t TraceCapture::writes_ = 0;
+
+static uint64_t ReadVarint(const uint8_t* data,
+                           intptr_t length,
+                           intptr_t* pos) {
+  uint64_t value = 0;
+  for (intptr_t shift = 0; *pos < length; shift += 7) {
+    const uint8_t byte = data[(*pos)++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  EXPECT(false);  // Truncated varint.
+  return value;
+}
+
+// Checks that the fields of the message in data[start, end) are well formed,
+// and returns the number of fields with the given number.
+static intptr_t CountFields(const uint8_t* data,
+                            intptr_t start,
+                            intptr_t end,
+                            intptr_t field) {
+  intptr_t count = 0;
+  intptr_t pos = start;
+  while (pos < end) {
+    const uint64_t tag = ReadVarint(data, end, &pos);
+    if (static_cast<intptr_t>(tag >> 3) == field) {
+      count++;
+    }
+    switch (tag & 7) {
+      case 0:
+        ReadVarint(data, end, &pos);
+        break;
+      case 2:
+        pos += ReadVarint(data, end, &pos);
+        break;
+      default:
+        EXPECT(false);  // Only varints and length delimited fields are used.
+        return count;
+    }
+  }
+  EXPECT_EQ(end, pos);
+  return count;
+}
+
+static intptr_t CountOccurrences(const MallocGrowableArray<uint8_t>& data,
+                                 const char* str) {
+  const intptr_t length = strlen(str);
+  intptr_t count = 0;
+  for (intptr_t i = 0; i + length <= data.length(); i++) {
+    if (memcmp(&data[i], str, length) == 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+TEST_CASE(TimelinePerfettoTrace) {
+  SetFlagScope<charp> sfs(&FLAG_timeline_format, "perfetto");
+  TimelineEventEndlessRecorder* recorder = new TimelineEventEndlessRecorder();
+  const intptr_t kDurations = 3000;
+  intptr_t track_events = 0;
+  {
+    TimelineRecorderOverride override(recorder);
+    for (intptr_t i = 0; i < kDurations; i++) {
+      TimelineTestHelper::FakeDuration(recorder, "Alpha", 2 * i, 2 * i + 1);
+    }
+    const char* beta = "Beta";
+    TimelineTestHelper::FakeBegin(recorder, beta, 10);
+    TimelineTestHelper::FakeEnd(recorder, beta, 20);
+
+    Dart_FileOpenCallback file_open = Dart::file_open_callback();
+    Dart_FileReadCallback file_read = Dart::file_read_callback();
+    Dart_FileWriteCallback file_write = Dart::file_write_callback();
+    Dart_FileCloseCallback file_close = Dart::file_close_callback();
+    Dart::SetFileCallbacks(TraceCapture::Open, NULL, TraceCapture::Write,
+                           TraceCapture::Close);
+    TimelineTestHelper::WriteTo(recorder, "timeline");
+    Dart::SetFileCallbacks(file_open, file_read, file_write, file_close);
+  }
+
+  const MallocGrowableArray<uint8_t>& data = TraceCapture::data_;
+  EXPECT(data.length() > 0);
+  // Long traces are written in chunks rather than all at once.
+  EXPECT(TraceCapture::writes_ > 1);
+
+  // A trace is a sequence of TracePacket fields, one event per packet.
+  intptr_t pos = 0;
+  while (pos < data.length()) {
+    EXPECT_EQ(static_cast<uint64_t>((1 << 3) | 2),
+              ReadVarint(data.data(), data.length(), &pos));
+    const intptr_t length = ReadVarint(data.data(), data.length(), &pos);
+    EXPECT(pos + length <= data.length());
+    track_events += CountFields(data.data(), pos, pos + length, 11);
+    pos += length;
+  }
+  EXPECT_EQ(data.length(), pos);
+  // A begin and an end for each duration, and the separate begin and end.
+  EXPECT_EQ(2 * kDurations + 2, track_events);
+  // Names are interned, so each is written once.
+  EXPECT_EQ(1, CountOccurrences(data, "Alpha"));
+  EXPECT_EQ(1, CountOccurrences(data, "Beta"));
+
+  TraceCapture::data_.Clear();
+  TraceCapture::writes_ = 0;
+  TimelineTestHelper::Clear(recorder);
+  delete recorder;
+}
+
 TEST_CASE(TimelinePauses_Basic) {
   TimelineEventEndlessRecorder* recorder = new TimelineEventEndlessRecorder();
   ASSERT(recorder != NULL);
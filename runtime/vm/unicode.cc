@@ -40,6 +40,31 @@ const uint32_t Utf8::kOverlongMinimum[7] = {0,  // Padding.
                                             0x0,     0x80,       0x800,
                                             0x10000, 0xFFFFFFFF, 0xFFFFFFFF};
 
+// A constant mask that can be 'and'ed with a word of data to determine if it
+// is all ASCII (with no Latin1 characters).
+#if defined(ARCH_IS_64_BIT)
+static const uintptr_t kAsciiWordMask = DART_UINT64_C(0x8080808080808080);
+#else
+static const uintptr_t kAsciiWordMask = 0x80808080u;
+#endif
+
+// Returns the number of ASCII bytes at the start of 'utf8_array', checking
+// a word at a time.
+static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                  intptr_t array_len) {
+  intptr_t i = 0;
+  while ((i + static_cast<intptr_t>(sizeof(uintptr_t))) <= array_len) {
+    uintptr_t chunk =
+        ReadUnaligned(reinterpret_cast<const uintptr_t*>(&utf8_array[i]));
+    if ((chunk & kAsciiWordMask) != 0) break;
+    i += sizeof(uintptr_t);
+  }
+  while ((i < array_len) && (utf8_array[i] < 0x80)) {
+    i++;
+  }
+  return i;
+}
+
 // Returns the most restricted coding form in which the sequence of utf8
 // characters in 'utf8_array' can be represented in, and the number of
 // code units needed in that form.
@@ -50,6 +75,13 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
   Type char_type = kLatin1;
   for (intptr_t i = 0; i < array_len; i++) {
     uint8_t code_unit = utf8_array[i];
+    if (code_unit < 0x80) {
+      // Skip the rest of the ASCII run, which is one code unit per byte.
+      intptr_t ascii = AsciiPrefixLength(&utf8_array[i], array_len - i);
+      len += ascii;
+      i += ascii - 1;
+      continue;
+    }
     if (!IsTrailByte(code_unit)) {
       ++len;
       if (!IsLatin1SequenceStart(code_unit)) {          // > U+00FF
@@ -71,6 +103,10 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   intptr_t i = 0;
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
+    if (ch < 0x80) {
+      i += AsciiPrefixLength(&utf8_array[i], array_len - i);
+      continue;
+    }
     intptr_t j = 1;
     if (ch >= 0x80) {
       int8_t num_trail_bytes = kTrailBytes[ch];
@@ -107,14 +143,6 @@ intptr_t Utf8::Length(int32_t ch) {
   return 4;
 }
 
-// A constant mask that can be 'and'ed with a word of data to determine if it
-// is all ASCII (with no Latin1 characters).
-#if defined(ARCH_IS_64_BIT)
-static const uintptr_t kAsciiWordMask = DART_UINT64_C(0x8080808080808080);
-#else
-static const uintptr_t kAsciiWordMask = 0x80808080u;
-#endif
-
 intptr_t Utf8::Length(const String& str) {
   if (str.IsOneByteString() || str.IsExternalOneByteString()) {
     // For 1-byte strings, all code points < 0x80 have single-byte UTF-8
@@ -155,11 +183,23 @@ intptr_t Utf8::Length(const String& str) {
 
   // Slow case for 2-byte strings that handles surrogate pairs and longer UTF-8
   // encodings.
+  const uint16_t* data;
+  NoSafepointScope no_safepoint;
+  if (str.IsTwoByteString()) {
+    data = TwoByteString::DataStart(str);
+  } else {
+    data = ExternalTwoByteString::DataStart(str);
+  }
+  intptr_t char_length = str.Length();
   intptr_t length = 0;
-  String::CodePointIterator it(str);
-  while (it.Next()) {
-    int32_t ch = it.Current();
-    length += Utf8::Length(ch);
+  intptr_t i = 0;
+  while (i < char_length) {
+    if (data[i] <= kMaxOneByteChar) {
+      length++;
+      i++;
+    } else {
+      length += Utf8::Length(Utf16::Next(data, &i, char_length));
+    }
   }
   return length;
 }
@@ -237,16 +277,35 @@ intptr_t Utf8::Encode(const String& src, char* dst, intptr_t len) {
     }
   } else {
     // For two-byte strings, which can contain 3 and 4-byte UTF-8 encodings,
-    // which can result in surrogate pairs, use the more general code.
-    String::CodePointIterator it(src);
-    while (it.Next()) {
-      int32_t ch = it.Current();
+    // which can result in surrogate pairs, use the more general code. The
+    // code units are read directly, so that ASCII characters are copied
+    // without going through the code point iterator.
+    const uint16_t* data;
+    NoSafepointScope scope;
+    if (src.IsTwoByteString()) {
+      data = TwoByteString::DataStart(src);
+    } else {
+      data = ExternalTwoByteString::DataStart(src);
+    }
+    intptr_t char_length = src.Length();
+    intptr_t i = 0;
+    while (i < char_length) {
+      if (data[i] <= kMaxOneByteChar) {
+        if (pos == len) {
+          break;
+        }
+        dst[pos++] = static_cast<char>(data[i++]);
+        continue;
+      }
+      intptr_t next = i;
+      int32_t ch = Utf16::Next(data, &next, char_length);
       intptr_t num_bytes = Utf8::Length(ch);
       if (pos + num_bytes > len) {
         break;
       }
       Utf8::Encode(ch, &dst[pos]);
       pos += num_bytes;
+      i = next;
     }
   }
   return pos;
@@ -289,6 +348,14 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
   intptr_t j = 0;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+    if (utf8_array[i] < 0x80) {
+      // Copy the ASCII run as it is.
+      num_bytes = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      memmove(&dst[j], &utf8_array[i], num_bytes);
+      j += num_bytes - 1;
+      continue;
+    }
     int32_t ch;
     ASSERT(IsLatin1SequenceStart(utf8_array[i]));
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
@@ -312,6 +379,16 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
   intptr_t j = 0;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+    if (utf8_array[i] < 0x80) {
+      // Widen the ASCII run.
+      num_bytes = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      for (intptr_t k = 0; k < num_bytes; k++) {
+        dst[j + k] = utf8_array[i + k];
+      }
+      j += num_bytes - 1;
+      continue;
+    }
     int32_t ch;
     bool is_supplementary = IsSupplementarySequenceStart(utf8_array[i]);
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
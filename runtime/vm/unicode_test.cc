@@ -27,6 +27,44 @@ ISOLATE_UNIT_TEST_CASE(Utf8Encode) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Utf8AsciiRuns) {
+  // ASCII runs of different lengths and alignments around non-ASCII
+  // characters, so that both the word-at-a-time and byte loops are used.
+  const char* kSrc =
+      "abcdefghijklmnopq\xC3\xA6rstuvwxyz0123456789\xE2\x82\xAC"
+      "ABCDEFG\xF0\x9F\x98\x80HIJ";
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(kSrc);
+  intptr_t src_len = strlen(kSrc);
+  EXPECT(Utf8::IsValid(src, src_len));
+  Utf8::Type type;
+  EXPECT_EQ(50, Utf8::CodeUnitCount(src, src_len, &type));
+  EXPECT_EQ(Utf8::kSupplementary, type);
+  EXPECT(!Utf8::IsValid(src, src_len - 4));
+
+  const String& str = String::Handle(String::FromUTF8(src, src_len));
+  EXPECT_EQ(50, str.Length());
+  EXPECT_EQ('q', str.CharAt(16));
+  EXPECT_EQ(0xE6, str.CharAt(17));
+  EXPECT_EQ(0x20AC, str.CharAt(37));
+  EXPECT_EQ(0xD83D, str.CharAt(45));
+  EXPECT_EQ('J', str.CharAt(49));
+  EXPECT_EQ(src_len, Utf8::Length(str));
+  char buffer[64];
+  EXPECT_EQ(src_len, Utf8::Encode(str, buffer, sizeof(buffer)));
+  EXPECT(!memcmp(kSrc, buffer, src_len));
+  // Encoding stops in front of a character that does not fit.
+  EXPECT_EQ(38, Utf8::Encode(str, buffer, 40));
+
+  const uint8_t kLatin1Src[] = "0123456789abcdef\xC3\xBF" "0123456789";
+  const String& latin1 = String::Handle(
+      String::FromUTF8(kLatin1Src, sizeof(kLatin1Src) - 1));
+  EXPECT(latin1.IsOneByteString());
+  EXPECT_EQ(27, latin1.Length());
+  EXPECT_EQ('f', latin1.CharAt(15));
+  EXPECT_EQ(0xFF, latin1.CharAt(16));
+  EXPECT_EQ('9', latin1.CharAt(26));
+}
+
 ISOLATE_UNIT_TEST_CASE(Utf8Decode) {
   // Examples from the Unicode specification, chapter 3
   {
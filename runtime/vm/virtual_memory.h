@@ -37,6 +37,27 @@ class VirtualMemory {
   static void Protect(void* address, intptr_t size, Protection mode);
   void Protect(Protection mode) { return Protect(address(), size(), mode); }
 
+  // Size and alignment of a transparent huge page where supported.
+  static const intptr_t kHugePageSize = 2 * MB;
+
+  // Asks for the area to be backed by transparent huge pages. Only the parts
+  // covering whole, aligned huge pages can be. Best effort, and a no-op where
+  // unsupported.
+  static void AdviseHugePages(void* address, intptr_t size);
+  void AdviseHugePages() { return AdviseHugePages(address(), size()); }
+
+  // Tells the OS that the contents of the area are no longer needed, so its
+  // physical pages can be reclaimed. The area stays mapped and reads back as
+  // zeros or its old contents. Best effort, and a no-op where unsupported.
+  static void DontNeed(void* address, intptr_t size);
+
+  // Asks for the pages of the area to be placed on the given NUMA node when
+  // they are first touched. Best effort, and a no-op where unsupported.
+  static void BindToNumaNode(void* address, intptr_t size, intptr_t node);
+  void BindToNumaNode(intptr_t node) {
+    return BindToNumaNode(address(), size(), node);
+  }
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, NULL is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -177,6 +177,14 @@ bool VirtualMemory::FreeSubSegment(void* address, intptr_t size) {
   return true;
 }
 
+void VirtualMemory::AdviseHugePages(void* address, intptr_t size) {}
+
+void VirtualMemory::DontNeed(void* address, intptr_t size) {}
+
+void VirtualMemory::BindToNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
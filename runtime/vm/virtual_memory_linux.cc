@@ -9,6 +9,7 @@
 
 #include <errno.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "platform/assert.h"
@@ -101,6 +102,33 @@ bool VirtualMemory::FreeSubSegment(void* address,
   return true;
 }
 
+void VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+#if defined(MADV_HUGEPAGE)
+  // Fails with EINVAL when the kernel is built without THP support.
+  madvise(address, size, MADV_HUGEPAGE);
+#endif
+}
+
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  madvise(address, size, MADV_DONTNEED);
+}
+
+void VirtualMemory::BindToNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {
+  if ((node < 0) || (node >= kBitsPerWord)) {
+    return;
+  }
+  // From <linux/mempolicy.h>; libnuma is not a dependency.
+  const int kMpolPreferred = 1;
+  uword node_mask = static_cast<uword>(1) << node;
+  if (syscall(SYS_mbind, address, size, kMpolPreferred, &node_mask,
+              kBitsPerWord, 0) != 0) {
+    // Not fatal: the pages are placed by the default policy instead.
+    ASSERT(errno != EFAULT);
+  }
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
@@ -101,6 +101,16 @@ bool VirtualMemory::FreeSubSegment(void* address,
   return true;
 }
 
+void VirtualMemory::AdviseHugePages(void* address, intptr_t size) {}
+
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  madvise(address, size, MADV_FREE);
+}
+
+void VirtualMemory::BindToNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
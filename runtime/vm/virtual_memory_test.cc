@@ -100,4 +100,25 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+VM_UNIT_TEST_CASE(NumaBoundVirtualMemory) {
+  const intptr_t num_nodes = OSThread::NumberOfNumaNodes();
+  EXPECT(num_nodes >= 1);
+  const intptr_t node = OSThread::GetCurrentNumaNode();
+  EXPECT((node >= 0) && (node < num_nodes));
+
+  // Binding is best effort, but the memory must stay usable.
+  const intptr_t kVirtualMemoryBlockSize = 1 * MB;
+  VirtualMemory* vm =
+      VirtualMemory::Allocate(kVirtualMemoryBlockSize, false, NULL);
+  vm->BindToNumaNode(node);
+  memset(vm->address(), 0x42, kVirtualMemoryBlockSize);
+  EXPECT_EQ(0x42, reinterpret_cast<uint8_t*>(vm->address())[0]);
+  delete vm;
+
+  if (OSThread::BindCurrentThreadToNumaNode(node)) {
+    EXPECT_EQ(node, OSThread::GetCurrentNumaNode());
+    EXPECT(OSThread::BindCurrentThreadToNumaNode(OSThread::kAnyNumaNode));
+  }
+}
+
 }  // namespace dart
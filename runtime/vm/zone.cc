@@ -10,6 +10,7 @@
 #include "vm/flags.h"
 #include "vm/handles_impl.h"
 #include "vm/heap/heap.h"
+#include "vm/lockers.h"
 #include "vm/os.h"
 
 namespace dart {
@@ -38,16 +39,65 @@ class Zone::Segment {
   // Computes the address of the nth byte in this segment.
   uword address(int n) { return reinterpret_cast<uword>(this) + n; }
 
-  static void Delete(Segment* segment) { free(segment); }
+  static void Delete(Segment* segment, intptr_t size);
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Segment);
 };
 
+// Segments of the default size are kept in a process-wide cache when their
+// zone is deleted, so that creating and deleting zones, as the background
+// compiler and the service protocol do all the time, does not go to malloc
+// and free for every segment. Large segments are not cached.
+static const intptr_t kSegmentCacheCapacity = 16;  // 1 MB of segments.
+static Mutex* segment_cache_mutex = NULL;
+static void* segment_cache[kSegmentCacheCapacity];
+static intptr_t segment_cache_size = 0;
+
+void Zone::Init() {
+  ASSERT(segment_cache_mutex == NULL);
+  segment_cache_mutex = new Mutex(NOT_IN_PRODUCT("segment_cache_mutex"));
+}
+
+void Zone::Cleanup() {
+  ClearCache();
+  delete segment_cache_mutex;
+  segment_cache_mutex = NULL;
+}
+
+void Zone::ClearCache() {
+  if (segment_cache_mutex == NULL) {
+    return;
+  }
+  MutexLocker ml(segment_cache_mutex, /* no_safepoint_scope = */ false);
+  ASSERT(segment_cache_size >= 0);
+  ASSERT(segment_cache_size <= kSegmentCacheCapacity);
+  while (segment_cache_size > 0) {
+    free(segment_cache[--segment_cache_size]);
+  }
+}
+
+intptr_t Zone::CachedSegmentCount() {
+  if (segment_cache_mutex == NULL) {
+    return 0;
+  }
+  MutexLocker ml(segment_cache_mutex, /* no_safepoint_scope = */ false);
+  return segment_cache_size;
+}
+
 Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
   ASSERT(size >= 0);
-  Segment* result = reinterpret_cast<Segment*>(malloc(size));
+  Segment* result = NULL;
+  if ((size == kSegmentSize) && (segment_cache_mutex != NULL)) {
+    MutexLocker ml(segment_cache_mutex, /* no_safepoint_scope = */ false);
+    if (segment_cache_size > 0) {
+      result = reinterpret_cast<Segment*>(segment_cache[--segment_cache_size]);
+    }
+  }
   if (result == NULL) {
-    OUT_OF_MEMORY();
+    result = reinterpret_cast<Segment*>(malloc(size));
+    if (result == NULL) {
+      OUT_OF_MEMORY();
+    }
   }
   ASSERT(Utils::IsAligned(result->start(), Zone::kAlignment));
 #ifdef DEBUG
@@ -63,17 +113,29 @@ Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
 void Zone::Segment::DeleteSegmentList(Segment* head) {
   Segment* current = head;
   while (current != NULL) {
-    DecrementMemoryCapacity(current->size());
+    const intptr_t size = current->size();
+    DecrementMemoryCapacity(size);
     Segment* next = current->next();
 #ifdef DEBUG
     // Zap the entire current segment (including the header).
-    memset(current, kZapDeletedByte, current->size());
+    memset(current, kZapDeletedByte, size);
 #endif
-    Segment::Delete(current);
+    Segment::Delete(current, size);
     current = next;
   }
 }
 
+void Zone::Segment::Delete(Segment* segment, intptr_t size) {
+  if ((size == kSegmentSize) && (segment_cache_mutex != NULL)) {
+    MutexLocker ml(segment_cache_mutex, /* no_safepoint_scope = */ false);
+    if (segment_cache_size < kSegmentCacheCapacity) {
+      segment_cache[segment_cache_size++] = segment;
+      return;
+    }
+  }
+  free(segment);
+}
+
 void Zone::Segment::IncrementMemoryCapacity(uintptr_t size) {
   Thread* current_thread = Thread::Current();
   if (current_thread != NULL) {
@@ -75,6 +75,14 @@ class Zone {
 
   Zone* previous() const { return previous_; }
 
+  // Set up and tear down the process-wide cache of zone segments.
+  static void Init();
+  static void Cleanup();
+
+  // Free the segments held in the cache.
+  static void ClearCache();
+  static intptr_t CachedSegmentCount();
+
   bool ContainsNestedZone(Zone* other) const {
     while (other != NULL) {
       if (this == other) return true;
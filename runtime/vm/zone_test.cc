@@ -155,6 +155,39 @@ VM_UNIT_TEST_CASE(ZoneAllocated) {
   Dart_ShutdownIsolate();
 }
 
+VM_UNIT_TEST_CASE(ZoneSegmentReuse) {
+  TestCase::CreateTestIsolate();
+  Thread* thread = Thread::Current();
+  const intptr_t kSegmentSize = 64 * KB;
+  Zone::ClearCache();
+  // Segments released by one zone are handed out again to the next one,
+  // which must see them as fresh memory.
+  intptr_t cached = 0;
+  for (intptr_t round = 0; round < 4; round++) {
+    {
+      StackZone stack_zone(thread);
+      Zone* zone = stack_zone.GetZone();
+      for (intptr_t i = 0; i < 8; i++) {
+        uint8_t* buffer =
+            reinterpret_cast<uint8_t*>(zone->AllocUnsafe(kSegmentSize / 2));
+        EXPECT(buffer != NULL);
+        memset(buffer, round, kSegmentSize / 2);
+      }
+      EXPECT_LE(static_cast<uintptr_t>(4 * kSegmentSize),
+                zone->CapacityInBytes());
+      if (round > 0) {
+        // This zone took its segments from the ones the last zone left.
+        EXPECT_LT(Zone::CachedSegmentCount(), cached);
+      }
+    }
+    cached = Zone::CachedSegmentCount();
+    EXPECT_LE(4, cached);
+  }
+  Zone::ClearCache();
+  EXPECT_EQ(0, Zone::CachedSegmentCount());
+  Dart_ShutdownIsolate();
+}
+
 TEST_CASE(PrintToString) {
   StackZone zone(Thread::Current());
   const char* result = zone.GetZone()->PrintToString("Hello %s!", "World");
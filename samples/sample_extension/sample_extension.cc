@@ -36,30 +36,28 @@ Dart_Handle HandleError(Dart_Handle handle) {
 }
 
 
+// Natives that take and return numbers do not need to go through handles:
+// the return value is set unboxed, so SystemRand does not even need a scope.
 void SystemRand(Dart_NativeArguments arguments) {
-  Dart_EnterScope();
-  Dart_Handle result = HandleError(Dart_NewInteger(rand()));
-  Dart_SetReturnValue(arguments, result);
-  Dart_ExitScope();
+  Dart_SetIntegerReturnValue(arguments, rand());
 }
 
 
+// All arguments are decoded in one call, against a descriptor of their
+// positions and types. SystemSrand is resolved with an automatic scope, in
+// which Dart_GetNativeArguments can return an error handle.
 void SystemSrand(Dart_NativeArguments arguments) {
-  Dart_EnterScope();
-  bool success = false;
-  Dart_Handle seed_object = HandleError(Dart_GetNativeArgument(arguments, 0));
-  if (Dart_IsInteger(seed_object)) {
-    bool fits;
-    HandleError(Dart_IntegerFitsIntoInt64(seed_object, &fits));
-    if (fits) {
-      int64_t seed;
-      HandleError(Dart_IntegerToInt64(seed_object, &seed));
-      srand(static_cast<unsigned>(seed));
-      success = true;
-    }
+  const Dart_NativeArgument_Descriptor descriptors[] = {
+      {Dart_NativeArgument_kInt64, 0},
+  };
+  Dart_NativeArgument_Value values[1];
+  Dart_Handle result = Dart_GetNativeArguments(arguments, 1, descriptors,
+                                               values);
+  const bool success = !Dart_IsError(result);
+  if (success) {
+    srand(static_cast<unsigned>(values[0].as_int64));
   }
-  Dart_SetReturnValue(arguments, HandleError(Dart_NewBoolean(success)));
-  Dart_ExitScope();
+  Dart_SetBooleanReturnValue(arguments, success);
 }
 
 
@@ -464,9 +464,32 @@ class _HttpHeaders implements HttpHeaders {
     _mutable = false;
   }
 
+  // Encoded lines of single-valued headers that most responses repeat with
+  // the same value, keyed by name. Each keeps the line it last built, so the
+  // date is encoded once a second and the others about once.
+  static final Map<String, _HeaderLine> _headerLineCache = {
+    HttpHeaders.dateHeader: new _HeaderLine(),
+    HttpHeaders.serverHeader: new _HeaderLine(),
+    HttpHeaders.contentTypeHeader: new _HeaderLine(),
+    HttpHeaders.connectionHeader: new _HeaderLine(),
+    HttpHeaders.transferEncodingHeader: new _HeaderLine(),
+    HttpHeaders.contentEncodingHeader: new _HeaderLine(),
+    HttpHeaders.cacheControlHeader: new _HeaderLine(),
+    "x-frame-options": new _HeaderLine(),
+    "x-content-type-options": new _HeaderLine(),
+    "x-xss-protection": new _HeaderLine(),
+  };
+
   void _build(BytesBuilder builder) {
     for (String name in _headers.keys) {
       List<String> values = _headers[name];
+      if (values.length == 1) {
+        _HeaderLine line = _headerLineCache[name];
+        if (line != null) {
+          builder.add(line.encode(name, values[0]));
+          continue;
+        }
+      }
       bool fold = _foldHeader(name);
       var nameData = name.codeUnits;
       builder.add(nameData);
@@ -606,6 +629,33 @@ class _HttpHeaders implements HttpHeaders {
   }
 }
 
+// An encoded "name: value" header line, ending with CRLF, and the value it
+// was encoded for.
+class _HeaderLine {
+  String _value;
+  Uint8List _bytes;
+
+  Uint8List encode(String name, String value) {
+    if (_bytes == null || _value != value) {
+      Uint8List bytes = new Uint8List(name.length + value.length + 4);
+      int index = 0;
+      for (int i = 0; i < name.length; i++) {
+        bytes[index++] = name.codeUnitAt(i);
+      }
+      bytes[index++] = _CharCode.COLON;
+      bytes[index++] = _CharCode.SP;
+      for (int i = 0; i < value.length; i++) {
+        bytes[index++] = value.codeUnitAt(i);
+      }
+      bytes[index++] = _CharCode.CR;
+      bytes[index++] = _CharCode.LF;
+      _value = value;
+      _bytes = bytes;
+    }
+    return _bytes;
+  }
+}
+
 class _HeaderValue implements HeaderValue {
   String _value;
   Map<String, String> _parameters;
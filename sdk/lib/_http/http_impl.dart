@@ -854,21 +854,41 @@ class _HttpResponse extends _HttpOutboundMessage<HttpResponse>
     });
   }
 
+  // The status line of the last response written in this isolate. A server
+  // mostly answers with the same status, so the line is rarely encoded again.
+  static bool _lastStatusLineHttp11;
+  static int _lastStatusCode;
+  static String _lastReasonPhrase;
+  static Uint8List _lastStatusLine;
+
+  Uint8List _statusLine() {
+    bool http11 = headers.protocolVersion == "1.1";
+    String phrase = reasonPhrase;
+    if (_lastStatusLine == null ||
+        http11 != _lastStatusLineHttp11 ||
+        statusCode != _lastStatusCode ||
+        phrase != _lastReasonPhrase) {
+      BytesBuilder line = new BytesBuilder();
+      line.add(http11 ? _Const.HTTP11 : _Const.HTTP10);
+      line.addByte(_CharCode.SP);
+      line.add(statusCode.toString().codeUnits);
+      line.addByte(_CharCode.SP);
+      line.add(phrase.codeUnits);
+      line.addByte(_CharCode.CR);
+      line.addByte(_CharCode.LF);
+      _lastStatusLineHttp11 = http11;
+      _lastStatusCode = statusCode;
+      _lastReasonPhrase = phrase;
+      _lastStatusLine = line.takeBytes();
+    }
+    return _lastStatusLine;
+  }
+
   void _writeHeader() {
     BytesBuilder buffer = new _CopyingBytesBuilder(_OUTGOING_BUFFER_SIZE);
 
     // Write status line.
-    if (headers.protocolVersion == "1.1") {
-      buffer.add(_Const.HTTP11);
-    } else {
-      buffer.add(_Const.HTTP10);
-    }
-    buffer.addByte(_CharCode.SP);
-    buffer.add(statusCode.toString().codeUnits);
-    buffer.addByte(_CharCode.SP);
-    buffer.add(reasonPhrase.codeUnits);
-    buffer.addByte(_CharCode.CR);
-    buffer.addByte(_CharCode.LF);
+    buffer.add(_statusLine());
 
     var session = _httpRequest._session;
     if (session != null && !session._destroyed) {
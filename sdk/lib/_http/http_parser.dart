@@ -644,6 +644,19 @@ class _HttpParser extends Stream<_HttpIncoming> {
             _state = _State.HEADER_VALUE_FOLD_OR_END;
           } else {
             _headerValue.add(byte);
+            // Copy the rest of the value that is in the buffer at once,
+            // instead of going through the state machine for every byte.
+            int end = _index;
+            while (end < _buffer.length) {
+              int next = _buffer[end];
+              if (next == _CharCode.CR || next == _CharCode.LF) break;
+              end++;
+            }
+            if (end > _index) {
+              _headerValue.addAll(new Uint8List.view(_buffer.buffer,
+                  _buffer.offsetInBytes + _index, end - _index));
+              _index = end;
+            }
           }
           break;
 
@@ -656,7 +669,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
           if (byte == _CharCode.SP || byte == _CharCode.HT) {
             _state = _State.HEADER_VALUE_START;
           } else {
-            String headerField = new String.fromCharCodes(_headerField);
+            String headerField = _headerFieldToString(_headerField);
             String headerValue = new String.fromCharCodes(_headerValue);
             if (headerField == "transfer-encoding" &&
                 _caseInsensitiveCompare("chunked".codeUnits, _headerValue)) {
@@ -925,6 +938,51 @@ class _HttpParser extends Stream<_HttpIncoming> {
     _index = null;
   }
 
+  // Common header field names. A parsed field name that matches one of them
+  // is returned as the HttpHeaders constant instead of a new string, which
+  // also lets the comparisons in _HttpHeaders._add succeed on identity.
+  static const List<String> _commonHeaderFields = const [
+    HttpHeaders.acceptHeader,
+    HttpHeaders.acceptEncodingHeader,
+    HttpHeaders.acceptLanguageHeader,
+    HttpHeaders.authorizationHeader,
+    HttpHeaders.cacheControlHeader,
+    HttpHeaders.connectionHeader,
+    HttpHeaders.contentEncodingHeader,
+    HttpHeaders.contentLengthHeader,
+    HttpHeaders.contentTypeHeader,
+    HttpHeaders.cookieHeader,
+    HttpHeaders.dateHeader,
+    HttpHeaders.etagHeader,
+    HttpHeaders.expiresHeader,
+    HttpHeaders.hostHeader,
+    HttpHeaders.ifModifiedSinceHeader,
+    HttpHeaders.ifNoneMatchHeader,
+    HttpHeaders.lastModifiedHeader,
+    HttpHeaders.locationHeader,
+    HttpHeaders.refererHeader,
+    HttpHeaders.serverHeader,
+    HttpHeaders.setCookieHeader,
+    HttpHeaders.transferEncodingHeader,
+    HttpHeaders.upgradeHeader,
+    HttpHeaders.userAgentHeader,
+    HttpHeaders.varyHeader,
+  ];
+
+  static String _headerFieldToString(List<int> field) {
+    int length = field.length;
+    for (int i = 0; i < _commonHeaderFields.length; i++) {
+      String common = _commonHeaderFields[i];
+      if (common.length != length) continue;
+      int j = 0;
+      while (j < length && common.codeUnitAt(j) == field[j]) {
+        j++;
+      }
+      if (j == length) return common;
+    }
+    return new String.fromCharCodes(field);
+  }
+
   static bool _isTokenChar(int byte) {
     return byte > 31 && byte < 128 && !_Const.SEPARATOR_MAP[byte];
   }
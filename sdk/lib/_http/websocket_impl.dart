@@ -95,7 +95,7 @@ class _WebSocketProtocolTransformer extends StreamTransformerBase<List<int>,
   EventSink<dynamic /*List<int>|_WebSocketPing|_WebSocketPong*/ > _eventSink;
 
   final bool _serverSide;
-  final List _maskingBytes = new List(4);
+  final Uint8List _maskingBytes = new Uint8List(4);
   final BytesBuilder _payload = new BytesBuilder(copy: false);
 
   _WebSocketPerMessageDeflate _deflate;
@@ -244,7 +244,7 @@ class _WebSocketProtocolTransformer extends StreamTransformerBase<List<int>,
     // Skip Int32x4-version if message is small.
     if (length >= BLOCK_SIZE) {
       // Start by aligning to 16 bytes.
-      final int startOffset = BLOCK_SIZE - (index & 15);
+      final int startOffset = (BLOCK_SIZE - (index & 15)) & 15;
       final int end = index + startOffset;
       for (int i = index; i < end; i++) {
         buffer[i] ^= _maskingBytes[_unmaskingIndex++ & 3];
@@ -596,16 +596,18 @@ class _WebSocketPerMessageDeflate {
   Uint8List processIncomingMessage(List<int> msg) {
     _ensureDecoder();
 
-    var data = <int>[];
-    data.addAll(msg);
-    data.addAll(const [0x00, 0x00, 0xff, 0xff]);
-
-    decoder.process(data, 0, data.length);
-    var result = <int>[];
+    // Inflate the message and then the empty block trailer that the sender
+    // removed, collecting the output chunks without copying them into a
+    // list of ints.
+    var result = new BytesBuilder(copy: false);
     List<int> out;
-
+    decoder.process(msg, 0, msg.length);
+    while ((out = decoder.processed()) != null) {
+      result.add(out);
+    }
+    decoder.process(const [0x00, 0x00, 0xff, 0xff], 0, 4);
     while ((out = decoder.processed()) != null) {
-      result.addAll(out);
+      result.add(out);
     }
 
     if ((serverSide && clientNoContextTakeover) ||
@@ -613,12 +615,12 @@ class _WebSocketPerMessageDeflate {
       decoder = null;
     }
 
-    return new Uint8List.fromList(result);
+    return result.takeBytes();
   }
 
   List<int> processOutgoingMessage(List<int> msg) {
     _ensureEncoder();
-    var result = <int>[];
+    var result = new BytesBuilder(copy: false);
     Uint8List buffer;
 
     if (msg is! Uint8List) {
@@ -637,7 +639,7 @@ class _WebSocketPerMessageDeflate {
 
     List<int> out;
     while ((out = encoder.processed()) != null) {
-      result.addAll(out);
+      result.add(out);
     }
 
     if ((!serverSide && clientNoContextTakeover) ||
@@ -645,11 +647,14 @@ class _WebSocketPerMessageDeflate {
       encoder = null;
     }
 
-    if (result.length > 4) {
-      result = result.sublist(0, result.length - 4);
+    Uint8List bytes = result.takeBytes();
+    if (bytes.length > 4) {
+      // Drop the empty block trailer, see processIncomingMessage.
+      bytes = new Uint8List.view(
+          bytes.buffer, bytes.offsetInBytes, bytes.length - 4);
     }
 
-    return result;
+    return bytes;
   }
 }
 
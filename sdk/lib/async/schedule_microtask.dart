@@ -6,24 +6,24 @@ part of dart.async;
 
 typedef void _AsyncCallback();
 
-class _AsyncCallbackEntry {
-  final _AsyncCallback callback;
-  _AsyncCallbackEntry next;
-  _AsyncCallbackEntry(this.callback);
-}
-
-/** Head of single linked list of pending callbacks. */
-_AsyncCallbackEntry _nextCallback;
-/** Tail of single linked list of pending callbacks. */
-_AsyncCallbackEntry _lastCallback;
 /**
- * Tail of priority callbacks added by the currently executing callback.
+ * Pending callbacks, as a ring buffer whose length is a power of two.
+ *
+ * The [_callbackCount] callbacks starting at index [_callbackHead] are in
+ * use. A ring buffer avoids allocating a list entry for every callback.
+ */
+List<_AsyncCallback> _callbacks = new List<_AsyncCallback>(16);
+int _callbackHead = 0;
+int _callbackCount = 0;
+/**
+ * Priority callbacks added by the currently executing callback, or outside
+ * of the callback loop, in scheduling order.
  *
- * Priority callbacks are put at the beginning of the
- * callback queue, so that if one callback schedules more than one
- * priority callback, they are still enqueued in scheduling order.
+ * Priority callbacks are put at the beginning of the callback queue once
+ * the callback that added them returns, so that if one callback schedules
+ * more than one priority callback, they are still run in scheduling order.
  */
-_AsyncCallbackEntry _lastPriorityCallback;
+List<_AsyncCallback> _priorityCallbacks;
 /**
  * Whether we are currently inside the callback loop.
  *
@@ -32,13 +32,50 @@ _AsyncCallbackEntry _lastPriorityCallback;
  */
 bool _isInCallbackLoop = false;
 
+bool get _hasPendingCallbacks =>
+    _callbackCount != 0 || _priorityCallbacks != null;
+
+void _growCallbacks() {
+  List<_AsyncCallback> callbacks = _callbacks;
+  int mask = callbacks.length - 1;
+  List<_AsyncCallback> grown =
+      new List<_AsyncCallback>(callbacks.length * 2);
+  for (int i = 0; i < _callbackCount; i++) {
+    grown[i] = callbacks[(_callbackHead + i) & mask];
+  }
+  _callbacks = grown;
+  _callbackHead = 0;
+}
+
+void _addCallbackLast(_AsyncCallback callback) {
+  if (_callbackCount == _callbacks.length) _growCallbacks();
+  _callbacks[(_callbackHead + _callbackCount) & (_callbacks.length - 1)] =
+      callback;
+  _callbackCount++;
+}
+
+void _movePriorityCallbacksFirst() {
+  List<_AsyncCallback> priorityCallbacks = _priorityCallbacks;
+  _priorityCallbacks = null;
+  for (int i = priorityCallbacks.length - 1; i >= 0; i--) {
+    if (_callbackCount == _callbacks.length) _growCallbacks();
+    _callbackHead = (_callbackHead - 1) & (_callbacks.length - 1);
+    _callbacks[_callbackHead] = priorityCallbacks[i];
+    _callbackCount++;
+  }
+}
+
 void _microtaskLoop() {
-  while (_nextCallback != null) {
-    _lastPriorityCallback = null;
-    _AsyncCallbackEntry entry = _nextCallback;
-    _nextCallback = entry.next;
-    if (_nextCallback == null) _lastCallback = null;
-    (entry.callback)();
+  while (true) {
+    if (_priorityCallbacks != null) _movePriorityCallbacksFirst();
+    if (_callbackCount == 0) break;
+    List<_AsyncCallback> callbacks = _callbacks;
+    int head = _callbackHead;
+    _AsyncCallback callback = callbacks[head];
+    callbacks[head] = null;
+    _callbackHead = (head + 1) & (callbacks.length - 1);
+    _callbackCount--;
+    callback();
   }
 }
 
@@ -49,9 +86,9 @@ void _startMicrotaskLoop() {
     // good optimization.
     _microtaskLoop();
   } finally {
-    _lastPriorityCallback = null;
+    if (_priorityCallbacks != null) _movePriorityCallbacksFirst();
     _isInCallbackLoop = false;
-    if (_nextCallback != null) {
+    if (_callbackCount != 0) {
       _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
     }
   }
@@ -64,15 +101,10 @@ void _startMicrotaskLoop() {
  * microtasks, but as part of the current system event.
  */
 void _scheduleAsyncCallback(_AsyncCallback callback) {
-  _AsyncCallbackEntry newEntry = new _AsyncCallbackEntry(callback);
-  if (_nextCallback == null) {
-    _nextCallback = _lastCallback = newEntry;
-    if (!_isInCallbackLoop) {
-      _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
-    }
-  } else {
-    _lastCallback.next = newEntry;
-    _lastCallback = newEntry;
+  bool wasEmpty = !_hasPendingCallbacks;
+  _addCallbackLast(callback);
+  if (wasEmpty && !_isInCallbackLoop) {
+    _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
   }
 }
 
@@ -85,22 +117,10 @@ void _scheduleAsyncCallback(_AsyncCallback callback) {
  * Is always run in the root zone.
  */
 void _schedulePriorityAsyncCallback(_AsyncCallback callback) {
-  if (_nextCallback == null) {
-    _scheduleAsyncCallback(callback);
-    _lastPriorityCallback = _lastCallback;
-    return;
-  }
-  _AsyncCallbackEntry entry = new _AsyncCallbackEntry(callback);
-  if (_lastPriorityCallback == null) {
-    entry.next = _nextCallback;
-    _nextCallback = _lastPriorityCallback = entry;
-  } else {
-    entry.next = _lastPriorityCallback.next;
-    _lastPriorityCallback.next = entry;
-    _lastPriorityCallback = entry;
-    if (entry.next == null) {
-      _lastCallback = entry;
-    }
+  bool wasEmpty = !_hasPendingCallbacks;
+  (_priorityCallbacks ??= <_AsyncCallback>[]).add(callback);
+  if (wasEmpty && !_isInCallbackLoop) {
+    _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
   }
 }
 
@@ -399,9 +399,7 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
    */
   List<int> convert(List<int> bytes) {
     _BufferSink sink = new _BufferSink();
-    startChunkedConversion(sink)
-      ..add(bytes)
-      ..close();
+    startChunkedConversion(sink).addSlice(bytes, 0, bytes.length, true);
     return sink.builder.takeBytes();
   }
 
@@ -461,9 +459,7 @@ class ZLibDecoder extends Converter<List<int>, List<int>> {
    */
   List<int> convert(List<int> bytes) {
     _BufferSink sink = new _BufferSink();
-    startChunkedConversion(sink)
-      ..add(bytes)
-      ..close();
+    startChunkedConversion(sink).addSlice(bytes, 0, bytes.length, true);
     return sink.builder.takeBytes();
   }
 
@@ -606,9 +602,13 @@ class _FilterSink extends ByteConversionSink {
           _ensureFastAndSerializableByteData(data, start, end);
       _filter.process(bufferAndStart.buffer, bufferAndStart.start,
           end - (start - bufferAndStart.start));
-      List<int> out;
-      while ((out = _filter.processed(flush: false)) != null) {
-        _sink.add(out);
+      // The last chunk is processed by close, where the filter can finish the
+      // stream in as few and as large chunks as possible.
+      if (!isLast) {
+        List<int> out;
+        while ((out = _filter.processed(flush: false)) != null) {
+          _sink.add(out);
+        }
       }
     } catch (e) {
       _closed = true;
@@ -97,6 +97,22 @@ class FileLock {
   const FileLock._internal(this._type);
 }
 
+/// How the bytes returned by [RandomAccessFile.map] will be accessed.
+class FileAccessPattern {
+  /// No particular pattern.
+  static const normal = const FileAccessPattern._internal(0);
+
+  /// Mostly in order, so more of the file should be read ahead.
+  static const sequential = const FileAccessPattern._internal(1);
+
+  /// In no particular order, so little of the file should be read ahead.
+  static const random = const FileAccessPattern._internal(2);
+
+  final int _type;
+
+  const FileAccessPattern._internal(this._type);
+}
+
 /**
  * A reference to a file on the file system.
  *
@@ -713,6 +729,19 @@ abstract class RandomAccessFile {
    */
   int readIntoSync(List<int> buffer, [int start = 0, int end]);
 
+  /**
+   * Reads into an existing [List<int>] from the file, starting at byte
+   * [position] in the file, like [readInto]. The current position of the file
+   * is not used, and is left unchanged except on Windows.
+   *
+   * The read is done on a separate thread, into a native buffer that is
+   * copied into [buffer] when the read completes.
+   *
+   * Returns a `Future<int>` that completes with the number of bytes read.
+   */
+  Future<int> readIntoAt(List<int> buffer, int position,
+      [int start = 0, int end]);
+
   /**
    * Writes a single byte to the file. Returns a
    * `Future<RandomAccessFile>` that completes with this
@@ -749,6 +778,20 @@ abstract class RandomAccessFile {
    */
   void writeFromSync(List<int> buffer, [int start = 0, int end]);
 
+  /**
+   * Writes from a [List<int>] to the file, starting at byte [position] in the
+   * file, like [writeFrom]. The current position of the file is not used, and
+   * is left unchanged except on Windows.
+   *
+   * The bytes are copied out of [buffer] before this method returns, and
+   * the write is done on a separate thread.
+   *
+   * Returns a `Future<RandomAccessFile>` that completes with this
+   * [RandomAccessFile] when the write completes.
+   */
+  Future<RandomAccessFile> writeFromAt(List<int> buffer, int position,
+      [int start = 0, int end]);
+
   /**
    * Writes a string to the file using the given [Encoding]. Returns a
    * `Future<RandomAccessFile>` that completes with this
@@ -942,6 +985,25 @@ abstract class RandomAccessFile {
    */
   void unlockSync([int start = 0, int end = -1]);
 
+  /**
+   * Maps [length] bytes of the file, starting at byte [position], into
+   * memory and returns them as a [Uint8List].
+   *
+   * The bytes are read from the file when they are first accessed, instead
+   * of being copied into the heap. [accessPattern] tells the operating system
+   * how they are going to be accessed. Writes to the list are not written to
+   * the file. The mapping is released when the list is garbage collected,
+   * and stays valid after the file is closed.
+   *
+   * The range must lie within the file. If the file is truncated while it is
+   * mapped, accessing the bytes past its new end may crash the process. On
+   * Windows the bytes are read into memory immediately.
+   *
+   * Throws a [FileSystemException] if the operation fails.
+   */
+  Uint8List map(int position, int length,
+      {FileAccessPattern accessPattern: FileAccessPattern.normal});
+
   /**
    * Returns a human-readable string for this RandomAccessFile instance.
    */
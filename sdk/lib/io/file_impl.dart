@@ -27,6 +27,9 @@ class _FileStream extends Stream<List<int>> {
 
   bool _atEnd = false;
 
+  // Has the file been handed to a consumer instead of being listened to?
+  bool _transferred = false;
+
   _FileStream(this._path, this._position, this._end) {
     if (_position == null) _position = 0;
   }
@@ -35,6 +38,9 @@ class _FileStream extends Stream<List<int>> {
 
   StreamSubscription<List<int>> listen(void onData(List<int> event),
       {Function onError, void onDone(), bool cancelOnError}) {
+    if (_transferred) {
+      throw new StateError("Stream has already been listened to.");
+    }
     _setupController();
     return _controller.stream.listen(onData,
         onError: onError, onDone: onDone, cancelOnError: cancelOnError);
@@ -113,6 +119,19 @@ class _FileStream extends Stream<List<int>> {
     });
   }
 
+  // Opens the file for a consumer that moves its contents without reading
+  // them into the Dart heap, e.g. with sendfile. Like listen, this can only
+  // be done once, and only for a stream of a file given by path.
+  Future<RandomAccessFile> _openForTransfer() {
+    assert(_path != null && _controller == null && !_transferred);
+    _transferred = true;
+    if (_position < 0) {
+      return new Future.error(
+          new RangeError("Bad start position: $_position"));
+    }
+    return new File(_path).open(mode: FileMode.read);
+  }
+
   void _start() {
     if (_position < 0) {
       _controller.addError(new RangeError("Bad start position: $_position"));
@@ -657,14 +676,17 @@ abstract class _RandomAccessFileOps {
   readByte();
   read(int bytes);
   readInto(List<int> buffer, int start, int end);
+  readAt(List<int> buffer, int start, int end, int position, SendPort port);
   writeByte(int value);
   writeFrom(List<int> buffer, int start, int end);
+  writeAt(List<int> buffer, int start, int end, int position, SendPort port);
   position();
   setPosition(int position);
   truncate(int length);
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int position, int length, int accessPattern);
 }
 
 class _RandomAccessFile implements RandomAccessFile {
@@ -814,6 +836,35 @@ class _RandomAccessFile implements RandomAccessFile {
     return result;
   }
 
+  Future<int> readIntoAt(List<int> buffer, int position,
+      [int start = 0, int end]) {
+    if ((buffer is! List) ||
+        (position is! int) ||
+        ((start != null) && (start is! int)) ||
+        ((end != null) && (end is! int))) {
+      throw new ArgumentError();
+    }
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(0);
+    }
+    return _dispatchAt((SendPort port) {
+      return _ops.readAt(buffer, start, end, position, port);
+    }).then((response) {
+      if (response is int) {
+        _resourceInfo.addRead(response);
+        return response;
+      }
+      if (response is Uint8List) {
+        buffer.setRange(start, start + response.length, response);
+        _resourceInfo.addRead(response.length);
+        return response.length;
+      }
+      throw _exceptionFromResponse(response, "readIntoAt failed", path);
+    });
+  }
+
   Future<RandomAccessFile> writeByte(int value) {
     if (value is! int) {
       throw new ArgumentError(value);
@@ -872,6 +923,39 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
+  Future<RandomAccessFile> writeFromAt(List<int> buffer, int position,
+      [int start = 0, int end]) {
+    if ((buffer is! List) ||
+        (position is! int) ||
+        ((start != null) && (start is! int)) ||
+        ((end != null) && (end is! int))) {
+      throw new ArgumentError("Invalid arguments to writeFromAt");
+    }
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(this);
+    }
+    _BufferAndStart result;
+    try {
+      result = _ensureFastAndSerializableByteData(buffer, start, end);
+    } catch (e) {
+      return new Future.error(e);
+    }
+    int bufferStart = result.start;
+    int bufferEnd = end - (start - result.start);
+    return _dispatchAt((SendPort port) {
+      return _ops.writeAt(
+          result.buffer, bufferStart, bufferEnd, position, port);
+    }).then((response) {
+      if (response is! int) {
+        throw _exceptionFromResponse(response, "writeFromAt failed", path);
+      }
+      _resourceInfo.addWrite(response);
+      return this;
+    });
+  }
+
   void writeFromSync(List<int> buffer, [int start = 0, int end]) {
     _checkAvailable();
     if ((buffer is! List) ||
@@ -1070,6 +1154,26 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
+  Uint8List map(int position, int length,
+      {FileAccessPattern accessPattern: FileAccessPattern.normal}) {
+    _checkAvailable();
+    if ((position is! int) ||
+        (length is! int) ||
+        (accessPattern is! FileAccessPattern)) {
+      throw new ArgumentError();
+    }
+    RangeError.checkNotNegative(position, "position");
+    RangeError.checkNotNegative(length, "length");
+    if (length == 0) {
+      return new Uint8List(0);
+    }
+    var result = _ops.map(position, length, accessPattern._type);
+    if (result is OSError) {
+      throw new FileSystemException('map failed', path, result);
+    }
+    return result;
+  }
+
   bool closed = false;
 
   // WARNING:
@@ -1099,6 +1203,34 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
+  // Starts a positioned read or write with [start], which the native code
+  // runs on its own threads. The result is posted to a receive port for the
+  // request rather than going through the IO service.
+  Future _dispatchAt(start(SendPort port)) {
+    if (closed) {
+      return new Future.error(new FileSystemException("File closed", path));
+    }
+    if (_asyncDispatched) {
+      var msg = "An async operation is currently pending";
+      return new Future.error(new FileSystemException(msg, path));
+    }
+    var completer = new Completer();
+    var port = new RawReceivePort();
+    port.handler = (response) {
+      port.close();
+      _asyncDispatched = false;
+      completer.complete(response);
+    };
+    var result = start(port.sendPort);
+    if (result is OSError) {
+      port.close();
+      return new Future.error(
+          new FileSystemException("File operation failed", path, result));
+    }
+    _asyncDispatched = true;
+    return completer.future;
+  }
+
   void _checkAvailable() {
     if (_asyncDispatched) {
       throw new FileSystemException(
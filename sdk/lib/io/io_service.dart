@@ -49,6 +49,7 @@ class _IOService {
   static const int directoryListStop = 40;
   static const int directoryRename = 41;
   static const int sslProcessFilter = 42;
+  static const int socketSendFile = 43;
 
   external static Future _dispatch(int request, List data);
 }
@@ -554,6 +554,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
           SecurityContext._protocolsToLengthEncoding(supportedProtocols);
       _secureFilter.connect(
           address.host,
+          requestedPort,
           context,
           is_server,
           requestClientCertificate || requireClientCertificate,
@@ -965,8 +966,15 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   void _readSocket() {
     if (_status == closedStatus) return;
-    var buffer = _secureFilter.buffers[readEncryptedId];
-    if (buffer.writeFromSource(_readSocketOrBufferedData) > 0) {
+    int read = -1;
+    if (_bufferedData == null && !_socketClosedRead) {
+      read = _secureFilter.readEncryptedFrom(_socket);
+    }
+    if (read < 0) {
+      var buffer = _secureFilter.buffers[readEncryptedId];
+      read = buffer.writeFromSource(_readSocketOrBufferedData);
+    }
+    if (read > 0) {
       _filterStatus.readEmpty = false;
     } else {
       _socket.readEventsEnabled = false;
@@ -1230,6 +1238,7 @@ abstract class _SecureFilter {
 
   void connect(
       String hostName,
+      int port,
       SecurityContext context,
       bool is_server,
       bool requestClientCertificate,
@@ -1244,6 +1253,11 @@ abstract class _SecureFilter {
   void init();
   X509Certificate get peerCertificate;
   int processBuffer(int bufferIndex);
+
+  // Reads encrypted data from the socket straight into the readEncrypted
+  // buffer. Returns the number of bytes read, or -1 if the socket can only
+  // be read through RawSocket.read.
+  int readEncryptedFrom(RawSocket socket);
   void registerBadCertificateCallback(Function callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
 
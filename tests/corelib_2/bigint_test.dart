@@ -405,6 +405,28 @@ testBigintMul() {
   Expect.equals(BigInt.parse("123456789012345678900000000000000000"), a * b);
 }
 
+testBigintMulLarge() {
+  // Factors large enough to be split into halves, including unbalanced ones.
+  var one = BigInt.one;
+  for (var k in [2048, 4000, 6144, 20000]) {
+    for (var j in [1000, 2048, 3001, 9000]) {
+      var a = (one << k) - one;
+      var b = (one << j) - one;
+      var expected = (one << (k + j)) - (one << k) - (one << j) + one;
+      Expect.equals(expected, a * b);
+      Expect.equals(expected, b * a);
+      Expect.equals(-expected, -a * b);
+      // Factors with sparse digits and zero low halves.
+      var c = (one << k) + (one << (k ~/ 3)) + one;
+      var d = one << j;
+      Expect.equals(c << j, c * d);
+      var e = c * b;
+      Expect.equals(c, e ~/ b);
+      Expect.equals(BigInt.zero, e % b);
+    }
+  }
+}
+
 testBigintTruncDiv() {
   var a = BigInt.parse("12345678901234567890");
   var b = new BigInt.from(10);
@@ -1043,6 +1065,7 @@ main() {
     testBigintAdd();
     testBigintSub();
     testBigintMul();
+    testBigintMulLarge();
     testBigintTruncDiv();
     testBigintDiv();
     testBigintModulo();
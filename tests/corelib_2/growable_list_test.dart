@@ -10,6 +10,7 @@ void main() {
   testConstructor();
   // Concurrent modification checks are only guaranteed in checked mode.
   testConcurrentModification();
+  testGrowLarge();
 }
 
 // Iterable generating numbers in range [0..count).
@@ -161,3 +162,34 @@ void testConcurrentModification() {
     Expect.listEquals(new List.generate(500, (x) => x), l, "cm6");
   }
 }
+
+void testGrowLarge() {
+  // Lists of a few elements and of thousands grow in different ways, so the
+  // elements must survive both.
+  var list = <Object>[];
+  for (int i = 0; i < 5000; i++) {
+    list.add(i.isEven ? i : "$i");
+    Expect.equals(i + 1, list.length);
+  }
+  for (int i = 0; i < 5000; i++) {
+    Expect.equals(i.isEven ? i : "$i", list[i]);
+  }
+
+  // Growing through the length setter leaves the new elements null.
+  list.length = 20000;
+  Expect.equals(4998, list[4998]);
+  Expect.equals("4999", list[4999]);
+  Expect.isNull(list[5000]);
+  Expect.isNull(list[19999]);
+
+  // Growing again after shrinking.
+  list.length = 70;
+  for (int i = 70; i < 1000; i++) {
+    list.add(-i);
+  }
+  Expect.equals(1000, list.length);
+  Expect.equals(68, list[68]);
+  Expect.equals("69", list[69]);
+  Expect.equals(-70, list[70]);
+  Expect.equals(-999, list[999]);
+}
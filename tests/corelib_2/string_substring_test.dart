@@ -28,4 +28,21 @@ main() {
   Expect.equals("abc".substring(3, null), "");
   Expect.throwsRangeError(() => "abc".substring(4, null));
   Expect.throwsRangeError(() => "abc".substring(-1, null));
+
+  testCopies();
+}
+
+// Substrings of one-byte strings are copied a word at a time. Check every
+// start alignment with lengths below, at and above a word, so both aligned
+// and unaligned sources reach the word loop and the byte-wise tail.
+void testCopies() {
+  var codeUnits = new List<int>.generate(64, (i) => 0x21 + (i * 7) % 90);
+  var s = new String.fromCharCodes(codeUnits);
+  for (int start = 0; start < 16; start++) {
+    for (int length = 0; start + length <= codeUnits.length; length++) {
+      var expected = new String.fromCharCodes(
+          codeUnits.sublist(start, start + length));
+      Expect.equals(expected, s.substring(start, start + length));
+    }
+  }
 }
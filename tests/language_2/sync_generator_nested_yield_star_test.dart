@@ -0,0 +1,81 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test yield* of nested sync* generators, which the VM runs from the
+// outermost iterator.
+
+import "package:expect/expect.dart";
+
+class Tree {
+  final int value;
+  final Tree left;
+  final Tree right;
+  Tree(this.value, [this.left, this.right]);
+}
+
+Iterable<int> inOrder(Tree tree) sync* {
+  if (tree == null) return;
+  yield* inOrder(tree.left);
+  yield tree.value;
+  yield* inOrder(tree.right);
+}
+
+Iterable<int> countDown(int n) sync* {
+  if (n == 0) return;
+  yield n;
+  yield* countDown(n - 1);
+}
+
+Iterable<int> mixed() sync* {
+  yield 1;
+  yield* [2, 3];
+  yield* empty();
+  yield* countDown(2).map((x) => x * 10);
+  yield* sub();
+  yield 6;
+}
+
+Iterable<int> empty() sync* {}
+
+Iterable<int> sub() sync* {
+  yield* [4];
+  yield* empty();
+  yield 5;
+}
+
+Iterable<num> numbers() sync* {
+  yield 1.5;
+  // Nested generator with a more specific element type.
+  yield* countDown(2);
+}
+
+main() {
+  // A degenerate tree, deep enough to be slow if every element had to be
+  // passed up through each level.
+  Tree tree;
+  for (int i = 2000; i > 0; i--) tree = new Tree(i, null, tree);
+  var values = inOrder(tree).toList();
+  Expect.equals(2000, values.length);
+  for (int i = 0; i < values.length; i++) Expect.equals(i + 1, values[i]);
+
+  Expect.listEquals([3, 2, 1], countDown(3).toList());
+  Expect.listEquals([1, 2, 3, 20, 10, 4, 5, 6], mixed().toList());
+  Expect.listEquals(<num>[1.5, 2, 1], numbers().toList());
+
+  // Iterators of the same iterable are independent.
+  var iterable = mixed();
+  var a = iterable.iterator;
+  var b = iterable.iterator;
+  Expect.isTrue(a.moveNext());
+  Expect.isTrue(a.moveNext());
+  Expect.isTrue(b.moveNext());
+  Expect.equals(2, a.current);
+  Expect.equals(1, b.current);
+  var rest = <int>[];
+  while (a.moveNext()) rest.add(a.current);
+  Expect.listEquals([3, 20, 10, 4, 5, 6], rest);
+  Expect.isFalse(a.moveNext());
+  Expect.isTrue(b.moveNext());
+  Expect.equals(2, b.current);
+}
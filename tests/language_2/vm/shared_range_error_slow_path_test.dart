@@ -0,0 +1,69 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that failing bounds checks in optimized code throw a RangeError with
+// the right index and length, and keep the values live across the check.
+// In AOT code these checks call a shared slow-path stub.
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation --enable-inlining-annotations
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+const NeverInline = "NeverInline";
+
+@NeverInline
+int load(List<int> list, int index) => list[index];
+
+// Integer and double values that are live across the bounds check.
+@NeverInline
+double loadWithLiveValues(List<int> list, int index, int a, double d) {
+  final b = a * 3;
+  final e = d * 2.0;
+  final x = list[index];
+  return x + a + b + d + e;
+}
+
+@NeverInline
+int loadInTry(Uint8List bytes, int index, int fallback) {
+  final before = fallback + 1;
+  try {
+    return bytes[index];
+  } on RangeError catch (e) {
+    Expect.equals(index, e.invalidValue);
+    return before;
+  }
+}
+
+void expectRangeError(int index, int length, void f()) {
+  try {
+    f();
+    Expect.fail("RangeError expected");
+  } on RangeError catch (e) {
+    Expect.equals(index, e.invalidValue);
+    Expect.equals(0, e.start);
+    Expect.equals(length - 1, e.end);
+  }
+}
+
+main() {
+  final list = new List<int>.generate(5, (i) => i * 10);
+  final bytes = new Uint8List.fromList([1, 2, 3]);
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(20, load(list, 2));
+    Expect.equals(30.0 + 1 + 3 + 0.5 + 1.0,
+        loadWithLiveValues(list, 3, 1, 0.5));
+    Expect.equals(2, loadInTry(bytes, 1, 7));
+  }
+
+  expectRangeError(5, 5, () => load(list, 5));
+  expectRangeError(-1, 5, () => load(list, -1));
+  expectRangeError(7, 5, () => loadWithLiveValues(list, 7, 1, 0.5));
+  Expect.equals(8, loadInTry(bytes, 3, 7));
+  Expect.equals(8, loadInTry(bytes, -4, 7));
+
+  // Still correct after the failures.
+  Expect.equals(40, load(list, 4));
+  Expect.equals(0.0 + 2 + 6 + 1.5 + 3.0, loadWithLiveValues(list, 0, 2, 1.5));
+  Expect.equals(3, loadInTry(bytes, 2, 7));
+}
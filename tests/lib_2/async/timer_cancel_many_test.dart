@@ -0,0 +1,38 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+library timer_cancel_many_test;
+
+import 'dart:async';
+import 'package:expect/expect.dart';
+
+main() {
+  // Cancel most of a large number of timers, in an order that leaves
+  // cancelled timers both at the top and in the middle of the queue, and
+  // check that the remaining ones fire in order.
+  const int count = 1000;
+  var completer = new Completer();
+  var fired = <int>[];
+  var timers = new List<Timer>(count);
+  for (int i = 0; i < count; i++) {
+    timers[i] = new Timer(new Duration(milliseconds: 10 + i ~/ 10), () {
+      fired.add(i);
+      if (i == count - 1) completer.complete();
+    });
+  }
+  for (int i = count - 2; i >= 0; i--) {
+    if (i % 7 != 0) timers[i].cancel();
+  }
+  // Cancelling twice has no effect.
+  timers[1].cancel();
+  // A cancelled timer that is not first must not keep the isolate alive.
+  new Timer(const Duration(hours: 1), () => Expect.fail("Cancelled")).cancel();
+  return completer.future.then((_) {
+    var expected = <int>[];
+    for (int i = 0; i < count - 1; i += 7) expected.add(i);
+    expected.add(count - 1);
+    Expect.listEquals(expected, fired);
+    for (var timer in timers) Expect.isFalse(timer.isActive);
+  });
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test reading fields through InstanceMirror.getField, which loads fields
+// behind implicit getters directly.
+
+library test.invoke_implicit_getter;
+
+import 'dart:mirrors';
+
+import 'package:expect/expect.dart';
+
+class A<T> {
+  int i = 1;
+  final String s = 'a';
+  double d = 1.5;
+  T t;
+  var uninitialized;
+  var _p = 'private';
+  A(this.t);
+}
+
+class B extends A<int> {
+  B() : super(7);
+  int get i => 99;
+}
+
+class C {
+  noSuchMethod(invocation) => invocation.memberName;
+}
+
+main() {
+  var a = new A<String>('t');
+  var im = reflect(a);
+  for (var n = 0; n < 20; n++) {
+    a.d = 1.5 + n;
+    a.i = n;
+    Expect.equals(n, im.getField(#i).reflectee);
+    Expect.equals('a', im.getField(#s).reflectee);
+    Expect.equals(1.5 + n, im.getField(#d).reflectee);
+    Expect.equals('t', im.getField(#t).reflectee);
+    Expect.isNull(im.getField(#uninitialized).reflectee);
+  }
+
+  // A double read before the field is updated keeps its value.
+  var d = im.getField(#d).reflectee;
+  a.d = -3.0;
+  Expect.equals(1.5 + 19, d);
+  Expect.equals(-3.0, im.getField(#d).reflectee);
+
+  var library = reflectClass(A).owner as LibraryMirror;
+  Expect.equals('private',
+      im.getField(MirrorSystem.getSymbol('_p', library)).reflectee);
+
+  // An explicit getter overriding a field is still called.
+  var b = reflect(new B());
+  Expect.equals(99, b.getField(#i).reflectee);
+  Expect.equals(7, b.getField(#t).reflectee);
+
+  Expect.equals(#missing, reflect(new C()).getField(#missing).reflectee);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test fillRange on typed lists and views, over ranges short enough to be
+// stored element by element and long enough to be filled by bulk copies.
+
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+const lengths = const [0, 1, 127, 128, 255, 256, 257, 300, 1000, 4099];
+
+void testFill(List makeList(int length), num fillValue) {
+  // The value each element holds after storing fillValue into it.
+  final expected = (makeList(1)..[0] = fillValue)[0];
+  for (int length in lengths) {
+    for (int start in [0, 3]) {
+      final list = makeList(start + length + 5);
+      for (int i = 0; i < list.length; i++) {
+        list[i] = list is List<double> ? (i % 7 + 1).toDouble() : i % 7 + 1;
+      }
+      list.fillRange(start, start + length, fillValue);
+      for (int i = 0; i < list.length; i++) {
+        if (i >= start && i < start + length) {
+          Expect.equals(expected, list[i], "$length $start $i");
+        } else {
+          Expect.equals(i % 7 + 1, list[i], "$length $start $i");
+        }
+      }
+    }
+  }
+}
+
+main() {
+  final intLists = <List Function(int)>[
+    (n) => new Uint8List(n),
+    (n) => new Int8List(n),
+    (n) => new Uint8ClampedList(n),
+    (n) => new Uint16List(n),
+    (n) => new Int16List(n),
+    (n) => new Uint32List(n),
+    (n) => new Int32List(n),
+    // Views that start inside their buffer.
+    (n) => new Uint8List.view(new Uint8List(n + 3).buffer, 3, n),
+    (n) => new Int16List.view(new Int16List(n + 2).buffer, 4, n),
+    (n) => new Uint32List.view(new Uint32List(n + 1).buffer, 4, n),
+  ];
+  for (var makeList in intLists) {
+    testFill(makeList, 42);
+    testFill(makeList, -1);
+    testFill(makeList, 300);
+    testFill(makeList, 0x12345678);
+  }
+
+  final doubleLists = <List Function(int)>[
+    (n) => new Float32List(n),
+    (n) => new Float64List(n),
+    (n) => new Float32List.view(new Float32List(n + 1).buffer, 4, n),
+    (n) => new Float64List.view(new Float64List(n + 1).buffer, 8, n),
+  ];
+  for (var makeList in doubleLists) {
+    testFill(makeList, 0.1);
+    testFill(makeList, -0.0);
+    testFill(makeList, double.infinity);
+    testFill(makeList, 1e300);
+  }
+
+  // The range is checked before anything is stored.
+  final list = new Uint8List(1000);
+  Expect.throws(() => list.fillRange(0, 1001, 1), (e) => e is RangeError);
+  Expect.throws(() => list.fillRange(500, 400, 1), (e) => e is RangeError);
+  Expect.equals(0, list[0]);
+}
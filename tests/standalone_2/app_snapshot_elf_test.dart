@@ -0,0 +1,87 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that gen_snapshot --snapshot-kind=app-aot-elf writes a shared object
+// that the precompiled runtime can load and run.
+
+import "dart:io";
+import "dart:typed_data";
+
+void main(List<String> args) {
+  if (args.contains("--child")) {
+    print("Hello, ELF world!");
+    return;
+  }
+
+  if (!Platform.executable.endsWith("dart_precompiled_runtime")) {
+    return; // Running in JIT or Windows: AOT binaries not available.
+  }
+
+  if (!Platform.isLinux) {
+    return; // The shared object is loaded with dlopen on Linux only.
+  }
+
+  var buildDir =
+      Platform.executable.substring(0, Platform.executable.lastIndexOf('/'));
+  var tempDir = Directory.systemTemp.createTempSync("app-elf");
+  var snapshotPath = tempDir.uri.resolve("hello.so").toFilePath();
+  var scriptPath = new Directory(buildDir)
+      .uri
+      .resolve("../../tests/standalone_2/app_snapshot_elf_test.dart")
+      .toFilePath();
+  final scriptPathDill = tempDir.uri.resolve('app.dill').toFilePath();
+
+  try {
+    args = <String>[
+      '--aot',
+      '--platform=$buildDir/vm_platform_strong.dill',
+      '-o',
+      scriptPathDill,
+      scriptPath,
+    ];
+    runSync("pkg/vm/tool/gen_kernel", args);
+
+    args = <String>[
+      "--snapshot-kind=app-aot-elf",
+      "--elf=$snapshotPath",
+      scriptPathDill,
+    ];
+    runSync("$buildDir/gen_snapshot", args);
+
+    // A shared object: the ELF magic, then e_type ET_DYN.
+    var header = new Uint8List.fromList(
+        new File(snapshotPath).readAsBytesSync().sublist(0, 18));
+    if (header[0] != 0x7f ||
+        new String.fromCharCodes(header.sublist(1, 4)) != "ELF") {
+      throw "Not an ELF file";
+    }
+    if (new ByteData.view(header.buffer).getUint16(16, Endian.little) != 3) {
+      throw "Not a shared object";
+    }
+
+    args = <String>[snapshotPath, "--child"];
+    final result = runSync("$buildDir/dart_precompiled_runtime", args);
+    if (!result.stdout.contains("Hello, ELF world!")) {
+      throw "Missing output";
+    }
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}
+
+ProcessResult runSync(String executable, List<String> args) {
+  print("+ $executable ${args.join(' ')}");
+
+  final result = Process.runSync(executable, args);
+  print("Exit code: ${result.exitCode}");
+  print("stdout:");
+  print(result.stdout);
+  print("stderr:");
+  print(result.stderr);
+
+  if (result.exitCode != 0) {
+    throw "Bad exit code";
+  }
+  return result;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing RandomAccessFile.map.
+
+import 'dart:io';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+// Spans several 64 KB mapping boundaries.
+const int fileLength = 200 * 1024 + 17;
+
+List<int> expectedBytes(int start, int end) =>
+    new List<int>.generate(end - start, (i) => ((start + i) * 13) & 0xff);
+
+void testMap(File file) {
+  var raf = file.openSync();
+  try {
+    Expect.listEquals(expectedBytes(0, fileLength), raf.map(0, fileLength));
+    // Positions that are and aren't on a mapping boundary.
+    for (var position in [1, 4095, 65536, 65537, 131071, fileLength - 1]) {
+      var length = fileLength - position;
+      if (length > 5000) length = 5000;
+      var bytes = raf.map(position, length,
+          accessPattern: FileAccessPattern.random);
+      Expect.equals(length, bytes.length);
+      Expect.listEquals(expectedBytes(position, position + length), bytes);
+    }
+    Expect.equals(0, raf.map(100, 0).length);
+
+    var bytes =
+        raf.map(1000, 1000, accessPattern: FileAccessPattern.sequential);
+    // Stores change the list but not the file.
+    bytes[0] = bytes[0] ^ 0xff;
+    Expect.equals((expectedBytes(1000, 1001)[0] ^ 0xff), bytes[0]);
+    Expect.listEquals(expectedBytes(1000, 2000), raf.map(1000, 1000));
+
+    // The list stays valid after the file is closed.
+    raf.closeSync();
+    Expect.listEquals(expectedBytes(1001, 2000), bytes.sublist(1));
+  } finally {
+    try {
+      raf.closeSync();
+    } on FileSystemException catch (e) {
+      // Already closed.
+    }
+  }
+}
+
+void testErrors(File file) {
+  var raf = file.openSync();
+  // Ranges past the end of the file.
+  Expect.throws(() => raf.map(0, fileLength + 1),
+      (e) => e is FileSystemException);
+  Expect.throws(
+      () => raf.map(fileLength, 1), (e) => e is FileSystemException);
+  Expect.throws(() => raf.map(-1, 10), (e) => e is RangeError);
+  Expect.throws(() => raf.map(0, -10), (e) => e is RangeError);
+  raf.closeSync();
+  Expect.throws(() => raf.map(0, 10), (e) => e is FileSystemException);
+}
+
+main() {
+  if (Platform.isFuchsia) return;
+  var tmp = Directory.systemTemp.createTempSync('dart-file-map');
+  try {
+    var file = new File('${tmp.path}/data');
+    file.writeAsBytesSync(new Uint8List.fromList(expectedBytes(0, fileLength)));
+    testMap(file);
+    testErrors(file);
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+}
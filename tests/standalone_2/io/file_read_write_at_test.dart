@@ -0,0 +1,102 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing RandomAccessFile.readIntoAt and
+// RandomAccessFile.writeFromAt.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+const int fileLength = 64 * 1024;
+
+List<int> expectedBytes(int start, int end) =>
+    new List<int>.generate(end - start, (i) => (start + i) & 0xff);
+
+Future testWriteAndRead(Directory tmp) async {
+  var file = new File('${tmp.path}/positioned');
+  var raf = await file.open(mode: FileMode.write);
+  // Write the file back to front, through each kind of buffer.
+  await raf.writeFromAt(
+      new Uint8List.fromList(expectedBytes(32768, fileLength)), 32768);
+  await raf.writeFromAt(
+      new Int8List.fromList(expectedBytes(16384, 32768)), 16384);
+  await raf.writeFromAt(expectedBytes(0, 16384), 0);
+  // Positioned writes leave the file position alone, except on Windows.
+  if (!Platform.isWindows) {
+    Expect.equals(0, await raf.position());
+  }
+  await raf.close();
+  Expect.listEquals(expectedBytes(0, fileLength), file.readAsBytesSync());
+
+  raf = await file.open();
+  var buffer = new Uint8List(1000);
+  Expect.equals(1000, await raf.readIntoAt(buffer, 12345));
+  Expect.listEquals(expectedBytes(12345, 13345), buffer);
+
+  // Read into part of a plain list.
+  var list = new List<int>.filled(10, -1);
+  Expect.equals(4, await raf.readIntoAt(list, 100, 3, 7));
+  Expect.listEquals(
+      [-1, -1, -1]..addAll(expectedBytes(100, 104))..addAll([-1, -1, -1]),
+      list);
+
+  // Reads are cut short at the end of the file.
+  Expect.equals(10, await raf.readIntoAt(buffer, fileLength - 10));
+  Expect.listEquals(
+      expectedBytes(fileLength - 10, fileLength), buffer.sublist(0, 10));
+  Expect.equals(0, await raf.readIntoAt(buffer, fileLength + 10));
+
+  // Only one operation may be pending at a time.
+  var pending = raf.readIntoAt(buffer, 0);
+  await raf.readIntoAt(buffer, 0).then((_) {
+    Expect.fail("A second operation should not start");
+  }, onError: (e) {
+    Expect.isTrue(e is FileSystemException);
+  });
+  Expect.equals(1000, await pending);
+  await raf.close();
+
+  await raf.readIntoAt(buffer, 0).then((_) {
+    Expect.fail("Reading a closed file should fail");
+  }, onError: (e) {
+    Expect.isTrue(e is FileSystemException);
+  });
+}
+
+// Starts a large positioned read and kills the isolate before it completes.
+// The buffer goes away with the isolate, so the read must not touch it.
+void readAndDie(String path) {
+  var raf = new File(path).openSync();
+  raf.readIntoAt(new Uint8List(fileLength), 0);
+  Isolate.current.kill(priority: Isolate.immediate);
+}
+
+Future testIsolateDeath(Directory tmp) async {
+  var path = '${tmp.path}/positioned';
+  for (int i = 0; i < 20; i++) {
+    var exitPort = new ReceivePort();
+    await Isolate.spawn(readAndDie, path, onExit: exitPort.sendPort);
+    await exitPort.first;
+  }
+  // The file is still intact and readable.
+  Expect.listEquals(
+      expectedBytes(0, fileLength), new File(path).readAsBytesSync());
+}
+
+main() async {
+  asyncStart();
+  var tmp = Directory.systemTemp.createTempSync('dart-file-read-write-at');
+  try {
+    await testWriteAndRead(tmp);
+    await testIsolateDeath(tmp);
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -219,6 +219,36 @@ void testMultipleEvents() {
   file2.deleteSync();
 }
 
+void testInterleavedModifyEvents() {
+  // Repeated changes are only merged when nothing happened in between, so a
+  // file changed again after another file is reported again.
+  var dir = Directory.systemTemp.createTempSync('dart_file_system_watcher');
+  var file = new File(join(dir.path, 'file'))..createSync();
+  var file2 = new File(join(dir.path, 'file2'))..createSync();
+
+  var watcher = dir.watch(events: FileSystemEvent.modify);
+
+  asyncStart();
+  var names = <String>[];
+  var sub;
+  sub = watcher.listen((event) {
+    names.add(basename(event.path));
+    if (names.length == 3) {
+      Expect.listEquals(['file', 'file2', 'file'], names);
+      sub.cancel();
+      asyncEnd();
+      dir.deleteSync(recursive: true);
+    }
+  }, onError: (e) {
+    dir.deleteSync(recursive: true);
+    throw e;
+  });
+
+  file.writeAsStringSync('a');
+  file2.writeAsStringSync('b');
+  file.writeAsStringSync('c');
+}
+
 void testWatchRecursive() {
   var dir = Directory.systemTemp.createTempSync('dart_file_system_watcher');
   if (Platform.isLinux) {
@@ -323,6 +353,9 @@ void main() {
   testWatchDeleteDir();
   testWatchOnlyModifyFile();
   testMultipleEvents();
+  if (Platform.isLinux) {
+    testInterleavedModifyEvents();
+  }
   testWatchNonRecursive();
   testWatchNonExisting();
   testWatchMoveSelf();
@@ -0,0 +1,78 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that host lookups give the same results whether they are shared,
+// cached or sent to getaddrinfo each time.
+//
+// VMOptions=
+// VMOptions=-Ddart.io.lookup_cache=false
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+void expectSameAddresses(
+    List<InternetAddress> expected, List<InternetAddress> actual) {
+  Expect.equals(expected.length, actual.length);
+  for (int i = 0; i < expected.length; i++) {
+    Expect.equals(expected[i], actual[i]);
+    Expect.equals(expected[i].host, actual[i].host);
+  }
+}
+
+Future testConcurrentLookups() async {
+  var lookups = new List<Future<List<InternetAddress>>>.generate(
+      10, (_) => InternetAddress.lookup("localhost"));
+  var results = await Future.wait(lookups);
+  Expect.isTrue(results[0].isNotEmpty);
+  for (var result in results) {
+    expectSameAddresses(results[0], result);
+  }
+  // Each caller gets its own list.
+  results[0].clear();
+  expectSameAddresses(results[1], await InternetAddress.lookup("localhost"));
+}
+
+Future testTypes() async {
+  var v4 = await InternetAddress.lookup("localhost",
+      type: InternetAddressType.IPv4);
+  for (var address in v4) {
+    Expect.equals(InternetAddressType.IPv4, address.type);
+  }
+  // A lookup of another type is not answered from the first one.
+  var any = await InternetAddress.lookup("localhost");
+  Expect.isTrue(any.length >= v4.length);
+}
+
+Future testFailedLookups() async {
+  for (int i = 0; i < 3; i++) {
+    await InternetAddress.lookup("lookup-cache-test.invalid").then((_) {
+      Expect.fail("An .invalid host should not resolve");
+    }, onError: (e) {
+      Expect.isTrue(e is SocketException);
+    });
+  }
+}
+
+Future testManyHosts() async {
+  // More hosts than the cache holds.
+  for (int i = 0; i < 300; i++) {
+    var host = "10.0.${i ~/ 256}.${i % 256}";
+    var addresses = await InternetAddress.lookup(host);
+    Expect.equals(1, addresses.length);
+    Expect.equals(host, addresses[0].address);
+  }
+  Expect.isTrue((await InternetAddress.lookup("localhost")).isNotEmpty);
+}
+
+main() async {
+  asyncStart();
+  await testConcurrentLookups();
+  await testTypes();
+  await testFailedLookups();
+  await testManyHosts();
+  asyncEnd();
+}
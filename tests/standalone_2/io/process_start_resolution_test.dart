@@ -0,0 +1,83 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test how the executable of a started process is found: a relative path is
+// resolved against the process's working directory, and a bare name is looked
+// up in the PATH of the process's environment.
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+File writeScript(Directory dir, String name, String output,
+    {bool shebang: true}) {
+  var script = new File('${dir.path}/$name');
+  script.writeAsStringSync(
+      '${shebang ? "#!/bin/sh\n" : ""}echo $output "\$@"\n');
+  var result = Process.runSync('chmod', ['+x', script.path]);
+  Expect.equals(0, result.exitCode);
+  return script;
+}
+
+Future testRelativeToWorkingDirectory(Directory tmp) async {
+  var dir = new Directory('${tmp.path}/bin')..createSync();
+  writeScript(dir, 'tool', 'relative');
+  var result =
+      await Process.run('./tool', ['a', 'b'], workingDirectory: dir.path);
+  Expect.equals(0, result.exitCode);
+  Expect.equals('relative a b\n', result.stdout);
+
+  result = await Process.run('bin/tool', [], workingDirectory: tmp.path);
+  Expect.equals(0, result.exitCode);
+  Expect.equals('relative\n', result.stdout);
+
+  // The same relative path is not found from elsewhere.
+  await Process.run('./tool', [], workingDirectory: tmp.path).then((_) {
+    Expect.fail('./tool should not be found in ${tmp.path}');
+  }, onError: (e) {
+    Expect.isTrue(e is ProcessException);
+  });
+}
+
+Future testChildPath(Directory tmp) async {
+  var dir = new Directory('${tmp.path}/path')..createSync();
+  writeScript(dir, 'dart_process_resolution_tool', 'found');
+  // A script without '#!' is run with the shell, as execvp does.
+  writeScript(dir, 'dart_process_resolution_plain', 'plain', shebang: false);
+  var environment = {'PATH': '/nonexistent:${dir.path}:/bin:/usr/bin'};
+
+  var result = await Process.run('dart_process_resolution_tool', ['x'],
+      environment: environment);
+  Expect.equals(0, result.exitCode);
+  Expect.equals('found x\n', result.stdout);
+
+  result = await Process.run('dart_process_resolution_plain', [],
+      environment: environment);
+  Expect.equals(0, result.exitCode);
+  Expect.equals('plain\n', result.stdout);
+
+  // Without the directory in the child's PATH the tool is not found, even
+  // though the parent's PATH is unchanged.
+  await Process.run('dart_process_resolution_tool', [],
+      environment: {'PATH': '/bin:/usr/bin'}).then((_) {
+    Expect.fail('The tool should not be found');
+  }, onError: (e) {
+    Expect.isTrue(e is ProcessException);
+  });
+}
+
+main() async {
+  if (Platform.isWindows) return;
+  asyncStart();
+  var tmp = Directory.systemTemp.createTempSync('dart_process_resolution');
+  try {
+    await testRelativeToWorkingDirectory(tmp);
+    await testChildPath(tmp);
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// This test checks the client session cache kept by each SecurityContext.
+// Sessions are cached per host and port, and resumed by later connections
+// made with the same context. Sessions whose certificate was only accepted
+// by an onBadCertificate callback must never be cached: resuming them would
+// skip the callback on later connections.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+InternetAddress HOST;
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(localFile('certificates/server_key.pem'),
+      password: 'dartdart');
+
+Future<SecureServerSocket> startServer() {
+  return SecureServerSocket.bind(HOST, 0, serverContext).then((server) {
+    server.listen((SecureSocket client) {
+      client.fold(<int>[], (message, data) => message..addAll(data)).then(
+          (message) {
+        String received = new String.fromCharCodes(message);
+        client.write("Welcome, $received");
+        client.close();
+      });
+    });
+    return server;
+  });
+}
+
+Future connectClient(SecureServerSocket server, String name,
+    SecurityContext context, {bool onBadCertificate(X509Certificate c)}) {
+  return SecureSocket
+      .connect(HOST, server.port,
+          context: context, onBadCertificate: onBadCertificate)
+      .then((socket) {
+    // A resumed session still reports the server's certificate.
+    Expect.isNotNull(socket.peerCertificate);
+    socket.write(name);
+    socket.close();
+    return socket.fold(<int>[], (message, data) => message..addAll(data)).then(
+        (message) {
+      Expect.listEquals("Welcome, $name".codeUnits, message);
+    });
+  });
+}
+
+Future testResumption() async {
+  SecurityContext context = new SecurityContext()
+    ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+  SecureServerSocket first = await startServer();
+  SecureServerSocket second = await startServer();
+  // Alternate between two ports on the same host, so each connection after
+  // the first two finds its own port's session in the cache.
+  for (String name in ['able', 'baker', 'charlie', 'dozen', 'elapse']) {
+    await connectClient(first, name, context);
+    await connectClient(second, name, context);
+  }
+  await first.close();
+  await second.close();
+}
+
+Future testBadCertificateNotCached() async {
+  // The server's certificate is not trusted by this context, so every
+  // connection must go through a full handshake and ask the callback again.
+  SecurityContext context = new SecurityContext(withTrustedRoots: false);
+  int callbacks = 0;
+  bool accept(X509Certificate certificate) {
+    callbacks++;
+    return true;
+  }
+
+  SecureServerSocket server = await startServer();
+  const int connections = 4;
+  for (int i = 0; i < connections; i++) {
+    int before = callbacks;
+    await connectClient(server, 'client $i', context, onBadCertificate: accept);
+    Expect.isTrue(callbacks > before);
+  }
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  HOST = (await InternetAddress.lookup("localhost")).first;
+  await testResumption();
+  await testBadCertificateNotCached();
+  asyncEnd();
+}
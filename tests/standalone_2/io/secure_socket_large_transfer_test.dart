@@ -0,0 +1,92 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Echoes a payload many times the size of the secure filter's buffers over
+// TLS, so encrypted records read from the socket wrap around the buffer and
+// are split at arbitrary points.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+InternetAddress HOST;
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(localFile('certificates/server_key.pem'),
+      password: 'dartdart');
+
+SecurityContext clientContext = new SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+const int payloadLength = 1024 * 1024 + 17;
+
+List<int> payload() {
+  var bytes = new Uint8List(payloadLength);
+  for (int i = 0; i < payloadLength; i++) {
+    bytes[i] = (i * 7 + (i >> 10)) & 0xff;
+  }
+  return bytes;
+}
+
+Future<SecureServerSocket> startEchoServer() async {
+  var server = await SecureServerSocket.bind(HOST, 0, serverContext);
+  server.listen((SecureSocket client) {
+    client.listen(client.add, onDone: client.close);
+  });
+  return server;
+}
+
+Future<List<int>> echo(Socket socket, List<int> data) {
+  var received = socket.fold(new BytesBuilder(copy: false),
+      (BytesBuilder builder, List<int> chunk) => builder..add(chunk));
+  // Send in uneven pieces.
+  for (int start = 0; start < data.length; start += 40000) {
+    int end = start + 40000 < data.length ? start + 40000 : data.length;
+    socket.add(data.sublist(start, end));
+  }
+  socket.close();
+  return received.then((builder) => builder.takeBytes());
+}
+
+Future testConnect() async {
+  var server = await startEchoServer();
+  var data = payload();
+  var socket =
+      await SecureSocket.connect(HOST, server.port, context: clientContext);
+  Expect.listEquals(data, await echo(socket, data));
+  await server.close();
+}
+
+Future testUpgrade() async {
+  // An upgraded socket reads through the same path once the handshake is
+  // under way.
+  var server = await startEchoServer();
+  var data = payload();
+  var plain = await Socket.connect(HOST, server.port);
+  var socket = await SecureSocket.secure(plain, context: clientContext);
+  Expect.listEquals(data, await echo(socket, data));
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  HOST = (await InternetAddress.lookup("localhost")).first;
+  await testConnect();
+  await testUpgrade();
+  asyncEnd();
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that many small chunks added to a socket while it is not writable
+// arrive complete and in order. Such chunks are queued and written together
+// with one writev.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+const int chunks = 20000;
+
+List<int> chunk(int i) {
+  // Vary the length and the kind of list.
+  var bytes = new List<int>.generate(i % 37 + 1, (j) => (i + j) & 0xff);
+  switch (i % 3) {
+    case 0:
+      return bytes;
+    case 1:
+      return new Uint8List.fromList(bytes);
+    default:
+      return new Int8List.fromList(bytes).buffer.asUint8List();
+  }
+}
+
+Stream<List<int>> chunkStream() async* {
+  for (int i = 0; i < chunks; i++) {
+    yield chunk(i);
+  }
+}
+
+main() async {
+  asyncStart();
+  var expected = <int>[];
+  for (int i = 0; i < chunks; i++) {
+    expected.addAll(chunk(i));
+  }
+
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = new Completer<List<int>>();
+  server.listen((client) {
+    var bytes = new BytesBuilder(copy: false);
+    // Read slowly at first, so the writer's chunks queue up.
+    var subscription = client.listen(bytes.add, onDone: () {
+      received.complete(bytes.takeBytes());
+      client.destroy();
+    });
+    subscription.pause(new Future.delayed(new Duration(milliseconds: 200)));
+  });
+
+  var socket = await Socket.connect(server.address, server.port);
+  await socket.addStream(chunkStream());
+  // Lists added after the stream follow it.
+  socket.add([1, 2, 3]);
+  await socket.close();
+  expected.addAll([1, 2, 3]);
+  Expect.listEquals(expected, await received.future);
+  await server.close();
+  asyncEnd();
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test adding file streams to a socket. On Linux and Android they are sent
+// with sendfile instead of being read into the Dart heap.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+import "package:async_helper/async_helper.dart";
+
+// Larger than the socket buffers, so the send has to wait for write events.
+const int fileLength = 4 * 1024 * 1024 + 123;
+
+List<int> expectedBytes(int start, int end) =>
+    new List<int>.generate(end - start, (i) => ((start + i) * 7) & 0xff);
+
+// Starts a server that collects everything sent on each connection.
+Future<ServerSocket> startServer(void onReceived(List<int> bytes)) async {
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) {
+    var received = new BytesBuilder(copy: false);
+    client.listen(received.add, onDone: () {
+      onReceived(received.takeBytes());
+      client.destroy();
+    });
+  });
+  return server;
+}
+
+Future<List<int>> send(File file, [int start, int end]) async {
+  var completer = new Completer<List<int>>();
+  var server = await startServer(completer.complete);
+  var socket = await Socket.connect(server.address, server.port);
+  var stream = file.openRead(start, end);
+  await socket.addStream(stream);
+  if (Platform.isLinux || Platform.isAndroid) {
+    // The stream was handed to sendfile, and can't be listened to.
+    Expect.throws(() => stream.listen((_) {}), (e) => e is StateError);
+  }
+  await socket.close();
+  var received = await completer.future;
+  await server.close();
+  return received;
+}
+
+Future testRanges(File file) async {
+  Expect.listEquals(expectedBytes(0, fileLength), await send(file));
+  Expect.listEquals(expectedBytes(1000, fileLength), await send(file, 1000));
+  Expect.listEquals(expectedBytes(12345, 2000000),
+      await send(file, 12345, 2000000));
+  Expect.listEquals(<int>[], await send(file, 100, 100));
+  // The end is clamped to the end of the file.
+  Expect.listEquals(expectedBytes(fileLength - 10, fileLength),
+      await send(file, fileLength - 10, fileLength + 10));
+}
+
+Future testSequence(File file) async {
+  // Files and lists added one after the other arrive in order.
+  var completer = new Completer<List<int>>();
+  var server = await startServer(completer.complete);
+  var socket = await Socket.connect(server.address, server.port);
+  await socket.addStream(file.openRead(0, 100000));
+  socket.add(expectedBytes(100000, 100010));
+  await socket.addStream(file.openRead(100010, 300000));
+  await socket.close();
+  Expect.listEquals(expectedBytes(0, 300000), await completer.future);
+  await server.close();
+}
+
+Future testErrors(Directory tmp) async {
+  var completer = new Completer<List<int>>();
+  var server = await startServer(completer.complete);
+  var socket = await Socket.connect(server.address, server.port);
+  await socket.addStream(new File('${tmp.path}/missing').openRead()).then(
+      (_) {
+    Expect.fail("Sending a missing file should fail");
+  }, onError: (e) {
+    Expect.isTrue(e is FileSystemException);
+  });
+  socket.destroy();
+  await server.close();
+}
+
+Future testDestroy(File file) async {
+  // Destroying the socket in the middle of a send stops it.
+  var server = await startServer((_) {});
+  for (int i = 0; i < 10; i++) {
+    var socket = await Socket.connect(server.address, server.port);
+    var sent = socket.addStream(file.openRead());
+    await new Future.delayed(new Duration(milliseconds: i));
+    socket.destroy();
+    await sent.catchError((_) {});
+  }
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  var tmp = Directory.systemTemp.createTempSync('dart-socket-send-file');
+  try {
+    var file = new File('${tmp.path}/data');
+    file.writeAsBytesSync(
+        new Uint8List.fromList(expectedBytes(0, fileLength)));
+    await testRanges(file);
+    await testSequence(file);
+    await testErrors(tmp);
+    await testDestroy(file);
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -244,6 +244,44 @@ void testZlibWithDictionary() {
   });
 }
 
+List<int> randomBytes(int length) {
+  var bytes = new Uint8List(length);
+  int seed = 42;
+  for (int i = 0; i < length; i++) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    bytes[i] = (seed >> 16) & 0xff;
+  }
+  return bytes;
+}
+
+void testZlibLargeBuffers() {
+  // Random data does not compress, so each direction needs more than the
+  // 64 KB of the default output buffer.
+  var data = randomBytes(200000);
+  var encoded = new ZLibEncoder().convert(data);
+  Expect.isTrue(encoded.length > data.length);
+  Expect.listEquals(data, new ZLibDecoder().convert(encoded));
+  Expect.listEquals(data, gzip.decode(gzip.encode(data)));
+
+  // Finishing a deflate stream returns the rest of it as one chunk.
+  var deflate = new RawZLibFilter.deflateFilter();
+  deflate.process(data, 0, data.length);
+  Expect.listEquals(encoded, deflate.processed(end: true));
+  Expect.isNull(deflate.processed(end: true));
+
+  // Inflating makes room for the likely size of the pending input.
+  var inflate = new RawZLibFilter.inflateFilter();
+  inflate.process(encoded, 0, encoded.length);
+  Expect.listEquals(data, inflate.processed(end: true));
+  Expect.isNull(inflate.processed(end: true));
+
+  // Data that expands more than the guess still comes out whole.
+  var zeros = new Uint8List(1024 * 1024);
+  var compressed = new ZLibEncoder().convert(zeros);
+  Expect.isTrue(compressed.length < 64 * 1024);
+  Expect.listEquals(zeros, new ZLibDecoder().convert(compressed));
+}
+
 var generateListTypes = [
   (list) => list,
   (list) => new Uint8List.fromList(list),
@@ -286,5 +324,6 @@ void main() {
   testZlibInflateThrowsWithSmallerWindow();
   testZlibInflateWithLargerWindow();
   testZlibWithDictionary();
+  testZlibLargeBuffers();
   asyncEnd();
 }
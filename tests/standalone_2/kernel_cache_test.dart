@@ -0,0 +1,81 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that --kernel-cache reuses the kernel of an unchanged script, and
+// compiles it again when its sources or its packages file change.
+
+import "dart:io";
+
+import "package:expect/expect.dart";
+
+String run(Directory cache, String script) {
+  var result = Process.runSync(
+      Platform.executable, ["--kernel-cache=${cache.path}", script]);
+  Expect.equals(0, result.exitCode, "${result.stdout}\n${result.stderr}");
+  return result.stdout.trim();
+}
+
+List<File> entries(Directory cache) =>
+    cache.listSync().where((e) => e.path.endsWith(".dill")).toList().cast();
+
+void writeLater(File file, String contents) {
+  // Make sure the modification time changes.
+  sleep(new Duration(milliseconds: 1100));
+  file.writeAsStringSync(contents);
+}
+
+void main() {
+  if (Platform.executable.endsWith("dart_precompiled_runtime") ||
+      Platform.isAndroid) {
+    return; // Scripts are not compiled from source there.
+  }
+  var tmp = Directory.systemTemp.createTempSync("kernel-cache");
+  try {
+    var cache = new Directory("${tmp.path}/cache");
+    new Directory("${tmp.path}/one").createSync();
+    new Directory("${tmp.path}/two").createSync();
+    new File("${tmp.path}/one/value.dart")
+        .writeAsStringSync("const value = 'one';\n");
+    new File("${tmp.path}/two/value.dart")
+        .writeAsStringSync("const value = 'two';\n");
+    var packages = new File("${tmp.path}/.packages")
+      ..writeAsStringSync("value:one/\n");
+    var script = new File("${tmp.path}/main.dart")
+      ..writeAsStringSync("import 'package:value/value.dart';\n"
+          "main() => print(value);\n");
+
+    Expect.equals("one", run(cache, script.path));
+    Expect.equals(1, entries(cache).length);
+    var entry = entries(cache).single;
+    var modified = entry.lastModifiedSync();
+
+    // An unchanged script is loaded from the cache, not compiled and stored
+    // again.
+    sleep(new Duration(milliseconds: 1100));
+    Expect.equals("one", run(cache, script.path));
+    Expect.equals(modified, entry.lastModifiedSync());
+
+    // A changed dependency replaces the entry.
+    writeLater(new File("${tmp.path}/one/value.dart"),
+        "const value = 'uno';\n");
+    Expect.equals("uno", run(cache, script.path));
+    Expect.equals(1, entries(cache).length);
+
+    // Packages files of the same size and age, but different contents, are
+    // different compilations.
+    var packagesModified = packages.lastModifiedSync();
+    packages.writeAsStringSync("value:two/\n");
+    packages.setLastModifiedSync(packagesModified);
+    Expect.equals("two", run(cache, script.path));
+    Expect.equals(2, entries(cache).length);
+
+    // A corrupt entry is not used.
+    for (var file in entries(cache)) {
+      file.writeAsStringSync("garbage");
+    }
+    Expect.equals("two", run(cache, script.path));
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+}
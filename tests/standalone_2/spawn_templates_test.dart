@@ -0,0 +1,85 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that isolates spawned with --spawn-templates start from a template of
+// their script that matches their own flags, also when several of them are
+// spawned at once, and that deferred libraries still load in them. Isolates
+// spawned after the first one has exited start from its warmed up snapshot.
+
+import "dart:async";
+import "dart:io";
+import "dart:isolate";
+
+import "package:expect/expect.dart";
+
+const String childSource = """
+import 'dart:isolate';
+import 'value.dart' deferred as value;
+
+main(List<String> args, SendPort port) async {
+  bool asserts = false;
+  assert(asserts = true);
+  await value.loadLibrary();
+  port.send([asserts, value.value]);
+}
+""";
+
+Future<List> spawn(String dill, bool checked) async {
+  var port = new ReceivePort();
+  await Isolate.spawnUri(Uri.file(dill), [], port.sendPort, checked: checked);
+  var reply = await port.first;
+  return reply as List;
+}
+
+// Runs in a VM started with --spawn-templates.
+Future driver(String dill) async {
+  // The first isolates are spawned together, while the template is created.
+  var replies = await Future.wait(
+      new List.generate(4, (_) => spawn(dill, false)));
+  for (var reply in replies) {
+    Expect.listEquals([false, "deferred"], reply);
+  }
+  Expect.listEquals([false, "deferred"], await spawn(dill, false));
+  // Isolates with other flags do not start from the same template.
+  Expect.listEquals([true, "deferred"], await spawn(dill, true));
+  Expect.listEquals([true, "deferred"], await spawn(dill, true));
+  Expect.listEquals([false, "deferred"], await spawn(dill, false));
+}
+
+main(List<String> args) async {
+  if (args.length == 2 && args[0] == "--driver") {
+    await driver(args[1]);
+    return;
+  }
+  if (Platform.executable.endsWith("dart_precompiled_runtime") ||
+      Platform.isAndroid) {
+    return; // Isolates are not spawned from kernel files there.
+  }
+  var tmp = Directory.systemTemp.createTempSync("spawn-templates");
+  try {
+    new File("${tmp.path}/value.dart")
+        .writeAsStringSync("const value = 'deferred';\n");
+    var child = new File("${tmp.path}/child.dart")
+      ..writeAsStringSync(childSource);
+    var dill = "${tmp.path}/child.dill";
+    var result = Process.runSync(Platform.executable,
+        ["--snapshot-kind=kernel", "--snapshot=$dill", child.path]);
+    Expect.equals(0, result.exitCode, "${result.stdout}\n${result.stderr}");
+
+    result = Process.runSync(Platform.executable, [
+      "--spawn-templates",
+      "--trace-loading",
+      Platform.script.toFilePath(),
+      "--driver",
+      dill
+    ]);
+    Expect.equals(0, result.exitCode, "${result.stdout}\n${result.stderr}");
+    Expect.isFalse(result.stderr.contains("Cannot create spawn template"),
+        result.stderr);
+    Expect.isFalse(result.stderr.contains("Cannot warm spawn template"),
+        result.stderr);
+  } finally {
+    tmp.deleteSync(recursive: true);
+  }
+}